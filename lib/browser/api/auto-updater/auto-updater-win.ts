@@ -51,7 +51,7 @@ class AutoUpdater extends EventEmitter implements Electron.AutoUpdater {
       this.updateAvailable = true;
       this.emit('update-available');
 
-      await squirrelUpdate.update(url);
+      await squirrelUpdate.update(url, (percent) => this.emit('update-progress', { percent }));
       const { releaseNotes, version } = update;
       // Date is not available on Windows, so fake it.
       const date = new Date();
@@ -1,4 +1,5 @@
 import * as fs from 'fs';
+import * as os from 'os';
 import * as path from 'path';
 import { spawn, ChildProcessWithoutNullStreams } from 'child_process';
 
@@ -14,8 +15,10 @@ let spawnedProcess: ChildProcessWithoutNullStreams | undefined;
 const isSameArgs = (args: string[]) => args.length === spawnedArgs.length && args.every((e, i) => e === spawnedArgs[i]);
 
 // Spawn a command and invoke the callback when it completes with an error
-// and the output from standard out.
-const spawnUpdate = async function (args: string[], options: { detached: boolean }): Promise<string> {
+// and the output from standard out. With |background|, Update.exe runs with
+// below normal priority so that it doesn't compete with the app, and
+// |onProgress| is called with the percentages it prints while updating.
+const spawnUpdate = async function (args: string[], options: { detached: boolean, background?: boolean, onProgress?: (percent: number) => void }): Promise<string> {
   return new Promise((resolve, reject) => {
     // Ensure we don't spawn multiple squirrel processes
     // Process spawned, same args:        Attach events to already running process
@@ -29,12 +32,29 @@ const spawnUpdate = async function (args: string[], options: { detached: boolean
         windowsHide: true
       });
       spawnedArgs = args || [];
+      if (options.background && spawnedProcess.pid !== undefined) {
+        try {
+          os.setPriority(spawnedProcess.pid, os.constants.priority.PRIORITY_BELOW_NORMAL);
+        } catch {
+          // The process may have exited already.
+        }
+      }
     }
 
     let stdout = '';
     let stderr = '';
+    let partialLine = '';
 
-    spawnedProcess.stdout.on('data', (data) => { stdout += data; });
+    spawnedProcess.stdout.on('data', (data) => {
+      stdout += data;
+      if (options.onProgress) {
+        const lines = (partialLine + data).split(/\r?\n/);
+        partialLine = lines.pop()!;
+        for (const line of lines) {
+          if (/^\d+$/.test(line)) options.onProgress(Math.min(parseInt(line, 10), 100));
+        }
+      }
+    });
     spawnedProcess.stderr.on('data', (data) => { stderr += data; });
 
     spawnedProcess.on('error', (error) => {
@@ -65,7 +85,7 @@ export function processStart () {
 
 // Download the releases specified by the URL and write new results to stdout.
 export async function checkForUpdate (updateURL: string): Promise<any> {
-  const stdout = await spawnUpdate(['--checkForUpdate', updateURL], { detached: false });
+  const stdout = await spawnUpdate(['--checkForUpdate', updateURL], { detached: false, background: true });
   try {
     // Last line of output is the JSON details about the releases
     const json = stdout.trim().split('\n').pop();
@@ -76,8 +96,8 @@ export async function checkForUpdate (updateURL: string): Promise<any> {
 }
 
 // Update the application to the latest remote version specified by URL.
-export async function update (updateURL: string): Promise<void> {
-  await spawnUpdate(['--update', updateURL], { detached: false });
+export async function update (updateURL: string, onProgress?: (percent: number) => void): Promise<void> {
+  await spawnUpdate(['--update', updateURL], { detached: false, background: true, onProgress });
 }
 
 // Is the Update.exe installed with the current application?
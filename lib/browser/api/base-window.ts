@@ -15,6 +15,13 @@ BaseWindow.prototype._init = function (this: TLWT) {
   }
 };
 
+BaseWindow.prototype.batchUpdate = function (callback) {
+  if (typeof callback !== 'function') {
+    throw new TypeError('callback must be a function');
+  }
+  this._batchUpdate(callback);
+};
+
 // Properties
 
 Object.defineProperty(BaseWindow.prototype, 'autoHideMenuBar', {
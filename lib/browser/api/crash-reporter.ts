@@ -72,6 +72,10 @@ class CrashReporter implements Electron.CrashReporter {
     binding.addExtraParameter(key, value);
   }
 
+  addExtraParameters (parameters: Record<string, string>) {
+    binding.addExtraParameters(parameters);
+  }
+
   removeExtraParameter (key: string) {
     binding.removeExtraParameter(key);
   }
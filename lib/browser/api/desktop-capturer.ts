@@ -1,3 +1,5 @@
+import { EventEmitter } from 'events';
+
 const { createDesktopCapturer } = process._linkedBinding('electron_browser_desktop_capturer');
 
 const deepEqual = (a: ElectronInternal.GetSourcesOptions, b: ElectronInternal.GetSourcesOptions) => JSON.stringify(a) === JSON.stringify(b);
@@ -69,3 +71,52 @@ export async function getSources (args: Electron.SourcesOptions) {
 
   return getSources;
 }
+
+class DesktopCapturerSourceWatcher extends EventEmitter implements Electron.DesktopCapturerSourceWatcher {
+  #capturer: ElectronInternal.DesktopCapturer | null;
+
+  constructor (options: ElectronInternal.GetSourcesOptions, updateInterval: number) {
+    super();
+    const capturer = this.#capturer = createDesktopCapturer();
+    capturer._onerror = (error: string) => {
+      this.#capturer = null;
+      // Emitting 'error' without a listener would throw from the capturer's
+      // callback.
+      if (this.listenerCount('error') > 0) {
+        this.emit('error', new Error(error));
+      }
+    };
+    capturer._onsourceadded = (source) => this.emit('source-added', source);
+    capturer._onsourceremoved = (id) => this.emit('source-removed', id);
+    capturer._onsourcenamechanged = (source) => this.emit('source-name-changed', source);
+    capturer._onthumbnailchanged = (source) => this.emit('thumbnail-changed', source);
+    // Let the caller add its listeners before the first sources are found.
+    process.nextTick(() => {
+      this.#capturer?.startWatching(options.captureWindow, options.captureScreen,
+        options.thumbnailSize, options.fetchWindowIcons, updateInterval);
+    });
+  }
+
+  stop () {
+    if (!this.#capturer) return;
+    this.#capturer.stopWatching();
+    this.#capturer = null;
+  }
+}
+
+export function watchSources (args: Electron.WatchSourcesOptions) {
+  if (!isValid(args)) throw new Error('Invalid options');
+
+  const { thumbnailSize = { width: 150, height: 150 } } = args;
+  const { fetchWindowIcons = false, updateInterval = 1000 } = args;
+  if (typeof updateInterval !== 'number' || !(updateInterval > 0)) {
+    throw new Error('updateInterval must be a positive number');
+  }
+
+  return new DesktopCapturerSourceWatcher({
+    captureWindow: args.types.includes('window'),
+    captureScreen: args.types.includes('screen'),
+    thumbnailSize,
+    fetchWindowIcons
+  }, updateInterval);
+}
@@ -12,6 +12,11 @@ const MenuItem = function (this: any, options: any) {
     this.role = this.role.toLowerCase();
   }
   this.submenu = this.submenu || roles.getDefaultSubmenu(this.role);
+  if (typeof this.submenu === 'function') {
+    const populate = this.submenu;
+    this.submenu = new Menu();
+    this.submenu._setPopulator(populate);
+  }
   if (this.submenu != null && this.submenu.constructor !== Menu) {
     this.submenu = Menu.buildFromTemplate(this.submenu);
   }
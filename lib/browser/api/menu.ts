@@ -6,6 +6,7 @@ const bindings = process._linkedBinding('electron_browser_menu');
 
 const { Menu } = bindings as { Menu: typeof MenuType };
 const checked = new WeakMap<MenuItem, boolean>();
+const populators = new WeakMap<MenuType, () => (MenuItemConstructorOptions | MenuItem)[]>();
 let applicationMenu: MenuType | null = null;
 let groupIdIndex = 0;
 
@@ -65,6 +66,19 @@ Menu.prototype._menuWillShow = function () {
   }
 };
 
+// Defers adding the items of the menu until it is about to be shown.
+Menu.prototype._setPopulator = function (populate) {
+  populators.set(this, populate);
+  this._setNeedsPopulate(true);
+};
+
+Menu.prototype._populate = function () {
+  const populate = populators.get(this);
+  if (!populate) return;
+  populators.delete(this);
+  appendTemplate(this, populate());
+};
+
 Menu.prototype.popup = function (options = {}) {
   if (options == null || typeof options !== 'object') {
     throw new TypeError('Options must be an object');
@@ -146,6 +160,8 @@ Menu.prototype.insert = function (pos, item) {
   // Make menu accessible to items.
   item.overrideReadOnlyProperty('menu', this);
 
+  observeItemChanges.call(this, item);
+
   // Remember the items.
   this.items.splice(pos, 0, item);
   this.commandsMap[item.commandId] = item;
@@ -184,6 +200,14 @@ Menu.setApplicationMenu = function (menu: MenuType) {
 };
 
 Menu.buildFromTemplate = function (template) {
+  const menu = new Menu();
+  appendTemplate(menu, template);
+  return menu;
+};
+
+/* Helper Functions */
+
+function appendTemplate (menu: MenuType, template: (MenuItemConstructorOptions | MenuItem)[]) {
   if (!Array.isArray(template)) {
     throw new TypeError('Invalid template for Menu: Menu template must be an array');
   }
@@ -195,7 +219,6 @@ Menu.buildFromTemplate = function (template) {
   const sorted = sortTemplate(template);
   const filtered = removeExtraSeparators(sorted);
 
-  const menu = new Menu();
   for (const item of filtered) {
     if (item instanceof MenuItem) {
       menu.append(item);
@@ -203,11 +226,7 @@ Menu.buildFromTemplate = function (template) {
       menu.append(new MenuItem(item));
     }
   }
-
-  return menu;
-};
-
-/* Helper Functions */
+}
 
 // validate the template against having the wrong attribute
 function areValidTemplateItems (template: (MenuItemConstructorOptions | MenuItem)[]) {
@@ -282,6 +301,7 @@ function insertItemByType (this: MenuType, item: MenuItem, pos: number) {
         set: () => {
           for (const other of this.groupsMap[item.groupId]) {
             if (other !== item) checked.set(other, false);
+            markItemChanged.call(this, other);
           }
           checked.set(item, true);
         }
@@ -292,4 +312,40 @@ function insertItemByType (this: MenuType, item: MenuItem, pos: number) {
   types[item.type]();
 }
 
+function markItemChanged (this: MenuType, item: MenuItem) {
+  const index = this.getIndexOfCommandId(item.commandId);
+  if (index !== -1) this._markItemChanged(index);
+}
+
+// Pass changes to the properties of an item on to the native menus built from
+// this menu, so that they update just that item instead of being rebuilt.
+function observeItemChanges (this: MenuType, item: MenuItem) {
+  const properties = ['label', 'sublabel', 'toolTip', 'enabled', 'visible'];
+  // The checked state of radio items is already handled by their group.
+  if (item.type !== 'radio') properties.push('checked');
+
+  for (const name of properties) {
+    let value = (item as any)[name];
+    Object.defineProperty(item, name, {
+      enumerable: true,
+      get: () => value,
+      set: (newValue) => {
+        if (value === newValue) return;
+        value = newValue;
+        const index = this.getIndexOfCommandId(item.commandId);
+        if (index === -1) return;
+        if (name === 'label') {
+          this.setLabel(index, value);
+        } else if (name === 'sublabel') {
+          this.setSublabel(index, value);
+        } else if (name === 'toolTip') {
+          this.setToolTip(index, value);
+        } else {
+          this._markItemChanged(index);
+        }
+      }
+    });
+  }
+}
+
 module.exports = Menu;
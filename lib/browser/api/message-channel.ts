@@ -2,6 +2,14 @@ import { MessagePortMain } from '@electron/internal/browser/message-port-main';
 import { EventEmitter } from 'events';
 const { createPair } = process._linkedBinding('electron_browser_message_port');
 
+type MessageTarget = Electron.WebContents | Electron.WebFrameMain;
+
+function getFrame (target: MessageTarget): Electron.WebFrameMain {
+  const frame = 'mainFrame' in target ? target.mainFrame : target;
+  if (!frame) throw new Error('Target has no frame to connect to');
+  return frame;
+}
+
 export default class MessageChannelMain extends EventEmitter implements Electron.MessageChannelMain {
   port1: MessagePortMain;
   port2: MessagePortMain;
@@ -11,4 +19,15 @@ export default class MessageChannelMain extends EventEmitter implements Electron
     this.port1 = new MessagePortMain(port1);
     this.port2 = new MessagePortMain(port2);
   }
+
+  // The ports are handed over without being wrapped, since the main process
+  // has no use for either end once the two renderers hold them.
+  static connect (channel: string, first: MessageTarget, second: MessageTarget, message?: any) {
+    if (typeof channel !== 'string') throw new TypeError('Missing required channel argument');
+    const firstFrame = getFrame(first);
+    const secondFrame = getFrame(second);
+    const { port1, port2 } = createPair();
+    firstFrame._postMessage(channel, message, [port1]);
+    secondFrame._postMessage(channel, message, [port2]);
+  }
 }
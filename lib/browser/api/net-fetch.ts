@@ -96,6 +96,12 @@ export function fetchWithSession (input: RequestInfo, init: (RequestInit & {bypa
     r.setHeader(k, v);
   }
 
+  // Streams have no length to send up front, so they are sent as they are
+  // read instead of being buffered first.
+  if (init?.body instanceof ReadableStream || isReadable(init?.body as unknown as NodeJS.ReadableStream)) {
+    r.chunkedEncoding = true;
+  }
+
   r.on('response', (resp: IncomingMessage) => {
     if (locallyAborted) return;
     const headers = new Headers();
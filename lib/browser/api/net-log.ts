@@ -12,9 +12,21 @@ const stopLogging: typeof session.defaultSession.netLog.stopLogging = async () =
   return session.defaultSession.netLog.stopLogging();
 };
 
+const startRingBuffer: typeof session.defaultSession.netLog.startRingBuffer = async (options) => {
+  if (!app.isReady()) return;
+  return session.defaultSession.netLog.startRingBuffer(options);
+};
+
+const dump: typeof session.defaultSession.netLog.dump = async (path, options) => {
+  if (!app.isReady()) return;
+  return session.defaultSession.netLog.dump(path, options);
+};
+
 export default {
   startLogging,
   stopLogging,
+  startRingBuffer,
+  dump,
   get currentlyLogging (): boolean {
     if (!app.isReady()) return false;
     return session.defaultSession.netLog.currentlyLogging;
@@ -9,13 +9,14 @@ const {
 } = process._linkedBinding('electron_browser_power_monitor');
 
 class PowerMonitor extends EventEmitter implements Electron.PowerMonitor {
+  #pm: any;
+
   constructor () {
     super();
     // Don't start the event source until both a) the app is ready and b)
     // there's a listener registered for a powerMonitor event.
     this.once('newListener', () => {
-      const pm = createPowerMonitor();
-      pm.emit = this.emit.bind(this);
+      const pm = this.#getMonitor();
 
       if (process.platform === 'linux') {
         // On Linux, we inhibit shutdown in order to give the app a chance to
@@ -37,6 +38,18 @@ class PowerMonitor extends EventEmitter implements Electron.PowerMonitor {
     });
   }
 
+  #getMonitor () {
+    if (!this.#pm) {
+      this.#pm = createPowerMonitor();
+      this.#pm.emit = this.emit.bind(this);
+    }
+    return this.#pm;
+  }
+
+  setIdleThreshold (idleThreshold: number) {
+    this.#getMonitor().setIdleThreshold(idleThreshold);
+  }
+
   getSystemIdleState (idleThreshold: number) {
     return getSystemIdleState(idleThreshold);
   }
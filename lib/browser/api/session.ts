@@ -1,14 +1,36 @@
 import { fetchWithSession } from '@electron/internal/browser/api/net-fetch';
+import { clearPreloadCodeCaches } from '@electron/internal/browser/preload-code-cache';
+import { makeReadableFromDataPipe } from '@electron/internal/common/data-pipe-stream';
 import { net } from 'electron/main';
-const { fromPartition, fromPath, Session } = process._linkedBinding('electron_browser_session');
+const { fromPartition, fromPath, setSparePartitionCount, Session } = process._linkedBinding('electron_browser_session');
 
 Session.prototype.fetch = function (input: RequestInfo, init?: RequestInit) {
   return fetchWithSession(input, init, this, net.request);
 };
 
+const { clearCodeCaches } = Session.prototype;
+Session.prototype.clearCodeCaches = async function (options: Electron.ClearCodeCachesOptions) {
+  await clearCodeCaches.call(this, options);
+  const codeCacheDir = this._getCodeCachePath();
+  if (codeCacheDir && !options?.urls?.length) {
+    await clearPreloadCodeCaches(codeCacheDir);
+  }
+};
+
+Session.prototype.getBlobDataStream = function (identifier: string) {
+  let finished!: (success: boolean) => void;
+  const done = new Promise<void>((resolve, reject) => {
+    finished = (success) => success ? resolve() : reject(new Error('Could not get blob data'));
+  });
+  // Only observed through the stream, which may be destroyed early.
+  done.catch(() => {});
+  return makeReadableFromDataPipe(this._getBlobDataStream(identifier, finished), done);
+};
+
 export default {
   fromPartition,
   fromPath,
+  setSparePartitionCount,
   get defaultSession () {
     return fromPartition('');
   }
@@ -1,8 +1,12 @@
+import { app } from 'electron/main';
 import { EventEmitter } from 'events';
+import { cpus } from 'os';
 import { Duplex, PassThrough } from 'stream';
 import { Socket } from 'net';
 import { MessagePortMain } from '@electron/internal/browser/message-port-main';
-const { _fork } = process._linkedBinding('electron_browser_utility_process');
+import MessageChannelMain from '@electron/internal/browser/api/message-channel';
+import { makeDuplexFromDataPipe } from '@electron/internal/common/data-pipe-stream';
+const { _fork, _setSpareCount } = process._linkedBinding('electron_browser_utility_process');
 
 class ForkUtilityProcess extends EventEmitter implements Electron.UtilityProcess {
   #handle: ElectronInternal.UtilityProcessWrapper | null;
@@ -50,6 +54,12 @@ class ForkUtilityProcess extends EventEmitter implements Electron.UtilityProcess
       }
     }
 
+    if (options.priority != null) {
+      if (options.priority !== 'normal' && options.priority !== 'background') {
+        throw new TypeError('priority must be one of: normal, background');
+      }
+    }
+
     if (typeof options.stdio === 'string') {
       const stdio : Array<'pipe' | 'ignore' | 'inherit'> = [];
       switch (options.stdio) {
@@ -137,14 +147,220 @@ class ForkUtilityProcess extends EventEmitter implements Electron.UtilityProcess
     return this.#handle?.postMessage(message);
   }
 
+  setPriority (priority: 'normal' | 'background') : void {
+    this.#handle?.setPriority(priority);
+  }
+
+  getMetrics () : Electron.ProcessMetric | null {
+    const pid = this.pid;
+    if (pid === undefined) return null;
+    return app.getAppMetrics().find(metric => metric.pid === pid) ?? null;
+  }
+
+  createStream () : Duplex | null {
+    const pipe = this.#handle?.createStream();
+    return pipe ? makeDuplexFromDataPipe(pipe) : null;
+  }
+
   kill () : boolean {
     if (this.#handle === null) {
       return false;
     }
     return this.#handle.kill();
   }
+
+  static getHandle (child: ForkUtilityProcess) {
+    return child.#handle;
+  }
+}
+
+export function getUtilityProcessHandle (child: Electron.UtilityProcess) {
+  return child instanceof ForkUtilityProcess ? ForkUtilityProcess.getHandle(child) : null;
 }
 
 export function fork (modulePath: string, args?: string[], options?: Electron.ForkOptions) {
   return new ForkUtilityProcess(modulePath, args, options);
 }
+
+type PoolJob = {
+  message: any;
+  transfer?: MessagePortMain[];
+  resolve: (result: any) => void;
+  reject: (error: Error) => void;
+  port?: MessagePortMain;
+};
+
+type PoolWorker = {
+  child: ForkUtilityProcess;
+  jobs: Set<PoolJob>;
+  spawned: boolean;
+};
+
+// Workers that keep exiting before any job completes, like ones crashing at
+// startup, are replaced after a delay that doubles each time, and given up on
+// after this many replacements in a row.
+const kMaxConsecutiveRespawns = 5;
+const kRespawnDelayMs = 50;
+
+// Jobs wait in a single queue that workers take from as they free up, so a
+// long job never holds up the jobs behind it while other workers are idle.
+class UtilityProcessPool extends EventEmitter implements Electron.UtilityProcessPool {
+  #modulePath: string;
+  #args?: string[];
+  #forkOptions: Electron.ForkOptions;
+  #maxInFlight: number;
+  #queue: PoolJob[] = [];
+  #workers: PoolWorker[] = [];
+  #closed = false;
+  #completed = 0;
+  #failed = 0;
+  #respawns = 0;
+  #consecutiveRespawns = 0;
+  #pendingRespawns = 0;
+  // Set once no worker is left to run jobs, which are rejected with it.
+  #startError: Error | null = null;
+
+  constructor (modulePath: string, args?: string[], options?: Electron.CreatePoolOptions) {
+    super();
+
+    if (args != null && typeof args === 'object' && !Array.isArray(args)) {
+      options = args;
+      args = undefined;
+    }
+
+    const { size = cpus().length, maxInFlight = 1, ...forkOptions } = options ?? {};
+    if (!Number.isInteger(size) || size < 1) {
+      throw new TypeError('size must be a positive integer.');
+    }
+    if (!Number.isInteger(maxInFlight) || maxInFlight < 1) {
+      throw new TypeError('maxInFlight must be a positive integer.');
+    }
+
+    this.#modulePath = modulePath;
+    this.#args = args;
+    this.#forkOptions = forkOptions;
+    this.#maxInFlight = maxInFlight;
+    for (let i = 0; i < size; i++) {
+      this.#workers.push(this.#startWorker());
+    }
+  }
+
+  run (message: any, transfer?: MessagePortMain[]): Promise<any> {
+    if (this.#closed) {
+      return Promise.reject(new Error('The pool is closed.'));
+    }
+    if (this.#startError) {
+      return Promise.reject(this.#startError);
+    }
+    return new Promise((resolve, reject) => {
+      this.#queue.push({ message, transfer, resolve, reject });
+      this.#dispatch();
+    });
+  }
+
+  getStats () {
+    let inFlight = 0;
+    for (const worker of this.#workers) inFlight += worker.jobs.size;
+    return {
+      workers: this.#workers.length,
+      queued: this.#queue.length,
+      inFlight,
+      completed: this.#completed,
+      failed: this.#failed,
+      respawns: this.#respawns
+    };
+  }
+
+  close () {
+    if (this.#closed) return;
+    this.#closed = true;
+    for (const job of this.#queue.splice(0)) {
+      job.reject(new Error('The pool is closed.'));
+    }
+    for (const worker of this.#workers) {
+      worker.child.kill();
+    }
+  }
+
+  #startWorker (): PoolWorker {
+    const worker: PoolWorker = {
+      child: new ForkUtilityProcess(this.#modulePath, this.#args, this.#forkOptions),
+      jobs: new Set(),
+      spawned: false
+    };
+    worker.child.once('spawn', () => { worker.spawned = true; });
+    worker.child.once('exit', (code: number) => this.#onWorkerExit(worker, code));
+    return worker;
+  }
+
+  #onWorkerExit (worker: PoolWorker, code: number) {
+    this.#workers.splice(this.#workers.indexOf(worker), 1);
+    for (const job of worker.jobs) {
+      job.port!.close();
+      this.#failed++;
+      job.reject(new Error(`Utility process exited with code ${code} while running the job.`));
+    }
+    worker.jobs.clear();
+
+    if (this.#closed) return;
+    // A worker that could not even start would fail again straight away, so
+    // only replace the ones that crashed after starting.
+    if (worker.spawned && this.#consecutiveRespawns < kMaxConsecutiveRespawns) {
+      const delay = kRespawnDelayMs * 2 ** this.#consecutiveRespawns;
+      this.#consecutiveRespawns++;
+      this.#pendingRespawns++;
+      setTimeout(() => {
+        this.#pendingRespawns--;
+        if (this.#closed) return;
+        this.#respawns++;
+        this.#workers.push(this.#startWorker());
+        this.#dispatch();
+      }, delay);
+    } else if (this.#workers.length === 0 && this.#pendingRespawns === 0) {
+      this.#startError = new Error(worker.spawned
+        ? `Utility process kept exiting, last with code ${code}.`
+        : `Utility process failed to start with code ${code}.`);
+      for (const job of this.#queue.splice(0)) {
+        this.#failed++;
+        job.reject(this.#startError);
+      }
+    }
+  }
+
+  #dispatch () {
+    while (this.#queue.length > 0) {
+      let target: PoolWorker | undefined;
+      for (const worker of this.#workers) {
+        if (worker.jobs.size < this.#maxInFlight && (!target || worker.jobs.size < target.jobs.size)) {
+          target = worker;
+        }
+      }
+      if (!target) return;
+      this.#send(target, this.#queue.shift()!);
+    }
+  }
+
+  #send (worker: PoolWorker, job: PoolJob) {
+    const { port1, port2 } = new MessageChannelMain();
+    job.port = port1;
+    worker.jobs.add(job);
+    port1.once('message', ({ data }: { data: any }) => {
+      if (!worker.jobs.delete(job)) return;
+      port1.close();
+      this.#completed++;
+      this.#consecutiveRespawns = 0;
+      job.resolve(data);
+      this.#dispatch();
+    });
+    port1.start();
+    worker.child.postMessage(job.message, [port2, ...(job.transfer ?? [])]);
+  }
+}
+
+export function setSpareProcessCount (count: number) {
+  _setSpareCount(count);
+}
+
+export function createPool (modulePath: string, args?: string[], options?: Electron.CreatePoolOptions) {
+  return new UtilityProcessPool(modulePath, args, options);
+}
@@ -3,13 +3,16 @@ import type { BrowserWindowConstructorOptions, LoadURLOptions, MessageBoxOptions
 
 import * as url from 'url';
 import * as path from 'path';
+import { pipeline } from 'stream';
+import { createGzip } from 'zlib';
 import { openGuestWindow, makeWebPreferences, parseContentTypeFormat } from '@electron/internal/browser/guest-window-manager';
 import { parseFeatures } from '@electron/internal/browser/parse-features-string';
 import { ipcMainInternal } from '@electron/internal/browser/ipc-main-internal';
 import * as ipcMainUtils from '@electron/internal/browser/ipc-main-internal-utils';
 import { MessagePortMain } from '@electron/internal/browser/message-port-main';
 import { IPC_MESSAGES } from '@electron/internal/common/ipc-messages';
-import { IpcMainImpl } from '@electron/internal/browser/ipc-main-impl';
+import { makeReadableFromDataPipe } from '@electron/internal/common/data-pipe-stream';
+import { IpcMainImpl, scopedInvokeHandlerCounts } from '@electron/internal/browser/ipc-main-impl';
 import * as deprecate from '@electron/internal/common/deprecate';
 
 // session is not used here, the purpose is to make sure session is initialized
@@ -131,6 +134,10 @@ WebContents.prototype.send = function (channel, ...args) {
   return this.mainFrame.send(channel, ...args);
 };
 
+WebContents.prototype.sendWithTransfer = function (channel, transfer, ...args) {
+  return this.mainFrame.sendWithTransfer(channel, transfer, ...args);
+};
+
 WebContents.prototype._sendInternal = function (channel, ...args) {
   return this.mainFrame._sendInternal(channel, ...args);
 };
@@ -187,6 +194,59 @@ WebContents.prototype.executeJavaScriptInIsolatedWorld = async function (worldId
   return ipcMainUtils.invokeInWebContents(this, IPC_MESSAGES.RENDERER_WEB_FRAME_METHOD, 'executeJavaScriptInIsolatedWorld', worldId, code, !!hasUserGesture);
 };
 
+WebContents.prototype.takeHeapSnapshotStream = function (options = {}) {
+  let finished!: (success: boolean) => void;
+  const done = new Promise<void>((resolve, reject) => {
+    finished = (success) => success ? resolve() : reject(new Error('Failed to take heap snapshot'));
+  });
+  // Only observed through the stream, which may be destroyed early.
+  done.catch(() => {});
+  const snapshot = makeReadableFromDataPipe(this._takeHeapSnapshotStream(finished), done);
+  if (!options.compress) return snapshot;
+  // Errors on either stream destroy both, so they reach the caller.
+  return pipeline(snapshot, createGzip(), () => {});
+};
+
+type RegisteredScript = { code: string, worldId: number };
+
+const registeredScripts = new WeakMap<Electron.WebContents, Map<number, RegisteredScript>>();
+let nextScriptId = 0;
+
+const getRegisteredScripts = (webContents: Electron.WebContents) => {
+  let scripts = registeredScripts.get(webContents);
+  if (!scripts) {
+    scripts = new Map();
+    registeredScripts.set(webContents, scripts);
+  }
+  return scripts;
+};
+
+WebContents.prototype.registerScript = async function (code, worldId = 0) {
+  await waitTillCanExecuteJavaScript(this);
+  const id = ++nextScriptId;
+  const script = { code: String(code), worldId: checkType(worldId, 'number', 'worldId') };
+  // Compile right away so that errors surface here rather than on first use.
+  await ipcMainUtils.invokeInWebContents(this, IPC_MESSAGES.RENDERER_WEB_FRAME_METHOD, '_registerScript', id, script.worldId, script.code);
+  getRegisteredScripts(this).set(id, script);
+  return id;
+};
+WebContents.prototype.unregisterScript = function (id) {
+  if (!getRegisteredScripts(this).delete(id)) return;
+  ipcMainUtils.invokeInWebContents(this, IPC_MESSAGES.RENDERER_WEB_FRAME_METHOD, '_unregisterScript', id).catch(() => {});
+};
+WebContents.prototype.executeRegisteredScript = async function (id, ...args) {
+  const script = getRegisteredScripts(this).get(id);
+  if (!script) throw new Error(`No script is registered with handle ${id}`);
+  await waitTillCanExecuteJavaScript(this);
+  let reply = await ipcMainUtils.invokeInWebContents<any>(this, IPC_MESSAGES.RENDERER_EXECUTE_REGISTERED_SCRIPT, id, args);
+  if (!reply.registered) {
+    // The page has navigated since the script was compiled, so compile it
+    // again in the new document.
+    reply = await ipcMainUtils.invokeInWebContents<any>(this, IPC_MESSAGES.RENDERER_EXECUTE_REGISTERED_SCRIPT, id, args, script);
+  }
+  return reply.result;
+};
+
 function checkType<T> (value: T, type: 'number' | 'boolean' | 'string' | 'object', name: string): T {
   // eslint-disable-next-line valid-typeof
   if (typeof value !== type) {
@@ -217,8 +277,7 @@ function parsePageSize (pageSize: string | ElectronInternal.PageSize) {
 
 // Translate the options of printToPDF.
 
-let pendingPromise: Promise<any> | undefined;
-WebContents.prototype.printToPDF = async function (options) {
+function translatePrintToPDFOptions (options: Electron.PrintToPDFOptions) {
   const margins = checkType(options.margins ?? {}, 'object', 'margins');
   const pageSize = parsePageSize(options.pageSize ?? 'letter');
 
@@ -230,7 +289,7 @@ WebContents.prototype.printToPDF = async function (options) {
     throw new Error('margins must be less than or equal to pageSize');
   }
 
-  const printSettings = {
+  return {
     requestID: getNextId(),
     landscape: checkType(options.landscape ?? false, 'boolean', 'landscape'),
     displayHeaderFooter: checkType(options.displayHeaderFooter ?? false, 'boolean', 'displayHeaderFooter'),
@@ -248,17 +307,36 @@ WebContents.prototype.printToPDF = async function (options) {
     generateDocumentOutline: checkType(options.generateDocumentOutline ?? false, 'boolean', 'generateDocumentOutline'),
     ...pageSize
   };
+}
 
-  if (this._printToPDF) {
-    if (pendingPromise) {
-      pendingPromise = pendingPromise.then(() => this._printToPDF(printSettings));
-    } else {
-      pendingPromise = this._printToPDF(printSettings);
-    }
-    return pendingPromise;
-  } else {
+// The print manager of a WebContents generates one PDF at a time, so the
+// requests of each WebContents are queued, while those of different
+// WebContents run in parallel.
+const pendingPrintToPDF = new WeakMap<Electron.WebContents, Promise<any>>();
+function queuePrintToPDF (contents: Electron.WebContents, printSettings: any, filePath?: string) {
+  if (!contents._printToPDF) {
     throw new Error('Printing feature is disabled');
   }
+
+  const run = () => contents._printToPDF(printSettings, filePath);
+  const previous = pendingPrintToPDF.get(contents);
+  // A failed request doesn't fail the ones queued after it.
+  const promise = previous ? previous.then(run, run) : run();
+  pendingPrintToPDF.set(contents, promise);
+  const clear = () => {
+    if (pendingPrintToPDF.get(contents) === promise) pendingPrintToPDF.delete(contents);
+  };
+  promise.then(clear, clear);
+  return promise;
+}
+
+WebContents.prototype.printToPDF = async function (options) {
+  return queuePrintToPDF(this, translatePrintToPDFOptions(options));
+};
+
+WebContents.prototype.printToPDFFile = async function (filePath, options = {}) {
+  checkType(filePath, 'string', 'filePath');
+  await queuePrintToPDF(this, translatePrintToPDFOptions(options), filePath);
 };
 
 // TODO(codebytere): deduplicate argument sanitization by moving rest of
@@ -499,6 +577,39 @@ const addReturnValueToEvent = (event: Electron.IpcMainEvent) => {
   });
 };
 
+const replyWithInvokeError = (event: Electron.IpcMainInvokeEvent, channel: string, error: Error) => {
+  console.error(`Error occurred in handler for '${channel}':`, error);
+  event._replyChannel.sendReply({ error: error.toString() });
+};
+
+const callInvokeHandler = async (event: Electron.IpcMainInvokeEvent, channel: string, handler: (e: Electron.IpcMainInvokeEvent, ...args: any[]) => any, args: any[]) => {
+  try {
+    event._replyChannel.sendReply({ result: await Promise.resolve(handler(event, ...args)) });
+  } catch (err) {
+    replyWithInvokeError(event, channel, err as Error);
+  }
+};
+
+// Lets WebContents::Invoke() call ipcMain's handler for |channel| directly,
+// without emitting '-ipc-invoke', unless a webContents.ipc or webFrameMain.ipc
+// handler for it could take precedence.
+const updateNativeInvokeHandler = (channel: string) => {
+  const handler = (ipcMain as any)._invokeHandlers.get(channel);
+  if (handler && !scopedInvokeHandlerCounts.has(channel)) {
+    binding._setInvokeHandler(channel, function (this: Electron.WebContents, event: Electron.IpcMainInvokeEvent, args: any[]) {
+      addSenderToEvent(event, this);
+      return callInvokeHandler(event, channel, handler, args);
+    });
+  } else {
+    binding._setInvokeHandler(channel, null);
+  }
+};
+
+IpcMainImpl.onInvokeHandlerChanged = updateNativeInvokeHandler;
+for (const channel of (ipcMain as any)._invokeHandlers.keys()) {
+  updateNativeInvokeHandler(channel);
+}
+
 const getWebFrameForEvent = (event: Electron.IpcMainEvent | Electron.IpcMainInvokeEvent) => {
   if (!event.processId || !event.frameId) return null;
   return webFrameMainBinding.fromIdOrNull(event.processId, event.frameId);
@@ -527,7 +638,7 @@ WebContents.prototype._init = function () {
 
   this._windowOpenHandler = null;
 
-  const ipc = new IpcMainImpl();
+  const ipc = new IpcMainImpl({ scoped: true });
   Object.defineProperty(this, 'ipc', {
     get () { return ipc; },
     enumerable: true
@@ -561,23 +672,13 @@ WebContents.prototype._init = function () {
 
   this.on('-ipc-invoke' as any, async function (this: Electron.WebContents, event: Electron.IpcMainInvokeEvent, internal: boolean, channel: string, args: any[]) {
     addSenderToEvent(event, this);
-    const replyWithResult = (result: any) => event._replyChannel.sendReply({ result });
-    const replyWithError = (error: Error) => {
-      console.error(`Error occurred in handler for '${channel}':`, error);
-      event._replyChannel.sendReply({ error: error.toString() });
-    };
     const maybeWebFrame = getWebFrameForEvent(event);
     const targets: (ElectronInternal.IpcMainInternal| undefined)[] = internal ? [ipcMainInternal] : [maybeWebFrame?.ipc, ipc, ipcMain];
     const target = targets.find(target => target && (target as any)._invokeHandlers.has(channel));
     if (target) {
-      const handler = (target as any)._invokeHandlers.get(channel);
-      try {
-        replyWithResult(await Promise.resolve(handler(event, ...args)));
-      } catch (err) {
-        replyWithError(err as Error);
-      }
+      await callInvokeHandler(event, channel, (target as any)._invokeHandlers.get(channel), args);
     } else {
-      replyWithError(new Error(`No handler registered for '${channel}'`));
+      replyWithInvokeError(event, channel, new Error(`No handler registered for '${channel}'`));
     }
   });
 
@@ -898,3 +999,11 @@ export function getFocusedWebContents () {
 export function getAllWebContents () {
   return binding.getAllWebContents();
 }
+
+export function getAllWebContentsInfo () {
+  return binding.getAllWebContentsInfo();
+}
+
+export function getWebContentsInfo (id: number) {
+  return binding.getWebContentsInfo(id);
+}
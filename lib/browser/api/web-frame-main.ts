@@ -5,7 +5,7 @@ const { WebFrameMain, fromId } = process._linkedBinding('electron_browser_web_fr
 
 Object.defineProperty(WebFrameMain.prototype, 'ipc', {
   get () {
-    const ipc = new IpcMainImpl();
+    const ipc = new IpcMainImpl({ scoped: true });
     Object.defineProperty(this, 'ipc', { value: ipc });
     return ipc;
   }
@@ -23,6 +23,18 @@ WebFrameMain.prototype.send = function (channel, ...args) {
   }
 };
 
+WebFrameMain.prototype.sendWithTransfer = function (channel, transfer, ...args) {
+  if (typeof channel !== 'string') {
+    throw new TypeError('Missing required channel argument');
+  }
+
+  try {
+    return this._send(false /* internal */, channel, args, transfer);
+  } catch (e) {
+    console.error('Error sending from webFrameMain: ', e);
+  }
+};
+
 WebFrameMain.prototype._sendInternal = function (channel, ...args) {
   if (typeof channel !== 'string') {
     throw new TypeError('Missing required channel argument');
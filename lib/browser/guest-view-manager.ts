@@ -20,6 +20,37 @@ const supportedWebViewEvents = Object.keys(webViewEvents);
 
 const guestInstances = new Map<number, GuestInstance>();
 const embedderElementsMap = new Map<string, number>();
+// The guests of each embedder, so that the events of an embedder don't have to
+// look through the guests of every other embedder.
+const embedderGuests = new Map<Electron.WebContents, Set<number>>();
+
+// Events of the guests that are to be sent to each embedder. The events
+// emitted while a task runs are sent in one message after it, rather than in
+// one message each. This can't wait for a microtask, since the microtasks run
+// after every event emitted from native code.
+const pendingEvents = new Map<Electron.WebContents, [number, string, Record<string, any>][]>();
+
+const flushPendingEvents = function () {
+  const batches = [...pendingEvents];
+  pendingEvents.clear();
+  for (const [embedder, events] of batches) {
+    if (!embedder.isDestroyed()) {
+      embedder._sendInternal(IPC_MESSAGES.GUEST_VIEW_INTERNAL_DISPATCH_EVENTS, events);
+    }
+  }
+};
+
+const queueEventForEmbedder = function (embedder: Electron.WebContents, viewInstanceId: number, eventName: string, props: Record<string, any>) {
+  if (pendingEvents.size === 0) {
+    setImmediate(flushPendingEvents);
+  }
+  let events = pendingEvents.get(embedder);
+  if (!events) {
+    events = [];
+    pendingEvents.set(embedder, events);
+  }
+  events.push([viewInstanceId, eventName, props]);
+};
 
 function makeWebPreferences (embedder: Electron.WebContents, params: Record<string, any>) {
   // parse the 'webpreferences' attribute string, if set
@@ -132,10 +163,8 @@ const createGuest = function (embedder: Electron.WebContents, embedderFrameId: n
     embedder.emit('did-attach-webview', event, guest);
   });
 
-  const sendToEmbedder = (channel: string, ...args: any[]) => {
-    if (!embedder.isDestroyed()) {
-      embedder._sendInternal(`${channel}-${guest.viewInstanceId}`, ...args);
-    }
+  const sendToEmbedder = (eventName: string, props: Record<string, any>) => {
+    queueEventForEmbedder(embedder, guest.viewInstanceId, eventName, props);
   };
 
   const makeProps = (eventKey: string, args: any[]) => {
@@ -149,13 +178,13 @@ const createGuest = function (embedder: Electron.WebContents, embedderFrameId: n
   // Dispatch events to embedder.
   for (const event of supportedWebViewEvents) {
     guest.on(event as any, function (_, ...args: any[]) {
-      sendToEmbedder(IPC_MESSAGES.GUEST_VIEW_INTERNAL_DISPATCH_EVENT, event, makeProps(event, args));
+      sendToEmbedder(event, makeProps(event, args));
     });
   }
 
   // Dispatch guest's IPC messages to embedder.
   guest.on('ipc-message-host' as any, function (event: Electron.IpcMainEvent, channel: string, args: any[]) {
-    sendToEmbedder(IPC_MESSAGES.GUEST_VIEW_INTERNAL_DISPATCH_EVENT, 'ipc-message', {
+    sendToEmbedder('ipc-message', {
       frameId: [event.processId, event.frameId],
       channel,
       args
@@ -164,7 +193,7 @@ const createGuest = function (embedder: Electron.WebContents, embedderFrameId: n
 
   // Dispatch guest's frame navigation event to embedder.
   guest.on('will-frame-navigate', function (event: Electron.WebContentsWillFrameNavigateEventParams) {
-    sendToEmbedder(IPC_MESSAGES.GUEST_VIEW_INTERNAL_DISPATCH_EVENT, 'will-frame-navigate', {
+    sendToEmbedder('will-frame-navigate', {
       url: event.url,
       isMainFrame: event.isMainFrame,
       frameProcessId: event.frame.processId,
@@ -195,6 +224,7 @@ const createGuest = function (embedder: Electron.WebContents, embedderFrameId: n
   guest.setEmbedder(embedder);
 
   watchEmbedder(embedder);
+  embedderGuests.get(embedder)!.add(guestInstanceId);
 
   webViewManager.addGuest(guestInstanceId, embedder, guest, webPreferences);
   guest.attachToIframe(embedder, embedderFrameId);
@@ -214,6 +244,7 @@ const detachGuest = function (embedder: Electron.WebContents, guestInstanceId: n
 
   webViewManager.removeGuest(embedder, guestInstanceId);
   guestInstances.delete(guestInstanceId);
+  embedderGuests.get(embedder)?.delete(guestInstanceId);
 
   const key = `${embedder.id}-${guestInstance.elementInstanceId}`;
   embedderElementsMap.delete(key);
@@ -221,20 +252,19 @@ const detachGuest = function (embedder: Electron.WebContents, guestInstanceId: n
 
 // Once an embedder has had a guest attached we watch it for destruction to
 // destroy any remaining guests.
-const watchedEmbedders = new Set<Electron.WebContents>();
 const watchEmbedder = function (embedder: Electron.WebContents) {
-  if (watchedEmbedders.has(embedder)) {
+  if (embedderGuests.has(embedder)) {
     return;
   }
-  watchedEmbedders.add(embedder);
+  const guestIds = new Set<number>();
+  embedderGuests.set(embedder, guestIds);
 
   // Forward embedder window visibility change events to guest
   const onVisibilityChange = function (visibilityState: DocumentVisibilityState) {
-    for (const guestInstance of guestInstances.values()) {
+    for (const guestInstanceId of guestIds) {
+      const guestInstance = guestInstances.get(guestInstanceId)!;
       guestInstance.visibilityState = visibilityState;
-      if (guestInstance.embedder === embedder) {
-        guestInstance.guest._sendInternal(IPC_MESSAGES.GUEST_INSTANCE_VISIBILITY_CHANGE, visibilityState);
-      }
+      guestInstance.guest._sendInternal(IPC_MESSAGES.GUEST_INSTANCE_VISIBILITY_CHANGE, visibilityState);
     }
   };
   embedder.on('-window-visibility-change' as any, onVisibilityChange);
@@ -243,14 +273,13 @@ const watchEmbedder = function (embedder: Electron.WebContents) {
     // Usually the guestInstances is cleared when guest is destroyed, but it
     // may happen that the embedder gets manually destroyed earlier than guest,
     // and the embedder will be invalid in the usual code path.
-    for (const [guestInstanceId, guestInstance] of guestInstances) {
-      if (guestInstance.embedder === embedder) {
-        detachGuest(embedder, guestInstanceId);
-      }
+    for (const guestInstanceId of [...guestIds]) {
+      detachGuest(embedder, guestInstanceId);
     }
     // Clear the listeners.
     embedder.removeListener('-window-visibility-change' as any, onVisibilityChange);
-    watchedEmbedders.delete(embedder);
+    embedderGuests.delete(embedder);
+    pendingEvents.delete(embedder);
   });
 };
 
@@ -1,11 +1,21 @@
 import { EventEmitter } from 'events';
 import { IpcMainInvokeEvent } from 'electron/main';
 
+// The number of webContents.ipc and webFrameMain.ipc objects that have an
+// invoke handler for each channel. Their handlers take precedence over the one
+// registered on ipcMain.
+export const scopedInvokeHandlerCounts = new Map<string, number>();
+
 export class IpcMainImpl extends EventEmitter implements Electron.IpcMain {
+  // Called after an invoke handler is added to or removed from any IpcMainImpl.
+  static onInvokeHandlerChanged?: (channel: string) => void;
+
   private _invokeHandlers: Map<string, (e: IpcMainInvokeEvent, ...args: any[]) => void> = new Map();
+  private _scoped: boolean;
 
-  constructor () {
+  constructor ({ scoped = false }: { scoped?: boolean } = {}) {
     super();
+    this._scoped = scoped;
 
     // Do not throw exception when channel name is "error".
     this.on('error', () => {});
@@ -19,6 +29,7 @@ export class IpcMainImpl extends EventEmitter implements Electron.IpcMain {
       throw new TypeError(`Expected handler to be a function, but found type '${typeof fn}'`);
     }
     this._invokeHandlers.set(method, fn);
+    this._invokeHandlerChanged(method, true);
   };
 
   handleOnce: Electron.IpcMain['handleOnce'] = (method, fn) => {
@@ -29,6 +40,20 @@ export class IpcMainImpl extends EventEmitter implements Electron.IpcMain {
   };
 
   removeHandler (method: string) {
-    this._invokeHandlers.delete(method);
+    if (this._invokeHandlers.delete(method)) {
+      this._invokeHandlerChanged(method, false);
+    }
+  }
+
+  private _invokeHandlerChanged (channel: string, added: boolean) {
+    if (this._scoped) {
+      const count = (scopedInvokeHandlerCounts.get(channel) ?? 0) + (added ? 1 : -1);
+      if (count > 0) {
+        scopedInvokeHandlerCounts.set(channel, count);
+      } else {
+        scopedInvokeHandlerCounts.delete(channel);
+      }
+    }
+    IpcMainImpl.onInvokeHandlerChanged?.(channel);
   }
 }
@@ -5,10 +5,32 @@ export class MessagePortMain extends EventEmitter implements Electron.MessagePor
   constructor (internalPort: any) {
     super();
     this._internalPort = internalPort;
-    this._internalPort.emit = (channel: string, event: {ports: any[]}) => {
-      if (channel === 'message') { event = { ...event, ports: event.ports.map(p => new MessagePortMain(p)) }; }
-      this.emit(channel, event);
+    this._internalPort.emit = (channel: string, event: any) => {
+      if (channel === 'message') {
+        this.emit(channel, this._wrapMessageEvent(event));
+      } else if (channel === 'messages') {
+        const events = event.map((e: any) => this._wrapMessageEvent(e));
+        this.emit('messages', events);
+        if (this.listenerCount('message') > 0) {
+          for (const e of events) this.emit('message', e);
+        }
+      } else {
+        this.emit(channel, event);
+      }
     };
+    // Messages are only batched while someone listens for them in batches.
+    this.on('newListener', (event) => {
+      if (event === 'messages' && this.listenerCount('messages') === 0) this._internalPort.setBatching(true);
+    });
+    this.on('removeListener', (event) => {
+      if (event === 'messages' && this.listenerCount('messages') === 0) this._internalPort.setBatching(false);
+    });
+  }
+
+  _wrapMessageEvent (event: { data: any, ports: any[] }) {
+    // Most messages carry no ports, so skip copying the event for them.
+    if (event.ports.length === 0) return event;
+    return { ...event, ports: event.ports.map(p => new MessagePortMain(p)) };
   }
 
   start () {
@@ -0,0 +1,89 @@
+import { wrapPreloadScript } from '@electron/internal/common/preload-wrapper';
+import * as crypto from 'crypto';
+import * as fs from 'fs';
+import * as path from 'path';
+import * as vm from 'vm';
+
+// The code caches of sandboxed preload scripts are made by the browser from the
+// source it read itself, and never taken from renderers, which could otherwise
+// hand a crafted cache to every other renderer that runs the same preload.
+
+// At most this many cache files are kept in a session's cache directory, and
+// at most this many caches in memory, the least recently used being evicted.
+const kMaxCodeCaches = 32;
+
+// Caches read or made so far, by the file each is saved as, in the order they
+// were last used.
+const codeCaches = new Map<string, Buffer>();
+
+const rememberCodeCache = function (codeCachePath: string, codeCache: Buffer) {
+  codeCaches.delete(codeCachePath);
+  codeCaches.set(codeCachePath, codeCache);
+  if (codeCaches.size > kMaxCodeCaches) {
+    codeCaches.delete(codeCaches.keys().next().value!);
+  }
+};
+
+const getCacheDir = (codeCacheDir: string) => path.join(codeCacheDir, 'preload');
+
+// Code caches are keyed by the preload's source and the V8 build they were made
+// with, so that a changed script or runtime never picks up a stale one.
+const getCodeCachePath = function (codeCacheDir: string, preloadSrc: string) {
+  const key = crypto.createHash('sha256')
+    .update(`${process.versions.electron}\0${process.versions.v8}\0`)
+    .update(preloadSrc)
+    .digest('hex');
+  return path.join(getCacheDir(codeCacheDir), key);
+};
+
+// Removes the least recently written files beyond the limit.
+const evictCodeCaches = async function (cacheDir: string) {
+  const names = await fs.promises.readdir(cacheDir);
+  if (names.length <= kMaxCodeCaches) return;
+  const files = await Promise.all(names.map(async (name) => {
+    const file = path.join(cacheDir, name);
+    const { mtimeMs } = await fs.promises.stat(file);
+    return { file, mtimeMs };
+  }));
+  files.sort((a, b) => a.mtimeMs - b.mtimeMs);
+  await Promise.all(files.slice(0, files.length - kMaxCodeCaches).map(({ file }) => {
+    codeCaches.delete(file);
+    return fs.promises.rm(file, { force: true });
+  }));
+};
+
+const makeCodeCache = function (codeCachePath: string, preloadSrc: string) {
+  let codeCache: Buffer;
+  try {
+    codeCache = new vm.Script(wrapPreloadScript(preloadSrc)).createCachedData();
+  } catch {
+    // Let the renderer report the syntax error.
+    return null;
+  }
+  rememberCodeCache(codeCachePath, codeCache);
+  const cacheDir = path.dirname(codeCachePath);
+  fs.promises.mkdir(cacheDir, { recursive: true })
+    .then(() => fs.promises.writeFile(codeCachePath, codeCache, { flag: 'wx' }))
+    .then(() => evictCodeCaches(cacheDir))
+    .catch(() => {});
+  return codeCache;
+};
+
+export const getPreloadCodeCache = async function (codeCacheDir: string, preloadSrc: string) {
+  const codeCachePath = getCodeCachePath(codeCacheDir, preloadSrc);
+  let codeCache = codeCaches.get(codeCachePath);
+  if (!codeCache) {
+    codeCache = await fs.promises.readFile(codeCachePath).catch(() => undefined);
+  }
+  if (!codeCache) return makeCodeCache(codeCachePath, preloadSrc);
+  rememberCodeCache(codeCachePath, codeCache);
+  return codeCache;
+};
+
+export const clearPreloadCodeCaches = async function (codeCacheDir: string) {
+  const cacheDir = getCacheDir(codeCacheDir);
+  for (const codeCachePath of codeCaches.keys()) {
+    if (path.dirname(codeCachePath) === cacheDir) codeCaches.delete(codeCachePath);
+  }
+  await fs.promises.rm(cacheDir, { recursive: true, force: true });
+};
@@ -1,5 +1,6 @@
 import { clipboard } from 'electron/common';
 import * as fs from 'fs';
+import { getPreloadCodeCache } from '@electron/internal/browser/preload-code-cache';
 import { ipcMainInternal } from '@electron/internal/browser/ipc-main-internal';
 import * as ipcMainUtils from '@electron/internal/browser/ipc-main-internal-utils';
 import { IPC_MESSAGES } from '@electron/internal/common/ipc-messages';
@@ -41,22 +42,55 @@ ipcMainUtils.handleSync(IPC_MESSAGES.BROWSER_CLIPBOARD_SYNC, function (event, me
   return (clipboard as any)[method](...args);
 });
 
-const getPreloadScript = async function (preloadPath: string) {
+ipcMainInternal.handle(IPC_MESSAGES.BROWSER_CLIPBOARD_ASYNC, function (event, method: string, ...args: any[]) {
+  if (!allowedClipboardMethods.has(method)) {
+    throw new Error(`Invalid method: ${method}`);
+  }
+
+  return (clipboard as any)[method](...args);
+});
+
+// Sources of the preload scripts read so far, so that opening many windows
+// with the same preloads reads each file once. An entry is used for as long as
+// the modification time and size of its file stay the same.
+const preloadSources = new Map<string, { mtimeMs: number, size: number, source: Promise<string> }>();
+
+const readPreloadSource = async function (preloadPath: string) {
+  const { mtimeMs, size } = await fs.promises.stat(preloadPath);
+  const cached = preloadSources.get(preloadPath);
+  if (cached && cached.mtimeMs === mtimeMs && cached.size === size) {
+    return cached.source;
+  }
+  const source = fs.promises.readFile(preloadPath, 'utf8');
+  preloadSources.set(preloadPath, { mtimeMs, size, source });
+  source.catch(() => {
+    if (preloadSources.get(preloadPath)?.source === source) preloadSources.delete(preloadPath);
+  });
+  return source;
+};
+
+const getPreloadScript = async function (preloadPath: string, codeCacheDir: string | null) {
   let preloadSrc = null;
   let preloadError = null;
+  let preloadCodeCache = null;
   try {
-    preloadSrc = await fs.promises.readFile(preloadPath, 'utf8');
+    preloadSrc = await readPreloadSource(preloadPath);
   } catch (error) {
     preloadError = error;
   }
-  return { preloadPath, preloadSrc, preloadError };
+  if (preloadSrc !== null && codeCacheDir) {
+    preloadCodeCache = await getPreloadCodeCache(codeCacheDir, preloadSrc);
+  }
+  return { preloadPath, preloadSrc, preloadError, preloadCodeCache };
 };
 
 ipcMainUtils.handleSync(IPC_MESSAGES.BROWSER_SANDBOX_LOAD, async function (event) {
   const preloadPaths = event.sender._getPreloadPaths();
+  const codeCacheDir = event.sender.session._getCodeCachePath();
+  const preloadScripts = await Promise.all(preloadPaths.map(preloadPath => getPreloadScript(preloadPath, codeCacheDir)));
 
   return {
-    preloadScripts: await Promise.all(preloadPaths.map(path => getPreloadScript(path))),
+    preloadScripts,
     process: {
       arch: process.arch,
       platform: process.platform,
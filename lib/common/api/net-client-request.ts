@@ -128,18 +128,16 @@ class IncomingMessage extends Readable {
 
 /** Writable stream that buffers up everything written to it. */
 class SlurpStream extends Writable {
-  _data: Buffer;
-  constructor () {
-    super();
-    this._data = Buffer.alloc(0);
-  }
+  // Joined once at the end, as joining them on every write copies the body
+  // over and over.
+  _chunks: Buffer[] = [];
 
   _write (chunk: Buffer, encoding: string, callback: () => void) {
-    this._data = Buffer.concat([this._data, chunk]);
+    this._chunks.push(chunk);
     callback();
   }
 
-  data () { return this._data; }
+  data () { return Buffer.concat(this._chunks); }
 }
 
 class ChunkedBodyStream extends Writable {
@@ -271,6 +269,7 @@ function parseOptions (optionsIn: ClientRequestConstructorOptions | string): Nod
     origin: options.origin,
     referrerPolicy: options.referrerPolicy,
     cache: options.cache,
+    downloadPath: options.downloadPath,
     allowNonHttpProtocols: Object.hasOwn(options, kAllowNonHttpProtocols)
   };
   const headers: Record<string, string | string[]> = options.headers || {};
@@ -394,6 +393,28 @@ export class ClientRequest extends Writable implements Electron.ClientRequest {
     delete this._urlLoaderOptions.headers[key];
   }
 
+  sendFile (filePath: string, options: { offset?: number, length?: number } = {}) {
+    if (typeof filePath !== 'string') {
+      throw new TypeError('`filePath` should be a string');
+    }
+    if (this._started || this._firstWrite) {
+      throw new Error('sendFile() can only be called before the request body is written');
+    }
+    if (this._chunkedEncoding) {
+      throw new Error('sendFile() can not be used with chunked encoding');
+    }
+    const { offset = 0, length = -1 } = options;
+    if (!Number.isInteger(offset) || offset < 0) {
+      throw new TypeError('`offset` should be a non-negative integer');
+    }
+    if (!Number.isInteger(length) || length < -1) {
+      throw new TypeError('`length` should be a non-negative integer');
+    }
+    this._firstWrite = true;
+    this._urlLoaderOptions.bodyFile = { path: filePath, offset, length };
+    return this.end();
+  }
+
   _write (chunk: Buffer, encoding: BufferEncoding, callback: () => void) {
     this._firstWrite = true;
     if (!this._body) {
@@ -0,0 +1,262 @@
+import type { ProtocolRequest } from 'electron/main';
+import { createReadStream } from 'fs';
+import { Readable } from 'stream';
+import { ReadableStream } from 'stream/web';
+
+const ERR_FAILED = -2;
+const ERR_UNEXPECTED = -9;
+
+export type BlobDataGetter = (blobUUID: string) => Readable;
+
+export type ProtocolHandlerOptions = { cache?: boolean };
+
+// Total size of the bodies a handler's cache keeps, and the size of the
+// largest one it takes.
+const kMaxCacheSize = 64 * 1024 * 1024;
+const kMaxCachedBodySize = 8 * 1024 * 1024;
+
+type CachedResponse = {
+  expires: number;
+  data: Buffer;
+  headers: Record<string, string>;
+  statusCode: number;
+  statusText: string;
+  mimeType?: string;
+};
+
+function parseCacheControl (value: string | null) {
+  return value ? value.toLowerCase().split(',').map(directive => directive.trim()) : [];
+}
+
+// Returns how many seconds a response may be reused for, following its
+// Cache-Control header.
+function getMaxAge (headers: Headers) {
+  const directives = parseCacheControl(headers.get('cache-control'));
+  if (directives.includes('no-store') || directives.includes('no-cache')) return 0;
+  const maxAge = directives.find(directive => directive.startsWith('max-age='));
+  return maxAge ? parseInt(maxAge.slice('max-age='.length), 10) || 0 : 0;
+}
+
+// Keeps responses in memory for as long as their Cache-Control allows, so that
+// repeated requests are answered without calling the handler again. The least
+// recently used responses are dropped first.
+class ResponseCache {
+  #entries = new Map<string, CachedResponse>();
+  #size = 0;
+
+  static isCacheable (req: Request) {
+    if (req.method !== 'GET' || req.headers.has('range')) return false;
+    const directives = parseCacheControl(req.headers.get('cache-control'));
+    return !directives.includes('no-store') && !directives.includes('no-cache') &&
+      req.headers.get('pragma') !== 'no-cache';
+  }
+
+  get (url: string) {
+    const entry = this.#entries.get(url);
+    if (!entry) return null;
+    this.#delete(url, entry);
+    if (entry.expires <= Date.now()) return null;
+    this.#entries.set(url, entry);
+    this.#size += entry.data.length;
+    return entry;
+  }
+
+  set (url: string, entry: CachedResponse) {
+    if (entry.data.length > kMaxCachedBodySize) return;
+    const existing = this.#entries.get(url);
+    if (existing) this.#delete(url, existing);
+    this.#entries.set(url, entry);
+    this.#size += entry.data.length;
+    for (const [oldestUrl, oldest] of this.#entries) {
+      if (this.#size <= kMaxCacheSize) break;
+      this.#delete(oldestUrl, oldest);
+    }
+  }
+
+  #delete (url: string, entry: CachedResponse) {
+    this.#entries.delete(url);
+    this.#size -= entry.data.length;
+  }
+}
+
+// Reads |body| while it fits in |limit| bytes. Returns the whole body when it
+// does, or else a stream of the chunks read so far followed by the rest of it.
+async function readBodyWithin (body: ReadableStream<Uint8Array>, limit: number) {
+  const reader = body.getReader();
+  const chunks: Uint8Array[] = [];
+  let size = 0;
+  while (size <= limit) {
+    const { done, value } = await reader.read();
+    if (done) return { data: Buffer.concat(chunks, size) };
+    chunks.push(value);
+    size += value.byteLength;
+  }
+  const rest = async function * () {
+    let finished = false;
+    try {
+      yield * chunks;
+      while (true) {
+        const { done, value } = await reader.read();
+        if (done) break;
+        yield value;
+      }
+      finished = true;
+    } finally {
+      if (!finished) reader.cancel().catch(() => {});
+    }
+  };
+  return { stream: Readable.from(rest(), { objectMode: false }) };
+}
+
+function makeStreamFromPipe (pipe: any): ReadableStream {
+  const buf = new Uint8Array(1024 * 1024 /* 1 MB */);
+  return new ReadableStream({
+    async pull (controller) {
+      try {
+        const rv = await pipe.read(buf);
+        if (rv > 0) {
+          controller.enqueue(buf.subarray(0, rv));
+        } else {
+          controller.close();
+        }
+      } catch (e) {
+        controller.error(e);
+      }
+    }
+  });
+}
+
+function makeStreamFromFileInfo ({
+  filePath,
+  offset = 0,
+  length = -1
+}: {
+  filePath: string;
+  offset?: number;
+  length?: number;
+}): ReadableStream {
+  return Readable.toWeb(createReadStream(filePath, {
+    start: offset,
+    end: length >= 0 ? offset + length : undefined
+  }));
+}
+
+function convertToRequestBody (uploadData: ProtocolRequest['uploadData'], getBlobData?: BlobDataGetter): RequestInit['body'] {
+  if (!uploadData) return null;
+  // Optimization: skip creating a stream if the request is just a single buffer.
+  if (uploadData.length === 1 && (uploadData[0] as any).type === 'rawData') return uploadData[0].bytes;
+
+  const chunks = [...uploadData] as any[]; // TODO: types are wrong
+  let current: ReadableStreamDefaultReader | null = null;
+  return new ReadableStream({
+    async pull (controller) {
+      if (current) {
+        const { done, value } = await current.read();
+        // (done => value === undefined) as per WHATWG spec
+        if (done) {
+          current = null;
+          return this.pull!(controller);
+        } else {
+          controller.enqueue(value);
+        }
+      } else {
+        if (!chunks.length) { return controller.close(); }
+        const chunk = chunks.shift()!;
+        if (chunk.type === 'rawData') {
+          controller.enqueue(chunk.bytes);
+        } else if (chunk.type === 'file') {
+          current = makeStreamFromFileInfo(chunk).getReader();
+          return this.pull!(controller);
+        } else if (chunk.type === 'stream') {
+          current = makeStreamFromPipe(chunk.body).getReader();
+          return this.pull!(controller);
+        } else if (chunk.type === 'blob' && getBlobData) {
+          current = Readable.toWeb(getBlobData(chunk.blobUUID)).getReader();
+          return this.pull!(controller);
+        } else {
+          throw new Error(`Unknown upload data chunk type: ${chunk.type}`);
+        }
+      }
+    }
+  }) as RequestInit['body'];
+}
+
+function validateResponse (res: Response) {
+  if (!res || typeof res !== 'object') return false;
+
+  if (res.type === 'error') return true;
+
+  const exists = (key: string) => Object.hasOwn(res, key);
+
+  if (exists('status') && typeof res.status !== 'number') return false;
+  if (exists('statusText') && typeof res.statusText !== 'string') return false;
+  if (exists('headers') && typeof res.headers !== 'object') return false;
+
+  if (exists('body')) {
+    if (typeof res.body !== 'object') return false;
+    if (res.body !== null && !(res.body instanceof ReadableStream)) return false;
+  }
+
+  return true;
+}
+
+// Adapts a protocol.handle() handler, which takes a Request and returns a
+// Response, to the native registerProtocol() callback. Blob upload data is
+// only supported when |getBlobData| is given.
+export function wrapProtocolHandler (handler: (req: Request) => Response | Promise<Response>, getBlobData?: BlobDataGetter, options?: ProtocolHandlerOptions) {
+  const cache = options?.cache ? new ResponseCache() : null;
+  return async (preq: ProtocolRequest, cb: any) => {
+    try {
+      const body = convertToRequestBody(preq.uploadData, getBlobData);
+      const headers = new Headers(preq.headers);
+      if (headers.get('origin') === 'null') {
+        headers.delete('origin');
+      }
+      const req = new Request(preq.url, {
+        headers,
+        method: preq.method,
+        referrer: preq.referrer,
+        body,
+        duplex: body instanceof ReadableStream ? 'half' : undefined
+      } as any);
+      const useCache = cache && ResponseCache.isCacheable(req);
+      const cached = useCache && cache!.get(req.url);
+      if (cached) {
+        const { expires, ...response } = cached;
+        return cb(response);
+      }
+      const res = await handler(req);
+      if (!validateResponse(res)) {
+        return cb({ error: ERR_UNEXPECTED });
+      } else if (res.type === 'error') {
+        cb({ error: ERR_FAILED });
+      } else {
+        const response = {
+          headers: res.headers ? Object.fromEntries(res.headers) : {},
+          statusCode: res.status,
+          statusText: res.statusText,
+          mimeType: (res as any).__original_resp?._responseHead?.mimeType
+        };
+        const maxAge = useCache && res.status === 200 && res.headers && !res.headers.has('vary') ? getMaxAge(res.headers) : 0;
+        const contentLength = maxAge > 0 ? Number(res.headers.get('content-length') ?? 0) : 0;
+        if (maxAge > 0 && !(contentLength > kMaxCachedBodySize)) {
+          // Bodies are only buffered up to the size that the cache takes.
+          const body = res.body
+            ? await readBodyWithin(res.body as ReadableStream<Uint8Array>, kMaxCachedBodySize)
+            : { data: Buffer.alloc(0) };
+          if ('data' in body) {
+            cache!.set(req.url, { expires: Date.now() + maxAge * 1000, data: body.data, ...response });
+            cb({ data: body.data, ...response });
+          } else {
+            cb({ data: body.stream, ...response });
+          }
+        } else {
+          cb({ data: res.body ? Readable.fromWeb(res.body as ReadableStream<ArrayBufferView>) : null, ...response });
+        }
+      }
+    } catch (e) {
+      console.error(e);
+      cb({ error: ERR_UNEXPECTED });
+    }
+  };
+}
@@ -0,0 +1,72 @@
+import { Duplex, Readable } from 'stream';
+
+// Matches the capacity of the pipes, so that a read can drain a full pipe.
+const kReadSize = 1024 * 1024;
+
+// Returns a function that reads the next chunk from |pipe|, or null once it
+// has ended. Reads go into one scratch buffer per stream. Chunks that fill most
+// of it are handed out as they are, and the scratch buffer replaced, while
+// smaller ones are copied out, so that a few bytes never keep a whole
+// megabyte alive.
+function makeChunkReader (pipe: ElectronInternal.DataPipeStream) {
+  let scratch: Buffer | null = null;
+  return async function readChunk () {
+    if (!scratch) scratch = Buffer.allocUnsafe(kReadSize);
+    const buffer = scratch;
+    const length = await pipe.read(buffer);
+    if (length === 0) return null;
+    if (length > kReadSize / 2) {
+      scratch = null;
+      return buffer.subarray(0, length);
+    }
+    return Buffer.from(buffer.subarray(0, length));
+  };
+}
+
+// Wraps one end of a native byte stream to another process. Reads stop while
+// nothing is consuming the Duplex and writes wait while the pipe is full, so
+// backpressure carries across the process boundary.
+export function makeDuplexFromDataPipe (pipe: ElectronInternal.DataPipeStream): Duplex {
+  const readChunk = makeChunkReader(pipe);
+  return new Duplex({
+    read () {
+      readChunk().then((chunk) => {
+        this.push(chunk);
+      }, (error) => this.destroy(error));
+    },
+    write (chunk: Buffer, encoding, callback) {
+      pipe.write(chunk).then(() => callback(), callback);
+    },
+    final (callback) {
+      pipe.end();
+      callback();
+    },
+    destroy (error, callback) {
+      pipe.close();
+      callback(error);
+    }
+  });
+}
+
+// Wraps the reading end of a native byte stream. When |done| is given the
+// stream only ends once it resolves, and fails if it rejects, for producers
+// that report separately whether they wrote everything.
+export function makeReadableFromDataPipe (pipe: ElectronInternal.DataPipeStream, done?: Promise<void>): Readable {
+  const readChunk = makeChunkReader(pipe);
+  return new Readable({
+    read () {
+      readChunk().then(async (chunk) => {
+        if (chunk) {
+          this.push(chunk);
+        } else {
+          await done;
+          this.push(null);
+        }
+      }).catch((error) => this.destroy(error));
+    },
+    destroy (error, callback) {
+      pipe.close();
+      callback(error);
+    }
+  });
+}
@@ -1,7 +1,15 @@
-const handleESModule = (loader: ElectronInternal.ModuleLoader) => () => {
-  const value = loader();
-  if (value.__esModule && value.default) return value.default;
-  return value;
+// Loads the module on first access only, and returns the same value after.
+const handleESModule = (loader: ElectronInternal.ModuleLoader) => {
+  let value: any;
+  let loaded = false;
+  return () => {
+    if (!loaded) {
+      value = loader();
+      if (value.__esModule && value.default) value = value.default;
+      loaded = true;
+    }
+    return value;
+  };
 };
 
 // Attaches properties to |targetExports|.
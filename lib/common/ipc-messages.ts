@@ -1,5 +1,6 @@
 export const enum IPC_MESSAGES {
   BROWSER_CLIPBOARD_SYNC = 'BROWSER_CLIPBOARD_SYNC',
+  BROWSER_CLIPBOARD_ASYNC = 'BROWSER_CLIPBOARD_ASYNC',
   BROWSER_GET_LAST_WEB_PREFERENCES = 'BROWSER_GET_LAST_WEB_PREFERENCES',
   BROWSER_PRELOAD_ERROR = 'BROWSER_PRELOAD_ERROR',
   BROWSER_SANDBOX_LOAD = 'BROWSER_SANDBOX_LOAD',
@@ -9,7 +10,7 @@ export const enum IPC_MESSAGES {
 
   GUEST_INSTANCE_VISIBILITY_CHANGE = 'GUEST_INSTANCE_VISIBILITY_CHANGE',
 
-  GUEST_VIEW_INTERNAL_DISPATCH_EVENT = 'GUEST_VIEW_INTERNAL_DISPATCH_EVENT',
+  GUEST_VIEW_INTERNAL_DISPATCH_EVENTS = 'GUEST_VIEW_INTERNAL_DISPATCH_EVENTS',
 
   GUEST_VIEW_MANAGER_CREATE_AND_ATTACH_GUEST = 'GUEST_VIEW_MANAGER_CREATE_AND_ATTACH_GUEST',
   GUEST_VIEW_MANAGER_DETACH_GUEST = 'GUEST_VIEW_MANAGER_DETACH_GUEST',
@@ -19,6 +20,7 @@ export const enum IPC_MESSAGES {
   GUEST_VIEW_MANAGER_PROPERTY_SET = 'GUEST_VIEW_MANAGER_PROPERTY_SET',
 
   RENDERER_WEB_FRAME_METHOD = 'RENDERER_WEB_FRAME_METHOD',
+  RENDERER_EXECUTE_REGISTERED_SCRIPT = 'RENDERER_EXECUTE_REGISTERED_SCRIPT',
 
   INSPECTOR_CONFIRM = 'INSPECTOR_CONFIRM',
   INSPECTOR_CONTEXT_MENU = 'INSPECTOR_CONTEXT_MENU',
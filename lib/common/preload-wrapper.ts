@@ -0,0 +1,16 @@
+// Wraps a sandboxed preload script into a function executed in global scope.
+// It won't have access to the current scope, so a few objects are exposed as
+// arguments:
+//
+// - `require`: The `preloadRequire` function
+// - `process`: The `preloadProcess` object
+// - `Buffer`: Shim of `Buffer` implementation
+// - `global`: The window object, which is aliased to `global` by webpack.
+//
+// The browser compiles the same source to make the code caches of preloads, so
+// both have to wrap it in exactly the same way.
+export function wrapPreloadScript (preloadSrc: string) {
+  return `(function(require, process, Buffer, global, setImmediate, clearImmediate, exports, module) {
+  ${preloadSrc}
+  })`;
+}
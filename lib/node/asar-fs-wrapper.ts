@@ -5,6 +5,7 @@ import * as util from 'util';
 
 import type * as Crypto from 'crypto';
 import type * as os from 'os';
+import type * as Zlib from 'zlib';
 
 const asar = process._linkedBinding('electron_common_asar');
 
@@ -117,6 +118,19 @@ const fileTypeToMode = new Map<AsarFileType, number>([
   [AsarFileType.kLink, constants.S_IFLNK]
 ]);
 
+// Stats every entry of an archive directory with a single call into the
+// archive. Returns the type of each entry, or the name of the first missing one.
+const getAsarDirentTypes = function (archive: NodeJS.AsarArchive, filePath: string, files: string[]) {
+  const stats = archive.statBatch(files.map(file => path.join(filePath, file)));
+  const types: AsarFileType[] = [];
+  for (let i = 0; i < files.length; i++) {
+    const type = stats ? stats[i * 3] : -1;
+    if (type === -1) return { types, missing: files[i] };
+    types.push(type);
+  }
+  return { types, missing: null };
+};
+
 const asarStatsToFsStats = function (stats: NodeJS.AsarFileStat) {
   const { Stats } = require('fs');
 
@@ -241,7 +255,12 @@ const overrideAPI = function (module: Record<string, any>, name: string, pathArg
   }
 };
 
+const isUtf8Encoding = (encoding: string | null | undefined) => {
+  return encoding === 'utf8' || encoding === 'utf-8';
+};
+
 let crypto: typeof Crypto;
+let zlib: typeof Zlib;
 function validateBufferIntegrity (buffer: Buffer, integrity: NodeJS.AsarFileInfo['integrity']) {
   if (!integrity) return;
 
@@ -574,6 +593,33 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
     }
   };
 
+  // Reads the blocks of a compressed file from the archive and decompresses
+  // them on the thread pool, so that async reads don't block the caller.
+  // Resolves with false if the file can't be decompressed.
+  const readCompressedAsync = async function (fd: number, info: NodeJS.AsarFileInfo) {
+    const { blocks } = info.compression!;
+    const compressed = Buffer.alloc(blocks.reduce((total, size) => total + size, 0));
+    const { bytesRead } = await util.promisify(fs.read)(fd, compressed, 0, compressed.length, info.offset);
+    if (bytesRead !== compressed.length) return false;
+
+    // Delay load zlib, which only compressed files need.
+    zlib = zlib || require('zlib');
+    const brotliDecompress = util.promisify(zlib.brotliDecompress);
+    const pending: Promise<Buffer>[] = [];
+    let offset = 0;
+    for (const size of blocks) {
+      pending.push(brotliDecompress(compressed.subarray(offset, offset + size)));
+      offset += size;
+    }
+    let buffer: Buffer;
+    try {
+      buffer = Buffer.concat(await Promise.all(pending));
+    } catch {
+      return false;
+    }
+    return buffer.length === info.size ? buffer : false;
+  };
+
   function fsReadFileAsar (pathArgument: string, options: any, callback: any) {
     const pathInfo = splitPath(pathArgument);
     if (pathInfo.isAsar) {
@@ -615,7 +661,6 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
         return fs.readFile(realPath, options, callback);
       }
 
-      const buffer = Buffer.alloc(info.size);
       const fd = archive.getFdAndValidateIntegrityLater();
       if (!(fd >= 0)) {
         const error = createError(AsarError.NOT_FOUND, { asarPath, filePath });
@@ -624,6 +669,20 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
       }
 
       logASARAccess(asarPath, filePath, info.offset);
+
+      if (info.compression) {
+        readCompressedAsync(fd, info).then((buffer) => {
+          if (buffer === false) {
+            callback(createError(AsarError.NOT_FOUND, { asarPath, filePath }));
+            return;
+          }
+          validateBufferIntegrity(buffer, info.integrity);
+          callback(null, encoding ? buffer.toString(encoding) : buffer);
+        }, (error) => callback(error));
+        return;
+      }
+
+      const buffer = Buffer.alloc(info.size);
       fs.read(fd, buffer, 0, info.size, info.offset, (error: Error) => {
         validateBufferIntegrity(buffer, info.integrity);
         callback(error, encoding ? buffer.toString(encoding) : buffer);
@@ -679,12 +738,30 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
     }
 
     const { encoding } = options;
-    const buffer = Buffer.alloc(info.size);
-    const fd = archive.getFdAndValidateIntegrityLater();
-    if (!(fd >= 0)) throw createError(AsarError.NOT_FOUND, { asarPath, filePath });
-
     logASARAccess(asarPath, filePath, info.offset);
-    fs.readSync(fd, buffer, 0, info.size, info.offset);
+
+    if (info.compression) {
+      const buffer = archive.readCompressed(filePath);
+      if (buffer === false) throw createError(AsarError.NOT_FOUND, { asarPath, filePath });
+      validateBufferIntegrity(buffer, info.integrity);
+      return (encoding) ? buffer.toString(encoding) : buffer;
+    }
+
+    // Serve straight from the archive's mapping when possible, decoding UTF-8
+    // without an intermediate Buffer. Integrity has to be checked on the raw
+    // bytes, so that case always goes through a Buffer.
+    if (isUtf8Encoding(encoding) && !info.integrity) {
+      const str = archive.readString(info.offset, info.size);
+      if (str !== false) return str;
+    }
+
+    let buffer = archive.readBuffer(info.offset, info.size);
+    if (buffer === false) {
+      buffer = Buffer.alloc(info.size);
+      const fd = archive.getFdAndValidateIntegrityLater();
+      if (!(fd >= 0)) throw createError(AsarError.NOT_FOUND, { asarPath, filePath });
+      fs.readSync(fd, buffer, 0, info.size, info.offset);
+    }
     validateBufferIntegrity(buffer, info.integrity);
     return (encoding) ? buffer.toString(encoding) : buffer;
   };
@@ -728,18 +805,13 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
     }
 
     if (options?.withFileTypes) {
-      const dirents = [];
-      for (const file of files) {
-        const childPath = path.join(filePath, file);
-        const stats = archive.stat(childPath);
-        if (!stats) {
-          const error = createError(AsarError.NOT_FOUND, { asarPath, filePath: childPath });
-          nextTick(callback!, [error]);
-          return;
-        }
-        dirents.push(new fs.Dirent(file, stats.type));
+      const { types, missing } = getAsarDirentTypes(archive, filePath, files);
+      if (missing !== null) {
+        const error = createError(AsarError.NOT_FOUND, { asarPath, filePath: path.join(filePath, missing) });
+        nextTick(callback!, [error]);
+        return;
       }
-      nextTick(callback!, [null, dirents]);
+      nextTick(callback!, [null, files.map((file: string, i: number) => new fs.Dirent(file, types[i]))]);
       return;
     }
 
@@ -774,16 +846,11 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
     }
 
     if (options?.withFileTypes) {
-      const dirents = [];
-      for (const file of files) {
-        const childPath = path.join(filePath, file);
-        const stats = archive.stat(childPath);
-        if (!stats) {
-          throw createError(AsarError.NOT_FOUND, { asarPath, filePath: childPath });
-        }
-        dirents.push(new fs.Dirent(file, stats.type));
+      const { types, missing } = getAsarDirentTypes(archive, filePath, files);
+      if (missing !== null) {
+        throw createError(AsarError.NOT_FOUND, { asarPath, filePath: path.join(filePath, missing) });
       }
-      return Promise.resolve(dirents);
+      return Promise.resolve(files.map((file: string, i: number) => new fs.Dirent(file, types[i])));
     }
 
     return Promise.resolve(files);
@@ -817,16 +884,11 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
     }
 
     if (options?.withFileTypes) {
-      const dirents = [];
-      for (const file of files) {
-        const childPath = path.join(filePath, file);
-        const stats = archive.stat(childPath);
-        if (!stats) {
-          throw createError(AsarError.NOT_FOUND, { asarPath, filePath: childPath });
-        }
-        dirents.push(new fs.Dirent(file, stats.type));
+      const { types, missing } = getAsarDirentTypes(archive, filePath, files);
+      if (missing !== null) {
+        throw createError(AsarError.NOT_FOUND, { asarPath, filePath: path.join(filePath, missing) });
       }
-      return dirents;
+      return files.map((file: string, i: number) => new fs.Dirent(file, types[i]));
     }
 
     return files;
@@ -851,12 +913,27 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
       return [str, str.length > 0];
     }
 
-    const buffer = Buffer.alloc(info.size);
-    const fd = archive.getFdAndValidateIntegrityLater();
-    if (!(fd >= 0)) return [];
-
     logASARAccess(asarPath, filePath, info.offset);
-    fs.readSync(fd, buffer, 0, info.size, info.offset);
+    if (info.compression) {
+      const buffer = archive.readCompressed(filePath);
+      if (buffer === false) return [];
+      validateBufferIntegrity(buffer, info.integrity);
+      const str = buffer.toString('utf8');
+      return [str, str.length > 0];
+    }
+
+    if (!info.integrity) {
+      const str = archive.readString(info.offset, info.size);
+      if (str !== false) return [str, str.length > 0];
+    }
+
+    let buffer = archive.readBuffer(info.offset, info.size);
+    if (buffer === false) {
+      buffer = Buffer.alloc(info.size);
+      const fd = archive.getFdAndValidateIntegrityLater();
+      if (!(fd >= 0)) return [];
+      fs.readSync(fd, buffer, 0, info.size, info.offset);
+    }
     validateBufferIntegrity(buffer, info.integrity);
     const str = buffer.toString('utf8');
     return [str, str.length > 0];
@@ -879,6 +956,37 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
     return (stats.type === AsarFileType.kDirectory) ? 1 : 0;
   };
 
+  // Resolves relative and absolute requests that land in an archive with a
+  // single lookup in the archive's index, instead of a stat per candidate
+  // file. Anything the archive can't resolve on its own, including misses, is
+  // left to Node, which then only has to stat the resolved file.
+  const { _findPath } = Module;
+  Module._findPath = function (request: string, paths: string[], isMain: boolean) {
+    if (!Array.isArray(paths) || paths.length !== 1 || request.length === 0 ||
+        /[\\/.]$/.test(request) || !(path.isAbsolute(request) || /^\.\.?[\\/]/.test(request))) {
+      return _findPath.apply(this, arguments);
+    }
+
+    const cacheKey = request + '\x00' + paths[0];
+    const cached = Module._pathCache[cacheKey];
+    if (cached) return cached;
+
+    const pathInfo = splitPath(path.resolve(paths[0], request));
+    if (pathInfo.isAsar) {
+      const archive = getOrCreateArchive(pathInfo.asarPath);
+      const resolved = archive && archive.resolveModule(pathInfo.filePath, Object.keys(Module._extensions));
+      if (resolved) {
+        const filename = _findPath.call(this, path.join(pathInfo.asarPath, resolved), [''], isMain);
+        if (filename) {
+          Module._pathCache[cacheKey] = filename;
+          return filename;
+        }
+      }
+    }
+
+    return _findPath.apply(this, arguments);
+  };
+
   async function readdirRecursive (originalPath: string, options: ReaddirOptions) {
     const result: any[] = [];
 
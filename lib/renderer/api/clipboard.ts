@@ -1,4 +1,5 @@
 import { IPC_MESSAGES } from '@electron/internal/common/ipc-messages';
+import { ipcRendererInternal } from '@electron/internal/renderer/ipc-renderer-internal';
 import * as ipcRendererUtils from '@electron/internal/renderer/ipc-renderer-internal-utils';
 
 const clipboard = process._linkedBinding('electron_common_clipboard');
@@ -12,6 +13,8 @@ if (process.platform === 'linux') {
   for (const method of Object.keys(clipboard) as (keyof Electron.Clipboard)[]) {
     clipboard[method] = makeRemoteMethod(method);
   }
+  // Reaching the main process synchronously would block on the decoding.
+  clipboard.readImageAsync = (...args: any[]) => ipcRendererInternal.invoke(IPC_MESSAGES.BROWSER_CLIPBOARD_ASYNC, 'readImageAsync', ...args);
 } else if (process.platform === 'darwin') {
   // Read/write to find pasteboard over IPC since only main process is notified of changes
   clipboard.readFindText = makeRemoteMethod('readFindText');
@@ -5,6 +5,10 @@ export default {
     binding.addExtraParameter(key, value);
   },
 
+  addExtraParameters (parameters: Record<string, string>) {
+    binding.addExtraParameters(parameters);
+  },
+
   removeExtraParameter (key: string) {
     binding.removeExtraParameter(key);
   },
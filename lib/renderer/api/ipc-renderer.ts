@@ -3,15 +3,71 @@ import { EventEmitter } from 'events';
 const { ipc } = process._linkedBinding('electron_renderer_ipc');
 
 const internal = false;
+
+// Batches are flushed on the next animation frame, or as soon as they reach
+// this many messages.
+const kMaxBatchLength = 1000;
+const batches = new Map<string, any[][]>();
+let flushScheduled = false;
+
+function flushBatches () {
+  flushScheduled = false;
+  for (const [channel, messages] of batches) {
+    ipc.send(internal, channel, [messages]);
+  }
+  batches.clear();
+}
+
+function scheduleFlush () {
+  if (flushScheduled) return;
+  flushScheduled = true;
+  // Animation frames don't run in hidden pages.
+  if (typeof requestAnimationFrame === 'function' && document.visibilityState === 'visible') {
+    requestAnimationFrame(flushBatches);
+  } else {
+    setTimeout(flushBatches, 16);
+  }
+}
+
 class IpcRenderer extends EventEmitter implements Electron.IpcRenderer {
   send (channel: string, ...args: any[]) {
     return ipc.send(internal, channel, args);
   }
 
+  sendWithTransfer (channel: string, transfer: ArrayBuffer[], ...args: any[]) {
+    return ipc.send(internal, channel, args, transfer);
+  }
+
+  sendBatched (channel: string, ...args: any[]) {
+    let messages = batches.get(channel);
+    if (!messages) {
+      messages = [];
+      batches.set(channel, messages);
+    }
+    messages.push(args);
+    if (messages.length >= kMaxBatchLength) {
+      batches.delete(channel);
+      ipc.send(internal, channel, [messages]);
+    } else {
+      scheduleFlush();
+    }
+  }
+
   sendSync (channel: string, ...args: any[]) {
     return ipc.sendSync(internal, channel, args);
   }
 
+  sendSyncWithTimeout (channel: string, timeout: number, ...args: any[]) {
+    if (typeof timeout !== 'number' || !(timeout >= 0)) {
+      throw new TypeError('Expected timeout to be a non-negative number');
+    }
+    return ipc.sendSync(internal, channel, args, timeout);
+  }
+
+  getSyncMessageStats () {
+    return ipc.getSyncMessageStats();
+  }
+
   sendToHost (channel: string, ...args: any[]) {
     return ipc.sendToHost(channel, args);
   }
@@ -24,6 +80,14 @@ class IpcRenderer extends EventEmitter implements Electron.IpcRenderer {
     return result;
   }
 
+  async invokeWithTransfer (channel: string, transfer: ArrayBuffer[], ...args: any[]) {
+    const { error, result } = await ipc.invoke(internal, channel, args, transfer);
+    if (error) {
+      throw new Error(`Error invoking remote method '${channel}': ${error}`);
+    }
+    return result;
+  }
+
   postMessage (channel: string, message: any, transferables: any) {
     return ipc.postMessage(channel, message, transferables);
   }
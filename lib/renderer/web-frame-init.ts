@@ -18,4 +18,18 @@ export const webFrameInit = () => {
     // will be caught by "keyof WebFrameMethod" though.
     return (webFrame[method] as any)(...args);
   });
+
+  // Call a script registered with webContents.registerScript(). The browser
+  // only sends the script's source along when it has not been compiled in the
+  // current document yet.
+  ipcRendererUtils.handle(IPC_MESSAGES.RENDERER_EXECUTE_REGISTERED_SCRIPT, async (
+    event, id: number, args: any[], script?: { code: string, worldId: number }
+  ) => {
+    if (script) {
+      webFrame._registerScript(id, script.worldId, script.code);
+    } else if (!webFrame._hasRegisteredScript(id)) {
+      return { registered: false };
+    }
+    return { registered: true, result: await webFrame._executeRegisteredScript(id, args) };
+  });
 };
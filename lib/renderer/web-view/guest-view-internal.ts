@@ -8,14 +8,27 @@ export interface GuestViewDelegate {
   dispatchEvent (eventName: string, props: Record<string, any>): void;
 }
 
+// The events of all the guests of this embedder arrive on one channel, in
+// batches of [viewInstanceId, eventName, props] entries.
+const delegates = new Map<number, GuestViewDelegate>();
+
+const dispatchEvents = function (_event: Electron.IpcRendererEvent, events: [number, string, Record<string, any>][]) {
+  for (const [viewInstanceId, eventName, props] of events) {
+    delegates.get(viewInstanceId)?.dispatchEvent(eventName, props);
+  }
+};
+
 export function registerEvents (viewInstanceId: number, delegate: GuestViewDelegate) {
-  ipcRendererInternal.on(`${IPC_MESSAGES.GUEST_VIEW_INTERNAL_DISPATCH_EVENT}-${viewInstanceId}`, function (event, eventName, props) {
-    delegate.dispatchEvent(eventName, props);
-  });
+  if (delegates.size === 0) {
+    ipcRendererInternal.on(IPC_MESSAGES.GUEST_VIEW_INTERNAL_DISPATCH_EVENTS, dispatchEvents);
+  }
+  delegates.set(viewInstanceId, delegate);
 }
 
 export function deregisterEvents (viewInstanceId: number) {
-  ipcRendererInternal.removeAllListeners(`${IPC_MESSAGES.GUEST_VIEW_INTERNAL_DISPATCH_EVENT}-${viewInstanceId}`);
+  if (delegates.delete(viewInstanceId) && delegates.size === 0) {
+    ipcRendererInternal.removeListener(IPC_MESSAGES.GUEST_VIEW_INTERNAL_DISPATCH_EVENTS, dispatchEvents);
+  }
 }
 
 export function createGuest (iframe: HTMLIFrameElement, elementInstanceId: number, params: Record<string, any>): Promise<number> {
@@ -1,6 +1,7 @@
 import * as events from 'events';
 import { setImmediate, clearImmediate } from 'timers';
 import { IPC_MESSAGES } from '@electron/internal/common/ipc-messages';
+import { wrapPreloadScript } from '@electron/internal/common/preload-wrapper';
 
 import type * as ipcRendererUtilsModule from '@electron/internal/renderer/ipc-renderer-internal-utils';
 import type * as ipcRendererInternalModule from '@electron/internal/renderer/ipc-renderer-internal';
@@ -8,7 +9,9 @@ import type * as ipcRendererInternalModule from '@electron/internal/renderer/ipc
 declare const binding: {
   get: (name: string) => any;
   process: NodeJS.Process;
-  createPreloadScript: (src: string) => Function
+  createPreloadScript: (src: string, codeCache?: Uint8Array | null) => {
+    preloadFn: Function;
+  }
 };
 
 const { EventEmitter } = events;
@@ -39,6 +42,7 @@ const {
     preloadPath: string;
     preloadSrc: string | null;
     preloadError: null | Error;
+    preloadCodeCache: Uint8Array | null;
   }[];
   process: NodeJS.Process;
 }>(IPC_MESSAGES.BROWSER_SANDBOX_LOAD);
@@ -113,29 +117,18 @@ if (hasSwitch('unsafely-expose-electron-internals-for-testing')) {
 // Common renderer initialization
 require('@electron/internal/renderer/common-init');
 
-// Wrap the script into a function executed in global scope. It won't have
-// access to the current scope, so we'll expose a few objects as arguments:
-//
-// - `require`: The `preloadRequire` function
-// - `process`: The `preloadProcess` object
-// - `Buffer`: Shim of `Buffer` implementation
-// - `global`: The window object, which is aliased to `global` by webpack.
-function runPreloadScript (preloadSrc: string) {
-  const preloadWrapperSrc = `(function(require, process, Buffer, global, setImmediate, clearImmediate, exports, module) {
-  ${preloadSrc}
-  })`;
-
+function runPreloadScript (preloadSrc: string, preloadCodeCache: Uint8Array | null) {
   // eval in window scope
-  const preloadFn = binding.createPreloadScript(preloadWrapperSrc);
+  const { preloadFn } = binding.createPreloadScript(wrapPreloadScript(preloadSrc), preloadCodeCache);
   const exports = {};
 
   preloadFn(preloadRequire, preloadProcess, Buffer, global, setImmediate, clearImmediate, exports, { exports });
 }
 
-for (const { preloadPath, preloadSrc, preloadError } of preloadScripts) {
+for (const { preloadPath, preloadSrc, preloadError, preloadCodeCache } of preloadScripts) {
   try {
     if (preloadSrc) {
-      runPreloadScript(preloadSrc);
+      runPreloadScript(preloadSrc, preloadCodeCache);
     } else if (preloadError) {
       throw preloadError;
     }
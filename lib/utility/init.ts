@@ -29,6 +29,12 @@ parentPort.on('newListener', (name: string) => {
   }
 });
 
+parentPort.on('newListener', (name: string) => {
+  if (name === 'stream') {
+    parentPort._startStreams();
+  }
+});
+
 parentPort.on('removeListener', (name: string) => {
   if (name === 'message' && parentPort.listenerCount('message') === 0) {
     parentPort.pause();
@@ -1,15 +1,20 @@
 import { EventEmitter } from 'events';
 import { MessagePortMain } from '@electron/internal/browser/message-port-main';
+import { wrapProtocolHandler } from '@electron/internal/common/api/protocol-handler';
+import { makeDuplexFromDataPipe } from '@electron/internal/common/data-pipe-stream';
 const { createParentPort } = process._linkedBinding('electron_utility_parent_port');
+const { registerProtocol, unregisterProtocol } = process._linkedBinding('electron_utility_protocol');
 
 export class ParentPort extends EventEmitter implements Electron.ParentPort {
   #port: ParentPort;
   constructor () {
     super();
     this.#port = createParentPort();
-    this.#port.emit = (channel: string | symbol, event: { ports: any[] }) => {
+    this.#port.emit = (channel: string | symbol, event: any) => {
       if (channel === 'message') {
-        event = { ...event, ports: event.ports.map(p => new MessagePortMain(p)) };
+        event = { ...event, ports: event.ports.map((p: any) => new MessagePortMain(p)) };
+      } else if (channel === 'stream') {
+        event = makeDuplexFromDataPipe(event);
       }
       this.emit(channel, event);
       return false;
@@ -24,7 +29,23 @@ export class ParentPort extends EventEmitter implements Electron.ParentPort {
     this.#port.pause();
   }
 
+  _startStreams () : void {
+    this.#port.startStreams();
+  }
+
   postMessage (message: any) : void {
     this.#port.postMessage(message);
   }
+
+  handleProtocol (scheme: string, handler: (req: Request) => Response | Promise<Response>) : void {
+    if (!registerProtocol(scheme, wrapProtocolHandler(handler))) {
+      throw new Error(`Failed to register protocol: ${scheme}`);
+    }
+  }
+
+  unhandleProtocol (scheme: string) : void {
+    if (!unregisterProtocol(scheme)) {
+      throw new Error(`Failed to unhandle protocol: ${scheme}`);
+    }
+  }
 }
@@ -0,0 +1,228 @@
+// Measures the latency and throughput of common operations of Electron apps,
+// printing the results on stdout for script/benchmark-runner.js to collect.
+// With --startup-only, only the time until the app is ready and the first
+// window has painted is measured, which the runner repeats in new processes.
+// With --memory-scenario=name, only the memory used by the processes of that
+// scenario is measured.
+const { app, BrowserWindow, ipcMain, MessageChannelMain, protocol, session, utilityProcess } = require('electron');
+const crypto = require('node:crypto');
+const { once } = require('node:events');
+const http = require('node:http');
+const path = require('node:path');
+
+const RESULT_PREFIX = 'BENCHMARK_RESULT ';
+// Modules the benchmarks don't use, which apps that don't use them either
+// don't load at all.
+const LAZY_MODULES = ['autoUpdater', 'contentTracing', 'crashReporter', 'desktopCapturer',
+  'inAppPurchase', 'netLog', 'pushNotifications', 'safeStorage', 'systemPreferences', 'TouchBar'];
+
+const startupOnly = process.argv.includes('--startup-only');
+const iterationsArg = process.argv.find(arg => arg.startsWith('--iterations='));
+const iterations = iterationsArg ? parseInt(iterationsArg.split('=')[1], 10) : 1000;
+const scenarioArg = process.argv.find(arg => arg.startsWith('--memory-scenario='));
+const userDataArg = process.argv.find(arg => arg.startsWith('--user-data='));
+if (userDataArg) app.setPath('userData', userDataArg.slice('--user-data='.length));
+
+function report (results) {
+  process.stdout.write(RESULT_PREFIX + JSON.stringify(results) + '\n');
+}
+
+function createWindow () {
+  const w = new BrowserWindow({
+    show: false,
+    webPreferences: { preload: path.join(__dirname, 'preload.js') }
+  });
+  const painted = new Promise(resolve => w.once('ready-to-show', resolve));
+  w.loadFile(path.join(__dirname, 'index.html'));
+  return { w, painted };
+}
+
+async function measureWindowOpen (count) {
+  const samples = [];
+  for (let i = 0; i < count; i++) {
+    const start = performance.now();
+    const { w, painted } = createWindow();
+    await painted;
+    samples.push(performance.now() - start);
+    w.destroy();
+  }
+  return { samples };
+}
+
+function setUpIpc (w) {
+  let received = 0;
+  ipcMain.on('benchmark-ping', (event) => event.sender.send('benchmark-pong'));
+  ipcMain.handle('benchmark-invoke', () => null);
+  ipcMain.on('benchmark-sync', (event) => { event.returnValue = null; });
+  ipcMain.on('benchmark-data', () => { received++; });
+  ipcMain.on('benchmark-flush', (event, count) => {
+    // Messages of a sender arrive in order, so all of them have been
+    // received by the time the flush is.
+    if (received !== count) console.error(`Received ${received} of ${count} messages`);
+    received = 0;
+    event.sender.send('benchmark-received');
+  });
+
+  const { port1, port2 } = new MessageChannelMain();
+  port1.on('message', (event) => {
+    // Echo pings, and acknowledge the end of the throughput runs.
+    if (event.data === null || typeof event.data === 'number') port1.postMessage(null);
+  });
+  port1.start();
+  w.webContents.postMessage('benchmark-port', null, [port2]);
+}
+
+// Accepts WebSocket handshakes and nothing else, which is all the handshake
+// benchmarks need.
+async function startWebSocketServer () {
+  const server = http.createServer();
+  server.on('upgrade', (request, socket) => {
+    const accept = crypto.createHash('sha1')
+      .update(request.headers['sec-websocket-key'] + '258EAFA5-E914-47DA-95CA-C5AB0DC85B11')
+      .digest('base64');
+    socket.on('error', () => {});
+    socket.on('end', () => socket.end());
+    socket.write('HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n' +
+      `Sec-WebSocket-Accept: ${accept}\r\n\r\n`);
+  });
+  server.listen(0, '127.0.0.1');
+  await once(server, 'listening');
+  return server;
+}
+
+// Measures the time the first access to each of the lazily loaded modules
+// takes, which is the startup time saved by not loading them eagerly.
+function measureLazyModules () {
+  const electron = require('electron');
+  const results = {};
+  for (const name of LAZY_MODULES) {
+    const start = performance.now();
+    // eslint-disable-next-line no-unused-expressions
+    electron[name];
+    results[`api.load.${name}`] = { samples: [performance.now() - start] };
+  }
+  return results;
+}
+
+async function runBenchmarks () {
+  const results = measureLazyModules();
+  results['window.open.latency'] = await measureWindowOpen(Math.min(iterations, 20));
+
+  const { w, painted } = createWindow();
+  await painted;
+  setUpIpc(w);
+
+  const run = (name, count, ...args) =>
+    w.webContents.executeJavaScript(`benchmark.run(${[name, count, ...args].map(arg => JSON.stringify(arg)).join(', ')})`);
+  for (const name of ['ipc.send.latency', 'ipc.invoke.latency', 'ipc.sendSync.latency',
+    'ipc.messagePort.latency', 'ipc.send.throughput', 'ipc.messagePort.throughput']) {
+    results[name] = await run(name, iterations);
+  }
+  results['protocol.fetch.throughput'] = await run('protocol.fetch.throughput', Math.min(iterations, 500));
+
+  // Handshakes with no webRequest listener, and with one that only filters
+  // HTTP requests, which should not make them any slower.
+  const server = await startWebSocketServer();
+  const wsUrl = `ws://127.0.0.1:${server.address().port}`;
+  const handshakes = Math.min(iterations, 200);
+  results['websocket.handshake.latency'] = await run('websocket.handshake.latency', handshakes, wsUrl);
+  session.defaultSession.webRequest.onBeforeRequest({ urls: ['<all_urls>'], types: ['xhr'] }, (details, callback) => callback({}));
+  results['websocket.handshake.latency.httpListener'] = await run('websocket.handshake.latency', handshakes, wsUrl);
+  session.defaultSession.webRequest.onBeforeRequest(null);
+  server.close();
+
+  // Compares calls to a function exposed over the contextBridge to calls of a
+  // function of the main world.
+  results['contextBridge.call.overhead'] = await w.webContents.executeJavaScript(`(() => {
+    const count = ${iterations * 100};
+    const local = () => {};
+    let start = performance.now();
+    for (let i = 0; i < count; i++) local();
+    const localDuration = performance.now() - start;
+    start = performance.now();
+    for (let i = 0; i < count; i++) benchmark.noop();
+    const bridgeDuration = performance.now() - start;
+    return { nsPerCall: (bridgeDuration - localDuration) * 1e6 / count };
+  })()`);
+  return results;
+}
+
+async function loadWindow (webPreferences, file = 'index.html') {
+  const w = new BrowserWindow({ show: false, webPreferences });
+  await w.loadFile(path.join(__dirname, file));
+  return w;
+}
+
+const memoryScenarios = {
+  'empty-window': () => loadWindow({}),
+  'sandboxed-window': () => loadWindow({ sandbox: true, preload: path.join(__dirname, 'preload.js') }),
+  webview: async () => {
+    const w = await loadWindow({ webviewTag: true }, 'webview.html');
+    await w.webContents.executeJavaScript(`new Promise((resolve) => {
+      document.querySelector('webview').addEventListener('dom-ready', resolve, { once: true });
+    })`);
+  },
+  'utility-process': async () => {
+    const child = utilityProcess.fork(path.join(__dirname, 'utility.js'));
+    await once(child, 'spawn');
+  },
+  'offscreen-window': () => loadWindow({ offscreen: true })
+};
+
+// Sums up the memory of the processes of each type, in kilobytes. Each
+// scenario runs in an app of its own, which does nothing else.
+async function measureMemory (scenario) {
+  await memoryScenarios[scenario]();
+  // Let the processes finish settling down after loading.
+  await new Promise(resolve => setTimeout(resolve, 2000));
+
+  const results = {};
+  for (const metric of app.getAppMetrics()) {
+    for (const key of ['privateBytes', 'workingSetSize', 'proportionalSetSize']) {
+      if (metric.memory[key] === undefined) continue;
+      const name = `memory.${scenario}.${metric.type}.${key}`;
+      results[name] = results[name] || { kilobytes: 0 };
+      results[name].kilobytes += metric.memory[key];
+    }
+  }
+  return results;
+}
+
+protocol.registerSchemesAsPrivileged([
+  { scheme: 'bench', privileges: { standard: true, supportFetchAPI: true, corsEnabled: true } }
+]);
+
+// Startup times are counted from the creation of the browser process, which
+// is before Node.js is initialized.
+function sinceProcessCreation () {
+  const browser = app.getAppMetrics().find(metric => metric.type === 'Browser');
+  return Date.now() - browser.creationTime;
+}
+
+app.whenReady().then(async () => {
+  if (scenarioArg) {
+    const scenario = scenarioArg.slice('--memory-scenario='.length);
+    report({ version: process.versions.electron, results: await measureMemory(scenario) });
+    app.quit();
+    return;
+  }
+
+  const ready = sinceProcessCreation();
+  protocol.handle('bench', () => new Response('x'.repeat(1024), {
+    headers: { 'Access-Control-Allow-Origin': '*' }
+  }));
+
+  const { painted } = createWindow();
+  await painted;
+  const results = {
+    'startup.ready': { samples: [ready] },
+    'startup.firstPaint': { samples: [sinceProcessCreation()] }
+  };
+
+  if (!startupOnly) Object.assign(results, await runBenchmarks());
+  report({ version: process.versions.electron, results });
+  app.quit();
+}).catch((error) => {
+  console.error(error);
+  app.exit(1);
+});
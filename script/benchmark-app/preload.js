@@ -0,0 +1,64 @@
+// The benchmarks run in the isolated world of this preload, so that only the
+// contextBridge benchmark pays for crossing into the main world.
+const { contextBridge, ipcRenderer } = require('electron');
+
+let port = null;
+ipcRenderer.on('benchmark-port', (event) => {
+  port = event.ports[0];
+  port.start();
+});
+
+const payload = 'x'.repeat(1024);
+
+async function measureLatency (iterations, run) {
+  const samples = [];
+  for (let i = 0; i < iterations; i++) {
+    const start = performance.now();
+    await run();
+    samples.push(performance.now() - start);
+  }
+  return { samples };
+}
+
+async function measureThroughput (iterations, run) {
+  const start = performance.now();
+  await run(iterations);
+  const duration = performance.now() - start;
+  return { opsPerSecond: iterations / (duration / 1000) };
+}
+
+const benchmarks = {
+  'ipc.send.latency': (iterations) => measureLatency(iterations, () => new Promise((resolve) => {
+    ipcRenderer.once('benchmark-pong', resolve);
+    ipcRenderer.send('benchmark-ping');
+  })),
+  'ipc.invoke.latency': (iterations) => measureLatency(iterations, () => ipcRenderer.invoke('benchmark-invoke')),
+  'ipc.sendSync.latency': (iterations) => measureLatency(iterations, () => ipcRenderer.sendSync('benchmark-sync')),
+  'ipc.messagePort.latency': (iterations) => measureLatency(iterations, () => new Promise((resolve) => {
+    port.onmessage = resolve;
+    port.postMessage(null);
+  })),
+  'ipc.send.throughput': (iterations) => measureThroughput(iterations, (count) => new Promise((resolve) => {
+    ipcRenderer.once('benchmark-received', resolve);
+    for (let i = 0; i < count; i++) ipcRenderer.send('benchmark-data', payload);
+    ipcRenderer.send('benchmark-flush', count);
+  })),
+  'ipc.messagePort.throughput': (iterations) => measureThroughput(iterations, (count) => new Promise((resolve) => {
+    port.onmessage = resolve;
+    for (let i = 0; i < count; i++) port.postMessage(payload);
+    port.postMessage(count);
+  })),
+  'protocol.fetch.throughput': (iterations) => measureThroughput(iterations, async (count) => {
+    for (let i = 0; i < count; i++) await (await fetch(`bench://host/${i}`)).text();
+  }),
+  'websocket.handshake.latency': (iterations, url) => measureLatency(iterations, () => new Promise((resolve, reject) => {
+    const socket = new WebSocket(url);
+    socket.onopen = () => { socket.close(); resolve(); };
+    socket.onerror = reject;
+  }))
+};
+
+contextBridge.exposeInMainWorld('benchmark', {
+  noop: () => {},
+  run: (name, iterations, ...args) => benchmarks[name](iterations, ...args)
+});
@@ -0,0 +1,2 @@
+// An idle utility process, which is kept alive by listening to its parent.
+process.parentPort.on('message', () => {});
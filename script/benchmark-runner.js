@@ -0,0 +1,178 @@
+#!/usr/bin/env node
+
+// Runs the app in script/benchmark-app and prints its results as JSON, with
+// the keys in a fixed order so the output of different runs and Electron
+// versions can be compared and fed to dashboards.
+//
+// Usage: node script/benchmark-runner.js [--electron=path] [--runs=10]
+//                                        [--iterations=1000] [--output=file]
+//                                        [--memory] [--memory-runs=3]
+//                                        [--baseline=file] [--tolerance=10]
+//
+// With --memory, the memory used by each process type is measured for a set
+// of scenarios. With --baseline, the memory results are compared to those of
+// an earlier output, and the runner fails when any of them grew by more than
+// --tolerance percent.
+
+const childProcess = require('node:child_process');
+const fs = require('node:fs');
+const os = require('node:os');
+const path = require('node:path');
+
+const utils = require('./lib/utils');
+
+const args = require('minimist')(process.argv.slice(2), {
+  string: ['electron', 'output', 'baseline'],
+  boolean: ['memory'],
+  default: { runs: 10, iterations: 1000, 'memory-runs': 3, tolerance: 10 }
+});
+
+const RESULT_PREFIX = 'BENCHMARK_RESULT ';
+const APP_DIR = path.resolve(__dirname, 'benchmark-app');
+const MEMORY_SCENARIOS = [
+  'empty-window',
+  'sandboxed-window',
+  'webview',
+  'utility-process',
+  'offscreen-window'
+];
+
+function runApp (electronPath, appArgs) {
+  return new Promise((resolve, reject) => {
+    const child = childProcess.spawn(electronPath, [APP_DIR, ...appArgs], {
+      stdio: ['ignore', 'pipe', 'inherit']
+    });
+    let stdout = '';
+    child.stdout.on('data', (data) => { stdout += data; });
+    child.on('error', reject);
+    child.on('close', (code) => {
+      const line = stdout.split('\n').find(line => line.startsWith(RESULT_PREFIX));
+      if (code !== 0 || !line) {
+        reject(new Error(`Benchmark app exited with code ${code} without results`));
+        return;
+      }
+      resolve(JSON.parse(line.slice(RESULT_PREFIX.length)));
+    });
+  });
+}
+
+function round (value) {
+  return Math.round(value * 1000) / 1000;
+}
+
+function percentile (sorted, p) {
+  return sorted[Math.min(sorted.length - 1, Math.floor(sorted.length * p))];
+}
+
+function summarize (result) {
+  if (result.samples) {
+    const sorted = [...result.samples].sort((a, b) => a - b);
+    const mean = sorted.reduce((sum, value) => sum + value, 0) / sorted.length;
+    return {
+      unit: 'ms',
+      count: sorted.length,
+      mean: round(mean),
+      median: round(percentile(sorted, 0.5)),
+      p90: round(percentile(sorted, 0.9)),
+      min: round(sorted[0]),
+      max: round(sorted[sorted.length - 1])
+    };
+  }
+  if (result.kilobytes) {
+    const sorted = [...result.kilobytes].sort((a, b) => a - b);
+    return { unit: 'KB', value: percentile(sorted, 0.5) };
+  }
+  if (result.opsPerSecond !== undefined) {
+    return { unit: 'ops/s', value: round(result.opsPerSecond) };
+  }
+  return { unit: 'ns', value: round(result.nsPerCall) };
+}
+
+function addSamples (results, name, samples) {
+  results[name] = results[name] || { samples: [] };
+  results[name].samples.push(...samples);
+}
+
+// Returns the memory results that grew by more than the tolerance.
+function findRegressions (results, baseline) {
+  const regressions = [];
+  for (const [name, result] of Object.entries(results)) {
+    const previous = baseline.results[name];
+    if (result.unit !== 'KB' || !previous) continue;
+    const limit = previous.value * (1 + args.tolerance / 100);
+    if (result.value > limit) {
+      regressions.push(`${name}: ${result.value} KB, was ${previous.value} KB`);
+    }
+  }
+  return regressions;
+}
+
+async function main () {
+  const electronPath = args.electron ? path.resolve(args.electron) : utils.getAbsoluteElectronExec();
+  const userDataDir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-benchmark-'));
+  const results = {};
+  let version;
+
+  try {
+    // The first launch with an empty profile is the cold one, later launches
+    // reuse it and find the OS caches warm.
+    for (let i = 0; i < args.runs; i++) {
+      const output = await runApp(electronPath, ['--startup-only', `--user-data=${userDataDir}`]);
+      version = output.version;
+      const kind = i === 0 ? 'cold' : 'warm';
+      for (const [name, result] of Object.entries(output.results)) {
+        addSamples(results, name.replace('startup.', `startup.${kind}.`), result.samples);
+      }
+    }
+
+    const output = await runApp(electronPath, [`--iterations=${args.iterations}`, `--user-data=${userDataDir}`]);
+    for (const [name, result] of Object.entries(output.results)) {
+      if (!name.startsWith('startup.')) results[name] = result;
+    }
+
+    if (args.memory) {
+      for (const scenario of MEMORY_SCENARIOS) {
+        for (let i = 0; i < args['memory-runs']; i++) {
+          const output = await runApp(electronPath, [`--memory-scenario=${scenario}`, `--user-data=${userDataDir}`]);
+          for (const [name, result] of Object.entries(output.results)) {
+            results[name] = results[name] || { kilobytes: [] };
+            results[name].kilobytes.push(result.kilobytes);
+          }
+        }
+      }
+    }
+  } finally {
+    fs.rmSync(userDataDir, { recursive: true, force: true });
+  }
+
+  const summary = {
+    electronVersion: version,
+    platform: process.platform,
+    arch: process.arch,
+    cpu: os.cpus()[0].model,
+    runs: args.runs,
+    iterations: args.iterations,
+    results: Object.fromEntries(Object.keys(results).sort().map(name => [name, summarize(results[name])]))
+  };
+  const json = JSON.stringify(summary, null, 2) + '\n';
+  if (args.output) {
+    fs.writeFileSync(args.output, json);
+  } else {
+    process.stdout.write(json);
+  }
+
+  if (args.baseline) {
+    const baseline = JSON.parse(fs.readFileSync(args.baseline, 'utf8'));
+    const regressions = findRegressions(summary.results, baseline);
+    if (regressions.length > 0) {
+      console.error(`Memory use grew by more than ${args.tolerance}%:`);
+      for (const regression of regressions) console.error(`  ${regression}`);
+      process.exitCode = 1;
+    }
+  }
+}
+
+main().catch((error) => {
+  console.error(error);
+  process.exit(1);
+});
@@ -17,6 +17,7 @@
 #include "base/strings/utf_string_conversions.h"
 #include "content/public/common/content_constants.h"
 #include "content/public/common/content_switches.h"
+#include "content/public/common/url_constants.h"
 #include "electron/buildflags/buildflags.h"
 #include "electron/fuses.h"
 #include "extensions/common/constants.h"
@@ -174,6 +175,12 @@ void ElectronContentClient::AddAdditionalSchemes(Schemes* schemes) {
     schemes->service_worker_schemes.emplace_back(url::kFileScheme);
   }
 
+  // The DevTools front-end is served from the resource bundle, so the code
+  // cache of its scripts can be keyed by the hash of their source, which
+  // saves compiling the whole front-end each time DevTools is opened. The
+  // renderers register it with Blink in `RendererClientBase`.
+  schemes->code_cache_schemes.emplace_back(content::kChromeDevToolsScheme);
+
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   schemes->standard_schemes.push_back(extensions::kExtensionScheme);
   schemes->savable_schemes.push_back(extensions::kExtensionScheme);
@@ -42,6 +42,7 @@
 #include "shell/common/options_switches.h"
 #include "shell/common/platform_util.h"
 #include "shell/common/process_util.h"
+#include "shell/common/startup_timings.h"
 #include "shell/common/thread_restrictions.h"
 #include "shell/renderer/electron_renderer_client.h"
 #include "shell/renderer/electron_sandboxed_renderer_client.h"
@@ -240,6 +241,8 @@ const size_t ElectronMainDelegate::kNonWildcardDomainNonPortSchemesSize =
     std::size(kNonWildcardDomainNonPortSchemes);
 
 std::optional<int> ElectronMainDelegate::BasicStartupComplete() {
+  ScopedStartupTiming startup_timing(
+      "ElectronMainDelegate::BasicStartupComplete");
   auto* command_line = base::CommandLine::ForCurrentProcess();
 
 #if BUILDFLAG(IS_WIN)
@@ -316,6 +319,7 @@ std::optional<int> ElectronMainDelegate::BasicStartupComplete() {
 }
 
 void ElectronMainDelegate::PreSandboxStartup() {
+  ScopedStartupTiming startup_timing("ElectronMainDelegate::PreSandboxStartup");
   auto* command_line = base::CommandLine::ForCurrentProcess();
   std::string process_type = GetProcessType();
 
@@ -101,6 +101,7 @@ bool UnsetHijackableEnvs(base::Environment* env) {
 
 #if IS_MAS_BUILD()
 void SetCrashKeyStub(const std::string& key, const std::string& value) {}
+void SetCrashKeysStub(const std::map<std::string, std::string>& keys) {}
 void ClearCrashKeyStub(const std::string& key) {}
 #endif
 
@@ -272,10 +273,13 @@ int NodeMain(int argc, char* argv[]) {
       reporter.SetMethod("getParameters", &GetParameters);
 #if IS_MAS_BUILD()
       reporter.SetMethod("addExtraParameter", &SetCrashKeyStub);
+      reporter.SetMethod("addExtraParameters", &SetCrashKeysStub);
       reporter.SetMethod("removeExtraParameter", &ClearCrashKeyStub);
 #else
       reporter.SetMethod("addExtraParameter",
                          &electron::crash_keys::SetCrashKey);
+      reporter.SetMethod("addExtraParameters",
+                         &electron::crash_keys::SetCrashKeys);
       reporter.SetMethod("removeExtraParameter",
                          &electron::crash_keys::ClearCrashKey);
 #endif
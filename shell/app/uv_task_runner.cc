@@ -5,29 +5,74 @@
 #include <utility>
 
 #include "base/location.h"
-#include "base/stl_util.h"
 #include "base/time/time.h"
 #include "shell/app/uv_task_runner.h"
 
 namespace electron {
 
-UvTaskRunner::UvTaskRunner(uv_loop_t* loop) : loop_(loop) {}
+namespace {
+
+template <typename T>
+void DeleteHandle(uv_handle_t* handle) {
+  delete reinterpret_cast<T*>(handle);
+}
+
+}  // namespace
+
+UvTaskRunner::DelayedTask::DelayedTask(uint64_t run_time,
+                                       uint64_t sequence_num,
+                                       base::OnceClosure task)
+    : run_time(run_time), sequence_num(sequence_num), task(std::move(task)) {}
+
+UvTaskRunner::DelayedTask::DelayedTask(DelayedTask&&) = default;
+
+UvTaskRunner::DelayedTask& UvTaskRunner::DelayedTask::operator=(
+    DelayedTask&&) = default;
+
+UvTaskRunner::DelayedTask::~DelayedTask() = default;
+
+bool UvTaskRunner::DelayedTask::operator>(const DelayedTask& other) const {
+  if (run_time != other.run_time)
+    return run_time > other.run_time;
+  return sequence_num > other.sequence_num;
+}
+
+UvTaskRunner::UvTaskRunner(uv_loop_t* loop)
+    : loop_(loop), async_(new uv_async_t), timer_(new uv_timer_t) {
+  uv_async_init(loop_, async_, UvTaskRunner::OnAsync);
+  async_->data = this;
+  // The async handle only keeps the loop alive while tasks are queued.
+  uv_unref(reinterpret_cast<uv_handle_t*>(async_.get()));
+
+  uv_timer_init(loop_, timer_);
+  timer_->data = this;
+}
 
 UvTaskRunner::~UvTaskRunner() {
-  for (auto& iter : tasks_) {
-    uv_unref(reinterpret_cast<uv_handle_t*>(iter.first));
-    delete iter.first;
-  }
+  uv_close(reinterpret_cast<uv_handle_t*>(async_.get()),
+           DeleteHandle<uv_async_t>);
+  uv_close(reinterpret_cast<uv_handle_t*>(timer_.get()),
+           DeleteHandle<uv_timer_t>);
 }
 
 bool UvTaskRunner::PostDelayedTask(const base::Location& from_here,
                                    base::OnceClosure task,
                                    base::TimeDelta delay) {
-  auto* timer = new uv_timer_t;
-  timer->data = this;
-  uv_timer_init(loop_, timer);
-  uv_timer_start(timer, UvTaskRunner::OnTimeout, delay.InMilliseconds(), 0);
-  tasks_[timer] = std::move(task);
+  if (!delay.is_positive()) {
+    if (immediate_tasks_.empty()) {
+      uv_ref(reinterpret_cast<uv_handle_t*>(async_.get()));
+      uv_async_send(async_);
+    }
+    immediate_tasks_.push_back(std::move(task));
+    return true;
+  }
+
+  const uint64_t run_time = uv_now(loop_) + delay.InMilliseconds();
+  const bool runs_first =
+      delayed_tasks_.empty() || run_time < delayed_tasks_.top().run_time;
+  delayed_tasks_.emplace(run_time, next_sequence_num_++, std::move(task));
+  if (runs_first)
+    StartTimer();
   return true;
 }
 
@@ -41,22 +86,48 @@ bool UvTaskRunner::PostNonNestableDelayedTask(const base::Location& from_here,
   return PostDelayedTask(from_here, std::move(task), delay);
 }
 
+// static
+void UvTaskRunner::OnAsync(uv_async_t* async) {
+  static_cast<UvTaskRunner*>(async->data)->RunImmediateTasks();
+}
+
 // static
 void UvTaskRunner::OnTimeout(uv_timer_t* timer) {
-  auto& tasks = static_cast<UvTaskRunner*>(timer->data)->tasks_;
-  const auto iter = tasks.find(timer);
-  if (iter == std::end(tasks))
-    return;
+  static_cast<UvTaskRunner*>(timer->data)->RunDelayedTasks();
+}
+
+void UvTaskRunner::RunImmediateTasks() {
+  // Tasks posted while these run are left for the next iteration of the loop,
+  // as they would have been with a timer each.
+  base::circular_deque<base::OnceClosure> tasks;
+  tasks.swap(immediate_tasks_);
+  for (auto& task : tasks)
+    std::move(task).Run();
 
-  std::move(iter->second).Run();
-  tasks.erase(iter);
-  uv_timer_stop(timer);
-  uv_close(reinterpret_cast<uv_handle_t*>(timer), UvTaskRunner::OnClose);
+  if (immediate_tasks_.empty())
+    uv_unref(reinterpret_cast<uv_handle_t*>(async_.get()));
 }
 
-// static
-void UvTaskRunner::OnClose(uv_handle_t* handle) {
-  delete reinterpret_cast<uv_timer_t*>(handle);
+void UvTaskRunner::RunDelayedTasks() {
+  const uint64_t now = uv_now(loop_);
+  while (!delayed_tasks_.empty() && delayed_tasks_.top().run_time <= now) {
+    base::OnceClosure task = std::move(delayed_tasks_.top().task);
+    delayed_tasks_.pop();
+    std::move(task).Run();
+  }
+  StartTimer();
+}
+
+void UvTaskRunner::StartTimer() {
+  if (delayed_tasks_.empty()) {
+    uv_timer_stop(timer_);
+    return;
+  }
+
+  const uint64_t run_time = delayed_tasks_.top().run_time;
+  const uint64_t now = uv_now(loop_);
+  uv_timer_start(timer_, UvTaskRunner::OnTimeout,
+                 run_time > now ? run_time - now : 0, 0);
 }
 
 }  // namespace electron
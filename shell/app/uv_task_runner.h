@@ -5,8 +5,12 @@
 #ifndef ELECTRON_SHELL_APP_UV_TASK_RUNNER_H_
 #define ELECTRON_SHELL_APP_UV_TASK_RUNNER_H_
 
-#include <map>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
 
+#include "base/containers/circular_deque.h"
 #include "base/functional/callback.h"
 #include "base/memory/raw_ptr.h"
 #include "base/task/single_thread_task_runner.h"
@@ -20,6 +24,11 @@ class TimeDelta;
 namespace electron {
 
 // TaskRunner implementation that posts tasks into libuv's default loop.
+//
+// Tasks without a delay are queued behind a single uv_async_t, and delayed
+// tasks are kept in a heap ordered by their run time behind a single
+// uv_timer_t, which is started for the earliest of them. Either handle only
+// keeps the loop alive while it has tasks waiting.
 class UvTaskRunner : public base::SingleThreadTaskRunner {
  public:
   explicit UvTaskRunner(uv_loop_t* loop);
@@ -38,13 +47,43 @@ class UvTaskRunner : public base::SingleThreadTaskRunner {
                                   base::TimeDelta delay) override;
 
  private:
+  struct DelayedTask {
+    DelayedTask(uint64_t run_time, uint64_t sequence_num, base::OnceClosure);
+    DelayedTask(DelayedTask&&);
+    DelayedTask& operator=(DelayedTask&&);
+    ~DelayedTask();
+
+    // Orders the heap so that the task to run first is at its top, and the
+    // tasks with the same run time run in the order they were posted.
+    bool operator>(const DelayedTask& other) const;
+
+    uint64_t run_time;
+    uint64_t sequence_num;
+    // Mutable so the task can be moved out of the top of the heap.
+    mutable base::OnceClosure task;
+  };
+
   ~UvTaskRunner() override;
+  static void OnAsync(uv_async_t* async);
   static void OnTimeout(uv_timer_t* timer);
-  static void OnClose(uv_handle_t* handle);
+
+  void RunImmediateTasks();
+  void RunDelayedTasks();
+  void StartTimer();
 
   raw_ptr<uv_loop_t> loop_;
 
-  std::map<uv_timer_t*, base::OnceClosure> tasks_;
+  // The handles are allocated separately as they have to outlive the runner
+  // until libuv has closed them.
+  raw_ptr<uv_async_t> async_;
+  raw_ptr<uv_timer_t> timer_;
+
+  base::circular_deque<base::OnceClosure> immediate_tasks_;
+  std::priority_queue<DelayedTask,
+                      std::vector<DelayedTask>,
+                      std::greater<DelayedTask>>
+      delayed_tasks_;
+  uint64_t next_sequence_num_ = 0;
 };
 
 }  // namespace electron
@@ -0,0 +1,89 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include <string>
+
+#include "base/functional/bind.h"
+#include "base/location.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/time/time.h"
+#include "base/timer/lap_timer.h"
+#include "shell/app/uv_task_runner.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+#include "uv.h"  // NOLINT(build/include_directory)
+
+namespace electron {
+
+namespace {
+
+constexpr int kTasksPerRun = 10000;
+
+constexpr char kMetricPrefix[] = "UvTaskRunner.";
+constexpr char kMetricTasksPerSecond[] = "tasks_per_second";
+
+class UvTaskRunnerPerfTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_EQ(0, uv_loop_init(&loop_));
+    runner_ = base::MakeRefCounted<UvTaskRunner>(&loop_);
+  }
+
+  void TearDown() override {
+    // Lets the runner close its handles before the loop is closed.
+    runner_.reset();
+    uv_run(&loop_, UV_RUN_DEFAULT);
+    EXPECT_EQ(0, uv_loop_close(&loop_));
+  }
+
+  // Posts a batch of tasks with the delays returned by |delay_for_task|, then
+  // runs the loop until all of them have run.
+  template <typename DelayForTask>
+  void PostAndRun(DelayForTask delay_for_task) {
+    int remaining = kTasksPerRun;
+    for (int i = 0; i < kTasksPerRun; ++i) {
+      runner_->PostDelayedTask(
+          FROM_HERE, base::BindOnce([](int* remaining) { --*remaining; },
+                                    &remaining),
+          delay_for_task(i));
+    }
+    uv_run(&loop_, UV_RUN_DEFAULT);
+    ASSERT_EQ(0, remaining);
+  }
+
+  void Report(const std::string& story, base::LapTimer& timer) {
+    perf_test::PerfResultReporter reporter(kMetricPrefix, story);
+    reporter.RegisterImportantMetric(kMetricTasksPerSecond, "tasks/s");
+    reporter.AddResult(kMetricTasksPerSecond,
+                       timer.LapsPerSecond() * kTasksPerRun);
+  }
+
+  uv_loop_t loop_;
+  scoped_refptr<UvTaskRunner> runner_;
+};
+
+}  // namespace
+
+TEST_F(UvTaskRunnerPerfTest, PostTask) {
+  base::LapTimer timer;
+  do {
+    PostAndRun([](int) { return base::TimeDelta(); });
+    timer.NextLap();
+  } while (!timer.HasTimeLimitExpired());
+  Report("post_task", timer);
+}
+
+TEST_F(UvTaskRunnerPerfTest, PostDelayedTask) {
+  // Spreads the tasks over a few milliseconds, out of order, so the runner
+  // has to keep them sorted. Each lap also waits for the last of them to be
+  // due, which enough tasks make small next to the time spent on them.
+  base::LapTimer timer;
+  do {
+    PostAndRun([](int i) { return base::Milliseconds(1 + (i * 7) % 3); });
+    timer.NextLap();
+  } while (!timer.HasTimeLimitExpired());
+  Report("post_delayed_task", timer);
+}
+
+}  // namespace electron
@@ -4,6 +4,7 @@
 
 #include "shell/browser/api/electron_api_app.h"
 
+#include <cstring>
 #include <memory>
 #include <optional>
 #include <string>
@@ -13,6 +14,7 @@
 
 #include "base/command_line.h"
 #include "base/containers/fixed_flat_map.h"
+#include "base/containers/flat_set.h"
 #include "base/containers/span.h"
 #include "base/environment.h"
 #include "base/files/file_path.h"
@@ -20,6 +22,7 @@
 #include "base/functional/callback_helpers.h"
 #include "base/path_service.h"
 #include "base/system/sys_info.h"
+#include "base/task/sequenced_task_runner.h"
 #include "base/values.h"
 #include "base/win/windows_version.h"
 #include "chrome/browser/browser_process.h"
@@ -29,6 +32,7 @@
 #include "components/proxy_config/proxy_config_dictionary.h"
 #include "components/proxy_config/proxy_config_pref_names.h"
 #include "components/proxy_config/proxy_prefs.h"
+#include "components/viz/client/frame_eviction_manager.h"
 #include "content/browser/gpu/compositor_util.h"        // nogncheck
 #include "content/browser/gpu/gpu_data_manager_impl.h"  // nogncheck
 #include "content/public/browser/browser_accessibility_state.h"
@@ -38,6 +42,7 @@
 #include "content/public/browser/gpu_data_manager.h"
 #include "content/public/browser/network_service_instance.h"
 #include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_process_host.h"
 #include "content/public/common/content_switches.h"
 #include "crypto/crypto_buildflags.h"
 #include "media/audio/audio_manager.h"
@@ -525,6 +530,64 @@ void OnIconDataAvailable(gin_helper::Promise<gfx::Image> promise,
   }
 }
 
+std::unique_ptr<electron::ProcessMetric> CreateProcessMetric(
+    int process_type,
+    base::ProcessHandle handle,
+    const std::string& service_name = std::string(),
+    const std::string& name = std::string()) {
+  std::unique_ptr<base::ProcessMetrics> metrics;
+  if (handle == base::GetCurrentProcessHandle()) {
+    metrics = base::ProcessMetrics::CreateCurrentProcessMetrics();
+  } else {
+#if BUILDFLAG(IS_MAC)
+    metrics = base::ProcessMetrics::CreateProcessMetrics(
+        handle, content::BrowserChildProcessHost::GetPortProvider());
+#else
+    metrics = base::ProcessMetrics::CreateProcessMetrics(handle);
+#endif
+  }
+  return std::make_unique<electron::ProcessMetric>(
+      process_type, handle, std::move(metrics), service_name, name);
+}
+
+v8::Local<v8::Float64Array> ToFloat64Array(v8::Isolate* isolate,
+                                           const std::vector<double>& values) {
+  auto buffer = v8::ArrayBuffer::New(isolate, values.size() * sizeof(double));
+  if (!values.empty())
+    memcpy(buffer->Data(), values.data(), values.size() * sizeof(double));
+  return v8::Float64Array::New(buffer, 0, values.size());
+}
+
+void OnMetricsSamples(
+    gin_helper::Promise<std::vector<gin_helper::Dictionary>> promise,
+    std::vector<ProcessMetricsSampler::Samples> result) {
+  v8::Isolate* isolate = promise.isolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise.GetContext());
+
+  std::vector<gin_helper::Dictionary> processes;
+  processes.reserve(result.size());
+  for (const auto& samples : result) {
+    auto dict = gin_helper::Dictionary::CreateEmpty(isolate);
+    dict.Set("pid", samples.pid);
+    dict.Set("type", content::GetProcessTypeNameInEnglish(samples.type));
+    if (!samples.service_name.empty())
+      dict.Set("serviceName", samples.service_name);
+    if (!samples.name.empty())
+      dict.Set("name", samples.name);
+    dict.Set("timestamps", ToFloat64Array(isolate, samples.timestamps));
+    dict.Set("percentCPUUsage",
+             ToFloat64Array(isolate, samples.percent_cpu_usage));
+    dict.Set("workingSetSize",
+             ToFloat64Array(isolate, samples.working_set_size));
+    dict.Set("handleCount", ToFloat64Array(isolate, samples.handle_count));
+    dict.Set("ioReadBytes", ToFloat64Array(isolate, samples.io_read_bytes));
+    dict.Set("ioWriteBytes", ToFloat64Array(isolate, samples.io_write_bytes));
+    processes.push_back(dict);
+  }
+  promise.Resolve(processes);
+}
+
 }  // namespace
 
 App::App() {
@@ -533,10 +596,8 @@ App::App() {
   Browser::Get()->AddObserver(this);
 
   auto pid = content::ChildProcessHost::kInvalidUniqueID;
-  auto process_metric = std::make_unique<electron::ProcessMetric>(
-      content::PROCESS_TYPE_BROWSER, base::GetCurrentProcessHandle(),
-      base::ProcessMetrics::CreateCurrentProcessMetrics());
-  app_metrics_[pid] = std::move(process_metric);
+  app_metrics_[pid] = CreateProcessMetric(content::PROCESS_TYPE_BROWSER,
+                                          base::GetCurrentProcessHandle());
 }
 
 App::~App() {
@@ -571,6 +632,9 @@ void App::OnQuit() {
     process_singleton_->Cleanup();
     process_singleton_.reset();
   }
+
+  // The watchdog of the detector must not outlive the isolate.
+  long_task_detector_.reset();
 }
 
 void App::OnOpenFile(bool* prevent_default, const std::string& file_path) {
@@ -832,18 +896,18 @@ void App::ChildProcessLaunched(int process_type,
                                base::ProcessHandle handle,
                                const std::string& service_name,
                                const std::string& name) {
-#if BUILDFLAG(IS_MAC)
-  auto metrics = base::ProcessMetrics::CreateProcessMetrics(
-      handle, content::BrowserChildProcessHost::GetPortProvider());
-#else
-  auto metrics = base::ProcessMetrics::CreateProcessMetrics(handle);
-#endif
-  app_metrics_[pid] = std::make_unique<electron::ProcessMetric>(
-      process_type, handle, std::move(metrics), service_name, name);
+  app_metrics_[pid] =
+      CreateProcessMetric(process_type, handle, service_name, name);
+  if (metrics_sampler_) {
+    metrics_sampler_->AddProcess(
+        pid, CreateProcessMetric(process_type, handle, service_name, name));
+  }
 }
 
 void App::ChildProcessDisconnected(int pid) {
   app_metrics_.erase(pid);
+  if (metrics_sampler_)
+    metrics_sampler_->RemoveProcess(pid);
 }
 
 base::FilePath App::GetAppPath() const {
@@ -1306,7 +1370,24 @@ std::vector<gin_helper::Dictionary> App::GetAppMetrics(v8::Isolate* isolate) {
       pid_dict.Set("name", process_metric.second->name);
     }
 
-#if !BUILDFLAG(IS_LINUX)
+    // Renderers are keyed by the ID of their RenderProcessHost, and shared
+    // between the frames of any number of WebContents.
+    if (process_metric.second->type == content::PROCESS_TYPE_RENDERER) {
+      auto* host = content::RenderProcessHost::FromID(process_metric.first);
+      if (host) {
+        base::flat_set<int32_t> web_contents_ids;
+        host->ForEachRenderFrameHost([&](content::RenderFrameHost* rfh) {
+          auto* web_contents = WebContents::From(
+              content::WebContents::FromRenderFrameHost(rfh));
+          if (web_contents)
+            web_contents_ids.insert(web_contents->ID());
+        });
+        pid_dict.Set("webContentsIds",
+                     std::vector<int32_t>(web_contents_ids.begin(),
+                                          web_contents_ids.end()));
+      }
+    }
+
     auto memory_info = process_metric.second->GetMemoryInfo();
 
     auto memory_dict = gin_helper::Dictionary::CreateEmpty(isolate);
@@ -1316,13 +1397,15 @@ std::vector<gin_helper::Dictionary> App::GetAppMetrics(v8::Isolate* isolate) {
         "peakWorkingSetSize",
         static_cast<double>(memory_info.peak_working_set_size >> 10));
 
-#if BUILDFLAG(IS_WIN)
     memory_dict.Set("privateBytes",
                     static_cast<double>(memory_info.private_bytes >> 10));
+#if BUILDFLAG(IS_LINUX)
+    memory_dict.Set(
+        "proportionalSetSize",
+        static_cast<double>(memory_info.proportional_set_size >> 10));
 #endif
 
     pid_dict.Set("memory", memory_dict);
-#endif
 
 #if BUILDFLAG(IS_MAC)
     pid_dict.Set("sandboxed", process_metric.second->IsSandboxed());
@@ -1339,6 +1422,125 @@ std::vector<gin_helper::Dictionary> App::GetAppMetrics(v8::Isolate* isolate) {
   return result;
 }
 
+void App::StartMetricsSampling(gin::Arguments* args) {
+  double interval = 1000;
+  int sample_count = 60;
+  ProcessMetricsSampler::Options options;
+  gin_helper::Dictionary dict;
+  if (args->GetNext(&dict)) {
+    dict.Get("interval", &interval);
+    dict.Get("sampleCount", &sample_count);
+    dict.Get("path", &options.path);
+  }
+
+  if (!(interval >= 10)) {
+    args->ThrowTypeError("interval must be at least 10 milliseconds");
+    return;
+  }
+  if (sample_count < 1) {
+    args->ThrowTypeError("sampleCount must be a positive number");
+    return;
+  }
+  options.interval = base::Milliseconds(interval);
+  options.sample_count = sample_count;
+
+  metrics_sampler_ = std::make_unique<ProcessMetricsSampler>(options);
+  for (const auto& [pid, process_metric] : app_metrics_) {
+    metrics_sampler_->AddProcess(
+        pid, CreateProcessMetric(process_metric->type,
+                                 process_metric->process.Handle(),
+                                 process_metric->service_name,
+                                 process_metric->name));
+  }
+}
+
+void App::StopMetricsSampling() {
+  metrics_sampler_.reset();
+}
+
+v8::Local<v8::Promise> App::GetMetricsSamples(v8::Isolate* isolate) {
+  gin_helper::Promise<std::vector<gin_helper::Dictionary>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  if (!metrics_sampler_) {
+    promise.RejectWithErrorMessage("Metrics sampling has not been started");
+    return handle;
+  }
+  metrics_sampler_->GetSamples(
+      base::BindOnce(&OnMetricsSamples, std::move(promise)));
+  return handle;
+}
+
+void App::SetLongTaskThreshold(gin::Arguments* args) {
+  double threshold = 0;
+  if (!args->GetNext(&threshold) || !(threshold >= 0)) {
+    args->ThrowTypeError("threshold must be a non-negative number");
+    return;
+  }
+
+  long_task_detector_.reset();
+  if (threshold == 0)
+    return;
+  long_task_detector_ = std::make_unique<LongTaskDetector>(
+      JavascriptEnvironment::GetIsolate(), base::Milliseconds(threshold),
+      base::BindRepeating(&App::OnLongTask, base::Unretained(this)));
+}
+
+void App::OnLongTask(const LongTaskDetector::LongTask& long_task) {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  auto details = gin_helper::Dictionary::CreateEmpty(isolate);
+  details.Set("duration", long_task.duration.InMillisecondsF());
+  details.Set("postedFrom", long_task.posted_from.ToString());
+  if (!long_task.js_stack.empty())
+    details.Set("jsStack", long_task.js_stack);
+  if (!long_task.blocked_by.empty())
+    details.Set("blockedBy", long_task.blocked_by);
+  Emit("long-task", details);
+}
+
+void App::SetNearHeapLimitHeadroom(gin::Arguments* args) {
+  double headroom = 0;
+  if (!args->GetNext(&headroom) || !(headroom >= 0)) {
+    args->ThrowTypeError("headroom must be a non-negative number");
+    return;
+  }
+
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  if (near_heap_limit_headroom_ > 0)
+    isolate->RemoveNearHeapLimitCallback(&App::OnNearHeapLimit, 0);
+  near_heap_limit_headroom_ = static_cast<size_t>(headroom) * 1024 * 1024;
+  if (near_heap_limit_headroom_ > 0)
+    isolate->AddNearHeapLimitCallback(&App::OnNearHeapLimit, this);
+}
+
+// static
+size_t App::OnNearHeapLimit(void* data,
+                            size_t current_heap_limit,
+                            size_t initial_heap_limit) {
+  // Called during garbage collection, so JavaScript can only be told about
+  // it from a task of its own.
+  auto* self = static_cast<App*>(data);
+  const size_t heap_limit =
+      initial_heap_limit + self->near_heap_limit_headroom_;
+  if (current_heap_limit >= heap_limit)
+    return current_heap_limit;
+  base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+      FROM_HERE, base::BindOnce(&App::EmitNearHeapLimit, base::Unretained(self),
+                                heap_limit, initial_heap_limit));
+  return heap_limit;
+}
+
+void App::EmitNearHeapLimit(size_t heap_limit, size_t initial_heap_limit) {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  auto details = gin_helper::Dictionary::CreateEmpty(isolate);
+  // In kilobytes, like the heap statistics of process.getHeapStatistics().
+  details.Set("heapLimit", static_cast<double>(heap_limit / 1024));
+  details.Set("initialHeapLimit",
+              static_cast<double>(initial_heap_limit / 1024));
+  Emit("near-heap-limit", details);
+}
+
 v8::Local<v8::Value> App::GetGPUFeatureStatus(v8::Isolate* isolate) {
   return gin::ConvertToV8(isolate, content::GetFeatureStatus());
 }
@@ -1565,6 +1767,12 @@ v8::Local<v8::Value> App::GetDockAPI(v8::Isolate* isolate) {
 }
 #endif
 
+void DiscardHiddenFrames() {
+  // The frames of the visible pages are locked and kept, so this only
+  // discards the frames of the pages that aren't shown, in every window.
+  viz::FrameEvictionManager::GetInstance()->PurgeAllUnlockedFrames();
+}
+
 void ConfigureHostResolver(v8::Isolate* isolate,
                            const gin_helper::Dictionary& opts) {
   gin_helper::ErrorThrower thrower(isolate);
@@ -1779,8 +1987,14 @@ gin::ObjectTemplateBuilder App::GetObjectTemplateBuilder(v8::Isolate* isolate) {
                  &App::DisableDomainBlockingFor3DAPIs)
       .SetMethod("getFileIcon", &App::GetFileIcon)
       .SetMethod("getAppMetrics", &App::GetAppMetrics)
+      .SetMethod("startMetricsSampling", &App::StartMetricsSampling)
+      .SetMethod("stopMetricsSampling", &App::StopMetricsSampling)
+      .SetMethod("getMetricsSamples", &App::GetMetricsSamples)
+      .SetMethod("setLongTaskThreshold", &App::SetLongTaskThreshold)
+      .SetMethod("setNearHeapLimitHeadroom", &App::SetNearHeapLimitHeadroom)
       .SetMethod("getGPUFeatureStatus", &App::GetGPUFeatureStatus)
       .SetMethod("getGPUInfo", &App::GetGPUInfo)
+      .SetMethod("discardHiddenFrames", &DiscardHiddenFrames)
 #if IS_MAS_BUILD()
       .SetMethod("startAccessingSecurityScopedResource",
                  &App::StartAccessingSecurityScopedResource)
@@ -23,10 +23,12 @@
 #include "net/base/completion_repeating_callback.h"
 #include "net/ssl/client_cert_identity.h"
 #include "shell/browser/api/process_metric.h"
+#include "shell/browser/api/process_metrics_sampler.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/browser_observer.h"
 #include "shell/browser/electron_browser_client.h"
 #include "shell/browser/event_emitter_mixin.h"
+#include "shell/browser/long_task_detector.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/promise.h"
@@ -216,6 +218,16 @@ class App : public ElectronBrowserClient::Delegate,
                                      gin::Arguments* args);
 
   std::vector<gin_helper::Dictionary> GetAppMetrics(v8::Isolate* isolate);
+  void StartMetricsSampling(gin::Arguments* args);
+  void StopMetricsSampling();
+  v8::Local<v8::Promise> GetMetricsSamples(v8::Isolate* isolate);
+  void SetLongTaskThreshold(gin::Arguments* args);
+  void OnLongTask(const LongTaskDetector::LongTask& long_task);
+  void SetNearHeapLimitHeadroom(gin::Arguments* args);
+  static size_t OnNearHeapLimit(void* data,
+                                size_t current_heap_limit,
+                                size_t initial_heap_limit);
+  void EmitNearHeapLimit(size_t heap_limit, size_t initial_heap_limit);
   v8::Local<v8::Value> GetGPUFeatureStatus(v8::Isolate* isolate);
   v8::Local<v8::Promise> GetGPUInfo(v8::Isolate* isolate,
                                     const std::string& info_type);
@@ -265,6 +277,14 @@ class App : public ElectronBrowserClient::Delegate,
   // pid -> electron::ProcessMetric
   base::flat_map<int, std::unique_ptr<electron::ProcessMetric>> app_metrics_;
 
+  std::unique_ptr<ProcessMetricsSampler> metrics_sampler_;
+
+  std::unique_ptr<LongTaskDetector> long_task_detector_;
+
+  // How far V8 may raise the heap limit of the main process beyond its initial
+  // limit when the heap gets near it, in bytes.
+  size_t near_heap_limit_headroom_ = 0;
+
   bool disable_hw_acceleration_ = false;
   bool disable_domain_blocking_for_3DAPIs_ = false;
   bool watch_singleton_socket_on_ready_ = false;
@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -30,6 +31,8 @@
 #include "shell/common/gin_helper/persistent_dictionary.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/options_switches.h"
+#include "ui/compositor/compositor.h"
+#include "ui/views/widget/widget.h"
 
 #if defined(TOOLKIT_VIEWS)
 #include "shell/browser/native_window_views.h"
@@ -115,6 +118,7 @@ BaseWindow::BaseWindow(gin_helper::Arguments* args,
 }
 
 BaseWindow::~BaseWindow() {
+  StopObservingCompositor();
   CloseImmediately();
 
   // Remove global reference so the JS object can be garbage collected.
@@ -149,6 +153,7 @@ void BaseWindow::OnWindowClosed() {
   // there might be some delayed emit events which shouldn't be
   // triggered after this.
   weak_factory_.InvalidateWeakPtrs();
+  StopObservingCompositor();
 
   RemoveFromWeakMap();
   window_->RemoveObserver(this);
@@ -217,6 +222,7 @@ void BaseWindow::OnWindowWillResize(const gfx::Rect& new_bounds,
 
 void BaseWindow::OnWindowResize() {
   Emit("resize");
+  ScheduleBoundsChanged();
 }
 
 void BaseWindow::OnWindowResized() {
@@ -232,6 +238,7 @@ void BaseWindow::OnWindowWillMove(const gfx::Rect& new_bounds,
 
 void BaseWindow::OnWindowMove() {
   Emit("move");
+  ScheduleBoundsChanged();
 }
 
 void BaseWindow::OnWindowMoved() {
@@ -305,11 +312,29 @@ void BaseWindow::OnWindowMessage(UINT message, WPARAM w_param, LPARAM l_param) {
 }
 #endif
 
+void BaseWindow::OnAnimationStep(base::TimeTicks timestamp) {
+  StopObservingCompositor();
+  Emit("bounds-changed", window_->GetBounds());
+}
+
+void BaseWindow::OnCompositingShuttingDown(ui::Compositor* compositor) {
+  StopObservingCompositor();
+}
+
 void BaseWindow::SetContentView(gin::Handle<View> view) {
   content_view_.Reset(JavascriptEnvironment::GetIsolate(), view.ToV8());
   window_->SetContentView(view->view());
 }
 
+void BaseWindow::BatchUpdate(v8::Isolate* isolate,
+                             v8::Local<v8::Function> callback) {
+  // The batch ends even when the callback throws or destroys the window. Its
+  // exception is left for the caller.
+  NativeWindow::ScopedBatchUpdate batch_update(window_.get());
+  std::ignore = callback->Call(isolate->GetCurrentContext(),
+                               v8::Undefined(isolate), 0, nullptr);
+}
+
 void BaseWindow::CloseImmediately() {
   if (!window_->IsClosed())
     window_->CloseImmediately();
@@ -1045,6 +1070,26 @@ int32_t BaseWindow::GetID() const {
   return weak_map_id();
 }
 
+void BaseWindow::ScheduleBoundsChanged() {
+  if (bounds_changed_compositor_)
+    return;
+  ui::Compositor* compositor =
+      window_->widget() ? window_->widget()->GetCompositor() : nullptr;
+  if (!compositor) {
+    Emit("bounds-changed", window_->GetBounds());
+    return;
+  }
+  bounds_changed_compositor_ = compositor;
+  compositor->AddAnimationObserver(this);
+}
+
+void BaseWindow::StopObservingCompositor() {
+  if (!bounds_changed_compositor_)
+    return;
+  bounds_changed_compositor_->RemoveAnimationObserver(this);
+  bounds_changed_compositor_ = nullptr;
+}
+
 void BaseWindow::RemoveFromParentChildWindows() {
   if (parent_window_.IsEmpty())
     return;
@@ -1073,14 +1118,15 @@ void BaseWindow::BuildPrototype(v8::Isolate* isolate,
   gin_helper::Destroyable::MakeDestroyable(isolate, prototype);
   gin_helper::ObjectTemplateBuilder(isolate, prototype->PrototypeTemplate())
       .SetMethod("setContentView", &BaseWindow::SetContentView)
+      .SetMethod("_batchUpdate", &BaseWindow::BatchUpdate)
       .SetMethod("close", &BaseWindow::Close)
       .SetMethod("focus", &BaseWindow::Focus)
       .SetMethod("blur", &BaseWindow::Blur)
-      .SetMethod("isFocused", &BaseWindow::IsFocused)
+      .SetFastMethod<&BaseWindow::IsFocused>("isFocused")
       .SetMethod("show", &BaseWindow::Show)
       .SetMethod("showInactive", &BaseWindow::ShowInactive)
       .SetMethod("hide", &BaseWindow::Hide)
-      .SetMethod("isVisible", &BaseWindow::IsVisible)
+      .SetFastMethod<&BaseWindow::IsVisible>("isVisible")
       .SetMethod("isEnabled", &BaseWindow::IsEnabled)
       .SetMethod("setEnabled", &BaseWindow::SetEnabled)
       .SetMethod("maximize", &BaseWindow::Maximize)
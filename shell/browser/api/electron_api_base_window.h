@@ -12,6 +12,7 @@
 #include <string_view>
 #include <vector>
 
+#include "base/memory/raw_ptr.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 #include "gin/handle.h"
@@ -20,13 +21,20 @@
 #include "shell/common/api/electron_api_native_image.h"
 #include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/trackable_object.h"
+#include "shell/common/key_weak_map.h"
+#include "ui/compositor/compositor_animation_observer.h"
+
+namespace ui {
+class Compositor;
+}
 
 namespace electron::api {
 
 class View;
 
 class BaseWindow : public gin_helper::TrackableObject<BaseWindow>,
-                   public NativeWindowObserver {
+                   public NativeWindowObserver,
+                   public ui::CompositorAnimationObserver {
  public:
   static gin_helper::WrappableBase* New(gin_helper::Arguments* args);
 
@@ -87,8 +95,13 @@ class BaseWindow : public gin_helper::TrackableObject<BaseWindow>,
   void OnWindowMessage(UINT message, WPARAM w_param, LPARAM l_param) override;
 #endif
 
+  // ui::CompositorAnimationObserver:
+  void OnAnimationStep(base::TimeTicks timestamp) override;
+  void OnCompositingShuttingDown(ui::Compositor* compositor) override;
+
   // Public APIs of NativeWindow.
   void SetContentView(gin::Handle<View> view);
+  void BatchUpdate(v8::Isolate* isolate, v8::Local<v8::Function> callback);
   void Close();
   virtual void CloseImmediately();
   virtual void Focus();
@@ -249,6 +262,12 @@ class BaseWindow : public gin_helper::TrackableObject<BaseWindow>,
   // Remove this window from parent window's |child_windows_|.
   void RemoveFromParentChildWindows();
 
+  // Emits "bounds-changed" with the next frame of the window's compositor, so
+  // that however many resize and move notifications arrive in between, JS
+  // only hears about the bounds once per frame.
+  void ScheduleBoundsChanged();
+  void StopObservingCompositor();
+
   template <typename... Args>
   void EmitEventSoon(std::string_view eventName) {
     content::GetUIThreadTaskRunner({})->PostTask(
@@ -269,6 +288,9 @@ class BaseWindow : public gin_helper::TrackableObject<BaseWindow>,
 
   std::unique_ptr<NativeWindow> window_;
 
+  // The compositor observed while a "bounds-changed" event is pending.
+  raw_ptr<ui::Compositor> bounds_changed_compositor_ = nullptr;
+
   // Reference to JS wrapper to prevent garbage collection.
   v8::Global<v8::Value> self_ref_;
 
@@ -5,6 +5,7 @@
 #include "shell/browser/api/electron_api_browser_window.h"
 
 #include "base/task/single_thread_task_runner.h"
+#include "base/timer/elapsed_timer.h"
 #include "content/browser/renderer_host/render_widget_host_impl.h"  // nogncheck
 #include "content/browser/renderer_host/render_widget_host_owner_delegate.h"  // nogncheck
 #include "content/browser/web_contents/web_contents_impl.h"  // nogncheck
@@ -16,6 +17,7 @@
 #include "shell/browser/web_contents_preferences.h"
 #include "shell/browser/window_list.h"
 #include "shell/common/color_util.h"
+#include "shell/common/electron_histograms.h"
 #include "shell/common/gin_helper/constructor.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/object_template_builder.h"
@@ -382,6 +384,13 @@ void BrowserWindow::OnWindowHide() {
   BaseWindow::OnWindowHide();
 }
 
+void BrowserWindow::OnWindowOcclusionChanged(bool occluded) {
+  if (occluded)
+    web_contents()->WasOccluded();
+  else
+    web_contents()->WasShown();
+}
+
 // static
 gin_helper::WrappableBase* BrowserWindow::New(gin_helper::ErrorThrower thrower,
                                               gin::Arguments* args) {
@@ -400,7 +409,10 @@ gin_helper::WrappableBase* BrowserWindow::New(gin_helper::ErrorThrower thrower,
     options = gin::Dictionary::CreateEmpty(args->isolate());
   }
 
-  return new BrowserWindow(args, options);
+  base::ElapsedTimer timer;
+  auto* window = new BrowserWindow(args, options);
+  histograms::RecordWindowCreationTime(timer.Elapsed());
+  return window;
 }
 
 // static
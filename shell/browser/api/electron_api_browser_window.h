@@ -70,6 +70,7 @@ class BrowserWindow : public BaseWindow,
   void SetBackgroundColor(const std::string& color_name) override;
   void OnWindowShow() override;
   void OnWindowHide() override;
+  void OnWindowOcclusionChanged(bool occluded) override;
 
   // BrowserWindow APIs.
   void FocusOnWebView();
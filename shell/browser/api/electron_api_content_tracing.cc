@@ -2,12 +2,15 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include <memory>
 #include <optional>
 #include <set>
 #include <string>
 #include <utility>
 
 #include "base/files/file_util.h"
+#include "base/no_destructor.h"
+#include "base/task/bind_post_task.h"
 #include "base/task/thread_pool.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/trace_event/trace_config.h"
@@ -57,6 +60,43 @@ struct Converter<base::trace_event::TraceConfig> {
 namespace {
 
 using CompletionCallback = base::OnceCallback<void(const base::FilePath&)>;
+using ChunkCallback = base::RepeatingCallback<void(const std::string&)>;
+
+// The config of the recording in progress, which dumpRecording restarts
+// recording with.
+std::optional<base::trace_event::TraceConfig>& CurrentTraceConfig() {
+  static base::NoDestructor<std::optional<base::trace_event::TraceConfig>>
+      config;
+  return *config;
+}
+
+// Hands the chunks of trace data to a JS callback as they are read from the
+// tracing service, instead of collecting them into a file.
+class CallbackTraceDataEndpoint : public TracingController::TraceDataEndpoint {
+ public:
+  // Both callbacks are run on the sequence of the caller, since the endpoint
+  // is called on the sequence reading the trace data.
+  CallbackTraceDataEndpoint(ChunkCallback on_chunk, base::OnceClosure on_done)
+      : on_chunk_(base::BindPostTaskToCurrentDefault(std::move(on_chunk))),
+        on_done_(base::BindPostTaskToCurrentDefault(std::move(on_done))) {}
+
+  // disable copy
+  CallbackTraceDataEndpoint(const CallbackTraceDataEndpoint&) = delete;
+  CallbackTraceDataEndpoint& operator=(const CallbackTraceDataEndpoint&) =
+      delete;
+
+  // TracingController::TraceDataEndpoint:
+  void ReceiveTraceChunk(std::unique_ptr<std::string> chunk) override {
+    on_chunk_.Run(*chunk);
+  }
+  void ReceivedTraceFinalContents() override { std::move(on_done_).Run(); }
+
+ private:
+  ~CallbackTraceDataEndpoint() override = default;
+
+  ChunkCallback on_chunk_;
+  base::OnceClosure on_done_;
+};
 
 std::optional<base::FilePath> CreateTemporaryFileOnIO() {
   base::FilePath temp_file_path;
@@ -65,18 +105,47 @@ std::optional<base::FilePath> CreateTemporaryFileOnIO() {
   return std::make_optional(std::move(temp_file_path));
 }
 
+// Settles the promise of dumpRecording once recording has been started again.
+void OnTracingRestarted(gin_helper::Promise<base::FilePath> promise,
+                        const base::FilePath& path,
+                        bool restarted) {
+  if (restarted) {
+    promise.Resolve(path);
+  } else {
+    promise.RejectWithErrorMessage(
+        "Failed to start tracing again, trace data was written to " +
+        path.AsUTF8Unsafe());
+  }
+}
+
+// Stops recording into |file_path|. With |restart| set, recording is started
+// again with the same config once the trace data has been written.
 void StopTracing(gin_helper::Promise<base::FilePath> promise,
+                 bool restart,
                  std::optional<base::FilePath> file_path) {
   auto resolve_or_reject = base::BindOnce(
-      [](gin_helper::Promise<base::FilePath> promise,
+      [](gin_helper::Promise<base::FilePath> promise, bool restart,
          const base::FilePath& path, std::optional<std::string> error) {
         if (error) {
           promise.RejectWithErrorMessage(error.value());
-        } else {
+          return;
+        }
+        auto& config = CurrentTraceConfig();
+        if (!restart || !config) {
+          config.reset();
           promise.Resolve(path);
+          return;
+        }
+        auto split_callback = base::SplitOnceCallback(
+            base::BindOnce(&OnTracingRestarted, std::move(promise), path));
+        if (!TracingController::GetInstance()->StartTracing(
+                *config, base::BindOnce(std::move(split_callback.first),
+                                        true))) {
+          config.reset();
+          std::move(split_callback.second).Run(false);
         }
       },
-      std::move(promise), *file_path);
+      std::move(promise), restart, file_path.value_or(base::FilePath()));
 
   auto* instance = TracingController::GetInstance();
   if (!instance->IsTracing()) {
@@ -99,21 +168,65 @@ void StopTracing(gin_helper::Promise<base::FilePath> promise,
   }
 }
 
-v8::Local<v8::Promise> StopRecording(gin_helper::Arguments* args) {
+v8::Local<v8::Promise> StopRecordingToFile(gin_helper::Arguments* args,
+                                           bool restart) {
   gin_helper::Promise<base::FilePath> promise(args->isolate());
   v8::Local<v8::Promise> handle = promise.GetHandle();
 
   base::FilePath path;
   if (args->GetNext(&path) && !path.empty()) {
-    StopTracing(std::move(promise), std::make_optional(path));
+    StopTracing(std::move(promise), restart, std::make_optional(path));
   } else {
     // use a temporary file.
     base::ThreadPool::PostTaskAndReplyWithResult(
         FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
         base::BindOnce(CreateTemporaryFileOnIO),
-        base::BindOnce(StopTracing, std::move(promise)));
+        base::BindOnce(StopTracing, std::move(promise), restart));
+  }
+
+  return handle;
+}
+
+v8::Local<v8::Promise> StopRecording(gin_helper::Arguments* args) {
+  return StopRecordingToFile(args, false);
+}
+
+v8::Local<v8::Promise> DumpRecording(gin_helper::Arguments* args) {
+  return StopRecordingToFile(args, true);
+}
+
+v8::Local<v8::Promise> StopRecordingToCallback(v8::Isolate* isolate,
+                                               ChunkCallback on_chunk) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  auto* instance = TracingController::GetInstance();
+  if (!instance->IsTracing()) {
+    promise.RejectWithErrorMessage(
+        "Failed to stop tracing - no trace in progress");
+    return handle;
   }
 
+  auto resolve_or_reject = base::BindOnce(
+      [](gin_helper::Promise<void> promise, std::optional<std::string> error) {
+        if (error) {
+          promise.RejectWithErrorMessage(error.value());
+        } else {
+          promise.Resolve();
+        }
+      },
+      std::move(promise));
+
+  auto split_callback = base::SplitOnceCallback(std::move(resolve_or_reject));
+  auto endpoint = base::MakeRefCounted<CallbackTraceDataEndpoint>(
+      std::move(on_chunk),
+      base::BindOnce(std::move(split_callback.first), std::nullopt));
+  if (!instance->StopTracing(endpoint)) {
+    std::move(split_callback.second)
+        .Run(std::make_optional("Failed to stop tracing"));
+    return handle;
+  }
+  CurrentTraceConfig().reset();
   return handle;
 }
 
@@ -145,6 +258,7 @@ v8::Local<v8::Promise> StartTracing(
     // this point).
     return gin_helper::Promise<void>::ResolvedPromise(isolate);
   }
+  CurrentTraceConfig() = trace_config;
   return handle;
 }
 
@@ -177,6 +291,8 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("getCategories", &GetCategories);
   dict.SetMethod("startRecording", &StartTracing);
   dict.SetMethod("stopRecording", &StopRecording);
+  dict.SetMethod("stopRecordingToCallback", &StopRecordingToCallback);
+  dict.SetMethod("dumpRecording", &DumpRecording);
   dict.SetMethod("getTraceBufferUsage", &GetTraceBufferUsage);
 }
 
@@ -4,20 +4,30 @@
 
 #include "shell/browser/api/electron_api_cookies.h"
 
+#include <algorithm>
+#include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
+#include "base/barrier_callback.h"
+#include "base/barrier_closure.h"
+#include "base/pickle.h"
 #include "base/time/time.h"
 #include "base/values.h"
 #include "content/public/browser/browser_context.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/storage_partition.h"
+#include "gin/arguments.h"
 #include "gin/dictionary.h"
 #include "gin/object_template_builder.h"
+#include "net/base/schemeful_site.h"
 #include "net/cookies/canonical_cookie.h"
 #include "net/cookies/cookie_inclusion_status.h"
+#include "net/cookies/cookie_partition_key.h"
 #include "net/cookies/cookie_store.h"
 #include "net/cookies/cookie_util.h"
 #include "shell/browser/cookie_change_notifier.h"
@@ -27,6 +37,7 @@
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/object_template_builder.h"
+#include "shell/common/node_includes.h"
 
 namespace gin {
 
@@ -214,6 +225,199 @@ std::string StringToCookieSameSite(const std::string* str_ptr,
   return "";
 }
 
+// Creates the cookie described by the |details| of cookies.set(), setting
+// |url| to the URL it is set for, or returns null and sets |error|.
+std::unique_ptr<net::CanonicalCookie> CreateCookie(
+    const base::Value::Dict& details,
+    GURL* url,
+    std::string* error) {
+  const std::string* url_string = details.FindString("url");
+  if (!url_string) {
+    *error = "Missing required option 'url'";
+    return nullptr;
+  }
+  const std::string* name = details.FindString("name");
+  const std::string* value = details.FindString("value");
+  const std::string* domain = details.FindString("domain");
+  const std::string* path = details.FindString("path");
+  bool http_only = details.FindBool("httpOnly").value_or(false);
+  const std::string* same_site_string = details.FindString("sameSite");
+  net::CookieSameSite same_site;
+  *error = StringToCookieSameSite(same_site_string, &same_site);
+  if (!error->empty())
+    return nullptr;
+  bool secure = details.FindBool("secure").value_or(
+      same_site == net::CookieSameSite::NO_RESTRICTION);
+
+  *url = GURL(*url_string);
+  if (!url->is_valid()) {
+    *error = InclusionStatusToString(net::CookieInclusionStatus(
+        net::CookieInclusionStatus::EXCLUDE_INVALID_DOMAIN));
+    return nullptr;
+  }
+
+  net::CookieInclusionStatus status;
+  auto canonical_cookie = net::CanonicalCookie::CreateSanitizedCookie(
+      *url, name ? *name : "", value ? *value : "", domain ? *domain : "",
+      path ? *path : "", ParseTimeProperty(details.FindDouble("creationDate")),
+      ParseTimeProperty(details.FindDouble("expirationDate")),
+      ParseTimeProperty(details.FindDouble("lastAccessDate")), secure,
+      http_only, same_site, net::COOKIE_PRIORITY_DEFAULT, std::nullopt,
+      &status);
+
+  if (!canonical_cookie || !canonical_cookie->IsCanonical()) {
+    *error = InclusionStatusToString(
+        !status.IsInclude()
+            ? status
+            : net::CookieInclusionStatus(
+                  net::CookieInclusionStatus::EXCLUDE_FAILURE_TO_STORE));
+    return nullptr;
+  }
+  return canonical_cookie;
+}
+
+net::CookieOptions GetSetOptions(const net::CanonicalCookie& cookie) {
+  net::CookieOptions options;
+  if (cookie.IsHttpOnly())
+    options.set_include_httponly();
+  options.set_same_site_cookie_context(
+      net::CookieOptions::SameSiteCookieContext::MakeInclusive());
+  return options;
+}
+
+using IndexedError = std::pair<size_t, std::string>;
+
+void ResolveWithErrors(gin_helper::Promise<std::vector<std::string>> promise,
+                       std::vector<IndexedError> results) {
+  std::vector<std::string> errors(results.size());
+  for (auto& [index, error] : results)
+    errors[index] = std::move(error);
+  promise.Resolve(errors);
+}
+
+void ResolveWithCookieLists(
+    gin_helper::Promise<std::vector<net::CookieList>> promise,
+    std::vector<std::pair<size_t, net::CookieList>> results) {
+  std::vector<net::CookieList> lists(results.size());
+  for (auto& [index, list] : results)
+    lists[index] = std::move(list);
+  promise.Resolve(lists);
+}
+
+// The cookie jar is exported as a pickle of this version followed by the
+// number of cookies and their fields.
+constexpr int kCookieJarVersion = 2;
+
+// Cookies partitioned by a nonce belong to a single frame tree, so they can't
+// be exported.
+bool IsExportable(const net::CanonicalCookie& cookie) {
+  return !cookie.IsPartitioned() || !cookie.PartitionKey()->nonce();
+}
+
+void WriteCookieJar(base::Pickle* pickle, const net::CookieList& cookies) {
+  pickle->WriteInt(kCookieJarVersion);
+  pickle->WriteUInt64(std::ranges::count_if(cookies, &IsExportable));
+  for (const auto& cookie : cookies) {
+    if (!IsExportable(cookie))
+      continue;
+    pickle->WriteString(cookie.Name());
+    pickle->WriteString(cookie.Value());
+    pickle->WriteString(cookie.Domain());
+    pickle->WriteString(cookie.Path());
+    pickle->WriteInt64(
+        cookie.CreationDate().ToDeltaSinceWindowsEpoch().InMicroseconds());
+    pickle->WriteInt64(
+        cookie.ExpiryDate().ToDeltaSinceWindowsEpoch().InMicroseconds());
+    pickle->WriteInt64(
+        cookie.LastAccessDate().ToDeltaSinceWindowsEpoch().InMicroseconds());
+    pickle->WriteBool(cookie.SecureAttribute());
+    pickle->WriteBool(cookie.IsHttpOnly());
+    pickle->WriteInt(static_cast<int>(cookie.SameSite()));
+    pickle->WriteInt(static_cast<int>(cookie.Priority()));
+    pickle->WriteInt64(
+        cookie.LastUpdateDate().ToDeltaSinceWindowsEpoch().InMicroseconds());
+    pickle->WriteBool(cookie.IsPartitioned());
+    if (cookie.IsPartitioned())
+      pickle->WriteString(cookie.PartitionKey()->site().Serialize());
+    pickle->WriteInt(static_cast<int>(cookie.SourceScheme()));
+    pickle->WriteInt(cookie.SourcePort());
+  }
+}
+
+base::Time ReadTime(base::PickleIterator* iter, bool* ok) {
+  int64_t microseconds = 0;
+  *ok = *ok && iter->ReadInt64(&microseconds);
+  return base::Time::FromDeltaSinceWindowsEpoch(
+      base::Microseconds(microseconds));
+}
+
+// Returns false if |data| isn't a cookie jar exported by cookies.export().
+bool ReadCookieJar(
+    const char* data,
+    size_t size,
+    std::vector<std::pair<GURL, std::unique_ptr<net::CanonicalCookie>>>*
+        cookies) {
+  base::Pickle pickle(data, size);
+  base::PickleIterator iter(pickle);
+  int version;
+  uint64_t count;
+  if (!iter.ReadInt(&version) || version != kCookieJarVersion ||
+      !iter.ReadUInt64(&count))
+    return false;
+
+  for (uint64_t i = 0; i < count; ++i) {
+    std::string name, value, domain, path;
+    bool secure, http_only;
+    int same_site, priority, source_scheme, source_port;
+    bool partitioned;
+    std::string partition_site;
+    bool ok = iter.ReadString(&name) && iter.ReadString(&value) &&
+              iter.ReadString(&domain) && iter.ReadString(&path);
+    base::Time creation = ReadTime(&iter, &ok);
+    base::Time expiry = ReadTime(&iter, &ok);
+    base::Time last_access = ReadTime(&iter, &ok);
+    ok = ok && iter.ReadBool(&secure) && iter.ReadBool(&http_only) &&
+         iter.ReadInt(&same_site) && iter.ReadInt(&priority);
+    if (!ok || same_site < static_cast<int>(net::CookieSameSite::UNSPECIFIED) ||
+        same_site > static_cast<int>(net::CookieSameSite::kMaxValue) ||
+        priority < net::COOKIE_PRIORITY_LOW ||
+        priority > net::COOKIE_PRIORITY_HIGH)
+      return false;
+
+    base::Time last_update = ReadTime(&iter, &ok);
+    ok = ok && iter.ReadBool(&partitioned) &&
+         (!partitioned || iter.ReadString(&partition_site)) &&
+         iter.ReadInt(&source_scheme) && iter.ReadInt(&source_port);
+    if (!ok ||
+        source_scheme < static_cast<int>(net::CookieSourceScheme::kUnset) ||
+        source_scheme > static_cast<int>(net::CookieSourceScheme::kMaxValue))
+      return false;
+
+    std::optional<net::CookiePartitionKey> partition_key;
+    if (partitioned) {
+      GURL partition_url(partition_site);
+      if (!partition_url.is_valid())
+        return false;
+      partition_key = net::CookiePartitionKey::FromWire(
+          net::SchemefulSite(partition_url));
+    }
+
+    // The cookies are restored like the cookie store loads them, keeping the
+    // partition key and the source scheme and port they were set with.
+    auto cookie = net::CanonicalCookie::FromStorage(
+        name, value, domain, path, creation, expiry, last_access, last_update,
+        secure, http_only, static_cast<net::CookieSameSite>(same_site),
+        static_cast<net::CookiePriority>(priority), std::move(partition_key),
+        static_cast<net::CookieSourceScheme>(source_scheme), source_port);
+    GURL url = net::cookie_util::CookieOriginToURL(domain, secure);
+    // Cookies which are no longer valid, like expired ones, are skipped.
+    if (cookie && cookie->IsCanonical() &&
+        !cookie->IsExpired(base::Time::Now()))
+      cookies->emplace_back(std::move(url), std::move(cookie));
+  }
+  return true;
+}
+
 }  // namespace
 
 gin::WrapperInfo Cookies::kWrapperInfo = {gin::kEmbedderNativeGin};
@@ -289,63 +493,19 @@ v8::Local<v8::Promise> Cookies::Set(v8::Isolate* isolate,
   gin_helper::Promise<void> promise(isolate);
   v8::Local<v8::Promise> handle = promise.GetHandle();
 
-  const std::string* url_string = details.FindString("url");
-  if (!url_string) {
-    promise.RejectWithErrorMessage("Missing required option 'url'");
-    return handle;
-  }
-  const std::string* name = details.FindString("name");
-  const std::string* value = details.FindString("value");
-  const std::string* domain = details.FindString("domain");
-  const std::string* path = details.FindString("path");
-  bool http_only = details.FindBool("httpOnly").value_or(false);
-  const std::string* same_site_string = details.FindString("sameSite");
-  net::CookieSameSite same_site;
-  std::string error = StringToCookieSameSite(same_site_string, &same_site);
-  if (!error.empty()) {
+  GURL url;
+  std::string error;
+  std::unique_ptr<net::CanonicalCookie> canonical_cookie =
+      CreateCookie(details, &url, &error);
+  if (!canonical_cookie) {
     promise.RejectWithErrorMessage(error);
     return handle;
   }
-  bool secure = details.FindBool("secure").value_or(
-      same_site == net::CookieSameSite::NO_RESTRICTION);
-
-  GURL url(url_string ? *url_string : "");
-  if (!url.is_valid()) {
-    promise.RejectWithErrorMessage(
-        InclusionStatusToString(net::CookieInclusionStatus(
-            net::CookieInclusionStatus::EXCLUDE_INVALID_DOMAIN)));
-    return handle;
-  }
-
-  net::CookieInclusionStatus status;
-  auto canonical_cookie = net::CanonicalCookie::CreateSanitizedCookie(
-      url, name ? *name : "", value ? *value : "", domain ? *domain : "",
-      path ? *path : "", ParseTimeProperty(details.FindDouble("creationDate")),
-      ParseTimeProperty(details.FindDouble("expirationDate")),
-      ParseTimeProperty(details.FindDouble("lastAccessDate")), secure,
-      http_only, same_site, net::COOKIE_PRIORITY_DEFAULT, std::nullopt,
-      &status);
-
-  if (!canonical_cookie || !canonical_cookie->IsCanonical()) {
-    promise.RejectWithErrorMessage(InclusionStatusToString(
-        !status.IsInclude()
-            ? status
-            : net::CookieInclusionStatus(
-                  net::CookieInclusionStatus::EXCLUDE_FAILURE_TO_STORE)));
-    return handle;
-  }
-
-  net::CookieOptions options;
-  if (http_only) {
-    options.set_include_httponly();
-  }
-  options.set_same_site_cookie_context(
-      net::CookieOptions::SameSiteCookieContext::MakeInclusive());
 
   auto* storage_partition = browser_context_->GetDefaultStoragePartition();
   auto* manager = storage_partition->GetCookieManagerForBrowserProcess();
   manager->SetCanonicalCookie(
-      *canonical_cookie, url, options,
+      *canonical_cookie, url, GetSetOptions(*canonical_cookie),
       base::BindOnce(
           [](gin_helper::Promise<void> promise, net::CookieAccessResult r) {
             if (r.status.IsInclude()) {
@@ -359,6 +519,219 @@ v8::Local<v8::Promise> Cookies::Set(v8::Isolate* isolate,
   return handle;
 }
 
+v8::Local<v8::Promise> Cookies::GetMany(
+    v8::Isolate* isolate,
+    const std::vector<gin_helper::Dictionary>& filters) {
+  gin_helper::Promise<std::vector<net::CookieList>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  auto* storage_partition = browser_context_->GetDefaultStoragePartition();
+  auto* manager = storage_partition->GetCookieManagerForBrowserProcess();
+
+  // All the filters without a URL share a single read of the cookie jar.
+  auto barrier = base::BarrierCallback<std::pair<size_t, net::CookieList>>(
+      filters.size(),
+      base::BindOnce(&ResolveWithCookieLists, std::move(promise)));
+  std::vector<std::pair<size_t, base::Value::Dict>> jar_filters;
+  for (size_t i = 0; i < filters.size(); ++i) {
+    base::Value::Dict dict;
+    gin::ConvertFromV8(isolate, filters[i].GetHandle(), &dict);
+
+    std::string url;
+    filters[i].Get("url", &url);
+    if (url.empty()) {
+      jar_filters.emplace_back(i, std::move(dict));
+      continue;
+    }
+
+    net::CookieOptions options;
+    options.set_include_httponly();
+    options.set_same_site_cookie_context(
+        net::CookieOptions::SameSiteCookieContext::MakeInclusive());
+    options.set_do_not_update_access_time();
+    manager->GetCookieList(
+        GURL(url), options, net::CookiePartitionKeyCollection::Todo(),
+        base::BindOnce(
+            [](base::RepeatingCallback<void(std::pair<size_t, net::CookieList>)>
+                   barrier,
+               size_t index, base::Value::Dict filter,
+               const net::CookieAccessResultList& list,
+               const net::CookieAccessResultList& excluded_list) {
+              net::CookieList result;
+              for (const auto& cookie :
+                   net::cookie_util::StripAccessResults(list)) {
+                if (MatchesCookie(filter, cookie))
+                  result.push_back(cookie);
+              }
+              barrier.Run({index, std::move(result)});
+            },
+            barrier, i, std::move(dict)));
+  }
+
+  if (!jar_filters.empty()) {
+    manager->GetAllCookies(base::BindOnce(
+        [](base::RepeatingCallback<void(std::pair<size_t, net::CookieList>)>
+               barrier,
+           std::vector<std::pair<size_t, base::Value::Dict>> filters,
+           const net::CookieList& cookies) {
+          for (const auto& [index, filter] : filters) {
+            net::CookieList result;
+            for (const auto& cookie : cookies) {
+              if (MatchesCookie(filter, cookie))
+                result.push_back(cookie);
+            }
+            barrier.Run({index, std::move(result)});
+          }
+        },
+        barrier, std::move(jar_filters)));
+  }
+
+  return handle;
+}
+
+v8::Local<v8::Promise> Cookies::RemoveMany(
+    v8::Isolate* isolate,
+    const std::vector<gin_helper::Dictionary>& cookies) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  std::vector<network::mojom::CookieDeletionFilterPtr> deletion_filters;
+  for (const auto& cookie : cookies) {
+    GURL url;
+    std::string name;
+    if (!cookie.Get("url", &url) || !cookie.Get("name", &name)) {
+      promise.RejectWithErrorMessage(
+          "Each cookie must have a 'url' and a 'name'");
+      return handle;
+    }
+    auto filter = network::mojom::CookieDeletionFilter::New();
+    filter->url = std::move(url);
+    filter->cookie_name = std::move(name);
+    deletion_filters.push_back(std::move(filter));
+  }
+
+  auto* storage_partition = browser_context_->GetDefaultStoragePartition();
+  auto* manager = storage_partition->GetCookieManagerForBrowserProcess();
+
+  // The calls are pipelined over the same connection to the network service,
+  // so none of them waits for the previous one.
+  base::RepeatingClosure barrier = base::BarrierClosure(
+      deletion_filters.size(),
+      base::BindOnce(gin_helper::Promise<void>::ResolvePromise,
+                     std::move(promise)));
+  for (auto& filter : deletion_filters) {
+    manager->DeleteCookies(
+        std::move(filter),
+        base::BindOnce([](base::RepeatingClosure barrier,
+                          uint32_t num_deleted) { barrier.Run(); },
+                       barrier));
+  }
+
+  return handle;
+}
+
+v8::Local<v8::Promise> Cookies::SetMany(
+    v8::Isolate* isolate,
+    std::vector<base::Value::Dict> details) {
+  gin_helper::Promise<std::vector<std::string>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  auto* storage_partition = browser_context_->GetDefaultStoragePartition();
+  auto* manager = storage_partition->GetCookieManagerForBrowserProcess();
+
+  auto barrier = base::BarrierCallback<IndexedError>(
+      details.size(), base::BindOnce(&ResolveWithErrors, std::move(promise)));
+  for (size_t i = 0; i < details.size(); ++i) {
+    GURL url;
+    std::string error;
+    std::unique_ptr<net::CanonicalCookie> canonical_cookie =
+        CreateCookie(details[i], &url, &error);
+    if (!canonical_cookie) {
+      barrier.Run({i, std::move(error)});
+      continue;
+    }
+
+    manager->SetCanonicalCookie(
+        *canonical_cookie, url, GetSetOptions(*canonical_cookie),
+        base::BindOnce(
+            [](base::RepeatingCallback<void(IndexedError)> barrier,
+               size_t index, net::CookieAccessResult r) {
+              std::string error;
+              if (!r.status.IsInclude())
+                error = InclusionStatusToString(r.status);
+              barrier.Run({index, std::move(error)});
+            },
+            barrier, i));
+  }
+
+  return handle;
+}
+
+v8::Local<v8::Promise> Cookies::Export(v8::Isolate* isolate) {
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  auto* storage_partition = browser_context_->GetDefaultStoragePartition();
+  auto* manager = storage_partition->GetCookieManagerForBrowserProcess();
+
+  manager->GetAllCookies(base::BindOnce(
+      [](gin_helper::Promise<v8::Local<v8::Value>> promise,
+         const net::CookieList& cookies) {
+        base::Pickle pickle;
+        WriteCookieJar(&pickle, cookies);
+
+        v8::Isolate* isolate = promise.isolate();
+        v8::HandleScope handle_scope(isolate);
+        v8::Local<v8::Value> buffer =
+            node::Buffer::Copy(isolate, pickle.data_as_char(), pickle.size())
+                .ToLocalChecked();
+        promise.Resolve(buffer);
+      },
+      std::move(promise)));
+
+  return handle;
+}
+
+v8::Local<v8::Promise> Cookies::Import(v8::Isolate* isolate,
+                                       v8::Local<v8::Value> buffer) {
+  gin_helper::Promise<uint32_t> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  std::vector<std::pair<GURL, std::unique_ptr<net::CanonicalCookie>>> cookies;
+  if (!node::Buffer::HasInstance(buffer) ||
+      !ReadCookieJar(node::Buffer::Data(buffer), node::Buffer::Length(buffer),
+                     &cookies)) {
+    promise.RejectWithErrorMessage(
+        "Expected a buffer returned by cookies.export()");
+    return handle;
+  }
+
+  auto* storage_partition = browser_context_->GetDefaultStoragePartition();
+  auto* manager = storage_partition->GetCookieManagerForBrowserProcess();
+
+  // Resolves with the number of cookies which have been stored.
+  auto barrier = base::BarrierCallback<bool>(
+      cookies.size(),
+      base::BindOnce(
+          [](gin_helper::Promise<uint32_t> promise, std::vector<bool> results) {
+            promise.Resolve(
+                static_cast<uint32_t>(std::ranges::count(results, true)));
+          },
+          std::move(promise)));
+  for (const auto& [url, cookie] : cookies) {
+    manager->SetCanonicalCookie(
+        *cookie, url, GetSetOptions(*cookie),
+        base::BindOnce(
+            [](base::RepeatingCallback<void(bool)> barrier,
+               net::CookieAccessResult r) {
+              barrier.Run(r.status.IsInclude());
+            },
+            barrier));
+  }
+
+  return handle;
+}
+
 v8::Local<v8::Promise> Cookies::FlushStore(v8::Isolate* isolate) {
   gin_helper::Promise<void> promise(isolate);
   v8::Local<v8::Promise> handle = promise.GetHandle();
@@ -372,7 +745,68 @@ v8::Local<v8::Promise> Cookies::FlushStore(v8::Isolate* isolate) {
   return handle;
 }
 
+void Cookies::SetChangeNotificationOptions(gin::Arguments* args) {
+  gin_helper::Dictionary options;
+  if (!args->GetNext(&options)) {
+    args->ThrowTypeError("Expected an options object");
+    return;
+  }
+
+  std::vector<ChangeFilter> filters;
+  std::vector<gin_helper::Dictionary> filter_dicts;
+  options.Get("filters", &filter_dicts);
+  for (const auto& filter_dict : filter_dicts) {
+    ChangeFilter filter;
+    filter_dict.Get("domain", &filter.domain);
+    filter_dict.Get("name", &filter.name);
+    if (filter.domain.empty() && filter.name.empty()) {
+      args->ThrowTypeError("Each filter must have a 'domain' or a 'name'");
+      return;
+    }
+    filters.push_back(std::move(filter));
+  }
+
+  double batch_interval = 0;
+  options.Get("batchInterval", &batch_interval);
+  if (!(batch_interval >= 0)) {
+    args->ThrowTypeError("batchInterval must be a non-negative number");
+    return;
+  }
+
+  change_filters_ = std::move(filters);
+  batch_interval_ = base::Milliseconds(batch_interval);
+  // Changes still waiting for the previous interval are sent right away.
+  if (batch_timer_.IsRunning() || !pending_changes_.empty()) {
+    batch_timer_.Stop();
+    EmitChangedBatch();
+  }
+}
+
+bool Cookies::MatchesChangeFilters(const net::CanonicalCookie& cookie) const {
+  if (change_filters_.empty())
+    return true;
+  for (const auto& filter : change_filters_) {
+    if (!filter.name.empty() && filter.name != cookie.Name())
+      continue;
+    if (filter.domain.empty() || MatchesDomain(filter.domain, cookie.Domain()))
+      return true;
+  }
+  return false;
+}
+
 void Cookies::OnCookieChanged(const net::CookieChangeInfo& change) {
+  if (!MatchesChangeFilters(change.cookie))
+    return;
+
+  if (batch_interval_.is_positive()) {
+    pending_changes_.push_back(change);
+    if (!batch_timer_.IsRunning()) {
+      batch_timer_.Start(FROM_HERE, batch_interval_, this,
+                         &Cookies::EmitChangedBatch);
+    }
+    return;
+  }
+
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope scope(isolate);
   Emit("changed", gin::ConvertToV8(isolate, change.cookie),
@@ -381,6 +815,25 @@ void Cookies::OnCookieChanged(const net::CookieChangeInfo& change) {
                         change.cause != net::CookieChangeCause::INSERTED));
 }
 
+void Cookies::EmitChangedBatch() {
+  if (pending_changes_.empty())
+    return;
+
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope scope(isolate);
+  std::vector<v8::Local<v8::Value>> changes;
+  changes.reserve(pending_changes_.size());
+  for (const auto& change : pending_changes_) {
+    auto dict = gin_helper::Dictionary::CreateEmpty(isolate);
+    dict.Set("cookie", change.cookie);
+    dict.Set("cause", change.cause);
+    dict.Set("removed", change.cause != net::CookieChangeCause::INSERTED);
+    changes.push_back(dict.GetHandle());
+  }
+  pending_changes_.clear();
+  Emit("changed-batch", changes);
+}
+
 // static
 gin::Handle<Cookies> Cookies::Create(v8::Isolate* isolate,
                                      ElectronBrowserContext* browser_context) {
@@ -394,7 +847,14 @@ gin::ObjectTemplateBuilder Cookies::GetObjectTemplateBuilder(
       .SetMethod("get", &Cookies::Get)
       .SetMethod("remove", &Cookies::Remove)
       .SetMethod("set", &Cookies::Set)
-      .SetMethod("flushStore", &Cookies::FlushStore);
+      .SetMethod("getMany", &Cookies::GetMany)
+      .SetMethod("removeMany", &Cookies::RemoveMany)
+      .SetMethod("setMany", &Cookies::SetMany)
+      .SetMethod("export", &Cookies::Export)
+      .SetMethod("import", &Cookies::Import)
+      .SetMethod("flushStore", &Cookies::FlushStore)
+      .SetMethod("setChangeNotificationOptions",
+                 &Cookies::SetChangeNotificationOptions);
 }
 
 const char* Cookies::GetTypeName() {
@@ -6,9 +6,11 @@
 #define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_COOKIES_H_
 
 #include <string>
+#include <vector>
 
 #include "base/callback_list.h"
 #include "base/memory/raw_ptr.h"
+#include "base/timer/timer.h"
 #include "base/values.h"
 #include "gin/handle.h"
 #include "net/cookies/canonical_cookie.h"
@@ -17,6 +19,10 @@
 #include "shell/common/gin_helper/promise.h"
 #include "shell/common/gin_helper/trackable_object.h"
 
+namespace gin {
+class Arguments;
+}
+
 namespace gin_helper {
 class Dictionary;
 }
@@ -53,14 +59,42 @@ class Cookies : public gin::Wrappable<Cookies>,
   v8::Local<v8::Promise> Remove(v8::Isolate*,
                                 const GURL& url,
                                 const std::string& name);
+  v8::Local<v8::Promise> GetMany(
+      v8::Isolate*,
+      const std::vector<gin_helper::Dictionary>& filters);
+  v8::Local<v8::Promise> SetMany(v8::Isolate*,
+                                 std::vector<base::Value::Dict> details);
+  v8::Local<v8::Promise> RemoveMany(
+      v8::Isolate*,
+      const std::vector<gin_helper::Dictionary>& cookies);
+  v8::Local<v8::Promise> Export(v8::Isolate*);
+  v8::Local<v8::Promise> Import(v8::Isolate*, v8::Local<v8::Value> buffer);
   v8::Local<v8::Promise> FlushStore(v8::Isolate*);
+  void SetChangeNotificationOptions(gin::Arguments* args);
 
   // CookieChangeNotifier subscription:
   void OnCookieChanged(const net::CookieChangeInfo& change);
 
  private:
+  struct ChangeFilter {
+    std::string domain;
+    std::string name;
+  };
+
+  bool MatchesChangeFilters(const net::CanonicalCookie& cookie) const;
+  void EmitChangedBatch();
+
   base::CallbackListSubscription cookie_change_subscription_;
 
+  // Only the changes of cookies matching one of them are emitted, or all of
+  // them when there is none.
+  std::vector<ChangeFilter> change_filters_;
+  // When positive, changes are emitted together as 'changed-batch' events at
+  // most this often, instead of one 'changed' event each.
+  base::TimeDelta batch_interval_;
+  std::vector<net::CookieChangeInfo> pending_changes_;
+  base::OneShotTimer batch_timer_;
+
   // Weak reference; ElectronBrowserContext is guaranteed to outlive us.
   raw_ptr<ElectronBrowserContext> browser_context_;
 };
@@ -264,9 +264,11 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("start", &electron::api::crash_reporter::Start);
 #if IS_MAS_BUILD()
   dict.SetMethod("addExtraParameter", &electron::api::crash_reporter::NoOp);
+  dict.SetMethod("addExtraParameters", &electron::api::crash_reporter::NoOp);
   dict.SetMethod("removeExtraParameter", &electron::api::crash_reporter::NoOp);
 #else
   dict.SetMethod("addExtraParameter", &electron::crash_keys::SetCrashKey);
+  dict.SetMethod("addExtraParameters", &electron::crash_keys::SetCrashKeys);
   dict.SetMethod("removeExtraParameter", &electron::crash_keys::ClearCrashKey);
 #endif
   dict.SetMethod("getParameters", &GetParameters);
@@ -4,6 +4,7 @@
 
 #include "shell/browser/api/electron_api_data_pipe_holder.h"
 
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -12,9 +13,12 @@
 #include "base/no_destructor.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/task/sequenced_task_runner.h"
+#include "mojo/public/cpp/bindings/callback_helpers.h"
 #include "mojo/public/cpp/system/data_pipe.h"
 #include "mojo/public/cpp/system/simple_watcher.h"
 #include "net/base/net_errors.h"
+#include "shell/common/data_pipe_stream.h"
+#include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/promise.h"
 #include "shell/common/key_weak_map.h"
 
@@ -27,6 +31,10 @@ namespace {
 // Incremental ID.
 int g_next_id = 0;
 
+// Matches the reads of the JS streams, so that one of them can drain a full
+// pipe.
+constexpr uint32_t kStreamPipeCapacity = 1024 * 1024;  // 1 MB
+
 // Map that manages all the DataPipeHolder objects.
 KeyWeakMap<std::string>& AllDataPipeHolders() {
   static base::NoDestructor<KeyWeakMap<std::string>> weak_map;
@@ -162,6 +170,43 @@ v8::Local<v8::Promise> DataPipeHolder::ReadAll(v8::Isolate* isolate) {
   return handle;
 }
 
+v8::Local<v8::Value> DataPipeHolder::ReadStream(
+    v8::Isolate* isolate,
+    base::OnceCallback<void(bool)> callback) {
+  const MojoCreateDataPipeOptions options{sizeof(MojoCreateDataPipeOptions),
+                                          MOJO_CREATE_DATA_PIPE_FLAG_NONE, 1,
+                                          kStreamPipeCapacity};
+  mojo::ScopedDataPipeProducerHandle producer;
+  mojo::ScopedDataPipeConsumerHandle consumer;
+  if (!data_pipe_ ||
+      mojo::CreateDataPipe(&options, producer, consumer) != MOJO_RESULT_OK) {
+    gin_helper::ErrorThrower(isolate).ThrowError("Could not get blob data");
+    return v8::Null(isolate);
+  }
+
+  // Reads from a clone of the getter, owned by the read itself, so that the
+  // stream keeps working if this holder is garbage collected first.
+  auto getter =
+      std::make_unique<mojo::Remote<network::mojom::DataPipeGetter>>();
+  data_pipe_->Clone(getter->BindNewPipeAndPassReceiver());
+  auto* raw_getter = getter.get();
+  (*raw_getter)
+      ->Read(std::move(producer),
+             mojo::WrapCallbackWithDefaultInvokeIfNotRun(
+                 base::BindOnce(
+                     [](mojo::Remote<network::mojom::DataPipeGetter>* getter,
+                        base::OnceCallback<void(bool)> callback,
+                        int32_t status, uint64_t size) {
+                       std::move(callback).Run(status == net::OK);
+                     },
+                     base::Owned(std::move(getter)), std::move(callback)),
+                 static_cast<int32_t>(net::ERR_FAILED), uint64_t{0}));
+
+  return DataPipeStream::Create(isolate, std::move(consumer),
+                                mojo::ScopedDataPipeProducerHandle())
+      .ToV8();
+}
+
 const char* DataPipeHolder::GetTypeName() {
   return "DataPipeHolder";
 }
@@ -7,6 +7,7 @@
 
 #include <string>
 
+#include "base/functional/callback_forward.h"
 #include "gin/handle.h"
 #include "gin/wrappable.h"
 #include "mojo/public/cpp/bindings/remote.h"
@@ -28,12 +29,16 @@ class DataPipeHolder : public gin::Wrappable<DataPipeHolder> {
   static gin::Handle<DataPipeHolder> From(v8::Isolate* isolate,
                                           const std::string& id);
 
-  // Read all data at once.
-  //
-  // TODO(zcbenz): This is apparently not suitable for really large data, but
-  // no one has complained about it yet.
+  // Read all data at once. ReadStream should be used for large data.
   v8::Local<v8::Promise> ReadAll(v8::Isolate* isolate);
 
+  // Returns a stream that the data is written to as it is read, held back
+  // while nothing reads from the stream. |callback| is called with whether
+  // all of the data was written. Unlike ReadAll, this leaves the holder
+  // usable, so the data can be streamed more than once.
+  v8::Local<v8::Value> ReadStream(v8::Isolate* isolate,
+                                  base::OnceCallback<void(bool)> callback);
+
   // The unique ID that can be used to receive the object.
   const std::string& id() const { return id_; }
 
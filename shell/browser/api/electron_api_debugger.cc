@@ -6,21 +6,42 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/json/json_reader.h"
 #include "base/json/json_writer.h"
+#include "base/strings/string_util.h"
 #include "content/public/browser/devtools_agent_host.h"
 #include "content/public/browser/web_contents.h"
 #include "gin/object_template_builder.h"
 #include "gin/per_isolate_data.h"
 #include "shell/browser/javascript_environment.h"
 #include "shell/common/gin_converters/value_converter.h"
+#include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/node_includes.h"
 
 using content::DevToolsAgentHost;
 
 namespace electron::api {
 
+namespace {
+
+// Returns the method of an event without parsing the whole message, when it
+// is the first key of the message as DevTools serializes it. Returns nullopt
+// for other messages, which need to be parsed.
+std::optional<std::string_view> PeekEventMethod(std::string_view message) {
+  constexpr std::string_view kPrefix = "{\"method\":\"";
+  if (!base::StartsWith(message, kPrefix))
+    return std::nullopt;
+  message.remove_prefix(kPrefix.size());
+  size_t end = message.find_first_of("\"\\");
+  if (end == std::string_view::npos || message[end] != '"')
+    return std::nullopt;
+  return message.substr(0, end);
+}
+
+}  // namespace
+
 gin::WrapperInfo Debugger::kWrapperInfo = {gin::kEmbedderNativeGin};
 
 Debugger::Debugger(v8::Isolate* isolate, content::WebContents* web_contents)
@@ -44,6 +65,16 @@ void Debugger::DispatchProtocolMessage(DevToolsAgentHost* agent_host,
 
   base::StringPiece message_str(reinterpret_cast<const char*>(message.data()),
                                 message.size());
+  // Filtered out and raw events don't need to be parsed.
+  if (std::optional<std::string_view> method = PeekEventMethod(message_str)) {
+    if (!IsEventEmitted(*method))
+      return;
+    if (raw_events_) {
+      Emit("raw-message", message_str);
+      return;
+    }
+  }
+
   std::optional<base::Value> parsed_message = base::JSONReader::Read(
       message_str, base::JSON_REPLACE_INVALID_CHARACTERS);
   if (!parsed_message || !parsed_message->is_dict())
@@ -52,8 +83,12 @@ void Debugger::DispatchProtocolMessage(DevToolsAgentHost* agent_host,
   std::optional<int> id = dict.FindInt("id");
   if (!id) {
     std::string* method = dict.FindString("method");
-    if (!method)
+    if (!method || !IsEventEmitted(*method))
+      return;
+    if (raw_events_) {
+      Emit("raw-message", message_str);
       return;
+    }
     std::string* session_id = dict.FindString("sessionId");
     base::Value::Dict* params = dict.FindDict("params");
     Emit("message", *method, params ? std::move(*params) : base::Value::Dict(),
@@ -166,6 +201,40 @@ v8::Local<v8::Promise> Debugger::SendCommand(gin::Arguments* args) {
   return handle;
 }
 
+void Debugger::SetMessageOptions(gin::Arguments* args) {
+  gin_helper::Dictionary options;
+  if (!args->GetNext(&options)) {
+    args->ThrowTypeError("Invalid options");
+    return;
+  }
+
+  bool raw = false;
+  options.Get("raw", &raw);
+  std::optional<std::vector<std::string>> event_filter;
+  v8::Local<v8::Value> value;
+  if (options.Get("eventFilter", &value) && !value->IsNullOrUndefined()) {
+    std::vector<std::string> filter;
+    if (!gin::ConvertFromV8(args->isolate(), value, &filter)) {
+      args->ThrowTypeError("eventFilter must be an array of strings");
+      return;
+    }
+    event_filter = std::move(filter);
+  }
+
+  raw_events_ = raw;
+  if (event_filter)
+    event_filter_.emplace(std::move(*event_filter));
+  else
+    event_filter_.reset();
+}
+
+bool Debugger::IsEventEmitted(std::string_view method) const {
+  if (!event_filter_)
+    return true;
+  std::string_view domain = method.substr(0, method.find('.'));
+  return event_filter_->contains(domain) || event_filter_->contains(method);
+}
+
 void Debugger::ClearPendingRequests() {
   for (auto& it : pending_requests_)
     it.second.RejectWithErrorMessage("target closed while handling command");
@@ -185,7 +254,8 @@ gin::ObjectTemplateBuilder Debugger::GetObjectTemplateBuilder(
       .SetMethod("attach", &Debugger::Attach)
       .SetMethod("isAttached", &Debugger::IsAttached)
       .SetMethod("detach", &Debugger::Detach)
-      .SetMethod("sendCommand", &Debugger::SendCommand);
+      .SetMethod("sendCommand", &Debugger::SendCommand)
+      .SetMethod("setMessageOptions", &Debugger::SetMessageOptions);
 }
 
 const char* Debugger::GetTypeName() {
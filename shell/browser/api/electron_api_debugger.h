@@ -6,7 +6,11 @@
 #define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_DEBUGGER_H_
 
 #include <map>
+#include <optional>
+#include <string>
+#include <string_view>
 
+#include "base/containers/flat_set.h"
 #include "base/functional/callback.h"
 #include "base/memory/raw_ptr.h"
 #include "base/values.h"
@@ -64,13 +68,23 @@ class Debugger : public gin::Wrappable<Debugger>,
   bool IsAttached();
   void Detach();
   v8::Local<v8::Promise> SendCommand(gin::Arguments* args);
+  void SetMessageOptions(gin::Arguments* args);
   void ClearPendingRequests();
 
+  // Whether events of |method| pass the filter set by SetMessageOptions.
+  bool IsEventEmitted(std::string_view method) const;
+
   raw_ptr<content::WebContents> web_contents_;  // Weak Reference.
   scoped_refptr<content::DevToolsAgentHost> agent_host_;
 
   PendingRequestMap pending_requests_;
   int previous_request_id_ = 0;
+
+  // Set by SetMessageOptions. Raw events are emitted as their JSON text, and
+  // when there is a filter, only the events of the domains and methods in it
+  // are emitted.
+  bool raw_events_ = false;
+  std::optional<base::flat_set<std::string, std::less<>>> event_filter_;
 };
 
 }  // namespace electron::api
@@ -11,6 +11,7 @@
 #include "base/containers/flat_map.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/sequenced_task_runner.h"
 #include "base/threading/thread_restrictions.h"
 #include "chrome/browser/media/webrtc/desktop_capturer_wrapper.h"
 #include "chrome/browser/media/webrtc/desktop_media_list.h"
@@ -241,11 +242,51 @@ void DesktopCapturer::DesktopListListener::OnDelegatedSourceListDismissed() {
   std::move(failure_callback_).Run();
 }
 
-void DesktopCapturer::StartHandling(bool capture_window,
-                                    bool capture_screen,
-                                    const gfx::Size& thumbnail_size,
-                                    bool fetch_window_icons) {
-  fetch_window_icons_ = fetch_window_icons;
+DesktopCapturer::SourceListWatcher::SourceListWatcher(
+    base::WeakPtr<DesktopCapturer> capturer,
+    DesktopMediaList* list)
+    : capturer_(std::move(capturer)), list_(list) {}
+
+DesktopCapturer::SourceListWatcher::~SourceListWatcher() = default;
+
+void DesktopCapturer::SourceListWatcher::OnSourceAdded(int index) {
+  source_ids_.insert(source_ids_.begin() + index, list_->GetSource(index).id);
+  if (!capturer_)
+    return;
+  // Icons are only fetched once per source, as they rarely change.
+  capturer_->EmitWatchedSource("_onsourceadded", list_, index,
+                               /* fetch_icon = */ true);
+}
+
+void DesktopCapturer::SourceListWatcher::OnSourceRemoved(int index) {
+  const std::string id = source_ids_[index].ToString();
+  source_ids_.erase(source_ids_.begin() + index);
+  if (capturer_)
+    capturer_->EmitWatchedSourceRemoved(id);
+}
+
+void DesktopCapturer::SourceListWatcher::OnSourceMoved(int old_index,
+                                                       int new_index) {
+  content::DesktopMediaID id = source_ids_[old_index];
+  source_ids_.erase(source_ids_.begin() + old_index);
+  source_ids_.insert(source_ids_.begin() + new_index, id);
+}
+
+void DesktopCapturer::SourceListWatcher::OnSourceNameChanged(int index) {
+  if (capturer_)
+    capturer_->EmitWatchedSource("_onsourcenamechanged", list_, index,
+                                 /* fetch_icon = */ false);
+}
+
+void DesktopCapturer::SourceListWatcher::OnSourceThumbnailChanged(int index) {
+  // The list only notifies about thumbnails whose content has changed since
+  // the last refresh.
+  if (capturer_)
+    capturer_->EmitWatchedSource("_onthumbnailchanged", list_, index,
+                                 /* fetch_icon = */ false);
+}
+
+void DesktopCapturer::DetectDirectXCapturer() {
 #if BUILDFLAG(IS_WIN)
   if (content::desktop_capture::CreateDesktopCaptureOptions()
           .allow_directx_capturer()) {
@@ -255,6 +296,14 @@ void DesktopCapturer::StartHandling(bool capture_window,
     using_directx_capturer_ = webrtc::ScreenCapturerWinDirectx::IsSupported();
   }
 #endif  // BUILDFLAG(IS_WIN)
+}
+
+void DesktopCapturer::StartHandling(bool capture_window,
+                                    bool capture_screen,
+                                    const gfx::Size& thumbnail_size,
+                                    bool fetch_window_icons) {
+  fetch_window_icons_ = fetch_window_icons;
+  DetectDirectXCapturer();
 
   // clear any existing captured sources.
   captured_sources_.clear();
@@ -359,6 +408,112 @@ void DesktopCapturer::StartHandling(bool capture_window,
   }
 }
 
+void DesktopCapturer::StartWatching(bool capture_window,
+                                    bool capture_screen,
+                                    const gfx::Size& thumbnail_size,
+                                    bool fetch_window_icons,
+                                    double update_interval) {
+  fetch_window_icons_ = fetch_window_icons;
+  is_watching_ = true;
+  DetectDirectXCapturer();
+
+  const base::TimeDelta update_period = base::Milliseconds(update_interval);
+  if (capture_window) {
+    window_capturer_ =
+        CreateWatchedList(DesktopMediaList::Type::kWindow, thumbnail_size,
+                          update_period, &window_watcher_);
+  }
+  if (capture_screen) {
+    screen_capturer_ =
+        CreateWatchedList(DesktopMediaList::Type::kScreen, thumbnail_size,
+                          update_period, &screen_watcher_);
+  }
+  if ((capture_window && !window_capturer_) ||
+      (capture_screen && !screen_capturer_)) {
+    // Stop the list that could be watched, if any, so it emits nothing after
+    // the error.
+    StopWatching();
+    HandleFailure();
+  }
+}
+
+void DesktopCapturer::StopWatching() {
+  // A watcher that is stopped before it got to start still has to let go of
+  // the capturer, which is pinned from its creation.
+  if (is_watching_) {
+    is_watching_ = false;
+
+    // This can be called from the listeners of a list that is notifying its
+    // watcher, so both are deleted once the notification is over. The lists
+    // notify their watchers, so they go first.
+    auto task_runner = base::SequencedTaskRunner::GetCurrentDefault();
+    task_runner->DeleteSoon(FROM_HERE, std::move(window_capturer_));
+    task_runner->DeleteSoon(FROM_HERE, std::move(screen_capturer_));
+    task_runner->DeleteSoon(FROM_HERE, std::move(window_watcher_));
+    task_runner->DeleteSoon(FROM_HERE, std::move(screen_watcher_));
+  }
+  Unpin();
+}
+
+std::unique_ptr<DesktopMediaList> DesktopCapturer::CreateWatchedList(
+    DesktopMediaList::Type type,
+    const gfx::Size& thumbnail_size,
+    base::TimeDelta update_period,
+    std::unique_ptr<SourceListWatcher>* watcher) {
+  auto capturer = type == DesktopMediaList::Type::kWindow
+                      ? MakeWindowCapturer()
+                      : MakeScreenCapturer();
+  if (!capturer)
+    return nullptr;
+
+  auto list =
+      std::make_unique<NativeDesktopMediaList>(type, std::move(capturer));
+  // Lists delegated to the system, like PipeWire's, pick a single source
+  // through a system dialog, so there is nothing to watch.
+  if (list->IsSourceListDelegated())
+    return nullptr;
+
+  list->SetThumbnailSize(thumbnail_size);
+  list->SetUpdatePeriod(update_period);
+  *watcher = std::make_unique<SourceListWatcher>(
+      weak_ptr_factory_.GetWeakPtr(), list.get());
+  list->StartUpdating(watcher->get());
+  return list;
+}
+
+void DesktopCapturer::EmitWatchedSource(const char* method,
+                                        DesktopMediaList* list,
+                                        int index,
+                                        bool fetch_icon) {
+  if (!is_watching_)
+    return;
+
+  std::optional<Source> source;
+  if (list->GetMediaListType() == DesktopMediaList::Type::kScreen) {
+    std::optional<std::vector<Source>> screen_sources = GetScreenSources(list);
+    if (screen_sources)
+      source = std::move((*screen_sources)[index]);
+  } else {
+    source.emplace(list->GetSource(index), std::string(),
+                   fetch_icon && fetch_window_icons_);
+  }
+  if (!source)
+    return;
+
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope scope(isolate);
+  gin_helper::CallMethod(this, method, *source);
+}
+
+void DesktopCapturer::EmitWatchedSourceRemoved(const std::string& id) {
+  if (!is_watching_)
+    return;
+
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope scope(isolate);
+  gin_helper::CallMethod(this, "_onsourceremoved", id);
+}
+
 void DesktopCapturer::UpdateSourcesList(DesktopMediaList* list) {
   if (capture_window_ &&
       list->GetMediaListType() == DesktopMediaList::Type::kWindow) {
@@ -376,57 +531,13 @@ void DesktopCapturer::UpdateSourcesList(DesktopMediaList* list) {
   if (capture_screen_ &&
       list->GetMediaListType() == DesktopMediaList::Type::kScreen) {
     capture_screen_ = false;
-    std::vector<DesktopCapturer::Source> screen_sources;
-    screen_sources.reserve(list->GetSourceCount());
-    for (int i = 0; i < list->GetSourceCount(); i++) {
-      screen_sources.emplace_back(list->GetSource(i), std::string());
-    }
-#if BUILDFLAG(IS_WIN)
-    // Gather the same unique screen IDs used by the electron.screen API in
-    // order to provide an association between it and
-    // desktopCapturer/getUserMedia. This is only required when using the
-    // DirectX capturer, otherwise the IDs across the APIs already match.
-    if (using_directx_capturer_) {
-      std::vector<std::string> device_names;
-      // Crucially, this list of device names will be in the same order as
-      // |media_list_sources|.
-      if (!webrtc::DxgiDuplicatorController::Instance()->GetDeviceNames(
-              &device_names)) {
-        HandleFailure();
-        return;
-      }
-
-      int device_name_index = 0;
-      for (auto& source : screen_sources) {
-        const auto& device_name = device_names[device_name_index++];
-        std::wstring wide_device_name;
-        base::UTF8ToWide(device_name.c_str(), device_name.size(),
-                         &wide_device_name);
-        const int64_t device_id =
-            display::win::internal::DisplayInfo::DeviceIdFromDeviceName(
-                wide_device_name.c_str());
-        source.display_id = base::NumberToString(device_id);
-      }
-    }
-#elif BUILDFLAG(IS_MAC)
-    // On Mac, the IDs across the APIs match.
-    for (auto& source : screen_sources) {
-      source.display_id = base::NumberToString(source.media_list_source.id.id);
-    }
-#elif BUILDFLAG(IS_OZONE_X11)
-    // On Linux, with X11, the source id is the numeric value of the
-    // display name atom and the display id is either the EDID or the
-    // loop index when that display was found (see
-    // BuildDisplaysFromXRandRInfo in ui/base/x/x11_display_util.cc)
-    const auto monitor_atom_to_display_id = MonitorAtomIdToDisplayId();
-    for (auto& source : screen_sources) {
-      auto display_id_iter =
-          monitor_atom_to_display_id.find(source.media_list_source.id.id);
-      if (display_id_iter != monitor_atom_to_display_id.end())
-        source.display_id = base::NumberToString(display_id_iter->second);
+    std::optional<std::vector<DesktopCapturer::Source>> screen_sources =
+        GetScreenSources(list);
+    if (!screen_sources) {
+      HandleFailure();
+      return;
     }
-#endif
-    std::move(screen_sources.begin(), screen_sources.end(),
+    std::move(screen_sources->begin(), screen_sources->end(),
               std::back_inserter(captured_sources_));
   }
 
@@ -442,6 +553,60 @@ void DesktopCapturer::UpdateSourcesList(DesktopMediaList* list) {
   }
 }
 
+std::optional<std::vector<DesktopCapturer::Source>>
+DesktopCapturer::GetScreenSources(DesktopMediaList* list) {
+  std::vector<DesktopCapturer::Source> screen_sources;
+  screen_sources.reserve(list->GetSourceCount());
+  for (int i = 0; i < list->GetSourceCount(); i++) {
+    screen_sources.emplace_back(list->GetSource(i), std::string());
+  }
+#if BUILDFLAG(IS_WIN)
+  // Gather the same unique screen IDs used by the electron.screen API in
+  // order to provide an association between it and
+  // desktopCapturer/getUserMedia. This is only required when using the
+  // DirectX capturer, otherwise the IDs across the APIs already match.
+  if (using_directx_capturer_) {
+    std::vector<std::string> device_names;
+    // Crucially, this list of device names will be in the same order as
+    // |media_list_sources|.
+    if (!webrtc::DxgiDuplicatorController::Instance()->GetDeviceNames(
+            &device_names)) {
+      return std::nullopt;
+    }
+
+    int device_name_index = 0;
+    for (auto& source : screen_sources) {
+      const auto& device_name = device_names[device_name_index++];
+      std::wstring wide_device_name;
+      base::UTF8ToWide(device_name.c_str(), device_name.size(),
+                       &wide_device_name);
+      const int64_t device_id =
+          display::win::internal::DisplayInfo::DeviceIdFromDeviceName(
+              wide_device_name.c_str());
+      source.display_id = base::NumberToString(device_id);
+    }
+  }
+#elif BUILDFLAG(IS_MAC)
+  // On Mac, the IDs across the APIs match.
+  for (auto& source : screen_sources) {
+    source.display_id = base::NumberToString(source.media_list_source.id.id);
+  }
+#elif BUILDFLAG(IS_OZONE_X11)
+  // On Linux, with X11, the source id is the numeric value of the
+  // display name atom and the display id is either the EDID or the
+  // loop index when that display was found (see
+  // BuildDisplaysFromXRandRInfo in ui/base/x/x11_display_util.cc)
+  const auto monitor_atom_to_display_id = MonitorAtomIdToDisplayId();
+  for (auto& source : screen_sources) {
+    auto display_id_iter =
+        monitor_atom_to_display_id.find(source.media_list_source.id.id);
+    if (display_id_iter != monitor_atom_to_display_id.end())
+      source.display_id = base::NumberToString(display_id_iter->second);
+  }
+#endif
+  return screen_sources;
+}
+
 void DesktopCapturer::HandleFailure() {
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope scope(isolate);
@@ -466,7 +631,9 @@ gin::Handle<DesktopCapturer> DesktopCapturer::Create(v8::Isolate* isolate) {
 gin::ObjectTemplateBuilder DesktopCapturer::GetObjectTemplateBuilder(
     v8::Isolate* isolate) {
   return gin::Wrappable<DesktopCapturer>::GetObjectTemplateBuilder(isolate)
-      .SetMethod("startHandling", &DesktopCapturer::StartHandling);
+      .SetMethod("startHandling", &DesktopCapturer::StartHandling)
+      .SetMethod("startWatching", &DesktopCapturer::StartWatching)
+      .SetMethod("stopWatching", &DesktopCapturer::StopWatching);
 }
 
 const char* DesktopCapturer::GetTypeName() {
@@ -6,9 +6,11 @@
 #define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_DESKTOP_CAPTURER_H_
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
+#include "base/memory/raw_ptr.h"
 #include "chrome/browser/media/webrtc/desktop_media_list_observer.h"
 #include "chrome/browser/media/webrtc/native_desktop_media_list.h"
 #include "gin/handle.h"
@@ -37,6 +39,15 @@ class DesktopCapturer : public gin::Wrappable<DesktopCapturer>,
                      const gfx::Size& thumbnail_size,
                      bool fetch_window_icons);
 
+  // Unlike StartHandling, keeps the capturers running and reports the changes
+  // of the sources as they happen, until StopWatching is called.
+  void StartWatching(bool capture_window,
+                     bool capture_screen,
+                     const gfx::Size& thumbnail_size,
+                     bool fetch_window_icons,
+                     double update_interval);
+  void StopWatching();
+
   // gin::Wrappable
   static gin::WrapperInfo kWrapperInfo;
   gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
@@ -88,17 +99,58 @@ class DesktopCapturer : public gin::Wrappable<DesktopCapturer>,
     bool have_thumbnail_ = false;
   };
 
+  // Keeps the IDs of the sources of a watched list, as sources that have
+  // been removed can't be looked up from the list anymore.
+  class SourceListWatcher : public DesktopMediaListObserver {
+   public:
+    SourceListWatcher(base::WeakPtr<DesktopCapturer> capturer,
+                      DesktopMediaList* list);
+    ~SourceListWatcher() override;
+
+   protected:
+    void OnSourceAdded(int index) override;
+    void OnSourceRemoved(int index) override;
+    void OnSourceMoved(int old_index, int new_index) override;
+    void OnSourceNameChanged(int index) override;
+    void OnSourceThumbnailChanged(int index) override;
+    void OnSourcePreviewChanged(size_t index) override {}
+    void OnDelegatedSourceListSelection() override {}
+    void OnDelegatedSourceListDismissed() override {}
+
+   private:
+    base::WeakPtr<DesktopCapturer> capturer_;
+    raw_ptr<DesktopMediaList> list_;
+    std::vector<content::DesktopMediaID> source_ids_;
+  };
+
+  void DetectDirectXCapturer();
+  std::unique_ptr<DesktopMediaList> CreateWatchedList(
+      DesktopMediaList::Type type,
+      const gfx::Size& thumbnail_size,
+      base::TimeDelta update_period,
+      std::unique_ptr<SourceListWatcher>* watcher);
   void UpdateSourcesList(DesktopMediaList* list);
+  // Returns the sources of a screen list with their display_id, or nullopt
+  // if the display ids couldn't be found.
+  std::optional<std::vector<Source>> GetScreenSources(DesktopMediaList* list);
+  void EmitWatchedSource(const char* method,
+                         DesktopMediaList* list,
+                         int index,
+                         bool fetch_icon);
+  void EmitWatchedSourceRemoved(const std::string& id);
   void HandleFailure();
 
   std::unique_ptr<DesktopListListener> window_listener_;
   std::unique_ptr<DesktopListListener> screen_listener_;
   std::unique_ptr<DesktopMediaList> window_capturer_;
   std::unique_ptr<DesktopMediaList> screen_capturer_;
+  std::unique_ptr<SourceListWatcher> window_watcher_;
+  std::unique_ptr<SourceListWatcher> screen_watcher_;
   std::vector<DesktopCapturer::Source> captured_sources_;
   bool capture_window_ = false;
   bool capture_screen_ = false;
   bool fetch_window_icons_ = false;
+  bool is_watching_ = false;
 #if BUILDFLAG(IS_WIN)
   bool using_directx_capturer_ = false;
 #endif  // BUILDFLAG(IS_WIN)
@@ -2,9 +2,16 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include <optional>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "base/dcheck_is_on.h"
+#include "base/run_loop.h"
+#include "base/task/single_thread_task_runner.h"
+#include "base/time/time.h"
+#include "shell/browser/long_task_detector.h"
 #include "shell/browser/ui/certificate_trust.h"
 #include "shell/browser/ui/file_dialog.h"
 #include "shell/browser/ui/message_box.h"
@@ -20,7 +27,30 @@
 
 namespace {
 
+#if DCHECK_IS_ON()
+// Answers the next synchronous message box in place of the user, with the
+// response and after the delay, which is spent in a nested run loop like the
+// one of a real dialog.
+std::optional<std::pair<int, base::TimeDelta>> g_message_box_for_testing;
+
+void SetMessageBoxSyncResponseForTesting(int response, double delay_ms) {
+  g_message_box_for_testing.emplace(response, base::Milliseconds(delay_ms));
+}
+#endif
+
 int ShowMessageBoxSync(const electron::MessageBoxSettings& settings) {
+  electron::LongTaskDetector::MarkBlockingCall("dialog.showMessageBoxSync");
+#if DCHECK_IS_ON()
+  if (g_message_box_for_testing) {
+    auto [response, delay] = *g_message_box_for_testing;
+    g_message_box_for_testing.reset();
+    base::RunLoop run_loop(base::RunLoop::Type::kNestableTasksAllowed);
+    base::SingleThreadTaskRunner::GetCurrentDefault()->PostDelayedTask(
+        FROM_HERE, run_loop.QuitClosure(), delay);
+    run_loop.Run();
+    return response;
+  }
+#endif
   return electron::ShowMessageBoxSync(settings);
 }
 
@@ -52,6 +82,7 @@ v8::Local<v8::Promise> ShowMessageBox(
 
 void ShowOpenDialogSync(const file_dialog::DialogSettings& settings,
                         gin::Arguments* args) {
+  electron::LongTaskDetector::MarkBlockingCall("dialog.showOpenDialogSync");
   std::vector<base::FilePath> paths;
   if (file_dialog::ShowOpenDialogSync(settings, &paths))
     args->Return(paths);
@@ -68,11 +99,17 @@ v8::Local<v8::Promise> ShowOpenDialog(
 
 void ShowSaveDialogSync(const file_dialog::DialogSettings& settings,
                         gin::Arguments* args) {
+  electron::LongTaskDetector::MarkBlockingCall("dialog.showSaveDialogSync");
   base::FilePath path;
   if (file_dialog::ShowSaveDialogSync(settings, &path))
     args->Return(path);
 }
 
+void ShowErrorBox(const std::u16string& title, const std::u16string& content) {
+  electron::LongTaskDetector::MarkBlockingCall("dialog.showErrorBox");
+  electron::ShowErrorBox(title, content);
+}
+
 v8::Local<v8::Promise> ShowSaveDialog(
     const file_dialog::DialogSettings& settings,
     gin::Arguments* args) {
@@ -90,9 +127,13 @@ void Initialize(v8::Local<v8::Object> exports,
   v8::Isolate* isolate = context->GetIsolate();
   gin_helper::Dictionary dict(isolate, exports);
   dict.SetMethod("showMessageBoxSync", &ShowMessageBoxSync);
+#if DCHECK_IS_ON()
+  dict.SetMethod("_setMessageBoxSyncResponseForTesting",
+                 &SetMessageBoxSyncResponseForTesting);
+#endif
   dict.SetMethod("showMessageBox", &ShowMessageBox);
   dict.SetMethod("_closeMessageBox", &electron::CloseMessageBox);
-  dict.SetMethod("showErrorBox", &electron::ShowErrorBox);
+  dict.SetMethod("showErrorBox", &ShowErrorBox);
   dict.SetMethod("showOpenDialogSync", &ShowOpenDialogSync);
   dict.SetMethod("showOpenDialog", &ShowOpenDialog);
   dict.SetMethod("showSaveDialogSync", &ShowSaveDialogSync);
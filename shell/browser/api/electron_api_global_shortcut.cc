@@ -33,8 +33,10 @@ bool RegisteringMediaKeyForUntrustedClient(const ui::Accelerator& accelerator) {
          !electron::api::SystemPreferences::IsTrustedAccessibilityClient(false);
 }
 
-bool MapHasMediaKeys(
-    const std::map<ui::Accelerator, base::RepeatingClosure>& accelerator_map) {
+bool MapHasMediaKeys(const std::unordered_map<ui::Accelerator,
+                                              base::RepeatingClosure,
+                                              accelerator_util::AcceleratorHash>&
+                         accelerator_map) {
   auto media_key = std::find_if(
       accelerator_map.begin(), accelerator_map.end(),
       [](const auto& ac) { return Command::IsMediaKey(ac.first); });
@@ -56,13 +58,14 @@ GlobalShortcut::~GlobalShortcut() {
 }
 
 void GlobalShortcut::OnKeyPressed(const ui::Accelerator& accelerator) {
-  if (!base::Contains(accelerator_callback_map_, accelerator)) {
+  auto iter = accelerator_callback_map_.find(accelerator);
+  if (iter == accelerator_callback_map_.end()) {
     // This should never occur, because if it does, GlobalShortcutListener
     // notifies us with wrong accelerator.
     NOTREACHED();
     return;
   }
-  accelerator_callback_map_[accelerator].Run();
+  iter->second.Run();
 }
 
 bool GlobalShortcut::RegisterAll(
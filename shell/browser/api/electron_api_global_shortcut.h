@@ -5,13 +5,14 @@
 #ifndef ELECTRON_SHELL_BROWSER_API_ELECTRON_API_GLOBAL_SHORTCUT_H_
 #define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_GLOBAL_SHORTCUT_H_
 
-#include <map>
+#include <unordered_map>
 #include <vector>
 
 #include "base/functional/callback.h"
 #include "chrome/browser/extensions/global_shortcut_listener.h"
 #include "gin/handle.h"
 #include "gin/wrappable.h"
+#include "shell/browser/ui/accelerator_util.h"
 #include "ui/base/accelerators/accelerator.h"
 
 namespace electron::api {
@@ -36,7 +37,9 @@ class GlobalShortcut : public extensions::GlobalShortcutListener::Observer,
   ~GlobalShortcut() override;
 
  private:
-  typedef std::map<ui::Accelerator, base::RepeatingClosure>
+  typedef std::unordered_map<ui::Accelerator,
+                             base::RepeatingClosure,
+                             accelerator_util::AcceleratorHash>
       AcceleratorCallbackMap;
 
   bool RegisterAll(const std::vector<ui::Accelerator>& accelerators,
@@ -142,6 +142,12 @@ void Menu::OnMenuWillShow(ui::SimpleMenuModel* source) {
   gin_helper::CallMethod(isolate, const_cast<Menu*>(this), "_menuWillShow");
 }
 
+void Menu::PopulateMenu() {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope scope(isolate);
+  gin_helper::CallMethod(isolate, const_cast<Menu*>(this), "_populate");
+}
+
 base::OnceClosure Menu::BindSelfToClosure(base::OnceClosure callback) {
   // return ((callback, ref) => { callback() }).bind(null, callback, this)
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
@@ -194,6 +200,18 @@ void Menu::SetIcon(int index, const gfx::Image& image) {
   model_->SetIcon(index, ui::ImageModel::FromImage(image));
 }
 
+void Menu::SetLabel(int index, const std::u16string& label) {
+  model_->SetLabelAt(index, label);
+}
+
+void Menu::MarkItemChangedAt(int index) {
+  model_->MarkItemChangedAt(index);
+}
+
+void Menu::SetNeedsPopulate(bool needs_populate) {
+  model_->set_needs_populate(needs_populate);
+}
+
 void Menu::SetSublabel(int index, const std::u16string& sublabel) {
   model_->SetSecondaryLabel(index, sublabel);
 }
@@ -276,6 +294,9 @@ void Menu::FillObjectTemplate(v8::Isolate* isolate,
       .SetMethod("insertSeparator", &Menu::InsertSeparatorAt)
       .SetMethod("insertSubMenu", &Menu::InsertSubMenuAt)
       .SetMethod("setIcon", &Menu::SetIcon)
+      .SetMethod("setLabel", &Menu::SetLabel)
+      .SetMethod("_markItemChanged", &Menu::MarkItemChangedAt)
+      .SetMethod("_setNeedsPopulate", &Menu::SetNeedsPopulate)
       .SetMethod("setSublabel", &Menu::SetSublabel)
       .SetMethod("setToolTip", &Menu::SetToolTip)
       .SetMethod("setRole", &Menu::SetRole)
@@ -75,6 +75,7 @@ class Menu : public gin::Wrappable<Menu>,
 #endif
   void ExecuteCommand(int command_id, int event_flags) override;
   void OnMenuWillShow(ui::SimpleMenuModel* source) override;
+  void PopulateMenu() override;
 
   virtual void PopupAt(BaseWindow* window,
                        int x,
@@ -107,6 +108,9 @@ class Menu : public gin::Wrappable<Menu>,
                        const std::u16string& label,
                        Menu* menu);
   void SetIcon(int index, const gfx::Image& image);
+  void SetLabel(int index, const std::u16string& label);
+  void MarkItemChangedAt(int index);
+  void SetNeedsPopulate(bool needs_populate);
   void SetSublabel(int index, const std::u16string& sublabel);
   void SetToolTip(int index, const std::u16string& toolTip);
   void SetRole(int index, const std::u16string& role);
@@ -39,6 +39,10 @@ void MenuViews::PopupAt(BaseWindow* window,
 
   int flags = MenuRunner::CONTEXT_MENU | MenuRunner::HAS_MNEMONICS;
 
+  // The whole menu is built before it is shown, so submenus whose items are
+  // added on demand have to get them now.
+  model()->PopulateAllIfNeeded();
+
   // Make sure the Menu object would not be garbage-collected until the callback
   // has run.
   base::OnceClosure callback_with_ref = BindSelfToClosure(std::move(callback));
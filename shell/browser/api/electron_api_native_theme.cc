@@ -32,6 +32,9 @@ NativeTheme::~NativeTheme() {
 }
 
 void NativeTheme::OnNativeThemeUpdatedOnUI() {
+#if BUILDFLAG(IS_MAC)
+  inverted_color_scheme_.reset();
+#endif
   Emit("updated");
 }
 
@@ -76,13 +79,14 @@ const CFStringRef UniversalAccessDomain = CFSTR("com.apple.universalaccess");
 // TODO(MarshallOfSound): Implement for Linux
 bool NativeTheme::ShouldUseInvertedColorScheme() {
 #if BUILDFLAG(IS_MAC)
-  CFPreferencesAppSynchronize(UniversalAccessDomain);
-  Boolean keyExistsAndHasValidFormat = false;
-  Boolean is_inverted = CFPreferencesGetAppBooleanValue(
-      WhiteOnBlack, UniversalAccessDomain, &keyExistsAndHasValidFormat);
-  if (!keyExistsAndHasValidFormat)
-    return false;
-  return is_inverted;
+  if (!inverted_color_scheme_) {
+    CFPreferencesAppSynchronize(UniversalAccessDomain);
+    Boolean keyExistsAndHasValidFormat = false;
+    Boolean is_inverted = CFPreferencesGetAppBooleanValue(
+        WhiteOnBlack, UniversalAccessDomain, &keyExistsAndHasValidFormat);
+    inverted_color_scheme_ = keyExistsAndHasValidFormat && is_inverted;
+  }
+  return *inverted_color_scheme_;
 #else
   return ui_theme_->GetPlatformHighContrastColorScheme() ==
          ui::NativeTheme::PlatformHighContrastColorScheme::kDark;
@@ -5,6 +5,8 @@
 #ifndef ELECTRON_SHELL_BROWSER_API_ELECTRON_API_NATIVE_THEME_H_
 #define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_NATIVE_THEME_H_
 
+#include <optional>
+
 #include "base/memory/raw_ptr.h"
 #include "gin/handle.h"
 #include "gin/wrappable.h"
@@ -54,6 +56,12 @@ class NativeTheme : public gin::Wrappable<NativeTheme>,
  private:
   raw_ptr<ui::NativeTheme> ui_theme_;
   raw_ptr<ui::NativeTheme> web_theme_;
+
+#if BUILDFLAG(IS_MAC)
+  // Reading the preference synchronizes the preferences with the system, so
+  // it is read once until the theme reports an update.
+  std::optional<bool> inverted_color_scheme_;
+#endif
 };
 
 }  // namespace electron::api
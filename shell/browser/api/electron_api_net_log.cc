@@ -4,12 +4,17 @@
 
 #include "shell/browser/api/electron_api_net_log.h"
 
+#include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/command_line.h"
 #include "base/files/file_path.h"
+#include "base/files/file_util.h"
 #include "base/functional/bind.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
 #include "base/task/thread_pool.h"
 #include "chrome/browser/browser_process.h"
 #include "components/net_log/chrome_net_log.h"
@@ -67,6 +72,69 @@ base::File OpenFileForWriting(base::FilePath path) {
                     base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
 }
 
+// 10 MB, like the default of the net-export page of Chrome.
+constexpr uint64_t kDefaultRingBufferSize = 10 * 1024 * 1024;
+
+std::pair<base::FilePath, base::File> CreateRingBufferFile() {
+  base::FilePath path;
+  if (!base::CreateTemporaryFile(&path))
+    return {path, base::File(base::File::FILE_ERROR_FAILED)};
+  return {path, OpenFileForWriting(path)};
+}
+
+std::optional<std::string> WriteFilteredDump(
+    const base::FilePath& log_path,
+    const base::FilePath& dump_path,
+    const std::vector<std::string>& source_types) {
+  std::string contents;
+  if (!base::ReadFileToString(log_path, &contents))
+    return "Failed to read the net log";
+  std::optional<base::Value> log = base::JSONReader::Read(contents);
+  if (!log || !log->is_dict())
+    return "Failed to parse the net log";
+
+  // The log maps the names of the source types to the ids its events use.
+  std::set<int> type_ids;
+  const base::Value::Dict* type_constants =
+      log->GetDict().FindDictByDottedPath("constants.logSourceType");
+  for (const auto& source_type : source_types) {
+    std::optional<int> id =
+        type_constants ? type_constants->FindInt(source_type) : std::nullopt;
+    if (id)
+      type_ids.insert(*id);
+  }
+  if (base::Value::List* events = log->GetDict().FindList("events")) {
+    events->EraseIf([&type_ids](const base::Value& event) {
+      std::optional<int> id =
+          event.is_dict() ? event.GetDict().FindIntByDottedPath("source.type")
+                          : std::nullopt;
+      return !id || !type_ids.contains(*id);
+    });
+  }
+
+  std::string json;
+  if (!base::JSONWriter::Write(*log, &json) ||
+      !base::WriteFile(dump_path, json))
+    return "Failed to write the net log dump";
+  return std::nullopt;
+}
+
+// Writes the log at |log_path| to |dump_path|, with only the events of
+// |source_types| if there are any, and deletes it.
+std::optional<std::string> WriteDump(base::FilePath log_path,
+                                     base::FilePath dump_path,
+                                     std::vector<std::string> source_types) {
+  std::optional<std::string> error;
+  if (source_types.empty()) {
+    if (!base::CopyFile(log_path, dump_path))
+      error = "Failed to write the net log dump";
+  } else {
+    error = WriteFilteredDump(log_path, dump_path, source_types);
+  }
+  base::DeleteFile(log_path);
+  return error;
+}
+
 void ResolvePromiseWithNetError(gin_helper::Promise<void> promise,
                                 int32_t error) {
   if (error == net::OK) {
@@ -87,7 +155,12 @@ NetLog::NetLog(v8::Isolate* isolate, ElectronBrowserContext* browser_context)
   file_task_runner_ = CreateFileTaskRunner();
 }
 
-NetLog::~NetLog() = default;
+NetLog::~NetLog() {
+  if (!ring_buffer_path_.empty()) {
+    file_task_runner_->PostTask(
+        FROM_HERE, base::GetDeleteFileCallback(std::move(ring_buffer_path_)));
+  }
+}
 
 v8::Local<v8::Promise> NetLog::StartLogging(base::FilePath log_path,
                                             gin::Arguments* args) {
@@ -119,7 +192,7 @@ v8::Local<v8::Promise> NetLog::StartLogging(base::FilePath log_path,
     }
   }
 
-  if (net_log_exporter_) {
+  if (net_log_exporter_ || ring_buffer_) {
     args->ThrowTypeError("There is already a net log running");
     return v8::Local<v8::Promise>();
   }
@@ -161,12 +234,15 @@ void NetLog::StartNetLogAfterCreateFile(net::NetLogCaptureMode capture_mode,
     // been resolved.
     return;
   }
-  DCHECK(pending_start_promise_);
   if (!output_file.IsValid()) {
-    std::move(*pending_start_promise_)
-        .RejectWithErrorMessage(
-            base::File::ErrorToString(output_file.error_details()));
+    if (pending_start_promise_) {
+      std::move(*pending_start_promise_)
+          .RejectWithErrorMessage(
+              base::File::ErrorToString(output_file.error_details()));
+      pending_start_promise_.reset();
+    }
     net_log_exporter_.reset();
+    ring_buffer_.reset();
     return;
   }
   net_log_exporter_->Start(
@@ -176,26 +252,50 @@ void NetLog::StartNetLogAfterCreateFile(net::NetLogCaptureMode capture_mode,
 }
 
 void NetLog::NetLogStarted(int32_t error) {
-  DCHECK(pending_start_promise_);
-  ResolvePromiseWithNetError(std::move(*pending_start_promise_), error);
+  // The ring buffer is restarted without a promise after each dump.
+  if (pending_start_promise_) {
+    ResolvePromiseWithNetError(std::move(*pending_start_promise_), error);
+    pending_start_promise_.reset();
+  }
+  if (error != net::OK && ring_buffer_) {
+    net_log_exporter_.reset();
+    ring_buffer_.reset();
+  }
 }
 
 void NetLog::OnConnectionError() {
   net_log_exporter_.reset();
+  ring_buffer_.reset();
   if (pending_start_promise_) {
     std::move(*pending_start_promise_)
         .RejectWithErrorMessage("Failed to start net log exporter");
+    pending_start_promise_.reset();
   }
 }
 
 bool NetLog::IsCurrentlyLogging() const {
-  return !!net_log_exporter_;
+  return net_log_exporter_ || ring_buffer_;
 }
 
 v8::Local<v8::Promise> NetLog::StopLogging(gin::Arguments* args) {
   gin_helper::Promise<void> promise(args->isolate());
   v8::Local<v8::Promise> handle = promise.GetHandle();
 
+  if (ring_buffer_) {
+    ring_buffer_.reset();
+    // Nothing was asked to be kept from the ring buffer.
+    if (!ring_buffer_path_.empty()) {
+      file_task_runner_->PostTask(
+          FROM_HERE,
+          base::GetDeleteFileCallback(std::exchange(ring_buffer_path_, {})));
+    }
+    // A dump is restarting the exporter.
+    if (!net_log_exporter_) {
+      promise.Resolve();
+      return handle;
+    }
+  }
+
   if (net_log_exporter_) {
     // Move the net_log_exporter_ into the callback to ensure that the mojo
     // pointer lives long enough to resolve the promise. Moving it into the
@@ -215,12 +315,171 @@ v8::Local<v8::Promise> NetLog::StopLogging(gin::Arguments* args) {
   return handle;
 }
 
+v8::Local<v8::Promise> NetLog::StartRingBuffer(gin::Arguments* args) {
+  net::NetLogCaptureMode capture_mode = net::NetLogCaptureMode::kDefault;
+  uint64_t max_size = kDefaultRingBufferSize;
+
+  gin_helper::Dictionary dict;
+  if (args->GetNext(&dict)) {
+    v8::Local<v8::Value> capture_mode_v8;
+    if (dict.Get("captureMode", &capture_mode_v8)) {
+      if (!gin::ConvertFromV8(args->isolate(), capture_mode_v8,
+                              &capture_mode)) {
+        args->ThrowTypeError("Invalid value for captureMode");
+        return v8::Local<v8::Promise>();
+      }
+    }
+    v8::Local<v8::Value> max_size_v8;
+    if (dict.Get("maxSize", &max_size_v8)) {
+      if (!gin::ConvertFromV8(args->isolate(), max_size_v8, &max_size) ||
+          max_size == 0) {
+        args->ThrowTypeError("Invalid value for maxSize");
+        return v8::Local<v8::Promise>();
+      }
+    }
+  }
+
+  if (net_log_exporter_ || ring_buffer_) {
+    args->ThrowTypeError("There is already a net log running");
+    return v8::Local<v8::Promise>();
+  }
+
+  pending_start_promise_ =
+      std::make_optional<gin_helper::Promise<void>>(args->isolate());
+  v8::Local<v8::Promise> handle = pending_start_promise_->GetHandle();
+
+  ring_buffer_ = RingBufferOptions{capture_mode, max_size};
+  StartRingBufferExporter();
+
+  return handle;
+}
+
+void NetLog::StartRingBufferExporter() {
+  auto* network_context =
+      browser_context_->GetDefaultStoragePartition()->GetNetworkContext();
+  network_context->CreateNetLogExporter(
+      net_log_exporter_.BindNewPipeAndPassReceiver());
+  net_log_exporter_.set_disconnect_handler(
+      base::BindOnce(&NetLog::OnConnectionError, base::Unretained(this)));
+
+  file_task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE, base::BindOnce(&CreateRingBufferFile),
+      base::BindOnce(&NetLog::OnRingBufferFileCreated,
+                     weak_ptr_factory_.GetWeakPtr()));
+}
+
+void NetLog::OnRingBufferFileCreated(
+    std::pair<base::FilePath, base::File> ring_buffer_file) {
+  auto& [path, file] = ring_buffer_file;
+  if (!ring_buffer_) {
+    // Stopped meanwhile.
+    if (!path.empty())
+      file_task_runner_->PostTask(FROM_HERE,
+                                  base::GetDeleteFileCallback(path));
+    return;
+  }
+  ring_buffer_path_ = path;
+
+  auto command_line_string =
+      base::CommandLine::ForCurrentProcess()->GetCommandLineString();
+  auto channel_string = std::string("Electron " ELECTRON_VERSION);
+  StartNetLogAfterCreateFile(ring_buffer_->capture_mode, ring_buffer_->max_size,
+                             net_log::GetPlatformConstantsForNetLog(
+                                 command_line_string, channel_string),
+                             std::move(file));
+}
+
+v8::Local<v8::Promise> NetLog::Dump(base::FilePath dump_path,
+                                    gin::Arguments* args) {
+  gin_helper::Promise<void> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  if (dump_path.empty()) {
+    promise.RejectWithErrorMessage("The first parameter must be a valid path");
+    return handle;
+  }
+  std::vector<std::string> source_types;
+  gin_helper::Dictionary dict;
+  if (args->GetNext(&dict) && dict.Has("sourceTypes") &&
+      !dict.Get("sourceTypes", &source_types)) {
+    promise.RejectWithErrorMessage("Invalid value for sourceTypes");
+    return handle;
+  }
+  if (!ring_buffer_) {
+    promise.RejectWithErrorMessage("No ring buffer net log in progress");
+    return handle;
+  }
+  // Stopping is queued after starting on the pipe, but the exporter can't be
+  // started before its file exists.
+  if (dumping_ || ring_buffer_path_.empty()) {
+    promise.RejectWithErrorMessage("A dump is already in progress");
+    return handle;
+  }
+
+  // The log can only be read once the exporter has completed it, a new one
+  // is started right away to keep the gap without events short.
+  dumping_ = true;
+  net_log_exporter_->Stop(
+      base::Value::Dict(),
+      base::BindOnce(
+          [](mojo::Remote<network::mojom::NetLogExporter>,
+             base::WeakPtr<NetLog> net_log, base::FilePath dump_path,
+             std::vector<std::string> source_types,
+             gin_helper::Promise<void> promise, base::FilePath log_path,
+             int32_t error) {
+            if (net_log) {
+              net_log->OnRingBufferStopped(
+                  std::move(dump_path), std::move(source_types),
+                  std::move(promise), std::move(log_path), error);
+            }
+          },
+          std::move(net_log_exporter_), weak_ptr_factory_.GetWeakPtr(),
+          std::move(dump_path), std::move(source_types), std::move(promise),
+          std::exchange(ring_buffer_path_, {})));
+
+  return handle;
+}
+
+void NetLog::OnRingBufferStopped(base::FilePath dump_path,
+                                 std::vector<std::string> source_types,
+                                 gin_helper::Promise<void> promise,
+                                 base::FilePath log_path,
+                                 int32_t error) {
+  if (ring_buffer_)
+    StartRingBufferExporter();
+
+  if (error != net::OK) {
+    dumping_ = false;
+    file_task_runner_->PostTask(FROM_HERE,
+                                base::GetDeleteFileCallback(log_path));
+    promise.RejectWithErrorMessage(net::ErrorToString(error));
+    return;
+  }
+  file_task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE,
+      base::BindOnce(&WriteDump, std::move(log_path), std::move(dump_path),
+                     std::move(source_types)),
+      base::BindOnce(&NetLog::OnDumpWritten, weak_ptr_factory_.GetWeakPtr(),
+                     std::move(promise)));
+}
+
+void NetLog::OnDumpWritten(gin_helper::Promise<void> promise,
+                           std::optional<std::string> error) {
+  dumping_ = false;
+  if (error)
+    promise.RejectWithErrorMessage(*error);
+  else
+    promise.Resolve();
+}
+
 gin::ObjectTemplateBuilder NetLog::GetObjectTemplateBuilder(
     v8::Isolate* isolate) {
   return gin::Wrappable<NetLog>::GetObjectTemplateBuilder(isolate)
       .SetProperty("currentlyLogging", &NetLog::IsCurrentlyLogging)
       .SetMethod("startLogging", &NetLog::StartLogging)
-      .SetMethod("stopLogging", &NetLog::StopLogging);
+      .SetMethod("stopLogging", &NetLog::StopLogging)
+      .SetMethod("startRingBuffer", &NetLog::StartRingBuffer)
+      .SetMethod("dump", &NetLog::Dump);
 }
 
 const char* NetLog::GetTypeName() {
@@ -6,6 +6,9 @@
 #define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_NET_LOG_H_
 
 #include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "base/files/file_path.h"
 #include "base/functional/callback.h"
@@ -40,6 +43,11 @@ class NetLog : public gin::Wrappable<NetLog> {
   v8::Local<v8::Promise> StopLogging(gin::Arguments* args);
   bool IsCurrentlyLogging() const;
 
+  // Keeps the most recent events in a bounded log, which is only written out
+  // where the embedder wants it when it calls Dump().
+  v8::Local<v8::Promise> StartRingBuffer(gin::Arguments* args);
+  v8::Local<v8::Promise> Dump(base::FilePath dump_path, gin::Arguments* args);
+
   // gin::Wrappable
   static gin::WrapperInfo kWrapperInfo;
   gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
@@ -64,12 +72,34 @@ class NetLog : public gin::Wrappable<NetLog> {
   void NetLogStarted(int32_t error);
 
  private:
+  struct RingBufferOptions {
+    net::NetLogCaptureMode capture_mode;
+    uint64_t max_size;
+  };
+
+  void StartRingBufferExporter();
+  void OnRingBufferFileCreated(
+      std::pair<base::FilePath, base::File> ring_buffer_file);
+  void OnRingBufferStopped(base::FilePath dump_path,
+                           std::vector<std::string> source_types,
+                           gin_helper::Promise<void> promise,
+                           base::FilePath log_path,
+                           int32_t error);
+  void OnDumpWritten(gin_helper::Promise<void> promise,
+                     std::optional<std::string> error);
+
   raw_ptr<ElectronBrowserContext> browser_context_;
 
   mojo::Remote<network::mojom::NetLogExporter> net_log_exporter_;
 
   std::optional<gin_helper::Promise<void>> pending_start_promise_;
 
+  // Set while logging into the ring buffer, which is a temporary file the
+  // network service keeps below |max_size| by dropping the oldest events.
+  std::optional<RingBufferOptions> ring_buffer_;
+  base::FilePath ring_buffer_path_;
+  bool dumping_ = false;
+
   scoped_refptr<base::TaskRunner> file_task_runner_;
 
   base::WeakPtrFactory<NetLog> weak_ptr_factory_{this};
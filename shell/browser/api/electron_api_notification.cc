@@ -4,12 +4,18 @@
 
 #include "shell/browser/api/electron_api_notification.h"
 
+#include <algorithm>
+#include <map>
+
+#include "base/no_destructor.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/timer/timer.h"
 #include "base/uuid.h"
 #include "gin/handle.h"
 #include "shell/browser/api/electron_api_menu.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/electron_browser_client.h"
+#include "shell/browser/javascript_environment.h"
 #include "shell/common/gin_converters/image_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/object_template_builder.h"
@@ -47,6 +53,29 @@ struct Converter<electron::NotificationAction> {
 
 namespace electron::api {
 
+namespace {
+
+// The coalesce interval of a tag, which starts when a notification with it is
+// displayed.
+struct CoalescedTag {
+  base::OneShotTimer timer;
+  // The last notification shown during the interval, displayed at its end.
+  // It is pinned meanwhile, so that it isn't collected before then.
+  base::WeakPtr<Notification> pending;
+};
+
+std::map<std::string, CoalescedTag>& GetCoalescedTags() {
+  static base::NoDestructor<std::map<std::string, CoalescedTag>> tags;
+  return *tags;
+}
+
+// Keeps the ids of tagged notifications apart from those of web notifications.
+std::string NotificationIdForTag(const std::string& tag) {
+  return "electron-tag:" + tag;
+}
+
+}  // namespace
+
 gin::WrapperInfo Notification::kWrapperInfo = {gin::kEmbedderNativeGin};
 
 Notification::Notification(gin::Arguments* args) {
@@ -71,6 +100,10 @@ Notification::Notification(gin::Arguments* args) {
     opts.Get("sound", &sound_);
     opts.Get("closeButtonText", &close_button_text_);
     opts.Get("toastXml", &toast_xml_);
+    opts.Get("tag", &tag_);
+    double coalesce_interval = 0;
+    if (opts.Get("coalesceInterval", &coalesce_interval))
+      SetCoalesceInterval(coalesce_interval);
   }
 }
 
@@ -139,6 +172,14 @@ void Notification::SetToastXml(const std::u16string& new_toast_xml) {
   toast_xml_ = new_toast_xml;
 }
 
+void Notification::SetTag(const std::string& new_tag) {
+  tag_ = new_tag;
+}
+
+void Notification::SetCoalesceInterval(double new_coalesce_interval) {
+  coalesce_interval_ = base::Milliseconds(std::max(0.0, new_coalesce_interval));
+}
+
 void Notification::NotificationAction(int index) {
   Emit("action", index);
 }
@@ -166,6 +207,15 @@ void Notification::NotificationClosed() {
 }
 
 void Notification::Close() {
+  if (!tag_.empty()) {
+    auto& tags = GetCoalescedTags();
+    auto it = tags.find(tag_);
+    if (it != tags.end() && it->second.pending.get() == this) {
+      it->second.pending.reset();
+      Unpin();
+    }
+  }
+
   if (notification_) {
     if (notification_->is_dismissed()) {
       notification_->Remove();
@@ -179,10 +229,53 @@ void Notification::Close() {
 
 // Showing notifications
 void Notification::Show() {
+  if (!tag_.empty() && coalesce_interval_.is_positive()) {
+    auto& coalesced = GetCoalescedTags()[tag_];
+    if (coalesced.timer.IsRunning()) {
+      // Replaces any notification already waiting for the interval to end.
+      if (coalesced.pending)
+        coalesced.pending->Unpin();
+      coalesced.pending = weak_factory_.GetWeakPtr();
+      Pin(JavascriptEnvironment::GetIsolate());
+      return;
+    }
+    coalesced.timer.Start(
+        FROM_HERE, coalesce_interval_,
+        base::BindOnce(&Notification::OnCoalesceIntervalEnd, tag_));
+  }
+
+  Display();
+}
+
+// static
+void Notification::OnCoalesceIntervalEnd(const std::string& tag) {
+  auto& tags = GetCoalescedTags();
+  auto it = tags.find(tag);
+  if (it == tags.end())
+    return;
+
+  base::WeakPtr<Notification> pending = std::move(it->second.pending);
+  // This also deletes the timer running this task, which is allowed.
+  tags.erase(it);
+  // Showing it starts the next interval.
+  if (pending) {
+    pending->Unpin();
+    pending->Show();
+  }
+}
+
+void Notification::Display() {
   Close();
   if (presenter_) {
-    notification_ = presenter_->CreateNotification(
-        this, base::Uuid::GenerateRandomV4().AsLowercaseString());
+    std::string notification_id;
+    if (tag_.empty()) {
+      notification_id = base::Uuid::GenerateRandomV4().AsLowercaseString();
+    } else {
+      // Like web notifications, replace the one shown with the same tag.
+      notification_id = NotificationIdForTag(tag_);
+      presenter_->CloseNotificationWithId(notification_id);
+    }
+    notification_ = presenter_->CreateNotification(this, notification_id);
     if (notification_) {
       electron::NotificationOptions options;
       options.title = title_;
@@ -199,6 +292,7 @@ void Notification::Show() {
       options.close_button_text = close_button_text_;
       options.urgency = urgency_;
       options.toast_xml = toast_xml_;
+      options.tag = tag_;
       notification_->Show(options);
     }
   }
@@ -232,6 +326,9 @@ void Notification::FillObjectTemplate(v8::Isolate* isolate,
                    &Notification::SetCloseButtonText)
       .SetProperty("toastXml", &Notification::toast_xml,
                    &Notification::SetToastXml)
+      .SetProperty("tag", &Notification::tag, &Notification::SetTag)
+      .SetProperty("coalesceInterval", &Notification::coalesce_interval,
+                   &Notification::SetCoalesceInterval)
       .Build();
 }
 
@@ -9,7 +9,9 @@
 #include <vector>
 
 #include "base/memory/raw_ptr.h"
+#include "base/memory/weak_ptr.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/time/time.h"
 #include "gin/wrappable.h"
 #include "shell/browser/event_emitter_mixin.h"
 #include "shell/browser/notifications/notification.h"
@@ -18,6 +20,7 @@
 #include "shell/common/gin_helper/cleaned_up_at_exit.h"
 #include "shell/common/gin_helper/constructible.h"
 #include "shell/common/gin_helper/error_thrower.h"
+#include "shell/common/gin_helper/pinnable.h"
 #include "ui/gfx/image/image.h"
 
 namespace gin {
@@ -32,6 +35,7 @@ class Notification : public gin::Wrappable<Notification>,
                      public gin_helper::EventEmitterMixin<Notification>,
                      public gin_helper::Constructible<Notification>,
                      public gin_helper::CleanedUpAtExit,
+                     public gin_helper::Pinnable<Notification>,
                      public NotificationDelegate {
  public:
   static bool IsSupported();
@@ -81,6 +85,10 @@ class Notification : public gin::Wrappable<Notification>,
   }
   const std::u16string& close_button_text() const { return close_button_text_; }
   const std::u16string& toast_xml() const { return toast_xml_; }
+  const std::string& tag() const { return tag_; }
+  double coalesce_interval() const {
+    return coalesce_interval_.InMillisecondsF();
+  }
 
   // Prop Setters
   void SetTitle(const std::u16string& new_title);
@@ -95,8 +103,16 @@ class Notification : public gin::Wrappable<Notification>,
   void SetActions(const std::vector<electron::NotificationAction>& actions);
   void SetCloseButtonText(const std::u16string& text);
   void SetToastXml(const std::u16string& new_toast_xml);
+  void SetTag(const std::string& new_tag);
+  void SetCoalesceInterval(double new_coalesce_interval);
 
  private:
+  // Creates the platform notification, replacing the one with the same tag.
+  void Display();
+
+  // Displays the last notification coalesced into the interval of |tag|.
+  static void OnCoalesceIntervalEnd(const std::string& tag);
+
   std::u16string title_;
   std::u16string subtitle_;
   std::u16string body_;
@@ -112,10 +128,14 @@ class Notification : public gin::Wrappable<Notification>,
   std::vector<electron::NotificationAction> actions_;
   std::u16string close_button_text_;
   std::u16string toast_xml_;
+  std::string tag_;
+  base::TimeDelta coalesce_interval_;
 
   raw_ptr<electron::NotificationPresenter> presenter_;
 
   base::WeakPtr<electron::Notification> notification_;
+
+  base::WeakPtrFactory<Notification> weak_factory_{this};
 };
 
 }  // namespace electron::api
@@ -4,6 +4,9 @@
 
 #include "shell/browser/api/electron_api_power_monitor.h"
 
+#include <algorithm>
+
+#include "base/dcheck_is_on.h"
 #include "base/power_monitor/power_monitor.h"
 #include "base/power_monitor/power_monitor_device_source.h"
 #include "base/power_monitor/power_observer.h"
@@ -16,6 +19,23 @@
 #include "shell/common/gin_helper/object_template_builder.h"
 #include "shell/common/node_includes.h"
 
+namespace {
+
+#if DCHECK_IS_ON()
+// Replaces the system idle time in tests, negative when unset.
+int g_idle_time_for_testing = -1;
+#endif
+
+int CalculateIdleTime() {
+#if DCHECK_IS_ON()
+  if (g_idle_time_for_testing >= 0)
+    return g_idle_time_for_testing;
+#endif
+  return ui::CalculateIdleTime();
+}
+
+}  // namespace
+
 namespace gin {
 
 template <>
@@ -100,6 +120,13 @@ void PowerMonitor::OnSuspend() {
 
 void PowerMonitor::OnResume() {
   Emit("resume");
+
+  // Input is likely right after resuming, so don't wait for the next check.
+  if (idle_threshold_ > 0 && is_idle_) {
+    idle_check_interval_ = base::TimeDelta();
+    idle_timer_.Start(FROM_HERE, base::TimeDelta(), this,
+                      &PowerMonitor::CheckIdleState);
+  }
 }
 
 void PowerMonitor::OnThermalStateChange(DeviceThermalState new_state) {
@@ -118,6 +145,56 @@ void PowerMonitor::OnSpeedLimitChange(int speed_limit) {
       gin::DataObjectBuilder(isolate).Set("limit", speed_limit).Build());
 }
 
+void PowerMonitor::SetIdleThreshold(gin::Arguments* args,
+                                    int idle_threshold) {
+  if (idle_threshold < 0) {
+    args->ThrowTypeError("Invalid idle threshold, must not be negative");
+    return;
+  }
+
+  idle_threshold_ = idle_threshold;
+  is_idle_ = false;
+  if (idle_threshold_ == 0) {
+    idle_timer_.Stop();
+    return;
+  }
+  // Check on the next turn of the loop rather than emitting from inside the
+  // call.
+  idle_timer_.Start(FROM_HERE, base::TimeDelta(), this,
+                    &PowerMonitor::CheckIdleState);
+}
+
+void PowerMonitor::CheckIdleState() {
+  // While idle, there is no telling when input resumes, so the checks start a
+  // second apart and back off the longer the system stays idle. While active,
+  // the threshold can't be reached before the time that is left, since the
+  // idle time only grows until there is input.
+  constexpr base::TimeDelta kMinActivityCheckInterval = base::Seconds(1);
+  constexpr base::TimeDelta kMaxActivityCheckInterval = base::Seconds(30);
+  const int idle_time = CalculateIdleTime();
+  base::TimeDelta delay;
+  if (idle_time >= idle_threshold_) {
+    if (!is_idle_) {
+      is_idle_ = true;
+      idle_check_interval_ = base::TimeDelta();
+      Emit("idle");
+    }
+    idle_check_interval_ =
+        std::clamp(idle_check_interval_ * 2, kMinActivityCheckInterval,
+                   kMaxActivityCheckInterval);
+    delay = idle_check_interval_;
+  } else {
+    delay = base::Seconds(idle_threshold_ - idle_time);
+    if (is_idle_) {
+      is_idle_ = false;
+      Emit("active");
+    }
+  }
+  // A listener may have changed the threshold.
+  if (idle_threshold_ > 0 && !idle_timer_.IsRunning())
+    idle_timer_.Start(FROM_HERE, delay, this, &PowerMonitor::CheckIdleState);
+}
+
 #if BUILDFLAG(IS_LINUX)
 void PowerMonitor::SetListeningForShutdown(bool is_listening) {
   if (is_listening) {
@@ -143,6 +220,7 @@ gin::ObjectTemplateBuilder PowerMonitor::GetObjectTemplateBuilder(
   auto builder =
       gin_helper::EventEmitterMixin<PowerMonitor>::GetObjectTemplateBuilder(
           isolate);
+  builder.SetMethod("setIdleThreshold", &PowerMonitor::SetIdleThreshold);
 #if BUILDFLAG(IS_LINUX)
   builder.SetMethod("setListeningForShutdown",
                     &PowerMonitor::SetListeningForShutdown);
@@ -171,9 +249,15 @@ ui::IdleState GetSystemIdleState(v8::Isolate* isolate, int idle_threshold) {
 }
 
 int GetSystemIdleTime() {
-  return ui::CalculateIdleTime();
+  return CalculateIdleTime();
 }
 
+#if DCHECK_IS_ON()
+void SetSystemIdleTimeForTesting(int idle_time) {
+  g_idle_time_for_testing = idle_time;
+}
+#endif
+
 bool IsOnBatteryPower() {
   return base::PowerMonitor::IsOnBatteryPower();
 }
@@ -195,6 +279,10 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("getCurrentThermalState",
                  base::BindRepeating(&GetCurrentThermalState));
   dict.SetMethod("getSystemIdleTime", base::BindRepeating(&GetSystemIdleTime));
+#if DCHECK_IS_ON()
+  dict.SetMethod("_setSystemIdleTimeForTesting",
+                 base::BindRepeating(&SetSystemIdleTimeForTesting));
+#endif
   dict.SetMethod("isOnBatteryPower", base::BindRepeating(&IsOnBatteryPower));
 }
 
@@ -6,6 +6,8 @@
 #define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_POWER_MONITOR_H_
 
 #include "base/power_monitor/power_observer.h"
+#include "base/timer/timer.h"
+#include "gin/arguments.h"
 #include "gin/wrappable.h"
 #include "shell/browser/event_emitter_mixin.h"
 #include "shell/common/gin_helper/pinnable.h"
@@ -47,6 +49,11 @@ class PowerMonitor : public gin::Wrappable<PowerMonitor>,
   // Called by native calles.
   bool ShouldShutdown();
 
+  // Emits "idle" once the system has been idle for |idle_threshold| seconds,
+  // and "active" when it stops being idle. 0 stops watching.
+  void SetIdleThreshold(gin::Arguments* args, int idle_threshold);
+  void CheckIdleState();
+
 #if BUILDFLAG(IS_MAC) || BUILDFLAG(IS_WIN)
   void InitPlatformSpecificMonitors();
 #endif
@@ -87,6 +94,14 @@ class PowerMonitor : public gin::Wrappable<PowerMonitor>,
 #if BUILDFLAG(IS_LINUX)
   PowerObserverLinux power_observer_linux_{this};
 #endif
+
+  // Checks the idle time only when the threshold could first have been
+  // reached, rather than on a fixed interval.
+  base::OneShotTimer idle_timer_;
+  // The delay between the checks while idle, which doubles after each one.
+  base::TimeDelta idle_check_interval_;
+  int idle_threshold_ = 0;
+  bool is_idle_ = false;
 };
 
 }  // namespace electron::api
@@ -5,6 +5,7 @@
 #include "shell/browser/api/electron_api_protocol.h"
 
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include "base/command_line.h"
@@ -12,6 +13,7 @@
 #include "content/common/url_schemes.h"
 #include "content/public/browser/child_process_security_policy.h"
 #include "gin/object_template_builder.h"
+#include "shell/browser/api/electron_api_utility_process.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/electron_browser_context.h"
 #include "shell/browser/protocol_registry.h"
@@ -36,6 +38,9 @@ std::vector<std::string> g_streaming_schemes;
 // Schemes that support V8 code cache.
 std::vector<std::string> g_code_cache_schemes;
 
+// Schemes whose pages share one renderer process per site.
+std::vector<std::string> g_process_per_site_schemes;
+
 struct SchemeOptions {
   bool standard = false;
   bool secure = false;
@@ -45,6 +50,7 @@ struct SchemeOptions {
   bool corsEnabled = false;
   bool stream = false;
   bool codeCache = false;
+  bool processPerSite = false;
 };
 
 struct CustomScheme {
@@ -77,6 +83,7 @@ struct Converter<CustomScheme> {
       opt.Get("corsEnabled", &(out->options.corsEnabled));
       opt.Get("stream", &(out->options.stream));
       opt.Get("codeCache", &(out->options.codeCache));
+      opt.Get("processPerSite", &(out->options.processPerSite));
     }
     return true;
   }
@@ -96,6 +103,10 @@ const std::vector<std::string>& GetCodeCacheSchemes() {
   return g_code_cache_schemes;
 }
 
+const std::vector<std::string>& GetProcessPerSiteSchemes() {
+  return g_process_per_site_schemes;
+}
+
 void AddServiceWorkerScheme(const std::string& scheme) {
   // There is no API to add service worker scheme, but there is an API to
   // return const reference to the schemes vector.
@@ -160,6 +171,9 @@ void RegisterSchemesAsPrivileged(gin_helper::ErrorThrower thrower,
       g_code_cache_schemes.push_back(custom_scheme.scheme);
       url::AddCodeCacheScheme(custom_scheme.scheme.c_str());
     }
+    if (custom_scheme.options.processPerSite) {
+      g_process_per_site_schemes.push_back(custom_scheme.scheme);
+    }
   }
 
   const auto AppendSchemesToCmdLine = [](const char* switch_name,
@@ -235,6 +249,14 @@ bool Protocol::IsProtocolRegistered(const std::string& scheme) {
   return protocol_registry_->IsProtocolRegistered(scheme);
 }
 
+bool Protocol::RegisterUtilityProcessProtocol(const std::string& scheme,
+                                              UtilityProcessWrapper* child) {
+  auto factory = child->CreateProtocolURLLoaderFactory(scheme);
+  if (!factory)
+    return false;
+  return protocol_registry_->RegisterRemoteProtocol(scheme, std::move(factory));
+}
+
 ProtocolError Protocol::InterceptProtocol(ProtocolType type,
                                           const std::string& scheme,
                                           const ProtocolHandler& handler) {
@@ -325,6 +347,8 @@ v8::Local<v8::ObjectTemplate> Protocol::FillObjectTemplate(
                  &Protocol::RegisterProtocolFor<ProtocolType::kFree>)
       .SetMethod("unregisterProtocol", &Protocol::UnregisterProtocol)
       .SetMethod("isProtocolRegistered", &Protocol::IsProtocolRegistered)
+      .SetMethod("registerUtilityProcessProtocol",
+                 &Protocol::RegisterUtilityProcessProtocol)
       .SetMethod("isProtocolHandled", &Protocol::IsProtocolHandled)
       .SetMethod("interceptStringProtocol",
                  &Protocol::InterceptProtocolFor<ProtocolType::kString>)
@@ -22,8 +22,11 @@ class ProtocolRegistry;
 
 namespace api {
 
+class UtilityProcessWrapper;
+
 const std::vector<std::string>& GetStandardSchemes();
 const std::vector<std::string>& GetCodeCacheSchemes();
+const std::vector<std::string>& GetProcessPerSiteSchemes();
 
 void AddServiceWorkerScheme(const std::string& scheme);
 
@@ -72,6 +75,11 @@ class Protocol : public gin::Wrappable<Protocol>,
   bool UnregisterProtocol(const std::string& scheme, gin::Arguments* args);
   bool IsProtocolRegistered(const std::string& scheme);
 
+  // Serves |scheme| with the handler registered by |child|, the requests are
+  // sent to the utility process without going through this thread.
+  bool RegisterUtilityProcessProtocol(const std::string& scheme,
+                                      UtilityProcessWrapper* child);
+
   ProtocolError InterceptProtocol(ProtocolType type,
                                   const std::string& scheme,
                                   const ProtocolHandler& handler);
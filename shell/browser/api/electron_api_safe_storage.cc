@@ -4,14 +4,20 @@
 
 #include "shell/browser/api/electron_api_safe_storage.h"
 
+#include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "base/strings/stringprintf.h"
+#include "base/task/thread_pool.h"
 #include "components/os_crypt/sync/os_crypt.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/browser_process_impl.h"
 #include "shell/common/gin_converters/base_converter.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/platform_util.h"
 
@@ -128,6 +134,159 @@ std::string DecryptString(v8::Isolate* isolate, v8::Local<v8::Value> buffer) {
   return plaintext;
 }
 
+namespace {
+
+// The results of a batch, or the first error it ran into.
+struct BatchResult {
+  std::vector<std::string> values;
+  std::optional<std::string> error;
+};
+
+BatchResult EncryptBatch(const std::vector<std::string>& plaintexts) {
+  BatchResult result;
+  result.values.reserve(plaintexts.size());
+  for (size_t i = 0; i < plaintexts.size(); ++i) {
+    std::string ciphertext;
+    if (!OSCrypt::EncryptString(plaintexts[i], &ciphertext)) {
+      result.error = base::StringPrintf(
+          "Error while encrypting the text at index %zu provided to "
+          "safeStorage.encryptStrings.",
+          i);
+      return result;
+    }
+    result.values.push_back(std::move(ciphertext));
+  }
+  return result;
+}
+
+BatchResult DecryptBatch(const std::vector<std::string>& ciphertexts) {
+  BatchResult result;
+  result.values.reserve(ciphertexts.size());
+  for (size_t i = 0; i < ciphertexts.size(); ++i) {
+    const std::string& ciphertext = ciphertexts[i];
+    std::string plaintext;
+    if (!ciphertext.empty()) {
+      if (ciphertext.find(kEncryptionVersionPrefixV10) != 0 &&
+          ciphertext.find(kEncryptionVersionPrefixV11) != 0) {
+        result.error = base::StringPrintf(
+            "Error while decrypting the ciphertext at index %zu provided to "
+            "safeStorage.decryptStrings. "
+            "Ciphertext does not appear to be encrypted.",
+            i);
+        return result;
+      }
+      if (!OSCrypt::DecryptString(ciphertext, &plaintext)) {
+        result.error = base::StringPrintf(
+            "Error while decrypting the ciphertext at index %zu provided to "
+            "safeStorage.decryptStrings.",
+            i);
+        return result;
+      }
+    }
+    result.values.push_back(std::move(plaintext));
+  }
+  return result;
+}
+
+void OnStringsEncrypted(
+    gin_helper::Promise<std::vector<v8::Local<v8::Value>>> promise,
+    BatchResult result) {
+  if (result.error) {
+    promise.RejectWithErrorMessage(*result.error);
+    return;
+  }
+  v8::Isolate* isolate = promise.isolate();
+  v8::HandleScope handle_scope(isolate);
+  std::vector<v8::Local<v8::Value>> buffers;
+  buffers.reserve(result.values.size());
+  for (const auto& ciphertext : result.values) {
+    buffers.push_back(
+        node::Buffer::Copy(isolate, ciphertext.c_str(), ciphertext.size())
+            .ToLocalChecked());
+  }
+  promise.Resolve(buffers);
+}
+
+void OnStringsDecrypted(gin_helper::Promise<std::vector<std::string>> promise,
+                        BatchResult result) {
+  if (result.error)
+    promise.RejectWithErrorMessage(*result.error);
+  else
+    promise.Resolve(result.values);
+}
+
+// OSCrypt can be used from any thread, and it only asks the OS for the key the
+// first time it is needed, so batches run on the thread pool rather than
+// keeping the main thread busy.
+constexpr base::TaskTraits kBatchTaskTraits = {
+    base::MayBlock(), base::TaskPriority::USER_VISIBLE};
+
+}  // namespace
+
+v8::Local<v8::Promise> EncryptStrings(v8::Isolate* isolate,
+                                      std::vector<std::string> plaintexts) {
+  gin_helper::Promise<std::vector<v8::Local<v8::Value>>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  if (!IsEncryptionAvailable()) {
+    if (!Browser::Get()->is_ready()) {
+      promise.RejectWithErrorMessage(
+          "safeStorage cannot be used before app is ready");
+    } else {
+      promise.RejectWithErrorMessage(
+          "Error while encrypting the texts provided to "
+          "safeStorage.encryptStrings. "
+          "Encryption is not available.");
+    }
+    return handle;
+  }
+
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, kBatchTaskTraits,
+      base::BindOnce(&EncryptBatch, std::move(plaintexts)),
+      base::BindOnce(&OnStringsEncrypted, std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Promise> DecryptStrings(
+    v8::Isolate* isolate,
+    const std::vector<v8::Local<v8::Value>>& buffers) {
+  gin_helper::Promise<std::vector<std::string>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  if (!IsEncryptionAvailable()) {
+    if (!Browser::Get()->is_ready()) {
+      promise.RejectWithErrorMessage(
+          "safeStorage cannot be used before app is ready");
+    } else {
+      promise.RejectWithErrorMessage(
+          "Error while decrypting the ciphertexts provided to "
+          "safeStorage.decryptStrings. "
+          "Decryption is not available.");
+    }
+    return handle;
+  }
+
+  std::vector<std::string> ciphertexts;
+  ciphertexts.reserve(buffers.size());
+  for (const auto& buffer : buffers) {
+    if (!node::Buffer::HasInstance(buffer)) {
+      promise.RejectWithErrorMessage(
+          "Expected the first argument of decryptStrings() to be an array of "
+          "buffers");
+      return handle;
+    }
+    ciphertexts.emplace_back(node::Buffer::Data(buffer),
+                             node::Buffer::Length(buffer));
+  }
+
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, kBatchTaskTraits,
+      base::BindOnce(&DecryptBatch, std::move(ciphertexts)),
+      base::BindOnce(&OnStringsDecrypted, std::move(promise)));
+  return handle;
+}
+
 }  // namespace electron::safestorage
 
 void Initialize(v8::Local<v8::Object> exports,
@@ -140,6 +299,8 @@ void Initialize(v8::Local<v8::Object> exports,
                  &electron::safestorage::IsEncryptionAvailable);
   dict.SetMethod("encryptString", &electron::safestorage::EncryptString);
   dict.SetMethod("decryptString", &electron::safestorage::DecryptString);
+  dict.SetMethod("encryptStrings", &electron::safestorage::EncryptStrings);
+  dict.SetMethod("decryptStrings", &electron::safestorage::DecryptStrings);
   dict.SetMethod("setUsePlainTextEncryption",
                  &electron::safestorage::SetUsePasswordV10);
 #if BUILDFLAG(IS_LINUX)
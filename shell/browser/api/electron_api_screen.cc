@@ -105,12 +105,14 @@ static gfx::Rect DIPToScreenRect(electron::NativeWindow* window,
 #endif
 
 void Screen::OnDisplayAdded(const display::Display& new_display) {
+  ++displays_version_;
   base::SingleThreadTaskRunner::GetCurrentDefault()->PostNonNestableTask(
       FROM_HERE, base::BindOnce(&DelayEmit, base::Unretained(this),
                                 "display-added", new_display));
 }
 
 void Screen::OnDisplayRemoved(const display::Display& old_display) {
+  ++displays_version_;
   base::SingleThreadTaskRunner::GetCurrentDefault()->PostNonNestableTask(
       FROM_HERE, base::BindOnce(&DelayEmit, base::Unretained(this),
                                 "display-removed", old_display));
@@ -118,6 +120,7 @@ void Screen::OnDisplayRemoved(const display::Display& old_display) {
 
 void Screen::OnDisplayMetricsChanged(const display::Display& display,
                                      uint32_t changed_metrics) {
+  ++displays_version_;
   base::SingleThreadTaskRunner::GetCurrentDefault()->PostNonNestableTask(
       FROM_HERE, base::BindOnce(&DelayEmitWithMetrics, base::Unretained(this),
                                 "display-metrics-changed", display,
@@ -157,7 +160,8 @@ gin::ObjectTemplateBuilder Screen::GetObjectTemplateBuilder(
       .SetMethod("screenToDipRect", &ScreenToDIPRect)
       .SetMethod("dipToScreenRect", &DIPToScreenRect)
 #endif
-      .SetMethod("getDisplayMatching", &Screen::GetDisplayMatching);
+      .SetMethod("getDisplayMatching", &Screen::GetDisplayMatching)
+      .SetProperty("displaysVersion", &Screen::displays_version);
 }
 
 const char* Screen::GetTypeName() {
@@ -54,6 +54,7 @@ class Screen : public gin::Wrappable<Screen>,
   display::Display GetDisplayMatching(const gfx::Rect& match_rect) const {
     return screen_->GetDisplayMatching(match_rect);
   }
+  uint32_t displays_version() const { return displays_version_; }
 
   // display::DisplayObserver:
   void OnDisplayAdded(const display::Display& new_display) override;
@@ -63,6 +64,9 @@ class Screen : public gin::Wrappable<Screen>,
 
  private:
   raw_ptr<display::Screen> screen_;
+  // Bumped whenever a display is added, removed or changed, so that callers
+  // can tell whether displays they converted before are still current.
+  uint32_t displays_version_ = 0;
 };
 
 }  // namespace electron::api
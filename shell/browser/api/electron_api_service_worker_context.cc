@@ -4,8 +4,10 @@
 
 #include "shell/browser/api/electron_api_service_worker_context.h"
 
+#include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include "base/strings/string_number_conversions.h"
 #include "chrome/browser/browser_process.h"
@@ -88,6 +90,14 @@ void ServiceWorkerContext::OnReportConsoleMessage(
     int64_t version_id,
     const GURL& scope,
     const content::ConsoleMessage& message) {
+  if (static_cast<int>(message.message_level) < console_message_level_)
+    return;
+  if (console_message_sources_ &&
+      !console_message_sources_->contains(
+          MessageSourceToString(message.source))) {
+    return;
+  }
+
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope handle_scope(isolate);
   Emit("console-message",
@@ -141,6 +151,43 @@ v8::Local<v8::Value> ServiceWorkerContext::GetWorkerInfoFromID(
                                         std::move(iter->second));
 }
 
+void ServiceWorkerContext::SetConsoleMessageFilter(
+    gin_helper::ErrorThrower thrower,
+    v8::Local<v8::Value> value) {
+  // The filter is only replaced once all of it is valid, so an invalid one
+  // leaves the current filter in place.
+  int level = 0;
+  std::optional<base::flat_set<std::string>> sources;
+  if (!value->IsNullOrUndefined()) {
+    gin_helper::Dictionary filter;
+    if (!gin::ConvertFromV8(thrower.isolate(), value, &filter)) {
+      thrower.ThrowTypeError("filter must be an object or null");
+      return;
+    }
+
+    v8::Local<v8::Value> level_value;
+    if (filter.Get("level", &level_value) && !level_value->IsUndefined() &&
+        !gin::ConvertFromV8(thrower.isolate(), level_value, &level)) {
+      thrower.ThrowTypeError("level must be a number");
+      return;
+    }
+
+    v8::Local<v8::Value> sources_value;
+    if (filter.Get("sources", &sources_value) &&
+        !sources_value->IsUndefined()) {
+      std::vector<std::string> names;
+      if (!gin::ConvertFromV8(thrower.isolate(), sources_value, &names)) {
+        thrower.ThrowTypeError("sources must be an array of strings");
+        return;
+      }
+      sources.emplace(std::move(names));
+    }
+  }
+
+  console_message_level_ = level;
+  console_message_sources_ = std::move(sources);
+}
+
 // static
 gin::Handle<ServiceWorkerContext> ServiceWorkerContext::Create(
     v8::Isolate* isolate,
@@ -157,7 +204,9 @@ gin::ObjectTemplateBuilder ServiceWorkerContext::GetObjectTemplateBuilder(
       .SetMethod("getAllRunning",
                  &ServiceWorkerContext::GetAllRunningWorkerInfo)
       .SetMethod("getFromVersionID",
-                 &ServiceWorkerContext::GetWorkerInfoFromID);
+                 &ServiceWorkerContext::GetWorkerInfoFromID)
+      .SetMethod("setConsoleMessageFilter",
+                 &ServiceWorkerContext::SetConsoleMessageFilter);
 }
 
 const char* ServiceWorkerContext::GetTypeName() {
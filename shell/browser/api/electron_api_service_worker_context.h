@@ -5,6 +5,10 @@
 #ifndef ELECTRON_SHELL_BROWSER_API_ELECTRON_API_SERVICE_WORKER_CONTEXT_H_
 #define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_SERVICE_WORKER_CONTEXT_H_
 
+#include <optional>
+#include <string>
+
+#include "base/containers/flat_set.h"
 #include "base/memory/raw_ptr.h"
 #include "content/public/browser/service_worker_context.h"
 #include "content/public/browser/service_worker_context_observer.h"
@@ -30,6 +34,8 @@ class ServiceWorkerContext
   v8::Local<v8::Value> GetAllRunningWorkerInfo(v8::Isolate* isolate);
   v8::Local<v8::Value> GetWorkerInfoFromID(gin_helper::ErrorThrower thrower,
                                            int64_t version_id);
+  void SetConsoleMessageFilter(gin_helper::ErrorThrower thrower,
+                               v8::Local<v8::Value> value);
 
   // content::ServiceWorkerContextObserver
   void OnReportConsoleMessage(int64_t version_id,
@@ -56,6 +62,11 @@ class ServiceWorkerContext
  private:
   raw_ptr<content::ServiceWorkerContext> service_worker_context_;
 
+  // Console messages below this level, or from other sources than these when
+  // set, are not emitted.
+  int console_message_level_ = 0;
+  std::optional<base::flat_set<std::string>> console_message_sources_;
+
   base::WeakPtrFactory<ServiceWorkerContext> weak_ptr_factory_{this};
 };
 
@@ -12,13 +12,16 @@
 #include <vector>
 
 #include "base/command_line.h"
+#include "base/dcheck_is_on.h"
 #include "base/files/file_enumerator.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/memory/raw_ptr.h"
 #include "base/scoped_observation.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
+#include "base/timer/timer.h"
 #include "base/uuid.h"
 #include "chrome/browser/browser_process.h"
 #include "chrome/common/chrome_switches.h"
@@ -63,12 +66,16 @@
 #include "shell/browser/browser.h"
 #include "shell/browser/electron_browser_context.h"
 #include "shell/browser/electron_browser_main_parts.h"
+#include "shell/browser/electron_download_manager_delegate.h"
 #include "shell/browser/electron_permission_manager.h"
 #include "shell/browser/javascript_environment.h"
 #include "shell/browser/media/media_device_id_salt.h"
 #include "shell/browser/net/cert_verifier_client.h"
+#include "shell/browser/net/resolve_host_batch.h"
 #include "shell/browser/net/resolve_host_function.h"
+#include "shell/browser/preconnect_predictor.h"
 #include "shell/browser/session_preferences.h"
+#include "shell/browser/spare_renderer_pool.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/content_converter.h"
 #include "shell/common/gin_converters/file_path_converter.h"
@@ -112,6 +119,9 @@ namespace {
 
 struct ClearStorageDataOptions {
   blink::StorageKey storage_key;
+  // When set, each origin is cleared on its own, in this order.
+  std::vector<blink::StorageKey> storage_keys;
+  base::TimeDelta interval;
   uint32_t storage_types = StoragePartition::REMOVE_DATA_MASK_ALL;
   uint32_t quota_types = StoragePartition::QUOTA_MANAGED_STORAGE_MASK_ALL;
 };
@@ -186,6 +196,70 @@ class ClearDataObserver : public content::BrowsingDataRemover::Observer {
       observation_{this};
 };
 
+// Clears the storage of one origin at a time, emitting the progress on the
+// session after each of them and waiting for the interval before going on,
+// so clearing lots of data doesn't keep the storage backends busy for long.
+// This type manages its own lifetime, deleting itself once it's done.
+class IncrementalStorageDataClearer {
+ public:
+  IncrementalStorageDataClearer(base::WeakPtr<api::Session> session,
+                                gin_helper::Promise<void> promise,
+                                ClearStorageDataOptions options)
+      : session_(std::move(session)),
+        promise_(std::move(promise)),
+        options_(std::move(options)) {}
+
+  // disable copy
+  IncrementalStorageDataClearer(const IncrementalStorageDataClearer&) = delete;
+  IncrementalStorageDataClearer& operator=(
+      const IncrementalStorageDataClearer&) = delete;
+
+  void Start() { ClearNext(); }
+
+ private:
+  void ClearNext() {
+    if (!session_) {
+      promise_.RejectWithErrorMessage("The session has been destroyed");
+      delete this;
+      return;
+    }
+    auto* storage_partition =
+        session_->browser_context()->GetStoragePartition(nullptr);
+    storage_partition->ClearData(
+        options_.storage_types, options_.quota_types,
+        options_.storage_keys[completed_], base::Time(), base::Time::Max(),
+        base::BindOnce(&IncrementalStorageDataClearer::OnOriginCleared,
+                       base::Unretained(this)));
+  }
+
+  void OnOriginCleared() {
+    const blink::StorageKey& storage_key = options_.storage_keys[completed_];
+    ++completed_;
+    if (session_) {
+      base::Value::Dict progress;
+      progress.Set("origin", storage_key.origin().Serialize());
+      progress.Set("completed", static_cast<int>(completed_));
+      progress.Set("total", static_cast<int>(options_.storage_keys.size()));
+      session_->Emit("clear-storage-data-progress", std::move(progress));
+    }
+
+    if (completed_ == options_.storage_keys.size()) {
+      promise_.Resolve();
+      delete this;
+      return;
+    }
+    timer_.Start(FROM_HERE, options_.interval,
+                 base::BindOnce(&IncrementalStorageDataClearer::ClearNext,
+                                base::Unretained(this)));
+  }
+
+  base::WeakPtr<api::Session> session_;
+  gin_helper::Promise<void> promise_;
+  const ClearStorageDataOptions options_;
+  size_t completed_ = 0;
+  base::OneShotTimer timer_;
+};
+
 base::Value::Dict createProxyConfig(ProxyPrefs::ProxyMode proxy_mode,
                                     std::string const& pac_url,
                                     std::string const& proxy_server,
@@ -225,6 +299,14 @@ struct Converter<ClearStorageDataOptions> {
     if (GURL storage_origin; options.Get("origin", &storage_origin))
       out->storage_key = blink::StorageKey::CreateFirstParty(
           url::Origin::Create(storage_origin));
+    if (std::vector<GURL> origins; options.Get("origins", &origins)) {
+      for (const auto& origin : origins) {
+        out->storage_keys.push_back(
+            blink::StorageKey::CreateFirstParty(url::Origin::Create(origin)));
+      }
+    }
+    if (double interval_ms; options.Get("interval", &interval_ms))
+      out->interval = base::Milliseconds(std::max(interval_ms, 0.0));
     std::vector<std::string> types;
     if (options.Get("storages", &types))
       out->storage_types = GetStorageMask(types);
@@ -497,6 +579,56 @@ v8::Local<v8::Promise> Session::ResolveHost(
   return handle;
 }
 
+v8::Local<v8::Promise> Session::ResolveHosts(std::vector<std::string> hosts,
+                                             gin::Arguments* args) {
+  network::mojom::ResolveHostParametersPtr params;
+  int concurrency = 16;
+  v8::Local<v8::Value> options;
+  if (args->GetNext(&options) && !options->IsUndefined()) {
+    gin_helper::Dictionary dict;
+    if (!gin::ConvertFromV8(isolate_, options, &dict) ||
+        !gin::ConvertFromV8(isolate_, options, &params)) {
+      args->ThrowTypeError("options must be an object");
+      return {};
+    }
+    if (dict.Get("concurrency", &concurrency) &&
+        (concurrency < 1 || concurrency > 64)) {
+      args->ThrowTypeError("concurrency must be between 1 and 64");
+      return {};
+    }
+  }
+
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate_);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  ResolveHostBatch::Start(
+      browser_context_, std::move(hosts), std::move(params), concurrency,
+      base::BindOnce(
+          [](gin_helper::Promise<v8::Local<v8::Value>> promise,
+             std::vector<ResolveHostBatch::Result> results) {
+            v8::Isolate* isolate = promise.isolate();
+            v8::HandleScope handle_scope(isolate);
+            v8::Local<v8::Array> array =
+                v8::Array::New(isolate, results.size());
+            v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            for (size_t i = 0; i < results.size(); ++i) {
+              const auto& result = results[i];
+              auto dict = gin_helper::Dictionary::CreateEmpty(isolate);
+              dict.Set("host", result.host);
+              if (result.error < 0)
+                dict.Set("error", net::ErrorToString(result.error));
+              else
+                dict.Set("endpoints", result.addresses->endpoints());
+              dict.Set("duration", result.duration.InMillisecondsF());
+              array->Set(context, i, dict.GetHandle()).Check();
+            }
+            promise.Resolve(array);
+          },
+          std::move(promise)));
+
+  return handle;
+}
+
 v8::Local<v8::Promise> Session::GetCacheSize() {
   gin_helper::Promise<int64_t> promise(isolate_);
   auto handle = promise.GetHandle();
@@ -541,6 +673,12 @@ v8::Local<v8::Promise> Session::ClearStorageData(gin::Arguments* args) {
   ClearStorageDataOptions options;
   args->GetNext(&options);
 
+  if (!options.storage_keys.empty() && !options.storage_key.origin().opaque()) {
+    promise.RejectWithErrorMessage(
+        "Pass either 'origin' or 'origins', but not both");
+    return handle;
+  }
+
   auto* storage_partition = browser_context()->GetStoragePartition(nullptr);
   if (options.storage_types & StoragePartition::REMOVE_DATA_MASK_COOKIES) {
     // Reset media device id salt when cookies are cleared.
@@ -548,6 +686,13 @@ v8::Local<v8::Promise> Session::ClearStorageData(gin::Arguments* args) {
     MediaDeviceIDSalt::Reset(browser_context()->prefs());
   }
 
+  if (!options.storage_keys.empty()) {
+    (new IncrementalStorageDataClearer(GetWeakPtr(), std::move(promise),
+                                       std::move(options)))
+        ->Start();
+    return handle;
+  }
+
   storage_partition->ClearData(
       options.storage_types, options.quota_types, options.storage_key,
       base::Time(), base::Time::Max(),
@@ -659,11 +804,72 @@ void Session::SetCertVerifyProc(v8::Local<v8::Value> val,
     return;
   }
 
+  CertVerifierClient::Options options;
+  bool has_policies = false;
+  gin_helper::Dictionary dict;
+  if (args->GetNext(&dict)) {
+    double cache_ttl = 0;
+    if (dict.Get("cacheTTL", &cache_ttl)) {
+      if (!(cache_ttl >= 0)) {
+        args->ThrowTypeError("cacheTTL must be a non-negative number");
+        return;
+      }
+      options.cache_ttl = base::Milliseconds(cache_ttl);
+    }
+
+    std::vector<gin_helper::Dictionary> pins;
+    dict.Get("pinnedPublicKeys", &pins);
+    for (const auto& pin_dict : pins) {
+      CertVerifierClient::PublicKeyPin pin;
+      std::vector<std::string> hashes;
+      if (!pin_dict.Get("hostname", &pin.hostname) ||
+          !pin_dict.Get("hashes", &hashes)) {
+        args->ThrowTypeError(
+            "Public key pins must have a hostname and hashes");
+        return;
+      }
+      pin_dict.Get("includeSubdomains", &pin.include_subdomains);
+      for (const auto& hash : hashes) {
+        net::HashValue value;
+        if (!value.FromString(hash)) {
+          args->ThrowTypeError("Invalid public key hash: " + hash);
+          return;
+        }
+        pin.hashes.push_back(value);
+      }
+      options.pins.push_back(std::move(pin));
+    }
+
+    std::vector<gin_helper::Dictionary> certificates;
+    dict.Get("trustedCertificates", &certificates);
+    for (const auto& certificate_dict : certificates) {
+      CertVerifierClient::TrustedCertificate certificate;
+      std::string fingerprint;
+      if (!certificate_dict.Get("hostname", &certificate.hostname) ||
+          !certificate_dict.Get("fingerprint", &fingerprint)) {
+        args->ThrowTypeError(
+            "Trusted certificates must have a hostname and fingerprint");
+        return;
+      }
+      certificate_dict.Get("includeSubdomains",
+                           &certificate.include_subdomains);
+      if (!certificate.fingerprint.FromString(fingerprint) ||
+          certificate.fingerprint.tag() != net::HASH_VALUE_SHA256) {
+        args->ThrowTypeError("Invalid certificate fingerprint: " +
+                             fingerprint);
+        return;
+      }
+      options.trusted_certificates.push_back(std::move(certificate));
+    }
+    has_policies = !options.pins.empty() ||
+                   !options.trusted_certificates.empty();
+  }
+
   mojo::PendingRemote<network::mojom::CertVerifierClient>
       cert_verifier_client_remote;
-  if (proc) {
+  if (proc || has_policies) {
     mojo::MakeSelfOwnedReceiver(
-        std::make_unique<CertVerifierClient>(proc),
+        std::make_unique<CertVerifierClient>(proc, options),
         cert_verifier_client_remote.InitWithNewPipeAndPassReceiver());
   }
   browser_context_->GetDefaultStoragePartition()
@@ -709,6 +915,18 @@ void Session::SetPermissionCheckHandler(v8::Local<v8::Value> val,
   permission_manager->SetPermissionCheckHandler(handler);
 }
 
+void Session::SetPermissionCheckCacheEnabled(bool enabled) {
+  auto* permission_manager = static_cast<ElectronPermissionManager*>(
+      browser_context()->GetPermissionControllerDelegate());
+  permission_manager->SetPermissionCheckCacheEnabled(enabled);
+}
+
+void Session::ClearPermissionCheckCache() {
+  auto* permission_manager = static_cast<ElectronPermissionManager*>(
+      browser_context()->GetPermissionControllerDelegate());
+  permission_manager->ClearPermissionCheckCache();
+}
+
 void Session::SetDisplayMediaRequestHandler(v8::Isolate* isolate,
                                             v8::Local<v8::Value> val) {
   if (val->IsNull()) {
@@ -841,14 +1059,37 @@ v8::Local<v8::Promise> Session::GetBlobData(v8::Isolate* isolate,
   return holder->ReadAll(isolate);
 }
 
+v8::Local<v8::Value> Session::GetBlobDataStream(
+    v8::Isolate* isolate,
+    const std::string& uuid,
+    base::OnceCallback<void(bool)> callback) {
+  gin::Handle<DataPipeHolder> holder = DataPipeHolder::From(isolate, uuid);
+  if (holder.IsEmpty()) {
+    gin_helper::ErrorThrower(isolate).ThrowError(
+        "Could not get blob data handle");
+    return v8::Null(isolate);
+  }
+
+  return holder->ReadStream(isolate, std::move(callback));
+}
+
 void Session::DownloadURL(const GURL& url, gin::Arguments* args) {
   std::map<std::string, std::string> headers;
+  std::string sha256;
   gin_helper::Dictionary options;
   if (args->GetNext(&options)) {
     if (options.Has("headers") && !options.Get("headers", &headers)) {
       args->ThrowTypeError("Invalid value for headers - must be an object");
       return;
     }
+    std::string sha256_hex;
+    if (options.Has("sha256") &&
+        (!options.Get("sha256", &sha256_hex) || sha256_hex.size() != 64 ||
+         !base::HexStringToString(sha256_hex, &sha256))) {
+      args->ThrowTypeError(
+          "Invalid value for sha256 - must be a hex encoded SHA-256 hash");
+      return;
+    }
   }
 
   auto download_params = std::make_unique<download::DownloadUrlParameters>(
@@ -858,6 +1099,17 @@ void Session::DownloadURL(const GURL& url, gin::Arguments* args) {
     download_params->add_request_header(name, value);
   }
 
+  if (!sha256.empty()) {
+    download_params->set_callback(base::BindOnce(
+        [](std::string sha256, download::DownloadItem* item,
+           download::DownloadInterruptReason reason) {
+          if (item)
+            ElectronDownloadManagerDelegate::SetExpectedHash(item,
+                                                             std::move(sha256));
+        },
+        std::move(sha256)));
+  }
+
   auto* download_manager = browser_context()->GetDownloadManager();
   download_manager->DownloadUrl(std::move(download_params));
 }
@@ -925,18 +1177,20 @@ v8::Local<v8::Promise> Session::LoadExtension(
   }
 
   int load_flags = extensions::Extension::FOLLOW_SYMLINKS_ANYWHERE;
+  bool defer_activation = false;
   gin_helper::Dictionary options;
   if (args->GetNext(&options)) {
     bool allowFileAccess = false;
     options.Get("allowFileAccess", &allowFileAccess);
     if (allowFileAccess)
       load_flags |= extensions::Extension::ALLOW_FILE_ACCESS;
+    options.Get("deferActivation", &defer_activation);
   }
 
   auto* extension_system = static_cast<extensions::ElectronExtensionSystem*>(
       extensions::ExtensionSystem::Get(browser_context()));
   extension_system->LoadExtension(
-      extension_path, load_flags,
+      extension_path, load_flags, defer_activation,
       base::BindOnce(
           [](gin_helper::Promise<const extensions::Extension*> promise,
              const extensions::Extension* extension,
@@ -1080,6 +1334,23 @@ void Session::Preconnect(const gin_helper::Dictionary& options,
                      url, num_sockets_to_preconnect));
 }
 
+void Session::SetPreconnectPredictionEnabled(bool enabled) {
+  browser_context_->GetPreconnectPredictor()->SetEnabled(enabled);
+}
+
+void Session::SetSpareRendererCount(gin::Arguments* args) {
+  int count;
+  if (!args->GetNext(&count) || count < 0) {
+    args->ThrowTypeError("Must pass a non-negative count of spare renderers.");
+    return;
+  }
+  gin_helper::Dictionary web_preferences;
+  if (!args->GetNext(&web_preferences))
+    web_preferences = gin_helper::Dictionary::CreateEmpty(isolate_);
+  browser_context_->GetSpareRendererPool()->SetSpareCount(
+      isolate_, web_preferences, count);
+}
+
 v8::Local<v8::Promise> Session::CloseAllConnections() {
   gin_helper::Promise<void> promise(isolate_);
   auto handle = promise.GetHandle();
@@ -1111,9 +1382,22 @@ void Session::SetCodeCachePath(gin::Arguments* args) {
     }
     code_cache_context->Initialize(
         code_cache_path, 0 /* allows disk_cache to choose the size */);
+    code_cache_path_ = code_cache_path;
   }
 }
 
+v8::Local<v8::Value> Session::GetCodeCachePath(v8::Isolate* isolate) {
+  if (!code_cache_path_.empty())
+    return gin::ConvertToV8(isolate, code_cache_path_);
+  if (browser_context_->IsOffTheRecord() ||
+      !browser_context_->GetDefaultStoragePartition()
+           ->GetGeneratedCodeCacheContext()) {
+    return v8::Null(isolate);
+  }
+  return gin::ConvertToV8(isolate, browser_context_->GetPath().Append(
+                                       FILE_PATH_LITERAL("Code Cache")));
+}
+
 v8::Local<v8::Promise> Session::ClearCodeCaches(
     const gin_helper::Dictionary& options) {
   auto* isolate = JavascriptEnvironment::GetIsolate();
@@ -1356,6 +1640,7 @@ void Session::FillObjectTemplate(v8::Isolate* isolate,
                                  v8::Local<v8::ObjectTemplate> templ) {
   gin::ObjectTemplateBuilder(isolate, GetClassName(), templ)
       .SetMethod("resolveHost", &Session::ResolveHost)
+      .SetMethod("resolveHosts", &Session::ResolveHosts)
       .SetMethod("resolveProxy", &Session::ResolveProxy)
       .SetMethod("getCacheSize", &Session::GetCacheSize)
       .SetMethod("clearCache", &Session::ClearCache)
@@ -1371,6 +1656,10 @@ void Session::FillObjectTemplate(v8::Isolate* isolate,
                  &Session::SetPermissionRequestHandler)
       .SetMethod("setPermissionCheckHandler",
                  &Session::SetPermissionCheckHandler)
+      .SetMethod("setPermissionCheckCacheEnabled",
+                 &Session::SetPermissionCheckCacheEnabled)
+      .SetMethod("clearPermissionCheckCache",
+                 &Session::ClearPermissionCheckCache)
       .SetMethod("setDisplayMediaRequestHandler",
                  &Session::SetDisplayMediaRequestHandler)
       .SetMethod("setDevicePermissionHandler",
@@ -1388,6 +1677,7 @@ void Session::FillObjectTemplate(v8::Isolate* isolate,
       .SetMethod("getUserAgent", &Session::GetUserAgent)
       .SetMethod("setSSLConfig", &Session::SetSSLConfig)
       .SetMethod("getBlobData", &Session::GetBlobData)
+      .SetMethod("_getBlobDataStream", &Session::GetBlobDataStream)
       .SetMethod("downloadURL", &Session::DownloadURL)
       .SetMethod("createInterruptedDownload",
                  &Session::CreateInterruptedDownload)
@@ -1418,9 +1708,13 @@ void Session::FillObjectTemplate(v8::Isolate* isolate,
                    &Session::SetSpellCheckerEnabled)
 #endif
       .SetMethod("preconnect", &Session::Preconnect)
+      .SetMethod("setPreconnectPredictionEnabled",
+                 &Session::SetPreconnectPredictionEnabled)
+      .SetMethod("setSpareRendererCount", &Session::SetSpareRendererCount)
       .SetMethod("closeAllConnections", &Session::CloseAllConnections)
       .SetMethod("getStoragePath", &Session::GetPath)
       .SetMethod("setCodeCachePath", &Session::SetCodeCachePath)
+      .SetMethod("_getCodeCachePath", &Session::GetCodeCachePath)
       .SetMethod("clearCodeCaches", &Session::ClearCodeCaches)
       .SetMethod("clearData", &Session::ClearData)
       .SetProperty("cookies", &Session::Cookies)
@@ -1471,6 +1765,28 @@ v8::Local<v8::Value> FromPath(const base::FilePath& path,
     return v8::Null(args->isolate());
 }
 
+void SetSparePartitionCount(gin::Arguments* args) {
+  // Like the sessions they stand in for, the spare ones can't be created
+  // before the browser process is ready.
+  if (!electron::Browser::Get()->is_ready()) {
+    args->ThrowTypeError(
+        "Spare sessions can only be created when app is ready");
+    return;
+  }
+  int count = -1;
+  if (!args->GetNext(&count) || count < 0) {
+    args->ThrowTypeError("count must be a non-negative integer");
+    return;
+  }
+  ElectronBrowserContext::SetSpareContextCount(count);
+}
+
+#if DCHECK_IS_ON()
+size_t GetSparePartitionCountForTesting() {
+  return ElectronBrowserContext::GetSpareContextCountForTesting();
+}
+#endif
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -1480,6 +1796,11 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.Set("Session", Session::GetConstructor(context));
   dict.SetMethod("fromPartition", &FromPartition);
   dict.SetMethod("fromPath", &FromPath);
+  dict.SetMethod("setSparePartitionCount", &SetSparePartitionCount);
+#if DCHECK_IS_ON()
+  dict.SetMethod("_getSparePartitionCountForTesting",
+                 &GetSparePartitionCountForTesting);
+#endif
 }
 
 }  // namespace
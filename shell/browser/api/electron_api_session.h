@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "base/memory/raw_ptr.h"
+#include "base/memory/weak_ptr.h"
 #include "base/values.h"
 #include "content/public/browser/download_manager.h"
 #include "electron/buildflags/buildflags.h"
@@ -93,6 +94,8 @@ class Session : public gin::Wrappable<Session>,
 
   ElectronBrowserContext* browser_context() const { return browser_context_; }
 
+  base::WeakPtr<Session> GetWeakPtr() { return weak_factory_.GetWeakPtr(); }
+
   // gin::Wrappable
   static gin::WrapperInfo kWrapperInfo;
   static void FillObjectTemplate(v8::Isolate*, v8::Local<v8::ObjectTemplate>);
@@ -103,6 +106,8 @@ class Session : public gin::Wrappable<Session>,
   v8::Local<v8::Promise> ResolveHost(
       std::string host,
       std::optional<network::mojom::ResolveHostParametersPtr> params);
+  v8::Local<v8::Promise> ResolveHosts(std::vector<std::string> hosts,
+                                      gin::Arguments* args);
   v8::Local<v8::Promise> ResolveProxy(gin::Arguments* args);
   v8::Local<v8::Promise> GetCacheSize();
   v8::Local<v8::Promise> ClearCache();
@@ -118,6 +123,8 @@ class Session : public gin::Wrappable<Session>,
                                    gin::Arguments* args);
   void SetPermissionCheckHandler(v8::Local<v8::Value> val,
                                  gin::Arguments* args);
+  void SetPermissionCheckCacheEnabled(bool enabled);
+  void ClearPermissionCheckCache();
   void SetDevicePermissionHandler(v8::Local<v8::Value> val,
                                   gin::Arguments* args);
   void SetUSBProtectedClassesHandler(v8::Local<v8::Value> val,
@@ -133,6 +140,10 @@ class Session : public gin::Wrappable<Session>,
   bool IsPersistent();
   v8::Local<v8::Promise> GetBlobData(v8::Isolate* isolate,
                                      const std::string& uuid);
+  v8::Local<v8::Value> GetBlobDataStream(
+      v8::Isolate* isolate,
+      const std::string& uuid,
+      base::OnceCallback<void(bool)> callback);
   void DownloadURL(const GURL& url, gin::Arguments* args);
   void CreateInterruptedDownload(const gin_helper::Dictionary& options);
   void SetPreloads(const std::vector<base::FilePath>& preloads);
@@ -143,9 +154,12 @@ class Session : public gin::Wrappable<Session>,
   v8::Local<v8::Value> WebRequest(v8::Isolate* isolate);
   v8::Local<v8::Value> NetLog(v8::Isolate* isolate);
   void Preconnect(const gin_helper::Dictionary& options, gin::Arguments* args);
+  void SetPreconnectPredictionEnabled(bool enabled);
+  void SetSpareRendererCount(gin::Arguments* args);
   v8::Local<v8::Promise> CloseAllConnections();
   v8::Local<v8::Value> GetPath(v8::Isolate* isolate);
   void SetCodeCachePath(gin::Arguments* args);
+  v8::Local<v8::Value> GetCodeCachePath(v8::Isolate* isolate);
   v8::Local<v8::Promise> ClearCodeCaches(const gin_helper::Dictionary& options);
   v8::Local<v8::Promise> ClearData(gin::Arguments* args);
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
@@ -215,6 +229,11 @@ class Session : public gin::Wrappable<Session>,
   base::UnguessableToken network_emulation_token_;
 
   raw_ptr<ElectronBrowserContext> browser_context_;
+
+  // Set by SetCodeCachePath(), Chromium's default is used otherwise.
+  base::FilePath code_cache_path_;
+
+  base::WeakPtrFactory<Session> weak_factory_{this};
 };
 
 }  // namespace api
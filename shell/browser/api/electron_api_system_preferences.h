@@ -6,6 +6,7 @@
 #define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_SYSTEM_PREFERENCES_H_
 
 #include <memory>
+#include <optional>
 #include <string>
 
 #include "base/values.h"
@@ -155,6 +156,10 @@ class SystemPreferences
 
   std::string current_color_;
 
+  // The accent color, which is queried from DWM only once until
+  // WM_DWMCOLORIZATIONCOLORCHANGED reports a change.
+  std::optional<std::string> accent_color_;
+
   std::unique_ptr<gfx::ScopedSysColorChangeListener> color_change_listener_;
 #endif
 };
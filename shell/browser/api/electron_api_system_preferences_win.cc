@@ -88,6 +88,9 @@ std::string hexColorDWORDToRGBA(DWORD color) {
 }
 
 std::string SystemPreferences::GetAccentColor() {
+  if (accent_color_)
+    return *accent_color_;
+
   DWORD color = 0;
   BOOL opaque = FALSE;
 
@@ -95,7 +98,8 @@ std::string SystemPreferences::GetAccentColor() {
     return "";
   }
 
-  return hexColorDWORDToRGBA(color);
+  accent_color_ = hexColorDWORDToRGBA(color);
+  return *accent_color_;
 }
 
 std::string SystemPreferences::GetColor(gin_helper::ErrorThrower thrower,
@@ -203,6 +207,7 @@ LRESULT CALLBACK SystemPreferences::WndProc(HWND hwnd,
                                             WPARAM wparam,
                                             LPARAM lparam) {
   if (message == WM_DWMCOLORIZATIONCOLORCHANGED) {
+    accent_color_.reset();
     DWORD new_color = (DWORD)wparam;
     std::string new_color_string = hexColorDWORDToRGBA(new_color);
     if (new_color_string != current_color_) {
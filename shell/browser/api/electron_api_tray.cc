@@ -188,6 +188,8 @@ void Tray::OnDragEnded() {
 void Tray::Destroy() {
   Unpin();
   menu_.Reset();
+  image_frame_timer_.Stop();
+  image_frames_.clear();
   tray_icon_.reset();
 }
 
@@ -203,6 +205,11 @@ void Tray::SetImage(v8::Isolate* isolate, v8::Local<v8::Value> image) {
   if (!NativeImage::TryConvertNativeImage(isolate, image, &native_image))
     return;
 
+  // The image no longer is any of the frames.
+  current_image_frame_.reset();
+  pending_image_frame_.reset();
+  image_frame_timer_.Stop();
+
 #if BUILDFLAG(IS_WIN)
   tray_icon_->SetImage(native_image->GetHICON(GetSystemMetrics(SM_CXSMICON)));
 #else
@@ -210,6 +217,90 @@ void Tray::SetImage(v8::Isolate* isolate, v8::Local<v8::Value> image) {
 #endif
 }
 
+void Tray::SetImageFrames(
+    gin_helper::ErrorThrower thrower,
+    const std::vector<v8::Local<v8::Value>>& images,
+    const std::optional<gin_helper::Dictionary>& options) {
+  if (!CheckAlive())
+    return;
+
+  double min_interval = 100;
+  if (options && options->Get("minimumInterval", &min_interval) &&
+      min_interval < 0) {
+    thrower.ThrowRangeError("'minimumInterval' must not be negative");
+    return;
+  }
+
+  decltype(image_frames_) frames;
+  frames.reserve(images.size());
+  for (v8::Local<v8::Value> image : images) {
+    NativeImage* native_image = nullptr;
+    if (!NativeImage::TryConvertNativeImage(thrower.isolate(), image,
+                                            &native_image))
+      return;
+#if BUILDFLAG(IS_WIN)
+    frames.emplace_back(
+        CopyIcon(native_image->GetHICON(GetSystemMetrics(SM_CXSMICON))));
+#else
+    gfx::Image frame = native_image->image();
+#if BUILDFLAG(IS_MAC)
+    // gfx::Image keeps the NSImage it converts to, so convert it up front.
+    frame.AsNSImage();
+#endif
+    frames.push_back(std::move(frame));
+#endif
+  }
+
+  image_frames_ = std::move(frames);
+  image_frame_interval_ = base::Milliseconds(min_interval);
+  current_image_frame_.reset();
+  pending_image_frame_.reset();
+  image_frame_timer_.Stop();
+}
+
+void Tray::SetImageFrame(gin_helper::ErrorThrower thrower, int index) {
+  if (!CheckAlive())
+    return;
+  if (index < 0 || static_cast<size_t>(index) >= image_frames_.size()) {
+    thrower.ThrowRangeError("Image frame index out of range");
+    return;
+  }
+
+  if (image_frame_timer_.IsRunning()) {
+    pending_image_frame_ = index;
+    return;
+  }
+  const base::TimeDelta elapsed =
+      base::TimeTicks::Now() - last_image_frame_time_;
+  if (elapsed < image_frame_interval_) {
+    pending_image_frame_ = index;
+    image_frame_timer_.Start(FROM_HERE, image_frame_interval_ - elapsed, this,
+                             &Tray::ApplyPendingImageFrame);
+    return;
+  }
+  ApplyImageFrame(index);
+}
+
+void Tray::ApplyImageFrame(size_t index) {
+  last_image_frame_time_ = base::TimeTicks::Now();
+  if (current_image_frame_ == index)
+    return;
+  current_image_frame_ = index;
+#if BUILDFLAG(IS_WIN)
+  tray_icon_->SetImage(image_frames_[index].get());
+#else
+  tray_icon_->SetImage(image_frames_[index]);
+#endif
+}
+
+void Tray::ApplyPendingImageFrame() {
+  if (!tray_icon_ || !pending_image_frame_)
+    return;
+  size_t index = *pending_image_frame_;
+  pending_image_frame_.reset();
+  ApplyImageFrame(index);
+}
+
 void Tray::SetPressedImage(v8::Isolate* isolate, v8::Local<v8::Value> image) {
   if (!CheckAlive())
     return;
@@ -410,6 +501,8 @@ void Tray::FillObjectTemplate(v8::Isolate* isolate,
       .SetMethod("isDestroyed", &Tray::IsDestroyed)
       .SetMethod("setImage", &Tray::SetImage)
       .SetMethod("setPressedImage", &Tray::SetPressedImage)
+      .SetMethod("setImageFrames", &Tray::SetImageFrames)
+      .SetMethod("setImageFrame", &Tray::SetImageFrame)
       .SetMethod("setToolTip", &Tray::SetToolTip)
       .SetMethod("setTitle", &Tray::SetTitle)
       .SetMethod("getTitle", &Tray::GetTitle)
@@ -10,6 +10,8 @@
 #include <string>
 #include <vector>
 
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "gin/handle.h"
 #include "gin/wrappable.h"
 #include "shell/browser/event_emitter_mixin.h"
@@ -21,10 +23,11 @@
 #include "shell/common/gin_helper/constructible.h"
 #include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/pinnable.h"
+#include "ui/gfx/image/image.h"
 
-namespace gfx {
-class Image;
-}
+#if BUILDFLAG(IS_WIN)
+#include "base/win/scoped_gdi_object.h"
+#endif
 
 namespace gin_helper {
 class Dictionary;
@@ -91,6 +94,10 @@ class Tray : public gin::Wrappable<Tray>,
   bool IsDestroyed();
   void SetImage(v8::Isolate* isolate, v8::Local<v8::Value> image);
   void SetPressedImage(v8::Isolate* isolate, v8::Local<v8::Value> image);
+  void SetImageFrames(gin_helper::ErrorThrower thrower,
+                      const std::vector<v8::Local<v8::Value>>& images,
+                      const std::optional<gin_helper::Dictionary>& options);
+  void SetImageFrame(gin_helper::ErrorThrower thrower, int index);
   void SetToolTip(const std::string& tool_tip);
   void SetTitle(const std::string& title,
                 const std::optional<gin_helper::Dictionary>& options,
@@ -110,8 +117,27 @@ class Tray : public gin::Wrappable<Tray>,
 
   bool CheckAlive();
 
+  // Shows the image frame at |index| and remembers when it did.
+  void ApplyImageFrame(size_t index);
+  void ApplyPendingImageFrame();
+
   v8::Global<v8::Value> menu_;
   std::unique_ptr<TrayIcon> tray_icon_;
+
+  // Images converted once to what the platform's tray icon takes, so that
+  // switching between them doesn't convert them again.
+#if BUILDFLAG(IS_WIN)
+  std::vector<base::win::ScopedHICON> image_frames_;
+#else
+  std::vector<gfx::Image> image_frames_;
+#endif
+  std::optional<size_t> current_image_frame_;
+  std::optional<size_t> pending_image_frame_;
+  // Frames are shown at most once per |image_frame_interval_|; only the
+  // latest frame asked for in between is shown.
+  base::TimeDelta image_frame_interval_;
+  base::TimeTicks last_image_frame_time_;
+  base::OneShotTimer image_frame_timer_;
 };
 
 }  // namespace electron::api
@@ -4,8 +4,10 @@
 
 #include "shell/browser/api/electron_api_utility_process.h"
 
+#include <iterator>
 #include <map>
 #include <utility>
+#include <vector>
 
 #include "base/files/file_util.h"
 #include "base/functional/bind.h"
@@ -13,7 +15,10 @@
 #include "base/process/kill.h"
 #include "base/process/launch.h"
 #include "base/process/process.h"
+#include "base/ranges/algorithm.h"
+#include "base/task/single_thread_task_runner.h"
 #include "chrome/browser/browser_process.h"
+#include "content/public/browser/browser_child_process_host.h"
 #include "content/public/browser/child_process_host.h"
 #include "content/public/browser/service_process_host.h"
 #include "content/public/common/result_codes.h"
@@ -24,6 +29,8 @@
 #include "shell/browser/api/message_port.h"
 #include "shell/browser/javascript_environment.h"
 #include "shell/browser/net/system_network_context_manager.h"
+#include "shell/browser/spare_utility_process_pool.h"
+#include "shell/common/data_pipe_stream.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
@@ -55,6 +62,20 @@ GetAllUtilityProcessWrappers() {
 
 namespace api {
 
+namespace {
+
+bool ParsePriority(const std::string& name, base::Process::Priority* out) {
+  if (name == "normal")
+    *out = base::Process::Priority::kUserBlocking;
+  else if (name == "background")
+    *out = base::Process::Priority::kBestEffort;
+  else
+    return false;
+  return true;
+}
+
+}  // namespace
+
 gin::WrapperInfo UtilityProcessWrapper::kWrapperInfo = {
     gin::kEmbedderNativeGin};
 
@@ -64,7 +85,10 @@ UtilityProcessWrapper::UtilityProcessWrapper(
     std::map<IOHandle, IOType> stdio,
     base::EnvironmentMap env_map,
     base::FilePath current_working_directory,
-    bool use_plugin_helper) {
+    bool use_plugin_helper,
+    base::Process::Priority priority,
+    std::unique_ptr<SpareUtilityProcess> spare)
+    : priority_(priority) {
 #if BUILDFLAG(IS_WIN)
   base::win::ScopedHandle stdout_write(nullptr);
   base::win::ScopedHandle stderr_write(nullptr);
@@ -145,36 +169,43 @@ UtilityProcessWrapper::UtilityProcessWrapper(
     }
   }
 
-  mojo::PendingReceiver<node::mojom::NodeService> receiver =
-      node_service_remote_.BindNewPipeAndPassReceiver();
-
-  content::ServiceProcessHost::Launch(
-      std::move(receiver),
-      content::ServiceProcessHost::Options()
-          .WithDisplayName(display_name.empty()
-                               ? std::u16string(u"Node Utility Process")
-                               : display_name)
-          .WithExtraCommandLineSwitches(params->exec_args)
-          .WithCurrentDirectory(current_working_directory)
-          // Inherit parent process environment when there is no custom
-          // environment provided by the user.
-          .WithEnvironment(env_map,
-                           env_map.empty() ? false : true /*clear_environment*/)
+  if (spare) {
+    // The spare has launched already, but 'spawn' can only be emitted once
+    // the JS wrapper has been set up.
+    node_service_remote_ = std::move(spare->node_service);
+    base::SingleThreadTaskRunner::GetCurrentDefault()->PostTask(
+        FROM_HERE,
+        base::BindOnce(&UtilityProcessWrapper::OnServiceProcessLaunched,
+                       weak_factory_.GetWeakPtr(), std::move(spare->process)));
+  } else {
+    content::ServiceProcessHost::Launch(
+        node_service_remote_.BindNewPipeAndPassReceiver(),
+        content::ServiceProcessHost::Options()
+            .WithDisplayName(display_name.empty()
+                                 ? std::u16string(u"Node Utility Process")
+                                 : display_name)
+            .WithExtraCommandLineSwitches(params->exec_args)
+            .WithCurrentDirectory(current_working_directory)
+            // Inherit parent process environment when there is no custom
+            // environment provided by the user.
+            .WithEnvironment(
+                env_map, env_map.empty() ? false : true /*clear_environment*/)
 #if BUILDFLAG(IS_WIN)
-          .WithStdoutHandle(std::move(stdout_write))
-          .WithStderrHandle(std::move(stderr_write))
+            .WithStdoutHandle(std::move(stdout_write))
+            .WithStderrHandle(std::move(stderr_write))
 #elif BUILDFLAG(IS_POSIX)
-          .WithAdditionalFds(std::move(fds_to_remap))
+            .WithAdditionalFds(std::move(fds_to_remap))
 #endif
 #if BUILDFLAG(IS_MAC)
-          .WithChildFlags(use_plugin_helper
-                              ? content::ChildProcessHost::CHILD_PLUGIN
-                              : content::ChildProcessHost::CHILD_NORMAL)
+            .WithChildFlags(use_plugin_helper
+                                ? content::ChildProcessHost::CHILD_PLUGIN
+                                : content::ChildProcessHost::CHILD_NORMAL)
 #endif
-          .WithProcessCallback(
-              base::BindOnce(&UtilityProcessWrapper::OnServiceProcessLaunched,
-                             weak_factory_.GetWeakPtr()))
-          .Pass());
+            .WithProcessCallback(
+                base::BindOnce(&UtilityProcessWrapper::OnServiceProcessLaunched,
+                               weak_factory_.GetWeakPtr()))
+            .Pass());
+  }
   node_service_remote_.set_disconnect_with_reason_handler(
       base::BindOnce(&UtilityProcessWrapper::OnServiceProcessDisconnected,
                      weak_factory_.GetWeakPtr()));
@@ -219,7 +250,10 @@ void UtilityProcessWrapper::OnServiceProcessLaunched(
     const base::Process& process) {
   DCHECK(node_service_remote_.is_connected());
   pid_ = process.Pid();
+  process_ = process.Duplicate();
   GetAllUtilityProcessWrappers().AddWithID(this, pid_);
+  if (priority_ != base::Process::Priority::kUserBlocking)
+    ApplyPriority();
   if (stdout_read_fd_ != -1) {
     EmitWithoutEvent("stdout", stdout_read_fd_);
   }
@@ -235,6 +269,9 @@ void UtilityProcessWrapper::OnServiceProcessDisconnected(
     const std::string& description) {
   if (pid_ != base::kNullProcessId)
     GetAllUtilityProcessWrappers().Remove(pid_);
+  // The pid can be reused once the process is gone, so stop changing the
+  // priority through it.
+  process_.Close();
   CloseConnectorPort();
   // Emit 'exit' event
   EmitWithoutEvent("exit", error_code);
@@ -242,6 +279,7 @@ void UtilityProcessWrapper::OnServiceProcessDisconnected(
 }
 
 void UtilityProcessWrapper::CloseConnectorPort() {
+  regions_waiter_.Cancel();
   if (!connector_closed_ && connector_->is_valid()) {
     host_port_.GiveDisentangledHandle(connector_->PassMessagePipe());
     connector_ = nullptr;
@@ -253,6 +291,7 @@ void UtilityProcessWrapper::CloseConnectorPort() {
 void UtilityProcessWrapper::Shutdown(int exit_code) {
   if (pid_ != base::kNullProcessId)
     GetAllUtilityProcessWrappers().Remove(pid_);
+  process_.Close();
   node_service_remote_.reset();
   CloseConnectorPort();
   // Emit 'exit' event
@@ -260,6 +299,17 @@ void UtilityProcessWrapper::Shutdown(int exit_code) {
   Unpin();
 }
 
+mojo::PendingRemote<network::mojom::URLLoaderFactory>
+UtilityProcessWrapper::CreateProtocolURLLoaderFactory(
+    const std::string& scheme) {
+  mojo::PendingRemote<network::mojom::URLLoaderFactory> factory;
+  if (node_service_remote_.is_connected()) {
+    node_service_remote_->BindProtocolHandler(
+        scheme, factory.InitWithNewPipeAndPassReceiver());
+  }
+  return factory;
+}
+
 void UtilityProcessWrapper::PostMessage(gin::Arguments* args) {
   if (!node_service_remote_.is_connected())
     return;
@@ -285,16 +335,43 @@ void UtilityProcessWrapper::PostMessage(gin::Arguments* args) {
   }
 
   bool threw_exception = false;
-  transferable_message.ports = MessagePort::DisentanglePorts(
-      args->isolate(), wrapped_ports, &threw_exception);
+  std::vector<blink::MessagePortDescriptor> ports =
+      MessagePort::DisentanglePorts(args->isolate(), wrapped_ports,
+                                    &threw_exception);
   if (threw_exception)
     return;
+  // Disentangling emits the messages pending on the ports, whose listeners
+  // may have killed the process or closed the connector.
+  if (connector_closed_ || !connector_ || !node_service_remote_.is_connected())
+    return;
+  // The port that carries shared SharedArrayBuffers, if any, stays last.
+  transferable_message.ports.insert(transferable_message.ports.begin(),
+                                    std::make_move_iterator(ports.begin()),
+                                    std::make_move_iterator(ports.end()));
 
   mojo::Message mojo_message = blink::mojom::TransferableMessage::WrapAsMessage(
       std::move(transferable_message));
   connector_->Accept(&mojo_message);
 }
 
+v8::Local<v8::Value> UtilityProcessWrapper::CreateStream(
+    v8::Isolate* isolate) {
+  if (!node_service_remote_.is_connected())
+    return v8::Null(isolate);
+
+  mojo::ScopedDataPipeConsumerHandle remote_consumer;
+  mojo::ScopedDataPipeProducerHandle remote_producer;
+  auto stream =
+      DataPipeStream::CreatePair(isolate, &remote_consumer, &remote_producer);
+  if (stream.IsEmpty()) {
+    gin_helper::ErrorThrower(isolate).ThrowError("Failed to create stream.");
+    return v8::Null(isolate);
+  }
+  node_service_remote_->OpenStream(std::move(remote_consumer),
+                                   std::move(remote_producer));
+  return stream.ToV8();
+}
+
 bool UtilityProcessWrapper::Kill() const {
   if (pid_ == base::kNullProcessId)
     return false;
@@ -311,6 +388,27 @@ bool UtilityProcessWrapper::Kill() const {
   return result;
 }
 
+void UtilityProcessWrapper::SetPriority(gin::Arguments* args) {
+  std::string priority;
+  if (!args->GetNext(&priority) || !ParsePriority(priority, &priority_)) {
+    args->ThrowTypeError("priority must be one of: normal, background");
+    return;
+  }
+  if (process_.IsValid() && !ApplyPriority())
+    args->ThrowError("Failed to set the priority of the process.");
+}
+
+bool UtilityProcessWrapper::ApplyPriority() {
+  if (!base::Process::CanSetPriority())
+    return false;
+#if BUILDFLAG(IS_MAC)
+  return process_.SetPriority(
+      content::BrowserChildProcessHost::GetPortProvider(), priority_);
+#else
+  return process_.SetPriority(priority_);
+#endif
+}
+
 v8::Local<v8::Value> UtilityProcessWrapper::GetOSProcessId(
     v8::Isolate* isolate) const {
   if (pid_ == base::kNullProcessId)
@@ -325,10 +423,30 @@ bool UtilityProcessWrapper::Accept(mojo::Message* mojo_message) {
     return false;
   }
 
+  if (regions_waiter_.Wait(
+          message,
+          base::BindOnce(&UtilityProcessWrapper::OnSharedArrayBuffersArrived,
+                         base::Unretained(this)))) {
+    connector_->PauseIncomingMethodCallProcessing();
+    return true;
+  }
+  return AcceptMessage(std::move(message));
+}
+
+void UtilityProcessWrapper::OnSharedArrayBuffersArrived(
+    blink::TransferableMessage message) {
+  AcceptMessage(std::move(message));
+  // The listeners may have killed the process.
+  if (!connector_closed_ && connector_)
+    connector_->ResumeIncomingMethodCallProcessing();
+}
+
+bool UtilityProcessWrapper::AcceptMessage(
+    blink::TransferableMessage message) {
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope handle_scope(isolate);
   v8::Local<v8::Value> message_value =
-      electron::DeserializeV8Value(isolate, message);
+      electron::DeserializeV8Value(isolate, &message);
   EmitWithoutEvent("message", message_value);
   return true;
 }
@@ -351,6 +469,7 @@ gin::Handle<UtilityProcessWrapper> UtilityProcessWrapper::Create(
 
   std::u16string display_name;
   bool use_plugin_helper = false;
+  base::Process::Priority priority = base::Process::Priority::kUserBlocking;
   std::map<IOHandle, IOType> stdio;
   base::FilePath current_working_directory;
   base::EnvironmentMap env_map;
@@ -394,12 +513,32 @@ gin::Handle<UtilityProcessWrapper> UtilityProcessWrapper::Create(
 #if BUILDFLAG(IS_MAC)
     opts.Get("allowLoadingUnsignedLibraries", &use_plugin_helper);
 #endif
+
+    std::string priority_name;
+    if (opts.Get("priority", &priority_name) &&
+        !ParsePriority(priority_name, &priority)) {
+      args->ThrowTypeError("Invalid value for priority");
+      return gin::Handle<UtilityProcessWrapper>();
+    }
+  }
+  // Spares are launched with the default options, so they can only stand in
+  // for processes that would have been launched the same way.
+  std::unique_ptr<SpareUtilityProcess> spare;
+  if (params->exec_args.empty() && display_name.empty() && env_map.empty() &&
+      current_working_directory.empty() && !use_plugin_helper &&
+      base::ranges::none_of(stdio, [](const auto& entry) {
+        return entry.first != IOHandle::STDIN &&
+               entry.second != IOType::IO_INHERIT;
+      })) {
+    spare = SpareUtilityProcessPool::GetInstance()->Take();
   }
+
   auto handle = gin::CreateHandle(
       args->isolate(),
       new UtilityProcessWrapper(std::move(params), display_name,
                                 std::move(stdio), env_map,
-                                current_working_directory, use_plugin_helper));
+                                current_working_directory, use_plugin_helper,
+                                priority, std::move(spare)));
   handle->Pin(args->isolate());
   return handle;
 }
@@ -410,7 +549,9 @@ gin::ObjectTemplateBuilder UtilityProcessWrapper::GetObjectTemplateBuilder(
   return gin_helper::EventEmitterMixin<
              UtilityProcessWrapper>::GetObjectTemplateBuilder(isolate)
       .SetMethod("postMessage", &UtilityProcessWrapper::PostMessage)
+      .SetMethod("createStream", &UtilityProcessWrapper::CreateStream)
       .SetMethod("kill", &UtilityProcessWrapper::Kill)
+      .SetMethod("setPriority", &UtilityProcessWrapper::SetPriority)
       .SetProperty("pid", &UtilityProcessWrapper::GetOSProcessId);
 }
 
@@ -424,6 +565,15 @@ const char* UtilityProcessWrapper::GetTypeName() {
 
 namespace {
 
+void SetSpareCount(gin::Arguments* args) {
+  int count;
+  if (!args->GetNext(&count) || count < 0) {
+    args->ThrowTypeError("Must pass a non-negative count of spare processes.");
+    return;
+  }
+  electron::SpareUtilityProcessPool::GetInstance()->SetSpareCount(count);
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -431,6 +581,7 @@ void Initialize(v8::Local<v8::Object> exports,
   v8::Isolate* isolate = context->GetIsolate();
   gin_helper::Dictionary dict(isolate, exports);
   dict.SetMethod("_fork", &electron::api::UtilityProcessWrapper::Create);
+  dict.SetMethod("_setSpareCount", &SetSpareCount);
 }
 
 }  // namespace
@@ -12,13 +12,17 @@
 #include "base/containers/id_map.h"
 #include "base/environment.h"
 #include "base/memory/weak_ptr.h"
+#include "base/process/process.h"
 #include "base/process/process_handle.h"
 #include "gin/wrappable.h"
 #include "mojo/public/cpp/bindings/connector.h"
 #include "mojo/public/cpp/bindings/message.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
 #include "mojo/public/cpp/bindings/remote.h"
+#include "services/network/public/mojom/url_loader_factory.mojom-forward.h"
 #include "shell/browser/event_emitter_mixin.h"
 #include "shell/common/gin_helper/pinnable.h"
+#include "shell/common/v8_value_serializer.h"
 #include "shell/services/node/public/mojom/node_service.mojom.h"
 #include "v8/include/v8.h"
 
@@ -28,9 +32,9 @@ template <typename T>
 class Handle;
 }  // namespace gin
 
-namespace base {
-class Process;
-}  // namespace base
+namespace electron {
+struct SpareUtilityProcess;
+}  // namespace electron
 
 namespace electron::api {
 
@@ -49,6 +53,12 @@ class UtilityProcessWrapper
 
   void Shutdown(int exit_code);
 
+  // Returns a factory served by the handler the utility process registers for
+  // |scheme| with parentPort.handleProtocol, or an invalid remote when the
+  // process is no longer running.
+  mojo::PendingRemote<network::mojom::URLLoaderFactory>
+  CreateProtocolURLLoaderFactory(const std::string& scheme);
+
   // gin::Wrappable
   static gin::WrapperInfo kWrapperInfo;
   gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
@@ -61,20 +71,33 @@ class UtilityProcessWrapper
                         std::map<IOHandle, IOType> stdio,
                         base::EnvironmentMap env_map,
                         base::FilePath current_working_directory,
-                        bool use_plugin_helper);
+                        bool use_plugin_helper,
+                        base::Process::Priority priority,
+                        std::unique_ptr<SpareUtilityProcess> spare);
   void OnServiceProcessDisconnected(uint32_t error_code,
                                     const std::string& description);
   void OnServiceProcessLaunched(const base::Process& process);
   void CloseConnectorPort();
 
   void PostMessage(gin::Arguments* args);
+  v8::Local<v8::Value> CreateStream(v8::Isolate* isolate);
   bool Kill() const;
+  void SetPriority(gin::Arguments* args);
+  bool ApplyPriority();
   v8::Local<v8::Value> GetOSProcessId(v8::Isolate* isolate) const;
 
+  bool AcceptMessage(blink::TransferableMessage message);
+  void OnSharedArrayBuffersArrived(blink::TransferableMessage message);
+
   // mojo::MessageReceiver
   bool Accept(mojo::Message* mojo_message) override;
 
+  // Holds back the message whose SharedArrayBuffers are still on their way,
+  // with |connector_| paused so that the next ones wait behind it.
+  SharedArrayBufferRegionsWaiter regions_waiter_;
   base::ProcessId pid_ = base::kNullProcessId;
+  base::Process process_;
+  base::Process::Priority priority_;
 #if BUILDFLAG(IS_WIN)
   // Non-owning handles, these will be closed when the
   // corresponding FD are closed via _close.
@@ -16,11 +16,15 @@
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/gfx_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/object_template_builder.h"
 #include "shell/common/node_includes.h"
+#include "ui/gfx/geometry/rect_conversions.h"
 #include "ui/views/background.h"
 #include "ui/views/layout/flex_layout.h"
+#include "ui/views/layout/flex_layout_types.h"
 #include "ui/views/layout/layout_manager_base.h"
+#include "ui/views/view_class_properties.h"
 
 #if BUILDFLAG(IS_MAC)
 #include "shell/browser/animation_util.h"
@@ -122,6 +126,50 @@ struct Converter<views::FlexAllocationOrder> {
   }
 };
 
+template <>
+struct Converter<views::MinimumFlexSizeRule> {
+  static bool FromV8(v8::Isolate* isolate,
+                     v8::Local<v8::Value> val,
+                     views::MinimumFlexSizeRule* out) {
+    std::string rule = base::ToLowerASCII(gin::V8ToString(isolate, val));
+    if (rule == "preferred") {
+      *out = views::MinimumFlexSizeRule::kPreferred;
+    } else if (rule == "preferredsnaptominimum") {
+      *out = views::MinimumFlexSizeRule::kPreferredSnapToMinimum;
+    } else if (rule == "preferredsnaptozero") {
+      *out = views::MinimumFlexSizeRule::kPreferredSnapToZero;
+    } else if (rule == "scaletominimum") {
+      *out = views::MinimumFlexSizeRule::kScaleToMinimum;
+    } else if (rule == "scaletominimumsnaptozero") {
+      *out = views::MinimumFlexSizeRule::kScaleToMinimumSnapToZero;
+    } else if (rule == "scaletozero") {
+      *out = views::MinimumFlexSizeRule::kScaleToZero;
+    } else {
+      return false;
+    }
+    return true;
+  }
+};
+
+template <>
+struct Converter<views::MaximumFlexSizeRule> {
+  static bool FromV8(v8::Isolate* isolate,
+                     v8::Local<v8::Value> val,
+                     views::MaximumFlexSizeRule* out) {
+    std::string rule = base::ToLowerASCII(gin::V8ToString(isolate, val));
+    if (rule == "preferred") {
+      *out = views::MaximumFlexSizeRule::kPreferred;
+    } else if (rule == "scaletomaximum") {
+      *out = views::MaximumFlexSizeRule::kScaleToMaximum;
+    } else if (rule == "unbounded") {
+      *out = views::MaximumFlexSizeRule::kUnbounded;
+    } else {
+      return false;
+    }
+    return true;
+  }
+};
+
 template <>
 struct Converter<views::SizeBound> {
   static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
@@ -226,6 +274,7 @@ void View::RemoveChildView(gin::Handle<View> child) {
 void View::SetBounds(const gfx::Rect& bounds) {
   if (!view_)
     return;
+  auto_resize_bounds_.reset();
   view_->SetBoundsRect(bounds);
 }
 
@@ -280,6 +329,87 @@ void View::SetLayout(v8::Isolate* isolate, v8::Local<v8::Object> value) {
   }
 }
 
+void View::SetAutoResize(const gin_helper::Dictionary& options) {
+  AutoResizeFlags flags;
+  options.Get("width", &flags.width);
+  options.Get("height", &flags.height);
+  options.Get("horizontal", &flags.horizontal);
+  options.Get("vertical", &flags.vertical);
+  auto_resize_ = flags;
+  auto_resize_bounds_.reset();
+}
+
+void View::AutoResize(const gfx::Size& old_size, const gfx::Size& new_size) {
+  if (!view_)
+    return;
+  if (!auto_resize_.width && !auto_resize_.height &&
+      !auto_resize_.horizontal && !auto_resize_.vertical)
+    return;
+
+  gfx::RectF bounds =
+      auto_resize_bounds_.value_or(gfx::RectF(view_->bounds()));
+  if (auto_resize_.horizontal) {
+    float scale = static_cast<float>(new_size.width()) / old_size.width();
+    bounds.set_x(bounds.x() * scale);
+    bounds.set_width(bounds.width() * scale);
+  } else if (auto_resize_.width) {
+    bounds.set_width(std::max(
+        0.f, bounds.width() + new_size.width() - old_size.width()));
+  }
+  if (auto_resize_.vertical) {
+    float scale = static_cast<float>(new_size.height()) / old_size.height();
+    bounds.set_y(bounds.y() * scale);
+    bounds.set_height(bounds.height() * scale);
+  } else if (auto_resize_.height) {
+    bounds.set_height(std::max(
+        0.f, bounds.height() + new_size.height() - old_size.height()));
+  }
+  auto_resize_bounds_ = bounds;
+  view_->SetBoundsRect(gfx::ToRoundedRect(bounds));
+}
+
+void View::SetFlex(const gin_helper::Dictionary& options) {
+  if (!view_)
+    return;
+  views::MinimumFlexSizeRule minimum_size =
+      views::MinimumFlexSizeRule::kScaleToZero;
+  options.Get("minimumSize", &minimum_size);
+  views::MaximumFlexSizeRule maximum_size =
+      views::MaximumFlexSizeRule::kUnbounded;
+  options.Get("maximumSize", &maximum_size);
+  views::FlexSpecification flex(minimum_size, maximum_size);
+
+  int weight;
+  if (options.Get("weight", &weight)) {
+    if (weight < 0) {
+      gin_helper::ErrorThrower(options.isolate())
+          .ThrowRangeError("'weight' must not be negative");
+      return;
+    }
+    flex = flex.WithWeight(weight);
+  }
+  int order;
+  if (options.Get("order", &order))
+    flex = flex.WithOrder(order);
+  views::LayoutAlignment alignment;
+  if (options.Get("alignment", &alignment))
+    flex = flex.WithAlignment(alignment);
+
+  // Setting layout properties only invalidates the layout, so all the
+  // changes made before the next frame are applied in a single layout pass.
+  view_->SetProperty(views::kFlexBehaviorKey, flex);
+  gfx::Insets margin;
+  if (options.Get("margin", &margin))
+    view_->SetProperty(views::kMarginsKey, margin);
+  view_->InvalidateLayout();
+}
+
+void View::SetPreferredSize(const gfx::Size& size) {
+  if (!view_)
+    return;
+  view_->SetPreferredSize(size);
+}
+
 std::vector<v8::Local<v8::Value>> View::GetChildren() {
   std::vector<v8::Local<v8::Value>> ret;
   ret.reserve(child_views_.size());
@@ -305,6 +435,19 @@ void View::SetVisible(bool visible) {
 }
 
 void View::OnViewBoundsChanged(views::View* observed_view) {
+  // Lay out the children that follow the view natively, rather than leaving
+  // it to a "bounds-changed" handler.
+  const gfx::Size size = view_->size();
+  if (size != last_size_ && !last_size_.IsEmpty()) {
+    v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+    v8::HandleScope handle_scope(isolate);
+    for (auto& child_view : child_views_) {
+      gin::Handle<View> child;
+      if (gin::ConvertFromV8(isolate, child_view.Get(isolate), &child))
+        child->AutoResize(last_size_, size);
+    }
+  }
+  last_size_ = size;
   Emit("bounds-changed");
 }
 
@@ -354,6 +497,9 @@ void View::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("getBounds", &View::GetBounds)
       .SetMethod("setBackgroundColor", &View::SetBackgroundColor)
       .SetMethod("setLayout", &View::SetLayout)
+      .SetMethod("setAutoResize", &View::SetAutoResize)
+      .SetMethod("setFlex", &View::SetFlex)
+      .SetMethod("setPreferredSize", &View::SetPreferredSize)
       .SetMethod("setVisible", &View::SetVisible);
 }
 
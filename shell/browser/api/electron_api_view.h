@@ -11,10 +11,15 @@
 #include "gin/handle.h"
 #include "shell/common/color_util.h"
 #include "shell/common/gin_helper/event_emitter.h"
+#include "ui/gfx/geometry/rect_f.h"
 #include "ui/views/view.h"
 #include "ui/views/view_observer.h"
 #include "v8/include/v8-value.h"
 
+namespace gin_helper {
+class Dictionary;
+}
+
 namespace electron::api {
 
 class View : public gin_helper::EventEmitter<View>, public views::ViewObserver {
@@ -34,6 +39,9 @@ class View : public gin_helper::EventEmitter<View>, public views::ViewObserver {
   void SetBounds(const gfx::Rect& bounds);
   gfx::Rect GetBounds();
   void SetLayout(v8::Isolate* isolate, v8::Local<v8::Object> value);
+  void SetAutoResize(const gin_helper::Dictionary& options);
+  void SetFlex(const gin_helper::Dictionary& options);
+  void SetPreferredSize(const gfx::Size& size);
   std::vector<v8::Local<v8::Value>> GetChildren();
   void SetBackgroundColor(std::optional<WrappedSkColor> color);
   void SetVisible(bool visible);
@@ -57,8 +65,26 @@ class View : public gin_helper::EventEmitter<View>, public views::ViewObserver {
   void set_delete_view(bool should) { delete_view_ = should; }
 
  private:
+  // Which edges of the view follow its parent when the parent is resized.
+  struct AutoResizeFlags {
+    bool width = false;
+    bool height = false;
+    bool horizontal = false;
+    bool vertical = false;
+  };
+
+  // Moves and resizes the view after its parent was resized from |old_size|
+  // to |new_size|, according to |auto_resize_|.
+  void AutoResize(const gfx::Size& old_size, const gfx::Size& new_size);
+
   std::vector<v8::Global<v8::Object>> child_views_;
 
+  AutoResizeFlags auto_resize_;
+  // The bounds before rounding, so that repeated proportional resizes don't
+  // accumulate rounding errors. Reset whenever the bounds are set from JS.
+  std::optional<gfx::RectF> auto_resize_bounds_;
+  gfx::Size last_size_;
+
   bool delete_view_ = true;
   raw_ptr<views::View> view_ = nullptr;
 };
@@ -4,7 +4,9 @@
 
 #include "shell/browser/api/electron_api_web_contents.h"
 
+#include <algorithm>
 #include <limits>
+#include <map>
 #include <memory>
 #include <optional>
 #include <set>
@@ -18,11 +20,16 @@
 #include "base/containers/id_map.h"
 #include "base/files/file_util.h"
 #include "base/json/json_reader.h"
+#include "base/memory/ref_counted.h"
 #include "base/no_destructor.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/current_thread.h"
 #include "base/task/thread_pool.h"
 #include "base/threading/scoped_blocking_call.h"
+#include "base/timer/elapsed_timer.h"
+#include "base/trace_event/trace_event.h"
 #include "base/values.h"
 #include "chrome/browser/browser_process.h"
 #include "chrome/browser/picture_in_picture/picture_in_picture_window_manager.h"
@@ -46,6 +53,7 @@
 #include "content/public/browser/download_request_utils.h"
 #include "content/public/browser/favicon_status.h"
 #include "content/public/browser/file_select_listener.h"
+#include "content/public/browser/mhtml_generation_result.h"
 #include "content/public/browser/navigation_details.h"
 #include "content/public/browser/navigation_entry.h"
 #include "content/public/browser/navigation_handle.h"
@@ -59,6 +67,7 @@
 #include "content/public/browser/storage_partition.h"
 #include "content/public/browser/web_contents.h"
 #include "content/public/common/input/native_web_keyboard_event.h"
+#include "content/public/common/mhtml_generation_params.h"
 #include "content/public/common/referrer_type_converters.h"
 #include "content/public/common/result_codes.h"
 #include "content/public/common/webplugininfo.h"
@@ -70,9 +79,12 @@
 #include "gin/object_template_builder.h"
 #include "gin/wrappable.h"
 #include "media/base/mime_util.h"
+#include "media/media_buildflags.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
+#include "mojo/public/cpp/bindings/callback_helpers.h"
 #include "mojo/public/cpp/bindings/pending_receiver.h"
 #include "mojo/public/cpp/bindings/remote.h"
+#include "mojo/public/cpp/system/data_pipe.h"
 #include "mojo/public/cpp/system/platform_handle.h"
 #include "ppapi/buildflags/buildflags.h"
 #include "printing/buildflags/buildflags.h"
@@ -92,15 +104,20 @@
 #include "shell/browser/electron_browser_main_parts.h"
 #include "shell/browser/electron_navigation_throttle.h"
 #include "shell/browser/file_select_helper.h"
+#include "shell/browser/frame_rate_throttler.h"
 #include "shell/browser/native_window.h"
 #include "shell/browser/osr/osr_render_widget_host_view.h"
 #include "shell/browser/osr/osr_web_contents_view.h"
 #include "shell/browser/session_preferences.h"
+#include "shell/browser/spare_renderer_pool.h"
 #include "shell/browser/ui/drag_util.h"
 #include "shell/browser/ui/file_dialog.h"
 #include "shell/browser/ui/inspectable_web_contents.h"
 #include "shell/browser/ui/inspectable_web_contents_view.h"
+#include "shell/browser/web_contents_hibernation_controller.h"
+#include "shell/browser/web_contents_memory_budget_controller.h"
 #include "shell/browser/web_contents_permission_helper.h"
+#include "shell/browser/web_contents_preconnect_helper.h"
 #include "shell/browser/web_contents_preferences.h"
 #include "shell/browser/web_contents_zoom_controller.h"
 #include "shell/browser/web_view_guest_delegate.h"
@@ -108,7 +125,9 @@
 #include "shell/common/api/electron_api_native_image.h"
 #include "shell/common/api/electron_bindings.h"
 #include "shell/common/color_util.h"
+#include "shell/common/data_pipe_stream.h"
 #include "shell/common/electron_constants.h"
+#include "shell/common/electron_histograms.h"
 #include "shell/common/gin_converters/base_converter.h"
 #include "shell/common/gin_converters/blink_converter.h"
 #include "shell/common/gin_converters/callback_converter.h"
@@ -122,6 +141,7 @@
 #include "shell/common/gin_converters/optional_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/event_emitter_caller.h"
 #include "shell/common/gin_helper/object_template_builder.h"
 #include "shell/common/language_util.h"
 #include "shell/common/node_includes.h"
@@ -340,6 +360,30 @@ struct Converter<electron::api::WebContents::Type> {
   }
 };
 
+template <>
+struct Converter<electron::api::WebContents::BackgroundThrottlingPolicy> {
+  using Val = electron::api::WebContents::BackgroundThrottlingPolicy;
+  static constexpr auto Lookup =
+      base::MakeFixedFlatMap<std::string_view, Val>({
+          {"capFrameRate", Val::kCapFrameRate},
+          {"freeze", Val::kFreeze},
+          {"live", Val::kLive},
+          {"throttle", Val::kThrottle},
+      });
+
+  static v8::Local<v8::Value> ToV8(v8::Isolate* isolate, Val val) {
+    for (const auto& [name, policy] : Lookup) {
+      if (policy == val)
+        return StringToV8(isolate, name);
+    }
+    return v8::Undefined(isolate);
+  }
+
+  static bool FromV8(v8::Isolate* isolate, v8::Local<v8::Value> val, Val* out) {
+    return FromV8WithLookup(isolate, val, Lookup, out);
+  }
+};
+
 template <>
 struct Converter<scoped_refptr<content::DevToolsAgentHost>> {
   static v8::Local<v8::Value> ToV8(
@@ -495,6 +539,16 @@ base::IDMap<WebContents*>& GetAllWebContents() {
   return *s_all_web_contents;
 }
 
+// Dispatchers for the channels handled by ipcMain.handle(), which Invoke()
+// calls directly instead of emitting '-ipc-invoke'.
+using InvokeHandlerMap =
+    std::map<std::string, v8::Global<v8::Function>, std::less<>>;
+
+InvokeHandlerMap& GetInvokeHandlers() {
+  static base::NoDestructor<InvokeHandlerMap> s_invoke_handlers;
+  return *s_invoke_handlers;
+}
+
 void OnCapturePageDone(gin_helper::Promise<gfx::Image> promise,
                        base::ScopedClosureRunner capture_handle,
                        const SkBitmap& bitmap) {
@@ -630,6 +684,9 @@ const void* kElectronApiWebContentsKey = &kElectronApiWebContentsKey;
 
 const char kRootName[] = "<root>";
 
+// The getIpcStats() entry of the channels past the limit.
+const char kOtherIpcChannels[] = "(other)";
+
 struct FileSystem {
   FileSystem() = default;
   FileSystem(const std::string& type,
@@ -748,6 +805,70 @@ content::RenderFrameHost* GetRenderFrameHost(
 
   return frame_host;
 }
+
+#if BUILDFLAG(ENABLE_LIBVPX)
+using EncodedChunkCallback =
+    base::RepeatingCallback<void(v8::Local<v8::Value>, v8::Local<v8::Value>)>;
+
+void OnEncodedFrame(const EncodedChunkCallback& callback,
+                    media::VideoEncoderOutput output) {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  auto chunk =
+      node::Buffer::Copy(isolate,
+                         reinterpret_cast<const char*>(output.data.get()),
+                         output.size)
+          .ToLocalChecked();
+  callback.Run(chunk,
+               gin::DataObjectBuilder(isolate)
+                   .Set("keyFrame", output.key_frame)
+                   .Set("timestamp", output.timestamp.InMillisecondsF())
+                   .Build());
+}
+#endif
+
+using VideoFrameCallback =
+    base::RepeatingCallback<void(const gfx::Image&,
+                                 const gfx::Rect&,
+                                 v8::Local<v8::Value>)>;
+
+void OnVideoFrameCaptured(const VideoFrameCallback& callback,
+                          scoped_refptr<media::VideoFrame> frame,
+                          const gfx::Rect& content_rect) {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+
+  // Pack the visible part of each plane one after another without padding, so
+  // the buffer is laid out the way most YUV consumers expect it.
+  const media::VideoPixelFormat format = frame->format();
+  const gfx::Size size = frame->visible_rect().size();
+  const size_t planes = media::VideoFrame::NumPlanes(format);
+  size_t byte_length = 0;
+  for (size_t plane = 0; plane < planes; ++plane) {
+    byte_length += media::VideoFrame::Rows(plane, format, size.height()) *
+                   media::VideoFrame::RowBytes(plane, format, size.width());
+  }
+  auto data = node::Buffer::New(isolate, byte_length).ToLocalChecked();
+  char* out = node::Buffer::Data(data);
+  for (size_t plane = 0; plane < planes; ++plane) {
+    const int rows = media::VideoFrame::Rows(plane, format, size.height());
+    const int row_bytes =
+        media::VideoFrame::RowBytes(plane, format, size.width());
+    const uint8_t* in = frame->visible_data(plane);
+    for (int row = 0; row < rows; ++row) {
+      memcpy(out, in, row_bytes);
+      out += row_bytes;
+      in += frame->stride(plane);
+    }
+  }
+
+  callback.Run(gfx::Image(), gfx::Rect(content_rect.size()),
+               gin::DataObjectBuilder(isolate)
+                   .Set("format", "i420")
+                   .Set("size", size)
+                   .Set("data", data)
+                   .Build());
+}
 }  // namespace
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
@@ -832,7 +953,10 @@ WebContents::WebContents(v8::Isolate* isolate,
 #endif
 {
   // Read options.
-  options.Get("backgroundThrottling", &background_throttling_);
+  bool background_throttling = true;
+  options.Get("backgroundThrottling", &background_throttling);
+  if (!background_throttling)
+    background_throttling_policy_ = BackgroundThrottlingPolicy::kLive;
 
   // Get type
   options.Get("type", &type_);
@@ -844,6 +968,14 @@ WebContents::WebContents(v8::Isolate* isolate,
   if (options.Get(options::kOffscreen, &b) && b)
     type_ = Type::kOffScreen;
 
+  gin_helper::Dictionary offscreen_options;
+  if (options.Get(options::kOffscreen, &offscreen_options)) {
+    offscreen_options.Get("useSharedMemory", &offscreen_use_shared_memory_);
+    offscreen_options.Get("useSharedTexture", &offscreen_use_shared_texture_);
+    offscreen_options.Get("dirtyRectOnly", &offscreen_dirty_rect_only_);
+    offscreen_options.Get("adaptiveFrameRate", &offscreen_adaptive_frame_rate_);
+  }
+
   // Init embedder earlier
   options.Get("embedder", &embedder_);
 
@@ -878,8 +1010,9 @@ WebContents::WebContents(v8::Isolate* isolate,
 
     if (embedder_ && embedder_->IsOffScreen()) {
       auto* view = new OffScreenWebContentsView(
-          false,
-          base::BindRepeating(&WebContents::OnPaint, base::Unretained(this)));
+          OffScreenRenderOptions(),
+          base::BindRepeating(&WebContents::OnPaint, base::Unretained(this)),
+          OnSharedPaintCallback());
       params.view = view;
       params.delegate_view = view;
 
@@ -898,17 +1031,32 @@ WebContents::WebContents(v8::Isolate* isolate,
 
     content::WebContents::CreateParams params(session->browser_context());
     auto* view = new OffScreenWebContentsView(
-        transparent,
-        base::BindRepeating(&WebContents::OnPaint, base::Unretained(this)));
+        OffScreenRenderOptions{
+            .transparent = transparent,
+            .shared_texture = offscreen_use_shared_texture_,
+            .dirty_rect_only = offscreen_dirty_rect_only_,
+            .adaptive_frame_rate = offscreen_adaptive_frame_rate_},
+        base::BindRepeating(&WebContents::OnPaint, base::Unretained(this)),
+        offscreen_use_shared_memory_ || offscreen_use_shared_texture_
+            ? base::BindRepeating(&WebContents::OnSharedPaint,
+                                  base::Unretained(this))
+            : OnSharedPaintCallback());
     params.view = view;
     params.delegate_view = view;
 
     web_contents = content::WebContents::Create(params);
     view->SetWebContents(web_contents.get());
   } else {
-    content::WebContents::CreateParams params(session->browser_context());
-    params.initially_hidden = !initially_shown;
-    web_contents = content::WebContents::Create(params);
+    web_contents = session->browser_context()->GetSpareRendererPool()->Take(
+        isolate, options);
+    if (web_contents) {
+      if (initially_shown)
+        web_contents->WasShown();
+    } else {
+      content::WebContents::CreateParams params(session->browser_context());
+      params.initially_hidden = !initially_shown;
+      web_contents = content::WebContents::Create(params);
+    }
   }
 
   InitWithSessionAndOptions(isolate, std::move(web_contents), session, options);
@@ -984,6 +1132,7 @@ void WebContents::InitWithSessionAndOptions(
   web_contents()->NotifyPreferencesChanged();
 
   WebContentsPermissionHelper::CreateForWebContents(web_contents());
+  WebContentsPreconnectHelper::CreateForWebContents(web_contents());
   InitZoomController(web_contents(), options);
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   extensions::ElectronExtensionWebContentsObserver::CreateForWebContents(
@@ -1061,6 +1210,9 @@ WebContents::~WebContents() {
   if (owner_window_) {
     owner_window_->RemoveBackgroundThrottlingSource(this);
   }
+  if (throttled_frame_sink_id_)
+    FrameRateThrottler::GetInstance()->ClearFrameRate(
+        *throttled_frame_sink_id_);
   if (web_contents()) {
     content::RenderViewHost* host = web_contents()->GetRenderViewHost();
     if (host)
@@ -1512,7 +1664,10 @@ void WebContents::FindReply(content::WebContents* web_contents,
                             const gfx::Rect& selection_rect,
                             int active_match_ordinal,
                             bool final_update) {
-  if (!final_update)
+  // Blink counts matches in chunks and reports after each of them, only pass
+  // those partial counts on when the request asked for them.
+  if (!final_update &&
+      static_cast<uint32_t>(request_id) != find_in_page_progress_request_id_)
     return;
 
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
@@ -1677,13 +1832,18 @@ void WebContents::HandleNewRenderFrame(
   if (web_preferences)
     SetBackgroundColor(web_preferences->GetBackgroundColor());
 
-  if (!background_throttling_)
+  bool background_throttling = GetBackgroundThrottling();
+  if (!background_throttling)
     render_frame_host->GetRenderViewHost()->SetSchedulerThrottling(false);
 
   auto* rwh_impl =
       static_cast<content::RenderWidgetHostImpl*>(rwhv->GetRenderWidgetHost());
   if (rwh_impl)
-    rwh_impl->disable_hidden_ = !background_throttling_;
+    rwh_impl->disable_hidden_ = !background_throttling;
+
+  // A new renderer has a frame sink of its own.
+  if (backgrounded_)
+    UpdateThrottledFrameSink();
 
   auto* web_frame = WebFrameMain::FromRenderFrameHost(render_frame_host);
   if (web_frame)
@@ -1790,6 +1950,13 @@ void WebContents::RenderViewDeleted(content::RenderViewHost* render_view_host) {
 
 void WebContents::PrimaryMainFrameRenderProcessGone(
     base::TerminationStatus status) {
+  // A renderer that was shut down to hibernate the page didn't go away on
+  // its own, and comes back when the page is shown again.
+  auto* hibernation_controller =
+      WebContentsHibernationController::FromWebContents(web_contents());
+  if (hibernation_controller && hibernation_controller->is_discarded())
+    return;
+
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope handle_scope(isolate);
   auto details = gin_helper::Dictionary::CreateEmpty(isolate);
@@ -1942,26 +2109,113 @@ bool WebContents::EmitNavigationEvent(
 
 void WebContents::Message(bool internal,
                           const std::string& channel,
-                          blink::CloneableMessage arguments,
+                          mojom::SerializedArgumentsPtr arguments,
                           content::RenderFrameHost* render_frame_host) {
   TRACE_EVENT1("electron", "WebContents::Message", "channel", channel);
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  base::ElapsedTimer timer;
+  v8::Local<v8::Value> args = electron::DeserializeV8Value(isolate, *arguments);
+  RecordIpcReceived(channel, electron::GetSerializedSize(*arguments),
+                    timer, arguments->send_time);
   // webContents.emit('-ipc-message', new Event(), internal, channel,
   // arguments);
   EmitWithSender("-ipc-message", render_frame_host,
                  electron::mojom::ElectronApiIPC::InvokeCallback(), internal,
-                 channel, std::move(arguments));
+                 channel, args);
+  histograms::RecordIpcDispatchTime(timer.Elapsed());
 }
 
 void WebContents::Invoke(
     bool internal,
     const std::string& channel,
-    blink::CloneableMessage arguments,
+    mojom::SerializedArgumentsPtr arguments,
     electron::mojom::ElectronApiIPC::InvokeCallback callback,
     content::RenderFrameHost* render_frame_host) {
   TRACE_EVENT1("electron", "WebContents::Invoke", "channel", channel);
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  base::ElapsedTimer timer;
+  v8::Local<v8::Value> args = electron::DeserializeV8Value(isolate, *arguments);
+  RecordIpcReceived(channel, electron::GetSerializedSize(*arguments),
+                    timer, arguments->send_time);
+  if (!internal) {
+    const InvokeHandlerMap& handlers = GetInvokeHandlers();
+    if (auto iter = handlers.find(channel); iter != handlers.end()) {
+      gin::Handle<gin_helper::internal::Event> event = MakeEventWithSender(
+          isolate, render_frame_host, std::move(callback));
+      if (event.IsEmpty())
+        return;
+      // dispatcher.call(webContents, new Event(), arguments);
+      gin_helper::internal::ValueVector dispatcher_args = {event.ToV8(), args};
+      gin_helper::internal::CallFunctionWithArgs(
+          isolate, GetWrapper(isolate).ToLocalChecked(),
+          iter->second.Get(isolate), &dispatcher_args);
+      histograms::RecordIpcDispatchTime(timer.Elapsed());
+      return;
+    }
+  }
   // webContents.emit('-ipc-invoke', new Event(), internal, channel, arguments);
   EmitWithSender("-ipc-invoke", render_frame_host, std::move(callback),
-                 internal, channel, std::move(arguments));
+                 internal, channel, args);
+  histograms::RecordIpcDispatchTime(timer.Elapsed());
+}
+
+WebContents::IpcChannelStats& WebContents::GetIpcChannelStats(
+    const std::string& channel) {
+  // How many channels are counted on their own.
+  constexpr size_t kMaxIpcStatsChannels = 256;
+  auto it = ipc_stats_.find(channel);
+  if (it != ipc_stats_.end())
+    return it->second;
+  if (ipc_stats_.size() >= kMaxIpcStatsChannels)
+    return ipc_stats_[kOtherIpcChannels];
+  return ipc_stats_[channel];
+}
+
+void WebContents::RecordIpcReceived(
+    const std::string& channel,
+    size_t bytes,
+    const base::ElapsedTimer& deserialize_timer,
+    std::optional<base::TimeTicks> send_time) {
+  IpcChannelStats& stats = GetIpcChannelStats(channel);
+  stats.received_count++;
+  stats.received_bytes += bytes;
+  stats.deserialize_time += deserialize_timer.Elapsed();
+  if (send_time && !send_time->is_null()) {
+    stats.queueing_delay += std::max(
+        deserialize_timer.start_time() - *send_time, base::TimeDelta());
+  }
+  ipc_received_bytes_ += bytes;
+  TRACE_COUNTER_ID1("electron", "IPC bytes received", id_,
+                    ipc_received_bytes_);
+}
+
+void WebContents::RecordIpcSent(const std::string& channel,
+                                size_t bytes,
+                                base::TimeDelta serialize_time) {
+  IpcChannelStats& stats = GetIpcChannelStats(channel);
+  stats.sent_count++;
+  stats.sent_bytes += bytes;
+  stats.serialize_time += serialize_time;
+  ipc_sent_bytes_ += bytes;
+  TRACE_COUNTER_ID1("electron", "IPC bytes sent", id_, ipc_sent_bytes_);
+}
+
+v8::Local<v8::Value> WebContents::GetIpcStats(v8::Isolate* isolate) const {
+  auto dict = gin_helper::Dictionary::CreateEmpty(isolate);
+  for (const auto& [channel, stats] : ipc_stats_) {
+    auto entry = gin_helper::Dictionary::CreateEmpty(isolate);
+    entry.Set("receivedCount", static_cast<double>(stats.received_count));
+    entry.Set("receivedBytes", static_cast<double>(stats.received_bytes));
+    entry.Set("sentCount", static_cast<double>(stats.sent_count));
+    entry.Set("sentBytes", static_cast<double>(stats.sent_bytes));
+    entry.Set("serializeTime", stats.serialize_time.InMillisecondsF());
+    entry.Set("deserializeTime", stats.deserialize_time.InMillisecondsF());
+    entry.Set("queueingDelay", stats.queueing_delay.InMillisecondsF());
+    dict.Set(channel, entry);
+  }
+  return dict.GetHandle();
 }
 
 void WebContents::OnFirstNonEmptyLayout(
@@ -2075,20 +2329,34 @@ void WebContents::MessageSync(
     electron::mojom::ElectronApiIPC::MessageSyncCallback callback,
     content::RenderFrameHost* render_frame_host) {
   TRACE_EVENT1("electron", "WebContents::MessageSync", "channel", channel);
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  base::ElapsedTimer timer;
+  v8::Local<v8::Value> args = electron::DeserializeV8Value(isolate, arguments);
+  RecordIpcReceived(channel, arguments.encoded_message.size(), timer,
+                    std::nullopt);
   // webContents.emit('-ipc-message-sync', new Event(sender, message), internal,
   // channel, arguments);
   EmitWithSender("-ipc-message-sync", render_frame_host, std::move(callback),
-                 internal, channel, std::move(arguments));
+                 internal, channel, args);
+  histograms::RecordIpcDispatchTime(timer.Elapsed());
 }
 
 void WebContents::MessageHost(const std::string& channel,
                               blink::CloneableMessage arguments,
                               content::RenderFrameHost* render_frame_host) {
   TRACE_EVENT1("electron", "WebContents::MessageHost", "channel", channel);
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  base::ElapsedTimer timer;
+  v8::Local<v8::Value> args = electron::DeserializeV8Value(isolate, arguments);
+  RecordIpcReceived(channel, arguments.encoded_message.size(), timer,
+                    std::nullopt);
   // webContents.emit('ipc-message-host', new Event(), channel, args);
   EmitWithSender("ipc-message-host", render_frame_host,
                  electron::mojom::ElectronApiIPC::InvokeCallback(), channel,
-                 std::move(arguments));
+                 args);
+  histograms::RecordIpcDispatchTime(timer.Elapsed());
 }
 
 void WebContents::UpdateDraggableRegions(
@@ -2345,16 +2613,106 @@ void WebContents::NavigationEntryCommitted(
 }
 
 bool WebContents::GetBackgroundThrottling() const {
-  return background_throttling_;
+  // The page is only hidden by Chromium when it may be throttled; otherwise
+  // it keeps rendering, and so does its window.
+  return background_throttling_policy_ ==
+             BackgroundThrottlingPolicy::kThrottle ||
+         background_throttling_policy_ == BackgroundThrottlingPolicy::kFreeze;
 }
 
 void WebContents::SetBackgroundThrottling(bool allowed) {
-  background_throttling_ = allowed;
+  SetBackgrounded(false);
+  background_throttling_policy_ = allowed
+                                      ? BackgroundThrottlingPolicy::kThrottle
+                                      : BackgroundThrottlingPolicy::kLive;
+  background_throttling_when_occluded_ = false;
+  UpdateBackgroundThrottling();
+}
+
+void WebContents::SetBackgroundThrottlingPolicy(gin::Arguments* args) {
+  BackgroundThrottlingPolicy policy;
+  if (!args->GetNext(&policy)) {
+    args->ThrowTypeError(
+        "Expected 'live', 'capFrameRate', 'throttle' or 'freeze'");
+    return;
+  }
+
+  int frame_rate = 1;
+  bool when_occluded = false;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options)) {
+    if (options.Has("frameRate") &&
+        (!options.Get("frameRate", &frame_rate) || frame_rate < 1 ||
+         frame_rate > 240)) {
+      args->ThrowTypeError("'frameRate' must be a number between 1 and 240");
+      return;
+    }
+    options.Get("whenOccluded", &when_occluded);
+  }
+
+  // Undo what the previous policy applied before switching.
+  SetBackgrounded(false);
+  background_throttling_policy_ = policy;
+  background_frame_rate_ = frame_rate;
+  background_throttling_when_occluded_ = when_occluded;
+  UpdateBackgroundThrottling();
+}
+
+void WebContents::OnVisibilityChanged(content::Visibility visibility) {
+  UpdateBackgrounded();
+}
+
+void WebContents::UpdateBackgrounded() {
+  content::Visibility visibility = web_contents()->GetVisibility();
+  SetBackgrounded(visibility == content::Visibility::HIDDEN ||
+                  (background_throttling_when_occluded_ &&
+                   visibility == content::Visibility::OCCLUDED));
+}
+
+void WebContents::SetBackgrounded(bool backgrounded) {
+  if (backgrounded_ == backgrounded)
+    return;
+  backgrounded_ = backgrounded;
+
+  switch (background_throttling_policy_) {
+    case BackgroundThrottlingPolicy::kCapFrameRate:
+      UpdateThrottledFrameSink();
+      break;
+    case BackgroundThrottlingPolicy::kFreeze:
+      web_contents()->SetPageFrozen(backgrounded);
+      break;
+    case BackgroundThrottlingPolicy::kLive:
+    case BackgroundThrottlingPolicy::kThrottle:
+      break;
+  }
+}
+
+void WebContents::UpdateThrottledFrameSink() {
+  std::optional<viz::FrameSinkId> frame_sink_id;
+  auto* rwhv = web_contents()->GetRenderWidgetHostView();
+  if (backgrounded_ &&
+      background_throttling_policy_ ==
+          BackgroundThrottlingPolicy::kCapFrameRate &&
+      rwhv)
+    frame_sink_id = rwhv->GetFrameSinkId();
+
+  auto* throttler = FrameRateThrottler::GetInstance();
+  if (throttled_frame_sink_id_ && throttled_frame_sink_id_ != frame_sink_id)
+    throttler->ClearFrameRate(*throttled_frame_sink_id_);
+  if (frame_sink_id)
+    throttler->SetFrameRate(*frame_sink_id, background_frame_rate_);
+  throttled_frame_sink_id_ = frame_sink_id;
+}
+
+void WebContents::UpdateBackgroundThrottling() {
+  bool allowed = GetBackgroundThrottling();
 
   if (owner_window_) {
     owner_window_->UpdateBackgroundThrottlingState();
   }
 
+  UpdateBackgrounded();
+
   auto* rfh = web_contents()->GetPrimaryMainFrame();
   if (!rfh)
     return;
@@ -2368,7 +2726,7 @@ void WebContents::SetBackgroundThrottling(bool allowed) {
   if (!rwh_impl)
     return;
 
-  rwh_impl->disable_hidden_ = !background_throttling_;
+  rwh_impl->disable_hidden_ = !allowed;
   web_contents()->GetRenderViewHost()->SetSchedulerThrottling(allowed);
 
   if (rwh_impl->is_hidden()) {
@@ -2723,7 +3081,8 @@ std::string WebContents::GetUserAgent() {
 
 v8::Local<v8::Promise> WebContents::SavePage(
     const base::FilePath& full_file_path,
-    const content::SavePageType& save_type) {
+    const content::SavePageType& save_type,
+    std::optional<gin_helper::Dictionary> options) {
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   gin_helper::Promise<void> promise(isolate);
   v8::Local<v8::Promise> handle = promise.GetHandle();
@@ -2733,6 +3092,33 @@ v8::Local<v8::Promise> WebContents::SavePage(
     return handle;
   }
 
+  bool stream_to_file = false;
+  if (options)
+    options->Get("streamToFile", &stream_to_file);
+
+  if (stream_to_file) {
+    if (save_type != content::SAVE_PAGE_TYPE_AS_MHTML) {
+      promise.RejectWithErrorMessage(
+          "streamToFile is only supported when saving as MHTML");
+      return handle;
+    }
+    // Each frame is serialized by its renderer from the resources it already
+    // has and appended to the file as it is produced, without going through
+    // the download manager.
+    web_contents()->GenerateMHTMLWithResult(
+        content::MHTMLGenerationParams(full_file_path),
+        base::BindOnce(
+            [](gin_helper::Promise<void> promise,
+               const content::MHTMLGenerationResult& result) {
+              if (result.file_size < 0)
+                promise.RejectWithErrorMessage("Failed to save the page.");
+              else
+                promise.Resolve();
+            },
+            std::move(promise)));
+    return handle;
+  }
+
   auto* handler = new SavePageHandler(web_contents(), std::move(promise));
   handler->Handle(full_file_path, save_type);
 
@@ -3155,7 +3541,9 @@ void WebContents::Print(gin::Arguments* args) {
 
 // Partially duplicated and modified from
 // headless/lib/browser/protocol/page_handler.cc;l=41
-v8::Local<v8::Promise> WebContents::PrintToPDF(const base::Value& settings) {
+v8::Local<v8::Promise> WebContents::PrintToPDF(
+    const base::Value& settings,
+    std::optional<base::FilePath> file_path) {
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   gin_helper::Promise<v8::Local<v8::Value>> promise(isolate);
   v8::Local<v8::Promise> handle = promise.GetHandle();
@@ -3209,13 +3597,14 @@ v8::Local<v8::Promise> WebContents::PrintToPDF(const base::Value& settings) {
   manager->PrintToPdf(web_contents()->GetPrimaryMainFrame(), page_ranges,
                       std::move(params),
                       base::BindOnce(&WebContents::OnPDFCreated, GetWeakPtr(),
-                                     std::move(promise)));
+                                     std::move(promise), std::move(file_path)));
 
   return handle;
 }
 
 void WebContents::OnPDFCreated(
     gin_helper::Promise<v8::Local<v8::Value>> promise,
+    std::optional<base::FilePath> file_path,
     print_to_pdf::PdfPrintResult print_result,
     scoped_refptr<base::RefCountedMemory> data) {
   if (print_result != print_to_pdf::PdfPrintResult::kPrintSuccess) {
@@ -3225,6 +3614,32 @@ void WebContents::OnPDFCreated(
     return;
   }
 
+  // Writing the file off the UI thread spares copying what can be hundreds
+  // of megabytes into the JS heap just for it to be written out again.
+  if (file_path) {
+    base::ThreadPool::PostTaskAndReplyWithResult(
+        FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+        base::BindOnce(
+            [](const base::FilePath& path,
+               scoped_refptr<base::RefCountedMemory> data) {
+              return base::WriteFile(
+                  path, base::make_span(data->front(), data->size()));
+            },
+            *file_path, std::move(data)),
+        base::BindOnce(
+            [](gin_helper::Promise<v8::Local<v8::Value>> promise,
+               bool success) {
+              if (!success) {
+                promise.RejectWithErrorMessage("Failed to write PDF to file");
+                return;
+              }
+              v8::HandleScope handle_scope(promise.isolate());
+              promise.Resolve(v8::Undefined(promise.isolate()));
+            },
+            std::move(promise)));
+    return;
+  }
+
   v8::Isolate* isolate = promise.isolate();
   gin_helper::Locker locker(isolate);
   v8::HandleScope handle_scope(isolate);
@@ -3343,11 +3758,15 @@ uint32_t WebContents::FindInPage(gin::Arguments* args) {
   uint32_t request_id = ++find_in_page_request_id_;
   gin_helper::Dictionary dict;
   auto options = blink::mojom::FindOptions::New();
+  bool report_progress = false;
   if (args->GetNext(&dict)) {
     dict.Get("forward", &options->forward);
     dict.Get("matchCase", &options->match_case);
     dict.Get("findNext", &options->new_session);
+    dict.Get("reportProgress", &report_progress);
   }
+  if (report_progress)
+    find_in_page_progress_request_id_ = request_id;
 
   web_contents()->Find(request_id, search_text, std::move(options));
   return request_id;
@@ -3399,10 +3818,79 @@ bool WebContents::IsFocused() const {
 
 void WebContents::SendInputEvent(v8::Isolate* isolate,
                                  v8::Local<v8::Value> input_event) {
+  if (!web_contents()->GetRenderWidgetHostView())
+    return;
+
+  if (!ForwardInputEvent(isolate, input_event)) {
+    isolate->ThrowException(
+        v8::Exception::Error(gin::StringToV8(isolate, "Invalid event object")));
+  }
+}
+
+void WebContents::SendInputEvents(
+    v8::Isolate* isolate,
+    const std::vector<v8::Local<v8::Value>>& input_events,
+    std::optional<gin_helper::Dictionary> options) {
+  if (!web_contents()->GetRenderWidgetHostView())
+    return;
+
+  bool coalesce = true;
+  if (options)
+    options->Get("coalesce", &coalesce);
+
+  // Runs of mouse moves are folded into a single event, the way the input
+  // pipeline would coalesce them anyway, so that replaying a recorded stream
+  // doesn't send one event to the renderer per sample.
+  std::optional<blink::WebMouseEvent> pending_move;
+  for (size_t i = 0; i < input_events.size(); ++i) {
+    v8::Local<v8::Value> input_event = input_events[i];
+    if (coalesce && gin::GetWebInputEventType(isolate, input_event) ==
+                        blink::WebInputEvent::Type::kMouseMove) {
+      blink::WebMouseEvent mouse_event;
+      if (gin::ConvertFromV8(isolate, input_event, &mouse_event)) {
+        if (pending_move && pending_move->CanCoalesce(mouse_event)) {
+          pending_move->Coalesce(mouse_event);
+        } else {
+          if (pending_move)
+            ForwardMouseEvent(*pending_move);
+          pending_move = mouse_event;
+        }
+        continue;
+      }
+    }
+
+    if (pending_move) {
+      ForwardMouseEvent(*pending_move);
+      pending_move.reset();
+    }
+    if (!ForwardInputEvent(isolate, input_event)) {
+      isolate->ThrowException(v8::Exception::Error(gin::StringToV8(
+          isolate, base::StringPrintf("Invalid event object at index %zu",
+                                      i))));
+      return;
+    }
+  }
+  if (pending_move)
+    ForwardMouseEvent(*pending_move);
+}
+
+void WebContents::ForwardMouseEvent(const blink::WebMouseEvent& mouse_event) {
+  if (IsOffScreen()) {
+    GetOffScreenRenderWidgetHostView()->SendMouseEvent(mouse_event);
+    return;
+  }
+  content::RenderWidgetHostView* view =
+      web_contents()->GetRenderWidgetHostView();
+  if (view)
+    view->GetRenderWidgetHost()->ForwardMouseEvent(mouse_event);
+}
+
+bool WebContents::ForwardInputEvent(v8::Isolate* isolate,
+                                    v8::Local<v8::Value> input_event) {
   content::RenderWidgetHostView* view =
       web_contents()->GetRenderWidgetHostView();
   if (!view)
-    return;
+    return true;
 
   content::RenderWidgetHost* rwh = view->GetRenderWidgetHost();
   blink::WebInputEvent::Type type =
@@ -3410,12 +3898,8 @@ void WebContents::SendInputEvent(v8::Isolate* isolate,
   if (blink::WebInputEvent::IsMouseEventType(type)) {
     blink::WebMouseEvent mouse_event;
     if (gin::ConvertFromV8(isolate, input_event, &mouse_event)) {
-      if (IsOffScreen()) {
-        GetOffScreenRenderWidgetHostView()->SendMouseEvent(mouse_event);
-      } else {
-        rwh->ForwardMouseEvent(mouse_event);
-      }
-      return;
+      ForwardMouseEvent(mouse_event);
+      return true;
     }
   } else if (blink::WebInputEvent::IsKeyboardEventType(type)) {
     content::NativeWebKeyboardEvent keyboard_event(
@@ -3425,8 +3909,11 @@ void WebContents::SendInputEvent(v8::Isolate* isolate,
       // For backwards compatibility, convert `kKeyDown` to `kRawKeyDown`.
       if (keyboard_event.GetType() == blink::WebKeyboardEvent::Type::kKeyDown)
         keyboard_event.SetType(blink::WebKeyboardEvent::Type::kRawKeyDown);
-      rwh->ForwardKeyboardEvent(keyboard_event);
-      return;
+      if (IsOffScreen())
+        GetOffScreenRenderWidgetHostView()->SendKeyboardEvent(keyboard_event);
+      else
+        rwh->ForwardKeyboardEvent(keyboard_event);
+      return true;
     }
   } else if (type == blink::WebInputEvent::Type::kMouseWheel) {
     blink::WebMouseWheelEvent mouse_wheel_event;
@@ -3451,31 +3938,84 @@ void WebContents::SendInputEvent(v8::Isolate* isolate,
             blink::WebInputEvent::DispatchType::kEventNonBlocking;
         rwh->ForwardWheelEvent(mouse_wheel_event);
       }
-      return;
+      return true;
     }
   }
-
-  isolate->ThrowException(
-      v8::Exception::Error(gin::StringToV8(isolate, "Invalid event object")));
+  return false;
 }
 
 void WebContents::BeginFrameSubscription(gin::Arguments* args) {
-  bool only_dirty = false;
-  FrameSubscriber::FrameCaptureCallback callback;
+  FrameSubscriber::CaptureOptions options;
 
   if (args->Length() > 1) {
-    if (!args->GetNext(&only_dirty)) {
+    // Any value converts to a boolean, so an options object has to be told
+    // apart before |onlyDirty| is read.
+    gin_helper::Dictionary dict;
+    v8::Local<v8::Value> next = args->PeekNext();
+    if (!next.IsEmpty() && next->IsObject() && args->GetNext(&dict)) {
+      dict.Get("onlyDirty", &options.only_dirty);
+      dict.Get("size", &options.size);
+      std::string format;
+      if (dict.Get("format", &format) && format == "i420") {
+        options.format = media::PIXEL_FORMAT_I420;
+      } else if (!format.empty() && format != "bgra") {
+        args->ThrowTypeError("format must be 'bgra' or 'i420'");
+        return;
+      }
+    } else if (!args->GetNext(&options.only_dirty)) {
+      args->ThrowError();
+      return;
+    }
+  }
+
+  if (options.format == media::PIXEL_FORMAT_I420) {
+    VideoFrameCallback callback;
+    if (!args->GetNext(&callback)) {
       args->ThrowError();
       return;
     }
+    frame_subscriber_ = std::make_unique<FrameSubscriber>(
+        web_contents(), base::BindRepeating(&OnVideoFrameCaptured, callback),
+        options);
+    return;
   }
+
+  FrameSubscriber::FrameCaptureCallback callback;
   if (!args->GetNext(&callback)) {
     args->ThrowError();
     return;
   }
 
   frame_subscriber_ =
-      std::make_unique<FrameSubscriber>(web_contents(), callback, only_dirty);
+      std::make_unique<FrameSubscriber>(web_contents(), callback, options);
+}
+
+void WebContents::BeginEncodedFrameSubscription(gin::Arguments* args) {
+#if BUILDFLAG(ENABLE_LIBVPX)
+  gin_helper::Dictionary options;
+  EncodedChunkCallback callback;
+  if (!args->GetNext(&options) || !args->GetNext(&callback)) {
+    args->ThrowError();
+    return;
+  }
+
+  FrameSubscriber::EncodingOptions encoding;
+  std::string codec = "vp8";
+  options.Get("codec", &codec);
+  if (codec == "vp9") {
+    encoding.profile = media::VP9PROFILE_PROFILE0;
+  } else if (codec != "vp8") {
+    args->ThrowTypeError("codec must be 'vp8' or 'vp9'");
+    return;
+  }
+  options.Get("bitrate", &encoding.bitrate);
+
+  frame_subscriber_ = std::make_unique<FrameSubscriber>(
+      web_contents(), base::BindRepeating(&OnEncodedFrame, callback),
+      encoding);
+#else
+  args->ThrowError("Encoded frames are not supported in this build");
+#endif
 }
 
 void WebContents::EndFrameSubscription() {
@@ -3522,11 +4062,13 @@ v8::Local<v8::Promise> WebContents::CapturePage(gin::Arguments* args) {
 
   bool stay_hidden = false;
   bool stay_awake = false;
+  gfx::Size output_size;
   if (args && args->Length() == 2) {
     gin_helper::Dictionary options;
     if (args->GetNext(&options)) {
       options.Get("stayHidden", &stay_hidden);
       options.Get("stayAwake", &stay_awake);
+      options.Get("size", &output_size);
     }
   }
 
@@ -3559,6 +4101,10 @@ v8::Local<v8::Promise> WebContents::CapturePage(gin::Arguments* args) {
                           .device_scale_factor();
   if (scale > 1.0f)
     bitmap_size = gfx::ScaleToCeiledSize(view_size, scale);
+  // The copy request scales the result on the GPU, which is much cheaper than
+  // resizing the full size image afterwards.
+  if (!output_size.IsEmpty())
+    bitmap_size = output_size;
 
   view->CopyFromSurface(gfx::Rect(rect.origin(), view_size), bitmap_size,
                         base::BindOnce(&OnCapturePageDone, std::move(promise),
@@ -3595,7 +4141,84 @@ bool WebContents::IsOffScreen() const {
 }
 
 void WebContents::OnPaint(const gfx::Rect& dirty_rect, const SkBitmap& bitmap) {
-  Emit("paint", dirty_rect, gfx::Image::CreateFrom1xBitmap(bitmap));
+  if (!offscreen_dirty_rect_only_) {
+    Emit("paint", dirty_rect, gfx::Image::CreateFrom1xBitmap(bitmap));
+    return;
+  }
+
+  // The bitmap is reused for the next frame, so copy the damaged pixels out.
+  SkBitmap dirty;
+  if (!dirty_rect.IsEmpty() &&
+      dirty.tryAllocPixels(
+          bitmap.info().makeWH(dirty_rect.width(), dirty_rect.height())) &&
+      !bitmap.readPixels(dirty.pixmap(), dirty_rect.x(), dirty_rect.y())) {
+    dirty.reset();
+  }
+  Emit("paint", dirty_rect, gfx::Image::CreateFrom1xBitmap(dirty));
+}
+
+void WebContents::OnSharedPaint(const gfx::Rect& dirty_rect,
+                                std::unique_ptr<OffScreenSharedFrame> frame) {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+
+  auto buffer_of = [isolate](const auto& value) {
+    return node::Buffer::Copy(isolate, reinterpret_cast<const char*>(&value),
+                              sizeof(value))
+        .ToLocalChecked();
+  };
+
+  auto dict = gin_helper::Dictionary::CreateEmpty(isolate);
+  if (frame->is_texture()) {
+    dict.Set("type", "sharedTexture");
+#if BUILDFLAG(IS_WIN)
+    dict.Set("handle", buffer_of(frame->texture.dxgi_handle.Get()));
+#elif BUILDFLAG(IS_MAC)
+    dict.Set("handle", buffer_of(frame->texture.io_surface.get()));
+#elif BUILDFLAG(IS_LINUX)
+    const auto& pixmap = frame->texture.native_pixmap_handle;
+    std::vector<gin_helper::Dictionary> planes;
+    for (const auto& plane : pixmap.planes) {
+      auto plane_dict = gin_helper::Dictionary::CreateEmpty(isolate);
+      plane_dict.Set("fd", plane.fd.get());
+      plane_dict.Set("stride", plane.stride);
+      plane_dict.Set("offset", static_cast<double>(plane.offset));
+      plane_dict.Set("size", static_cast<double>(plane.size));
+      planes.push_back(plane_dict);
+    }
+    dict.Set("planes", planes);
+    dict.Set("modifier", base::NumberToString(pixmap.modifier));
+#endif
+  } else {
+    dict.Set("type", "sharedMemory");
+#if BUILDFLAG(IS_WIN) || BUILDFLAG(IS_APPLE)
+    dict.Set("handle", buffer_of(frame->region.GetPlatformHandle()));
+#elif BUILDFLAG(IS_POSIX)
+    dict.Set("handle", buffer_of(frame->region.GetPlatformHandle().fd));
+#endif
+    dict.Set("pixels", buffer_of(frame->mapping.memory()));
+    dict.Set("byteLength", static_cast<uint32_t>(frame->mapping.size()));
+  }
+  dict.Set("stride", static_cast<uint32_t>(frame->stride));
+  dict.Set("codedSize", frame->coded_size);
+  dict.Set("contentRect", frame->content_rect);
+  dict.Set("pixelFormat", "bgra");
+
+  // The frame is also released once the function, and so the object holding
+  // it, is garbage collected.
+  auto holder = base::MakeRefCounted<
+      base::RefCountedData<std::unique_ptr<OffScreenSharedFrame>>>(
+      std::move(frame));
+  dict.SetMethod(
+      "release",
+      base::BindRepeating(
+          [](scoped_refptr<base::RefCountedData<
+                 std::unique_ptr<OffScreenSharedFrame>>> holder) {
+            holder->data.reset();
+          },
+          holder));
+
+  Emit("paint", dirty_rect, gfx::Image(), dict);
 }
 
 void WebContents::StartPainting() {
@@ -3932,6 +4555,290 @@ v8::Local<v8::Promise> WebContents::TakeHeapSnapshot(
   return handle;
 }
 
+namespace {
+
+// Connects to the renderer of the page's main frame, or returns nullptr with
+// the reason in |error|.
+std::unique_ptr<mojo::Remote<mojom::ElectronRenderer>> BindMainFrameRenderer(
+    content::WebContents* web_contents,
+    std::string* error) {
+  auto* frame_host = web_contents->GetPrimaryMainFrame();
+  if (!frame_host || !frame_host->IsRenderFrameLive()) {
+    *error = "The renderer of the main frame is not running";
+    return nullptr;
+  }
+
+  auto electron_renderer =
+      std::make_unique<mojo::Remote<mojom::ElectronRenderer>>();
+  frame_host->GetRemoteInterfaces()->GetInterface(
+      electron_renderer->BindNewPipeAndPassReceiver());
+  return electron_renderer;
+}
+
+}  // namespace
+
+v8::Local<v8::Value> WebContents::TakeHeapSnapshotStream(
+    v8::Isolate* isolate,
+    base::OnceCallback<void(bool)> callback) {
+  std::string error;
+  auto electron_renderer = BindMainFrameRenderer(web_contents(), &error);
+  if (!electron_renderer) {
+    gin_helper::ErrorThrower(isolate).ThrowError(error);
+    return v8::Null(isolate);
+  }
+
+  // Large enough to hold several of V8's 64 KB chunks, so that the renderer
+  // rarely has to wait for the reader.
+  const MojoCreateDataPipeOptions options{sizeof(MojoCreateDataPipeOptions),
+                                          MOJO_CREATE_DATA_PIPE_FLAG_NONE, 1,
+                                          1024 * 1024};
+  mojo::ScopedDataPipeProducerHandle producer;
+  mojo::ScopedDataPipeConsumerHandle consumer;
+  if (mojo::CreateDataPipe(&options, producer, consumer) != MOJO_RESULT_OK) {
+    gin_helper::ErrorThrower(isolate).ThrowError(
+        "Failed to create a pipe for the heap snapshot");
+    return v8::Null(isolate);
+  }
+
+  auto* raw_ptr = electron_renderer.get();
+  (*raw_ptr)->StreamHeapSnapshot(
+      std::move(producer),
+      mojo::WrapCallbackWithDefaultInvokeIfNotRun(
+          base::BindOnce(
+              [](mojo::Remote<mojom::ElectronRenderer>* ep,
+                 base::OnceCallback<void(bool)> callback, bool success) {
+                std::move(callback).Run(success);
+              },
+              base::Owned(std::move(electron_renderer)), std::move(callback)),
+          false));
+
+  return DataPipeStream::Create(isolate, std::move(consumer),
+                                mojo::ScopedDataPipeProducerHandle())
+      .ToV8();
+}
+
+v8::Local<v8::Promise> WebContents::StartSamplingHeapProfiler(
+    v8::Isolate* isolate,
+    std::optional<gin_helper::Dictionary> options) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  double sampling_interval = 32768;
+  int stack_depth = 16;
+  if (options) {
+    if (options->Has("samplingInterval") &&
+        (!options->Get("samplingInterval", &sampling_interval) ||
+         sampling_interval < 1)) {
+      promise.RejectWithErrorMessage(
+          "'samplingInterval' must be a positive number");
+      return handle;
+    }
+    if (options->Has("stackDepth") &&
+        (!options->Get("stackDepth", &stack_depth) || stack_depth < 1)) {
+      promise.RejectWithErrorMessage("'stackDepth' must be a positive number");
+      return handle;
+    }
+  }
+
+  std::string error;
+  auto electron_renderer = BindMainFrameRenderer(web_contents(), &error);
+  if (!electron_renderer) {
+    promise.RejectWithErrorMessage(error);
+    return handle;
+  }
+
+  auto* raw_ptr = electron_renderer.get();
+  (*raw_ptr)->StartSamplingHeapProfiler(
+      static_cast<uint64_t>(sampling_interval), stack_depth,
+      base::BindOnce(
+          [](mojo::Remote<mojom::ElectronRenderer>* ep,
+             gin_helper::Promise<void> promise, bool success) {
+            if (success) {
+              promise.Resolve();
+            } else {
+              promise.RejectWithErrorMessage(
+                  "Failed to start the sampling heap profiler");
+            }
+          },
+          base::Owned(std::move(electron_renderer)), std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Promise> WebContents::StopSamplingHeapProfiler(
+    v8::Isolate* isolate) {
+  gin_helper::Promise<base::Value::Dict> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  std::string error;
+  auto electron_renderer = BindMainFrameRenderer(web_contents(), &error);
+  if (!electron_renderer) {
+    promise.RejectWithErrorMessage(error);
+    return handle;
+  }
+
+  auto* raw_ptr = electron_renderer.get();
+  (*raw_ptr)->StopSamplingHeapProfiler(base::BindOnce(
+      [](mojo::Remote<mojom::ElectronRenderer>* ep,
+         gin_helper::Promise<base::Value::Dict> promise,
+         std::optional<base::Value::Dict> profile) {
+        if (profile) {
+          promise.Resolve(std::move(*profile));
+        } else {
+          promise.RejectWithErrorMessage(
+              "The sampling heap profiler is not running");
+        }
+      },
+      base::Owned(std::move(electron_renderer)), std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Promise> WebContents::StartCpuProfiler(
+    v8::Isolate* isolate,
+    std::optional<gin_helper::Dictionary> options) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  double sampling_interval = 1000;
+  if (options && options->Has("samplingInterval") &&
+      (!options->Get("samplingInterval", &sampling_interval) ||
+       sampling_interval < 1)) {
+    promise.RejectWithErrorMessage(
+        "'samplingInterval' must be a positive number");
+    return handle;
+  }
+
+  std::string error;
+  auto electron_renderer = BindMainFrameRenderer(web_contents(), &error);
+  if (!electron_renderer) {
+    promise.RejectWithErrorMessage(error);
+    return handle;
+  }
+
+  auto* raw_ptr = electron_renderer.get();
+  (*raw_ptr)->StartCpuProfiler(
+      base::Microseconds(static_cast<int64_t>(sampling_interval)),
+      base::BindOnce(
+          [](mojo::Remote<mojom::ElectronRenderer>* ep,
+             gin_helper::Promise<void> promise, bool success) {
+            if (success) {
+              promise.Resolve();
+            } else {
+              promise.RejectWithErrorMessage(
+                  "Failed to start the CPU profiler");
+            }
+          },
+          base::Owned(std::move(electron_renderer)), std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Promise> WebContents::StopCpuProfiler(v8::Isolate* isolate) {
+  gin_helper::Promise<base::Value::Dict> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  std::string error;
+  auto electron_renderer = BindMainFrameRenderer(web_contents(), &error);
+  if (!electron_renderer) {
+    promise.RejectWithErrorMessage(error);
+    return handle;
+  }
+
+  auto* raw_ptr = electron_renderer.get();
+  (*raw_ptr)->StopCpuProfiler(base::BindOnce(
+      [](mojo::Remote<mojom::ElectronRenderer>* ep,
+         gin_helper::Promise<base::Value::Dict> promise,
+         std::optional<base::Value::Dict> profile) {
+        if (profile) {
+          promise.Resolve(std::move(*profile));
+        } else {
+          promise.RejectWithErrorMessage("The CPU profiler is not running");
+        }
+      },
+      base::Owned(std::move(electron_renderer)), std::move(promise)));
+  return handle;
+}
+
+bool WebContents::Hibernate() {
+  WebContentsHibernationController::CreateForWebContents(web_contents());
+  return WebContentsHibernationController::FromWebContents(web_contents())
+      ->Hibernate();
+}
+
+bool WebContents::IsHibernated() const {
+  auto* hibernation_controller =
+      WebContentsHibernationController::FromWebContents(web_contents());
+  return hibernation_controller && hibernation_controller->is_hibernated();
+}
+
+void WebContents::SetHibernationPolicy(gin::Arguments* args) {
+  gin_helper::Dictionary options;
+  if (!args->GetNext(&options)) {
+    args->ThrowTypeError("Expected an options object");
+    return;
+  }
+
+  WebContentsHibernationController::Policy policy;
+  double idle_timeout = 0;
+  if (options.Has("idleTimeout") &&
+      (!options.Get("idleTimeout", &idle_timeout) || idle_timeout < 0)) {
+    args->ThrowTypeError("'idleTimeout' must be a non-negative number");
+    return;
+  }
+  policy.idle_timeout = base::Milliseconds(idle_timeout);
+  options.Get("onMemoryPressure", &policy.on_memory_pressure);
+  options.Get("discard", &policy.discard);
+
+  WebContentsHibernationController::CreateForWebContents(web_contents());
+  WebContentsHibernationController::FromWebContents(web_contents())
+      ->SetPolicy(policy);
+}
+
+void WebContents::SetMemoryBudget(gin::Arguments* args) {
+  gin_helper::Dictionary options;
+  if (!args->GetNext(&options)) {
+    args->ThrowTypeError("Expected an options object");
+    return;
+  }
+
+  double limit = 0;
+  if (options.Has("limit") && (!options.Get("limit", &limit) || limit < 0)) {
+    args->ThrowTypeError("'limit' must be a non-negative number");
+    return;
+  }
+  double check_interval = 5000;
+  if (options.Has("checkInterval") &&
+      (!options.Get("checkInterval", &check_interval) ||
+       check_interval <= 0)) {
+    args->ThrowTypeError("'checkInterval' must be a positive number");
+    return;
+  }
+  bool reload = false;
+  options.Get("reload", &reload);
+
+  WebContentsMemoryBudgetController::Policy policy;
+  policy.limit_kb = static_cast<uint64_t>(limit);
+  policy.check_interval = base::Milliseconds(check_interval);
+
+  WebContentsMemoryBudgetController::CreateForWebContents(web_contents());
+  WebContentsMemoryBudgetController::FromWebContents(web_contents())
+      ->SetPolicy(
+          policy,
+          base::BindRepeating(
+              [](base::WeakPtr<WebContents> self, bool reload,
+                 uint64_t limit_kb, uint64_t usage_kb) {
+                if (!self)
+                  return false;
+                v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+                v8::HandleScope handle_scope(isolate);
+                auto details = gin_helper::Dictionary::CreateEmpty(isolate);
+                details.Set("usage", static_cast<double>(usage_kb));
+                details.Set("limit", static_cast<double>(limit_kb));
+                bool prevented =
+                    self->Emit("memory-budget-exceeded", details.GetHandle());
+                return reload && !prevented;
+              },
+              GetWeakPtr(), reload, policy.limit_kb));
+}
+
 void WebContents::UpdatePreferredSize(content::WebContents* web_contents,
                                       const gfx::Size& pref_size) {
   Emit("preferred-size-changed", pref_size);
@@ -4351,8 +5258,13 @@ void WebContents::FillObjectTemplate(v8::Isolate* isolate,
                  &WebContents::GetBackgroundThrottling)
       .SetMethod("setBackgroundThrottling",
                  &WebContents::SetBackgroundThrottling)
+      .SetMethod("getBackgroundThrottlingPolicy",
+                 &WebContents::GetBackgroundThrottlingPolicy)
+      .SetMethod("setBackgroundThrottlingPolicy",
+                 &WebContents::SetBackgroundThrottlingPolicy)
       .SetMethod("getProcessId", &WebContents::GetProcessID)
       .SetMethod("getOSProcessId", &WebContents::GetOSProcessID)
+      .SetMethod("getIpcStats", &WebContents::GetIpcStats)
       .SetMethod("equal", &WebContents::Equal)
       .SetMethod("_loadURL", &WebContents::LoadURL)
       .SetMethod("reload", &WebContents::Reload)
@@ -4360,7 +5272,7 @@ void WebContents::FillObjectTemplate(v8::Isolate* isolate,
       .SetMethod("downloadURL", &WebContents::DownloadURL)
       .SetMethod("getURL", &WebContents::GetURL)
       .SetMethod("getTitle", &WebContents::GetTitle)
-      .SetMethod("isLoading", &WebContents::IsLoading)
+      .SetFastMethod<&WebContents::IsLoading>("isLoading")
       .SetMethod("isLoadingMainFrame", &WebContents::IsLoadingMainFrame)
       .SetMethod("isWaitingForResponse", &WebContents::IsWaitingForResponse)
       .SetMethod("stop", &WebContents::Stop)
@@ -4418,7 +5330,10 @@ void WebContents::FillObjectTemplate(v8::Isolate* isolate,
       .SetMethod("focus", &WebContents::Focus)
       .SetMethod("isFocused", &WebContents::IsFocused)
       .SetMethod("sendInputEvent", &WebContents::SendInputEvent)
+      .SetMethod("sendInputEvents", &WebContents::SendInputEvents)
       .SetMethod("beginFrameSubscription", &WebContents::BeginFrameSubscription)
+      .SetMethod("beginEncodedFrameSubscription",
+                 &WebContents::BeginEncodedFrameSubscription)
       .SetMethod("endFrameSubscription", &WebContents::EndFrameSubscription)
       .SetMethod("startDrag", &WebContents::StartDrag)
       .SetMethod("attachToIframe", &WebContents::AttachToIframe)
@@ -4467,9 +5382,21 @@ void WebContents::FillObjectTemplate(v8::Isolate* isolate,
                  &WebContents::GetWebRTCIPHandlingPolicy)
       .SetMethod("getWebRTCUDPPortRange", &WebContents::GetWebRTCUDPPortRange)
       .SetMethod("takeHeapSnapshot", &WebContents::TakeHeapSnapshot)
+      .SetMethod("_takeHeapSnapshotStream",
+                 &WebContents::TakeHeapSnapshotStream)
+      .SetMethod("startSamplingHeapProfiler",
+                 &WebContents::StartSamplingHeapProfiler)
+      .SetMethod("stopSamplingHeapProfiler",
+                 &WebContents::StopSamplingHeapProfiler)
+      .SetMethod("startCpuProfiler", &WebContents::StartCpuProfiler)
+      .SetMethod("stopCpuProfiler", &WebContents::StopCpuProfiler)
       .SetMethod("setImageAnimationPolicy",
                  &WebContents::SetImageAnimationPolicy)
       .SetMethod("_getProcessMemoryInfo", &WebContents::GetProcessMemoryInfo)
+      .SetMethod("hibernate", &WebContents::Hibernate)
+      .SetMethod("isHibernated", &WebContents::IsHibernated)
+      .SetMethod("setHibernationPolicy", &WebContents::SetHibernationPolicy)
+      .SetMethod("setMemoryBudget", &WebContents::SetMemoryBudget)
       .SetProperty("id", &WebContents::ID)
       .SetProperty("session", &WebContents::Session)
       .SetProperty("hostWebContents", &WebContents::HostWebContents)
@@ -4595,6 +5522,7 @@ gin::WrapperInfo WebContents::kWrapperInfo = {gin::kEmbedderNativeGin};
 namespace {
 
 using electron::api::GetAllWebContents;
+using electron::api::GetInvokeHandlers;
 using electron::api::WebContents;
 using electron::api::WebFrameMain;
 
@@ -4623,6 +5551,18 @@ gin::Handle<WebContents> WebContentsFromDevToolsTargetID(
                   : gin::Handle<WebContents>();
 }
 
+void SetInvokeHandler(v8::Isolate* isolate,
+                      const std::string& channel,
+                      v8::Local<v8::Value> dispatcher) {
+  if (dispatcher->IsFunction()) {
+    GetInvokeHandlers().insert_or_assign(
+        channel,
+        v8::Global<v8::Function>(isolate, dispatcher.As<v8::Function>()));
+  } else {
+    GetInvokeHandlers().erase(channel);
+  }
+}
+
 std::vector<gin::Handle<WebContents>> GetAllWebContentsAsV8(
     v8::Isolate* isolate) {
   std::vector<gin::Handle<WebContents>> list;
@@ -4633,6 +5573,55 @@ std::vector<gin::Handle<WebContents>> GetAllWebContentsAsV8(
   return list;
 }
 
+// Describes |contents| with plain values so that callers enumerating many
+// WebContents don't have to create a wrapper for each of them. Returns null
+// once |contents| has been destroyed.
+v8::Local<v8::Value> CreateWebContentsInfo(v8::Isolate* isolate,
+                                           WebContents* contents) {
+  content::WebContents* web_contents = contents->web_contents();
+  if (!web_contents)
+    return v8::Null(isolate);
+
+  std::string_view visibility = "hidden";
+  switch (web_contents->GetVisibility()) {
+    case content::Visibility::VISIBLE:
+      visibility = "visible";
+      break;
+    case content::Visibility::OCCLUDED:
+      visibility = "occluded";
+      break;
+    case content::Visibility::HIDDEN:
+      break;
+  }
+
+  auto info = gin_helper::Dictionary::CreateEmpty(isolate);
+  info.Set("id", contents->ID());
+  info.Set("type", contents->type());
+  info.Set("url", contents->GetURL());
+  info.Set("processId", contents->GetProcessID());
+  info.Set("osProcessId", contents->GetOSProcessID());
+  info.Set("visibility", visibility);
+  return info.GetHandle();
+}
+
+v8::Local<v8::Value> GetWebContentsInfo(v8::Isolate* isolate, int32_t id) {
+  WebContents* contents = WebContents::FromID(id);
+  if (!contents)
+    return v8::Null(isolate);
+  return CreateWebContentsInfo(isolate, contents);
+}
+
+std::vector<v8::Local<v8::Value>> GetAllWebContentsInfo(v8::Isolate* isolate) {
+  std::vector<v8::Local<v8::Value>> list;
+  list.reserve(GetAllWebContents().size());
+  for (auto iter = base::IDMap<WebContents*>::iterator(&GetAllWebContents());
+       !iter.IsAtEnd(); iter.Advance()) {
+    if (iter.GetCurrentValue()->web_contents())
+      list.push_back(CreateWebContentsInfo(isolate, iter.GetCurrentValue()));
+  }
+  return list;
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -4644,6 +5633,9 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("fromFrame", &WebContentsFromFrame);
   dict.SetMethod("fromDevToolsTargetId", &WebContentsFromDevToolsTargetID);
   dict.SetMethod("getAllWebContents", &GetAllWebContentsAsV8);
+  dict.SetMethod("getAllWebContentsInfo", &GetAllWebContentsInfo);
+  dict.SetMethod("getWebContentsInfo", &GetWebContentsInfo);
+  dict.SetMethod("_setInvokeHandler", &SetInvokeHandler);
 }
 
 }  // namespace
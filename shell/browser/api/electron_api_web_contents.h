@@ -19,10 +19,13 @@
 #include "base/observer_list.h"
 #include "base/observer_list_types.h"
 #include "base/task/thread_pool.h"
+#include "base/time/time.h"
+#include "base/timer/elapsed_timer.h"
 #include "chrome/browser/devtools/devtools_eye_dropper.h"
 #include "chrome/browser/devtools/devtools_file_system_indexer.h"
 #include "chrome/browser/ui/exclusive_access/exclusive_access_context.h"  // nogncheck
 #include "chrome/browser/ui/exclusive_access/exclusive_access_manager.h"
+#include "components/viz/common/surfaces/frame_sink_id.h"
 #include "content/common/frame.mojom.h"
 #include "content/public/browser/devtools_agent_host.h"
 #include "content/public/browser/javascript_dialog_manager.h"
@@ -67,6 +70,7 @@ class ScriptExecutor;
 #endif
 
 namespace blink {
+class WebMouseEvent;
 struct DeviceEmulationParams;
 // enum class PermissionType;
 }  // namespace blink
@@ -96,6 +100,7 @@ class WebDialogHelper;
 class NativeWindow;
 class OffScreenRenderWidgetHostView;
 class OffScreenWebContentsView;
+struct OffScreenSharedFrame;
 
 namespace api {
 
@@ -127,6 +132,14 @@ class WebContents : public ExclusiveAccessContext,
     kOffScreen,       // Used for offscreen rendering
   };
 
+  // What happens to the page while it is in the background.
+  enum class BackgroundThrottlingPolicy {
+    kLive,          // Keeps running as if it were visible.
+    kCapFrameRate,  // Keeps running, at a capped frame rate.
+    kThrottle,      // Hidden, with its timers and animations throttled.
+    kFreeze,        // Frozen entirely.
+  };
+
   // Create a new WebContents and return the V8 wrapper of it.
   static gin::Handle<WebContents> New(v8::Isolate* isolate,
                                       const gin_helper::Dictionary& options);
@@ -171,6 +184,10 @@ class WebContents : public ExclusiveAccessContext,
 
   bool GetBackgroundThrottling() const override;
   void SetBackgroundThrottling(bool allowed);
+  BackgroundThrottlingPolicy GetBackgroundThrottlingPolicy() const {
+    return background_throttling_policy_;
+  }
+  void SetBackgroundThrottlingPolicy(gin::Arguments* args);
   int GetProcessID() const;
   base::ProcessId GetOSProcessID() const;
   [[nodiscard]] Type type() const { return type_; }
@@ -207,8 +224,10 @@ class WebContents : public ExclusiveAccessContext,
   void SetUserAgent(const std::string& user_agent);
   std::string GetUserAgent();
   void InsertCSS(const std::string& css);
-  v8::Local<v8::Promise> SavePage(const base::FilePath& full_file_path,
-                                  const content::SavePageType& save_type);
+  v8::Local<v8::Promise> SavePage(
+      const base::FilePath& full_file_path,
+      const content::SavePageType& save_type,
+      std::optional<gin_helper::Dictionary> options);
   void OpenDevTools(gin::Arguments* args);
   void CloseDevTools();
   bool IsDevToolsOpened();
@@ -240,9 +259,12 @@ class WebContents : public ExclusiveAccessContext,
                             // <error, device_name>
                             std::pair<std::string, std::u16string> info);
   void Print(gin::Arguments* args);
-  // Print current page as PDF.
-  v8::Local<v8::Promise> PrintToPDF(const base::Value& settings);
+  // Print current page as PDF. When |file_path| is given the PDF is written
+  // to it natively instead of being returned as a Buffer.
+  v8::Local<v8::Promise> PrintToPDF(const base::Value& settings,
+                                    std::optional<base::FilePath> file_path);
   void OnPDFCreated(gin_helper::Promise<v8::Local<v8::Value>> promise,
+                    std::optional<base::FilePath> file_path,
                     print_to_pdf::PdfPrintResult print_result,
                     scoped_refptr<base::RefCountedMemory> data);
 #endif
@@ -280,9 +302,13 @@ class WebContents : public ExclusiveAccessContext,
 
   // Send WebInputEvent to the page.
   void SendInputEvent(v8::Isolate* isolate, v8::Local<v8::Value> input_event);
+  void SendInputEvents(v8::Isolate* isolate,
+                       const std::vector<v8::Local<v8::Value>>& input_events,
+                       std::optional<gin_helper::Dictionary> options);
 
   // Subscribe to the frame updates.
   void BeginFrameSubscription(gin::Arguments* args);
+  void BeginEncodedFrameSubscription(gin::Arguments* args);
   void EndFrameSubscription();
 
   // Dragging native items.
@@ -301,6 +327,8 @@ class WebContents : public ExclusiveAccessContext,
   // Methods for offscreen rendering
   bool IsOffScreen() const;
   void OnPaint(const gfx::Rect& dirty_rect, const SkBitmap& bitmap);
+  void OnSharedPaint(const gfx::Rect& dirty_rect,
+                     std::unique_ptr<OffScreenSharedFrame> frame);
   void StartPainting();
   void StopPainting();
   bool IsPainting() const;
@@ -343,8 +371,26 @@ class WebContents : public ExclusiveAccessContext,
 
   v8::Local<v8::Promise> TakeHeapSnapshot(v8::Isolate* isolate,
                                           const base::FilePath& file_path);
+  v8::Local<v8::Value> TakeHeapSnapshotStream(
+      v8::Isolate* isolate,
+      base::OnceCallback<void(bool)> callback);
+  v8::Local<v8::Promise> StartSamplingHeapProfiler(
+      v8::Isolate* isolate,
+      std::optional<gin_helper::Dictionary> options);
+  v8::Local<v8::Promise> StopSamplingHeapProfiler(v8::Isolate* isolate);
+  v8::Local<v8::Promise> StartCpuProfiler(
+      v8::Isolate* isolate,
+      std::optional<gin_helper::Dictionary> options);
+  v8::Local<v8::Promise> StopCpuProfiler(v8::Isolate* isolate);
   v8::Local<v8::Promise> GetProcessMemoryInfo(v8::Isolate* isolate);
 
+  // Hibernation of the page while it is hidden.
+  bool Hibernate();
+  bool IsHibernated() const;
+  void SetHibernationPolicy(gin::Arguments* args);
+
+  void SetMemoryBudget(gin::Arguments* args);
+
   bool HandleContextMenu(content::RenderFrameHost& render_frame_host,
                          const content::ContextMenuParams& params) override;
 
@@ -426,14 +472,40 @@ class WebContents : public ExclusiveAccessContext,
     fullscreen_frame_ = rfh;
   }
 
+  // Counters for the IPC messages on one channel between this WebContents and
+  // its frames' renderers.
+  struct IpcChannelStats {
+    uint64_t received_count = 0;
+    uint64_t received_bytes = 0;
+    uint64_t sent_count = 0;
+    uint64_t sent_bytes = 0;
+    base::TimeDelta serialize_time;
+    base::TimeDelta deserialize_time;
+    // Time between a renderer finishing serializing a message and the browser
+    // starting to handle it, for the messages that record when they were sent.
+    base::TimeDelta queueing_delay;
+  };
+
+  void RecordIpcReceived(const std::string& channel,
+                         size_t bytes,
+                         const base::ElapsedTimer& deserialize_timer,
+                         std::optional<base::TimeTicks> send_time);
+  void RecordIpcSent(const std::string& channel,
+                     size_t bytes,
+                     base::TimeDelta serialize_time);
+  v8::Local<v8::Value> GetIpcStats(v8::Isolate* isolate) const;
+  // Channel names are chosen by the renderer, so past a limit the messages
+  // of new channels are counted together under one entry.
+  IpcChannelStats& GetIpcChannelStats(const std::string& channel);
+
   // mojom::ElectronApiIPC
   void Message(bool internal,
                const std::string& channel,
-               blink::CloneableMessage arguments,
+               mojom::SerializedArgumentsPtr arguments,
                content::RenderFrameHost* render_frame_host);
   void Invoke(bool internal,
               const std::string& channel,
-              blink::CloneableMessage arguments,
+              mojom::SerializedArgumentsPtr arguments,
               electron::mojom::ElectronApiIPC::InvokeCallback callback,
               content::RenderFrameHost* render_frame_host);
   void ReceivePostMessage(const std::string& channel,
@@ -505,6 +577,12 @@ class WebContents : public ExclusiveAccessContext,
   // Delete this if garbage collection has not started.
   void DeleteThisIfAlive();
 
+  // Converts |input_event| and forwards it to the page. Returns false when
+  // it isn't a valid input event.
+  bool ForwardInputEvent(v8::Isolate* isolate,
+                         v8::Local<v8::Value> input_event);
+  void ForwardMouseEvent(const blink::WebMouseEvent& mouse_event);
+
   // Creates a InspectableWebContents object and takes ownership of
   // |web_contents|.
   void InitWithWebContents(std::unique_ptr<content::WebContents> web_contents,
@@ -632,6 +710,7 @@ class WebContents : public ExclusiveAccessContext,
   void RenderViewDeleted(content::RenderViewHost*) override;
   void PrimaryMainFrameRenderProcessGone(
       base::TerminationStatus status) override;
+  void OnVisibilityChanged(content::Visibility visibility) override;
   void DOMContentLoaded(content::RenderFrameHost* render_frame_host) override;
   void DidFinishLoad(content::RenderFrameHost* render_frame_host,
                      const GURL& validated_url) override;
@@ -808,13 +887,44 @@ class WebContents : public ExclusiveAccessContext,
   // Weather the guest view should be transparent
   bool guest_transparent_ = true;
 
+  // Whether offscreen frames are handed out in shared memory or GPU memory
+  // buffers.
+  bool offscreen_use_shared_memory_ = false;
+  bool offscreen_use_shared_texture_ = false;
+
+  // Whether offscreen paint events only carry the pixels of the dirty rect.
+  bool offscreen_dirty_rect_only_ = false;
+
+  // Whether the offscreen frame rate is lowered while nothing is painted.
+  bool offscreen_adaptive_frame_rate_ = false;
+
   int32_t id_;
 
+  std::map<std::string, IpcChannelStats, std::less<>> ipc_stats_;
+  uint64_t ipc_received_bytes_ = 0;
+  uint64_t ipc_sent_bytes_ = 0;
+
   // Request id used for findInPage request.
   uint32_t find_in_page_request_id_ = 0;
 
-  // Whether background throttling is disabled.
-  bool background_throttling_ = true;
+  // Id of the latest findInPage request that asked for intermediate results.
+  uint32_t find_in_page_progress_request_id_ = 0;
+
+  void UpdateBackgroundThrottling();
+  void UpdateBackgrounded();
+  void SetBackgrounded(bool backgrounded);
+  void UpdateThrottledFrameSink();
+
+  BackgroundThrottlingPolicy background_throttling_policy_ =
+      BackgroundThrottlingPolicy::kThrottle;
+  // Used by kCapFrameRate.
+  int background_frame_rate_ = 1;
+  // Whether the policy also applies while the page is occluded.
+  bool background_throttling_when_occluded_ = false;
+  // Whether the policy is currently applied.
+  bool backgrounded_ = false;
+  // The frame sink whose frame rate is capped by kCapFrameRate.
+  std::optional<viz::FrameSinkId> throttled_frame_sink_id_;
 
   // Whether to enable devtools.
   bool enable_devtools_ = true;
@@ -11,12 +11,14 @@
 
 #include "base/logging.h"
 #include "base/no_destructor.h"
+#include "base/timer/elapsed_timer.h"
 #include "content/browser/renderer_host/render_frame_host_impl.h"  // nogncheck
 #include "content/public/browser/render_frame_host.h"
 #include "content/public/common/isolated_world_ids.h"
 #include "electron/shell/common/api/api.mojom.h"
 #include "gin/object_template_builder.h"
 #include "services/service_manager/public/cpp/interface_provider.h"
+#include "shell/browser/api/electron_api_web_contents.h"
 #include "shell/browser/api/message_port.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/javascript_environment.h"
@@ -183,17 +185,36 @@ bool WebFrameMain::Reload() {
 void WebFrameMain::Send(v8::Isolate* isolate,
                         bool internal,
                         const std::string& channel,
-                        v8::Local<v8::Value> args) {
-  blink::CloneableMessage message;
-  if (!gin::ConvertFromV8(isolate, args, &message)) {
+                        v8::Local<v8::Value> args,
+                        std::optional<v8::Local<v8::Value>> transfer) {
+  std::vector<v8::Local<v8::ArrayBuffer>> array_buffers;
+  if (transfer && !transfer.value()->IsUndefined()) {
+    if (!gin::ConvertFromV8(isolate, *transfer, &array_buffers)) {
+      isolate->ThrowException(v8::Exception::Error(
+          gin::StringToV8(isolate, "Invalid value for transfer")));
+      return;
+    }
+  }
+
+  base::ElapsedTimer timer;
+  mojom::SerializedArgumentsPtr message =
+      electron::SerializeV8ValueForIPC(isolate, args, array_buffers);
+  if (!message) {
     isolate->ThrowException(v8::Exception::Error(
         gin::StringToV8(isolate, "Failed to serialize arguments")));
     return;
   }
+  const base::TimeDelta serialize_time = timer.Elapsed();
 
   if (!CheckRenderFrame())
     return;
 
+  if (auto* web_contents = WebContents::From(
+          content::WebContents::FromRenderFrameHost(render_frame_))) {
+    web_contents->RecordIpcSent(channel, electron::GetSerializedSize(*message),
+                                serialize_time);
+  }
+
   GetRendererApi()->Message(internal, channel, std::move(message));
 }
 
@@ -262,6 +283,8 @@ void WebFrameMain::PostMessage(v8::Isolate* isolate,
   if (threw_exception)
     return;
 
+  // Disentangling emits the messages pending on the ports, whose listeners
+  // may have navigated or destroyed the frame.
   if (!CheckRenderFrame())
     return;
 
@@ -334,10 +357,14 @@ std::vector<content::RenderFrameHost*> WebFrameMain::Frames() const {
   if (!CheckRenderFrame())
     return frame_hosts;
 
-  render_frame_->ForEachRenderFrameHost(
+  // Only the children are visited, rather than the whole subtree.
+  render_frame_->ForEachRenderFrameHostWithAction(
       [&frame_hosts, this](content::RenderFrameHost* rfh) {
+        if (rfh == render_frame_)
+          return content::RenderFrameHost::FrameIterationAction::kContinue;
         if (rfh->GetParent() == render_frame_)
           frame_hosts.push_back(rfh);
+        return content::RenderFrameHost::FrameIterationAction::kSkipChildren;
       });
 
   return frame_hosts;
@@ -356,6 +383,39 @@ std::vector<content::RenderFrameHost*> WebFrameMain::FramesInSubtree() const {
   return frame_hosts;
 }
 
+gin_helper::Dictionary WebFrameMain::GetFramesInSubtreeInfo(
+    v8::Isolate* isolate) const {
+  std::vector<int> frame_tree_node_ids;
+  std::vector<int> parent_frame_tree_node_ids;
+  std::vector<int> process_ids;
+  std::vector<int> routing_ids;
+  std::vector<std::string> origins;
+  std::vector<GURL> urls;
+
+  if (CheckRenderFrame()) {
+    render_frame_->ForEachRenderFrameHost(
+        [&](content::RenderFrameHost* rfh) {
+          content::RenderFrameHost* parent = rfh->GetParent();
+          frame_tree_node_ids.push_back(rfh->GetFrameTreeNodeId());
+          parent_frame_tree_node_ids.push_back(
+              parent ? parent->GetFrameTreeNodeId() : -1);
+          process_ids.push_back(rfh->GetProcess()->GetID());
+          routing_ids.push_back(rfh->GetRoutingID());
+          origins.push_back(rfh->GetLastCommittedOrigin().Serialize());
+          urls.push_back(rfh->GetLastCommittedURL());
+        });
+  }
+
+  auto info = gin_helper::Dictionary::CreateEmpty(isolate);
+  info.Set("frameTreeNodeIds", frame_tree_node_ids);
+  info.Set("parentFrameTreeNodeIds", parent_frame_tree_node_ids);
+  info.Set("processIds", process_ids);
+  info.Set("routingIds", routing_ids);
+  info.Set("origins", origins);
+  info.Set("urls", urls);
+  return info;
+}
+
 void WebFrameMain::DOMContentLoaded() {
   Emit("dom-ready");
 }
@@ -405,6 +465,8 @@ void WebFrameMain::FillObjectTemplate(v8::Isolate* isolate,
       .SetMethod("reload", &WebFrameMain::Reload)
       .SetMethod("_send", &WebFrameMain::Send)
       .SetMethod("_postMessage", &WebFrameMain::PostMessage)
+      .SetMethod("getFramesInSubtreeInfo",
+                 &WebFrameMain::GetFramesInSubtreeInfo)
       .SetProperty("frameTreeNodeId", &WebFrameMain::FrameTreeNodeID)
       .SetProperty("name", &WebFrameMain::Name)
       .SetProperty("osProcessId", &WebFrameMain::OSProcessID)
@@ -30,6 +30,10 @@ namespace gin {
 class Arguments;
 }
 
+namespace gin_helper {
+class Dictionary;
+}
+
 namespace electron::api {
 
 class WebContents;
@@ -100,7 +104,8 @@ class WebFrameMain : public gin::Wrappable<WebFrameMain>,
   void Send(v8::Isolate* isolate,
             bool internal,
             const std::string& channel,
-            v8::Local<v8::Value> args);
+            v8::Local<v8::Value> args,
+            std::optional<v8::Local<v8::Value>> transfer);
   void PostMessage(v8::Isolate* isolate,
                    const std::string& channel,
                    v8::Local<v8::Value> message_value,
@@ -119,6 +124,9 @@ class WebFrameMain : public gin::Wrappable<WebFrameMain>,
   content::RenderFrameHost* Parent() const;
   std::vector<content::RenderFrameHost*> Frames() const;
   std::vector<content::RenderFrameHost*> FramesInSubtree() const;
+  // Describes the frames of the subtree with parallel arrays of plain
+  // values, which unlike FramesInSubtree() creates no wrappers.
+  gin_helper::Dictionary GetFramesInSubtreeInfo(v8::Isolate* isolate) const;
 
   void DOMContentLoaded();
 
@@ -4,22 +4,27 @@
 
 #include "shell/browser/api/electron_api_web_request.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include "base/containers/contains.h"
 #include "base/containers/fixed_flat_map.h"
+#include "base/functional/bind.h"
 #include "base/memory/raw_ptr.h"
+#include "base/ranges/algorithm.h"
 #include "base/stl_util.h"
+#include "base/strings/string_util.h"
 #include "base/task/sequenced_task_runner.h"
-#include "base/values.h"
 #include "extensions/browser/api/web_request/web_request_resource_type.h"
 #include "gin/converter.h"
 #include "gin/dictionary.h"
 #include "gin/object_template_builder.h"
 #include "net/http/http_content_disposition.h"
+#include "net/http/http_util.h"
 #include "shell/browser/api/electron_api_session.h"
 #include "shell/browser/api/electron_api_web_contents.h"
 #include "shell/browser/api/electron_api_web_frame_main.h"
@@ -32,6 +37,7 @@
 #include "shell/common/gin_converters/std_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/function_template.h"
 
 static constexpr auto ResourceTypes =
     base::MakeFixedFlatMap<std::string_view,
@@ -91,8 +97,9 @@ extensions::WebRequestResourceType ParseResourceType(std::string_view value) {
 // not use it because it lowercases the header keys, while the webRequest has
 // to pass the original keys.
 v8::Local<v8::Value> HttpResponseHeadersToV8(
-    net::HttpResponseHeaders* headers) {
-  base::Value::Dict response_headers;
+    const scoped_refptr<net::HttpResponseHeaders>& headers,
+    v8::Isolate* isolate) {
+  v8::Local<v8::Object> response_headers = v8::Object::New(isolate);
   if (headers) {
     size_t iter = 0;
     std::string key;
@@ -114,10 +121,38 @@ v8::Local<v8::Value> HttpResponseHeadersToV8(
         std::string filename = "\"" + header.filename() + "\"";
         value = decodedFilename + "; filename=" + filename;
       }
-      response_headers.EnsureList(key)->Append(value);
+      AppendHeaderValue(isolate, response_headers, key, value);
     }
   }
-  return gin::ConvertToV8(v8::Isolate::GetCurrent(), response_headers);
+  return response_headers;
+}
+
+v8::Local<v8::Value> HttpRequestHeadersToV8(
+    const net::HttpRequestHeaders& headers,
+    v8::Isolate* isolate) {
+  return gin::ConvertToV8(isolate, headers);
+}
+
+v8::Local<v8::Value> RequestBodyToV8(
+    const scoped_refptr<network::ResourceRequestBody>& body,
+    v8::Isolate* isolate) {
+  return gin::ConvertToV8(isolate, *body);
+}
+
+// Sets |key| of |details| to what |getter| returns, which is only run if and
+// when the listener first reads the property. Headers and upload data are
+// costly to convert, and most listeners never look at them.
+void SetLazy(
+    gin_helper::Dictionary* details,
+    std::string_view key,
+    base::RepeatingCallback<v8::Local<v8::Value>(v8::Isolate*)> getter) {
+  v8::Isolate* isolate = details->isolate();
+  auto [callback, data] =
+      gin_helper::CreateDataPropertyCallback(isolate, std::move(getter));
+  details->GetHandle()
+      ->SetLazyDataProperty(isolate->GetCurrentContext(),
+                            gin::StringToV8(isolate, key), callback, data)
+      .Check();
 }
 
 // Overloaded by multiple types to fill the |details| object.
@@ -135,8 +170,9 @@ void ToDictionary(gin_helper::Dictionary* details,
     details->Set("fromCache", info->response_from_cache);
     details->Set("statusLine", info->response_headers->GetStatusLine());
     details->Set("statusCode", info->response_headers->response_code());
-    details->Set("responseHeaders",
-                 HttpResponseHeadersToV8(info->response_headers.get()));
+    SetLazy(details, "responseHeaders",
+            base::BindRepeating(&HttpResponseHeadersToV8,
+                                info->response_headers));
   }
 
   auto* render_frame_host = content::RenderFrameHost::FromID(
@@ -157,12 +193,14 @@ void ToDictionary(gin_helper::Dictionary* details,
                   const network::ResourceRequest& request) {
   details->Set("referrer", request.referrer);
   if (request.request_body)
-    details->Set("uploadData", *request.request_body);
+    SetLazy(details, "uploadData",
+            base::BindRepeating(&RequestBodyToV8, request.request_body));
 }
 
 void ToDictionary(gin_helper::Dictionary* details,
                   const net::HttpRequestHeaders& headers) {
-  details->Set("requestHeaders", headers);
+  SetLazy(details, "requestHeaders",
+          base::BindRepeating(&HttpRequestHeadersToV8, headers));
 }
 
 void ToDictionary(gin_helper::Dictionary* details, const GURL& location) {
@@ -218,6 +256,14 @@ void ReadFromResponse(v8::Isolate* isolate,
   }
 }
 
+// Brings a pattern's host and a URL's host to the same form for bucketing, the
+// way URLPattern compares them. The pattern still decides the actual match.
+std::string NormalizeHostForMatching(std::string_view host) {
+  if (base::EndsWith(host, "."))
+    host.remove_suffix(1);
+  return base::ToLowerASCII(host);
+}
+
 }  // namespace
 
 gin::WrapperInfo WebRequest::kWrapperInfo = {gin::kEmbedderNativeGin};
@@ -225,13 +271,20 @@ gin::WrapperInfo WebRequest::kWrapperInfo = {gin::kEmbedderNativeGin};
 WebRequest::RequestFilter::RequestFilter(
     std::set<URLPattern> url_patterns,
     std::set<extensions::WebRequestResourceType> types)
-    : url_patterns_(std::move(url_patterns)), types_(std::move(types)) {}
+    : types_(std::move(types)) {
+  for (URLPattern pattern : url_patterns)
+    AddUrlPattern(std::move(pattern));
+}
 WebRequest::RequestFilter::RequestFilter(const RequestFilter&) = default;
 WebRequest::RequestFilter::RequestFilter() = default;
 WebRequest::RequestFilter::~RequestFilter() = default;
 
 void WebRequest::RequestFilter::AddUrlPattern(URLPattern pattern) {
-  url_patterns_.emplace(std::move(pattern));
+  std::string host = NormalizeHostForMatching(pattern.host());
+  if (host.empty())
+    any_host_url_patterns_.push_back(std::move(pattern));
+  else
+    host_url_patterns_[std::move(host)].push_back(std::move(pattern));
 }
 
 void WebRequest::RequestFilter::AddType(
@@ -240,12 +293,33 @@ void WebRequest::RequestFilter::AddType(
 }
 
 bool WebRequest::RequestFilter::MatchesURL(const GURL& url) const {
-  if (url_patterns_.empty())
+  if (host_url_patterns_.empty() && any_host_url_patterns_.empty())
     return true;
 
-  for (const auto& pattern : url_patterns_) {
-    if (pattern.MatchesURL(url))
+  const auto matches = [&url](const std::vector<URLPattern>& patterns) {
+    return base::ranges::any_of(patterns, [&url](const URLPattern& pattern) {
+      return pattern.MatchesURL(url);
+    });
+  };
+
+  if (matches(any_host_url_patterns_))
+    return true;
+  if (host_url_patterns_.empty())
+    return false;
+
+  // A pattern can only match hosts equal to its own, or subdomains of it when
+  // it starts with "*.", so look up the host and each of its parent domains.
+  const GURL& host_url =
+      url.SchemeIsFileSystem() && url.inner_url() ? *url.inner_url() : url;
+  const std::string host = NormalizeHostForMatching(host_url.host_piece());
+  for (std::string_view domain = host; !domain.empty();) {
+    const auto iter = host_url_patterns_.find(domain);
+    if (iter != host_url_patterns_.end() && matches(iter->second))
       return true;
+    const size_t dot = domain.find('.');
+    if (dot == std::string_view::npos)
+      break;
+    domain.remove_prefix(dot + 1);
   }
   return false;
 }
@@ -257,7 +331,7 @@ bool WebRequest::RequestFilter::MatchesType(
 
 bool WebRequest::RequestFilter::MatchesRequest(
     extensions::WebRequestInfo* info) const {
-  return MatchesURL(info->url) && MatchesType(info->web_request_type);
+  return MatchesType(info->web_request_type) && MatchesURL(info->url);
 }
 
 WebRequest::SimpleListenerInfo::SimpleListenerInfo(RequestFilter filter_,
@@ -273,6 +347,11 @@ WebRequest::ResponseListenerInfo::ResponseListenerInfo(
 WebRequest::ResponseListenerInfo::ResponseListenerInfo() = default;
 WebRequest::ResponseListenerInfo::~ResponseListenerInfo() = default;
 
+WebRequest::Rule::Rule() = default;
+WebRequest::Rule::Rule(Rule&&) = default;
+WebRequest::Rule& WebRequest::Rule::operator=(Rule&&) = default;
+WebRequest::Rule::~Rule() = default;
+
 WebRequest::WebRequest(v8::Isolate* isolate,
                        content::BrowserContext* browser_context)
     : browser_context_(browser_context) {
@@ -305,7 +384,8 @@ gin::ObjectTemplateBuilder WebRequest::GetObjectTemplateBuilder(
       .SetMethod("onErrorOccurred",
                  &WebRequest::SetSimpleListener<SimpleEvent::kOnErrorOccurred>)
       .SetMethod("onCompleted",
-                 &WebRequest::SetSimpleListener<SimpleEvent::kOnCompleted>);
+                 &WebRequest::SetSimpleListener<SimpleEvent::kOnCompleted>)
+      .SetMethod("setRules", &WebRequest::SetRules);
 }
 
 const char* WebRequest::GetTypeName() {
@@ -313,13 +393,40 @@ const char* WebRequest::GetTypeName() {
 }
 
 bool WebRequest::HasListener() const {
-  return !(simple_listeners_.empty() && response_listeners_.empty());
+  return !(simple_listeners_.empty() && response_listeners_.empty() &&
+           rules_.empty());
+}
+
+bool WebRequest::MayHaveListenerForType(
+    extensions::WebRequestResourceType type) const {
+  const auto matches = [&](const auto& item) {
+    return item.second.filter.MatchesType(type);
+  };
+  return base::ranges::any_of(simple_listeners_, matches) ||
+         base::ranges::any_of(response_listeners_, matches) ||
+         base::ranges::any_of(rules_, [&](const Rule& rule) {
+           return rule.filter.MatchesType(type);
+         });
 }
 
 int WebRequest::OnBeforeRequest(extensions::WebRequestInfo* info,
                                 const network::ResourceRequest& request,
                                 net::CompletionOnceCallback callback,
                                 GURL* new_url) {
+  for (const auto& rule : rules_) {
+    if (!rule.filter.MatchesRequest(info))
+      continue;
+    if (rule.action == RuleAction::kBlock)
+      return net::ERR_BLOCKED_BY_CLIENT;
+    // Skip redirects to the request's own URL, which would never end.
+    if (rule.action == RuleAction::kRedirect && new_url->is_empty() &&
+        rule.redirect_url != info->url)
+      *new_url = rule.redirect_url;
+  }
+  // The listener is called again for the request to the new URL.
+  if (!new_url->is_empty())
+    return net::OK;
+
   return HandleResponseEvent(ResponseEvent::kOnBeforeRequest, info,
                              std::move(callback), new_url, request);
 }
@@ -328,6 +435,16 @@ int WebRequest::OnBeforeSendHeaders(extensions::WebRequestInfo* info,
                                     const network::ResourceRequest& request,
                                     BeforeSendHeadersCallback callback,
                                     net::HttpRequestHeaders* headers) {
+  for (const auto& rule : rules_) {
+    if (rule.action != RuleAction::kModifyHeaders ||
+        !rule.filter.MatchesRequest(info))
+      continue;
+    for (const auto& name : rule.remove_request_headers)
+      headers->RemoveHeader(name);
+    for (const auto& [name, value] : rule.set_request_headers)
+      headers->SetHeader(name, value);
+  }
+
   return HandleResponseEvent(
       ResponseEvent::kOnBeforeSendHeaders, info,
       base::BindOnce(std::move(callback), std::set<std::string>(),
@@ -342,6 +459,25 @@ int WebRequest::OnHeadersReceived(
     const net::HttpResponseHeaders* original_response_headers,
     scoped_refptr<net::HttpResponseHeaders>* override_response_headers,
     GURL* allowed_unsafe_redirect_url) {
+  if (original_response_headers) {
+    for (const auto& rule : rules_) {
+      if (rule.action != RuleAction::kModifyHeaders ||
+          (rule.remove_response_headers.empty() &&
+           rule.set_response_headers.empty()) ||
+          !rule.filter.MatchesRequest(info))
+        continue;
+      if (!*override_response_headers) {
+        *override_response_headers =
+            base::MakeRefCounted<net::HttpResponseHeaders>(
+                original_response_headers->raw_headers());
+      }
+      for (const auto& name : rule.remove_response_headers)
+        (*override_response_headers)->RemoveHeader(name);
+      for (const auto& [name, value] : rule.set_response_headers)
+        (*override_response_headers)->SetHeader(name, value);
+    }
+  }
+
   const std::string& status_line =
       original_response_headers ? original_response_headers->GetStatusLine()
                                 : std::string();
@@ -390,7 +526,23 @@ void WebRequest::OnRequestWillBeDestroyed(extensions::WebRequestInfo* info) {
 
 template <WebRequest::SimpleEvent event>
 void WebRequest::SetSimpleListener(gin::Arguments* args) {
-  SetListener<SimpleListener>(event, &simple_listeners_, args);
+  // The filter of simple events may also have a batchInterval.
+  int batch_interval = 0;
+  v8::Local<v8::Value> arg = args->PeekNext();
+  gin::Dictionary dict(args->isolate());
+  if (!arg.IsEmpty() && !arg->IsFunction() &&
+      gin::ConvertFromV8(args->isolate(), arg, &dict))
+    dict.Get("batchInterval", &batch_interval);
+
+  if (!SetListener<SimpleListener>(event, &simple_listeners_, args))
+    return;
+
+  // Events batched for the previous listener are not delivered to this one.
+  batched_details_.erase(event);
+  if (auto iter = simple_listeners_.find(event);
+      iter != simple_listeners_.end())
+    iter->second.batch_interval =
+        base::Milliseconds(std::max(0, batch_interval));
 }
 
 template <WebRequest::ResponseEvent event>
@@ -399,7 +551,7 @@ void WebRequest::SetResponseListener(gin::Arguments* args) {
 }
 
 template <typename Listener, typename Listeners, typename Event>
-void WebRequest::SetListener(Event event,
+bool WebRequest::SetListener(Event event,
                              Listeners* listeners,
                              gin::Arguments* args) {
   v8::Local<v8::Value> arg;
@@ -414,7 +566,7 @@ void WebRequest::SetListener(Event event,
     if (gin::ConvertFromV8(args->isolate(), arg, &dict)) {
       if (!dict.Get("urls", &filter_patterns)) {
         args->ThrowTypeError("Parameter 'filter' must have property 'urls'.");
-        return;
+        return false;
       }
       dict.Get("types", &filter_types);
       args->GetNext(&arg);
@@ -422,28 +574,10 @@ void WebRequest::SetListener(Event event,
   }
 
   RequestFilter filter;
-
-  for (const std::string& filter_pattern : filter_patterns) {
-    URLPattern pattern(URLPattern::SCHEME_ALL);
-    const URLPattern::ParseResult result = pattern.Parse(filter_pattern);
-    if (result == URLPattern::ParseResult::kSuccess) {
-      filter.AddUrlPattern(std::move(pattern));
-    } else {
-      const char* error_type = URLPattern::GetParseResultString(result);
-      args->ThrowTypeError("Invalid url pattern " + filter_pattern + ": " +
-                           error_type);
-      return;
-    }
-  }
-
-  for (const std::string& filter_type : filter_types) {
-    auto type = ParseResourceType(filter_type);
-    if (type != extensions::WebRequestResourceType::OTHER) {
-      filter.AddType(type);
-    } else {
-      args->ThrowTypeError("Invalid type " + filter_type);
-      return;
-    }
+  std::string error;
+  if (!ParseFilter(filter_patterns, filter_types, &filter, &error)) {
+    args->ThrowTypeError(error);
+    return false;
   }
 
   // Function or null.
@@ -451,13 +585,103 @@ void WebRequest::SetListener(Event event,
   if (arg.IsEmpty() ||
       !(gin::ConvertFromV8(args->isolate(), arg, &listener) || arg->IsNull())) {
     args->ThrowTypeError("Must pass null or a Function");
-    return;
+    return false;
   }
 
   if (listener.is_null())
     listeners->erase(event);
   else
     (*listeners)[event] = {std::move(filter), std::move(listener)};
+  return true;
+}
+
+void WebRequest::SetRules(gin::Arguments* args) {
+  v8::Isolate* isolate = args->isolate();
+  std::vector<v8::Local<v8::Object>> objects;
+  if (!args->GetNext(&objects)) {
+    args->ThrowTypeError("Must pass an Array of rules");
+    return;
+  }
+
+  std::vector<Rule> rules;
+  for (v8::Local<v8::Object> object : objects) {
+    gin::Dictionary dict(isolate, object);
+    std::set<std::string> filter_patterns, filter_types;
+    if (!dict.Get("urls", &filter_patterns)) {
+      args->ThrowTypeError("Rule must have property 'urls'.");
+      return;
+    }
+    dict.Get("types", &filter_types);
+
+    Rule rule;
+    std::string error;
+    if (!ParseFilter(filter_patterns, filter_types, &rule.filter, &error)) {
+      args->ThrowTypeError(error);
+      return;
+    }
+
+    std::string action;
+    dict.Get("action", &action);
+    if (action == "block") {
+      rule.action = RuleAction::kBlock;
+    } else if (action == "redirect") {
+      rule.action = RuleAction::kRedirect;
+      if (!dict.Get("redirectURL", &rule.redirect_url) ||
+          !rule.redirect_url.is_valid()) {
+        args->ThrowTypeError("Redirect rule must have a valid 'redirectURL'.");
+        return;
+      }
+    } else if (action == "modifyHeaders") {
+      rule.action = RuleAction::kModifyHeaders;
+      dict.Get("setRequestHeaders", &rule.set_request_headers);
+      dict.Get("removeRequestHeaders", &rule.remove_request_headers);
+      dict.Get("setResponseHeaders", &rule.set_response_headers);
+      dict.Get("removeResponseHeaders", &rule.remove_response_headers);
+      for (const auto* headers :
+           {&rule.set_request_headers, &rule.set_response_headers}) {
+        for (const auto& [name, value] : *headers) {
+          if (!net::HttpUtil::IsValidHeaderName(name) ||
+              !net::HttpUtil::IsValidHeaderValue(value)) {
+            args->ThrowTypeError("Invalid header " + name);
+            return;
+          }
+        }
+      }
+    } else {
+      args->ThrowTypeError("Invalid rule action " + action);
+      return;
+    }
+    rules.push_back(std::move(rule));
+  }
+
+  rules_ = std::move(rules);
+}
+
+// static
+bool WebRequest::ParseFilter(const std::set<std::string>& urls,
+                             const std::set<std::string>& types,
+                             RequestFilter* filter,
+                             std::string* error) {
+  for (const std::string& filter_pattern : urls) {
+    URLPattern pattern(URLPattern::SCHEME_ALL);
+    const URLPattern::ParseResult result = pattern.Parse(filter_pattern);
+    if (result != URLPattern::ParseResult::kSuccess) {
+      const char* error_type = URLPattern::GetParseResultString(result);
+      *error = "Invalid url pattern " + filter_pattern + ": " + error_type;
+      return false;
+    }
+    filter->AddUrlPattern(std::move(pattern));
+  }
+
+  for (const std::string& filter_type : types) {
+    auto type = ParseResourceType(filter_type);
+    if (type == extensions::WebRequestResourceType::OTHER) {
+      *error = "Invalid type " + filter_type;
+      return false;
+    }
+    filter->AddType(type);
+  }
+  return true;
 }
 
 template <typename... Args>
@@ -476,9 +700,44 @@ void WebRequest::HandleSimpleEvent(SimpleEvent event,
   v8::HandleScope handle_scope(isolate);
   gin_helper::Dictionary details(isolate, v8::Object::New(isolate));
   FillDetails(&details, request_info, args...);
+
+  if (info.batch_interval.is_positive()) {
+    auto& batch = batched_details_[event];
+    if (batch.empty()) {
+      base::SequencedTaskRunner::GetCurrentDefault()->PostDelayedTask(
+          FROM_HERE,
+          base::BindOnce(&WebRequest::FlushBatchedEvents,
+                         weak_factory_.GetWeakPtr(), event),
+          info.batch_interval);
+    }
+    batch.emplace_back(isolate, details.GetHandle());
+    return;
+  }
+
   info.listener.Run(gin::ConvertToV8(isolate, details));
 }
 
+void WebRequest::FlushBatchedEvents(SimpleEvent event) {
+  const auto batch_iter = batched_details_.find(event);
+  if (batch_iter == std::end(batched_details_))
+    return;
+  std::vector<v8::Global<v8::Object>> batch = std::move(batch_iter->second);
+  batched_details_.erase(batch_iter);
+
+  const auto iter = simple_listeners_.find(event);
+  if (iter == std::end(simple_listeners_))
+    return;
+
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::LocalVector<v8::Value> details(isolate);
+  details.reserve(batch.size());
+  for (const auto& item : batch)
+    details.push_back(item.Get(isolate));
+  iter->second.listener.Run(
+      v8::Array::New(isolate, details.data(), details.size()));
+}
+
 template <typename Out, typename... Args>
 int WebRequest::HandleResponseEvent(ResponseEvent event,
                                     extensions::WebRequestInfo* request_info,
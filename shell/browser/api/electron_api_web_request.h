@@ -7,14 +7,19 @@
 
 #include <map>
 #include <set>
+#include <string>
+#include <vector>
 
 #include "base/memory/raw_ptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "base/values.h"
 #include "extensions/common/url_pattern.h"
 #include "gin/arguments.h"
 #include "gin/handle.h"
 #include "gin/wrappable.h"
 #include "shell/browser/net/web_request_api_interface.h"
+#include "url/gurl.h"
 
 namespace content {
 class BrowserContext;
@@ -49,6 +54,8 @@ class WebRequest : public gin::Wrappable<WebRequest>, public WebRequestAPI {
 
   // WebRequestAPI:
   bool HasListener() const override;
+  bool MayHaveListenerForType(
+      extensions::WebRequestResourceType type) const override;
   int OnBeforeRequest(extensions::WebRequestInfo* info,
                       const network::ResourceRequest& request,
                       net::CompletionOnceCallback callback,
@@ -107,12 +114,14 @@ class WebRequest : public gin::Wrappable<WebRequest>, public WebRequestAPI {
   template <ResponseEvent event>
   void SetResponseListener(gin::Arguments* args);
   template <typename Listener, typename Listeners, typename Event>
-  void SetListener(Event event, Listeners* listeners, gin::Arguments* args);
+  bool SetListener(Event event, Listeners* listeners, gin::Arguments* args);
+  void SetRules(gin::Arguments* args);
 
   template <typename... Args>
   void HandleSimpleEvent(SimpleEvent event,
                          extensions::WebRequestInfo* info,
                          Args... args);
+  void FlushBatchedEvents(SimpleEvent event);
   template <typename Out, typename... Args>
   int HandleResponseEvent(ResponseEvent event,
                           extensions::WebRequestInfo* info,
@@ -135,18 +144,56 @@ class WebRequest : public gin::Wrappable<WebRequest>, public WebRequestAPI {
     void AddType(extensions::WebRequestResourceType type);
 
     bool MatchesRequest(extensions::WebRequestInfo* info) const;
+    bool MatchesType(extensions::WebRequestResourceType type) const;
 
    private:
     bool MatchesURL(const GURL& url) const;
-    bool MatchesType(extensions::WebRequestResourceType type) const;
 
-    std::set<URLPattern> url_patterns_;
+    // Patterns with a host are bucketed by it, so that a URL only has to be
+    // tested against the patterns for its host and the domains above it.
+    // Patterns that match any host are always tested.
+    std::map<std::string, std::vector<URLPattern>, std::less<>>
+        host_url_patterns_;
+    std::vector<URLPattern> any_host_url_patterns_;
     std::set<extensions::WebRequestResourceType> types_;
   };
 
+  // Fills |filter| from the |urls| and |types| of a WebRequestFilter. Returns
+  // false with |error| set if any of them is invalid.
+  static bool ParseFilter(const std::set<std::string>& urls,
+                          const std::set<std::string>& types,
+                          RequestFilter* filter,
+                          std::string* error);
+
+  enum class RuleAction {
+    kBlock,
+    kRedirect,
+    kModifyHeaders,
+  };
+
+  // A rule set with webRequest.setRules(), which is applied without calling
+  // into JS.
+  struct Rule {
+    Rule();
+    Rule(Rule&&);
+    Rule& operator=(Rule&&);
+    ~Rule();
+
+    RequestFilter filter;
+    RuleAction action = RuleAction::kBlock;
+    GURL redirect_url;
+    std::map<std::string, std::string> set_request_headers;
+    std::set<std::string> remove_request_headers;
+    std::map<std::string, std::string> set_response_headers;
+    std::set<std::string> remove_response_headers;
+  };
+
   struct SimpleListenerInfo {
     RequestFilter filter;
     SimpleListener listener;
+    // When positive, the listener is called with an array of the details of
+    // the events in each interval instead of once per event.
+    base::TimeDelta batch_interval;
 
     SimpleListenerInfo(RequestFilter, SimpleListener);
     SimpleListenerInfo();
@@ -163,11 +210,15 @@ class WebRequest : public gin::Wrappable<WebRequest>, public WebRequestAPI {
   };
 
   std::map<SimpleEvent, SimpleListenerInfo> simple_listeners_;
+  std::map<SimpleEvent, std::vector<v8::Global<v8::Object>>> batched_details_;
   std::map<ResponseEvent, ResponseListenerInfo> response_listeners_;
+  std::vector<Rule> rules_;
   std::map<uint64_t, net::CompletionOnceCallback> callbacks_;
 
   // Weak-ref, it manages us.
   raw_ptr<content::BrowserContext> browser_context_;
+
+  base::WeakPtrFactory<WebRequest> weak_factory_{this};
 };
 
 }  // namespace electron::api
@@ -9,24 +9,54 @@
 #include "content/public/browser/render_view_host.h"
 #include "content/public/browser/render_widget_host.h"
 #include "content/public/browser/render_widget_host_view.h"
+#include "media/base/video_frame.h"
 #include "media/capture/mojom/video_capture_buffer.mojom.h"
 #include "media/capture/mojom/video_capture_types.mojom.h"
+#include "media/media_buildflags.h"
+#include "media/video/offloading_video_encoder.h"
 #include "mojo/public/cpp/bindings/remote.h"
 #include "services/viz/privileged/mojom/compositing/frame_sink_video_capture.mojom-shared.h"
 #include "ui/gfx/geometry/size_conversions.h"
 #include "ui/gfx/image/image.h"
 #include "ui/gfx/skbitmap_operations.h"
 
+#if BUILDFLAG(ENABLE_LIBVPX)
+#include "media/video/vpx_video_encoder.h"
+#endif
+
 namespace electron::api {
 
 constexpr static int kMaxFrameRate = 30;
 
 FrameSubscriber::FrameSubscriber(content::WebContents* web_contents,
                                  const FrameCaptureCallback& callback,
-                                 bool only_dirty)
+                                 const CaptureOptions& options)
     : content::WebContentsObserver(web_contents),
       callback_(callback),
-      only_dirty_(only_dirty) {
+      options_(options) {
+  DCHECK_EQ(options_.format, media::PIXEL_FORMAT_ARGB);
+  AttachToHost(web_contents->GetPrimaryMainFrame()->GetRenderWidgetHost());
+}
+
+FrameSubscriber::FrameSubscriber(content::WebContents* web_contents,
+                                 const VideoFrameCallback& callback,
+                                 const CaptureOptions& options)
+    : content::WebContentsObserver(web_contents),
+      video_frame_callback_(callback),
+      options_(options) {
+  DCHECK_NE(options_.format, media::PIXEL_FORMAT_ARGB);
+  AttachToHost(web_contents->GetPrimaryMainFrame()->GetRenderWidgetHost());
+}
+
+FrameSubscriber::FrameSubscriber(content::WebContents* web_contents,
+                                 const EncodedFrameCallback& callback,
+                                 const EncodingOptions& options)
+    : content::WebContentsObserver(web_contents),
+      encoded_callback_(callback),
+      encoding_options_(options) {
+  // The capturer converts to I420 on the GPU before frames are encoded, which
+  // also leaves less than half as much to read back.
+  options_.format = media::PIXEL_FORMAT_I420;
   AttachToHost(web_contents->GetPrimaryMainFrame()->GetRenderWidgetHost());
 }
 
@@ -41,12 +71,12 @@ void FrameSubscriber::AttachToHost(content::RenderWidgetHost* host) {
     return;
 
   // Create and configure the video capturer.
-  gfx::Size size = GetRenderViewSize();
+  gfx::Size size = GetCaptureSize();
   video_capturer_ = host_->GetView()->CreateVideoCapturer();
   video_capturer_->SetResolutionConstraints(size, size, true);
   video_capturer_->SetAutoThrottlingEnabled(false);
   video_capturer_->SetMinSizeChangePeriod(base::TimeDelta());
-  video_capturer_->SetFormat(media::PIXEL_FORMAT_ARGB);
+  video_capturer_->SetFormat(options_.format);
   video_capturer_->SetMinCapturePeriod(base::Seconds(1) / kMaxFrameRate);
   video_capturer_->Start(this, viz::mojom::BufferFormatPreference::kDefault);
 }
@@ -86,8 +116,10 @@ void FrameSubscriber::OnFrameCaptured(
         callbacks) {
   auto& data_region = data->get_read_only_shmem_region();
 
-  gfx::Size size = GetRenderViewSize();
-  if (size != content_rect.size()) {
+  // Frames scaled to a given size are letterboxed within it, so only the
+  // view size can be compared against.
+  gfx::Size size = GetCaptureSize();
+  if (options_.size.IsEmpty() && size != content_rect.size()) {
     video_capturer_->SetResolutionConstraints(size, size, true);
     video_capturer_->RequestRefreshFrame();
     return;
@@ -110,9 +142,37 @@ void FrameSubscriber::OnFrameCaptured(
     return;
   }
 
+  if (options_.format != media::PIXEL_FORMAT_ARGB) {
+    scoped_refptr<media::VideoFrame> frame =
+        media::VideoFrame::WrapExternalData(
+            info->pixel_format, info->coded_size, content_rect,
+            content_rect.size(), static_cast<const uint8_t*>(mapping.memory()),
+            mapping.size(), info->timestamp);
+    if (!frame)
+      return;
+    // The frame may be released on the encoder's thread, so only unbound
+    // handles are kept for it.
+    frame->AddDestructionObserver(base::BindOnce(
+        [](base::ReadOnlySharedMemoryMapping mapping,
+           mojo::PendingRemote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
+               releaser) {},
+        std::move(mapping), callbacks_remote.Unbind()));
+    if (encoding_options_)
+      Encode(std::move(frame));
+    else
+      video_frame_callback_.Run(std::move(frame), content_rect);
+    return;
+  }
+
   // The SkBitmap's pixels will be marked as immutable, but the installPixels()
-  // API requires a non-const pointer. So, cast away the const.
-  void* const pixels = const_cast<void*>(mapping.memory());
+  // API requires a non-const pointer. So, cast away the const. Frames that are
+  // letterboxed start at the origin of |content_rect|.
+  const size_t stride = media::VideoFrame::RowBytes(
+      media::VideoFrame::kARGBPlane, info->pixel_format,
+      info->coded_size.width());
+  void* const pixels =
+      static_cast<uint8_t*>(const_cast<void*>(mapping.memory())) +
+      content_rect.y() * stride + content_rect.x() * 4;
 
   // Call installPixels() with a |releaseProc| that: 1) notifies the capturer
   // that this consumer has finished with the frame, and 2) releases the shared
@@ -129,16 +189,14 @@ void FrameSubscriber::OnFrameCaptured(
   bitmap.installPixels(
       SkImageInfo::MakeN32(content_rect.width(), content_rect.height(),
                            kPremul_SkAlphaType),
-      pixels,
-      media::VideoFrame::RowBytes(media::VideoFrame::kARGBPlane,
-                                  info->pixel_format, info->coded_size.width()),
+      pixels, stride,
       [](void* addr, void* context) {
         delete static_cast<FramePinner*>(context);
       },
       new FramePinner{std::move(mapping), std::move(callbacks_remote)});
   bitmap.setImmutable();
 
-  Done(content_rect, bitmap);
+  Done(gfx::Rect(content_rect.size()), bitmap);
 }
 
 void FrameSubscriber::OnNewSubCaptureTargetVersion(uint32_t crop_version) {}
@@ -153,10 +211,11 @@ void FrameSubscriber::Done(const gfx::Rect& damage, const SkBitmap& frame) {
   if (frame.drawsNothing())
     return;
 
-  const SkBitmap& bitmap = only_dirty_ ? SkBitmapOperations::CreateTiledBitmap(
-                                             frame, damage.x(), damage.y(),
-                                             damage.width(), damage.height())
-                                       : frame;
+  const SkBitmap& bitmap =
+      options_.only_dirty
+          ? SkBitmapOperations::CreateTiledBitmap(
+                frame, damage.x(), damage.y(), damage.width(), damage.height())
+          : frame;
 
   // Copying SkBitmap does not copy the internal pixels, we have to manually
   // allocate and write pixels otherwise crash may happen when the original
@@ -171,6 +230,64 @@ void FrameSubscriber::Done(const gfx::Rect& damage, const SkBitmap& frame) {
   callback_.Run(gfx::Image::CreateFrom1xBitmap(copy), damage);
 }
 
+void FrameSubscriber::Encode(scoped_refptr<media::VideoFrame> frame) {
+  if (encoder_failed_)
+    return;
+
+  // Frames are always captured at the size of the view, so the encoder only
+  // has to be made again when the view is resized.
+  bool key_frame = false;
+  if (!encoder_ || encoder_size_ != frame->visible_rect().size()) {
+    encoder_size_ = frame->visible_rect().size();
+
+    media::VideoEncoder::Options options;
+    options.frame_size = encoder_size_;
+    options.bitrate =
+        media::Bitrate::ConstantBitrate(encoding_options_->bitrate);
+    options.framerate = kMaxFrameRate;
+    options.latency_mode = media::VideoEncoder::LatencyMode::Realtime;
+
+#if BUILDFLAG(ENABLE_LIBVPX)
+    encoder_ = std::make_unique<media::OffloadingVideoEncoder>(
+        std::make_unique<media::VpxVideoEncoder>());
+#else
+    // WebContents doesn't offer encoded subscriptions without libvpx.
+    encoder_failed_ = true;
+    return;
+#endif
+    encoder_->Initialize(
+        encoding_options_->profile, options,
+        media::VideoEncoder::EncoderInfoCB(),
+        base::BindRepeating(&FrameSubscriber::OnEncoded,
+                            weak_ptr_factory_.GetWeakPtr()),
+        base::BindOnce(&FrameSubscriber::OnEncoderStatus,
+                       weak_ptr_factory_.GetWeakPtr()));
+    key_frame = true;
+  }
+
+  encoder_->Encode(std::move(frame),
+                   media::VideoEncoder::EncodeOptions(key_frame),
+                   base::BindOnce(&FrameSubscriber::OnEncoderStatus,
+                                  weak_ptr_factory_.GetWeakPtr()));
+}
+
+void FrameSubscriber::OnEncoded(
+    media::VideoEncoderOutput output,
+    std::optional<media::VideoEncoder::CodecDescription> description) {
+  encoded_callback_.Run(std::move(output));
+}
+
+void FrameSubscriber::OnEncoderStatus(media::EncoderStatus status) {
+  if (status.is_ok())
+    return;
+  LOG(ERROR) << "Failed to encode frame: " << status.message();
+  encoder_failed_ = true;
+}
+
+gfx::Size FrameSubscriber::GetCaptureSize() const {
+  return options_.size.IsEmpty() ? GetRenderViewSize() : options_.size;
+}
+
 gfx::Size FrameSubscriber::GetRenderViewSize() const {
   content::RenderWidgetHostView* view = host_->GetView();
   gfx::Size size = view->GetViewBounds().size();
@@ -6,6 +6,7 @@
 #define ELECTRON_SHELL_BROWSER_API_FRAME_SUBSCRIBER_H_
 
 #include <memory>
+#include <optional>
 #include <string>
 
 #include "base/functional/callback.h"
@@ -14,8 +15,12 @@
 #include "components/viz/host/client_frame_sink_video_capturer.h"
 #include "content/public/browser/web_contents.h"
 #include "content/public/browser/web_contents_observer.h"
+#include "media/base/video_codecs.h"
+#include "media/base/video_encoder.h"
+#include "media/base/video_types.h"
 #include "media/capture/mojom/video_capture_buffer.mojom-forward.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
+#include "ui/gfx/geometry/size.h"
 #include "v8/include/v8.h"
 
 namespace gfx {
@@ -32,10 +37,38 @@ class FrameSubscriber : public content::WebContentsObserver,
  public:
   using FrameCaptureCallback =
       base::RepeatingCallback<void(const gfx::Image&, const gfx::Rect&)>;
+  using VideoFrameCallback =
+      base::RepeatingCallback<void(scoped_refptr<media::VideoFrame>,
+                                   const gfx::Rect&)>;
+  using EncodedFrameCallback =
+      base::RepeatingCallback<void(media::VideoEncoderOutput)>;
+
+  struct CaptureOptions {
+    bool only_dirty = false;
+    // Frames are scaled to fit in |size| by the capturer when it is set, and
+    // are captured at the size of the view otherwise.
+    gfx::Size size;
+    media::VideoPixelFormat format = media::PIXEL_FORMAT_ARGB;
+  };
+
+  struct EncodingOptions {
+    media::VideoCodecProfile profile = media::VP8PROFILE_ANY;
+    uint32_t bitrate = 2'500'000;
+  };
 
   FrameSubscriber(content::WebContents* web_contents,
                   const FrameCaptureCallback& callback,
-                  bool only_dirty);
+                  const CaptureOptions& options);
+  // Passes frames in a YUV |options.format| to |callback| as they are
+  // captured, rather than as images.
+  FrameSubscriber(content::WebContents* web_contents,
+                  const VideoFrameCallback& callback,
+                  const CaptureOptions& options);
+  // Captures frames in I420 and passes them to |callback| encoded with
+  // |options|, rather than as images.
+  FrameSubscriber(content::WebContents* web_contents,
+                  const EncodedFrameCallback& callback,
+                  const EncodingOptions& options);
   ~FrameSubscriber() override;
 
   // disable copy
@@ -64,11 +97,26 @@ class FrameSubscriber : public content::WebContentsObserver,
 
   void Done(const gfx::Rect& damage, const SkBitmap& frame);
 
+  void Encode(scoped_refptr<media::VideoFrame> frame);
+  void OnEncoded(
+      media::VideoEncoderOutput output,
+      std::optional<media::VideoEncoder::CodecDescription> description);
+  void OnEncoderStatus(media::EncoderStatus status);
+
   // Get the pixel size of render view.
   gfx::Size GetRenderViewSize() const;
+  // Get the pixel size that frames are captured at.
+  gfx::Size GetCaptureSize() const;
 
   FrameCaptureCallback callback_;
-  bool only_dirty_;
+  VideoFrameCallback video_frame_callback_;
+  CaptureOptions options_;
+
+  EncodedFrameCallback encoded_callback_;
+  std::optional<EncodingOptions> encoding_options_;
+  std::unique_ptr<media::VideoEncoder> encoder_;
+  gfx::Size encoder_size_;
+  bool encoder_failed_ = false;
 
   raw_ptr<content::RenderWidgetHost> host_;
   std::unique_ptr<viz::ClientFrameSinkVideoCapturer> video_capturer_;
@@ -8,6 +8,7 @@
 
 #include "base/memory/singleton.h"
 #include "base/task/single_thread_task_runner.h"
+#include "base/task/thread_pool.h"
 #include "content/public/browser/browser_thread.h"
 #include "gpu/config/gpu_info_collector.h"
 #include "shell/browser/api/gpu_info_enumerator.h"
@@ -15,6 +16,20 @@
 
 namespace electron {
 
+namespace {
+
+// How long the basic info is used before it is collected again, in the
+// background, so that the GPUs plugged in or removed since are picked up.
+constexpr base::TimeDelta kBasicInfoMaxAge = base::Minutes(1);
+
+gpu::GPUInfo CollectBasicGraphicsInfoOffThread() {
+  gpu::GPUInfo gpu_info;
+  CollectBasicGraphicsInfo(&gpu_info);
+  return gpu_info;
+}
+
+}  // namespace
+
 GPUInfoManager* GPUInfoManager::GetInstance() {
   return base::Singleton<GPUInfoManager>::get();
 }
@@ -58,6 +73,15 @@ void GPUInfoManager::OnGpuInfoUpdate() {
 // Should be posted to the task runner
 void GPUInfoManager::CompleteInfoFetcher(
     gin_helper::Promise<base::Value> promise) {
+#if BUILDFLAG(IS_WIN)
+  // The GPU process may have already gathered everything, in which case
+  // there is nothing to wait for.
+  if (gpu_data_manager_->IsDx12VulkanVersionAvailable()) {
+    promise.Resolve(
+        base::Value(EnumerateGPUInfo(gpu_data_manager_->GetGPUInfo())));
+    return;
+  }
+#endif
   complete_info_promise_set_.emplace_back(std::move(promise));
   gpu_data_manager_->RequestDx12VulkanVideoGpuInfoIfNeeded(
       content::GpuDataManagerImpl::kGpuInfoRequestAll, /* delayed */ false);
@@ -70,12 +94,45 @@ void GPUInfoManager::FetchCompleteInfo(
                                 base::Unretained(this), std::move(promise)));
 }
 
-// This fetches the info synchronously, so no need to post to the task queue.
-// There cannot be multiple promises as they are resolved synchronously.
+// The basic info is resolved from the last collection when there is one,
+// which is refreshed in the background once it gets old.
 void GPUInfoManager::FetchBasicInfo(gin_helper::Promise<base::Value> promise) {
-  gpu::GPUInfo gpu_info;
-  CollectBasicGraphicsInfo(&gpu_info);
-  promise.Resolve(base::Value(EnumerateGPUInfo(gpu_info)));
+  if (basic_info_) {
+    promise.Resolve(base::Value(basic_info_->Clone()));
+    if (base::TimeTicks::Now() - basic_info_time_ >= kBasicInfoMaxAge)
+      CollectBasicInfo();
+    return;
+  }
+  basic_info_promise_set_.emplace_back(std::move(promise));
+  CollectBasicInfo();
+}
+
+void GPUInfoManager::CollectBasicInfo() {
+  if (collecting_basic_info_)
+    return;
+  collecting_basic_info_ = true;
+  constexpr base::TaskTraits kTraits = {base::MayBlock(),
+                                        base::TaskPriority::USER_VISIBLE};
+#if BUILDFLAG(IS_WIN)
+  // Collecting the info goes through COM on Windows.
+  auto task_runner = base::ThreadPool::CreateCOMSTATaskRunner(kTraits);
+#else
+  auto task_runner = base::ThreadPool::CreateTaskRunner(kTraits);
+#endif
+  task_runner->PostTaskAndReplyWithResult(
+      FROM_HERE, base::BindOnce(&CollectBasicGraphicsInfoOffThread),
+      base::BindOnce(&GPUInfoManager::OnBasicInfoCollected,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void GPUInfoManager::OnBasicInfoCollected(gpu::GPUInfo gpu_info) {
+  collecting_basic_info_ = false;
+  basic_info_ = EnumerateGPUInfo(std::move(gpu_info));
+  basic_info_time_ = base::TimeTicks::Now();
+  for (auto& promise : basic_info_promise_set_) {
+    promise.Resolve(base::Value(basic_info_->Clone()));
+  }
+  basic_info_promise_set_.clear();
 }
 
 base::Value::Dict GPUInfoManager::EnumerateGPUInfo(
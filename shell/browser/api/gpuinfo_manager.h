@@ -5,9 +5,12 @@
 #ifndef ELECTRON_SHELL_BROWSER_API_GPUINFO_MANAGER_H_
 #define ELECTRON_SHELL_BROWSER_API_GPUINFO_MANAGER_H_
 
+#include <optional>
 #include <vector>
 
 #include "base/memory/raw_ptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "content/browser/gpu/gpu_data_manager_impl.h"  // nogncheck
 #include "content/public/browser/gpu_data_manager.h"
 #include "content/public/browser/gpu_data_manager_observer.h"
@@ -39,10 +42,25 @@ class GPUInfoManager : public content::GpuDataManagerObserver {
   void CompleteInfoFetcher(gin_helper::Promise<base::Value> promise);
   void ProcessCompleteInfo();
 
+  // Collects the basic info on the thread pool, as it can take hundreds of
+  // milliseconds on some systems.
+  void CollectBasicInfo();
+  void OnBasicInfoCollected(gpu::GPUInfo gpu_info);
+
   // This set maintains all the promises that should be fulfilled
   // once we have the complete information data
   std::vector<gin_helper::Promise<base::Value>> complete_info_promise_set_;
+
+  // The promises waiting for the first collection of the basic info, and the
+  // last info collected, which later calls are resolved with.
+  std::vector<gin_helper::Promise<base::Value>> basic_info_promise_set_;
+  std::optional<base::Value::Dict> basic_info_;
+  base::TimeTicks basic_info_time_;
+  bool collecting_basic_info_ = false;
+
   raw_ptr<content::GpuDataManagerImpl> gpu_data_manager_;
+
+  base::WeakPtrFactory<GPUInfoManager> weak_factory_{this};
 };
 
 }  // namespace electron
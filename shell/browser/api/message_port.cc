@@ -4,11 +4,14 @@
 
 #include "shell/browser/api/message_port.h"
 
+#include <iterator>
 #include <string>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "base/containers/contains.h"
+#include "base/functional/bind.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/task/single_thread_task_runner.h"
 #include "gin/arguments.h"
@@ -76,8 +79,9 @@ void MessagePort::PostMessage(gin::Arguments* args) {
     return;
   }
 
-  electron::SerializeV8Value(args->isolate(), message_value,
-                             &transferable_message);
+  if (!electron::SerializeV8Value(args->isolate(), message_value,
+                                  &transferable_message))
+    return;
 
   v8::Local<v8::Value> transferables;
   std::vector<gin::Handle<MessagePort>> wrapped_ports;
@@ -113,10 +117,19 @@ void MessagePort::PostMessage(gin::Arguments* args) {
   }
 
   bool threw_exception = false;
-  transferable_message.ports = MessagePort::DisentanglePorts(
-      args->isolate(), wrapped_ports, &threw_exception);
+  std::vector<blink::MessagePortDescriptor> ports =
+      MessagePort::DisentanglePorts(args->isolate(), wrapped_ports,
+                                    &threw_exception);
   if (threw_exception)
     return;
+  // The listeners of the transferred ports may have closed or transferred
+  // this one.
+  if (!IsEntangled())
+    return;
+  // The port that carries shared SharedArrayBuffers, if any, stays last.
+  transferable_message.ports.insert(transferable_message.ports.begin(),
+                                    std::make_move_iterator(ports.begin()),
+                                    std::make_move_iterator(ports.end()));
 
   mojo::Message mojo_message = blink::mojom::TransferableMessage::WrapAsMessage(
       std::move(transferable_message));
@@ -148,6 +161,9 @@ void MessagePort::Close() {
   if (!HasPendingActivity())
     Unpin();
 
+  // The messages received before the port was closed come before "close".
+  FlushPendingMessages();
+
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope scope(isolate);
   v8::Local<v8::Object> self;
@@ -155,6 +171,11 @@ void MessagePort::Close() {
     gin_helper::EmitEvent(isolate, self, "close");
 }
 
+void MessagePort::SetBatching(bool batching) {
+  // The messages already queued are still emitted by the posted task.
+  batching_ = batching;
+}
+
 void MessagePort::Entangle(blink::MessagePortDescriptor port) {
   DCHECK(port.IsValid());
   DCHECK(!connector_);
@@ -179,6 +200,7 @@ void MessagePort::Entangle(blink::MessagePortChannel channel) {
 
 blink::MessagePortChannel MessagePort::Disentangle() {
   DCHECK(!IsNeutered());
+  regions_waiter_.Cancel();
   port_.GiveDisentangledHandle(connector_->PassMessagePipe());
   connector_ = nullptr;
   if (!HasPendingActivity())
@@ -216,6 +238,14 @@ std::vector<blink::MessagePortChannel> MessagePort::DisentanglePorts(
   if (ports.empty())
     return std::vector<blink::MessagePortChannel>();
 
+  // A batching port may already have taken messages off its pipe, which would
+  // not go with it, so they are emitted before the ports are checked and
+  // handed on.
+  for (const auto& port : ports) {
+    if (port.get())
+      port->FlushPendingMessages();
+  }
+
   std::unordered_set<MessagePort*> visited;
 
   // Walk the incoming array - if there are any duplicate ports, or null ports
@@ -261,6 +291,43 @@ void MessagePort::Unpin() {
   pinned_.Reset();
 }
 
+v8::Local<v8::Value> MessagePort::CreateMessageEvent(
+    v8::Isolate* isolate,
+    blink::TransferableMessage message) {
+  // Takes the port that carries shared SharedArrayBuffers out of the message.
+  v8::Local<v8::Value> message_value = DeserializeV8Value(isolate, &message);
+
+  auto ports = EntanglePorts(isolate, std::move(message.ports));
+
+  return gin::DataObjectBuilder(isolate)
+      .Set("data", message_value)
+      .Set("ports", ports)
+      .Build();
+}
+
+void MessagePort::FlushPendingMessages() {
+  if (pending_messages_.empty())
+    return;
+
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope scope(isolate);
+
+  std::vector<blink::TransferableMessage> messages =
+      std::exchange(pending_messages_, {});
+  v8::Local<v8::Object> self;
+  if (!GetWrapper(isolate).ToLocal(&self))
+    return;
+
+  std::vector<v8::Local<v8::Value>> events;
+  events.reserve(messages.size());
+  for (auto& message : messages)
+    events.push_back(CreateMessageEvent(isolate, std::move(message)));
+  // A single call into JavaScript for the whole batch, which is what makes
+  // high volumes of small messages cheaper.
+  gin_helper::EmitEvent(isolate, self, "messages",
+                        v8::Array::New(isolate, events.data(), events.size()));
+}
+
 bool MessagePort::Accept(mojo::Message* mojo_message) {
   blink::TransferableMessage message;
   if (!blink::mojom::TransferableMessage::DeserializeFromMessage(
@@ -268,22 +335,47 @@ bool MessagePort::Accept(mojo::Message* mojo_message) {
     return false;
   }
 
-  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
-  v8::HandleScope scope(isolate);
+  if (regions_waiter_.Wait(
+          message, base::BindOnce(&MessagePort::OnSharedArrayBuffersArrived,
+                                  base::Unretained(this)))) {
+    connector_->PauseIncomingMethodCallProcessing();
+    return true;
+  }
+  return AcceptMessage(std::move(message));
+}
 
-  auto ports = EntanglePorts(isolate, std::move(message.ports));
+void MessagePort::OnSharedArrayBuffersArrived(
+    blink::TransferableMessage message) {
+  AcceptMessage(std::move(message));
+  // The listeners may have closed or transferred the port.
+  if (connector_ && started_)
+    connector_->ResumeIncomingMethodCallProcessing();
+}
 
-  v8::Local<v8::Value> message_value = DeserializeV8Value(isolate, message);
+bool MessagePort::AcceptMessage(blink::TransferableMessage message) {
+  // Keeps queueing after batching is turned off until the queue is emptied, so
+  // that the messages stay in order.
+  if (batching_ || !pending_messages_.empty()) {
+    pending_messages_.push_back(std::move(message));
+    // The connector dispatches the messages that are already in the pipe in
+    // one go, so they are all queued by the time the task runs.
+    if (pending_messages_.size() == 1) {
+      base::SingleThreadTaskRunner::GetCurrentDefault()->PostTask(
+          FROM_HERE, base::BindOnce(&MessagePort::FlushPendingMessages,
+                                    weak_factory_.GetWeakPtr()));
+    }
+    return true;
+  }
+
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope scope(isolate);
 
   v8::Local<v8::Object> self;
   if (!GetWrapper(isolate).ToLocal(&self))
     return false;
 
-  auto event = gin::DataObjectBuilder(isolate)
-                   .Set("data", message_value)
-                   .Set("ports", ports)
-                   .Build();
-  gin_helper::EmitEvent(isolate, self, "message", event);
+  gin_helper::EmitEvent(isolate, self, "message",
+                        CreateMessageEvent(isolate, std::move(message)));
   return true;
 }
 
@@ -292,7 +384,8 @@ gin::ObjectTemplateBuilder MessagePort::GetObjectTemplateBuilder(
   return gin::Wrappable<MessagePort>::GetObjectTemplateBuilder(isolate)
       .SetMethod("postMessage", &MessagePort::PostMessage)
       .SetMethod("start", &MessagePort::Start)
-      .SetMethod("close", &MessagePort::Close);
+      .SetMethod("close", &MessagePort::Close)
+      .SetMethod("setBatching", &MessagePort::SetBatching);
 }
 
 const char* MessagePort::GetTypeName() {
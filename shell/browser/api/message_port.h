@@ -12,8 +12,10 @@
 #include "mojo/public/cpp/bindings/connector.h"
 #include "mojo/public/cpp/bindings/message.h"
 #include "shell/common/gin_helper/cleaned_up_at_exit.h"
+#include "shell/common/v8_value_serializer.h"
 #include "third_party/blink/public/common/messaging/message_port_channel.h"
 #include "third_party/blink/public/common/messaging/message_port_descriptor.h"
+#include "third_party/blink/public/common/messaging/transferable_message.h"
 
 namespace gin {
 class Arguments;
@@ -34,6 +36,9 @@ class MessagePort : public gin::Wrappable<MessagePort>,
   void PostMessage(gin::Arguments* args);
   void Start();
   void Close();
+  // While batching, the messages that arrive together are emitted in one
+  // "messages" event rather than one "message" event each.
+  void SetBatching(bool batching);
 
   void Entangle(blink::MessagePortDescriptor port);
   void Entangle(blink::MessagePortChannel channel);
@@ -73,12 +78,28 @@ class MessagePort : public gin::Wrappable<MessagePort>,
   void Pin();
   void Unpin();
 
+  v8::Local<v8::Value> CreateMessageEvent(v8::Isolate* isolate,
+                                          blink::TransferableMessage message);
+  void FlushPendingMessages();
+
+  bool AcceptMessage(blink::TransferableMessage message);
+  void OnSharedArrayBuffersArrived(blink::TransferableMessage message);
+
   // mojo::MessageReceiver
   bool Accept(mojo::Message* mojo_message) override;
 
   std::unique_ptr<mojo::Connector> connector_;
   bool started_ = false;
   bool closed_ = false;
+  bool batching_ = false;
+
+  // The messages received while batching, emitted by a task posted when the
+  // first of them arrives.
+  std::vector<blink::TransferableMessage> pending_messages_;
+
+  // Holds back the message whose SharedArrayBuffers are still on their way,
+  // with |connector_| paused so that the next ones wait behind it.
+  SharedArrayBufferRegionsWaiter regions_waiter_;
 
   v8::Global<v8::Value> pinned_;
 
@@ -15,7 +15,20 @@
 #include "base/win/win_util.h"
 #endif
 
+#if BUILDFLAG(IS_LINUX)
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/strings/stringprintf.h"
+#endif
+
 #if BUILDFLAG(IS_MAC)
+#include <libproc.h>
 #include <mach/mach.h>
 #include "base/process/port_provider_mac.h"
 #include "content/public/browser/browser_child_process_host.h"
@@ -43,10 +56,52 @@ std::optional<mach_task_basic_info_data_t> GetTaskInfo(mach_port_t task) {
   return (kr == KERN_SUCCESS) ? std::make_optional(info) : std::nullopt;
 }
 
+std::optional<task_vm_info_data_t> GetTaskVMInfo(mach_port_t task) {
+  if (task == MACH_PORT_NULL)
+    return std::nullopt;
+  task_vm_info_data_t info = {};
+  mach_msg_type_number_t count = TASK_VM_INFO_COUNT;
+  kern_return_t kr = task_info(task, TASK_VM_INFO,
+                               reinterpret_cast<task_info_t>(&info), &count);
+  return (kr == KERN_SUCCESS) ? std::make_optional(info) : std::nullopt;
+}
+
 }  // namespace
 
 #endif  // BUILDFLAG(IS_MAC)
 
+#if BUILDFLAG(IS_LINUX)
+
+namespace {
+
+std::string ReadProcFile(base::ProcessId pid, const char* name) {
+  std::string contents;
+  base::ReadFileToString(
+      base::FilePath(base::StringPrintf("/proc/%d/%s", pid, name)),
+      &contents);
+  return contents;
+}
+
+// Finds the number in the "key: value" line of |key| in a /proc file, where
+// memory values are followed by their " kB" unit.
+uint64_t GetProcValue(std::string_view contents, std::string_view key) {
+  for (std::string_view line :
+       base::SplitStringPiece(contents, "\n", base::TRIM_WHITESPACE,
+                              base::SPLIT_WANT_NONEMPTY)) {
+    std::vector<std::string_view> parts = base::SplitStringPiece(
+        line, ": ", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+    uint64_t value = 0;
+    if (parts.size() >= 2 && parts[0] == key &&
+        base::StringToUint64(parts[1], &value))
+      return value;
+  }
+  return 0;
+}
+
+}  // namespace
+
+#endif  // BUILDFLAG(IS_LINUX)
+
 namespace electron {
 
 ProcessMetric::ProcessMetric(int type,
@@ -71,6 +126,12 @@ ProcessMetric::ProcessMetric(int type,
 
 ProcessMetric::~ProcessMetric() = default;
 
+#if BUILDFLAG(IS_POSIX)
+int ProcessMetric::GetHandleCount() const {
+  return metrics->GetOpenFdCount();
+}
+#endif
+
 #if BUILDFLAG(IS_WIN)
 
 ProcessMemoryInfo ProcessMetric::GetMemoryInfo() const {
@@ -88,6 +149,25 @@ ProcessMemoryInfo ProcessMetric::GetMemoryInfo() const {
   return result;
 }
 
+ProcessIOCounters ProcessMetric::GetIOCounters() const {
+  ProcessIOCounters result;
+
+  IO_COUNTERS info = {};
+  if (::GetProcessIoCounters(process.Handle(), &info)) {
+    result.read_bytes = info.ReadTransferCount;
+    result.write_bytes = info.WriteTransferCount;
+  }
+
+  return result;
+}
+
+int ProcessMetric::GetHandleCount() const {
+  DWORD count = 0;
+  if (!::GetProcessHandleCount(process.Handle(), &count))
+    return -1;
+  return static_cast<int>(count);
+}
+
 ProcessIntegrityLevel ProcessMetric::GetIntegrityLevel() const {
   HANDLE token = nullptr;
   if (!::OpenProcessToken(process.Handle(), TOKEN_QUERY, &token)) {
@@ -150,10 +230,28 @@ bool ProcessMetric::IsSandboxed(ProcessIntegrityLevel integrity_level) {
 ProcessMemoryInfo ProcessMetric::GetMemoryInfo() const {
   ProcessMemoryInfo result;
 
-  if (auto info = GetTaskInfo(TaskForPid(process.Pid()))) {
+  mach_port_t task = TaskForPid(process.Pid());
+  if (auto info = GetTaskInfo(task)) {
     result.working_set_size = info->resident_size;
     result.peak_working_set_size = info->resident_size_max;
   }
+  // The physical footprint is what Activity Monitor reports as the memory of
+  // a process.
+  if (auto vm_info = GetTaskVMInfo(task))
+    result.private_bytes = vm_info->phys_footprint;
+
+  return result;
+}
+
+ProcessIOCounters ProcessMetric::GetIOCounters() const {
+  ProcessIOCounters result;
+
+  rusage_info_v2 info = {};
+  if (proc_pid_rusage(process.Pid(), RUSAGE_INFO_V2,
+                      reinterpret_cast<rusage_info_t*>(&info)) == 0) {
+    result.read_bytes = info.ri_diskio_bytesread;
+    result.write_bytes = info.ri_diskio_byteswritten;
+  }
 
   return result;
 }
@@ -168,4 +266,36 @@ bool ProcessMetric::IsSandboxed() const {
 
 #endif  // BUILDFLAG(IS_MAC)
 
+#if BUILDFLAG(IS_LINUX)
+
+ProcessMemoryInfo ProcessMetric::GetMemoryInfo() const {
+  ProcessMemoryInfo result;
+
+  std::string status = ReadProcFile(process.Pid(), "status");
+  result.working_set_size = GetProcValue(status, "VmRSS") << 10;
+  result.peak_working_set_size = GetProcValue(status, "VmHWM") << 10;
+
+  // smaps_rollup sums up the mappings of smaps without listing them all, and
+  // is not readable for processes of other users, which are left at zero.
+  std::string smaps = ReadProcFile(process.Pid(), "smaps_rollup");
+  result.private_bytes = (GetProcValue(smaps, "Private_Clean") +
+                          GetProcValue(smaps, "Private_Dirty"))
+                         << 10;
+  result.proportional_set_size = GetProcValue(smaps, "Pss") << 10;
+
+  return result;
+}
+
+ProcessIOCounters ProcessMetric::GetIOCounters() const {
+  ProcessIOCounters result;
+
+  std::string io = ReadProcFile(process.Pid(), "io");
+  result.read_bytes = GetProcValue(io, "read_bytes");
+  result.write_bytes = GetProcValue(io, "write_bytes");
+
+  return result;
+}
+
+#endif  // BUILDFLAG(IS_LINUX)
+
 }  // namespace electron
@@ -5,6 +5,7 @@
 #ifndef ELECTRON_SHELL_BROWSER_API_PROCESS_METRIC_H_
 #define ELECTRON_SHELL_BROWSER_API_PROCESS_METRIC_H_
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -14,15 +15,23 @@
 
 namespace electron {
 
-#if !BUILDFLAG(IS_LINUX)
 struct ProcessMemoryInfo {
   size_t working_set_size = 0;
   size_t peak_working_set_size = 0;
-#if BUILDFLAG(IS_WIN)
+  // The memory not shared with other processes: the private usage on Windows,
+  // the physical footprint on macOS and the private resident pages on Linux.
   size_t private_bytes = 0;
+#if BUILDFLAG(IS_LINUX)
+  // The resident memory with the pages shared with other processes divided
+  // between them.
+  size_t proportional_set_size = 0;
 #endif
 };
-#endif
+
+struct ProcessIOCounters {
+  uint64_t read_bytes = 0;
+  uint64_t write_bytes = 0;
+};
 
 #if BUILDFLAG(IS_WIN)
 enum class ProcessIntegrityLevel {
@@ -48,9 +57,13 @@ struct ProcessMetric {
                 const std::string& name = std::string());
   ~ProcessMetric();
 
-#if !BUILDFLAG(IS_LINUX)
   ProcessMemoryInfo GetMemoryInfo() const;
-#endif
+  // The bytes read and written by the process since it started.
+  ProcessIOCounters GetIOCounters() const;
+
+  // The number of handles the process has open, or of file descriptors on
+  // POSIX. Returns -1 when it can't be read.
+  int GetHandleCount() const;
 
 #if BUILDFLAG(IS_WIN)
   ProcessIntegrityLevel GetIntegrityLevel() const;
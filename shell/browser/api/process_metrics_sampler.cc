@@ -0,0 +1,182 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/process_metrics_sampler.h"
+
+#include <utility>
+
+#include "base/containers/circular_deque.h"
+#include "base/containers/flat_map.h"
+#include "base/files/file.h"
+#include "base/functional/bind.h"
+#include "base/logging.h"
+#include "base/strings/stringprintf.h"
+#include "base/system/sys_info.h"
+#include "base/task/thread_pool.h"
+#include "base/timer/timer.h"
+#include "content/public/common/process_type.h"
+#include "shell/browser/api/process_metric.h"
+
+namespace electron {
+
+namespace {
+
+struct Sample {
+  double timestamp = 0;
+  double percent_cpu_usage = 0;
+  double working_set_size = 0;
+  double handle_count = 0;
+  double io_read_bytes = 0;
+  double io_write_bytes = 0;
+};
+
+}  // namespace
+
+class ProcessMetricsSampler::Core {
+ public:
+  explicit Core(const Options& options)
+      : options_(options),
+        processor_count_(base::SysInfo::NumberOfProcessors()) {
+    if (!options_.path.empty())
+      OpenFile();
+    timer_.Start(FROM_HERE, options_.interval,
+                 base::BindRepeating(&Core::TakeSamples,
+                                     base::Unretained(this)));
+  }
+
+  // disable copy
+  Core(const Core&) = delete;
+  Core& operator=(const Core&) = delete;
+
+  void AddProcess(int id, std::unique_ptr<ProcessMetric> metric) {
+    Process& process = processes_[id];
+    process.metric = std::move(metric);
+    process.samples.clear();
+  }
+
+  void RemoveProcess(int id) { processes_.erase(id); }
+
+  std::vector<Samples> GetSamples() const {
+    std::vector<Samples> result;
+    result.reserve(processes_.size());
+    for (const auto& [id, process] : processes_) {
+      Samples samples;
+      samples.pid = process.metric->process.Pid();
+      samples.type = process.metric->type;
+      samples.service_name = process.metric->service_name;
+      samples.name = process.metric->name;
+      for (const Sample& sample : process.samples) {
+        samples.timestamps.push_back(sample.timestamp);
+        samples.percent_cpu_usage.push_back(sample.percent_cpu_usage);
+        samples.working_set_size.push_back(sample.working_set_size);
+        samples.handle_count.push_back(sample.handle_count);
+        samples.io_read_bytes.push_back(sample.io_read_bytes);
+        samples.io_write_bytes.push_back(sample.io_write_bytes);
+      }
+      result.push_back(std::move(samples));
+    }
+    return result;
+  }
+
+ private:
+  struct Process {
+    std::unique_ptr<ProcessMetric> metric;
+    base::circular_deque<Sample> samples;
+  };
+
+  void OpenFile() {
+    file_.Initialize(options_.path,
+                     base::File::FLAG_OPEN_ALWAYS | base::File::FLAG_APPEND);
+    if (!file_.IsValid()) {
+      LOG(ERROR) << "Failed to open " << options_.path
+                 << " for writing process metrics: "
+                 << base::File::ErrorToString(file_.error_details());
+      return;
+    }
+    if (file_.GetLength() == 0) {
+      Write(
+          "timestamp,pid,type,percentCPUUsage,workingSetSize,handleCount,"
+          "ioReadBytes,ioWriteBytes\n");
+    }
+  }
+
+  void Write(const std::string& data) {
+    if (file_.WriteAtCurrentPos(data.data(), data.size()) !=
+        static_cast<int>(data.size())) {
+      LOG(ERROR) << "Failed to write process metrics to " << options_.path;
+      file_.Close();
+    }
+  }
+
+  void TakeSamples() {
+    double timestamp = base::Time::Now().InMillisecondsFSinceUnixEpoch();
+    std::string lines;
+    for (auto& [id, process] : processes_) {
+      ProcessMetric& metric = *process.metric;
+      Sample sample;
+      sample.timestamp = timestamp;
+      sample.percent_cpu_usage =
+          metric.metrics->GetPlatformIndependentCPUUsage().value_or(0) /
+          processor_count_;
+      sample.working_set_size = metric.GetMemoryInfo().working_set_size >> 10;
+      sample.handle_count = metric.GetHandleCount();
+      ProcessIOCounters io_counters = metric.GetIOCounters();
+      sample.io_read_bytes = io_counters.read_bytes;
+      sample.io_write_bytes = io_counters.write_bytes;
+
+      if (process.samples.size() == options_.sample_count)
+        process.samples.pop_front();
+      process.samples.push_back(sample);
+
+      if (file_.IsValid()) {
+        lines += base::StringPrintf(
+            "%.0f,%d,%s,%.3f,%.0f,%.0f,%.0f,%.0f\n", sample.timestamp,
+            metric.process.Pid(),
+            content::GetProcessTypeNameInEnglish(metric.type).c_str(),
+            sample.percent_cpu_usage, sample.working_set_size,
+            sample.handle_count, sample.io_read_bytes, sample.io_write_bytes);
+      }
+    }
+    if (!lines.empty())
+      Write(lines);
+  }
+
+  const Options options_;
+  const int processor_count_;
+  base::flat_map<int, Process> processes_;
+  base::File file_;
+  base::RepeatingTimer timer_;
+};
+
+ProcessMetricsSampler::Samples::Samples() = default;
+
+ProcessMetricsSampler::Samples::Samples(Samples&&) = default;
+
+ProcessMetricsSampler::Samples& ProcessMetricsSampler::Samples::operator=(
+    Samples&&) = default;
+
+ProcessMetricsSampler::Samples::~Samples() = default;
+
+ProcessMetricsSampler::ProcessMetricsSampler(const Options& options)
+    : core_(base::ThreadPool::CreateSequencedTaskRunner(
+                {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+                 base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN}),
+            options) {}
+
+ProcessMetricsSampler::~ProcessMetricsSampler() = default;
+
+void ProcessMetricsSampler::AddProcess(int id,
+                                       std::unique_ptr<ProcessMetric> metric) {
+  core_.AsyncCall(&Core::AddProcess).WithArgs(id, std::move(metric));
+}
+
+void ProcessMetricsSampler::RemoveProcess(int id) {
+  core_.AsyncCall(&Core::RemoveProcess).WithArgs(id);
+}
+
+void ProcessMetricsSampler::GetSamples(SamplesCallback callback) {
+  core_.AsyncCall(&Core::GetSamples).Then(std::move(callback));
+}
+
+}  // namespace electron
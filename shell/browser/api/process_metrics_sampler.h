@@ -0,0 +1,82 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_API_PROCESS_METRICS_SAMPLER_H_
+#define ELECTRON_SHELL_BROWSER_API_PROCESS_METRICS_SAMPLER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/functional/callback_forward.h"
+#include "base/process/process_handle.h"
+#include "base/threading/sequence_bound.h"
+#include "base/time/time.h"
+
+namespace electron {
+
+struct ProcessMetric;
+
+// Samples the CPU usage, memory, handle count and I/O of the processes of
+// the app at a fixed interval on a background sequence, so that the numbers
+// don't depend on how often they are asked for. The most recent samples of
+// every process are kept, and each one can also be appended to a CSV file.
+class ProcessMetricsSampler {
+ public:
+  struct Options {
+    base::TimeDelta interval;
+    size_t sample_count = 0;
+    // Where to append the samples to, if not empty.
+    base::FilePath path;
+  };
+
+  // The samples of one process, oldest first, with an element per sample in
+  // each vector.
+  struct Samples {
+    Samples();
+    Samples(Samples&&);
+    Samples& operator=(Samples&&);
+    ~Samples();
+
+    base::ProcessId pid = base::kNullProcessId;
+    int type = 0;
+    std::string service_name;
+    std::string name;
+    // In milliseconds since the epoch.
+    std::vector<double> timestamps;
+    std::vector<double> percent_cpu_usage;
+    // In kilobytes.
+    std::vector<double> working_set_size;
+    std::vector<double> handle_count;
+    std::vector<double> io_read_bytes;
+    std::vector<double> io_write_bytes;
+  };
+
+  using SamplesCallback = base::OnceCallback<void(std::vector<Samples>)>;
+
+  explicit ProcessMetricsSampler(const Options& options);
+  ~ProcessMetricsSampler();
+
+  // disable copy
+  ProcessMetricsSampler(const ProcessMetricsSampler&) = delete;
+  ProcessMetricsSampler& operator=(const ProcessMetricsSampler&) = delete;
+
+  // |id| is the same key App uses for its process metrics. |metric| is only
+  // used on the background sequence from then on.
+  void AddProcess(int id, std::unique_ptr<ProcessMetric> metric);
+  void RemoveProcess(int id);
+
+  // Runs |callback| with the samples of the processes that are still alive.
+  void GetSamples(SamplesCallback callback);
+
+ private:
+  class Core;
+
+  base::SequenceBound<Core> core_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_API_PROCESS_METRICS_SAMPLER_H_
@@ -80,6 +80,9 @@ void AutoUpdater::SetFeedURL(gin::Arguments* args) {
 
   NSURL* url = [NSURL URLWithString:base::SysUTF8ToNSString(feed)];
   NSMutableURLRequest* urlRequest = [NSMutableURLRequest requestWithURL:url];
+  // Squirrel.Mac copies the feed request for the download of the update, so
+  // that gets the lower priority of background traffic too.
+  urlRequest.networkServiceType = NSURLNetworkServiceTypeBackground;
 
   for (const auto& it : requestHeaders) {
     [urlRequest setValue:base::SysUTF8ToNSString(it.second)
@@ -35,19 +35,21 @@ void ElectronApiIPCHandlerImpl::OnConnectionError() {
   delete this;
 }
 
-void ElectronApiIPCHandlerImpl::Message(bool internal,
-                                        const std::string& channel,
-                                        blink::CloneableMessage arguments) {
+void ElectronApiIPCHandlerImpl::Message(
+    bool internal,
+    const std::string& channel,
+    mojom::SerializedArgumentsPtr arguments) {
   api::WebContents* api_web_contents = api::WebContents::From(web_contents());
   if (api_web_contents) {
     api_web_contents->Message(internal, channel, std::move(arguments),
                               GetRenderFrameHost());
   }
 }
-void ElectronApiIPCHandlerImpl::Invoke(bool internal,
-                                       const std::string& channel,
-                                       blink::CloneableMessage arguments,
-                                       InvokeCallback callback) {
+void ElectronApiIPCHandlerImpl::Invoke(
+    bool internal,
+    const std::string& channel,
+    mojom::SerializedArgumentsPtr arguments,
+    InvokeCallback callback) {
   api::WebContents* api_web_contents = api::WebContents::From(web_contents());
   if (api_web_contents) {
     api_web_contents->Invoke(internal, channel, std::move(arguments),
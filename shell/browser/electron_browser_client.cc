@@ -118,6 +118,7 @@
 #include "third_party/blink/public/common/associated_interfaces/associated_interface_registry.h"
 #include "third_party/blink/public/common/loader/url_loader_throttle.h"
 #include "third_party/blink/public/common/renderer_preferences/renderer_preferences.h"
+#include "third_party/blink/public/common/switches.h"
 #include "third_party/blink/public/common/tokens/tokens.h"
 #include "third_party/blink/public/common/web_preferences/web_preferences.h"
 #include "third_party/blink/public/mojom/badging/badging.mojom.h"
@@ -176,6 +177,7 @@
 #include "extensions/common/mojom/guest_view.mojom.h"
 #include "extensions/common/mojom/renderer_host.mojom.h"
 #include "extensions/common/switches.h"
+#include "shell/browser/extensions/electron_extension_activation_throttle.h"
 #include "shell/browser/extensions/electron_extension_system.h"
 #include "shell/browser/extensions/electron_extension_web_contents_observer.h"
 #endif
@@ -235,6 +237,22 @@ void SetApplicationLocaleOnIOThread(const std::string& locale) {
   *g_io_thread_application_locale = locale;
 }
 
+// Appends the V8 flags the main process was given with |switch_name| for the
+// processes of one type to the --js-flags of |command_line|.
+void AppendProcessTypeJsFlags(base::CommandLine* command_line,
+                              const char* switch_name) {
+  const auto* browser_command_line = base::CommandLine::ForCurrentProcess();
+  if (!browser_command_line->HasSwitch(switch_name))
+    return;
+  std::string js_flags =
+      command_line->GetSwitchValueASCII(blink::switches::kJavaScriptFlags);
+  if (!js_flags.empty())
+    js_flags.push_back(' ');
+  js_flags.append(browser_command_line->GetSwitchValueASCII(switch_name));
+  command_line->RemoveSwitch(blink::switches::kJavaScriptFlags);
+  command_line->AppendSwitchASCII(blink::switches::kJavaScriptFlags, js_flags);
+}
+
 void BindNetworkHintsHandler(
     content::RenderFrameHost* frame_host,
     mojo::PendingReceiver<network_hints::mojom::NetworkHintsHandler> receiver) {
@@ -523,17 +541,22 @@ void ElectronBrowserClient::AppendExtraCommandLineSwitches(
       process_type == ::switches::kRendererProcess) {
     // Copy following switches to child process.
     static const char* const kCommonSwitchNames[] = {
-        switches::kStandardSchemes,      switches::kEnableSandbox,
-        switches::kSecureSchemes,        switches::kBypassCSPSchemes,
-        switches::kCORSSchemes,          switches::kFetchSchemes,
-        switches::kServiceWorkerSchemes, switches::kStreamingSchemes,
-        switches::kCodeCacheSchemes};
+        switches::kStandardSchemes,        switches::kEnableSandbox,
+        switches::kSecureSchemes,          switches::kBypassCSPSchemes,
+        switches::kCORSSchemes,            switches::kFetchSchemes,
+        switches::kServiceWorkerSchemes,   switches::kStreamingSchemes,
+        switches::kCodeCacheSchemes,       switches::kAsarIndexCacheDir,
+        switches::kAsarExtractionCacheDir, switches::kV8WorkerThreads};
     command_line->CopySwitchesFrom(*base::CommandLine::ForCurrentProcess(),
                                    kCommonSwitchNames);
     if (process_type == ::switches::kUtilityProcess ||
         content::RenderProcessHost::FromID(process_id)) {
       MaybeAppendSecureOriginsAllowlistSwitch(command_line);
     }
+    AppendProcessTypeJsFlags(command_line,
+                             process_type == ::switches::kUtilityProcess
+                                 ? switches::kUtilityJsFlags
+                                 : switches::kRendererJsFlags);
   }
 
   if (process_type == ::switches::kRendererProcess) {
@@ -731,6 +754,16 @@ void ElectronBrowserClient::SiteInstanceGotProcessAndSite(
 bool ElectronBrowserClient::IsSuitableHost(
     content::RenderProcessHost* process_host,
     const GURL& site_url) {
+  // Pages of process-per-site schemes only share sandboxed renderers, which
+  // don't have Node.js integration.
+  if (base::Contains(api::GetProcessPerSiteSchemes(), site_url.scheme())) {
+    auto* web_contents = GetWebContentsFromProcessID(process_host->GetID());
+    auto* web_preferences =
+        web_contents ? WebContentsPreferences::From(web_contents) : nullptr;
+    if (!web_preferences || !web_preferences->IsSandboxed())
+      return false;
+  }
+
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   auto* browser_context = process_host->GetBrowserContext();
   extensions::ExtensionRegistry* registry =
@@ -752,6 +785,8 @@ bool ElectronBrowserClient::IsSuitableHost(
 bool ElectronBrowserClient::ShouldUseProcessPerSite(
     content::BrowserContext* browser_context,
     const GURL& effective_url) {
+  if (base::Contains(api::GetProcessPerSiteSchemes(), effective_url.scheme()))
+    return true;
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   const extensions::Extension* extension =
       GetEnabledExtensionFromEffectiveURL(browser_context, effective_url);
@@ -940,6 +975,12 @@ std::vector<std::unique_ptr<content::NavigationThrottle>>
 ElectronBrowserClient::CreateThrottlesForNavigation(
     content::NavigationHandle* handle) {
   std::vector<std::unique_ptr<content::NavigationThrottle>> throttles;
+#if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
+  // Goes first, so that the other throttles see the activated extensions.
+  throttles.push_back(
+      std::make_unique<extensions::ElectronExtensionActivationThrottle>(
+          handle));
+#endif
   throttles.push_back(std::make_unique<ElectronNavigationThrottle>(handle));
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
@@ -1240,7 +1281,10 @@ bool ElectronBrowserClient::WillInterceptWebSocket(
   if (!web_request.get())
     return false;
 
-  bool has_listener = web_request->HasListener();
+  // Sockets are only proxied when some listener could see them, so filters
+  // that only cover HTTP requests don't slow down every handshake.
+  bool has_listener = web_request->MayHaveListenerForType(
+      extensions::WebRequestResourceType::WEB_SOCKET);
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   const auto* web_request_api =
       extensions::BrowserContextKeyedAPIFactory<extensions::WebRequestAPI>::Get(
@@ -1269,7 +1313,8 @@ void ElectronBrowserClient::CreateWebSocket(
   DCHECK(web_request.get());
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
-  if (!web_request->HasListener()) {
+  if (!web_request->MayHaveListenerForType(
+          extensions::WebRequestResourceType::WEB_SOCKET)) {
     auto* web_request_api = extensions::BrowserContextKeyedAPIFactory<
         extensions::WebRequestAPI>::Get(browser_context);
 
@@ -4,14 +4,17 @@
 
 #include "shell/browser/electron_browser_context.h"
 
+#include <algorithm>
 #include <memory>
 
 #include <utility>
+#include <vector>
 
 #include "base/barrier_closure.h"
 #include "base/base_paths.h"
 #include "base/command_line.h"
 #include "base/files/file_path.h"
+#include "base/functional/bind.h"
 #include "base/no_destructor.h"
 #include "base/path_service.h"
 #include "base/strings/escape.h"
@@ -21,6 +24,7 @@
 #include "chrome/common/pref_names.h"
 #include "components/keyed_service/content/browser_context_dependency_manager.h"
 #include "components/prefs/json_pref_store.h"
+#include "components/prefs/overlay_user_pref_store.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/pref_service.h"
 #include "components/prefs/pref_service_factory.h"
@@ -28,6 +32,7 @@
 #include "components/proxy_config/pref_proxy_config_tracker_impl.h"
 #include "components/proxy_config/proxy_config_pref_names.h"
 #include "content/browser/blob_storage/chrome_blob_storage_context.h"  // nogncheck
+#include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/cors_origin_pattern_setter.h"
 #include "content/public/browser/host_zoom_map.h"
@@ -46,7 +51,9 @@
 #include "shell/browser/electron_download_manager_delegate.h"
 #include "shell/browser/electron_permission_manager.h"
 #include "shell/browser/net/resolve_proxy_helper.h"
+#include "shell/browser/preconnect_predictor.h"
 #include "shell/browser/protocol_registry.h"
+#include "shell/browser/spare_renderer_pool.h"
 #include "shell/browser/special_storage_policy.h"
 #include "shell/browser/ui/inspectable_web_contents.h"
 #include "shell/browser/web_contents_permission_helper.h"
@@ -97,6 +104,10 @@ namespace electron {
 
 namespace {
 
+// How long changes to lossy prefs wait to be written, unless
+// --prefs-write-interval says otherwise.
+constexpr int kDefaultLossyPrefsWriteIntervalSeconds = 30;
+
 // Copied from chrome/browser/media/webrtc/desktop_capture_devices_util.cc.
 media::mojom::CaptureHandlePtr CreateCaptureHandle(
     content::WebContents* capturer,
@@ -240,6 +251,21 @@ std::string MakePartitionName(const std::string& input) {
   return {};
 }
 
+size_t g_spare_context_count = 0;
+bool g_fill_spare_contexts_pending = false;
+
+using SpareContexts = std::vector<std::unique_ptr<ElectronBrowserContext>>;
+
+SpareContexts& GetSpareContexts() {
+  static base::NoDestructor<SpareContexts> spare_contexts;
+  return *spare_contexts;
+}
+
+bool IsOnlyLightweight(const base::Value::Dict& options) {
+  return options.size() == 1 &&
+         options.FindBool("lightweight").value_or(false);
+}
+
 }  // namespace
 
 // static
@@ -268,6 +294,12 @@ ElectronBrowserContext::ElectronBrowserContext(
 
   base::StringToInt(command_line->GetSwitchValueASCII(switches::kDiskCacheSize),
                     &max_cache_size_);
+  if (auto cache_size_opt = options.FindInt("cacheSize"))
+    max_cache_size_ = std::max(cache_size_opt.value(), 0);
+  if (const std::string* backend = options.FindString("cacheBackend"))
+    use_memory_cache_ = *backend == "memory";
+
+  lightweight_ = in_memory && options.FindBool("lightweight").value_or(false);
 
   if (auto* path_value = std::get_if<std::reference_wrapper<const std::string>>(
           &partition_location)) {
@@ -288,7 +320,10 @@ ElectronBrowserContext::ElectronBrowserContext(
   BrowserContextDependencyManager::GetInstance()->MarkBrowserContextLive(this);
 
   // Initialize Pref Registry.
-  InitPrefs();
+  if (lightweight_)
+    InitPrefsFromDefaultContext();
+  else
+    InitPrefs();
 
   cookie_change_notifier_ = std::make_unique<CookieChangeNotifier>(this);
 
@@ -307,6 +342,8 @@ ElectronBrowserContext::ElectronBrowserContext(
 
 ElectronBrowserContext::~ElectronBrowserContext() {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  // The spares are WebContents of this context, so they must go first.
+  spare_renderer_pool_.reset();
   NotifyWillBeDestroyed();
   // Notify any keyed services of browser context destruction.
   BrowserContextDependencyManager::GetInstance()->DestroyBrowserContextServices(
@@ -321,6 +358,8 @@ void ElectronBrowserContext::InitPrefs() {
   scoped_refptr<JsonPrefStore> pref_store =
       base::MakeRefCounted<JsonPrefStore>(prefs_path);
   pref_store->ReadPrefs();  // Synchronous.
+  user_pref_store_ = pref_store;
+  user_pref_store_observation_.Observe(user_pref_store_.get());
   prefs_factory.set_user_prefs(pref_store);
   prefs_factory.set_command_line_prefs(in_memory_pref_store());
 
@@ -385,6 +424,37 @@ void ElectronBrowserContext::InitPrefs() {
 #endif
 }
 
+void ElectronBrowserContext::OnPrefValueChanged(const std::string& key) {
+  if (lossy_prefs_write_timer_.IsRunning())
+    return;
+
+  int interval_seconds = kDefaultLossyPrefsWriteIntervalSeconds;
+  base::StringToInt(base::CommandLine::ForCurrentProcess()->GetSwitchValueASCII(
+                        switches::kPrefsWriteInterval),
+                    &interval_seconds);
+  lossy_prefs_write_timer_.Start(
+      FROM_HERE, base::Seconds(std::max(interval_seconds, 0)),
+      base::BindOnce(&PersistentPrefStore::SchedulePendingLossyWrites,
+                     user_pref_store_));
+}
+
+void ElectronBrowserContext::InitPrefsFromDefaultContext() {
+  ElectronBrowserContext* default_context = From("", false);
+  PrefServiceFactory prefs_factory;
+  // Changes stay in memory instead of being written over the preferences of
+  // the default context.
+  user_pref_store_ = base::MakeRefCounted<OverlayUserPrefStore>(
+      default_context->user_pref_store_.get());
+  prefs_factory.set_user_prefs(user_pref_store_);
+  prefs_factory.set_command_line_prefs(in_memory_pref_store());
+  prefs_ = prefs_factory.Create(
+      default_context->prefs()->DeprecatedGetPrefRegistry());
+#if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS) || \
+    BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
+  user_prefs::UserPrefs::Set(this, prefs_.get());
+#endif
+}
+
 void ElectronBrowserContext::SetUserAgent(const std::string& user_agent) {
   user_agent_ = user_agent;
 }
@@ -457,6 +527,18 @@ predictors::PreconnectManager* ElectronBrowserContext::GetPreconnectManager() {
   return preconnect_manager_.get();
 }
 
+PreconnectPredictor* ElectronBrowserContext::GetPreconnectPredictor() {
+  if (!preconnect_predictor_)
+    preconnect_predictor_ = std::make_unique<PreconnectPredictor>(this);
+  return preconnect_predictor_.get();
+}
+
+SpareRendererPool* ElectronBrowserContext::GetSpareRendererPool() {
+  if (!spare_renderer_pool_)
+    spare_renderer_pool_ = std::make_unique<SpareRendererPool>(this);
+  return spare_renderer_pool_.get();
+}
+
 scoped_refptr<network::SharedURLLoaderFactory>
 ElectronBrowserContext::GetURLLoaderFactory() {
   if (url_loader_factory_)
@@ -827,6 +909,18 @@ ElectronBrowserContext* ElectronBrowserContext::From(
     return browser_context;
   }
 
+  auto& spare_contexts = GetSpareContexts();
+  if (in_memory && IsOnlyLightweight(options) && !spare_contexts.empty()) {
+    // In-memory contexts don't depend on the name of their partition.
+    std::unique_ptr<ElectronBrowserContext> spare_context =
+        std::move(spare_contexts.back());
+    spare_contexts.pop_back();
+    ScheduleFillSpareContexts();
+    browser_context = spare_context.get();
+    browser_context_map()[key] = std::move(spare_context);
+    return browser_context;
+  }
+
   auto* new_context = new ElectronBrowserContext(std::cref(partition),
                                                  in_memory, std::move(options));
   browser_context_map()[key] =
@@ -834,6 +928,48 @@ ElectronBrowserContext* ElectronBrowserContext::From(
   return new_context;
 }
 
+// static
+void ElectronBrowserContext::SetSpareContextCount(size_t count) {
+  g_spare_context_count = count;
+  auto& spare_contexts = GetSpareContexts();
+  if (spare_contexts.size() > count)
+    spare_contexts.resize(count);
+  else
+    ScheduleFillSpareContexts();
+}
+
+// static
+size_t ElectronBrowserContext::GetSpareContextCountForTesting() {
+  return GetSpareContexts().size();
+}
+
+// static
+void ElectronBrowserContext::ScheduleFillSpareContexts() {
+  if (g_fill_spare_contexts_pending ||
+      GetSpareContexts().size() >= g_spare_context_count)
+    return;
+  g_fill_spare_contexts_pending = true;
+  content::GetUIThreadTaskRunner({base::TaskPriority::BEST_EFFORT})
+      ->PostTask(FROM_HERE,
+                 base::BindOnce(&ElectronBrowserContext::FillSpareContexts));
+}
+
+// static
+void ElectronBrowserContext::FillSpareContexts() {
+  g_fill_spare_contexts_pending = false;
+  auto& spare_contexts = GetSpareContexts();
+  if (spare_contexts.size() >= g_spare_context_count)
+    return;
+  // A single context per task, so that filling the pool doesn't hold up
+  // other work of the UI thread.
+  const std::string partition;
+  base::Value::Dict options;
+  options.Set("lightweight", true);
+  spare_contexts.push_back(base::WrapUnique(new ElectronBrowserContext(
+      std::cref(partition), true, std::move(options))));
+  ScheduleFillSpareContexts();
+}
+
 ElectronBrowserContext* ElectronBrowserContext::FromPath(
     const base::FilePath& path,
     base::Value::Dict options) {
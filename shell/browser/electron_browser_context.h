@@ -15,7 +15,10 @@
 
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
+#include "base/scoped_observation.h"
+#include "base/timer/timer.h"
 #include "chrome/browser/predictors/preconnect_manager.h"
+#include "components/prefs/pref_store.h"
 #include "content/public/browser/browser_context.h"
 #include "content/public/browser/media_stream_request.h"
 #include "content/public/browser/resource_context.h"
@@ -27,6 +30,7 @@
 #include "shell/browser/media/media_device_id_salt.h"
 #include "third_party/blink/public/common/permissions/permission_utils.h"
 
+class PersistentPrefStore;
 class PrefService;
 class ValueMapPrefStore;
 
@@ -60,7 +64,9 @@ using DevicePermissionMap =
 class ElectronDownloadManagerDelegate;
 class ElectronPermissionManager;
 class CookieChangeNotifier;
+class PreconnectPredictor;
 class ResolveProxyHelper;
+class SpareRendererPool;
 class WebViewManager;
 class ProtocolRegistry;
 
@@ -73,7 +79,8 @@ using PartitionOrPath =
     std::variant<std::reference_wrapper<const std::string>,
                  std::reference_wrapper<const base::FilePath>>;
 
-class ElectronBrowserContext : public content::BrowserContext {
+class ElectronBrowserContext : public content::BrowserContext,
+                               private PrefStore::Observer {
  public:
   // disable copy
   ElectronBrowserContext(const ElectronBrowserContext&) = delete;
@@ -117,12 +124,23 @@ class ElectronBrowserContext : public content::BrowserContext {
 
   static BrowserContextMap& browser_context_map();
 
+  // Keeps |count| lightweight in-memory contexts created in advance, which
+  // are handed out by From() to new partitions that ask for no other option
+  // than "lightweight".
+  static void SetSpareContextCount(size_t count);
+  static size_t GetSpareContextCountForTesting();
+
   void SetUserAgent(const std::string& user_agent);
   std::string GetUserAgent() const;
   bool can_use_http_cache() const { return use_cache_; }
   int max_cache_size() const { return max_cache_size_; }
+  // Whether the HTTP cache of a persistent session is kept in memory rather
+  // than on disk. The HTTP cache of in-memory sessions is always in memory.
+  bool use_memory_cache() const { return in_memory_ || use_memory_cache_; }
   ResolveProxyHelper* GetResolveProxyHelper();
   predictors::PreconnectManager* GetPreconnectManager();
+  PreconnectPredictor* GetPreconnectPredictor();
+  SpareRendererPool* GetSpareRendererPool();
   scoped_refptr<network::SharedURLLoaderFactory> GetURLLoaderFactory();
 
   std::string GetMediaDeviceIDSalt();
@@ -219,11 +237,27 @@ class ElectronBrowserContext : public content::BrowserContext {
   // Initialize pref registry.
   void InitPrefs();
 
+  // Lightweight contexts read the preferences of the default context, so
+  // they skip both loading them from disk and registering them again.
+  void InitPrefsFromDefaultContext();
+
+  // PrefStore::Observer:
+  void OnPrefValueChanged(const std::string& key) override;
+
+  static void ScheduleFillSpareContexts();
+  static void FillSpareContexts();
+
   bool DoesDeviceMatch(const base::Value& device,
                        const base::Value* device_to_compare,
                        blink::PermissionType permission_type);
 
   scoped_refptr<ValueMapPrefStore> in_memory_pref_store_;
+  scoped_refptr<PersistentPrefStore> user_pref_store_;
+  base::ScopedObservation<PrefStore, PrefStore::Observer>
+      user_pref_store_observation_{this};
+  // Changes to lossy prefs, like zoom levels and DevTools settings, are only
+  // written when this fires or along with other changes.
+  base::OneShotTimer lossy_prefs_write_timer_;
   std::unique_ptr<CookieChangeNotifier> cookie_change_notifier_;
   std::unique_ptr<PrefService> prefs_;
   std::unique_ptr<ElectronDownloadManagerDelegate> download_manager_delegate_;
@@ -233,13 +267,17 @@ class ElectronBrowserContext : public content::BrowserContext {
   scoped_refptr<ResolveProxyHelper> resolve_proxy_helper_;
   scoped_refptr<storage::SpecialStoragePolicy> storage_policy_;
   std::unique_ptr<predictors::PreconnectManager> preconnect_manager_;
+  std::unique_ptr<PreconnectPredictor> preconnect_predictor_;
   std::unique_ptr<ProtocolRegistry> protocol_registry_;
+  std::unique_ptr<SpareRendererPool> spare_renderer_pool_;
 
   std::optional<std::string> user_agent_;
   base::FilePath path_;
   bool in_memory_ = false;
+  bool lightweight_ = false;
   bool use_cache_ = true;
   int max_cache_size_ = 0;
+  bool use_memory_cache_ = false;
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   // Owned by the KeyedService system.
@@ -13,6 +13,7 @@
 #include "base/base_switches.h"
 #include "base/command_line.h"
 #include "base/feature_list.h"
+#include "base/functional/bind.h"
 #include "base/i18n/rtl.h"
 #include "base/metrics/field_trial.h"
 #include "base/nix/xdg_util.h"
@@ -21,6 +22,8 @@
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/single_thread_task_runner.h"
+#include "base/task/thread_pool.h"
+#include "base/trace_event/trace_event.h"
 #include "chrome/browser/icon_manager.h"
 #include "chrome/browser/ui/color/chrome_color_mixers.h"
 #include "chrome/common/chrome_paths.h"
@@ -57,14 +60,17 @@
 #include "shell/browser/feature_list.h"
 #include "shell/browser/javascript_environment.h"
 #include "shell/browser/media/media_capture_devices_dispatcher.h"
+#include "shell/browser/spare_utility_process_pool.h"
 #include "shell/browser/ui/devtools_manager_delegate.h"
 #include "shell/common/api/electron_bindings.h"
 #include "shell/common/application_info.h"
+#include "shell/common/asar/asar_util.h"
 #include "shell/common/electron_paths.h"
 #include "shell/common/gin_helper/trackable_object.h"
 #include "shell/common/logging.h"
 #include "shell/common/node_bindings.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/startup_timings.h"
 #include "ui/base/idle/idle.h"
 #include "ui/base/l10n/l10n_util.h"
 #include "ui/base/ui_base_switches.h"
@@ -170,6 +176,16 @@ std::u16string MediaStringProvider(media::MessageId id) {
   }
 }
 
+// Opens the app's archive, which lib/browser/init.ts looks for first, so
+// that reading and validating its header happens while the JS environment is
+// being created rather than after it. If JS gets to the archive first, it
+// waits on the archive cache lock for this to finish.
+void PreloadAppArchive() {
+  TRACE_EVENT0("electron", "PreloadAppArchive");
+  asar::GetOrCreateAsarArchive(
+      GetResourcesPath().Append(FILE_PATH_LITERAL("app.asar")));
+}
+
 }  // namespace
 
 // static
@@ -208,6 +224,8 @@ int ElectronBrowserMainParts::GetExitCode() const {
 }
 
 int ElectronBrowserMainParts::PreEarlyInitialization() {
+  ScopedStartupTiming startup_timing(
+      "ElectronBrowserMainParts::PreEarlyInitialization");
   field_trial_list_ = std::make_unique<base::FieldTrialList>();
 #if BUILDFLAG(IS_POSIX)
   HandleSIGCHLD();
@@ -230,6 +248,12 @@ void ElectronBrowserMainParts::PostEarlyInitialization() {
   // A workaround was previously needed because there was no ThreadTaskRunner
   // set.  If this check is failing we may need to re-add that workaround
   DCHECK(base::SingleThreadTaskRunner::HasCurrentDefault());
+  ScopedStartupTiming startup_timing(
+      "ElectronBrowserMainParts::PostEarlyInitialization");
+
+  base::ThreadPool::PostTask(
+      FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_BLOCKING},
+      base::BindOnce(&PreloadAppArchive));
 
   // The ProxyResolverV8 has setup a complete V8 environment, in order to
   // avoid conflicts we only initialize our V8 environment after that.
@@ -282,6 +306,8 @@ void ElectronBrowserMainParts::PostEarlyInitialization() {
 }
 
 int ElectronBrowserMainParts::PreCreateThreads() {
+  ScopedStartupTiming startup_timing(
+      "ElectronBrowserMainParts::PreCreateThreads");
   if (!views::LayoutProvider::Get()) {
     layout_provider_ = std::make_unique<views::LayoutProvider>();
   }
@@ -393,6 +419,8 @@ void ElectronBrowserMainParts::PostDestroyThreads() {
 }
 
 void ElectronBrowserMainParts::ToolkitInitialized() {
+  ScopedStartupTiming startup_timing(
+      "ElectronBrowserMainParts::ToolkitInitialized");
 #if BUILDFLAG(IS_LINUX)
   auto* linux_ui = ui::GetDefaultLinuxUi();
   CHECK(linux_ui);
@@ -436,6 +464,8 @@ void ElectronBrowserMainParts::ToolkitInitialized() {
 }
 
 int ElectronBrowserMainParts::PreMainMessageLoopRun() {
+  ScopedStartupTiming startup_timing(
+      "ElectronBrowserMainParts::PreMainMessageLoopRun");
   // Run user's main script before most things get initialized, so we can have
   // a chance to setup everything.
   node_bindings_->PrepareEmbedThread();
@@ -566,6 +596,8 @@ void ElectronBrowserMainParts::PostMainMessageLoopRun() {
     }
   }
 
+  SpareUtilityProcessPool::GetInstance()->Clear();
+
   // Shutdown utility process created with Electron API before
   // stopping Node.js so that exit events can be emitted. We don't let
   // content layer perform this action since it destroys
@@ -602,6 +634,7 @@ void ElectronBrowserMainParts::PostMainMessageLoopRun() {
   node::Stop(node_env_.get(), node::StopFlags::kDoNotTerminateIsolate);
   node_env_.reset();
 
+  ElectronBrowserContext::SetSpareContextCount(0);
   auto default_context_key = ElectronBrowserContext::PartitionKey("", false);
   std::unique_ptr<ElectronBrowserContext> default_context = std::move(
       ElectronBrowserContext::browser_context_map()[default_context_key]);
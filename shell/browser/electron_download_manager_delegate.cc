@@ -4,12 +4,16 @@
 
 #include "shell/browser/electron_download_manager_delegate.h"
 
+#include <memory>
 #include <string>
 #include <tuple>
 #include <utility>
+#include <vector>
 
+#include "base/files/file.h"
 #include "base/files/file_util.h"
 #include "base/functional/bind.h"
+#include "base/task/sequenced_task_runner.h"
 #include "base/task/thread_pool.h"
 #include "base/threading/thread_restrictions.h"
 #include "chrome/common/pref_names.h"
@@ -19,6 +23,8 @@
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/download_item_utils.h"
 #include "content/public/browser/download_manager.h"
+#include "crypto/secure_hash.h"
+#include "crypto/sha2.h"
 #include "net/base/filename_util.h"
 #include "shell/browser/api/electron_api_download_item.h"
 #include "shell/browser/electron_browser_context.h"
@@ -32,8 +38,6 @@
 #include "shell/common/thread_restrictions.h"
 
 #if BUILDFLAG(IS_WIN)
-#include <vector>
-
 #include "base/i18n/case_conversion.h"
 #include "base/win/registry.h"
 #include "ui/base/l10n/l10n_util.h"
@@ -45,6 +49,39 @@ namespace electron {
 
 namespace {
 
+const char kExpectedHashKey[] = "ElectronExpectedHash";
+
+struct ExpectedHash : public base::SupportsUserData::Data {
+  explicit ExpectedHash(std::string sha256) : sha256(std::move(sha256)) {}
+  // Raw bytes, like download::DownloadItem::GetHash().
+  std::string sha256;
+  // Whether the file has been hashed by HashFile() and matched.
+  bool verified = false;
+};
+
+// Returns the raw SHA-256 hash of the file at |path|, or an empty string when
+// it can't be read.
+std::string HashFile(const base::FilePath& path) {
+  base::File file(path, base::File::FLAG_OPEN | base::File::FLAG_READ);
+  if (!file.IsValid())
+    return std::string();
+
+  auto hash = crypto::SecureHash::Create(crypto::SecureHash::SHA256);
+  std::vector<char> buffer(64 * 1024);
+  while (true) {
+    int bytes_read = file.ReadAtCurrentPos(buffer.data(), buffer.size());
+    if (bytes_read < 0)
+      return std::string();
+    if (bytes_read == 0)
+      break;
+    hash->Update(buffer.data(), bytes_read);
+  }
+
+  std::string result(crypto::kSHA256Length, '\0');
+  hash->Finish(result.data(), result.size());
+  return result;
+}
+
 // Generate default file path to save the download.
 base::FilePath CreateDownloadPath(const GURL& url,
                                   const std::string& content_disposition,
@@ -324,6 +361,20 @@ void ElectronDownloadManagerDelegate::OnDownloadSaveDialogDone(
   std::move(download_callback).Run(std::move(target_info));
 }
 
+// static
+void ElectronDownloadManagerDelegate::SetExpectedHash(
+    download::DownloadItem* item,
+    std::string sha256) {
+  item->SetUserData(kExpectedHashKey,
+                    std::make_unique<ExpectedHash>(std::move(sha256)));
+}
+
+void ElectronDownloadManagerDelegate::CancelDownload(uint32_t download_id) {
+  auto* item = download_manager_->GetDownload(download_id);
+  if (item)
+    item->Cancel(true);
+}
+
 void ElectronDownloadManagerDelegate::Shutdown() {
   weak_ptr_factory_.InvalidateWeakPtrs();
   download_manager_ = nullptr;
@@ -384,4 +435,60 @@ void ElectronDownloadManagerDelegate::GetNextId(
   std::move(callback).Run(next_id++);
 }
 
+void ElectronDownloadManagerDelegate::OnDownloadFileHashed(
+    uint32_t download_id,
+    base::OnceClosure complete_callback,
+    const std::string& sha256) {
+  auto* item = download_manager_->GetDownload(download_id);
+  if (!item || item->GetState() != download::DownloadItem::IN_PROGRESS)
+    return;
+
+  auto* expected =
+      static_cast<ExpectedHash*>(item->GetUserData(kExpectedHashKey));
+  if (expected && sha256 != expected->sha256) {
+    item->Cancel(true);
+    return;
+  }
+
+  // |complete_callback| asks ShouldCompleteDownload() again.
+  if (expected)
+    expected->verified = true;
+  std::move(complete_callback).Run();
+}
+
+bool ElectronDownloadManagerDelegate::ShouldCompleteDownload(
+    download::DownloadItem* item,
+    base::OnceClosure complete_callback) {
+  // The hash covers the whole file, even when it was downloaded in parallel
+  // segments.
+  auto* expected =
+      static_cast<ExpectedHash*>(item->GetUserData(kExpectedHashKey));
+  if (!expected || expected->verified)
+    return true;
+
+  // Parallel and sparse downloads don't hash their data as it arrives, so the
+  // file itself is hashed before completing them.
+  if (item->GetHash().empty()) {
+    base::ThreadPool::PostTaskAndReplyWithResult(
+        FROM_HERE,
+        {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+         base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+        base::BindOnce(&HashFile, item->GetFullPath()),
+        base::BindOnce(&ElectronDownloadManagerDelegate::OnDownloadFileHashed,
+                       weak_ptr_factory_.GetWeakPtr(), item->GetId(),
+                       std::move(complete_callback)));
+    return false;
+  }
+
+  if (item->GetHash() == expected->sha256)
+    return true;
+
+  // The item can't be cancelled while it is deciding whether to complete.
+  base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+      FROM_HERE,
+      base::BindOnce(&ElectronDownloadManagerDelegate::CancelDownload,
+                     weak_ptr_factory_.GetWeakPtr(), item->GetId()));
+  return false;
+}
+
 }  // namespace electron
@@ -5,6 +5,8 @@
 #ifndef ELECTRON_SHELL_BROWSER_ELECTRON_DOWNLOAD_MANAGER_DELEGATE_H_
 #define ELECTRON_SHELL_BROWSER_ELECTRON_DOWNLOAD_MANAGER_DELEGATE_H_
 
+#include <string>
+
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
 #include "content/public/browser/download_manager_delegate.h"
@@ -26,6 +28,11 @@ class ElectronDownloadManagerDelegate
   explicit ElectronDownloadManagerDelegate(content::DownloadManager* manager);
   ~ElectronDownloadManagerDelegate() override;
 
+  // Cancels |item| instead of completing it when the SHA-256 hash of its data
+  // isn't |sha256|, so a corrupted file is never left at the target path.
+  static void SetExpectedHash(download::DownloadItem* item,
+                              std::string sha256);
+
   // disable copy
   ElectronDownloadManagerDelegate(const ElectronDownloadManagerDelegate&) =
       delete;
@@ -41,6 +48,8 @@ class ElectronDownloadManagerDelegate
       download::DownloadItem* download,
       content::DownloadOpenDelayedCallback callback) override;
   void GetNextId(content::DownloadIdCallback callback) override;
+  bool ShouldCompleteDownload(download::DownloadItem* item,
+                              base::OnceClosure complete_callback) override;
 
  private:
   // Get the save path set on the associated api::DownloadItem object
@@ -57,6 +66,11 @@ class ElectronDownloadManagerDelegate
       download::DownloadTargetCallback download_callback,
       gin_helper::Dictionary result);
 
+  void CancelDownload(uint32_t download_id);
+  void OnDownloadFileHashed(uint32_t download_id,
+                            base::OnceClosure complete_callback,
+                            const std::string& sha256);
+
   base::FilePath last_saved_directory_;
 
   raw_ptr<content::DownloadManager> download_manager_;
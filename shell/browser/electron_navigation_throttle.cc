@@ -4,14 +4,35 @@
 
 #include "shell/browser/electron_navigation_throttle.h"
 
+#include "base/containers/contains.h"
 #include "content/browser/renderer_host/render_frame_host_impl.h"  // nogncheck
 #include "content/public/browser/navigation_handle.h"
+#include "shell/browser/api/electron_api_protocol.h"
 #include "shell/browser/api/electron_api_web_contents.h"
 #include "shell/browser/javascript_environment.h"
+#include "shell/browser/web_contents_preferences.h"
 #include "ui/base/page_transition_types.h"
 
 namespace electron {
 
+namespace {
+
+// Pages of process-per-site schemes may be put in a sandboxed renderer that
+// other windows already share, where Node.js integration can't be given to
+// them. Windows that aren't sandboxed can't load them at all, instead of
+// silently losing Node.js.
+bool IsBlockedProcessPerSiteNavigation(content::NavigationHandle* handle,
+                                       content::WebContents* contents) {
+  if (!base::Contains(api::GetProcessPerSiteSchemes(),
+                      handle->GetURL().scheme())) {
+    return false;
+  }
+  auto* web_preferences = WebContentsPreferences::From(contents);
+  return web_preferences && !web_preferences->IsSandboxed();
+}
+
+}  // namespace
+
 ElectronNavigationThrottle::ElectronNavigationThrottle(
     content::NavigationHandle* navigation_handle)
     : content::NavigationThrottle(navigation_handle) {}
@@ -31,6 +52,9 @@ ElectronNavigationThrottle::WillStartRequest() {
     return PROCEED;
   }
 
+  if (IsBlockedProcessPerSiteNavigation(handle, contents))
+    return BLOCK_REQUEST;
+
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope scope(isolate);
   api::WebContents* api_contents = api::WebContents::From(contents);
@@ -72,6 +96,9 @@ ElectronNavigationThrottle::WillRedirectRequest() {
     return PROCEED;
   }
 
+  if (IsBlockedProcessPerSiteNavigation(handle, contents))
+    return BLOCK_REQUEST;
+
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope scope(isolate);
   api::WebContents* api_contents = api::WebContents::From(contents);
@@ -5,9 +5,13 @@
 #include "shell/browser/electron_permission_manager.h"
 
 #include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
+#include "base/task/sequenced_task_runner.h"
 #include "base/values.h"
 #include "content/browser/permissions/permission_util.h"  // nogncheck
 #include "content/public/browser/child_process_security_policy.h"
@@ -122,11 +126,22 @@ void ElectronPermissionManager::SetPermissionRequestHandler(
 void ElectronPermissionManager::SetPermissionCheckHandler(
     const CheckHandler& handler) {
   check_handler_ = handler;
+  check_cache_.Clear();
+}
+
+void ElectronPermissionManager::SetPermissionCheckCacheEnabled(bool enabled) {
+  check_cache_enabled_ = enabled;
+  check_cache_.Clear();
+}
+
+void ElectronPermissionManager::ClearPermissionCheckCache() {
+  check_cache_.Clear();
 }
 
 void ElectronPermissionManager::SetDevicePermissionHandler(
     const DeviceCheckHandler& handler) {
   device_permission_handler_ = handler;
+  device_check_cache_.Clear();
 }
 
 void ElectronPermissionManager::SetProtectedUSBHandler(
@@ -240,7 +255,9 @@ void ElectronPermissionManager::OnPermissionResponse(
 void ElectronPermissionManager::ResetPermission(
     blink::PermissionType permission,
     const GURL& requesting_origin,
-    const GURL& embedding_origin) {}
+    const GURL& embedding_origin) {
+  check_cache_.Clear();
+}
 
 void ElectronPermissionManager::RequestPermissionsFromCurrentDocument(
     content::RenderFrameHost* render_frame_host,
@@ -309,8 +326,10 @@ bool ElectronPermissionManager::CheckPermissionWithDetails(
     details.Set("requestingUrl",
                 render_frame_host->GetLastCommittedURL().spec());
   }
-  details.Set("isMainFrame",
-              render_frame_host && render_frame_host->GetParent() == nullptr);
+  bool is_main_frame =
+      render_frame_host && render_frame_host->GetParent() == nullptr;
+  details.Set("isMainFrame", is_main_frame);
+
   switch (permission) {
     case blink::PermissionType::AUDIO_CAPTURE:
       details.Set("mediaType", "audio");
@@ -321,8 +340,27 @@ bool ElectronPermissionManager::CheckPermissionWithDetails(
     default:
       break;
   }
-  return check_handler_.Run(web_contents, permission, requesting_origin,
-                            base::Value(std::move(details)));
+
+  std::optional<CheckCacheKey> cache_key;
+  if (check_cache_enabled_) {
+    auto find_string = [&details](std::string_view key) {
+      const std::string* value = details.FindString(key);
+      return value ? *value : std::string();
+    };
+    cache_key.emplace(permission, url::Origin::Create(requesting_origin),
+                      find_string("embeddingOrigin"),
+                      find_string("securityOrigin"), find_string("mediaType"),
+                      is_main_frame);
+    auto iter = check_cache_.Get(*cache_key);
+    if (iter != check_cache_.end())
+      return iter->second;
+  }
+
+  bool granted = check_handler_.Run(web_contents, permission, requesting_origin,
+                                    base::Value(std::move(details)));
+  if (cache_key)
+    check_cache_.Put(std::move(*cache_key), granted);
+  return granted;
 }
 
 bool ElectronPermissionManager::CheckDevicePermission(
@@ -333,6 +371,11 @@ bool ElectronPermissionManager::CheckDevicePermission(
   if (device_permission_handler_.is_null())
     return browser_context->CheckDevicePermission(origin, device, permission);
 
+  DeviceCheckCacheKey cache_key(permission, origin.Serialize(), device.Clone());
+  auto iter = device_check_cache_.find(cache_key);
+  if (iter != device_check_cache_.end())
+    return iter->second;
+
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope scope(isolate);
   v8::Local<v8::Object> details = gin::DataObjectBuilder(isolate)
@@ -340,7 +383,19 @@ bool ElectronPermissionManager::CheckDevicePermission(
                                       .Set("origin", origin.Serialize())
                                       .Set("device", device.Clone())
                                       .Build();
-  return device_permission_handler_.Run(details);
+  bool granted = device_permission_handler_.Run(details);
+  if (device_check_cache_.empty()) {
+    base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+        FROM_HERE,
+        base::BindOnce(&ElectronPermissionManager::ClearDeviceCheckCache,
+                       weak_factory_.GetWeakPtr()));
+  }
+  device_check_cache_.emplace(std::move(cache_key), granted);
+  return granted;
+}
+
+void ElectronPermissionManager::ClearDeviceCheckCache() const {
+  device_check_cache_.Clear();
 }
 
 void ElectronPermissionManager::GrantDevicePermission(
@@ -351,6 +406,7 @@ void ElectronPermissionManager::GrantDevicePermission(
   if (device_permission_handler_.is_null()) {
     browser_context->GrantDevicePermission(origin, device, permission);
   }
+  device_check_cache_.Clear();
 }
 
 void ElectronPermissionManager::RevokeDevicePermission(
@@ -359,6 +415,7 @@ void ElectronPermissionManager::RevokeDevicePermission(
     const base::Value& device,
     ElectronBrowserContext* browser_context) const {
   browser_context->RevokeDevicePermission(origin, device, permission);
+  device_check_cache_.Clear();
 }
 
 ElectronPermissionManager::USBProtectedClasses
@@ -5,15 +5,21 @@
 #ifndef ELECTRON_SHELL_BROWSER_ELECTRON_PERMISSION_MANAGER_H_
 #define ELECTRON_SHELL_BROWSER_ELECTRON_PERMISSION_MANAGER_H_
 
+#include <map>
 #include <memory>
+#include <string>
+#include <tuple>
 #include <vector>
 
 #include "base/containers/id_map.h"
+#include "base/containers/lru_cache.h"
 #include "base/functional/callback.h"
+#include "base/memory/weak_ptr.h"
 #include "content/public/browser/permission_controller_delegate.h"
 #include "gin/dictionary.h"
 #include "shell/browser/electron_browser_context.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "url/origin.h"
 
 namespace base {
 class Value;
@@ -75,6 +81,12 @@ class ElectronPermissionManager : public content::PermissionControllerDelegate {
   void SetProtectedUSBHandler(const ProtectedUSBHandler& handler);
   void SetBluetoothPairingHandler(const BluetoothPairingHandler& handler);
 
+  // When enabled, the result of the check handler is reused for later checks
+  // of the same permission by the same kind of frame of an origin, until the
+  // handler changes or the cache is cleared.
+  void SetPermissionCheckCacheEnabled(bool enabled);
+  void ClearPermissionCheckCache();
+
   void CheckBluetoothDevicePair(gin_helper::Dictionary details,
                                 PairCallback pair_callback) const;
 
@@ -158,13 +170,41 @@ class ElectronPermissionManager : public content::PermissionControllerDelegate {
       base::Value::Dict details,
       StatusesCallback callback);
 
+  // Clears the device permission checks made since the last task.
+  void ClearDeviceCheckCache() const;
+
+  // (permission, requesting origin, embedding origin, security origin, media
+  // type, is main frame).
+  using CheckCacheKey = std::tuple<blink::PermissionType,
+                                   url::Origin,
+                                   std::string,
+                                   std::string,
+                                   std::string,
+                                   bool>;
+
+  // The most results of the permission check handler that are kept.
+  static constexpr size_t kMaxCheckCacheSize = 256;
+
+  // (permission, origin, device).
+  using DeviceCheckCacheKey =
+      std::tuple<blink::PermissionType, std::string, base::Value>;
+
   RequestHandler request_handler_;
   CheckHandler check_handler_;
+  bool check_cache_enabled_ = false;
+  mutable base::LRUCache<CheckCacheKey, bool> check_cache_{kMaxCheckCacheSize};
   DeviceCheckHandler device_permission_handler_;
+  // The device permission handler is asked about every device when a page
+  // lists or opens devices, often several times for each of them. Its results
+  // are reused until the current task ends, so that each batch of checks only
+  // calls into JS once per device.
+  mutable std::map<DeviceCheckCacheKey, bool> device_check_cache_;
   ProtectedUSBHandler protected_usb_handler_;
   BluetoothPairingHandler bluetooth_pairing_handler_;
 
   PendingRequestsMap pending_requests_;
+
+  base::WeakPtrFactory<ElectronPermissionManager> weak_factory_{this};
 };
 
 }  // namespace electron
@@ -33,8 +33,10 @@ class EventEmitterMixin {
     if (!static_cast<T*>(this)->GetWrapper(isolate).ToLocal(&wrapper))
       return false;
     gin::Handle<internal::Event> event = internal::Event::New(isolate);
-    gin_helper::EmitEvent(isolate, wrapper, name, event,
-                          std::forward<Args>(args)...);
+    gin_helper::EmitEvent(
+        isolate, wrapper,
+        electron::JavascriptEnvironment::GetInternalizedString(name), event,
+        std::forward<Args>(args)...);
     return event->GetDefaultPrevented();
   }
 
@@ -46,7 +48,10 @@ class EventEmitterMixin {
     v8::Local<v8::Object> wrapper;
     if (!static_cast<T*>(this)->GetWrapper(isolate).ToLocal(&wrapper))
       return;
-    gin_helper::EmitEvent(isolate, wrapper, name, std::forward<Args>(args)...);
+    gin_helper::EmitEvent(
+        isolate, wrapper,
+        electron::JavascriptEnvironment::GetInternalizedString(name),
+        std::forward<Args>(args)...);
   }
 
  protected:
@@ -12,6 +12,7 @@
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/sequenced_task_runner.h"
 #include "base/types/optional_util.h"
 #include "chrome/common/extensions/api/scripting.h"
 #include "content/public/browser/browser_task_traits.h"
@@ -45,6 +46,8 @@
 #include "extensions/common/utils/content_script_utils.h"
 #include "extensions/common/utils/extension_types_utils.h"
 #include "shell/browser/api/electron_api_web_contents.h"
+#include "shell/browser/extensions/electron_extension_system.h"
+#include "shell/browser/extensions/electron_script_file_cache.h"
 
 namespace extensions {
 
@@ -232,10 +235,45 @@ void CheckLoadedResources(std::vector<std::string> file_names,
   std::move(callback).Run(std::move(file_sources), std::nullopt);
 }
 
+// Returns the file sources of `files` if all of them are cached, or an empty
+// vector otherwise.
+std::vector<InjectedFileSource> GetCachedFileSources(
+    ElectronScriptFileCache& cache,
+    const Extension& extension,
+    const std::vector<std::string>& files,
+    bool requires_localization) {
+  std::vector<InjectedFileSource> sources;
+  sources.reserve(files.size());
+  for (const auto& file : files) {
+    const std::string* data = cache.Get(extension, file, requires_localization);
+    if (!data)
+      return {};
+    sources.emplace_back(file, std::make_unique<std::string>(*data));
+  }
+  return sources;
+}
+
+// Adds the loaded file sources to the cache before passing them on.
+void CacheLoadedResources(base::WeakPtr<ElectronScriptFileCache> cache,
+                          scoped_refptr<const Extension> extension,
+                          bool requires_localization,
+                          ResourcesLoadedCallback callback,
+                          std::vector<InjectedFileSource> file_sources,
+                          std::optional<std::string> load_error) {
+  if (cache && !load_error) {
+    for (const auto& source : file_sources)
+      cache->Put(*extension, source.file_name, requires_localization,
+                 *source.data);
+  }
+  std::move(callback).Run(std::move(file_sources), std::move(load_error));
+}
+
 // Checks the specified `files` for validity, and attempts to load and localize
-// them, invoking `callback` with the result. Returns true on success; on
-// failure, populates `error`.
+// them, invoking `callback` with the result. Files injected before are taken
+// from the script file cache of `browser_context` instead. Returns true on
+// success; on failure, populates `error`.
 bool CheckAndLoadFiles(std::vector<std::string> files,
+                       content::BrowserContext* browser_context,
                        const Extension& extension,
                        bool requires_localization,
                        ResourcesLoadedCallback callback,
@@ -244,6 +282,25 @@ bool CheckAndLoadFiles(std::vector<std::string> files,
   if (!GetFileResources(files, extension, &resources, error))
     return false;
 
+  auto* cache = static_cast<ElectronExtensionSystem*>(
+                    ExtensionSystem::Get(browser_context))
+                    ->script_file_cache();
+  if (cache) {
+    std::vector<InjectedFileSource> cached_sources = GetCachedFileSources(
+        *cache, extension, files, requires_localization);
+    if (!cached_sources.empty()) {
+      // The callback responds to the extension function, which can't happen
+      // before Run() returns.
+      base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+          FROM_HERE, base::BindOnce(std::move(callback),
+                                    std::move(cached_sources), std::nullopt));
+      return true;
+    }
+    callback = base::BindOnce(&CacheLoadedResources, cache->GetWeakPtr(),
+                              base::WrapRefCounted(&extension),
+                              requires_localization, std::move(callback));
+  }
+
   LoadAndLocalizeResources(
       extension, resources, requires_localization,
       script_parsing::GetMaxScriptLength(),
@@ -613,7 +670,8 @@ ExtensionFunction::ResponseAction ScriptingExecuteScriptFunction::Run() {
     constexpr bool kRequiresLocalization = false;
     std::string error;
     if (!CheckAndLoadFiles(
-            std::move(*injection_.files), *extension(), kRequiresLocalization,
+            std::move(*injection_.files), browser_context(), *extension(),
+            kRequiresLocalization,
             base::BindOnce(&ScriptingExecuteScriptFunction::DidLoadResources,
                            this),
             &error)) {
@@ -767,7 +825,8 @@ ExtensionFunction::ResponseAction ScriptingInsertCSSFunction::Run() {
     constexpr bool kRequiresLocalization = true;
     std::string error;
     if (!CheckAndLoadFiles(
-            std::move(*injection_.files), *extension(), kRequiresLocalization,
+            std::move(*injection_.files), browser_context(), *extension(),
+            kRequiresLocalization,
             base::BindOnce(&ScriptingInsertCSSFunction::DidLoadResources, this),
             &error)) {
       return RespondNow(Error(std::move(error)));
@@ -0,0 +1,133 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/extensions/electron_extension_activation_throttle.h"
+
+#include <vector>
+
+#include "content/public/browser/navigation_handle.h"
+#include "content/public/browser/web_contents.h"
+#include "extensions/browser/extension_user_script_loader.h"
+#include "extensions/browser/user_script_manager.h"
+#include "extensions/common/manifest_handlers/content_scripts_handler.h"
+#include "extensions/common/mojom/host_id.mojom.h"
+#include "shell/browser/extensions/electron_extension_system.h"
+
+namespace extensions {
+
+ElectronExtensionActivationThrottle::ElectronExtensionActivationThrottle(
+    content::NavigationHandle* handle)
+    : content::NavigationThrottle(handle) {}
+
+ElectronExtensionActivationThrottle::~ElectronExtensionActivationThrottle() =
+    default;
+
+content::NavigationThrottle::ThrottleCheckResult
+ElectronExtensionActivationThrottle::WillStartRequest() {
+  return ActivateDeferredExtensions();
+}
+
+content::NavigationThrottle::ThrottleCheckResult
+ElectronExtensionActivationThrottle::WillRedirectRequest() {
+  return ActivateDeferredExtensions();
+}
+
+const char* ElectronExtensionActivationThrottle::GetNameForLogging() {
+  return "ElectronExtensionActivationThrottle";
+}
+
+content::NavigationThrottle::ThrottleCheckResult
+ElectronExtensionActivationThrottle::ActivateDeferredExtensions() {
+  auto* browser_context =
+      navigation_handle()->GetWebContents()->GetBrowserContext();
+  auto* extension_system = static_cast<ElectronExtensionSystem*>(
+      ExtensionSystem::Get(browser_context));
+  if (!extension_system)
+    return PROCEED;
+
+  std::vector<ExtensionId> activated =
+      extension_system->ActivateDeferredExtensions(
+          navigation_handle()->GetURL());
+  pending_extensions_.insert(activated.begin(), activated.end());
+  std::erase_if(pending_extensions_, [this](const ExtensionId& id) {
+    return IsExtensionReady(id);
+  });
+  if (pending_extensions_.empty())
+    return PROCEED;
+
+  if (!registry_observation_.IsObserving())
+    registry_observation_.Observe(ExtensionRegistry::Get(browser_context));
+  for (const ExtensionId& id : pending_extensions_) {
+    UserScriptLoader* loader =
+        extension_system->user_script_manager()
+            ->GetUserScriptLoaderForExtension(id);
+    if (!loader_observations_.IsObservingSource(loader))
+      loader_observations_.AddObservation(loader);
+  }
+  return DEFER;
+}
+
+bool ElectronExtensionActivationThrottle::IsExtensionReady(
+    const ExtensionId& extension_id) const {
+  auto* browser_context =
+      navigation_handle()->GetWebContents()->GetBrowserContext();
+  auto* registry = ExtensionRegistry::Get(browser_context);
+  const Extension* extension =
+      registry->enabled_extensions().GetByID(extension_id);
+  // An extension that went away again isn't waited for.
+  if (!extension)
+    return true;
+  if (!registry->ready_extensions().Contains(extension_id))
+    return false;
+  if (ContentScriptsInfo::GetContentScripts(extension).empty())
+    return true;
+
+  UserScriptLoader* loader =
+      ExtensionSystem::Get(browser_context)
+          ->user_script_manager()
+          ->GetUserScriptLoaderForExtension(extension_id);
+  return loader->HasLoadedScripts(
+      mojom::HostID(mojom::HostID::HostType::kExtensions, extension_id));
+}
+
+void ElectronExtensionActivationThrottle::MaybeResume() {
+  if (pending_extensions_.empty())
+    return;
+  std::erase_if(pending_extensions_, [this](const ExtensionId& id) {
+    return IsExtensionReady(id);
+  });
+  if (!pending_extensions_.empty())
+    return;
+
+  registry_observation_.Reset();
+  loader_observations_.RemoveAllObservations();
+  // May delete |this|.
+  Resume();
+}
+
+void ElectronExtensionActivationThrottle::OnExtensionReady(
+    content::BrowserContext* browser_context,
+    const Extension* extension) {
+  MaybeResume();
+}
+
+void ElectronExtensionActivationThrottle::OnExtensionUnloaded(
+    content::BrowserContext* browser_context,
+    const Extension* extension,
+    UnloadedExtensionReason reason) {
+  MaybeResume();
+}
+
+void ElectronExtensionActivationThrottle::OnScriptsLoaded(
+    UserScriptLoader* loader,
+    content::BrowserContext* browser_context) {
+  MaybeResume();
+}
+
+void ElectronExtensionActivationThrottle::OnUserScriptLoaderDestroyed(
+    UserScriptLoader* loader) {
+  loader_observations_.RemoveObservation(loader);
+}
+
+}  // namespace extensions
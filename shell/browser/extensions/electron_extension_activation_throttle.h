@@ -0,0 +1,76 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_EXTENSIONS_ELECTRON_EXTENSION_ACTIVATION_THROTTLE_H_
+#define ELECTRON_SHELL_BROWSER_EXTENSIONS_ELECTRON_EXTENSION_ACTIVATION_THROTTLE_H_
+
+#include <set>
+
+#include "base/scoped_multi_source_observation.h"
+#include "base/scoped_observation.h"
+#include "content/public/browser/navigation_throttle.h"
+#include "extensions/browser/extension_registry.h"
+#include "extensions/browser/extension_registry_observer.h"
+#include "extensions/browser/user_script_loader.h"
+#include "extensions/common/extension_id.h"
+
+namespace extensions {
+
+// Activates the extensions loaded with `deferActivation` when a navigation to
+// a page they apply to starts, and defers the navigation until they are ready
+// and their content scripts are loaded, so the page is the first to get them.
+class ElectronExtensionActivationThrottle : public content::NavigationThrottle,
+                                            public ExtensionRegistryObserver,
+                                            public UserScriptLoader::Observer {
+ public:
+  explicit ElectronExtensionActivationThrottle(
+      content::NavigationHandle* handle);
+  ~ElectronExtensionActivationThrottle() override;
+
+  // disable copy
+  ElectronExtensionActivationThrottle(
+      const ElectronExtensionActivationThrottle&) = delete;
+  ElectronExtensionActivationThrottle& operator=(
+      const ElectronExtensionActivationThrottle&) = delete;
+
+  // content::NavigationThrottle:
+  ThrottleCheckResult WillStartRequest() override;
+  ThrottleCheckResult WillRedirectRequest() override;
+  const char* GetNameForLogging() override;
+
+ private:
+  // Activates the deferred extensions for the URL, and returns DEFER when
+  // some of them aren't ready yet.
+  ThrottleCheckResult ActivateDeferredExtensions();
+
+  bool IsExtensionReady(const ExtensionId& extension_id) const;
+
+  // Resumes the navigation once no extension is pending anymore.
+  void MaybeResume();
+
+  // ExtensionRegistryObserver:
+  void OnExtensionReady(content::BrowserContext* browser_context,
+                        const Extension* extension) override;
+  void OnExtensionUnloaded(content::BrowserContext* browser_context,
+                           const Extension* extension,
+                           UnloadedExtensionReason reason) override;
+
+  // UserScriptLoader::Observer:
+  void OnScriptsLoaded(UserScriptLoader* loader,
+                       content::BrowserContext* browser_context) override;
+  void OnUserScriptLoaderDestroyed(UserScriptLoader* loader) override;
+
+  // The activated extensions that the navigation waits for.
+  std::set<ExtensionId> pending_extensions_;
+
+  base::ScopedObservation<ExtensionRegistry, ExtensionRegistryObserver>
+      registry_observation_{this};
+  base::ScopedMultiSourceObservation<UserScriptLoader,
+                                     UserScriptLoader::Observer>
+      loader_observations_{this};
+};
+
+}  // namespace extensions
+
+#endif  // ELECTRON_SHELL_BROWSER_EXTENSIONS_ELECTRON_EXTENSION_ACTIVATION_THROTTLE_H_
@@ -5,6 +5,7 @@
 #include "shell/browser/extensions/electron_extension_loader.h"
 
 #include <utility>
+#include <vector>
 
 #include "base/auto_reset.h"
 #include "base/files/file_path.h"
@@ -22,7 +23,11 @@
 #include "extensions/browser/pref_names.h"
 #include "extensions/common/error_utils.h"
 #include "extensions/common/file_util.h"
+#include "extensions/common/constants.h"
 #include "extensions/common/manifest_constants.h"
+#include "extensions/common/manifest_handlers/content_scripts_handler.h"
+#include "extensions/common/permissions/permissions_data.h"
+#include "url/gurl.h"
 
 namespace extensions {
 
@@ -90,6 +95,23 @@ std::pair<scoped_refptr<const Extension>, std::string> LoadUnpacked(
   return std::make_pair(extension, warnings);
 }
 
+// Whether a deferred |extension| has to be active for a page at |url|: it's
+// one of its own pages, its content scripts match it, or it has access to it.
+bool AppliesToURL(const Extension& extension, const GURL& url) {
+  if (url.SchemeIs(kExtensionScheme))
+    return url.host_piece() == extension.id();
+
+  for (const auto& script : ContentScriptsInfo::GetContentScripts(&extension)) {
+    if (script->MatchesURL(url))
+      return true;
+  }
+
+  return extension.permissions_data()
+      ->active_permissions()
+      .explicit_hosts()
+      .MatchesURL(url);
+}
+
 }  // namespace
 
 ElectronExtensionLoader::ElectronExtensionLoader(
@@ -102,11 +124,33 @@ ElectronExtensionLoader::~ElectronExtensionLoader() = default;
 void ElectronExtensionLoader::LoadExtension(
     const base::FilePath& extension_dir,
     int load_flags,
+    bool defer_activation,
     base::OnceCallback<void(const Extension*, const std::string&)> cb) {
   GetExtensionFileTaskRunner()->PostTaskAndReplyWithResult(
       FROM_HERE, base::BindOnce(&LoadUnpacked, extension_dir, load_flags),
       base::BindOnce(&ElectronExtensionLoader::FinishExtensionLoad,
-                     weak_factory_.GetWeakPtr(), std::move(cb)));
+                     weak_factory_.GetWeakPtr(), defer_activation,
+                     std::move(cb)));
+}
+
+std::vector<ExtensionId> ElectronExtensionLoader::ActivateDeferredExtensions(
+    const GURL& url) {
+  if (deferred_extensions_.empty())
+    return {};
+
+  std::vector<scoped_refptr<const Extension>> activated;
+  std::erase_if(deferred_extensions_, [&](const auto& extension) {
+    if (!AppliesToURL(*extension, url))
+      return false;
+    activated.push_back(extension);
+    return true;
+  });
+  std::vector<ExtensionId> ids;
+  for (auto& extension : activated) {
+    ids.push_back(extension->id());
+    ActivateExtension(std::move(extension));
+  }
+  return ids;
 }
 
 void ElectronExtensionLoader::ReloadExtension(const ExtensionId& extension_id) {
@@ -128,37 +172,55 @@ void ElectronExtensionLoader::ReloadExtension(const ExtensionId& extension_id) {
 void ElectronExtensionLoader::UnloadExtension(
     const ExtensionId& extension_id,
     extensions::UnloadedExtensionReason reason) {
+  // Deferred extensions were never added to the registry.
+  if (std::erase_if(deferred_extensions_, [&](const auto& extension) {
+        return extension->id() == extension_id;
+      })) {
+    return;
+  }
   extension_registrar_.RemoveExtension(extension_id, reason);
 }
 
 void ElectronExtensionLoader::FinishExtensionLoad(
+    bool defer_activation,
     base::OnceCallback<void(const Extension*, const std::string&)> cb,
     std::pair<scoped_refptr<const Extension>, std::string> result) {
   scoped_refptr<const Extension> extension = result.first;
   if (extension) {
-    extension_registrar_.AddExtension(extension);
-
-    // Write extension install time to ExtensionPrefs. This is required by
-    // WebRequestAPI which calls extensions::ExtensionPrefs::GetInstallTime.
-    //
-    // Implementation for writing the pref was based on
-    // PreferenceAPIBase::SetExtensionControlledPref.
-    {
-      ExtensionPrefs* extension_prefs = ExtensionPrefs::Get(browser_context_);
-      ExtensionPrefs::ScopedDictionaryUpdate update(
-          extension_prefs, extension.get()->id(),
-          extensions::pref_names::kPrefPreferences);
-
-      auto preference = update.Create();
-      const int64_t now_usec =
-          base::Time::Now().since_origin().InMicroseconds();
-      preference->SetString("install_time", base::NumberToString(now_usec));
-    }
+    // Loading the same extension again replaces the deferred one.
+    std::erase_if(deferred_extensions_, [&](const auto& deferred) {
+      return deferred->id() == extension->id();
+    });
+    if (defer_activation)
+      deferred_extensions_.push_back(extension);
+    else
+      ActivateExtension(extension);
   }
 
   std::move(cb).Run(extension.get(), result.second);
 }
 
+void ElectronExtensionLoader::ActivateExtension(
+    scoped_refptr<const Extension> extension) {
+  extension_registrar_.AddExtension(extension);
+
+  // Write extension install time to ExtensionPrefs. This is required by
+  // WebRequestAPI which calls extensions::ExtensionPrefs::GetInstallTime.
+  //
+  // Implementation for writing the pref was based on
+  // PreferenceAPIBase::SetExtensionControlledPref.
+  {
+    ExtensionPrefs* extension_prefs = ExtensionPrefs::Get(browser_context_);
+    ExtensionPrefs::ScopedDictionaryUpdate update(
+        extension_prefs, extension.get()->id(),
+        extensions::pref_names::kPrefPreferences);
+
+    auto preference = update.Create();
+    const int64_t now_usec = base::Time::Now().since_origin().InMicroseconds();
+    preference->SetString("install_time", base::NumberToString(now_usec));
+  }
+}
+
 void ElectronExtensionLoader::FinishExtensionReload(
     const ExtensionId& old_extension_id,
     std::pair<scoped_refptr<const Extension>, std::string> result) {
@@ -7,6 +7,7 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/functional/callback.h"
 #include "base/memory/raw_ptr.h"
@@ -19,6 +20,8 @@ namespace base {
 class FilePath;
 }
 
+class GURL;
+
 namespace content {
 class BrowserContext;
 }
@@ -38,12 +41,19 @@ class ElectronExtensionLoader : public ExtensionRegistrar::Delegate {
   ElectronExtensionLoader& operator=(const ElectronExtensionLoader&) = delete;
 
   // Loads an unpacked extension from a directory synchronously. Returns the
-  // extension on success, or nullptr otherwise.
+  // extension on success, or nullptr otherwise. With |defer_activation|, the
+  // extension is only added to the registry, which starts its background
+  // context and content scripts, once a page it applies to is navigated to.
   void LoadExtension(const base::FilePath& extension_dir,
                      int load_flags,
+                     bool defer_activation,
                      base::OnceCallback<void(const Extension* extension,
                                              const std::string&)> cb);
 
+  // Adds the deferred extensions that apply to |url| to the registry, and
+  // returns their ids.
+  std::vector<ExtensionId> ActivateDeferredExtensions(const GURL& url);
+
   // Starts reloading the extension. A keep-alive is maintained until the
   // reload succeeds/fails. If the extension is an app, it will be launched upon
   // reloading.
@@ -64,9 +74,12 @@ class ElectronExtensionLoader : public ExtensionRegistrar::Delegate {
       std::pair<scoped_refptr<const Extension>, std::string> result);
 
   void FinishExtensionLoad(
+      bool defer_activation,
       base::OnceCallback<void(const Extension*, const std::string&)> cb,
       std::pair<scoped_refptr<const Extension>, std::string> result);
 
+  void ActivateExtension(scoped_refptr<const Extension> extension);
+
   // ExtensionRegistrar::Delegate:
   void PreAddExtension(const Extension* extension,
                        const Extension* old_extension) override;
@@ -86,6 +99,9 @@ class ElectronExtensionLoader : public ExtensionRegistrar::Delegate {
   // Registers and unregisters extensions.
   ExtensionRegistrar extension_registrar_;
 
+  // Extensions that were loaded but not activated yet, in load order.
+  std::vector<scoped_refptr<const Extension>> deferred_extensions_;
+
   // Holds keep-alives for relaunching apps.
   //   ShellKeepAliveRequester keep_alive_requester_;
 
@@ -35,6 +35,7 @@
 #include "extensions/common/constants.h"
 #include "extensions/common/file_util.h"
 #include "shell/browser/extensions/electron_extension_loader.h"
+#include "shell/browser/extensions/electron_script_file_cache.h"
 
 #if BUILDFLAG(ENABLE_PDF_VIEWER)
 #include "chrome/browser/pdf/pdf_extension_util.h"  // nogncheck
@@ -56,8 +57,17 @@ ElectronExtensionSystem::~ElectronExtensionSystem() = default;
 void ElectronExtensionSystem::LoadExtension(
     const base::FilePath& extension_dir,
     int load_flags,
+    bool defer_activation,
     base::OnceCallback<void(const Extension*, const std::string&)> cb) {
-  extension_loader_->LoadExtension(extension_dir, load_flags, std::move(cb));
+  extension_loader_->LoadExtension(extension_dir, load_flags, defer_activation,
+                                   std::move(cb));
+}
+
+std::vector<ExtensionId> ElectronExtensionSystem::ActivateDeferredExtensions(
+    const GURL& url) {
+  if (!extension_loader_)
+    return {};
+  return extension_loader_->ActivateDeferredExtensions(url);
 }
 
 void ElectronExtensionSystem::FinishInitialization() {
@@ -75,6 +85,7 @@ void ElectronExtensionSystem::RemoveExtension(const ExtensionId& extension_id) {
 }
 
 void ElectronExtensionSystem::Shutdown() {
+  script_file_cache_.reset();
   extension_loader_.reset();
 }
 
@@ -86,6 +97,8 @@ void ElectronExtensionSystem::InitForRegularProfile(bool extensions_enabled) {
   app_sorting_ = std::make_unique<NullAppSorting>();
   extension_loader_ =
       std::make_unique<ElectronExtensionLoader>(browser_context_);
+  script_file_cache_ =
+      std::make_unique<ElectronScriptFileCache>(browser_context_);
 
   if (!browser_context_->IsOffTheRecord())
     LoadComponentExtensions();
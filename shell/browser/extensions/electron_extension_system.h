@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/compiler_specific.h"
 #include "base/memory/raw_ptr.h"
@@ -16,6 +17,7 @@
 #include "components/value_store/value_store_factory.h"
 #include "components/value_store/value_store_factory_impl.h"
 #include "extensions/browser/extension_system.h"
+#include "extensions/common/extension_id.h"
 
 namespace base {
 class FilePath;
@@ -25,9 +27,12 @@ namespace content {
 class BrowserContext;
 }
 
+class GURL;
+
 namespace extensions {
 
 class ElectronExtensionLoader;
+class ElectronScriptFileCache;
 class ValueStoreFactory;
 
 // A simplified version of ExtensionSystem for app_shell. Allows
@@ -47,8 +52,13 @@ class ElectronExtensionSystem : public ExtensionSystem {
   void LoadExtension(
       const base::FilePath& extension_dir,
       int load_flags,
+      bool defer_activation,
       base::OnceCallback<void(const Extension*, const std::string&)> cb);
 
+  // Activates the extensions loaded with |defer_activation| that apply to
+  // |url|, and returns their ids.
+  std::vector<ExtensionId> ActivateDeferredExtensions(const GURL& url);
+
   // Finish initialization for the shell extension system.
   void FinishInitialization();
 
@@ -57,6 +67,10 @@ class ElectronExtensionSystem : public ExtensionSystem {
 
   void RemoveExtension(const ExtensionId& extension_id);
 
+  ElectronScriptFileCache* script_file_cache() {
+    return script_file_cache_.get();
+  }
+
   // KeyedService implementation:
   void Shutdown() override;
 
@@ -102,6 +116,7 @@ class ElectronExtensionSystem : public ExtensionSystem {
   std::unique_ptr<ManagementPolicy> management_policy_;
 
   std::unique_ptr<ElectronExtensionLoader> extension_loader_;
+  std::unique_ptr<ElectronScriptFileCache> script_file_cache_;
 
   scoped_refptr<value_store::ValueStoreFactory> store_factory_;
 
@@ -0,0 +1,79 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/extensions/electron_script_file_cache.h"
+
+#include <utility>
+
+#include "extensions/common/extension.h"
+
+namespace extensions {
+
+namespace {
+
+// Scripts can be several megabytes each, so the cache is bounded by both the
+// number of files and their total size.
+constexpr size_t kMaxFiles = 256;
+constexpr size_t kMaxTotalSize = 32 * 1024 * 1024;
+
+}  // namespace
+
+ElectronScriptFileCache::ElectronScriptFileCache(
+    content::BrowserContext* browser_context)
+    : registry_(ExtensionRegistry::Get(browser_context)),
+      files_(base::LRUCache<Key, std::string>::NO_AUTO_EVICT) {
+  registry_observation_.Observe(registry_);
+}
+
+ElectronScriptFileCache::~ElectronScriptFileCache() = default;
+
+const std::string* ElectronScriptFileCache::Get(const Extension& extension,
+                                                const std::string& file,
+                                                bool localized) {
+  auto it = files_.Get(Key(extension.id(), file, localized));
+  return it == files_.end() ? nullptr : &it->second;
+}
+
+void ElectronScriptFileCache::Put(const Extension& extension,
+                                  const std::string& file,
+                                  bool localized,
+                                  std::string data) {
+  if (data.size() > kMaxTotalSize ||
+      registry_->enabled_extensions().GetByID(extension.id()) != &extension)
+    return;
+
+  Key key(extension.id(), file, localized);
+  auto it = files_.Peek(key);
+  if (it != files_.end()) {
+    total_size_ -= it->second.size();
+    files_.Erase(it);
+  }
+  total_size_ += data.size();
+  files_.Put(std::move(key), std::move(data));
+  EvictToFit();
+}
+
+void ElectronScriptFileCache::OnExtensionUnloaded(
+    content::BrowserContext* browser_context,
+    const Extension* extension,
+    UnloadedExtensionReason reason) {
+  for (auto it = files_.begin(); it != files_.end();) {
+    if (std::get<0>(it->first) == extension->id()) {
+      total_size_ -= it->second.size();
+      it = files_.Erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void ElectronScriptFileCache::EvictToFit() {
+  while (files_.size() > kMaxFiles || total_size_ > kMaxTotalSize) {
+    auto oldest = files_.rbegin();
+    total_size_ -= oldest->second.size();
+    files_.Erase(oldest);
+  }
+}
+
+}  // namespace extensions
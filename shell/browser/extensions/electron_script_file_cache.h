@@ -0,0 +1,78 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_EXTENSIONS_ELECTRON_SCRIPT_FILE_CACHE_H_
+#define ELECTRON_SHELL_BROWSER_EXTENSIONS_ELECTRON_SCRIPT_FILE_CACHE_H_
+
+#include <string>
+#include <tuple>
+
+#include "base/containers/lru_cache.h"
+#include "base/memory/raw_ptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/scoped_observation.h"
+#include "extensions/browser/extension_registry.h"
+#include "extensions/browser/extension_registry_observer.h"
+#include "extensions/common/extension_id.h"
+
+namespace content {
+class BrowserContext;
+}
+
+namespace extensions {
+
+class Extension;
+
+// Keeps the contents of the files injected with chrome.scripting, so that
+// extensions injecting the same files into every page don't have them read
+// and localized again each time. The files of an extension are dropped when
+// it is unloaded, which also happens when it is updated or reloaded.
+class ElectronScriptFileCache : public ExtensionRegistryObserver {
+ public:
+  explicit ElectronScriptFileCache(content::BrowserContext* browser_context);
+  ~ElectronScriptFileCache() override;
+
+  // disable copy
+  ElectronScriptFileCache(const ElectronScriptFileCache&) = delete;
+  ElectronScriptFileCache& operator=(const ElectronScriptFileCache&) = delete;
+
+  // Returns the contents of |file| of |extension|, or nullptr when they
+  // aren't cached. The pointer is only valid until the cache is changed.
+  const std::string* Get(const Extension& extension,
+                         const std::string& file,
+                         bool localized);
+  // Files of extensions that were unloaded while their files were read are
+  // ignored, since the new version of the extension could differ.
+  void Put(const Extension& extension,
+           const std::string& file,
+           bool localized,
+           std::string data);
+
+  base::WeakPtr<ElectronScriptFileCache> GetWeakPtr() {
+    return weak_factory_.GetWeakPtr();
+  }
+
+  // ExtensionRegistryObserver:
+  void OnExtensionUnloaded(content::BrowserContext* browser_context,
+                           const Extension* extension,
+                           UnloadedExtensionReason reason) override;
+
+ private:
+  using Key = std::tuple<ExtensionId, std::string, bool>;
+
+  void EvictToFit();
+
+  raw_ptr<ExtensionRegistry> registry_;
+  base::LRUCache<Key, std::string> files_;
+  size_t total_size_ = 0;
+
+  base::ScopedObservation<ExtensionRegistry, ExtensionRegistryObserver>
+      registry_observation_{this};
+
+  base::WeakPtrFactory<ElectronScriptFileCache> weak_factory_{this};
+};
+
+}  // namespace extensions
+
+#endif  // ELECTRON_SHELL_BROWSER_EXTENSIONS_ELECTRON_SCRIPT_FILE_CACHE_H_
@@ -10,12 +10,16 @@
 #include "base/command_line.h"
 #include "base/feature_list.h"
 #include "base/metrics/field_trial.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
+#include "components/download/public/common/download_features.h"
 #include "components/spellcheck/common/spellcheck_features.h"
 #include "content/public/common/content_features.h"
 #include "electron/buildflags/buildflags.h"
 #include "media/base/media_switches.h"
 #include "net/base/features.h"
 #include "services/network/public/cpp/features.h"
+#include "shell/common/options_switches.h"
 #include "third_party/blink/public/common/features.h"
 
 #if BUILDFLAG(IS_MAC)
@@ -49,6 +53,18 @@ void InitializeFeatureList() {
       // 'custom dictionary word list API' spec to crash.
       std::string(",") + spellcheck::kWinDelaySpellcheckServiceInit.name;
 #endif
+  // Downloads from servers that accept range requests are fetched over this
+  // many connections, the download system reassembles and hashes the file.
+  int parallel_download_segments = 0;
+  if (base::StringToInt(
+          cmd_line->GetSwitchValueASCII(switches::kParallelDownloadSegments),
+          &parallel_download_segments) &&
+      parallel_download_segments > 1) {
+    enable_features += base::StringPrintf(
+        ",%s:request_count/%d", download::features::kParallelDownloading.name,
+        parallel_download_segments);
+  }
+
   std::string platform_specific_enable_features =
       EnablePlatformSpecificFeatures();
   if (platform_specific_enable_features.size() > 0) {
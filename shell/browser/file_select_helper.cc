@@ -10,12 +10,13 @@
 #include <string>
 #include <utility>
 
+#include "base/files/file_enumerator.h"
 #include "base/files/file_util.h"
 #include "base/functional/bind.h"
-#include "base/memory/ptr_util.h"
 #include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/synchronization/atomic_flag.h"
 #include "base/task/thread_pool.h"
 #include "base/threading/hang_watcher.h"
 #include "build/build_config.h"
@@ -48,20 +49,70 @@ using content::WebContents;
 
 namespace {
 
+using CancellationFlag = base::RefCountedData<base::AtomicFlag>;
+
 void DeleteFiles(std::vector<base::FilePath> paths) {
   for (auto& file_path : paths)
     base::DeleteFile(file_path);
 }
 
+std::vector<FileChooserFileInfoPtr> ToFileChooserFileInfoList(
+    const std::vector<ui::SelectedFileInfo>& files) {
+  std::vector<FileChooserFileInfoPtr> chooser_files;
+  chooser_files.reserve(files.size());
+  for (const auto& file : files) {
+    chooser_files.push_back(
+        FileChooserFileInfo::NewNativeFile(blink::mojom::NativeFileInfo::New(
+            file.local_path,
+            base::FilePath(file.display_name).AsUTF16Unsafe())));
+  }
+  return chooser_files;
+}
+
+// Lists the files below |path| and converts them for the listener. Selected
+// folders can hold hundreds of thousands of files, so this runs on the thread
+// pool as a whole, rather than passing each file to the UI thread.
+std::optional<std::vector<FileChooserFileInfoPtr>> EnumerateFiles(
+    const base::FilePath& path,
+    bool upload_folder,
+    scoped_refptr<CancellationFlag> cancelled) {
+  if (!base::DirectoryExists(path))
+    return std::nullopt;
+
+  std::vector<base::FilePath> paths;
+  base::FileEnumerator enumerator(path, /*recursive=*/true,
+                                  base::FileEnumerator::FILES);
+  for (base::FilePath file = enumerator.Next(); !file.empty();
+       file = enumerator.Next()) {
+    if (cancelled->data.IsSet())
+      return std::nullopt;
+    paths.push_back(std::move(file));
+  }
+
+  if (upload_folder)
+    return ToFileChooserFileInfoList(
+        ui::FilePathListToSelectedFileInfoList(paths));
+
+  std::vector<FileChooserFileInfoPtr> chooser_files;
+  chooser_files.reserve(paths.size());
+  for (auto& file_path : paths) {
+    chooser_files.push_back(FileChooserFileInfo::NewNativeFile(
+        blink::mojom::NativeFileInfo::New(std::move(file_path),
+                                          std::u16string())));
+  }
+  return chooser_files;
+}
+
 }  // namespace
 
 struct FileSelectHelper::ActiveDirectoryEnumeration {
   explicit ActiveDirectoryEnumeration(const base::FilePath& path)
       : path_(path) {}
 
-  std::unique_ptr<net::DirectoryLister> lister_;
   const base::FilePath path_;
-  std::vector<base::FilePath> results_;
+  // Set to stop the enumeration early.
+  scoped_refptr<CancellationFlag> cancelled_ =
+      base::MakeRefCounted<CancellationFlag>();
 };
 
 FileSelectHelper::FileSelectHelper()
@@ -117,28 +168,19 @@ void FileSelectHelper::FileSelectionCanceled(void* params) {
 void FileSelectHelper::StartNewEnumeration(const base::FilePath& path) {
   base_dir_ = path;
   auto entry = std::make_unique<ActiveDirectoryEnumeration>(path);
-  entry->lister_ = base::WrapUnique(new net::DirectoryLister(
-      path, net::DirectoryLister::NO_SORT_RECURSIVE, this));
-  entry->lister_->Start();
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE,
+      {base::MayBlock(), base::TaskPriority::USER_BLOCKING,
+       base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN},
+      base::BindOnce(&EnumerateFiles, path,
+                     dialog_type_ == ui::SelectFileDialog::SELECT_UPLOAD_FOLDER,
+                     entry->cancelled_),
+      base::BindOnce(&FileSelectHelper::OnEnumerationDone, this));
   directory_enumeration_ = std::move(entry);
 }
 
-void FileSelectHelper::OnListFile(
-    const net::DirectoryLister::DirectoryListerData& data) {
-  // Directory upload only cares about files.
-  if (data.info.IsDirectory())
-    return;
-
-  directory_enumeration_->results_.push_back(data.path);
-}
-
-void FileSelectHelper::LaunchConfirmationDialog(
-    const base::FilePath& path,
-    std::vector<ui::SelectedFileInfo> selected_files) {
-  ConvertToFileChooserFileInfoList(std::move(selected_files));
-}
-
-void FileSelectHelper::OnListDone(int error) {
+void FileSelectHelper::OnEnumerationDone(
+    std::optional<std::vector<FileChooserFileInfoPtr>> files) {
   if (!web_contents_) {
     // Web contents was destroyed under us (probably by closing the tab). We
     // must notify |listener_| and release our reference to
@@ -147,47 +189,35 @@ void FileSelectHelper::OnListDone(int error) {
     return;
   }
 
-  // This entry needs to be cleaned up when this function is done.
-  std::unique_ptr<ActiveDirectoryEnumeration> entry =
-      std::move(directory_enumeration_);
-  if (error) {
+  directory_enumeration_.reset();
+  if (!files) {
     FileSelectionCanceled(nullptr);
     return;
   }
 
-  std::vector<ui::SelectedFileInfo> selected_files =
-      ui::FilePathListToSelectedFileInfoList(entry->results_);
-
   if (dialog_type_ == ui::SelectFileDialog::SELECT_UPLOAD_FOLDER) {
-    LaunchConfirmationDialog(entry->path_, std::move(selected_files));
+    if (AbortIfWebContentsDestroyed())
+      return;
+    PerformContentAnalysisIfNeeded(std::move(*files));
   } else {
-    std::vector<FileChooserFileInfoPtr> chooser_files;
-    for (const auto& file_path : entry->results_) {
-      chooser_files.push_back(FileChooserFileInfo::NewNativeFile(
-          blink::mojom::NativeFileInfo::New(file_path, std::u16string())));
-    }
-
-    listener_->FileSelected(std::move(chooser_files), base_dir_,
+    listener_->FileSelected(std::move(*files), base_dir_,
                             FileChooserParams::Mode::kUploadFolder);
     listener_.reset();
     EnumerateDirectoryEnd();
   }
 }
 
+void FileSelectHelper::CancelEnumeration() {
+  if (directory_enumeration_)
+    directory_enumeration_->cancelled_->data.Set();
+}
+
 void FileSelectHelper::ConvertToFileChooserFileInfoList(
     const std::vector<ui::SelectedFileInfo>& files) {
   if (AbortIfWebContentsDestroyed())
     return;
 
-  std::vector<FileChooserFileInfoPtr> chooser_files;
-  for (const auto& file : files) {
-    chooser_files.push_back(
-        FileChooserFileInfo::NewNativeFile(blink::mojom::NativeFileInfo::New(
-            file.local_path,
-            base::FilePath(file.display_name).AsUTF16Unsafe())));
-  }
-
-  PerformContentAnalysisIfNeeded(std::move(chooser_files));
+  PerformContentAnalysisIfNeeded(ToFileChooserFileInfoList(files));
 }
 
 void FileSelectHelper::PerformContentAnalysisIfNeeded(
@@ -498,6 +528,7 @@ void FileSelectHelper::RenderFrameHostChanged(
        host = host->GetParentOrOuterDocument()) {
     if (host == old_host) {
       render_frame_host_ = nullptr;
+      CancelEnumeration();
       return;
     }
   }
@@ -505,13 +536,16 @@ void FileSelectHelper::RenderFrameHostChanged(
 
 void FileSelectHelper::RenderFrameDeleted(
     content::RenderFrameHost* render_frame_host) {
-  if (render_frame_host == render_frame_host_)
+  if (render_frame_host == render_frame_host_) {
     render_frame_host_ = nullptr;
+    CancelEnumeration();
+  }
 }
 
 void FileSelectHelper::WebContentsDestroyed() {
   render_frame_host_ = nullptr;
   web_contents_ = nullptr;
+  CancelEnumeration();
   CleanUp();
 }
 
@@ -6,6 +6,7 @@
 #define ELECTRON_SHELL_BROWSER_FILE_SELECT_HELPER_H_
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -17,7 +18,6 @@
 #include "content/public/browser/render_widget_host.h"
 #include "content/public/browser/render_widget_host_observer.h"
 #include "content/public/browser/web_contents_observer.h"
-#include "net/base/directory_lister.h"
 #include "third_party/blink/public/mojom/choosers/file_chooser.mojom.h"
 #include "ui/shell_dialogs/select_file_dialog.h"
 
@@ -41,8 +41,7 @@ class FileSelectHelper : public base::RefCountedThreadSafe<
                              FileSelectHelper,
                              content::BrowserThread::DeleteOnUIThread>,
                          public ui::SelectFileDialog::Listener,
-                         public content::WebContentsObserver,
-                         private net::DirectoryLister::DirectoryListerDelegate {
+                         public content::WebContentsObserver {
  public:
   // disable copy
   FileSelectHelper(const FileSelectHelper&) = delete;
@@ -105,14 +104,13 @@ class FileSelectHelper : public base::RefCountedThreadSafe<
   // Kicks off a new directory enumeration.
   void StartNewEnumeration(const base::FilePath& path);
 
-  // net::DirectoryLister::DirectoryListerDelegate overrides.
-  void OnListFile(
-      const net::DirectoryLister::DirectoryListerData& data) override;
-  void OnListDone(int error) override;
+  // Called with the files found by the enumeration, or std::nullopt if it
+  // failed or was cancelled.
+  void OnEnumerationDone(
+      std::optional<std::vector<blink::mojom::FileChooserFileInfoPtr>> files);
 
-  void LaunchConfirmationDialog(
-      const base::FilePath& path,
-      std::vector<ui::SelectedFileInfo> selected_files);
+  // Stops the directory enumeration in progress, if any.
+  void CancelEnumeration();
 
   // Cleans up and releases this instance. This must be called after the last
   // callback is received from the enumeration code.
@@ -0,0 +1,54 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/frame_rate_throttler.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "base/no_destructor.h"
+#include "base/time/time.h"
+#include "components/viz/host/host_frame_sink_manager.h"
+#include "content/browser/compositor/surface_utils.h"  // nogncheck
+
+namespace electron {
+
+// static
+FrameRateThrottler* FrameRateThrottler::GetInstance() {
+  static base::NoDestructor<FrameRateThrottler> instance;
+  return instance.get();
+}
+
+FrameRateThrottler::FrameRateThrottler() = default;
+
+FrameRateThrottler::~FrameRateThrottler() = default;
+
+void FrameRateThrottler::SetFrameRate(const viz::FrameSinkId& frame_sink_id,
+                                      int frame_rate) {
+  auto [it, inserted] = frame_rates_.try_emplace(frame_sink_id, frame_rate);
+  if (!inserted && it->second == frame_rate)
+    return;
+  it->second = frame_rate;
+  Update();
+}
+
+void FrameRateThrottler::ClearFrameRate(
+    const viz::FrameSinkId& frame_sink_id) {
+  if (frame_rates_.erase(frame_sink_id))
+    Update();
+}
+
+void FrameRateThrottler::Update() {
+  std::vector<viz::FrameSinkId> frame_sink_ids;
+  int frame_rate = 0;
+  for (const auto& [frame_sink_id, rate] : frame_rates_) {
+    frame_sink_ids.push_back(frame_sink_id);
+    frame_rate = std::max(frame_rate, rate);
+  }
+  content::GetHostFrameSinkManager()->Throttle(
+      frame_sink_ids,
+      frame_rate ? base::Hertz(frame_rate) : base::TimeDelta());
+}
+
+}  // namespace electron
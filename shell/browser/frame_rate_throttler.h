@@ -0,0 +1,38 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_FRAME_RATE_THROTTLER_H_
+#define ELECTRON_SHELL_BROWSER_FRAME_RATE_THROTTLER_H_
+
+#include "base/containers/flat_map.h"
+#include "components/viz/common/surfaces/frame_sink_id.h"
+
+namespace electron {
+
+// Caps the frame rate of frame sinks, along with the frame sinks embedded in
+// them. Viz throttles all of them at a single interval, so when several are
+// capped at once they all run at the highest of their frame rates.
+class FrameRateThrottler {
+ public:
+  static FrameRateThrottler* GetInstance();
+
+  FrameRateThrottler();
+  ~FrameRateThrottler();
+
+  // disable copy
+  FrameRateThrottler(const FrameRateThrottler&) = delete;
+  FrameRateThrottler& operator=(const FrameRateThrottler&) = delete;
+
+  void SetFrameRate(const viz::FrameSinkId& frame_sink_id, int frame_rate);
+  void ClearFrameRate(const viz::FrameSinkId& frame_sink_id);
+
+ private:
+  void Update();
+
+  base::flat_map<viz::FrameSinkId, int> frame_rates_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_FRAME_RATE_THROTTLER_H_
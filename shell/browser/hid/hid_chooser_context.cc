@@ -343,6 +343,7 @@ void HidChooserContext::OnHidManagerConnectionError() {
   hid_manager_.reset();
   client_receiver_.reset();
   devices_.clear();
+  is_initialized_ = false;
 
   std::vector<url::Origin> revoked_origins;
   revoked_origins.reserve(ephemeral_devices_.size());
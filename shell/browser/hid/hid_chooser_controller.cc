@@ -99,7 +99,9 @@ HidChooserController::HidChooserController(
                          ->AsWeakPtr();
   DCHECK(chooser_context_);
 
-  chooser_context_->GetHidManager()->GetDevices(base::BindOnce(
+  // The chooser context keeps the list of connected devices up to date, so the
+  // devices do not need to be enumerated for each chooser.
+  chooser_context_->GetDevices(base::BindOnce(
       &HidChooserController::OnGotDevices, weak_factory_.GetWeakPtr()));
 }
 
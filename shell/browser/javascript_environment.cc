@@ -4,8 +4,10 @@
 
 #include "shell/browser/javascript_environment.h"
 
+#include <functional>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_set>
 #include <utility>
 
@@ -13,23 +15,37 @@
 #include "base/allocator/partition_allocator/src/partition_alloc/partition_alloc.h"
 #include "base/bits.h"
 #include "base/command_line.h"
+#include "base/containers/flat_map.h"
 #include "base/feature_list.h"
+#include "base/logging.h"
 #include "base/no_destructor.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/task/current_thread.h"
 #include "base/task/single_thread_task_runner.h"
 #include "base/task/thread_pool/initialization_util.h"
 #include "base/trace_event/trace_event.h"
+#include "content/public/common/content_switches.h"
 #include "gin/array_buffer.h"
+#include "gin/converter.h"
 #include "gin/v8_initializer.h"
 #include "shell/browser/microtasks_runner.h"
 #include "shell/common/gin_helper/cleaned_up_at_exit.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/options_switches.h"
 #include "third_party/blink/public/common/switches.h"
 #include "third_party/electron_node/src/node_wasm_web_api.h"
 
 namespace {
 v8::Isolate* g_isolate;
+
+using InternalizedStrings =
+    base::flat_map<std::string, v8::Eternal<v8::String>, std::less<>>;
+
+InternalizedStrings& GetInternalizedStrings() {
+  static base::NoDestructor<InternalizedStrings> strings;
+  return *strings;
 }
+}  // namespace
 
 namespace gin {
 
@@ -127,6 +143,7 @@ JavascriptEnvironment::~JavascriptEnvironment() {
     isolate_->GetCurrentContext()->Exit();
   }
   isolate_->Exit();
+  GetInternalizedStrings().clear();
   g_isolate = nullptr;
 
   platform_->UnregisterIsolate(isolate_);
@@ -283,21 +300,43 @@ v8::Isolate* JavascriptEnvironment::Initialize(uv_loop_t* event_loop,
                                                bool setup_wasm_streaming) {
   auto* cmd = base::CommandLine::ForCurrentProcess();
 
-  // --js-flags.
+  // --js-flags. Renderer and utility processes get the flags of their type
+  // appended to it at launch, the main process appends its own here.
   std::string js_flags =
       cmd->GetSwitchValueASCII(blink::switches::kJavaScriptFlags);
+  if (!cmd->HasSwitch(::switches::kProcessType) &&
+      cmd->HasSwitch(switches::kBrowserJsFlags)) {
+    js_flags.append(" ").append(
+        cmd->GetSwitchValueASCII(switches::kBrowserJsFlags));
+  }
   js_flags.append(" --no-freeze-flags-after-init");
   if (!js_flags.empty())
     v8::V8::SetFlagsFromString(js_flags.c_str(), js_flags.size());
 
+  // The worker threads run V8's background tasks, like garbage collection and
+  // compilation. They are sized to the number of cores unless the app picked
+  // a count that fits the CPU quota of its environment.
+  int worker_threads =
+      base::RecommendedMaxNumberOfThreadsInThreadGroup(3, 8, 0.1, 0);
+  if (cmd->HasSwitch(switches::kV8WorkerThreads)) {
+    int count = 0;
+    if (base::StringToInt(cmd->GetSwitchValueASCII(switches::kV8WorkerThreads),
+                          &count) &&
+        count > 0) {
+      worker_threads = count;
+    } else {
+      LOG(WARNING) << "Ignoring invalid --" << switches::kV8WorkerThreads;
+    }
+  }
+
   // The V8Platform of gin relies on Chromium's task schedule, which has not
   // been started at this point, so we have to rely on Node's V8Platform.
   auto* tracing_agent = node::CreateAgent();
   auto* tracing_controller = new TracingControllerImpl();
   node::tracing::TraceEventHelper::SetAgent(tracing_agent);
   platform_ = node::MultiIsolatePlatform::Create(
-      base::RecommendedMaxNumberOfThreadsInThreadGroup(3, 8, 0.1, 0),
-      tracing_controller, gin::V8Platform::GetCurrentPageAllocator());
+      worker_threads, tracing_controller,
+      gin::V8Platform::GetCurrentPageAllocator());
 
   v8::V8::InitializePlatform(platform_.get());
   gin::IsolateHolder::Initialize(gin::IsolateHolder::kNonStrictMode,
@@ -331,6 +370,21 @@ v8::Isolate* JavascriptEnvironment::GetIsolate() {
   return g_isolate;
 }
 
+// static
+v8::Local<v8::String> JavascriptEnvironment::GetInternalizedString(
+    std::string_view str) {
+  v8::Isolate* isolate = GetIsolate();
+  auto& strings = GetInternalizedStrings();
+  auto iter = strings.find(str);
+  if (iter == strings.end()) {
+    iter = strings
+               .emplace(str, v8::Eternal<v8::String>(
+                                 isolate, gin::StringToSymbol(isolate, str)))
+               .first;
+  }
+  return iter->second.Get(isolate);
+}
+
 void JavascriptEnvironment::CreateMicrotasksRunner() {
   DCHECK(!microtasks_runner_);
   microtasks_runner_ = std::make_unique<MicrotasksRunner>(isolate());
@@ -6,6 +6,7 @@
 #define ELECTRON_SHELL_BROWSER_JAVASCRIPT_ENVIRONMENT_H_
 
 #include <memory>
+#include <string_view>
 
 #include "base/memory/raw_ptr.h"
 #include "gin/public/isolate_holder.h"
@@ -39,6 +40,11 @@ class JavascriptEnvironment {
 
   static v8::Isolate* GetIsolate();
 
+  // Returns |str| as an internalized string of the isolate which is created
+  // once and kept for the lifetime of the isolate. Only meant for the fixed
+  // set of event names, as the strings are never released.
+  static v8::Local<v8::String> GetInternalizedString(std::string_view str);
+
  private:
   v8::Isolate* Initialize(uv_loop_t* event_loop, bool setup_wasm_streaming);
   std::unique_ptr<node::MultiIsolatePlatform> platform_;
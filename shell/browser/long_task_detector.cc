@@ -0,0 +1,252 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/long_task_detector.h"
+
+#include <string>
+#include <utility>
+
+#include "base/check.h"
+#include "base/functional/bind.h"
+#include "base/memory/raw_ptr.h"
+#include "base/memory/ref_counted.h"
+#include "base/pending_task.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/lock.h"
+#include "base/task/current_thread.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/task/single_thread_task_runner.h"
+#include "base/task/thread_pool.h"
+#include "base/trace_event/trace_event.h"
+#include "gin/converter.h"
+#include "v8/include/v8.h"
+
+namespace electron {
+
+namespace {
+
+constexpr int kMaxStackFrames = 20;
+
+// The detector of the UI thread, which the blocking calls are reported to.
+LongTaskDetector* g_detector = nullptr;
+
+std::string FormatCurrentStack(v8::Isolate* isolate) {
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::StackTrace> stack =
+      v8::StackTrace::CurrentStackTrace(isolate, kMaxStackFrames);
+  std::string result;
+  for (int i = 0; i < stack->GetFrameCount(); ++i) {
+    v8::Local<v8::StackFrame> frame = stack->GetFrame(isolate, i);
+    std::string function_name =
+        gin::V8ToString(isolate, frame->GetFunctionName());
+    std::string script_name =
+        gin::V8ToString(isolate, frame->GetScriptNameOrSourceURL());
+    if (function_name.empty())
+      function_name = "<anonymous>";
+    base::StringAppendF(&result, "    at %s (%s:%d:%d)\n",
+                        function_name.c_str(), script_name.c_str(),
+                        frame->GetLineNumber(), frame->GetColumn());
+  }
+  return result;
+}
+
+}  // namespace
+
+// Checks on the task that is running on the observed thread from a
+// background sequence, as the observed thread can't notice it is stuck by
+// itself. A check is only scheduled while a task is running that hasn't been
+// caught yet, so the watchdog stays idle along with the thread.
+class LongTaskDetector::Watchdog
+    : public base::RefCountedThreadSafe<Watchdog> {
+ public:
+  Watchdog(v8::Isolate* isolate, base::TimeDelta threshold)
+      : isolate_(isolate),
+        threshold_(threshold),
+        task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+            {base::TaskPriority::USER_BLOCKING})) {}
+
+  // disable copy
+  Watchdog(const Watchdog&) = delete;
+  Watchdog& operator=(const Watchdog&) = delete;
+
+  void TaskStarted(base::TimeTicks start) {
+    {
+      base::AutoLock lock(lock_);
+      ++task_id_;
+      task_start_ = start;
+      stack_requested_ = false;
+      js_stack_.clear();
+      // A check that is already scheduled moves on to this task.
+      if (check_scheduled_)
+        return;
+      check_scheduled_ = true;
+    }
+    ScheduleCheck(threshold_);
+  }
+
+  // Returns the JavaScript stack captured while the task was running. The
+  // scheduled check, if any, finds the thread idle and stops there.
+  std::string TaskFinished() {
+    base::AutoLock lock(lock_);
+    task_start_ = base::TimeTicks();
+    return std::move(js_stack_);
+  }
+
+  void Shutdown() {
+    base::AutoLock lock(lock_);
+    isolate_ = nullptr;
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<Watchdog>;
+  ~Watchdog() = default;
+
+  void ScheduleCheck(base::TimeDelta delay) {
+    task_runner_->PostDelayedTask(
+        FROM_HERE, base::BindOnce(&Watchdog::Check, this), delay);
+  }
+
+  void Check() {
+    base::TimeDelta delay;
+    {
+      base::AutoLock lock(lock_);
+      if (!isolate_ || task_start_.is_null() || stack_requested_) {
+        check_scheduled_ = false;
+        return;
+      }
+      base::TimeDelta elapsed = base::TimeTicks::Now() - task_start_;
+      if (elapsed < threshold_) {
+        // The task started after the check was scheduled.
+        delay = threshold_ - elapsed;
+      } else {
+        stack_requested_ = true;
+        requested_task_id_ = task_id_;
+        check_scheduled_ = false;
+        // Released by the interrupt, which might never run if the thread
+        // doesn't enter JavaScript again before the isolate goes away.
+        AddRef();
+        isolate_->RequestInterrupt(&Watchdog::CaptureStack, this);
+        return;
+      }
+    }
+    ScheduleCheck(delay);
+  }
+
+  // Runs on the observed thread, possibly only once a later task enters
+  // JavaScript, in which case there is nothing to capture.
+  static void CaptureStack(v8::Isolate* isolate, void* data) {
+    auto* self = static_cast<Watchdog*>(data);
+    bool capture;
+    {
+      base::AutoLock lock(self->lock_);
+      capture = self->isolate_ && !self->task_start_.is_null() &&
+                self->task_id_ == self->requested_task_id_;
+    }
+    if (capture) {
+      // The task id only changes on this thread, so the stack still belongs
+      // to the task that went over the threshold.
+      std::string js_stack = FormatCurrentStack(isolate);
+      base::AutoLock lock(self->lock_);
+      self->js_stack_ = std::move(js_stack);
+    }
+    self->Release();
+  }
+
+  base::Lock lock_;
+  raw_ptr<v8::Isolate> isolate_ GUARDED_BY(lock_);
+  uint64_t task_id_ GUARDED_BY(lock_) = 0;
+  uint64_t requested_task_id_ GUARDED_BY(lock_) = 0;
+  // Null while the thread is idle.
+  base::TimeTicks task_start_ GUARDED_BY(lock_);
+  bool stack_requested_ GUARDED_BY(lock_) = false;
+  std::string js_stack_ GUARDED_BY(lock_);
+  bool check_scheduled_ GUARDED_BY(lock_) = false;
+
+  const base::TimeDelta threshold_;
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+};
+
+// static
+void LongTaskDetector::MarkBlockingCall(const char* name) {
+  if (g_detector)
+    g_detector->OnBlockingCall(name);
+}
+
+LongTaskDetector::LongTaskDetector(v8::Isolate* isolate,
+                                   base::TimeDelta threshold,
+                                   ReportCallback callback)
+    : isolate_(isolate),
+      threshold_(threshold),
+      callback_(std::move(callback)),
+      watchdog_(base::MakeRefCounted<Watchdog>(isolate, threshold)) {
+  base::CurrentThread::Get()->AddTaskObserver(this);
+  DCHECK(!g_detector);
+  g_detector = this;
+}
+
+LongTaskDetector::~LongTaskDetector() {
+  g_detector = nullptr;
+  base::CurrentThread::Get()->RemoveTaskObserver(this);
+  watchdog_->Shutdown();
+}
+
+void LongTaskDetector::OnBlockingCall(const char* name) {
+  // Only the calls made by the outermost task are tracked, as that is the
+  // one that is reported.
+  if (nesting_depth_ != 1 || blocked_by_)
+    return;
+  blocked_by_ = name;
+  // The watchdog could only capture the stacks of the tasks run by the nested
+  // loop, so the stack is captured now.
+  blocked_js_stack_ = FormatCurrentStack(isolate_);
+}
+
+void LongTaskDetector::WillProcessTask(const base::PendingTask& pending_task,
+                                       bool was_blocked_or_low_priority) {
+  if (nesting_depth_++ > 0) {
+    nested_ = true;
+    return;
+  }
+  nested_ = false;
+  blocked_by_ = nullptr;
+  blocked_js_stack_.clear();
+  task_start_ = base::TimeTicks::Now();
+  watchdog_->TaskStarted(task_start_);
+}
+
+void LongTaskDetector::DidProcessTask(const base::PendingTask& pending_task) {
+  // The observer can be added while a task is running.
+  if (nesting_depth_ == 0)
+    return;
+  if (--nesting_depth_ > 0)
+    return;
+
+  std::string js_stack = watchdog_->TaskFinished();
+  base::TimeDelta duration = base::TimeTicks::Now() - task_start_;
+  if ((nested_ && !blocked_by_) || duration < threshold_)
+    return;
+
+  std::string blocked_by;
+  if (blocked_by_) {
+    blocked_by = blocked_by_;
+    js_stack = std::move(blocked_js_stack_);
+  }
+
+  TRACE_EVENT_INSTANT2("electron", "LongTask", TRACE_EVENT_SCOPE_THREAD,
+                       "duration_ms", duration.InMillisecondsF(),
+                       "posted_from", pending_task.posted_from.ToString());
+
+  LongTask long_task{duration, pending_task.posted_from, std::move(js_stack),
+                     std::move(blocked_by)};
+  base::SingleThreadTaskRunner::GetCurrentDefault()->PostTask(
+      FROM_HERE, base::BindOnce(
+                     [](base::WeakPtr<LongTaskDetector> detector,
+                        const LongTask& long_task) {
+                       if (detector)
+                         detector->callback_.Run(long_task);
+                     },
+                     weak_factory_.GetWeakPtr(), std::move(long_task)));
+}
+
+}  // namespace electron
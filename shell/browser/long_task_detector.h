@@ -0,0 +1,91 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_LONG_TASK_DETECTOR_H_
+#define ELECTRON_SHELL_BROWSER_LONG_TASK_DETECTOR_H_
+
+#include <string>
+
+#include "base/functional/callback.h"
+#include "base/location.h"
+#include "base/memory/raw_ptr.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/task/task_observer.h"
+#include "base/time/time.h"
+
+namespace v8 {
+class Isolate;
+}
+
+namespace electron {
+
+// Reports the tasks of the current thread that run for longer than a
+// threshold, which on the UI thread of the browser process means that the
+// input of every window was blocked meanwhile. A watchdog on a background
+// sequence interrupts V8 once a task has gone over the threshold, so the
+// JavaScript stack can be reported when the task is busy running script.
+class LongTaskDetector : public base::TaskObserver {
+ public:
+  struct LongTask {
+    base::TimeDelta duration;
+    base::Location posted_from;
+    // Empty if the task wasn't running JavaScript when it went over the
+    // threshold.
+    std::string js_stack;
+    // The name of the blocking call the task made, if any. See
+    // MarkBlockingCall().
+    std::string blocked_by;
+  };
+
+  // Marks the start of a call that keeps the JavaScript that made it waiting
+  // on a nested run loop, such as a synchronous dialog. Tasks that spin
+  // nested run loops aren't reported, as the loop keeps processing input, but
+  // the task making such a call is, since script can't run meanwhile. The
+  // call lasts until the end of the task, so only its start is marked.
+  static void MarkBlockingCall(const char* name);
+
+  using ReportCallback = base::RepeatingCallback<void(const LongTask&)>;
+
+  // |callback| is run in a task of its own after each long task.
+  LongTaskDetector(v8::Isolate* isolate,
+                   base::TimeDelta threshold,
+                   ReportCallback callback);
+  ~LongTaskDetector() override;
+
+  // disable copy
+  LongTaskDetector(const LongTaskDetector&) = delete;
+  LongTaskDetector& operator=(const LongTaskDetector&) = delete;
+
+  // base::TaskObserver
+  void WillProcessTask(const base::PendingTask& pending_task,
+                       bool was_blocked_or_low_priority) override;
+  void DidProcessTask(const base::PendingTask& pending_task) override;
+
+ private:
+  class Watchdog;
+
+  void OnBlockingCall(const char* name);
+
+  const raw_ptr<v8::Isolate> isolate_;
+  const base::TimeDelta threshold_;
+  ReportCallback callback_;
+  scoped_refptr<Watchdog> watchdog_;
+
+  base::TimeTicks task_start_;
+  // Tasks run by nested run loops keep processing input, so neither they nor
+  // the task that spun the loop are reported.
+  int nesting_depth_ = 0;
+  bool nested_ = false;
+  // The first blocking call of the running task, and the stack it was made
+  // from.
+  const char* blocked_by_ = nullptr;
+  std::string blocked_js_stack_;
+
+  base::WeakPtrFactory<LongTaskDetector> weak_factory_{this};
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_LONG_TASK_DETECTOR_H_
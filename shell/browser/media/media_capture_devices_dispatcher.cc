@@ -4,14 +4,36 @@
 
 #include "shell/browser/media/media_capture_devices_dispatcher.h"
 
-#include "components/webrtc/media_stream_devices_util.h"
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "base/containers/contains.h"
 #include "content/public/browser/browser_thread.h"
-#include "content/public/browser/media_capture_devices.h"
 
 using content::BrowserThread;
 
 namespace electron {
 
+namespace {
+
+// The devices are kept up to date by content::MediaCaptureDevices as they
+// change, so this picks from that list in place, rather than copying and
+// filtering it on every request like webrtc::FilterMediaDevices would.
+std::optional<blink::MediaStreamDevice> GetFirstEligibleDevice(
+    const blink::MediaStreamDevices& devices,
+    const std::vector<std::string>& eligible_device_ids) {
+  for (const auto& device : devices) {
+    if (eligible_device_ids.empty() ||
+        base::Contains(eligible_device_ids, device.id)) {
+      return device;
+    }
+  }
+  return std::nullopt;
+}
+
+}  // namespace
+
 MediaCaptureDevicesDispatcher* MediaCaptureDevicesDispatcher::GetInstance() {
   static base::NoDestructor<MediaCaptureDevicesDispatcher> instance;
   return instance.get();
@@ -51,32 +73,16 @@ const std::optional<blink::MediaStreamDevice>
 MediaCaptureDevicesDispatcher::GetPreferredAudioDeviceForBrowserContext(
     content::BrowserContext* browser_context,
     const std::vector<std::string>& eligible_audio_device_ids) const {
-  auto audio_devices = GetAudioCaptureDevices();
-  if (!eligible_audio_device_ids.empty()) {
-    audio_devices =
-        webrtc::FilterMediaDevices(audio_devices, eligible_audio_device_ids);
-  }
-
-  if (audio_devices.empty())
-    return std::nullopt;
-
-  return audio_devices.front();
+  return GetFirstEligibleDevice(GetAudioCaptureDevices(),
+                                eligible_audio_device_ids);
 }
 
 const std::optional<blink::MediaStreamDevice>
 MediaCaptureDevicesDispatcher::GetPreferredVideoDeviceForBrowserContext(
     content::BrowserContext* browser_context,
     const std::vector<std::string>& eligible_video_device_ids) const {
-  auto video_devices = GetVideoCaptureDevices();
-  if (!eligible_video_device_ids.empty()) {
-    video_devices =
-        webrtc::FilterMediaDevices(video_devices, eligible_video_device_ids);
-  }
-
-  if (video_devices.empty())
-    return std::nullopt;
-
-  return video_devices.front();
+  return GetFirstEligibleDevice(GetVideoCaptureDevices(),
+                                eligible_video_device_ids);
 }
 
 }  // namespace electron
@@ -604,6 +604,11 @@ void NativeWindow::NotifyWindowHide() {
     observer.OnWindowHide();
 }
 
+void NativeWindow::NotifyWindowOcclusionChanged(bool occluded) {
+  for (NativeWindowObserver& observer : observers_)
+    observer.OnWindowOcclusionChanged(occluded);
+}
+
 void NativeWindow::NotifyWindowMaximize() {
   for (NativeWindowObserver& observer : observers_)
     observer.OnWindowMaximize();
@@ -814,6 +819,27 @@ void NativeWindow::UpdateBackgroundThrottlingState() {
       enable_background_throttling);
 }
 
+NativeWindow::ScopedBatchUpdate::ScopedBatchUpdate(NativeWindow* window)
+    : window_(window->GetWeakPtr()) {
+  window->BeginBatchUpdate();
+}
+
+NativeWindow::ScopedBatchUpdate::~ScopedBatchUpdate() {
+  if (window_)
+    window_->EndBatchUpdate();
+}
+
+void NativeWindow::BeginBatchUpdate() {
+  if (batch_update_depth_++ == 0)
+    SetUpdatesBatched(true);
+}
+
+void NativeWindow::EndBatchUpdate() {
+  DCHECK_GT(batch_update_depth_, 0);
+  if (--batch_update_depth_ == 0)
+    SetUpdatesBatched(false);
+}
+
 views::Widget* NativeWindow::GetWidget() {
   return widget();
 }
@@ -305,6 +305,7 @@ class NativeWindow : public base::SupportsUserData,
   void NotifyWindowShow();
   void NotifyWindowIsKeyChanged(bool is_key);
   void NotifyWindowHide();
+  void NotifyWindowOcclusionChanged(bool occluded);
   void NotifyWindowMaximize();
   void NotifyWindowUnmaximize();
   void NotifyWindowMinimize();
@@ -412,11 +413,31 @@ class NativeWindow : public base::SupportsUserData,
   // throttling, then throttling in the `ui::Compositor` will be disabled.
   void UpdateBackgroundThrottlingState();
 
+  // Changes made to the window while an instance is alive are presented
+  // together instead of one by one. Instances can be nested, and may outlive
+  // the window.
+  class ScopedBatchUpdate {
+   public:
+    explicit ScopedBatchUpdate(NativeWindow* window);
+    ~ScopedBatchUpdate();
+
+    // disable copy
+    ScopedBatchUpdate(const ScopedBatchUpdate&) = delete;
+    ScopedBatchUpdate& operator=(const ScopedBatchUpdate&) = delete;
+
+   private:
+    base::WeakPtr<NativeWindow> window_;
+  };
+
  protected:
   friend class api::BrowserView;
 
   NativeWindow(const gin_helper::Dictionary& options, NativeWindow* parent);
 
+  // Called when the outermost batch update begins and ends. A window that is
+  // destroyed in between has to end the batch itself.
+  virtual void SetUpdatesBatched(bool batched) {}
+
   // views::WidgetDelegate:
   views::Widget* GetWidget() override;
   const views::Widget* GetWidget() const override;
@@ -450,6 +471,9 @@ class NativeWindow : public base::SupportsUserData,
   std::list<NativeWindow*> child_windows_;
 
  private:
+  void BeginBatchUpdate();
+  void EndBatchUpdate();
+
   std::unique_ptr<views::Widget> widget_;
 
   static int32_t next_id_;
@@ -497,6 +521,9 @@ class NativeWindow : public base::SupportsUserData,
 
   std::set<BackgroundThrottlingSource*> background_throttling_sources_;
 
+  // The nesting depth of the live ScopedBatchUpdate instances.
+  int batch_update_depth_ = 0;
+
   // Accessible title.
   std::u16string accessible_title_;
 
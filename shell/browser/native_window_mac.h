@@ -215,6 +215,9 @@ class NativeWindowMac : public NativeWindow,
   }
 
  protected:
+  // NativeWindow:
+  void SetUpdatesBatched(bool batched) override;
+
   // views::WidgetDelegate:
   views::View* GetContentsView() override;
   bool CanMaximize() const override;
@@ -229,6 +232,17 @@ class NativeWindowMac : public NativeWindow,
                                uint32_t changed_metrics) override;
 
  private:
+  // An explicit Core Animation transaction, committed when it goes away.
+  class ScopedTransaction {
+   public:
+    ScopedTransaction();
+    ~ScopedTransaction();
+
+    // disable copy
+    ScopedTransaction(const ScopedTransaction&) = delete;
+    ScopedTransaction& operator=(const ScopedTransaction&) = delete;
+  };
+
   // Add custom layers to the content view.
   void AddContentViewLayers();
 
@@ -299,6 +313,10 @@ class NativeWindowMac : public NativeWindow,
 
   // The presentation options before entering simple fullscreen mode.
   NSApplicationPresentationOptions simple_fullscreen_options_;
+
+  // Open while updates are batched. Also committed when the window is
+  // destroyed in the middle of a batch.
+  std::optional<ScopedTransaction> batch_transaction_;
 };
 
 }  // namespace electron
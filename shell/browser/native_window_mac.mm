@@ -5,6 +5,7 @@
 #include "shell/browser/native_window_mac.h"
 
 #include <AvailabilityMacros.h>
+#include <QuartzCore/QuartzCore.h>
 #include <objc/objc-runtime.h>
 
 #include <algorithm>
@@ -361,6 +362,15 @@ NativeWindowMac::NativeWindowMac(const gin_helper::Dictionary& options,
 
 NativeWindowMac::~NativeWindowMac() = default;
 
+NativeWindowMac::ScopedTransaction::ScopedTransaction() {
+  [CATransaction begin];
+  [CATransaction setDisableActions:YES];
+}
+
+NativeWindowMac::ScopedTransaction::~ScopedTransaction() {
+  [CATransaction commit];
+}
+
 void NativeWindowMac::SetContentView(views::View* view) {
   views::View* root_view = GetContentsView();
   if (content_view())
@@ -1192,6 +1202,17 @@ double NativeWindowMac::GetOpacity() const {
   return [window_ alphaValue];
 }
 
+void NativeWindowMac::SetUpdatesBatched(bool batched) {
+  if (batched) {
+    // Hold back both the window server and the layer tree until the batch
+    // is committed, without animating the layer changes in between.
+    [window_ disableScreenUpdatesUntilFlush];
+    batch_transaction_.emplace();
+  } else {
+    batch_transaction_.reset();
+  }
+}
+
 void NativeWindowMac::SetRepresentedFilename(const std::string& filename) {
   [window_ setRepresentedFilename:base::SysUTF8ToNSString(filename)];
   if (buttons_proxy_)
@@ -67,6 +67,10 @@ class NativeWindowObserver : public base::CheckedObserver {
   // Called when window is hidden.
   virtual void OnWindowHide() {}
 
+  // Called when window becomes fully covered by other windows, or stops
+  // being so, while it is shown.
+  virtual void OnWindowOcclusionChanged(bool occluded) {}
+
   // Called when window state changed.
   virtual void OnWindowMaximize() {}
   virtual void OnWindowUnmaximize() {}
@@ -65,6 +65,7 @@
 #if BUILDFLAG(IS_OZONE_X11)
 #include "shell/browser/ui/views/global_menu_bar_x11.h"
 #include "shell/browser/ui/x/event_disabler.h"
+#include "shell/browser/ui/x/x_window_occlusion_tracker.h"
 #include "shell/browser/ui/x/x_window_utils.h"
 #include "ui/gfx/x/atom_cache.h"
 #include "ui/gfx/x/connection.h"
@@ -358,6 +359,10 @@ NativeWindowViews::NativeWindowViews(const gin_helper::Dictionary& options,
     if (!window_type.empty())
       SetWindowType(static_cast<x11::Window>(GetAcceleratedWidget()),
                     window_type);
+
+    // Unlike Windows and macOS, X11 doesn't tell Chromium when a window is
+    // covered, so pages of covered windows would keep rendering.
+    XWindowOcclusionTracker::GetInstance()->Track(this);
   }
 #endif
 
@@ -541,6 +546,11 @@ void NativeWindowViews::ShowInactive() {
 }
 
 void NativeWindowViews::Hide() {
+#if BUILDFLAG(IS_WIN)
+  // A window whose redrawing is off has no WS_VISIBLE to hide.
+  ResumeRedraw();
+#endif
+
   if (is_modal() && NativeWindow::parent())
     static_cast<NativeWindowViews*>(parent())->DecrementChildModals();
 
@@ -567,7 +577,9 @@ bool NativeWindowViews::IsVisible() const {
   // widget()->IsVisible() calls ::IsWindowVisible, which returns non-zero if a
   // window or any of its parent windows are visible. We want to only check the
   // current window.
+  // Turning redrawing off during a batch update clears WS_VISIBLE too.
   bool visible =
+      redraw_disabled_ ||
       ::GetWindowLong(GetAcceleratedWidget(), GWL_STYLE) & WS_VISIBLE;
   // WS_VISIBLE is true even if a window is miminized - explicitly check that.
   return visible && !IsMinimized();
@@ -1198,6 +1210,38 @@ double NativeWindowViews::GetOpacity() const {
   return opacity_;
 }
 
+void NativeWindowViews::SetUpdatesBatched(bool batched) {
+#if BUILDFLAG(IS_WIN)
+  // Changes like SetWindowPos() repaint the window synchronously, so stop
+  // redrawing until the batch is done and then redraw everything once.
+  // WM_SETREDRAW clears and sets WS_VISIBLE, so it is only used on windows
+  // that are visible, and would show a hidden one when redrawing resumes.
+  if (batched) {
+    HWND hwnd = GetAcceleratedWidget();
+    if (::IsWindowVisible(hwnd)) {
+      ::SendMessage(hwnd, WM_SETREDRAW, FALSE, 0);
+      redraw_disabled_ = true;
+    }
+  } else {
+    ResumeRedraw();
+  }
+#endif
+  // Elsewhere the native calls only queue requests, which the window server
+  // applies together once the current task returns.
+}
+
+#if BUILDFLAG(IS_WIN)
+void NativeWindowViews::ResumeRedraw() {
+  if (!redraw_disabled_)
+    return;
+  redraw_disabled_ = false;
+  HWND hwnd = GetAcceleratedWidget();
+  ::SendMessage(hwnd, WM_SETREDRAW, TRUE, 0);
+  ::RedrawWindow(hwnd, nullptr, nullptr,
+                 RDW_ERASE | RDW_FRAME | RDW_INVALIDATE | RDW_ALLCHILDREN);
+}
+#endif
+
 void NativeWindowViews::SetIgnoreMouseEvents(bool ignore, bool forward) {
 #if BUILDFLAG(IS_WIN)
   LONG ex_style = ::GetWindowLong(GetAcceleratedWidget(), GWL_EXSTYLE);
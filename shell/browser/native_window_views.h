@@ -187,6 +187,9 @@ class NativeWindowViews : public NativeWindow,
 #endif
 
  private:
+  // NativeWindow:
+  void SetUpdatesBatched(bool batched) override;
+
   // views::WidgetObserver:
   void OnWidgetActivationChanged(views::Widget* widget, bool active) override;
   void OnWidgetBoundsChanged(views::Widget* widget,
@@ -215,6 +218,8 @@ class NativeWindowViews : public NativeWindow,
   void HandleSizeEvent(WPARAM w_param, LPARAM l_param);
   void ResetWindowControls();
   void SetForwardMouseMessages(bool forward);
+  // Turns redrawing back on if a batch update turned it off.
+  void ResumeRedraw();
   static LRESULT CALLBACK SubclassProc(HWND hwnd,
                                        UINT msg,
                                        WPARAM w_param,
@@ -296,6 +301,9 @@ class NativeWindowViews : public NativeWindow,
   // Set to true if the window is always on top and behind the task bar.
   bool behind_task_bar_ = false;
 
+  // Whether WM_SETREDRAW turned redrawing off for a batch update.
+  bool redraw_disabled_ = false;
+
   // Whether we want to set window placement without side effect.
   bool is_setting_window_placement_ = false;
 
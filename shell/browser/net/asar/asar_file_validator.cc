@@ -18,8 +18,13 @@
 namespace asar {
 
 AsarFileValidator::AsarFileValidator(IntegrityPayload integrity,
-                                     base::File file)
-    : file_(std::move(file)), integrity_(std::move(integrity)) {
+                                     base::File file,
+                                     std::shared_ptr<Archive> archive,
+                                     uint64_t file_offset)
+    : file_(std::move(file)),
+      integrity_(std::move(integrity)),
+      archive_(std::move(archive)),
+      file_offset_(file_offset) {
   current_block_ = 0;
   max_block_ = integrity_.blocks.size() - 1;
 }
@@ -41,9 +46,16 @@ void AsarFileValidator::OnRead(base::span<char> buffer,
           << "Unexpected number of blocks while validating ASAR file stream";
     }
 
-    // Create a hash if we don't have one yet
-    if (!current_hash_) {
+    // Start a new block, hashing it unless an earlier read verified it.
+    if (!in_block_) {
+      in_block_ = true;
       current_hash_byte_count_ = 0;
+      current_block_verified_ =
+          archive_ && archive_->IsBlockVerified(file_offset_, current_block_);
+    }
+
+    // Create a hash if we don't have one yet
+    if (!current_hash_ && !current_block_verified_) {
       switch (integrity_.algorithm) {
         case HashAlgorithm::kSHA256:
           current_hash_ =
@@ -61,7 +73,8 @@ void AsarFileValidator::OnRead(base::span<char> buffer,
     int bytes_to_hash = std::min(block_size - current_hash_byte_count_,
                                  buffer_size - bytes_added);
     DCHECK_GT(bytes_to_hash, 0);
-    current_hash_->Update(buffer.data() + bytes_added, bytes_to_hash);
+    if (!current_block_verified_)
+      current_hash_->Update(buffer.data() + bytes_added, bytes_to_hash);
     bytes_added += bytes_to_hash;
     current_hash_byte_count_ += bytes_to_hash;
     total_hash_byte_count_ += bytes_to_hash;
@@ -80,6 +93,14 @@ bool AsarFileValidator::FinishBlock() {
     }
   }
 
+  if (current_block_verified_) {
+    in_block_ = false;
+    current_block_verified_ = false;
+    current_hash_byte_count_ = 0;
+    current_block_++;
+    return true;
+  }
+
   if (!current_hash_) {
     // This happens when we fail to read the resource. Compute empty content's
     // hash in this case.
@@ -111,6 +132,7 @@ bool AsarFileValidator::FinishBlock() {
   current_hash_->Finish(actual, sizeof(actual));
   current_hash_.reset();
   current_hash_byte_count_ = 0;
+  in_block_ = false;
 
   const std::string expected_hash = integrity_.blocks[current_block_];
   const std::string actual_hex_hash =
@@ -120,6 +142,10 @@ bool AsarFileValidator::FinishBlock() {
     return false;
   }
 
+  if (archive_) {
+    archive_->MarkBlockVerified(file_offset_, current_block_,
+                                integrity_.blocks.size());
+  }
   current_block_++;
 
   return true;
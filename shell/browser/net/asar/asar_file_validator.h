@@ -18,7 +18,12 @@ namespace asar {
 
 class AsarFileValidator : public mojo::FilteredDataSource::Filter {
  public:
-  AsarFileValidator(IntegrityPayload integrity, base::File file);
+  // |archive| and |file_offset| identify the file being read, and are used to
+  // skip hashing blocks already verified by earlier reads.
+  AsarFileValidator(IntegrityPayload integrity,
+                    base::File file,
+                    std::shared_ptr<Archive> archive,
+                    uint64_t file_offset);
   ~AsarFileValidator() override;
 
   // disable copy
@@ -39,6 +44,8 @@ class AsarFileValidator : public mojo::FilteredDataSource::Filter {
  private:
   base::File file_;
   IntegrityPayload integrity_;
+  std::shared_ptr<Archive> archive_;
+  const uint64_t file_offset_;
 
   // The offset in the file_ that the underlying file reader is starting at
   uint64_t read_start_ = 0;
@@ -53,6 +60,10 @@ class AsarFileValidator : public mojo::FilteredDataSource::Filter {
   bool done_reading_ = false;
   int current_block_;
   int max_block_;
+  // Whether OnRead() has started consuming |current_block_|.
+  bool in_block_ = false;
+  // Whether |current_block_| was verified before and doesn't need hashing.
+  bool current_block_verified_ = false;
   uint64_t current_hash_byte_count_ = 0;
   uint64_t total_hash_byte_count_ = 0;
   std::unique_ptr<crypto::SecureHash> current_hash_;
@@ -4,19 +4,54 @@
 
 #include <utility>
 
+#include "base/containers/contains.h"
+#include "base/functional/bind.h"
+#include "base/strings/string_util.h"
+#include "net/base/net_errors.h"
 #include "net/cert/cert_verify_result.h"
 #include "shell/browser/net/cert_verifier_client.h"
 
 namespace electron {
 
+namespace {
+
+// Enough for the hosts an app usually talks to.
+constexpr size_t kMaxCachedResults = 256;
+
+// Works for both the public key pins and the trusted certificates.
+template <typename T>
+bool MatchesHostname(const T& entry, const std::string& hostname) {
+  if (base::EqualsCaseInsensitiveASCII(hostname, entry.hostname))
+    return true;
+  return entry.include_subdomains &&
+         base::EndsWith(hostname, "." + entry.hostname,
+                        base::CompareCase::INSENSITIVE_ASCII);
+}
+
+}  // namespace
+
 VerifyRequestParams::VerifyRequestParams() = default;
 
 VerifyRequestParams::~VerifyRequestParams() = default;
 
 VerifyRequestParams::VerifyRequestParams(const VerifyRequestParams&) = default;
 
-CertVerifierClient::CertVerifierClient(CertVerifyProc proc)
-    : cert_verify_proc_(proc) {}
+CertVerifierClient::PublicKeyPin::PublicKeyPin() = default;
+CertVerifierClient::PublicKeyPin::PublicKeyPin(const PublicKeyPin&) = default;
+CertVerifierClient::PublicKeyPin::~PublicKeyPin() = default;
+
+CertVerifierClient::TrustedCertificate::TrustedCertificate() = default;
+CertVerifierClient::TrustedCertificate::TrustedCertificate(
+    const TrustedCertificate&) = default;
+CertVerifierClient::TrustedCertificate::~TrustedCertificate() = default;
+
+CertVerifierClient::Options::Options() = default;
+CertVerifierClient::Options::Options(const Options&) = default;
+CertVerifierClient::Options::~Options() = default;
+
+CertVerifierClient::CertVerifierClient(CertVerifyProc proc,
+                                       const Options& options)
+    : cert_verify_proc_(proc), options_(options), cache_(kMaxCachedResults) {}
 
 CertVerifierClient::~CertVerifierClient() = default;
 
@@ -28,19 +63,101 @@ void CertVerifierClient::Verify(
     int flags,
     const std::optional<std::string>& ocsp_response,
     VerifyCallback callback) {
+  const int error =
+      ApplyPolicies(default_error, default_result, *certificate, hostname);
+  // A chain that fails a pin is rejected whatever |proc| would decide.
+  if (error != default_error &&
+      error == net::ERR_SSL_PINNED_KEY_NOT_IN_CERT_CHAIN) {
+    std::move(callback).Run(error, default_result);
+    return;
+  }
+
+  if (!cert_verify_proc_) {
+    // ERR_ABORTED uses the result of Chromium.
+    std::move(callback).Run(error == default_error ? net::ERR_ABORTED : error,
+                            default_result);
+    return;
+  }
+
+  CacheKey key{hostname, certificate->CalculateChainFingerprint256(),
+               default_error};
+  if (options_.cache_ttl.is_positive()) {
+    auto iter = cache_.Get(key);
+    if (iter != cache_.end()) {
+      if (base::TimeTicks::Now() < iter->second.expiry) {
+        std::move(callback).Run(iter->second.result, default_result);
+        return;
+      }
+      cache_.Erase(iter);
+    }
+  }
+
   VerifyRequestParams params;
   params.hostname = hostname;
-  params.default_result = net::ErrorToString(default_error);
-  params.error_code = default_error;
+  params.default_result = net::ErrorToString(error);
+  params.error_code = error;
   params.certificate = certificate;
   params.validated_certificate = default_result.verified_cert;
   params.is_issued_by_known_root = default_result.is_issued_by_known_root;
   cert_verify_proc_.Run(
-      params,
-      base::BindOnce(
-          [](VerifyCallback callback, const net::CertVerifyResult& result,
-             int err) { std::move(callback).Run(err, result); },
-          std::move(callback), default_result));
+      params, base::BindOnce(&CertVerifierClient::OnProcResult,
+                             weak_factory_.GetWeakPtr(), std::move(key),
+                             std::move(callback), default_error, error,
+                             default_result));
+}
+
+int CertVerifierClient::ApplyPolicies(
+    int default_error,
+    const net::CertVerifyResult& default_result,
+    const net::X509Certificate& certificate,
+    const std::string& hostname) const {
+  // Only the certificate of the server itself is compared, as an authority
+  // that is trusted by its fingerprint alone can't be checked to have signed
+  // the rest of the chain.
+  if (default_error == net::ERR_CERT_AUTHORITY_INVALID &&
+      !options_.trusted_certificates.empty()) {
+    const net::SHA256HashValue fingerprint =
+        net::X509Certificate::CalculateFingerprint256(
+            certificate.cert_buffer());
+    for (const auto& trusted : options_.trusted_certificates) {
+      if (MatchesHostname(trusted, hostname) &&
+          trusted.fingerprint == net::HashValue(fingerprint)) {
+        return net::OK;
+      }
+    }
+  }
+
+  // Pins only narrow down the chains Chromium accepts.
+  if (default_error != net::OK)
+    return default_error;
+  for (const auto& pin : options_.pins) {
+    if (!MatchesHostname(pin, hostname))
+      continue;
+    for (const auto& hash : default_result.public_key_hashes) {
+      if (base::Contains(pin.hashes, hash))
+        return default_error;
+    }
+    return net::ERR_SSL_PINNED_KEY_NOT_IN_CERT_CHAIN;
+  }
+  return default_error;
+}
+
+void CertVerifierClient::OnProcResult(
+    CacheKey key,
+    VerifyCallback callback,
+    int default_error,
+    int policy_error,
+    const net::CertVerifyResult& default_result,
+    int result) {
+  // When |proc| defers to Chromium, the result is the one the policies
+  // narrowed it to.
+  if (result == net::ERR_ABORTED && policy_error != default_error)
+    result = policy_error;
+  if (options_.cache_ttl.is_positive()) {
+    cache_.Put(std::move(key),
+               CacheEntry{result, base::TimeTicks::Now() + options_.cache_ttl});
+  }
+  std::move(callback).Run(result, default_result);
 }
 
 }  // namespace electron
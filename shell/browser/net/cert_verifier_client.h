@@ -5,8 +5,15 @@
 #ifndef ELECTRON_SHELL_BROWSER_NET_CERT_VERIFIER_CLIENT_H_
 #define ELECTRON_SHELL_BROWSER_NET_CERT_VERIFIER_CLIENT_H_
 
+#include <optional>
 #include <string>
+#include <tuple>
+#include <vector>
 
+#include "base/containers/lru_cache.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "net/base/hash_value.h"
 #include "net/cert/x509_certificate.h"
 #include "services/network/public/mojom/network_context.mojom.h"
 
@@ -31,7 +38,44 @@ class CertVerifierClient : public network::mojom::CertVerifierClient {
       base::RepeatingCallback<void(const VerifyRequestParams& request,
                                    base::OnceCallback<void(int)>)>;
 
-  explicit CertVerifierClient(CertVerifyProc proc);
+  // The public keys one of which must be in the verified chain of a host.
+  struct PublicKeyPin {
+    PublicKeyPin();
+    PublicKeyPin(const PublicKeyPin&);
+    ~PublicKeyPin();
+
+    std::string hostname;
+    bool include_subdomains = false;
+    net::HashValueVector hashes;
+  };
+
+  // A certificate of a host which is accepted when the only error in its
+  // chain is an unknown authority, like a self-signed certificate.
+  struct TrustedCertificate {
+    TrustedCertificate();
+    TrustedCertificate(const TrustedCertificate&);
+    ~TrustedCertificate();
+
+    std::string hostname;
+    bool include_subdomains = false;
+    // The SHA-256 fingerprint of the certificate of the server.
+    net::HashValue fingerprint;
+  };
+
+  // Policies applied before running |proc|, and the caching of its
+  // decisions.
+  struct Options {
+    Options();
+    Options(const Options&);
+    ~Options();
+
+    base::TimeDelta cache_ttl;
+    std::vector<PublicKeyPin> pins;
+    std::vector<TrustedCertificate> trusted_certificates;
+  };
+
+  // |proc| can be null to only apply the policies of |options|.
+  CertVerifierClient(CertVerifyProc proc, const Options& options);
   ~CertVerifierClient() override;
 
   // network::mojom::CertVerifierClient
@@ -44,7 +88,32 @@ class CertVerifierClient : public network::mojom::CertVerifierClient {
               VerifyCallback callback) override;
 
  private:
+  // (hostname, chain fingerprint, error from Chromium's verifier).
+  using CacheKey = std::tuple<std::string, net::SHA256HashValue, int>;
+  struct CacheEntry {
+    int result;
+    base::TimeTicks expiry;
+  };
+
+  // Returns |default_error| narrowed down by the policies.
+  int ApplyPolicies(
+      int default_error,
+      const net::CertVerifyResult& default_result,
+      const net::X509Certificate& certificate,
+      const std::string& hostname) const;
+
+  void OnProcResult(CacheKey key,
+                    VerifyCallback callback,
+                    int default_error,
+                    int policy_error,
+                    const net::CertVerifyResult& default_result,
+                    int result);
+
   CertVerifyProc cert_verify_proc_;
+  const Options options_;
+  base::LRUCache<CacheKey, CacheEntry> cache_;
+
+  base::WeakPtrFactory<CertVerifierClient> weak_factory_{this};
 };
 
 }  // namespace electron
@@ -6,16 +6,20 @@
 
 #include <list>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
 
+#include "base/containers/contains.h"
 #include "base/containers/fixed_flat_map.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/stringprintf.h"
+#include "base/timer/elapsed_timer.h"
 #include "base/uuid.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/storage_partition.h"
+#include "crypto/sha2.h"
 #include "mojo/public/cpp/system/data_pipe_producer.h"
 #include "mojo/public/cpp/system/string_data_source.h"
 #include "net/base/filename_util.h"
@@ -24,16 +28,19 @@
 #include "net/url_request/redirect_util.h"
 #include "services/network/public/cpp/url_loader_completion_status.h"
 #include "services/network/public/mojom/url_loader_factory.mojom.h"
+#include "shell/browser/api/electron_api_protocol.h"
 #include "shell/browser/api/electron_api_session.h"
 #include "shell/browser/electron_browser_context.h"
 #include "shell/browser/net/asar/asar_url_loader.h"
 #include "shell/browser/net/node_stream_loader.h"
 #include "shell/browser/net/url_pipe_loader.h"
 #include "shell/common/electron_constants.h"
+#include "shell/common/electron_histograms.h"
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_converters/net_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
+#include "shell/common/process_util.h"
 #include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
 
 #include "shell/common/node_includes.h"
@@ -102,6 +109,28 @@ gin::Dictionary ToDict(v8::Isolate* isolate, v8::Local<v8::Value> value) {
     return gin::Dictionary(isolate);
 }
 
+// Responses made by protocol handlers have no response time, while the V8 code
+// cache of a script is only used while the response time of the script stays
+// the same. So for the schemes with a code cache one is derived from the
+// validators of the response: the ETag maps to a time that is the same for the
+// same tag, and otherwise the Last-Modified time is used as is.
+void SetResponseTimeFromValidators(network::mojom::URLResponseHead* head) {
+  std::string etag;
+  if (head->headers->GetNormalizedHeader("etag", &etag) && !etag.empty()) {
+    uint64_t hash;
+    crypto::SHA256HashString(etag, &hash, sizeof(hash));
+    // Keep the time within about 140 years of the epoch.
+    head->response_time =
+        base::Time::UnixEpoch() +
+        base::Microseconds(static_cast<int64_t>(hash & ((1ULL << 52) - 1)));
+    return;
+  }
+  if (std::optional<base::Time> last_modified =
+          head->headers->GetLastModifiedValue()) {
+    head->response_time = *last_modified;
+  }
+}
+
 // Parse headers from response object.
 network::mojom::URLResponseHeadPtr ToResponseHead(
     const gin_helper::Dictionary& dict) {
@@ -164,7 +193,10 @@ network::mojom::URLResponseHeadPtr ToResponseHead(
 // Helper to write string to pipe.
 struct WriteData {
   mojo::Remote<network::mojom::URLLoaderClient> client;
-  std::string data;
+  // The body being written, owned by either |string| or |backing_store|.
+  std::string_view data;
+  std::string string;
+  std::shared_ptr<v8::BackingStore> backing_store;
   std::unique_ptr<mojo::DataPipeProducer> producer;
 };
 
@@ -179,6 +211,49 @@ void OnWrite(std::unique_ptr<WriteData> write_data, MojoResult result) {
   write_data->client->OnComplete(status);
 }
 
+// Sends |write_data->data| as the body of the response.
+void SendWriteData(mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+                   network::mojom::URLResponseHeadPtr head,
+                   std::unique_ptr<WriteData> write_data) {
+  mojo::Remote<network::mojom::URLLoaderClient> client_remote(
+      std::move(client));
+
+  // Add header to ignore CORS.
+  head->headers->AddHeader("Access-Control-Allow-Origin", "*");
+
+  // Code below follows the pattern of data_url_loader_factory.cc.
+  mojo::ScopedDataPipeProducerHandle producer;
+  mojo::ScopedDataPipeConsumerHandle consumer;
+  if (mojo::CreateDataPipe(nullptr, producer, consumer) != MOJO_RESULT_OK) {
+    client_remote->OnComplete(
+        network::URLLoaderCompletionStatus(net::ERR_INSUFFICIENT_RESOURCES));
+    return;
+  }
+
+  client_remote->OnReceiveResponse(std::move(head), std::move(consumer),
+                                   std::nullopt);
+
+  write_data->client = std::move(client_remote);
+  write_data->producer =
+      std::make_unique<mojo::DataPipeProducer>(std::move(producer));
+  auto* producer_ptr = write_data->producer.get();
+
+  const std::string_view data = write_data->data;
+  producer_ptr->Write(
+      std::make_unique<mojo::StringDataSource>(
+          data, mojo::StringDataSource::AsyncWritingMode::
+                    STRING_STAYS_VALID_UNTIL_COMPLETION),
+      base::BindOnce(OnWrite, std::move(write_data)));
+}
+
+// Records how long the protocol handler took before passing on its response.
+void OnHandlerResponded(base::ElapsedTimer timer,
+                        StartLoadingCallback start_loading,
+                        gin::Arguments* args) {
+  histograms::RecordProtocolHandlerTime(timer.Elapsed());
+  std::move(start_loading).Run(args);
+}
+
 }  // namespace
 
 ElectronURLLoaderFactory::RedirectedRequest::RedirectedRequest(
@@ -272,6 +347,14 @@ ElectronURLLoaderFactory::Create(ProtocolType type,
   return pending_remote;
 }
 
+// static
+void ElectronURLLoaderFactory::Create(
+    ProtocolType type,
+    const ProtocolHandler& handler,
+    mojo::PendingReceiver<network::mojom::URLLoaderFactory> factory_receiver) {
+  new ElectronURLLoaderFactory(type, handler, std::move(factory_receiver));
+}
+
 ElectronURLLoaderFactory::ElectronURLLoaderFactory(
     ProtocolType type,
     const ProtocolHandler& handler,
@@ -289,7 +372,9 @@ void ElectronURLLoaderFactory::CreateLoaderAndStart(
     const network::ResourceRequest& request,
     mojo::PendingRemote<network::mojom::URLLoaderClient> client,
     const net::MutableNetworkTrafficAnnotationTag& traffic_annotation) {
-  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  // Factories bound by UtilityProtocolRegistry run on the main thread of a
+  // utility process, where there are no browser threads.
+  DCHECK(!IsBrowserProcess() || BrowserThread::CurrentlyOn(BrowserThread::UI));
 
   // |StartLoading| is used for both intercepted and registered protocols,
   // and on redirects it needs a factory to use to create a loader for the
@@ -299,9 +384,12 @@ void ElectronURLLoaderFactory::CreateLoaderAndStart(
 
   handler_.Run(
       request,
-      base::BindOnce(&ElectronURLLoaderFactory::StartLoading, std::move(loader),
-                     request_id, options, request, std::move(client),
-                     traffic_annotation, std::move(target_factory), type_));
+      base::BindOnce(
+          &OnHandlerResponded, base::ElapsedTimer(),
+          base::BindOnce(&ElectronURLLoaderFactory::StartLoading,
+                         std::move(loader), request_id, options, request,
+                         std::move(client), traffic_annotation,
+                         std::move(target_factory), type_)));
 }
 
 // static
@@ -350,6 +438,10 @@ void ElectronURLLoaderFactory::StartLoading(
   }
 
   network::mojom::URLResponseHeadPtr head = ToResponseHead(dict);
+  // Other responses keep their lack of a response time rather than carrying
+  // one made up from their headers.
+  if (base::Contains(api::GetCodeCacheSchemes(), request.url.scheme()))
+    SetResponseTimeFromValidators(head.get());
 
   // Handle redirection.
   //
@@ -497,9 +589,15 @@ void ElectronURLLoaderFactory::StartLoadingBuffer(
     mojo::PendingRemote<network::mojom::URLLoaderClient> client,
     network::mojom::URLResponseHeadPtr head,
     v8::Local<v8::ArrayBufferView> buffer) {
-  SendContents(std::move(client), std::move(head),
-               std::string(node::Buffer::Data(buffer.As<v8::Value>()),
-                           node::Buffer::Length(buffer.As<v8::Value>())));
+  // The body is written straight out of the buffer's memory, which is kept
+  // alive by pinning its backing store until the write completes.
+  auto write_data = std::make_unique<WriteData>();
+  write_data->backing_store = buffer->Buffer()->GetBackingStore();
+  write_data->data = std::string_view(
+      static_cast<const char*>(write_data->backing_store->Data()) +
+          buffer->ByteOffset(),
+      buffer->ByteLength());
+  SendWriteData(std::move(client), std::move(head), std::move(write_data));
 }
 
 // static
@@ -625,37 +723,10 @@ void ElectronURLLoaderFactory::SendContents(
     mojo::PendingRemote<network::mojom::URLLoaderClient> client,
     network::mojom::URLResponseHeadPtr head,
     std::string data) {
-  mojo::Remote<network::mojom::URLLoaderClient> client_remote(
-      std::move(client));
-
-  // Add header to ignore CORS.
-  head->headers->AddHeader("Access-Control-Allow-Origin", "*");
-
-  // Code below follows the pattern of data_url_loader_factory.cc.
-  mojo::ScopedDataPipeProducerHandle producer;
-  mojo::ScopedDataPipeConsumerHandle consumer;
-  if (mojo::CreateDataPipe(nullptr, producer, consumer) != MOJO_RESULT_OK) {
-    client_remote->OnComplete(
-        network::URLLoaderCompletionStatus(net::ERR_INSUFFICIENT_RESOURCES));
-    return;
-  }
-
-  client_remote->OnReceiveResponse(std::move(head), std::move(consumer),
-                                   std::nullopt);
-
   auto write_data = std::make_unique<WriteData>();
-  write_data->client = std::move(client_remote);
-  write_data->data = std::move(data);
-  write_data->producer =
-      std::make_unique<mojo::DataPipeProducer>(std::move(producer));
-  auto* producer_ptr = write_data->producer.get();
-
-  base::StringPiece string_piece(write_data->data);
-  producer_ptr->Write(
-      std::make_unique<mojo::StringDataSource>(
-          string_piece, mojo::StringDataSource::AsyncWritingMode::
-                            STRING_STAYS_VALID_UNTIL_COMPLETION),
-      base::BindOnce(OnWrite, std::move(write_data)));
+  write_data->string = std::move(data);
+  write_data->data = write_data->string;
+  SendWriteData(std::move(client), std::move(head), std::move(write_data));
 }
 
 }  // namespace electron
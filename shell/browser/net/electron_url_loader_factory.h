@@ -98,6 +98,12 @@ class ElectronURLLoaderFactory : public network::SelfDeletingURLLoaderFactory {
   static mojo::PendingRemote<network::mojom::URLLoaderFactory> Create(
       ProtocolType type,
       const ProtocolHandler& handler);
+  // Serves |factory_receiver| with |handler|, for factories whose remote end
+  // was created by another process.
+  static void Create(
+      ProtocolType type,
+      const ProtocolHandler& handler,
+      mojo::PendingReceiver<network::mojom::URLLoaderFactory> factory_receiver);
 
   // network::mojom::URLLoaderFactory:
   void CreateLoaderAndStart(
@@ -73,16 +73,14 @@ void NetworkContextService::ConfigureNetworkContextParams(
   // Enable the HTTP cache.
   network_context_params->http_cache_enabled =
       browser_context_->can_use_http_cache();
+  network_context_params->http_cache_max_size =
+      browser_context_->max_cache_size();
 
   network_context_params->cookie_manager_params =
       network::mojom::CookieManagerParams::New();
 
   // Configure on-disk storage for persistent sessions.
   if (!in_memory) {
-    // Configure the HTTP cache path and size.
-    network_context_params->http_cache_max_size =
-        browser_context_->max_cache_size();
-
     network_context_params->file_paths =
         network::mojom::NetworkContextFilePaths::New();
     network_context_params->file_paths->data_directory =
@@ -90,8 +88,11 @@ void NetworkContextService::ConfigureNetworkContextParams(
     network_context_params->file_paths->unsandboxed_data_path = path;
     network_context_params->file_paths->trigger_migration =
         ShouldTriggerNetworkDataMigration();
-    network_context_params->file_paths->http_cache_directory =
-        path.Append(chrome::kCacheDirname);
+    // Without a directory the network service keeps the cache in memory.
+    if (!browser_context_->use_memory_cache()) {
+      network_context_params->file_paths->http_cache_directory =
+          path.Append(chrome::kCacheDirname);
+    }
 
     // Currently this just contains HttpServerProperties
     network_context_params->file_paths->http_server_properties_file_name =
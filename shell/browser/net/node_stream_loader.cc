@@ -4,15 +4,84 @@
 
 #include "shell/browser/net/node_stream_loader.h"
 
+#include <algorithm>
 #include <string_view>
 #include <utility>
 
-#include "mojo/public/cpp/system/string_data_source.h"
 #include "shell/common/gin_converters/callback_converter.h"
+#include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/node_includes.h"
 
 namespace electron {
 
+namespace {
+
+// Bounds of how much data is sent to the pipe in one write.
+constexpr size_t kMinBytesPerWrite = 256 * 1024;
+constexpr size_t kMaxBytesPerWrite = 8 * 1024 * 1024;
+
+// Writes the buffers that were read from the stream since the last write.
+class ChunksDataSource : public mojo::DataPipeProducer::DataSource {
+ public:
+  ChunksDataSource(std::vector<NodeStreamLoader::Chunk> chunks, size_t length)
+      : chunks_(std::move(chunks)), length_(length) {}
+  ~ChunksDataSource() override = default;
+
+  // disable copy
+  ChunksDataSource(const ChunksDataSource&) = delete;
+  ChunksDataSource& operator=(const ChunksDataSource&) = delete;
+
+  // mojo::DataPipeProducer::DataSource:
+  uint64_t GetLength() const override { return length_; }
+
+  ReadResult Read(uint64_t offset, base::span<char> buffer) override {
+    ReadResult result;
+    if (offset > length_) {
+      result.result = MOJO_RESULT_OUT_OF_RANGE;
+      return result;
+    }
+    // Reads are sequential, so resume from the chunk the last one ended in.
+    if (offset < chunk_start_) {
+      chunk_index_ = 0;
+      chunk_start_ = 0;
+    }
+    while (chunk_index_ < chunks_.size() &&
+           offset >= chunk_start_ + chunks_[chunk_index_].data.size()) {
+      chunk_start_ += chunks_[chunk_index_].data.size();
+      ++chunk_index_;
+    }
+    size_t index = chunk_index_;
+    size_t position = offset - chunk_start_;
+    while (result.bytes_read < buffer.size() && index < chunks_.size()) {
+      std::string_view data = chunks_[index].data.substr(position);
+      size_t size = std::min(data.size(), buffer.size() - result.bytes_read);
+      std::copy_n(data.begin(), size, buffer.begin() + result.bytes_read);
+      result.bytes_read += size;
+      position = 0;
+      ++index;
+    }
+    return result;
+  }
+
+ private:
+  std::vector<NodeStreamLoader::Chunk> chunks_;
+  const size_t length_;
+  size_t chunk_index_ = 0;
+  size_t chunk_start_ = 0;
+};
+
+}  // namespace
+
+NodeStreamLoader::Chunk::Chunk(std::shared_ptr<v8::BackingStore> backing_store,
+                               std::string_view data)
+    : backing_store(std::move(backing_store)), data(data) {}
+
+NodeStreamLoader::Chunk::Chunk(Chunk&&) = default;
+
+NodeStreamLoader::Chunk& NodeStreamLoader::Chunk::operator=(Chunk&&) = default;
+
+NodeStreamLoader::Chunk::~Chunk() = default;
+
 NodeStreamLoader::NodeStreamLoader(
     network::mojom::URLResponseHeadPtr head,
     mojo::PendingReceiver<network::mojom::URLLoader> loader,
@@ -50,11 +119,27 @@ NodeStreamLoader::~NodeStreamLoader() {
 }
 
 void NodeStreamLoader::Start(network::mojom::URLResponseHeadPtr head) {
+  v8::HandleScope scope(isolate_);
+
+  // Streams that buffer more data ahead are written in larger pieces.
+  uint32_t high_water_mark = 0;
+  gin_helper::Dictionary(isolate_, emitter_.Get(isolate_))
+      .Get("readableHighWaterMark", &high_water_mark);
+  bytes_per_write_ = std::clamp<size_t>(high_water_mark, kMinBytesPerWrite,
+                                        kMaxBytesPerWrite);
+
+  // Leave room for the next write while the previous one is being drained.
+  MojoCreateDataPipeOptions options;
+  options.struct_size = sizeof(MojoCreateDataPipeOptions);
+  options.flags = MOJO_CREATE_DATA_PIPE_FLAG_NONE;
+  options.element_num_bytes = 1;
+  options.capacity_num_bytes = 2 * bytes_per_write_;
+
   mojo::ScopedDataPipeProducerHandle producer;
   mojo::ScopedDataPipeConsumerHandle consumer;
-  MojoResult rv = mojo::CreateDataPipe(nullptr, producer, consumer);
+  MojoResult rv = mojo::CreateDataPipe(&options, producer, consumer);
   if (rv != MOJO_RESULT_OK) {
-    NotifyComplete(net::ERR_INSUFFICIENT_RESOURCES);
+    Complete(net::ERR_INSUFFICIENT_RESOURCES);
     return;
   }
 
@@ -71,26 +156,25 @@ void NodeStreamLoader::Start(network::mojom::URLResponseHeadPtr head) {
 }
 
 void NodeStreamLoader::NotifyReadable() {
-  if (!readable_)
-    ReadMore();
-  else if (is_reading_)
-    has_read_waiting_ = true;
   readable_ = true;
+  if (is_reading_)
+    has_read_waiting_ = true;
+  else
+    ReadMore();
 }
 
 void NodeStreamLoader::NotifyComplete(int result) {
-  // Wait until write finishes or fails.
-  if (is_reading_ || is_writing_) {
+  // Wait until write finishes or fails, and until the data that was read has
+  // been written when the stream ended normally.
+  if (is_reading_ || is_writing_ ||
+      (result == net::OK && !pending_chunks_.empty())) {
     ended_ = true;
     result_ = result;
+    MaybeWriteOrComplete();
     return;
   }
 
-  network::URLLoaderCompletionStatus status(result);
-  status.completion_time = base::TimeTicks::Now();
-  status.decoded_body_length = bytes_written_;
-  client_->OnComplete(status);
-  delete this;
+  Complete(result);
 }
 
 void NodeStreamLoader::ReadMore() {
@@ -100,61 +184,88 @@ void NodeStreamLoader::ReadMore() {
     // a nested read, so short-circuit.
     return;
   }
-  is_reading_ = true;
   auto weak = weak_factory_.GetWeakPtr();
   v8::HandleScope scope(isolate_);
-  // buffer = emitter.read()
-  v8::MaybeLocal<v8::Value> ret = node::MakeCallback(
-      isolate_, emitter_.Get(isolate_), "read", 0, nullptr, {0, 0});
-  DCHECK(weak) << "We shouldn't have been destroyed when calling read()";
-
-  // If there is no buffer read, wait until |readable| is emitted again.
-  v8::Local<v8::Value> buffer;
-  if (!ret.ToLocal(&buffer) || !node::Buffer::HasInstance(buffer)) {
+  // Keep reading while a write is in flight, until there is enough for the
+  // next one.
+  while (!ended_ && pending_bytes_ < bytes_per_write_) {
+    is_reading_ = true;
+    // buffer = emitter.read()
+    v8::MaybeLocal<v8::Value> ret = node::MakeCallback(
+        isolate_, emitter_.Get(isolate_), "read", 0, nullptr, {0, 0});
+    DCHECK(weak) << "We shouldn't have been destroyed when calling read()";
     is_reading_ = false;
 
-    // If 'readable' was called after 'read()', try again
-    if (has_read_waiting_) {
-      has_read_waiting_ = false;
-      ReadMore();
-      return;
+    // If there is no buffer read, wait until |readable| is emitted again.
+    v8::Local<v8::Value> buffer;
+    if (!ret.ToLocal(&buffer) || !node::Buffer::HasInstance(buffer)) {
+      // If 'readable' was called after 'read()', try again
+      if (has_read_waiting_) {
+        has_read_waiting_ = false;
+        continue;
+      }
+      readable_ = false;
+      break;
     }
 
-    readable_ = false;
-    if (ended_) {
-      NotifyComplete(result_);
-    }
+    // Pin the memory of the buffer until the write is done.
+    auto view = buffer.As<v8::ArrayBufferView>();
+    std::shared_ptr<v8::BackingStore> backing_store =
+        view->Buffer()->GetBackingStore();
+    std::string_view data{
+        static_cast<const char*>(backing_store->Data()) + view->ByteOffset(),
+        view->ByteLength()};
+    pending_bytes_ += data.size();
+    pending_chunks_.emplace_back(std::move(backing_store), data);
+  }
+
+  MaybeWriteOrComplete();
+}
+
+void NodeStreamLoader::MaybeWriteOrComplete() {
+  if (is_reading_ || is_writing_)
+    return;
+
+  // The data that was read is still sent when the stream ends, but not when it
+  // fails.
+  if (ended_ && (result_ != net::OK || pending_chunks_.empty())) {
+    Complete(result_);
     return;
   }
 
-  // Hold the buffer until the write is done.
-  buffer_.Reset(isolate_, buffer);
+  if (pending_chunks_.empty())
+    return;
 
-  bytes_written_ += node::Buffer::Length(buffer);
+  bytes_written_ += pending_bytes_;
 
-  // Write buffer to mojo pipe asynchronously.
-  is_reading_ = false;
+  // Write buffers to mojo pipe asynchronously.
   is_writing_ = true;
-  producer_->Write(std::make_unique<mojo::StringDataSource>(
-                       std::string_view{node::Buffer::Data(buffer),
-                                        node::Buffer::Length(buffer)},
-                       mojo::StringDataSource::AsyncWritingMode::
-                           STRING_STAYS_VALID_UNTIL_COMPLETION),
-                   base::BindOnce(&NodeStreamLoader::DidWrite, weak));
+  producer_->Write(std::make_unique<ChunksDataSource>(
+                       std::exchange(pending_chunks_, {}),
+                       std::exchange(pending_bytes_, 0)),
+                   base::BindOnce(&NodeStreamLoader::DidWrite,
+                                  weak_factory_.GetWeakPtr()));
 }
 
 void NodeStreamLoader::DidWrite(MojoResult result) {
   is_writing_ = false;
-  // We were told to end streaming.
-  if (ended_) {
-    NotifyComplete(result_);
+  if (result != MOJO_RESULT_OK) {
+    Complete(net::ERR_FAILED);
     return;
   }
 
-  if (result == MOJO_RESULT_OK && readable_)
+  if (readable_)
     ReadMore();
   else
-    NotifyComplete(net::ERR_FAILED);
+    MaybeWriteOrComplete();
+}
+
+void NodeStreamLoader::Complete(int result) {
+  network::URLLoaderCompletionStatus status(result);
+  status.completion_time = base::TimeTicks::Now();
+  status.decoded_body_length = bytes_written_;
+  client_->OnComplete(status);
+  delete this;
 }
 
 void NodeStreamLoader::On(const char* event, EventCallback callback) {
@@ -8,6 +8,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "base/memory/raw_ptr.h"
@@ -29,6 +30,10 @@ namespace electron {
 // We use |paused mode| to read data from |Readable| stream, so we don't need to
 // copy data from buffer and hold it in memory, and we only need to make sure
 // the passed |Buffer| is alive while writing data to pipe.
+//
+// The stream keeps being read while a write is in flight, and the buffers read
+// meanwhile are sent together in the next write, so that the pipe stays full
+// without a round-trip to JS for every chunk.
 class NodeStreamLoader : public network::mojom::URLLoader {
  public:
   NodeStreamLoader(network::mojom::URLResponseHeadPtr head,
@@ -41,6 +46,19 @@ class NodeStreamLoader : public network::mojom::URLLoader {
   NodeStreamLoader(const NodeStreamLoader&) = delete;
   NodeStreamLoader& operator=(const NodeStreamLoader&) = delete;
 
+  // A Buffer read from the stream. Its backing store is pinned until the data
+  // has been written to the pipe.
+  struct Chunk {
+    Chunk(std::shared_ptr<v8::BackingStore> backing_store,
+          std::string_view data);
+    Chunk(Chunk&&);
+    Chunk& operator=(Chunk&&);
+    ~Chunk();
+
+    std::shared_ptr<v8::BackingStore> backing_store;
+    std::string_view data;
+  };
+
  private:
   ~NodeStreamLoader() override;
 
@@ -50,7 +68,9 @@ class NodeStreamLoader : public network::mojom::URLLoader {
   void NotifyReadable();
   void NotifyComplete(int result);
   void ReadMore();
+  void MaybeWriteOrComplete();
   void DidWrite(MojoResult result);
+  void Complete(int result);
 
   // Subscribe to events of |emitter|.
   void On(const char* event, EventCallback callback);
@@ -71,11 +91,18 @@ class NodeStreamLoader : public network::mojom::URLLoader {
 
   raw_ptr<v8::Isolate> isolate_;
   v8::Global<v8::Object> emitter_;
-  v8::Global<v8::Value> buffer_;
 
   // Mojo data pipe where the data that is being read is written to.
   std::unique_ptr<mojo::DataPipeProducer> producer_;
 
+  // Buffers read from the stream that will be sent in the next write.
+  std::vector<Chunk> pending_chunks_;
+  size_t pending_bytes_ = 0;
+
+  // How much data is read ahead into |pending_chunks_| for one write, based
+  // on the stream's highWaterMark. The pipe holds two writes.
+  size_t bytes_per_write_ = 0;
+
   // Whether we are in the middle of write.
   bool is_writing_ = false;
 
@@ -84,8 +111,9 @@ class NodeStreamLoader : public network::mojom::URLLoader {
 
   size_t bytes_written_ = 0;
 
-  // When NotifyComplete is called while writing, we will save the result and
-  // quit with it after the write is done.
+  // When NotifyComplete is called while reading or writing, we will save the
+  // result and quit with it once the data that was read has been written, or
+  // once the write in flight is done if the stream failed.
   bool ended_ = false;
   int result_ = net::OK;
 
@@ -835,7 +835,13 @@ void ProxyingURLLoaderFactory::CreateLoaderAndStart(
     return;
   }
 
-  if (!web_request_api()->HasListener()) {
+  // Requests of a type that no filter can match are not worth the extra hops
+  // through InProgressRequest. Only the type is checked, since a redirect can
+  // take a request to a URL that a filter matches, but never changes its type.
+  if (!web_request_api()->HasListener() ||
+      !web_request_api()->MayHaveListenerForType(
+          extensions::ToWebRequestResourceType(request,
+                                               /*is_download=*/false))) {
     // Pass-through to the original factory.
     target_factory_->CreateLoaderAndStart(std::move(loader), request_id,
                                           options, request, std::move(client),
@@ -0,0 +1,113 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/resolve_host_batch.h"
+
+#include <utility>
+
+#include "base/functional/bind.h"
+#include "content/public/browser/storage_partition.h"
+#include "net/base/host_port_pair.h"
+#include "net/base/net_errors.h"
+#include "net/base/network_anonymization_key.h"
+#include "net/dns/public/resolve_error_info.h"
+#include "services/network/public/mojom/network_context.mojom.h"
+#include "shell/browser/electron_browser_context.h"
+
+namespace electron {
+
+ResolveHostBatch::Result::Result() = default;
+ResolveHostBatch::Result::Result(const Result&) = default;
+ResolveHostBatch::Result::~Result() = default;
+
+// static
+void ResolveHostBatch::Start(ElectronBrowserContext* browser_context,
+                             std::vector<std::string> hosts,
+                             network::mojom::ResolveHostParametersPtr params,
+                             size_t max_concurrency,
+                             Callback callback) {
+  DCHECK_GT(max_concurrency, 0u);
+  if (hosts.empty()) {
+    std::move(callback).Run({});
+    return;
+  }
+  auto* batch = new ResolveHostBatch(browser_context, std::move(hosts),
+                                     std::move(params), std::move(callback));
+  for (size_t i = 0; i < max_concurrency; ++i)
+    batch->ResolveNext();
+}
+
+ResolveHostBatch::ResolveHostBatch(
+    ElectronBrowserContext* browser_context,
+    std::vector<std::string> hosts,
+    network::mojom::ResolveHostParametersPtr params,
+    Callback callback)
+    : params_(std::move(params)),
+      callback_(std::move(callback)),
+      results_(hosts.size()),
+      start_times_(hosts.size()) {
+  for (size_t i = 0; i < hosts.size(); ++i)
+    results_[i].host = std::move(hosts[i]);
+  // Without config overrides the resolver shares the host cache of the
+  // network context.
+  browser_context->GetDefaultStoragePartition()
+      ->GetNetworkContext()
+      ->CreateHostResolver(std::nullopt,
+                           resolver_.BindNewPipeAndPassReceiver());
+  // The network service closes the pipes of the pending requests when the
+  // resolver goes away, so every host still gets a result.
+  receivers_.set_disconnect_handler(base::BindRepeating(
+      &ResolveHostBatch::OnClientDisconnected, base::Unretained(this)));
+}
+
+ResolveHostBatch::~ResolveHostBatch() = default;
+
+void ResolveHostBatch::ResolveNext() {
+  if (next_index_ == results_.size())
+    return;
+  size_t index = next_index_++;
+  mojo::PendingRemote<network::mojom::ResolveHostClient> client;
+  receivers_.Add(this, client.InitWithNewPipeAndPassReceiver(), index);
+  start_times_[index] = base::TimeTicks::Now();
+  resolver_->ResolveHost(network::mojom::HostResolverHost::NewHostPortPair(
+                             net::HostPortPair(results_[index].host, 0)),
+                         net::NetworkAnonymizationKey(),
+                         params_ ? params_.Clone() : nullptr,
+                         std::move(client));
+}
+
+void ResolveHostBatch::OnComplete(
+    int result,
+    const net::ResolveErrorInfo& resolve_error_info,
+    const std::optional<net::AddressList>& resolved_addresses,
+    const std::optional<net::HostResolverEndpointResults>&
+        endpoint_results_with_metadata) {
+  size_t index = receivers_.current_context();
+  receivers_.Remove(receivers_.current_receiver());
+  OnResult(index, resolve_error_info.error, resolved_addresses);
+}
+
+void ResolveHostBatch::OnClientDisconnected() {
+  OnResult(receivers_.current_context(), net::ERR_NAME_NOT_RESOLVED,
+           std::nullopt);
+}
+
+void ResolveHostBatch::OnResult(
+    size_t index,
+    int error,
+    const std::optional<net::AddressList>& addresses) {
+  Result& result = results_[index];
+  result.error = error;
+  result.addresses = addresses;
+  result.duration = base::TimeTicks::Now() - start_times_[index];
+
+  if (++completed_ < results_.size()) {
+    ResolveNext();
+    return;
+  }
+  std::move(callback_).Run(std::move(results_));
+  delete this;
+}
+
+}  // namespace electron
@@ -0,0 +1,92 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_NET_RESOLVE_HOST_BATCH_H_
+#define ELECTRON_SHELL_BROWSER_NET_RESOLVE_HOST_BATCH_H_
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "base/functional/callback.h"
+#include "base/time/time.h"
+#include "mojo/public/cpp/bindings/receiver_set.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "net/base/address_list.h"
+#include "net/dns/public/host_resolver_results.h"
+#include "services/network/public/cpp/resolve_host_client_base.h"
+#include "services/network/public/mojom/host_resolver.mojom.h"
+
+namespace electron {
+
+class ElectronBrowserContext;
+
+// Resolves a list of hosts through a single HostResolver of the network
+// context of a session, with at most |max_concurrency| requests in flight.
+// One client receives the replies of every request, told apart by the index
+// of their host.
+class ResolveHostBatch : public network::ResolveHostClientBase {
+ public:
+  struct Result {
+    Result();
+    Result(const Result&);
+    ~Result();
+
+    std::string host;
+    int error = 0;
+    std::optional<net::AddressList> addresses;
+    // The time from sending the request to receiving its reply.
+    base::TimeDelta duration;
+  };
+
+  // The results are in the order of the hosts.
+  using Callback = base::OnceCallback<void(std::vector<Result>)>;
+
+  // Deletes itself once every host has been resolved.
+  static void Start(ElectronBrowserContext* browser_context,
+                    std::vector<std::string> hosts,
+                    network::mojom::ResolveHostParametersPtr params,
+                    size_t max_concurrency,
+                    Callback callback);
+
+  // disable copy
+  ResolveHostBatch(const ResolveHostBatch&) = delete;
+  ResolveHostBatch& operator=(const ResolveHostBatch&) = delete;
+
+ private:
+  ResolveHostBatch(ElectronBrowserContext* browser_context,
+                   std::vector<std::string> hosts,
+                   network::mojom::ResolveHostParametersPtr params,
+                   Callback callback);
+  ~ResolveHostBatch() override;
+
+  void ResolveNext();
+
+  // network::mojom::ResolveHostClient implementation
+  void OnComplete(int result,
+                  const net::ResolveErrorInfo& resolve_error_info,
+                  const std::optional<net::AddressList>& resolved_addresses,
+                  const std::optional<net::HostResolverEndpointResults>&
+                      endpoint_results_with_metadata) override;
+
+  void OnClientDisconnected();
+  void OnResult(size_t index,
+                int error,
+                const std::optional<net::AddressList>& addresses);
+
+  mojo::Remote<network::mojom::HostResolver> resolver_;
+  // The context of each receiver is the index of its host.
+  mojo::ReceiverSet<network::mojom::ResolveHostClient, size_t> receivers_;
+  network::mojom::ResolveHostParametersPtr params_;
+  Callback callback_;
+
+  std::vector<Result> results_;
+  std::vector<base::TimeTicks> start_times_;
+  size_t next_index_ = 0;
+  size_t completed_ = 0;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_NET_RESOLVE_HOST_BATCH_H_
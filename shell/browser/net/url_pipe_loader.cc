@@ -6,10 +6,13 @@
 
 #include <utility>
 
-#include "base/task/sequenced_task_runner.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
-#include "mojo/public/cpp/system/string_data_source.h"
+#include "net/base/net_errors.h"
+#include "net/http/http_request_headers.h"
+#include "net/http/http_response_headers.h"
+#include "services/network/public/cpp/resource_request_body.h"
 #include "services/network/public/cpp/shared_url_loader_factory.h"
+#include "services/network/public/cpp/url_loader_completion_status.h"
 #include "services/network/public/mojom/url_response_head.mojom.h"
 
 namespace electron {
@@ -25,11 +28,9 @@ URLPipeLoader::URLPipeLoader(
   url_loader_.set_disconnect_handler(base::BindOnce(
       &URLPipeLoader::NotifyComplete, base::Unretained(this), net::ERR_FAILED));
 
-  // PostTask since it might destruct.
-  base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
-      FROM_HERE,
-      base::BindOnce(&URLPipeLoader::Start, weak_factory_.GetWeakPtr(), factory,
-                     std::move(request), annotation, std::move(upload_data)));
+  // Starting the request can not destruct this synchronously, every failure is
+  // reported through the mojo pipes.
+  Start(factory, std::move(request), annotation, std::move(upload_data));
 }
 
 URLPipeLoader::~URLPipeLoader() = default;
@@ -39,18 +40,24 @@ void URLPipeLoader::Start(
     std::unique_ptr<network::ResourceRequest> request,
     const net::NetworkTrafficAnnotationTag& annotation,
     base::Value::Dict upload_data) {
-  loader_ = network::SimpleURLLoader::Create(std::move(request), annotation);
-  loader_->SetOnResponseStartedCallback(base::BindOnce(
-      &URLPipeLoader::OnResponseStarted, weak_factory_.GetWeakPtr()));
-
   // TODO(zcbenz): The old protocol API only supports string as upload data,
   // we should seek to support more types in future.
   std::string* content_type = upload_data.FindString("contentType");
   std::string* data = upload_data.FindString("data");
-  if (content_type && data)
-    loader_->AttachStringForUpload(*data, *content_type);
+  if (content_type && data) {
+    request->request_body = network::ResourceRequestBody::CreateFromBytes(
+        data->data(), data->size());
+    request->headers.SetHeader(net::HttpRequestHeaders::kContentType,
+                               *content_type);
+  }
 
-  loader_->DownloadAsStream(factory.get(), this);
+  factory->CreateLoaderAndStart(
+      loader_.BindNewPipeAndPassReceiver(), 0,
+      network::mojom::kURLLoadOptionNone, *request,
+      loader_client_.BindNewPipeAndPassRemote(),
+      net::MutableNetworkTrafficAnnotationTag(annotation));
+  loader_client_.set_disconnect_handler(base::BindOnce(
+      &URLPipeLoader::NotifyComplete, base::Unretained(this), net::ERR_FAILED));
 }
 
 void URLPipeLoader::NotifyComplete(int result) {
@@ -58,46 +65,58 @@ void URLPipeLoader::NotifyComplete(int result) {
   delete this;
 }
 
-void URLPipeLoader::OnResponseStarted(
-    const GURL& final_url,
-    const network::mojom::URLResponseHead& response_head) {
-  mojo::ScopedDataPipeProducerHandle producer;
-  mojo::ScopedDataPipeConsumerHandle consumer;
-  MojoResult rv = mojo::CreateDataPipe(nullptr, producer, consumer);
-  if (rv != MOJO_RESULT_OK) {
-    NotifyComplete(net::ERR_INSUFFICIENT_RESOURCES);
-    return;
-  }
+void URLPipeLoader::OnReceiveResponse(
+    network::mojom::URLResponseHeadPtr head,
+    mojo::ScopedDataPipeConsumerHandle body,
+    std::optional<mojo_base::BigBuffer> cached_metadata) {
+  const int response_code =
+      head->headers ? head->headers->response_code() : 200;
+  client_->OnReceiveResponse(std::move(head), std::move(body),
+                             std::move(cached_metadata));
+
+  // Like network::SimpleURLLoader, which this used to be built on, fail the
+  // request when the server responds with an error.
+  if (response_code / 100 != 2)
+    NotifyComplete(net::ERR_HTTP_RESPONSE_CODE_FAILURE);
+}
 
-  producer_ = std::make_unique<mojo::DataPipeProducer>(std::move(producer));
+void URLPipeLoader::OnReceiveRedirect(const net::RedirectInfo& redirect_info,
+                                      network::mojom::URLResponseHeadPtr head) {
+  // Redirects of the target URL are followed, the client only sees the final
+  // response.
+  loader_->FollowRedirect({}, {}, {}, std::nullopt);
+}
+
+void URLPipeLoader::OnUploadProgress(int64_t current_position,
+                                     int64_t total_size,
+                                     OnUploadProgressCallback callback) {
+  std::move(callback).Run();
+}
 
-  client_->OnReceiveResponse(response_head.Clone(), std::move(consumer),
-                             std::nullopt);
+void URLPipeLoader::OnTransferSizeUpdated(int32_t transfer_size_diff) {
+  client_->OnTransferSizeUpdated(transfer_size_diff);
 }
 
-void URLPipeLoader::OnWrite(base::OnceClosure resume, MojoResult result) {
-  if (result == MOJO_RESULT_OK)
-    std::move(resume).Run();
-  else
-    NotifyComplete(net::ERR_FAILED);
+void URLPipeLoader::OnComplete(
+    const network::URLLoaderCompletionStatus& status) {
+  client_->OnComplete(status);
+  delete this;
 }
 
-void URLPipeLoader::OnDataReceived(base::StringPiece string_piece,
-                                   base::OnceClosure resume) {
-  producer_->Write(
-      std::make_unique<mojo::StringDataSource>(
-          string_piece, mojo::StringDataSource::AsyncWritingMode::
-                            STRING_MAY_BE_INVALIDATED_BEFORE_COMPLETION),
-      base::BindOnce(&URLPipeLoader::OnWrite, weak_factory_.GetWeakPtr(),
-                     std::move(resume)));
+void URLPipeLoader::SetPriority(net::RequestPriority priority,
+                                int32_t intra_priority_value) {
+  if (loader_)
+    loader_->SetPriority(priority, intra_priority_value);
 }
 
-void URLPipeLoader::OnRetry(base::OnceClosure start_retry) {
-  NOTREACHED();
+void URLPipeLoader::PauseReadingBodyFromNet() {
+  if (loader_)
+    loader_->PauseReadingBodyFromNet();
 }
 
-void URLPipeLoader::OnComplete(bool success) {
-  NotifyComplete(loader_->NetError());
+void URLPipeLoader::ResumeReadingBodyFromNet() {
+  if (loader_)
+    loader_->ResumeReadingBodyFromNet();
 }
 
 }  // namespace electron
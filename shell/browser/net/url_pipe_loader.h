@@ -6,17 +6,16 @@
 #define ELECTRON_SHELL_BROWSER_NET_URL_PIPE_LOADER_H_
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "base/values.h"
 #include "mojo/public/cpp/bindings/receiver.h"
 #include "mojo/public/cpp/bindings/remote.h"
-#include "mojo/public/cpp/system/data_pipe_producer.h"
 #include "services/network/public/cpp/resource_request.h"
-#include "services/network/public/cpp/simple_url_loader.h"
-#include "services/network/public/cpp/simple_url_loader_stream_consumer.h"
 #include "services/network/public/mojom/url_loader.mojom.h"
+#include "services/network/public/mojom/url_response_head.mojom-forward.h"
 
 namespace network {
 class SharedURLLoaderFactory;
@@ -29,10 +28,14 @@ namespace electron {
 // Different from creating a new loader for the URL directly, protocol handlers
 // using this loader can work around CORS restrictions.
 //
+// The data pipe of the response is handed to the client as is, so the body is
+// never buffered or copied here, and the upstream loader is only as far ahead
+// as the pipe's capacity allows.
+//
 // This class manages its own lifetime and should delete itself when the
 // connection is lost or finished.
 class URLPipeLoader : public network::mojom::URLLoader,
-                      public network::SimpleURLLoaderStreamConsumer {
+                      public network::mojom::URLLoaderClient {
  public:
   URLPipeLoader(scoped_refptr<network::SharedURLLoaderFactory> factory,
                 std::unique_ptr<network::ResourceRequest> request,
@@ -53,15 +56,21 @@ class URLPipeLoader : public network::mojom::URLLoader,
              const net::NetworkTrafficAnnotationTag& annotation,
              base::Value::Dict upload_data);
   void NotifyComplete(int result);
-  void OnResponseStarted(const GURL& final_url,
-                         const network::mojom::URLResponseHead& response_head);
-  void OnWrite(base::OnceClosure resume, MojoResult result);
 
-  // SimpleURLLoaderStreamConsumer:
-  void OnDataReceived(base::StringPiece string_piece,
-                      base::OnceClosure resume) override;
-  void OnComplete(bool success) override;
-  void OnRetry(base::OnceClosure start_retry) override;
+  // URLLoaderClient:
+  void OnReceiveEarlyHints(
+      network::mojom::EarlyHintsPtr early_hints) override {}
+  void OnReceiveResponse(
+      network::mojom::URLResponseHeadPtr head,
+      mojo::ScopedDataPipeConsumerHandle body,
+      std::optional<mojo_base::BigBuffer> cached_metadata) override;
+  void OnReceiveRedirect(const net::RedirectInfo& redirect_info,
+                         network::mojom::URLResponseHeadPtr head) override;
+  void OnUploadProgress(int64_t current_position,
+                        int64_t total_size,
+                        OnUploadProgressCallback callback) override;
+  void OnTransferSizeUpdated(int32_t transfer_size_diff) override;
+  void OnComplete(const network::URLLoaderCompletionStatus& status) override;
 
   // URLLoader:
   void FollowRedirect(
@@ -70,17 +79,15 @@ class URLPipeLoader : public network::mojom::URLLoader,
       const net::HttpRequestHeaders& modified_cors_exempt_headers,
       const std::optional<GURL>& new_url) override {}
   void SetPriority(net::RequestPriority priority,
-                   int32_t intra_priority_value) override {}
-  void PauseReadingBodyFromNet() override {}
-  void ResumeReadingBodyFromNet() override {}
+                   int32_t intra_priority_value) override;
+  void PauseReadingBodyFromNet() override;
+  void ResumeReadingBodyFromNet() override;
 
   mojo::Receiver<network::mojom::URLLoader> url_loader_;
   mojo::Remote<network::mojom::URLLoaderClient> client_;
 
-  std::unique_ptr<mojo::DataPipeProducer> producer_;
-  std::unique_ptr<network::SimpleURLLoader> loader_;
-
-  base::WeakPtrFactory<URLPipeLoader> weak_factory_{this};
+  mojo::Remote<network::mojom::URLLoader> loader_;
+  mojo::Receiver<network::mojom::URLLoaderClient> loader_client_{this};
 };
 
 }  // namespace electron
@@ -9,6 +9,7 @@
 #include <string>
 
 #include "extensions/browser/api/web_request/web_request_info.h"
+#include "extensions/browser/api/web_request/web_request_resource_type.h"
 #include "net/base/completion_once_callback.h"
 #include "services/network/public/cpp/resource_request.h"
 
@@ -25,6 +26,10 @@ class WebRequestAPI {
                               int error_code)>;
 
   virtual bool HasListener() const = 0;
+  // Whether a listener or rule might apply to some request of |type|.
+  // Requests for which this is false are not seen by the API at all.
+  virtual bool MayHaveListenerForType(
+      extensions::WebRequestResourceType type) const = 0;
   virtual int OnBeforeRequest(extensions::WebRequestInfo* info,
                               const network::ResourceRequest& request,
                               net::CompletionOnceCallback callback,
@@ -0,0 +1,136 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/osr/osr_buffer_pool.h"
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+#include "base/bits.h"
+#include "base/functional/bind.h"
+#include "base/trace_event/trace_event.h"
+
+namespace electron {
+
+namespace {
+
+// How many free buffers are kept of each size class, and in total. A frame
+// of a 1080p view takes 8 MB.
+constexpr size_t kMaxFreeBuffersPerSizeClass = 4;
+constexpr size_t kMaxCachedBytes = 64 * 1024 * 1024;
+
+constexpr size_t kMinSizeClassGranularity = 4096;
+
+struct PooledBuffer {
+  size_t size_class;
+  std::unique_ptr<uint8_t[]> buffer;
+};
+
+}  // namespace
+
+// static
+OffScreenBufferPool* OffScreenBufferPool::GetInstance() {
+  static base::NoDestructor<OffScreenBufferPool> instance;
+  return instance.get();
+}
+
+OffScreenBufferPool::OffScreenBufferPool()
+    : memory_pressure_listener_(
+          FROM_HERE,
+          base::BindRepeating(&OffScreenBufferPool::OnMemoryPressure,
+                              base::Unretained(this))) {}
+
+OffScreenBufferPool::~OffScreenBufferPool() = default;
+
+// static
+size_t OffScreenBufferPool::GetSizeClass(size_t byte_size) {
+  const size_t granularity =
+      std::max(std::bit_floor(byte_size) / 8, kMinSizeClassGranularity);
+  return base::bits::AlignUp(byte_size, granularity);
+}
+
+SkBitmap OffScreenBufferPool::Allocate(const gfx::Size& size,
+                                       bool is_opaque) {
+  const SkImageInfo info = SkImageInfo::MakeN32(
+      size.width(), size.height(),
+      is_opaque ? kOpaque_SkAlphaType : kPremul_SkAlphaType);
+  SkBitmap bitmap;
+  if (info.isEmpty())
+    return bitmap;
+
+  const size_t size_class = GetSizeClass(info.computeMinByteSize());
+  std::unique_ptr<uint8_t[]> buffer;
+  {
+    base::AutoLock lock(lock_);
+    auto it = free_buffers_.find(size_class);
+    if (it != free_buffers_.end()) {
+      buffer = std::move(it->second.back());
+      it->second.pop_back();
+      if (it->second.empty())
+        free_buffers_.erase(it);
+      bytes_cached_ -= size_class;
+      ++hits_;
+    } else {
+      ++misses_;
+    }
+    bytes_in_use_ += size_class;
+    ReportUsageLocked();
+  }
+  if (!buffer)
+    buffer = std::make_unique_for_overwrite<uint8_t[]>(size_class);
+
+  void* const pixels = buffer.get();
+  bitmap.installPixels(
+      info, pixels, info.minRowBytes(),
+      [](void* addr, void* context) {
+        std::unique_ptr<PooledBuffer> pooled(
+            static_cast<PooledBuffer*>(context));
+        OffScreenBufferPool::GetInstance()->Release(pooled->size_class,
+                                                    std::move(pooled->buffer));
+      },
+      new PooledBuffer{size_class, std::move(buffer)});
+  return bitmap;
+}
+
+void OffScreenBufferPool::Purge() {
+  base::AutoLock lock(lock_);
+  PurgeLocked();
+  ReportUsageLocked();
+}
+
+void OffScreenBufferPool::Release(size_t size_class,
+                                  std::unique_ptr<uint8_t[]> buffer) {
+  base::AutoLock lock(lock_);
+  bytes_in_use_ -= size_class;
+
+  auto& buffers = free_buffers_[size_class];
+  if (buffers.size() < kMaxFreeBuffersPerSizeClass &&
+      bytes_cached_ + size_class <= kMaxCachedBytes) {
+    buffers.push_back(std::move(buffer));
+    bytes_cached_ += size_class;
+  } else if (buffers.empty()) {
+    free_buffers_.erase(size_class);
+  }
+  ReportUsageLocked();
+}
+
+void OffScreenBufferPool::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel level) {
+  Purge();
+}
+
+void OffScreenBufferPool::PurgeLocked() {
+  free_buffers_.clear();
+  bytes_cached_ = 0;
+}
+
+void OffScreenBufferPool::ReportUsageLocked() {
+  TRACE_COUNTER2("electron", "OffScreenBufferPoolBytes", "inUse",
+                 bytes_in_use_, "cached", bytes_cached_);
+  TRACE_COUNTER2("electron", "OffScreenBufferPoolAllocations", "reused", hits_,
+                 "allocated", misses_);
+}
+
+}  // namespace electron
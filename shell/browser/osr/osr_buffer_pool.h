@@ -0,0 +1,71 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_OSR_OSR_BUFFER_POOL_H_
+#define ELECTRON_SHELL_BROWSER_OSR_OSR_BUFFER_POOL_H_
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "base/memory/memory_pressure_listener.h"
+#include "base/no_destructor.h"
+#include "base/synchronization/lock.h"
+#include "base/thread_annotations.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "ui/gfx/geometry/size.h"
+
+namespace electron {
+
+// Hands out the pixel memory of the bitmaps that offscreen views paint and
+// composite into, and keeps it for reuse by any view once it is released
+// instead of freeing it. Buffers are bucketed in size classes, so views of
+// slightly different sizes, and views that are being resized, share them.
+//
+// Its usage is reported in the "electron" tracing category.
+class OffScreenBufferPool {
+ public:
+  static OffScreenBufferPool* GetInstance();
+
+  OffScreenBufferPool(const OffScreenBufferPool&) = delete;
+  OffScreenBufferPool& operator=(const OffScreenBufferPool&) = delete;
+
+  // Returns an N32 bitmap of |size| whose pixels go back to the pool once the
+  // last reference to them is dropped, which may happen on any thread. Like
+  // SkBitmap::allocN32Pixels(), the pixels are left uninitialized.
+  SkBitmap Allocate(const gfx::Size& size, bool is_opaque);
+
+  // Frees all of the buffers that are not in use.
+  void Purge();
+
+ private:
+  friend class base::NoDestructor<OffScreenBufferPool>;
+
+  OffScreenBufferPool();
+  ~OffScreenBufferPool();
+
+  // Rounds |byte_size| up to its size class, which wastes at most an eighth
+  // of it.
+  static size_t GetSizeClass(size_t byte_size);
+
+  void Release(size_t size_class, std::unique_ptr<uint8_t[]> buffer);
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel level);
+  void PurgeLocked() EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  void ReportUsageLocked() EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  base::Lock lock_;
+  std::map<size_t, std::vector<std::unique_ptr<uint8_t[]>>> free_buffers_
+      GUARDED_BY(lock_);
+  size_t bytes_in_use_ GUARDED_BY(lock_) = 0;
+  size_t bytes_cached_ GUARDED_BY(lock_) = 0;
+  size_t hits_ GUARDED_BY(lock_) = 0;
+  size_t misses_ GUARDED_BY(lock_) = 0;
+
+  base::MemoryPressureListener memory_pressure_listener_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_OSR_OSR_BUFFER_POOL_H_
@@ -30,8 +30,10 @@
 #include "content/public/browser/context_factory.h"
 #include "content/public/browser/gpu_data_manager.h"
 #include "content/public/browser/render_process_host.h"
+#include "content/public/common/input/native_web_keyboard_event.h"
 #include "gpu/command_buffer/client/gl_helper.h"
 #include "media/base/video_frame.h"
+#include "shell/browser/osr/osr_buffer_pool.h"
 #include "third_party/blink/public/common/input/web_input_event.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "ui/compositor/compositor.h"
@@ -43,6 +45,7 @@
 #include "ui/gfx/canvas.h"
 #include "ui/gfx/geometry/dip_util.h"
 #include "ui/gfx/geometry/size_conversions.h"
+#include "ui/gfx/geometry/skia_conversions.h"
 #include "ui/gfx/image/image_skia.h"
 #include "ui/gfx/native_widget_types.h"
 #include "ui/gfx/skbitmap_operations.h"
@@ -54,6 +57,11 @@ namespace {
 
 const float kDefaultScaleFactor = 1.0;
 
+// How long an adaptive frame rate view goes without painting before its frame
+// rate is halved, and the rate it is never lowered below.
+constexpr base::TimeDelta kIdleFrameRatePeriod = base::Seconds(1);
+constexpr int kMinIdleFrameRate = 1;
+
 ui::MouseEvent UiMouseEventFromWebMouseEvent(blink::WebMouseEvent event) {
   ui::EventType type = ui::EventType::ET_UNKNOWN;
   switch (event.GetType()) {
@@ -172,19 +180,24 @@ class ElectronDelegatedFrameHostClient
 };
 
 OffScreenRenderWidgetHostView::OffScreenRenderWidgetHostView(
-    bool transparent,
+    const OffScreenRenderOptions& options,
     bool painting,
     int frame_rate,
     const OnPaintCallback& callback,
+    const OnSharedPaintCallback& shared_callback,
     content::RenderWidgetHost* host,
     OffScreenRenderWidgetHostView* parent_host_view,
     gfx::Size initial_size)
     : content::RenderWidgetHostViewBase(host),
       render_widget_host_(content::RenderWidgetHostImpl::From(host)),
       parent_host_view_(parent_host_view),
-      transparent_(transparent),
+      transparent_(options.transparent),
+      shared_texture_(options.shared_texture),
+      dirty_rect_only_(options.dirty_rect_only),
       callback_(callback),
+      shared_callback_(shared_callback),
       frame_rate_(frame_rate),
+      adaptive_frame_rate_(options.adaptive_frame_rate),
       size_(initial_size),
       painting_(painting),
       delegated_frame_host_client_{
@@ -232,11 +245,18 @@ OffScreenRenderWidgetHostView::OffScreenRenderWidgetHostView(
 
   if (content::GpuDataManager::GetInstance()->HardwareAccelerationEnabled()) {
     video_consumer_ = std::make_unique<OffScreenVideoConsumer>(
-        this, base::BindRepeating(&OffScreenRenderWidgetHostView::OnPaint,
-                                  weak_ptr_factory_.GetWeakPtr()));
+        this,
+        base::BindRepeating(&OffScreenRenderWidgetHostView::OnPaint,
+                            weak_ptr_factory_.GetWeakPtr()),
+        shared_callback_
+            ? base::BindRepeating(&OffScreenRenderWidgetHostView::OnSharedPaint,
+                                  weak_ptr_factory_.GetWeakPtr())
+            : OnSharedPaintCallback());
     video_consumer_->SetActive(is_painting());
     video_consumer_->SetFrameRate(this->frame_rate());
   }
+
+  RestoreFrameRate();
 }
 
 OffScreenRenderWidgetHostView::~OffScreenRenderWidgetHostView() {
@@ -417,6 +437,10 @@ void OffScreenRenderWidgetHostView::InitAsPopup(
   }
 
   parent_host_view_->set_popup_host_view(this);
+  // Frames handed out in shared memory are not kept in the parent's backing,
+  // which the popup now has to be composited into.
+  if (parent_host_view_->shared_callback_ && parent_host_view_->video_consumer_)
+    parent_host_view_->video_consumer_->RequestRefreshFrame();
   parent_callback_ =
       base::BindRepeating(&OffScreenRenderWidgetHostView::OnPopupPaint,
                           parent_host_view_->weak_ptr_factory_.GetWeakPtr());
@@ -558,7 +582,8 @@ OffScreenRenderWidgetHostView::CreateViewForWidget(
   }
 
   return new OffScreenRenderWidgetHostView(
-      transparent_, true, embedder_host_view->frame_rate(), callback_,
+      OffScreenRenderOptions{.transparent = transparent_}, true,
+      embedder_host_view->frame_rate(), callback_, OnSharedPaintCallback(),
       render_widget_host, embedder_host_view, size());
 }
 
@@ -621,6 +646,9 @@ void OffScreenRenderWidgetHostView::RemoveGuestHostView(
 void OffScreenRenderWidgetHostView::AddViewProxy(OffscreenViewProxy* proxy) {
   proxy->SetObserver(this);
   proxy_views_.insert(proxy);
+  // See InitAsPopup().
+  if (shared_callback_ && video_consumer_)
+    video_consumer_->RequestRefreshFrame();
 }
 
 void OffScreenRenderWidgetHostView::RemoveViewProxy(OffscreenViewProxy* proxy) {
@@ -686,9 +714,23 @@ uint64_t OffScreenRenderWidgetHostView::GetNSViewId() const {
 
 void OffScreenRenderWidgetHostView::OnPaint(const gfx::Rect& damage_rect,
                                             const SkBitmap& bitmap) {
-  backing_ = std::make_unique<SkBitmap>();
-  backing_->allocN32Pixels(bitmap.width(), bitmap.height(), !transparent_);
-  bitmap.readPixels(backing_->pixmap());
+  RestoreFrameRate();
+
+  gfx::Rect dirty_rect = gfx::IntersectRects(
+      gfx::Rect(bitmap.width(), bitmap.height()), damage_rect);
+  if (dirty_rect_only_ && backing_->width() == bitmap.width() &&
+      backing_->height() == bitmap.height()) {
+    SkPixmap dirty_pixels;
+    if (backing_->pixmap().extractSubset(&dirty_pixels,
+                                         gfx::RectToSkIRect(dirty_rect))) {
+      bitmap.readPixels(dirty_pixels, dirty_rect.x(), dirty_rect.y());
+    }
+  } else {
+    backing_ = std::make_unique<SkBitmap>(
+        OffScreenBufferPool::GetInstance()->Allocate(
+            gfx::Size(bitmap.width(), bitmap.height()), !transparent_));
+    bitmap.readPixels(backing_->pixmap());
+  }
 
   if (IsPopupWidget() && parent_callback_) {
     parent_callback_.Run(this->popup_position_);
@@ -697,6 +739,29 @@ void OffScreenRenderWidgetHostView::OnPaint(const gfx::Rect& damage_rect,
   }
 }
 
+void OffScreenRenderWidgetHostView::OnSharedPaint(
+    const gfx::Rect& damage_rect,
+    std::unique_ptr<OffScreenSharedFrame> frame) {
+  RestoreFrameRate();
+
+  // Popups and proxy views have to be composited into a copy of the frame,
+  // which frames in GPU memory are never read back into.
+  if (!frame->is_texture() &&
+      (IsPopupWidget() || popup_host_view_ || !proxy_views_.empty())) {
+    OnPaint(damage_rect, OffScreenSharedFrame::ToBitmap(std::move(frame)));
+    return;
+  }
+
+  // The frame is not copied into the backing, so drop the outdated one.
+  backing_ = std::make_unique<SkBitmap>();
+
+  HoldResize();
+  shared_callback_.Run(
+      gfx::IntersectRects(gfx::Rect(SizeInPixels()), damage_rect),
+      std::move(frame));
+  ReleaseResize();
+}
+
 gfx::Size OffScreenRenderWidgetHostView::SizeInPixels() {
   float sf = GetDeviceScaleFactor();
   return gfx::ToFlooredSize(
@@ -705,6 +770,11 @@ gfx::Size OffScreenRenderWidgetHostView::SizeInPixels() {
 
 void OffScreenRenderWidgetHostView::CompositeFrame(
     const gfx::Rect& damage_rect) {
+  // The last frame was handed out without being copied into the backing, so
+  // there is nothing up to date to composite popups and proxy views into.
+  if (shared_callback_ && GetBacking().drawsNothing())
+    return;
+
   HoldResize();
 
   gfx::Size size_in_pixels = SizeInPixels();
@@ -716,8 +786,7 @@ void OffScreenRenderWidgetHostView::CompositeFrame(
     frame = GetBacking();
   } else {
     float sf = GetDeviceScaleFactor();
-    frame.allocN32Pixels(size_in_pixels.width(), size_in_pixels.height(),
-                         false);
+    frame = OffScreenBufferPool::GetInstance()->Allocate(size_in_pixels, false);
     if (!GetBacking().drawsNothing()) {
       SkCanvas canvas(frame);
       canvas.writePixels(GetBacking(), 0, 0);
@@ -789,6 +858,8 @@ void OffScreenRenderWidgetHostView::SynchronizeVisualProperties() {
 
 void OffScreenRenderWidgetHostView::SendMouseEvent(
     const blink::WebMouseEvent& event) {
+  RestoreFrameRate();
+
   for (auto* proxy_view : proxy_views_) {
     gfx::Rect bounds = proxy_view->bounds();
     if (bounds.Contains(event.PositionInWidget().x(),
@@ -825,8 +896,21 @@ void OffScreenRenderWidgetHostView::SendMouseEvent(
   render_widget_host_->ForwardMouseEvent(event);
 }
 
+void OffScreenRenderWidgetHostView::SendKeyboardEvent(
+    const content::NativeWebKeyboardEvent& event) {
+  // Typing usually repaints the page, so don't wait for the next frame to
+  // bring the frame rate back up.
+  RestoreFrameRate();
+
+  if (!render_widget_host_)
+    return;
+  render_widget_host_->ForwardKeyboardEvent(event);
+}
+
 void OffScreenRenderWidgetHostView::SendMouseWheelEvent(
     const blink::WebMouseWheelEvent& event) {
+  RestoreFrameRate();
+
   for (auto* proxy_view : proxy_views_) {
     gfx::Rect bounds = proxy_view->bounds();
     if (bounds.Contains(event.PositionInWidget().x(),
@@ -948,6 +1032,45 @@ void OffScreenRenderWidgetHostView::SetFrameRate(int frame_rate) {
 
   for (auto* guest_host_view : guest_host_views_)
     guest_host_view->SetFrameRate(frame_rate);
+
+  idle_frame_rate_ = 0;
+  RestoreFrameRate();
+}
+
+void OffScreenRenderWidgetHostView::RestoreFrameRate() {
+  if (!adaptive_frame_rate_)
+    return;
+
+  if (idle_frame_rate_) {
+    idle_frame_rate_ = 0;
+    ApplyFrameRate(frame_rate());
+  }
+  idle_timer_.Start(
+      FROM_HERE, kIdleFrameRatePeriod,
+      base::BindOnce(&OffScreenRenderWidgetHostView::LowerIdleFrameRate,
+                     base::Unretained(this)));
+}
+
+void OffScreenRenderWidgetHostView::LowerIdleFrameRate() {
+  int current_frame_rate = idle_frame_rate_ ? idle_frame_rate_ : frame_rate();
+  idle_frame_rate_ = std::max(kMinIdleFrameRate, current_frame_rate / 2);
+  ApplyFrameRate(idle_frame_rate_);
+
+  if (idle_frame_rate_ > kMinIdleFrameRate) {
+    idle_timer_.Start(
+        FROM_HERE, kIdleFrameRatePeriod,
+        base::BindOnce(&OffScreenRenderWidgetHostView::LowerIdleFrameRate,
+                       base::Unretained(this)));
+  }
+}
+
+void OffScreenRenderWidgetHostView::ApplyFrameRate(int frame_rate) {
+  if (compositor_) {
+    compositor_->SetDisplayVSyncParameters(base::TimeTicks::Now(),
+                                           base::Seconds(1) / frame_rate);
+  }
+  if (video_consumer_)
+    video_consumer_->SetFrameRate(frame_rate);
 }
 
 const viz::LocalSurfaceId& OffScreenRenderWidgetHostView::GetLocalSurfaceId()
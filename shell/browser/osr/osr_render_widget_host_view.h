@@ -19,6 +19,7 @@
 #include "base/memory/raw_ptr.h"
 #include "base/process/kill.h"
 #include "base/threading/thread.h"
+#include "base/timer/timer.h"
 #include "components/viz/common/quads/compositor_frame.h"
 #include "components/viz/common/surfaces/parent_local_surface_id_allocator.h"
 #include "content/browser/renderer_host/delegated_frame_host.h"  // nogncheck
@@ -46,7 +47,8 @@
 
 namespace content {
 class CursorManager;
-}
+struct NativeWebKeyboardEvent;
+}  // namespace content
 
 namespace electron {
 
@@ -59,14 +61,28 @@ typedef base::RepeatingCallback<void(const gfx::Rect&, const SkBitmap&)>
     OnPaintCallback;
 typedef base::RepeatingCallback<void(const gfx::Rect&)> OnPopupPaintCallback;
 
+// How the frames of an offscreen view are produced, which doesn't change for
+// the lifetime of the view.
+struct OffScreenRenderOptions {
+  bool transparent = false;
+  // Whether frames are captured into shared textures rather than bitmaps.
+  bool shared_texture = false;
+  // The painted bitmaps are only read within their damage rect, so the
+  // backing can be reused and only the damaged pixels copied into it.
+  bool dirty_rect_only = false;
+  // Whether the capture rate drops while the frames don't change.
+  bool adaptive_frame_rate = false;
+};
+
 class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
                                       public ui::CompositorDelegate,
                                       public OffscreenViewProxyObserver {
  public:
-  OffScreenRenderWidgetHostView(bool transparent,
+  OffScreenRenderWidgetHostView(const OffScreenRenderOptions& options,
                                 bool painting,
                                 int frame_rate,
                                 const OnPaintCallback& callback,
+                                const OnSharedPaintCallback& shared_callback,
                                 content::RenderWidgetHost* render_widget_host,
                                 OffScreenRenderWidgetHostView* parent_host_view,
                                 gfx::Size initial_size);
@@ -190,6 +206,8 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   void ProxyViewDestroyed(OffscreenViewProxy* proxy) override;
 
   void OnPaint(const gfx::Rect& damage_rect, const SkBitmap& bitmap);
+  void OnSharedPaint(const gfx::Rect& damage_rect,
+                     std::unique_ptr<OffScreenSharedFrame> frame);
   void OnPopupPaint(const gfx::Rect& damage_rect);
   void OnProxyViewPaint(const gfx::Rect& damage_rect) override;
 
@@ -209,6 +227,7 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
 
   void SendMouseEvent(const blink::WebMouseEvent& event);
   void SendMouseWheelEvent(const blink::WebMouseWheelEvent& event);
+  void SendKeyboardEvent(const content::NativeWebKeyboardEvent& event);
 
   void SetPainting(bool painting);
   bool is_painting() const { return painting_; }
@@ -216,6 +235,11 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   void SetFrameRate(int frame_rate);
   int frame_rate() const { return frame_rate_; }
 
+  // Brings the frame rate back up if it was lowered while nothing was painted,
+  // for when a frame is painted or is about to be.
+  void RestoreFrameRate();
+  bool shared_texture() const { return shared_texture_; }
+
   ui::Layer* root_layer() const { return root_layer_.get(); }
 
   content::DelegatedFrameHost* delegated_frame_host() const {
@@ -243,6 +267,11 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   void SetupFrameRate(bool force);
   void ResizeRootLayer(bool force);
 
+  // Halves the frame rate, down to kMinIdleFrameRate, for each idle period
+  // that passes without a frame being painted.
+  void LowerIdleFrameRate();
+  void ApplyFrameRate(int frame_rate);
+
   viz::FrameSinkId AllocateFrameSinkId();
 
   // Applies background color without notifying the RenderWidget about
@@ -259,12 +288,20 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   std::set<OffscreenViewProxy*> proxy_views_;
 
   const bool transparent_;
+  const bool shared_texture_;
+  const bool dirty_rect_only_;
   OnPaintCallback callback_;
+  OnSharedPaintCallback shared_callback_;
   OnPopupPaintCallback parent_callback_;
 
   int frame_rate_ = 0;
   int frame_rate_threshold_us_ = 0;
 
+  const bool adaptive_frame_rate_;
+  // The rate frames are captured at while idle, or 0 when at |frame_rate_|.
+  int idle_frame_rate_ = 0;
+  base::OneShotTimer idle_timer_;
+
   gfx::Size size_;
   bool painting_;
 
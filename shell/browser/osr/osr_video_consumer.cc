@@ -31,10 +31,42 @@ bool IsValidMinAndMaxFrameSize(gfx::Size min_frame_size,
 
 namespace electron {
 
+OffScreenSharedFrame::OffScreenSharedFrame() = default;
+
+OffScreenSharedFrame::~OffScreenSharedFrame() = default;
+
+// static
+SkBitmap OffScreenSharedFrame::ToBitmap(
+    std::unique_ptr<OffScreenSharedFrame> frame) {
+  DCHECK(!frame->is_texture());
+
+  // The SkBitmap's pixels will be marked as immutable, but the installPixels()
+  // API requires a non-const pointer. So, cast away the const.
+  void* const pixels = const_cast<void*>(frame->mapping.memory());
+  const gfx::Size size = frame->content_rect.size();
+  const size_t stride = frame->stride;
+
+  // Call installPixels() with a |releaseProc| that destroys |frame|, which
+  // both notifies the capturer that this consumer has finished with it and
+  // releases the shared memory mapping.
+  SkBitmap bitmap;
+  bitmap.installPixels(
+      SkImageInfo::MakeN32(size.width(), size.height(), kPremul_SkAlphaType),
+      pixels, stride,
+      [](void* addr, void* context) {
+        delete static_cast<OffScreenSharedFrame*>(context);
+      },
+      frame.release());
+  bitmap.setImmutable();
+  return bitmap;
+}
+
 OffScreenVideoConsumer::OffScreenVideoConsumer(
     OffScreenRenderWidgetHostView* view,
-    OnPaintCallback callback)
+    OnPaintCallback callback,
+    OnSharedPaintCallback shared_callback)
     : callback_(callback),
+      shared_callback_(shared_callback),
       view_(view),
       video_capturer_(view->CreateVideoCapturer()) {
   video_capturer_->SetAutoThrottlingEnabled(false);
@@ -49,7 +81,10 @@ OffScreenVideoConsumer::~OffScreenVideoConsumer() = default;
 
 void OffScreenVideoConsumer::SetActive(bool active) {
   if (active) {
-    video_capturer_->Start(this, viz::mojom::BufferFormatPreference::kDefault);
+    video_capturer_->Start(
+        this, view_->shared_texture()
+                  ? viz::mojom::BufferFormatPreference::kPreferGpuMemoryBuffer
+                  : viz::mojom::BufferFormatPreference::kDefault);
   } else {
     video_capturer_->Stop();
   }
@@ -66,19 +101,42 @@ void OffScreenVideoConsumer::SizeChanged(const gfx::Size& size_in_pixels) {
   video_capturer_->RequestRefreshFrame();
 }
 
+void OffScreenVideoConsumer::RequestRefreshFrame() {
+  video_capturer_->RequestRefreshFrame();
+}
+
 void OffScreenVideoConsumer::OnFrameCaptured(
     ::media::mojom::VideoBufferHandlePtr data,
     ::media::mojom::VideoFrameInfoPtr info,
     const gfx::Rect& content_rect,
     mojo::PendingRemote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
         callbacks) {
-  auto& data_region = data->get_read_only_shmem_region();
-
   if (!CheckContentRect(content_rect)) {
     SizeChanged(view_->SizeInPixels());
     return;
   }
 
+  std::optional<gfx::Rect> update_rect = info->metadata.capture_update_rect;
+  if (!update_rect.has_value() || update_rect->IsEmpty()) {
+    update_rect = content_rect;
+  }
+
+  // The capturer only hands out GPU memory buffers when they were preferred
+  // in SetActive(), which is only done when there is a |shared_callback_|.
+  if (data->is_gpu_memory_buffer_handle()) {
+    DCHECK(shared_callback_);
+    auto frame = std::make_unique<OffScreenSharedFrame>();
+    frame->texture = std::move(data->get_gpu_memory_buffer_handle());
+    frame->releaser = std::move(callbacks);
+    frame->coded_size = info->coded_size;
+    frame->content_rect = content_rect;
+    frame->stride = frame->texture.stride;
+    shared_callback_.Run(*update_rect, std::move(frame));
+    return;
+  }
+
+  auto& data_region = data->get_read_only_shmem_region();
+
   mojo::Remote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
       callbacks_remote(std::move(callbacks));
 
@@ -99,41 +157,22 @@ void OffScreenVideoConsumer::OnFrameCaptured(
     return;
   }
 
-  // The SkBitmap's pixels will be marked as immutable, but the installPixels()
-  // API requires a non-const pointer. So, cast away the const.
-  void* const pixels = const_cast<void*>(mapping.memory());
-
-  // Call installPixels() with a |releaseProc| that: 1) notifies the capturer
-  // that this consumer has finished with the frame, and 2) releases the shared
-  // memory mapping.
-  struct FramePinner {
-    // Keeps the shared memory that backs |frame_| mapped.
-    base::ReadOnlySharedMemoryMapping mapping;
-    // Prevents FrameSinkVideoCapturer from recycling the shared memory that
-    // backs |frame_|.
-    mojo::PendingRemote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
-        releaser;
-  };
-
-  SkBitmap bitmap;
-  bitmap.installPixels(
-      SkImageInfo::MakeN32(content_rect.width(), content_rect.height(),
-                           kPremul_SkAlphaType),
-      pixels,
+  auto frame = std::make_unique<OffScreenSharedFrame>();
+  frame->region = std::move(data_region);
+  frame->mapping = std::move(mapping);
+  frame->releaser = callbacks_remote.Unbind();
+  frame->coded_size = info->coded_size;
+  frame->content_rect = content_rect;
+  frame->stride =
       media::VideoFrame::RowBytes(media::VideoFrame::kARGBPlane,
-                                  info->pixel_format, info->coded_size.width()),
-      [](void* addr, void* context) {
-        delete static_cast<FramePinner*>(context);
-      },
-      new FramePinner{std::move(mapping), callbacks_remote.Unbind()});
-  bitmap.setImmutable();
+                                  info->pixel_format, info->coded_size.width());
 
-  std::optional<gfx::Rect> update_rect = info->metadata.capture_update_rect;
-  if (!update_rect.has_value() || update_rect->IsEmpty()) {
-    update_rect = content_rect;
+  if (shared_callback_) {
+    shared_callback_.Run(*update_rect, std::move(frame));
+  } else {
+    callback_.Run(*update_rect,
+                  OffScreenSharedFrame::ToBitmap(std::move(frame)));
   }
-
-  callback_.Run(*update_rect, bitmap);
 }
 
 void OffScreenVideoConsumer::OnNewSubCaptureTargetVersion(
@@ -10,22 +10,64 @@
 
 #include "base/functional/callback.h"
 #include "base/memory/raw_ptr.h"
+#include "base/memory/read_only_shared_memory_region.h"
 #include "base/memory/weak_ptr.h"
 #include "components/viz/host/client_frame_sink_video_capturer.h"
 #include "media/capture/mojom/video_capture_buffer.mojom-forward.h"
 #include "media/capture/mojom/video_capture_types.mojom.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "ui/gfx/geometry/rect.h"
+#include "ui/gfx/gpu_memory_buffer.h"
 
 namespace electron {
 
 class OffScreenRenderWidgetHostView;
 
+// A captured frame that is handed out in the capturer's shared memory or GPU
+// memory buffer instead of being copied. The memory stays mapped, and is not
+// reused by the capturer for another frame, until this is destroyed.
+struct OffScreenSharedFrame {
+  OffScreenSharedFrame();
+  ~OffScreenSharedFrame();
+
+  // disable copy
+  OffScreenSharedFrame(const OffScreenSharedFrame&) = delete;
+  OffScreenSharedFrame& operator=(const OffScreenSharedFrame&) = delete;
+
+  // Wraps the pixels of |frame| in an immutable SkBitmap, which keeps |frame|
+  // alive until the bitmap's pixels are released. Only for frames that are in
+  // shared memory.
+  static SkBitmap ToBitmap(std::unique_ptr<OffScreenSharedFrame> frame);
+
+  bool is_texture() const { return !texture.is_null(); }
+
+  base::ReadOnlySharedMemoryRegion region;
+  base::ReadOnlySharedMemoryMapping mapping;
+  // Set instead of |region| and |mapping| when the frame was captured into a
+  // GPU memory buffer.
+  gfx::GpuMemoryBufferHandle texture;
+  // Prevents FrameSinkVideoCapturer from recycling |region|.
+  mojo::PendingRemote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
+      releaser;
+  gfx::Size coded_size;
+  gfx::Rect content_rect;
+  size_t stride = 0;
+};
+
 typedef base::RepeatingCallback<void(const gfx::Rect&, const SkBitmap&)>
     OnPaintCallback;
+typedef base::RepeatingCallback<void(const gfx::Rect&,
+                                     std::unique_ptr<OffScreenSharedFrame>)>
+    OnSharedPaintCallback;
 
 class OffScreenVideoConsumer : public viz::mojom::FrameSinkVideoConsumer {
  public:
+  // Frames are passed to |shared_callback| when it is set, and to |callback|
+  // as bitmaps otherwise.
   OffScreenVideoConsumer(OffScreenRenderWidgetHostView* view,
-                         OnPaintCallback callback);
+                         OnPaintCallback callback,
+                         OnSharedPaintCallback shared_callback);
   ~OffScreenVideoConsumer() override;
 
   // disable copy
@@ -35,6 +77,7 @@ class OffScreenVideoConsumer : public viz::mojom::FrameSinkVideoConsumer {
   void SetActive(bool active);
   void SetFrameRate(int frame_rate);
   void SizeChanged(const gfx::Size& size_in_pixels);
+  void RequestRefreshFrame();
 
  private:
   // viz::mojom::FrameSinkVideoConsumer implementation.
@@ -52,6 +95,7 @@ class OffScreenVideoConsumer : public viz::mojom::FrameSinkVideoConsumer {
   bool CheckContentRect(const gfx::Rect& content_rect);
 
   OnPaintCallback callback_;
+  OnSharedPaintCallback shared_callback_;
 
   raw_ptr<OffScreenRenderWidgetHostView> view_;
   std::unique_ptr<viz::ClientFrameSinkVideoCapturer> video_capturer_;
@@ -12,9 +12,12 @@
 namespace electron {
 
 OffScreenWebContentsView::OffScreenWebContentsView(
-    bool transparent,
-    const OnPaintCallback& callback)
-    : transparent_(transparent), callback_(callback) {
+    const OffScreenRenderOptions& options,
+    const OnPaintCallback& callback,
+    const OnSharedPaintCallback& shared_callback)
+    : options_(options),
+      callback_(callback),
+      shared_callback_(shared_callback) {
 #if BUILDFLAG(IS_MAC)
   PlatformCreate();
 #endif
@@ -123,8 +126,8 @@ OffScreenWebContentsView::CreateViewForWidget(
   }
 
   return new OffScreenRenderWidgetHostView(
-      transparent_, painting_, GetFrameRate(), callback_, render_widget_host,
-      nullptr, GetSize());
+      options_, painting_, GetFrameRate(), callback_, shared_callback_,
+      render_widget_host, nullptr, GetSize());
 }
 
 content::RenderWidgetHostViewBase*
@@ -138,9 +141,13 @@ OffScreenWebContentsView::CreateViewForChildWidget(
           ? web_contents_impl->GetOuterWebContents()->GetRenderWidgetHostView()
           : web_contents_impl->GetRenderWidgetHostView());
 
-  return new OffScreenRenderWidgetHostView(transparent_, painting_,
-                                           view->frame_rate(), callback_,
-                                           render_widget_host, view, GetSize());
+  // Child widgets are painted into bitmaps at the rate of their parent.
+  OffScreenRenderOptions options = options_;
+  options.shared_texture = false;
+  options.adaptive_frame_rate = false;
+  return new OffScreenRenderWidgetHostView(
+      options, painting_, view->frame_rate(), callback_,
+      OnSharedPaintCallback(), render_widget_host, view, GetSize());
 }
 
 void OffScreenWebContentsView::SetPageTitle(const std::u16string& title) {}
@@ -30,7 +30,14 @@ class OffScreenWebContentsView : public content::WebContentsView,
                                  public content::RenderViewHostDelegateView,
                                  public NativeWindowObserver {
  public:
-  OffScreenWebContentsView(bool transparent, const OnPaintCallback& callback);
+  // Frames of the main widget are passed to |shared_callback| when it is set,
+  // in GPU memory buffers if |shared_texture| and in shared memory otherwise.
+  // Without it they are passed to |callback| as bitmaps, which are only read
+  // within the damage rect if |dirty_rect_only|. With |adaptive_frame_rate|
+  // the frame rate is lowered while nothing is painted.
+  OffScreenWebContentsView(const OffScreenRenderOptions& options,
+                           const OnPaintCallback& callback,
+                           const OnSharedPaintCallback& shared_callback);
   ~OffScreenWebContentsView() override;
 
   void SetWebContents(content::WebContents*);
@@ -101,10 +108,11 @@ class OffScreenWebContentsView : public content::WebContentsView,
 
   raw_ptr<NativeWindow> native_window_ = nullptr;
 
-  const bool transparent_;
+  const OffScreenRenderOptions options_;
   bool painting_ = true;
   int frame_rate_ = 60;
   OnPaintCallback callback_;
+  OnSharedPaintCallback shared_callback_;
 
   // Weak refs.
   raw_ptr<content::WebContents> web_contents_ = nullptr;
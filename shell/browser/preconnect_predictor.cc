@@ -0,0 +1,93 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/preconnect_predictor.h"
+
+#include <vector>
+
+#include "chrome/browser/predictors/preconnect_manager.h"
+#include "net/base/network_anonymization_key.h"
+#include "net/base/schemeful_site.h"
+#include "shell/browser/electron_browser_context.h"
+#include "url/gurl.h"
+
+namespace electron {
+
+namespace {
+
+constexpr size_t kMaxHosts = 100;
+constexpr size_t kMaxOriginsPerHost = 32;
+
+// Same thresholds as the loading predictor of Chrome.
+constexpr double kMinConfidenceToPreconnect = 0.75;
+constexpr double kMinConfidenceToPreresolve = 0.2;
+
+}  // namespace
+
+PreconnectPredictor::HostStats::HostStats() = default;
+PreconnectPredictor::HostStats::HostStats(const HostStats&) = default;
+PreconnectPredictor::HostStats::~HostStats() = default;
+
+PreconnectPredictor::PreconnectPredictor(
+    ElectronBrowserContext* browser_context)
+    : browser_context_(browser_context), hosts_(kMaxHosts) {}
+
+PreconnectPredictor::~PreconnectPredictor() = default;
+
+void PreconnectPredictor::SetEnabled(bool enabled) {
+  enabled_ = enabled;
+  if (!enabled_)
+    hosts_.Clear();
+}
+
+void PreconnectPredictor::LearnPage(
+    const url::Origin& page_origin,
+    const std::set<url::Origin>& resource_origins) {
+  if (!enabled_ || page_origin.opaque())
+    return;
+
+  auto iter = hosts_.Get(page_origin);
+  if (iter == hosts_.end())
+    iter = hosts_.Put(page_origin, HostStats());
+  HostStats& stats = iter->second;
+  ++stats.page_loads;
+  for (const auto& origin : resource_origins) {
+    if (origin == page_origin)
+      continue;
+    // Origins that are new once the host is full are unlikely to be common.
+    auto origin_iter = stats.origin_loads.find(origin);
+    if (origin_iter != stats.origin_loads.end())
+      ++origin_iter->second;
+    else if (stats.origin_loads.size() < kMaxOriginsPerHost)
+      stats.origin_loads.emplace(origin, 1);
+  }
+}
+
+void PreconnectPredictor::OnNavigationStarted(const GURL& url) {
+  if (!enabled_ || !url.SchemeIsHTTPOrHTTPS())
+    return;
+
+  url::Origin page_origin = url::Origin::Create(url);
+  auto iter = hosts_.Get(page_origin);
+  if (iter == hosts_.end())
+    return;
+
+  const HostStats& stats = iter->second;
+  auto network_anonymization_key =
+      net::NetworkAnonymizationKey::CreateSameSite(
+          net::SchemefulSite(page_origin));
+  std::vector<predictors::PreconnectRequest> requests;
+  for (const auto& [origin, loads] : stats.origin_loads) {
+    double confidence = static_cast<double>(loads) / stats.page_loads;
+    if (confidence < kMinConfidenceToPreresolve)
+      continue;
+    // Requests without sockets only resolve the host.
+    int num_sockets = confidence >= kMinConfidenceToPreconnect ? 1 : 0;
+    requests.emplace_back(origin, num_sockets, network_anonymization_key);
+  }
+  if (!requests.empty())
+    browser_context_->GetPreconnectManager()->Start(url, std::move(requests));
+}
+
+}  // namespace electron
@@ -0,0 +1,63 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_PRECONNECT_PREDICTOR_H_
+#define ELECTRON_SHELL_BROWSER_PRECONNECT_PREDICTOR_H_
+
+#include <map>
+#include <set>
+
+#include "base/containers/lru_cache.h"
+#include "base/memory/raw_ptr.h"
+#include "url/origin.h"
+
+class GURL;
+
+namespace electron {
+
+class ElectronBrowserContext;
+
+// Learns which origins the pages of a host load their subresources from, and
+// preconnects to them, or only resolves their host when they are used less
+// often, as soon as a navigation to the host starts. What is learned is kept
+// in memory only. Each ElectronBrowserContext owns one predictor.
+class PreconnectPredictor {
+ public:
+  explicit PreconnectPredictor(ElectronBrowserContext* browser_context);
+  ~PreconnectPredictor();
+
+  // disable copy
+  PreconnectPredictor(const PreconnectPredictor&) = delete;
+  PreconnectPredictor& operator=(const PreconnectPredictor&) = delete;
+
+  // Disabling the predictor forgets everything it has learned.
+  void SetEnabled(bool enabled);
+  bool enabled() const { return enabled_; }
+
+  // Records the origins a page of |page_origin| loaded subresources from.
+  void LearnPage(const url::Origin& page_origin,
+                 const std::set<url::Origin>& resource_origins);
+
+  // Called as a main frame navigation to |url| starts.
+  void OnNavigationStarted(const GURL& url);
+
+ private:
+  struct HostStats {
+    HostStats();
+    HostStats(const HostStats&);
+    ~HostStats();
+
+    size_t page_loads = 0;
+    // The number of page loads that used each origin.
+    std::map<url::Origin, size_t> origin_loads;
+  };
+
+  raw_ptr<ElectronBrowserContext> browser_context_;
+  bool enabled_ = false;
+  base::LRUCache<url::Origin, HostStats> hosts_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_PRECONNECT_PREDICTOR_H_
@@ -4,6 +4,9 @@
 
 #include "shell/browser/protocol_registry.h"
 
+#include <utility>
+
+#include "base/functional/bind.h"
 #include "base/stl_util.h"
 #include "content/public/browser/web_contents.h"
 #include "electron/fuses.h"
@@ -46,6 +49,9 @@ void ProtocolRegistry::RegisterURLLoaderFactories(
     factories->emplace(it.first, ElectronURLLoaderFactory::Create(
                                      it.second.first, it.second.second));
   }
+
+  for (const auto& it : remote_handlers_)
+    factories->emplace(it.first, CreateURLLoaderFactoryForProtocol(it.first));
 }
 
 mojo::PendingRemote<network::mojom::URLLoaderFactory>
@@ -56,11 +62,23 @@ ProtocolRegistry::CreateNonNetworkNavigationURLLoaderFactory(
       return AsarURLLoaderFactory::Create();
     }
   } else {
-    auto handler = handlers_.find(scheme);
-    if (handler != handlers_.end()) {
-      return ElectronURLLoaderFactory::Create(handler->second.first,
-                                              handler->second.second);
-    }
+    return CreateURLLoaderFactoryForProtocol(scheme);
+  }
+  return {};
+}
+
+mojo::PendingRemote<network::mojom::URLLoaderFactory>
+ProtocolRegistry::CreateURLLoaderFactoryForProtocol(const std::string& scheme) {
+  auto handler = handlers_.find(scheme);
+  if (handler != handlers_.end()) {
+    return ElectronURLLoaderFactory::Create(handler->second.first,
+                                            handler->second.second);
+  }
+  auto remote_handler = remote_handlers_.find(scheme);
+  if (remote_handler != remote_handlers_.end()) {
+    mojo::PendingRemote<network::mojom::URLLoaderFactory> factory;
+    remote_handler->second->Clone(factory.InitWithNewPipeAndPassReceiver());
+    return factory;
   }
   return {};
 }
@@ -68,15 +86,38 @@ ProtocolRegistry::CreateNonNetworkNavigationURLLoaderFactory(
 bool ProtocolRegistry::RegisterProtocol(ProtocolType type,
                                         const std::string& scheme,
                                         const ProtocolHandler& handler) {
+  if (base::Contains(remote_handlers_, scheme))
+    return false;
   return handlers_.try_emplace(scheme, type, handler).second;
 }
 
 bool ProtocolRegistry::UnregisterProtocol(const std::string& scheme) {
-  return handlers_.erase(scheme) != 0;
+  return handlers_.erase(scheme) != 0 || remote_handlers_.erase(scheme) != 0;
 }
 
 bool ProtocolRegistry::IsProtocolRegistered(const std::string& scheme) {
-  return base::Contains(handlers_, scheme);
+  return base::Contains(handlers_, scheme) ||
+         base::Contains(remote_handlers_, scheme);
+}
+
+bool ProtocolRegistry::RegisterRemoteProtocol(
+    const std::string& scheme,
+    mojo::PendingRemote<network::mojom::URLLoaderFactory> factory) {
+  if (base::Contains(handlers_, scheme))
+    return false;
+  auto [it, added] = remote_handlers_.try_emplace(scheme, std::move(factory));
+  if (!added)
+    return false;
+  // Forget the handler once its process exits, so that the scheme can be
+  // registered again.
+  it->second.set_disconnect_handler(
+      base::BindOnce(&ProtocolRegistry::OnRemoteHandlerDisconnected,
+                     base::Unretained(this), scheme));
+  return true;
+}
+
+void ProtocolRegistry::OnRemoteHandlerDisconnected(const std::string& scheme) {
+  remote_handlers_.erase(scheme);
 }
 
 bool ProtocolRegistry::InterceptProtocol(ProtocolType type,
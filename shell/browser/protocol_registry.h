@@ -5,9 +5,11 @@
 #ifndef ELECTRON_SHELL_BROWSER_PROTOCOL_REGISTRY_H_
 #define ELECTRON_SHELL_BROWSER_PROTOCOL_REGISTRY_H_
 
+#include <map>
 #include <string>
 
 #include "content/public/browser/content_browser_client.h"
+#include "mojo/public/cpp/bindings/remote.h"
 #include "shell/browser/net/electron_url_loader_factory.h"
 
 namespace content {
@@ -32,6 +34,11 @@ class ProtocolRegistry {
   mojo::PendingRemote<network::mojom::URLLoaderFactory>
   CreateNonNetworkNavigationURLLoaderFactory(const std::string& scheme);
 
+  // Returns a factory for the handler registered for |scheme|, or an invalid
+  // remote when there is none.
+  mojo::PendingRemote<network::mojom::URLLoaderFactory>
+  CreateURLLoaderFactoryForProtocol(const std::string& scheme);
+
   const HandlersMap& intercept_handlers() const { return intercept_handlers_; }
   const HandlersMap& handlers() const { return handlers_; }
 
@@ -41,6 +48,12 @@ class ProtocolRegistry {
   bool UnregisterProtocol(const std::string& scheme);
   bool IsProtocolRegistered(const std::string& scheme);
 
+  // Registers |scheme| to be served by a factory in another process, like a
+  // utility process, which is cloned for every loader factory requested.
+  bool RegisterRemoteProtocol(
+      const std::string& scheme,
+      mojo::PendingRemote<network::mojom::URLLoaderFactory> factory);
+
   bool InterceptProtocol(ProtocolType type,
                          const std::string& scheme,
                          const ProtocolHandler& handler);
@@ -52,8 +65,14 @@ class ProtocolRegistry {
 
   ProtocolRegistry();
 
+  void OnRemoteHandlerDisconnected(const std::string& scheme);
+
   HandlersMap handlers_;
   HandlersMap intercept_handlers_;
+
+  // scheme => factory.
+  std::map<std::string, mojo::Remote<network::mojom::URLLoaderFactory>>
+      remote_handlers_;
 };
 
 }  // namespace electron
@@ -10,6 +10,7 @@
 #include "base/base64.h"
 #include "base/containers/contains.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/sequenced_task_runner.h"
 #include "base/values.h"
 #include "content/public/browser/device_service.h"
 #include "content/public/browser/web_contents.h"
@@ -209,6 +210,22 @@ device::mojom::SerialPortManager* SerialChooserContext::GetPortManager() {
   return port_manager_.get();
 }
 
+void SerialChooserContext::GetPorts(
+    device::mojom::SerialPortManager::GetDevicesCallback callback) {
+  if (!is_initialized_) {
+    EnsurePortManagerConnection();
+    pending_get_ports_requests_.push(std::move(callback));
+    return;
+  }
+
+  std::vector<device::mojom::SerialPortInfoPtr> ports;
+  ports.reserve(port_info_.size());
+  for (const auto& entry : port_info_)
+    ports.push_back(entry.second->Clone());
+  base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+      FROM_HERE, base::BindOnce(std::move(callback), std::move(ports)));
+}
+
 void SerialChooserContext::AddPortObserver(PortObserver* observer) {
   port_observer_list_.AddObserver(observer);
 }
@@ -269,13 +286,34 @@ void SerialChooserContext::OnGetDevices(
   for (auto& port : ports)
     port_info_.insert({port->token, std::move(port)});
   is_initialized_ = true;
+
+  while (!pending_get_ports_requests_.empty()) {
+    std::vector<device::mojom::SerialPortInfoPtr> port_list;
+    port_list.reserve(port_info_.size());
+    for (const auto& entry : port_info_)
+      port_list.push_back(entry.second->Clone());
+    std::move(pending_get_ports_requests_.front()).Run(std::move(port_list));
+    pending_get_ports_requests_.pop();
+  }
 }
 
 void SerialChooserContext::OnPortManagerConnectionError() {
+  // The requests still waiting for the first list of ports won't get one from
+  // this connection, so they are answered with no ports. That happens once
+  // the connection is gone, so that a request they make reconnects.
+  base::queue<device::mojom::SerialPortManager::GetDevicesCallback>
+      pending_requests;
+  pending_requests.swap(pending_get_ports_requests_);
   port_manager_.reset();
   client_receiver_.reset();
 
   port_info_.clear();
   ephemeral_ports_.clear();
+  is_initialized_ = false;
+
+  while (!pending_requests.empty()) {
+    std::move(pending_requests.front()).Run({});
+    pending_requests.pop();
+  }
 }
 }  // namespace electron
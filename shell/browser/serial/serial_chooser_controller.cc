@@ -75,7 +75,7 @@ SerialChooserController::SerialChooserController(
                          web_contents->GetBrowserContext())
                          ->AsWeakPtr();
   DCHECK(chooser_context_);
-  chooser_context_->GetPortManager()->GetDevices(base::BindOnce(
+  chooser_context_->GetPorts(base::BindOnce(
       &SerialChooserController::OnGetDevices, weak_factory_.GetWeakPtr()));
   observation_.Observe(chooser_context_.get());
 }
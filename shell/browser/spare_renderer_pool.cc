@@ -0,0 +1,148 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/spare_renderer_pool.h"
+
+#include <utility>
+
+#include "base/functional/bind.h"
+#include "base/task/sequenced_task_runner.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/web_contents.h"
+#include "shell/browser/javascript_environment.h"
+#include "shell/browser/web_contents_preferences.h"
+#include "shell/common/gin_helper/dictionary.h"
+
+namespace electron {
+
+SpareRendererPool::Group::Group() = default;
+
+SpareRendererPool::Group::~Group() = default;
+
+SpareRendererPool::SpareRendererPool(content::BrowserContext* browser_context)
+    : browser_context_(browser_context) {}
+
+SpareRendererPool::~SpareRendererPool() = default;
+
+void SpareRendererPool::SetSpareCount(
+    v8::Isolate* isolate,
+    const gin_helper::Dictionary& web_preferences,
+    size_t count) {
+  v8::HandleScope scope(isolate);
+  Group* group = FindGroup(isolate, web_preferences);
+  if (!group) {
+    if (count == 0)
+      return;
+    // The first spare of a new group is also what tells its switches.
+    auto spare = CreateWebContents(web_preferences);
+    auto new_group = std::make_unique<Group>();
+    new_group->switches = WebContentsPreferences::From(spare.get())
+                              ->GetMainFrameProcessSwitches();
+    Launch(spare.get());
+    new_group->spares.push_back(std::move(spare));
+    group = groups_.emplace_back(std::move(new_group)).get();
+  } else if (count == 0) {
+    std::erase_if(groups_, [group](const auto& g) { return g.get() == group; });
+    return;
+  }
+
+  group->web_preferences.Reset(isolate, web_preferences.GetHandle());
+  group->count = count;
+  if (group->spares.size() > count)
+    group->spares.resize(count);
+  else
+    Refill(isolate, group);
+}
+
+std::unique_ptr<content::WebContents> SpareRendererPool::Take(
+    v8::Isolate* isolate,
+    const gin_helper::Dictionary& web_preferences) {
+  v8::HandleScope scope(isolate);
+  for (auto& group : groups_) {
+    // A spare whose renderer has gone away is of no use to anyone.
+    std::erase_if(group->spares, [](const auto& web_contents) {
+      return !web_contents->GetPrimaryMainFrame()
+                  ->GetProcess()
+                  ->IsInitializedAndNotDead();
+    });
+    if (group->spares.empty() ||
+        !TryPreferences(isolate, group.get(), web_preferences))
+      continue;
+
+    // The renderer was launched with the spare's preferences, so record the
+    // ones it is adopted with instead.
+    WebContentsPreferences::From(group->spares.back().get())
+        ->SaveLastPreferences();
+    auto web_contents = std::move(group->spares.back());
+    group->spares.pop_back();
+    // Launch the replacement once the caller is done with its own renderer.
+    base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+        FROM_HERE, base::BindOnce(&SpareRendererPool::RefillAll,
+                                  weak_factory_.GetWeakPtr()));
+    return web_contents;
+  }
+  return nullptr;
+}
+
+SpareRendererPool::Group* SpareRendererPool::FindGroup(
+    v8::Isolate* isolate,
+    const gin_helper::Dictionary& web_preferences) {
+  // The preferences are tried on a spare of each group, so that finding out
+  // their switches doesn't take a WebContents of its own.
+  for (auto& group : groups_) {
+    // Spares that were taken may not have been replaced yet.
+    Refill(isolate, group.get());
+    if (TryPreferences(isolate, group.get(), web_preferences))
+      return group.get();
+  }
+  return nullptr;
+}
+
+bool SpareRendererPool::TryPreferences(
+    v8::Isolate* isolate,
+    Group* group,
+    const gin_helper::Dictionary& web_preferences) {
+  auto* prefs = WebContentsPreferences::From(group->spares.back().get());
+  prefs->SetFromDictionary(web_preferences);
+  if (prefs->GetMainFrameProcessSwitches() == group->switches)
+    return true;
+  prefs->SetFromDictionary(
+      gin_helper::Dictionary(isolate, group->web_preferences.Get(isolate)));
+  return false;
+}
+
+std::unique_ptr<content::WebContents> SpareRendererPool::CreateWebContents(
+    const gin_helper::Dictionary& web_preferences) {
+  content::WebContents::CreateParams params(browser_context_);
+  params.initially_hidden = true;
+  auto web_contents = content::WebContents::Create(params);
+  // The WebContents owns its preferences, and they are what
+  // ElectronBrowserClient reads the renderer's switches from.
+  new WebContentsPreferences(web_contents.get(), web_preferences);
+  return web_contents;
+}
+
+void SpareRendererPool::Launch(content::WebContents* web_contents) {
+  web_contents->GetPrimaryMainFrame()->GetProcess()->Init();
+}
+
+void SpareRendererPool::Refill(v8::Isolate* isolate, Group* group) {
+  v8::HandleScope scope(isolate);
+  gin_helper::Dictionary web_preferences(isolate,
+                                         group->web_preferences.Get(isolate));
+  while (group->spares.size() < group->count) {
+    auto web_contents = CreateWebContents(web_preferences);
+    Launch(web_contents.get());
+    group->spares.push_back(std::move(web_contents));
+  }
+}
+
+void SpareRendererPool::RefillAll() {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  for (auto& group : groups_)
+    Refill(isolate, group.get());
+}
+
+}  // namespace electron
@@ -0,0 +1,89 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_SPARE_RENDERER_POOL_H_
+#define ELECTRON_SHELL_BROWSER_SPARE_RENDERER_POOL_H_
+
+#include <memory>
+#include <vector>
+
+#include "base/command_line.h"
+#include "base/memory/raw_ptr.h"
+#include "base/memory/weak_ptr.h"
+#include "v8/include/v8-forward.h"
+#include "v8/include/v8-persistent-handle.h"
+
+namespace content {
+class BrowserContext;
+class WebContents;
+}  // namespace content
+
+namespace gin_helper {
+class Dictionary;
+}
+
+namespace electron {
+
+// Keeps hidden WebContents whose renderer process has already been launched
+// and initialized, so that a new WebContents with matching preferences can
+// adopt one instead of waiting for a renderer to start. Spares are grouped by
+// the process switches their preferences need, since those can not change
+// after launch. Each ElectronBrowserContext owns one pool.
+class SpareRendererPool {
+ public:
+  explicit SpareRendererPool(content::BrowserContext* browser_context);
+  ~SpareRendererPool();
+
+  // disable copy
+  SpareRendererPool(const SpareRendererPool&) = delete;
+  SpareRendererPool& operator=(const SpareRendererPool&) = delete;
+
+  // Keeps |count| spares launched for |web_preferences|, replacing each one
+  // that is taken. A |count| of 0 drops the spares kept for them.
+  void SetSpareCount(v8::Isolate* isolate,
+                     const gin_helper::Dictionary& web_preferences,
+                     size_t count);
+
+  // Returns a spare with |web_preferences| applied if one was launched with
+  // the switches they need, or nullptr.
+  std::unique_ptr<content::WebContents> Take(
+      v8::Isolate* isolate,
+      const gin_helper::Dictionary& web_preferences);
+
+ private:
+  struct Group {
+    Group();
+    ~Group();
+
+    base::CommandLine::StringVector switches;
+    v8::Global<v8::Object> web_preferences;
+    size_t count = 0;
+    std::vector<std::unique_ptr<content::WebContents>> spares;
+  };
+
+  // Returns the group whose renderers are launched with the switches that
+  // |web_preferences| need, or nullptr.
+  Group* FindGroup(v8::Isolate* isolate,
+                   const gin_helper::Dictionary& web_preferences);
+  // Applies |web_preferences| to the last spare of |group| and returns whether
+  // its renderer was launched with the switches they need. If not, the spare
+  // gets its own preferences back.
+  bool TryPreferences(v8::Isolate* isolate,
+                      Group* group,
+                      const gin_helper::Dictionary& web_preferences);
+  std::unique_ptr<content::WebContents> CreateWebContents(
+      const gin_helper::Dictionary& web_preferences);
+  void Launch(content::WebContents* web_contents);
+  void Refill(v8::Isolate* isolate, Group* group);
+  void RefillAll();
+
+  raw_ptr<content::BrowserContext> browser_context_;
+  std::vector<std::unique_ptr<Group>> groups_;
+
+  base::WeakPtrFactory<SpareRendererPool> weak_factory_{this};
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_SPARE_RENDERER_POOL_H_
@@ -0,0 +1,159 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/spare_utility_process_pool.h"
+
+#include <utility>
+
+#include "base/functional/bind.h"
+#include "base/no_destructor.h"
+#include "base/ranges/algorithm.h"
+#include "base/task/single_thread_task_runner.h"
+#include "build/build_config.h"
+#include "content/public/browser/service_process_host.h"
+
+#if BUILDFLAG(IS_WIN)
+#include <windows.h>
+#elif BUILDFLAG(IS_MAC)
+#include <crt_externs.h>
+#else
+extern char** environ;
+#endif
+
+namespace electron {
+
+namespace {
+
+// The environment that a process launched now inherits.
+base::NativeEnvironmentString GetCurrentEnvironment() {
+  base::NativeEnvironmentString environment;
+#if BUILDFLAG(IS_WIN)
+  wchar_t* strings = ::GetEnvironmentStringsW();
+  if (!strings)
+    return environment;
+  for (const wchar_t* entry = strings; *entry; entry += wcslen(entry) + 1) {
+    environment.append(entry);
+    environment.push_back(L'\0');
+  }
+  ::FreeEnvironmentStringsW(strings);
+#else
+#if BUILDFLAG(IS_MAC)
+  char** entries = *_NSGetEnviron();
+#else
+  char** entries = environ;
+#endif
+  for (char** entry = entries; entry && *entry; ++entry) {
+    environment.append(*entry);
+    environment.push_back('\0');
+  }
+#endif
+  return environment;
+}
+
+}  // namespace
+
+SpareUtilityProcess::SpareUtilityProcess() = default;
+
+SpareUtilityProcess::~SpareUtilityProcess() = default;
+
+// static
+SpareUtilityProcessPool* SpareUtilityProcessPool::GetInstance() {
+  static base::NoDestructor<SpareUtilityProcessPool> instance;
+  return instance.get();
+}
+
+SpareUtilityProcessPool::SpareUtilityProcessPool() = default;
+
+SpareUtilityProcessPool::~SpareUtilityProcessPool() = default;
+
+void SpareUtilityProcessPool::SetSpareCount(size_t count) {
+  count_ = count;
+  if (spares_.size() > count_)
+    spares_.resize(count_);
+  Refill();
+}
+
+void SpareUtilityProcessPool::Clear() {
+  count_ = 0;
+  spares_.clear();
+  weak_factory_.InvalidateWeakPtrs();
+}
+
+std::unique_ptr<SpareUtilityProcess> SpareUtilityProcessPool::Take() {
+  // A process launched now would inherit changes the app made to its
+  // environment since the spares were launched, so they are replaced rather
+  // than handed out.
+  const base::NativeEnvironmentString environment = GetCurrentEnvironment();
+  if (std::erase_if(spares_, [&environment](const auto& spare) {
+        return spare->environment != environment;
+      })) {
+    base::SingleThreadTaskRunner::GetCurrentDefault()->PostTask(
+        FROM_HERE, base::BindOnce(&SpareUtilityProcessPool::Refill,
+                                  weak_factory_.GetWeakPtr()));
+    return nullptr;
+  }
+
+  auto it = base::ranges::find_if(
+      spares_, [](const auto& spare) { return spare->process.IsValid(); });
+  if (it == spares_.end())
+    return nullptr;
+
+  std::unique_ptr<SpareUtilityProcess> spare = std::move(*it);
+  spares_.erase(it);
+  // Launching the replacement competes with the process that is about to
+  // start running its entry script, so leave it until the current task ends.
+  base::SingleThreadTaskRunner::GetCurrentDefault()->PostTask(
+      FROM_HERE, base::BindOnce(&SpareUtilityProcessPool::Refill,
+                                weak_factory_.GetWeakPtr()));
+  return spare;
+}
+
+void SpareUtilityProcessPool::Launch() {
+  auto spare = std::make_unique<SpareUtilityProcess>();
+  spare->id = next_id_++;
+  spare->environment = GetCurrentEnvironment();
+  content::ServiceProcessHost::Launch(
+      spare->node_service.BindNewPipeAndPassReceiver(),
+      content::ServiceProcessHost::Options()
+          .WithDisplayName(u"Node Utility Process")
+          .WithProcessCallback(
+              base::BindOnce(&SpareUtilityProcessPool::OnProcessLaunched,
+                             weak_factory_.GetWeakPtr(), spare->id))
+          .Pass());
+  spare->node_service.set_disconnect_with_reason_handler(
+      base::BindOnce(&SpareUtilityProcessPool::OnProcessDisconnected,
+                     weak_factory_.GetWeakPtr(), spare->id));
+  spare->node_service->WarmUp();
+  spares_.push_back(std::move(spare));
+}
+
+void SpareUtilityProcessPool::Refill() {
+  while (spares_.size() < count_)
+    Launch();
+}
+
+void SpareUtilityProcessPool::OnProcessLaunched(uint64_t id,
+                                                const base::Process& process) {
+  // The spare is gone when the pool shrank before it finished launching.
+  auto it = base::ranges::find(spares_, id, &SpareUtilityProcess::id);
+  if (it != spares_.end())
+    (*it)->process = process.Duplicate();
+}
+
+void SpareUtilityProcessPool::OnProcessDisconnected(
+    uint64_t id,
+    uint32_t error_code,
+    const std::string& description) {
+  auto it = base::ranges::find(spares_, id, &SpareUtilityProcess::id);
+  if (it == spares_.end())
+    return;
+  // A spare that failed to launch would most likely fail again, so only
+  // replace the ones that went away after starting.
+  bool launched = (*it)->process.IsValid();
+  spares_.erase(it);
+  if (launched)
+    Refill();
+}
+
+}  // namespace electron
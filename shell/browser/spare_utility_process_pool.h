@@ -0,0 +1,78 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_SPARE_UTILITY_PROCESS_POOL_H_
+#define ELECTRON_SHELL_BROWSER_SPARE_UTILITY_PROCESS_POOL_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/environment.h"
+#include "base/memory/weak_ptr.h"
+#include "base/process/process.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "shell/services/node/public/mojom/node_service.mojom.h"
+
+namespace electron {
+
+// A utility process that was launched with the default options and has set up
+// V8 and Node.js, but has not been given an entry script yet.
+struct SpareUtilityProcess {
+  SpareUtilityProcess();
+  ~SpareUtilityProcess();
+
+  // Identifies the spare to the callbacks of its launch, which can outlive
+  // it.
+  uint64_t id = 0;
+  mojo::Remote<node::mojom::NodeService> node_service;
+  base::Process process;
+  // The environment of the browser process when the spare was launched,
+  // which it inherited.
+  base::NativeEnvironmentString environment;
+};
+
+// Keeps spare utility processes so that utilityProcess.fork() only has to
+// create the Node.js environment and run the entry script, instead of waiting
+// for a process to launch. There is only a single instance in the browser
+// process.
+class SpareUtilityProcessPool {
+ public:
+  static SpareUtilityProcessPool* GetInstance();
+
+  SpareUtilityProcessPool();
+  ~SpareUtilityProcessPool();
+
+  // disable copy
+  SpareUtilityProcessPool(const SpareUtilityProcessPool&) = delete;
+  SpareUtilityProcessPool& operator=(const SpareUtilityProcessPool&) = delete;
+
+  // Keeps |count| spares launched, replacing each one that is taken.
+  void SetSpareCount(size_t count);
+
+  // Terminates every spare and stops launching new ones.
+  void Clear();
+
+  // Returns a spare that has finished launching with the current environment
+  // of the browser process, or nullptr.
+  std::unique_ptr<SpareUtilityProcess> Take();
+
+ private:
+  void Launch();
+  void Refill();
+  void OnProcessLaunched(uint64_t id, const base::Process& process);
+  void OnProcessDisconnected(uint64_t id,
+                             uint32_t error_code,
+                             const std::string& description);
+
+  size_t count_ = 0;
+  uint64_t next_id_ = 1;
+  std::vector<std::unique_ptr<SpareUtilityProcess>> spares_;
+
+  base::WeakPtrFactory<SpareUtilityProcessPool> weak_factory_{this};
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_SPARE_UTILITY_PROCESS_POOL_H_
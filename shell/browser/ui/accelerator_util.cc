@@ -9,7 +9,9 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/lru_cache.h"
 #include "base/logging.h"
+#include "base/no_destructor.h"
 #include "base/stl_util.h"
 #include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
@@ -17,8 +19,26 @@
 
 namespace accelerator_util {
 
+namespace {
+
+constexpr size_t kMaxCachedAccelerators = 1024;
+
+using AcceleratorCache = base::HashingLRUCache<std::string, ui::Accelerator>;
+AcceleratorCache& GetAcceleratorCache() {
+  static base::NoDestructor<AcceleratorCache> cache(kMaxCachedAccelerators);
+  return *cache;
+}
+
+}  // namespace
+
 bool StringToAccelerator(const std::string& shortcut,
                          ui::Accelerator* accelerator) {
+  auto& cache = GetAcceleratorCache();
+  if (auto iter = cache.Get(shortcut); iter != cache.end()) {
+    *accelerator = iter->second;
+    return true;
+  }
+
   if (!base::IsStringASCII(shortcut)) {
     LOG(ERROR) << "The accelerator string can only contain ASCII characters, "
                   "invalid string: "
@@ -68,6 +88,7 @@ bool StringToAccelerator(const std::string& shortcut,
 
   *accelerator = ui::Accelerator(key, modifiers);
   accelerator->shifted_char = shifted_char;
+  cache.Put(shortcut, *accelerator);
   return true;
 }
 
@@ -5,9 +5,10 @@
 #ifndef ELECTRON_SHELL_BROWSER_UI_ACCELERATOR_UTIL_H_
 #define ELECTRON_SHELL_BROWSER_UI_ACCELERATOR_UTIL_H_
 
-#include <map>
 #include <string>
+#include <unordered_map>
 
+#include "base/hash/hash.h"
 #include "base/memory/raw_ptr.h"
 #include "shell/browser/ui/electron_menu_model.h"
 #include "ui/base/accelerators/accelerator.h"
@@ -18,9 +19,20 @@ typedef struct {
   size_t position;
   raw_ptr<electron::ElectronMenuModel> model;
 } MenuItem;
-typedef std::map<ui::Accelerator, MenuItem> AcceleratorTable;
-
-// Parse a string as an accelerator.
+// Hashes the fields that ui::Accelerator's operator== compares.
+struct AcceleratorHash {
+  size_t operator()(const ui::Accelerator& accelerator) const {
+    return base::HashInts(
+        static_cast<int>(accelerator.key_code()),
+        ui::Accelerator::MaskOutKeyEventFlags(accelerator.modifiers()));
+  }
+};
+typedef std::unordered_map<ui::Accelerator, MenuItem, AcceleratorHash>
+    AcceleratorTable;
+
+// Parse a string as an accelerator. The accelerators that were parsed
+// successfully are cached, as menus convert the accelerators of all of their
+// items every time they are built. Must be called on the UI thread.
 bool StringToAccelerator(const std::string& shortcut,
                          ui::Accelerator* accelerator);
 
@@ -27,4 +27,23 @@ TEST(AcceleratorUtilTest, StringToAccelerator) {
   }
 }
 
+TEST(AcceleratorUtilTest, StringToAcceleratorCachesParsedAccelerators) {
+  ui::Accelerator first;
+  ASSERT_TRUE(StringToAccelerator("Ctrl+Shift+K", &first));
+  ui::Accelerator second;
+  ASSERT_TRUE(StringToAccelerator("Ctrl+Shift+K", &second));
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(first.shifted_char, second.shifted_char);
+
+  ui::Accelerator shifted;
+  ASSERT_TRUE(StringToAccelerator("Shift+1", &shifted));
+  ui::Accelerator shifted_again;
+  ASSERT_TRUE(StringToAccelerator("Shift+1", &shifted_again));
+  EXPECT_EQ(shifted.shifted_char, shifted_again.shifted_char);
+
+  ui::Accelerator invalid;
+  EXPECT_FALSE(StringToAccelerator("CmdOrCtrl", &invalid));
+  EXPECT_FALSE(StringToAccelerator("CmdOrCtrl", &invalid));
+}
+
 }  // namespace accelerator_util
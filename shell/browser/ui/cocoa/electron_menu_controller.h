@@ -28,6 +28,9 @@ class ElectronMenuModel;
   NSMenu* __strong menu_;
   NSMenuItem* __strong recentDocumentsMenuItem_;
   NSMenu* __strong recentDocumentsMenuSwap_;
+  // Submenus whose items are added the first time they are about to be
+  // shown, mapped to their models.
+  NSMapTable* __strong lazySubmenus_;
   BOOL isMenuOpen_;
   BOOL useDefaultAccelerator_;
   base::OnceClosure closeCallback;
@@ -123,6 +123,8 @@ NSArray* ConvertSharingItemToNS(const SharingItem& item) {
 + (electron::ElectronMenuModel*)getFrom:(id)instance;
 - (instancetype)initWithModel:(electron::ElectronMenuModel*)model;
 - (electron::ElectronMenuModel*)menuModel;
+// The change generation of the model the menu item was last updated at.
+@property(nonatomic) uint64_t generation;
 @end
 
 @implementation WeakPtrToElectronMenuModelAsNSObject {
@@ -141,6 +143,7 @@ NSArray* ConvertSharingItemToNS(const SharingItem& item) {
 - (instancetype)initWithModel:(electron::ElectronMenuModel*)model {
   if ((self = [super init])) {
     _model = model->GetWeakPtr();
+    _generation = model->change_generation();
   }
   return self;
 }
@@ -240,6 +243,19 @@ NSArray* ConvertSharingItemToNS(const SharingItem& item) {
   return menu;
 }
 
+// Creates an empty NSMenu which gets the items of |model| the first time it is
+// about to be shown, see menuNeedsUpdate:.
+- (NSMenu*)lazyMenuFromModel:(electron::ElectronMenuModel*)model {
+  NSMenu* menu = [[NSMenu alloc] initWithTitle:@""];
+  if (!lazySubmenus_)
+    lazySubmenus_ = [NSMapTable weakToStrongObjectsMapTable];
+  [lazySubmenus_ setObject:[WeakPtrToElectronMenuModelAsNSObject
+                               weakPtrForModel:model]
+                    forKey:menu];
+  [menu setDelegate:self];
+  return menu;
+}
+
 // Adds a separator item at the given index. As the separator doesn't need
 // anything from the model, this method doesn't need the model index as the
 // other method below does.
@@ -357,9 +373,14 @@ NSArray* ConvertSharingItemToNS(const SharingItem& item) {
     electron::ElectronMenuModel* submenuModel =
         static_cast<electron::ElectronMenuModel*>(
             model->GetSubmenuModelAt(index));
-    NSMenu* submenu = MenuHasVisibleItems(submenuModel)
-                          ? [self menuFromModel:submenuModel]
-                          : MakeEmptySubmenu();
+    NSMenu* submenu;
+    if (submenuModel->needs_populate()) {
+      submenu = [self lazyMenuFromModel:submenuModel];
+    } else {
+      submenu = MenuHasVisibleItems(submenuModel)
+                    ? [self menuFromModel:submenuModel]
+                    : MakeEmptySubmenu();
+    }
     [submenu setTitle:[item title]];
     [item setSubmenu:submenu];
 
@@ -448,13 +469,24 @@ NSArray* ConvertSharingItemToNS(const SharingItem& item) {
     return NO;
 
   NSInteger modelIndex = [item tag];
-  electron::ElectronMenuModel* model = [WeakPtrToElectronMenuModelAsNSObject
-      getFrom:[(id)item representedObject]];
+  WeakPtrToElectronMenuModelAsNSObject* modelRef =
+      base::apple::ObjCCastStrict<WeakPtrToElectronMenuModelAsNSObject>(
+          [(id)item representedObject]);
+  electron::ElectronMenuModel* model = [modelRef menuModel];
   DCHECK(model);
   if (model) {
     BOOL checked = model->IsItemCheckedAt(modelIndex);
     DCHECK([(id)item isKindOfClass:[NSMenuItem class]]);
 
+    // Only items that changed since they were built need their text updated.
+    if (model->IsItemChangedSinceAt(modelIndex, [modelRef generation])) {
+      [(id)item setTitle:l10n_util::FixUpWindowsStyleLabel(
+                             model->GetLabelAt(modelIndex))];
+      [(id)item setToolTip:base::SysUTF16ToNSString(
+                               model->GetToolTipAt(modelIndex))];
+      [modelRef setGeneration:model->change_generation()];
+    }
+
     [(id)item
         setState:(checked ? NSControlStateValueOn : NSControlStateValueOff)];
     [(id)item setHidden:(!model->IsVisibleAt(modelIndex))];
@@ -509,14 +541,44 @@ NSArray* ConvertSharingItemToNS(const SharingItem& item) {
   return isMenuOpen_;
 }
 
+// Called before a menu is shown. Submenus whose items are added on demand get
+// them here, once; they are kept afterwards.
+- (void)menuNeedsUpdate:(NSMenu*)menu {
+  WeakPtrToElectronMenuModelAsNSObject* modelRef =
+      [lazySubmenus_ objectForKey:menu];
+  if (!modelRef)
+    return;
+  [lazySubmenus_ removeObjectForKey:menu];
+  [menu setDelegate:nil];
+
+  electron::ElectronMenuModel* model = [modelRef menuModel];
+  if (!model)
+    return;
+  model->PopulateIfNeeded();
+  if (!MenuHasVisibleItems(model)) {
+    [self moveMenuItems:MakeEmptySubmenu() to:menu];
+    return;
+  }
+
+  const int count = model->GetItemCount();
+  for (int index = 0; index < count; index++) {
+    if (model->GetTypeAt(index) == electron::ElectronMenuModel::TYPE_SEPARATOR)
+      [self addSeparatorToMenu:menu atIndex:index];
+    else
+      [self addItemToMenu:menu atIndex:index fromModel:model];
+  }
+}
+
 - (void)menuWillOpen:(NSMenu*)menu {
+  if (menu != menu_)
+    return;
   isMenuOpen_ = YES;
   if (model_)
     model_->MenuWillShow();
 }
 
 - (void)menuDidClose:(NSMenu*)menu {
-  if (isMenuOpen_) {
+  if (menu == menu_ && isMenuOpen_) {
     isMenuOpen_ = NO;
     if (model_)
       model_->MenuWillClose();
@@ -51,17 +51,30 @@ void DragFileItems(const std::vector<base::FilePath>& files,
                               options:NSAlignAllEdgesOutward]
           .origin;
 
-  NSMutableArray* file_items = [NSMutableArray array];
+  // Every item shows the same image, so it is converted once, and handed to
+  // AppKit through a provider that is only called for the items it draws.
+  NSImage* file_image = icon.ToNSImage();
+  NSSize image_size = file_image.size;
+  NSRect image_rect = NSMakeRect(current_position.x - image_size.width / 2,
+                                 current_position.y - image_size.height / 2,
+                                 image_size.width, image_size.height);
+  NSDraggingImageComponent* image_component = [NSDraggingImageComponent
+      draggingImageComponentWithKey:NSDraggingImageComponentIconKey];
+  image_component.contents = file_image;
+  image_component.frame =
+      NSMakeRect(0, 0, image_size.width, image_size.height);
+  NSArray<NSDraggingImageComponent*>* image_components = @[ image_component ];
+  NSArray<NSDraggingImageComponent*>* (^image_components_provider)(void) = ^{
+    return image_components;
+  };
+
+  NSMutableArray* file_items = [NSMutableArray arrayWithCapacity:files.size()];
   for (auto const& file : files) {
     NSURL* file_url = base::apple::FilePathToNSURL(file);
     NSDraggingItem* file_item =
         [[NSDraggingItem alloc] initWithPasteboardWriter:file_url];
-    NSImage* file_image = icon.ToNSImage();
-    NSSize image_size = file_image.size;
-    NSRect image_rect = NSMakeRect(current_position.x - image_size.width / 2,
-                                   current_position.y - image_size.height / 2,
-                                   image_size.width, image_size.height);
-    [file_item setDraggingFrame:image_rect contents:file_image];
+    file_item.draggingFrame = image_rect;
+    file_item.imageComponentsProvider = image_components_provider;
     [file_items addObject:file_item];
   }
 
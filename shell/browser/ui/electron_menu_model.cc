@@ -27,10 +27,43 @@ ElectronMenuModel::ElectronMenuModel(Delegate* delegate)
 
 ElectronMenuModel::~ElectronMenuModel() = default;
 
+void ElectronMenuModel::SetLabelAt(size_t index,
+                                   const std::u16string& label) {
+  SetLabel(index, label);
+  MarkItemChangedAt(index);
+}
+
+void ElectronMenuModel::MarkItemChangedAt(size_t index) {
+  changes_[GetCommandIdAt(index)] = ++change_generation_;
+}
+
+bool ElectronMenuModel::IsItemChangedSinceAt(size_t index,
+                                             uint64_t generation) const {
+  const auto iter = changes_.find(GetCommandIdAt(index));
+  return iter != std::end(changes_) && iter->second > generation;
+}
+
+void ElectronMenuModel::PopulateIfNeeded() {
+  if (!needs_populate_)
+    return;
+  needs_populate_ = false;
+  if (delegate_)
+    delegate_->PopulateMenu();
+}
+
+void ElectronMenuModel::PopulateAllIfNeeded() {
+  PopulateIfNeeded();
+  for (size_t i = 0; i < GetItemCount(); ++i) {
+    if (GetTypeAt(i) == TYPE_SUBMENU)
+      GetSubmenuModelAt(i)->PopulateAllIfNeeded();
+  }
+}
+
 void ElectronMenuModel::SetToolTip(size_t index,
                                    const std::u16string& toolTip) {
   int command_id = GetCommandIdAt(index);
   toolTips_[command_id] = toolTip;
+  MarkItemChangedAt(index);
 }
 
 std::u16string ElectronMenuModel::GetToolTipAt(size_t index) {
@@ -54,6 +87,7 @@ void ElectronMenuModel::SetSecondaryLabel(size_t index,
                                           const std::u16string& sublabel) {
   int command_id = GetCommandIdAt(index);
   sublabels_[command_id] = sublabel;
+  MarkItemChangedAt(index);
 }
 
 std::u16string ElectronMenuModel::GetSecondaryLabelAt(size_t index) const {
@@ -109,6 +143,7 @@ void ElectronMenuModel::MenuWillClose() {
 }
 
 void ElectronMenuModel::MenuWillShow() {
+  PopulateIfNeeded();
   ui::SimpleMenuModel::MenuWillShow();
   for (Observer& observer : observers_) {
     observer.OnMenuWillShow();
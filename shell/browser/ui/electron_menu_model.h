@@ -49,6 +49,9 @@ class ElectronMenuModel : public ui::SimpleMenuModel {
 
     virtual bool ShouldCommandIdWorkWhenHidden(int command_id) const = 0;
 
+    // Adds the items of a menu whose items are added on demand.
+    virtual void PopulateMenu() {}
+
 #if BUILDFLAG(IS_MAC)
     virtual bool GetSharingItemForCommandId(int command_id,
                                             SharingItem* item) const = 0;
@@ -82,6 +85,30 @@ class ElectronMenuModel : public ui::SimpleMenuModel {
   void AddObserver(Observer* obs) { observers_.AddObserver(obs); }
   void RemoveObserver(Observer* obs) { observers_.RemoveObserver(obs); }
 
+  // Sets the label of an item that native menus may already show.
+  void SetLabelAt(size_t index, const std::u16string& label);
+  // Records that the item at |index| changed, so that native menus built
+  // from this model update just that item instead of being rebuilt.
+  void MarkItemChangedAt(size_t index);
+  // Returns whether the item at |index| changed after |generation|, which is
+  // the change_generation() a native menu item was last updated at.
+  bool IsItemChangedSinceAt(size_t index, uint64_t generation) const;
+  [[nodiscard]] uint64_t change_generation() const {
+    return change_generation_;
+  }
+
+  // Whether the items of the model are only added once it is about to be
+  // shown, so that menus the user never opens cost nothing to build.
+  void set_needs_populate(bool needs_populate) {
+    needs_populate_ = needs_populate;
+  }
+  [[nodiscard]] bool needs_populate() const { return needs_populate_; }
+  // Adds the items of the model when they haven't been yet.
+  void PopulateIfNeeded();
+  // Adds the items of the model and of all its submenus, for native menus
+  // that are built all at once before any of them is shown.
+  void PopulateAllIfNeeded();
+
   void SetToolTip(size_t index, const std::u16string& toolTip);
   std::u16string GetToolTipAt(size_t index);
   void SetRole(size_t index, const std::u16string& role);
@@ -125,6 +152,9 @@ class ElectronMenuModel : public ui::SimpleMenuModel {
   base::flat_map<int, std::u16string> toolTips_;   // command id -> tooltip
   base::flat_map<int, std::u16string> roles_;      // command id -> role
   base::flat_map<int, std::u16string> sublabels_;  // command id -> sublabel
+  base::flat_map<int, uint64_t> changes_;  // command id -> change generation
+  uint64_t change_generation_ = 0;
+  bool needs_populate_ = false;
   base::ObserverList<Observer> observers_;
 
   base::WeakPtrFactory<ElectronMenuModel> weak_factory_{this};
@@ -302,10 +302,13 @@ class InspectableWebContents::NetworkResourceLoader
 
 // static
 void InspectableWebContents::RegisterPrefs(PrefRegistrySimple* registry) {
+  // DevTools changes these often, so they are written in batches.
   registry->RegisterDictionaryPref(kDevToolsBoundsPref,
-                                   RectToDictionary(gfx::Rect{0, 0, 800, 600}));
-  registry->RegisterDoublePref(kDevToolsZoomPref, 0.);
-  registry->RegisterDictionaryPref(kDevToolsPreferences);
+                                   RectToDictionary(gfx::Rect{0, 0, 800, 600}),
+                                   PrefRegistry::LOSSY_PREF);
+  registry->RegisterDoublePref(kDevToolsZoomPref, 0., PrefRegistry::LOSSY_PREF);
+  registry->RegisterDictionaryPref(kDevToolsPreferences,
+                                   PrefRegistry::LOSSY_PREF);
 }
 
 InspectableWebContents::InspectableWebContents(
@@ -684,10 +687,8 @@ void InspectableWebContents::LoadNetworkResource(DispatchCallback callback,
         std::make_unique<network::WrapperPendingSharedURLLoaderFactory>(
             std::move(pending_remote)));
   } else if (protocol_registry->IsProtocolRegistered(gurl.scheme())) {
-    auto& protocol_handler = protocol_registry->handlers().at(gurl.scheme());
     mojo::PendingRemote<network::mojom::URLLoaderFactory> pending_remote =
-        ElectronURLLoaderFactory::Create(protocol_handler.first,
-                                         protocol_handler.second);
+        protocol_registry->CreateURLLoaderFactoryForProtocol(gurl.scheme());
     url_loader_factory = network::SharedURLLoaderFactory::Create(
         std::make_unique<network::WrapperPendingSharedURLLoaderFactory>(
             std::move(pending_remote)));
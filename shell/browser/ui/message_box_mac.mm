@@ -141,12 +141,19 @@ void ShowMessageBox(const MessageBoxSettings& settings,
                     MessageBoxCallback callback) {
   NSAlert* alert = CreateNSAlert(settings);
 
-  // Use runModal for synchronous alert without parent, since we don't have a
-  // window to wait for.
+  // Use runModal for alert without parent, since we don't have a window to
+  // wait for. It runs in a task of its own, so that the caller doesn't wait
+  // for the alert to be closed, as the tasks of the UI thread keep running in
+  // the modal run loop.
   if (!settings.parent_window) {
-    int ret = [alert runModal];
-    std::move(callback).Run(
-        ret, alert.suppressionButton.state == NSControlStateValueOn);
+    __block MessageBoxCallback callback_ = std::move(callback);
+    content::GetUIThreadTaskRunner({})->PostTask(
+        FROM_HERE, base::BindOnce(^{
+          int ret = [alert runModal];
+          bool suppressed =
+              alert.suppressionButton.state == NSControlStateValueOn;
+          std::move(callback_).Run(ret, suppressed);
+        }));
   } else {
     if (settings.id) {
       if (base::Contains(GetDialogsMap(), *settings.id))
@@ -161,18 +161,55 @@ void SetMenuItemID(DbusmenuMenuitem* item, int id) {
   g_object_set_data(G_OBJECT(item), "menu-id", GINT_TO_POINTER(id + 1));
 }
 
-std::string GetMenuModelStatus(ElectronMenuModel* model) {
+// Describes the items of |model| that can't be changed in place, a submenu is
+// only rebuilt when this changes.
+std::string GetMenuModelStructure(ElectronMenuModel* model) {
   std::string ret;
   for (size_t i = 0; i < model->GetItemCount(); ++i) {
-    int status = model->GetTypeAt(i) | (model->IsVisibleAt(i) << 3) |
-                 (model->IsEnabledAt(i) << 4) |
-                 (model->IsItemCheckedAt(i) << 5);
-    ret += base::StringPrintf(
-        "%s-%X\n", base::UTF16ToUTF8(model->GetLabelAt(i)).c_str(), status);
+    ret += base::StringPrintf("%d-%X\n", model->GetCommandIdAt(i),
+                              model->GetTypeAt(i));
   }
   return ret;
 }
 
+std::string GetMenuItemStatus(ElectronMenuModel* model, size_t index) {
+  int status = (model->IsVisibleAt(index) << 3) |
+               (model->IsEnabledAt(index) << 4) |
+               (model->IsItemCheckedAt(index) << 5);
+  return base::StringPrintf(
+      "%s-%X", base::UTF16ToUTF8(model->GetLabelAt(index)).c_str(), status);
+}
+
+// Sets the properties of |item| that can change after it is built, when they
+// differ from what was last set.
+void UpdateMenuItem(DbusmenuMenuitem* item,
+                    ElectronMenuModel* model,
+                    size_t index) {
+  std::string status = GetMenuItemStatus(model, index);
+  char* old = static_cast<char*>(g_object_get_data(G_OBJECT(item), "status"));
+  if (old && status == old)
+    return;
+  g_object_set_data_full(G_OBJECT(item), "status", g_strdup(status.c_str()),
+                         g_free);
+
+  menuitem_property_set_bool(item, kPropertyVisible,
+                             model->IsVisibleAt(index));
+
+  ElectronMenuModel::ItemType type = model->GetTypeAt(index);
+  if (type == ElectronMenuModel::TYPE_SEPARATOR)
+    return;
+
+  std::string label = ui::ConvertAcceleratorsFromWindowsStyle(
+      base::UTF16ToUTF8(model->GetLabelAt(index)));
+  menuitem_property_set(item, kPropertyLabel, label.c_str());
+  menuitem_property_set_bool(item, kPropertyEnabled, model->IsEnabledAt(index));
+  if (type == ElectronMenuModel::TYPE_CHECK ||
+      type == ElectronMenuModel::TYPE_RADIO) {
+    menuitem_property_set_int(item, kPropertyToggleState,
+                              model->IsItemCheckedAt(index));
+  }
+}
+
 }  // namespace
 
 GlobalMenuBarX11::GlobalMenuBarX11(NativeWindowViews* window)
@@ -242,17 +279,11 @@ void GlobalMenuBarX11::BuildMenuFromModel(ElectronMenuModel* model,
   };
   for (size_t i = 0; i < model->GetItemCount(); ++i) {
     DbusmenuMenuitem* item = menuitem_new();
-    menuitem_property_set_bool(item, kPropertyVisible, model->IsVisibleAt(i));
 
     ElectronMenuModel::ItemType type = model->GetTypeAt(i);
     if (type == ElectronMenuModel::TYPE_SEPARATOR) {
       menuitem_property_set(item, kPropertyType, kTypeSeparator);
     } else {
-      std::string label = ui::ConvertAcceleratorsFromWindowsStyle(
-          base::UTF16ToUTF8(model->GetLabelAt(i)));
-      menuitem_property_set(item, kPropertyLabel, label.c_str());
-      menuitem_property_set_bool(item, kPropertyEnabled, model->IsEnabledAt(i));
-
       g_object_set_data(G_OBJECT(item), "model", model);
       SetMenuItemID(item, i);
 
@@ -272,11 +303,10 @@ void GlobalMenuBarX11::BuildMenuFromModel(ElectronMenuModel* model,
                                 type == ElectronMenuModel::TYPE_CHECK
                                     ? kToggleCheck
                                     : kToggleRadio);
-          menuitem_property_set_int(item, kPropertyToggleState,
-                                    model->IsItemCheckedAt(i));
         }
       }
     }
+    UpdateMenuItem(item, model, i);
 
     menuitem_child_append(parent, item);
     g_object_unref(item);
@@ -328,15 +358,27 @@ void GlobalMenuBarX11::OnSubMenuShow(DbusmenuMenuitem* item) {
   if (!model || !GetMenuItemID(item, &id))
     return;
 
-  // Do not update menu if the submenu has not been changed.
-  std::string status = GetMenuModelStatus(model);
-  char* old = static_cast<char*>(g_object_get_data(G_OBJECT(item), "status"));
-  if (old && status == old)
+  // Submenus whose items are added on demand get them the first time they
+  // are opened. When the submenu still has the same items, only update the
+  // ones whose state changed rather than rebuilding all of them.
+  ElectronMenuModel* submenu = model->GetSubmenuModelAt(id);
+  submenu->PopulateIfNeeded();
+  std::string structure = GetMenuModelStructure(submenu);
+  char* old =
+      static_cast<char*>(g_object_get_data(G_OBJECT(item), "structure"));
+  if (old && structure == old) {
+    size_t index = 0;
+    for (GList* child = menuitem_get_children(item); child;
+         child = child->next, ++index) {
+      UpdateMenuItem(static_cast<DbusmenuMenuitem*>(child->data), submenu,
+                     index);
+    }
     return;
+  }
 
-  // Save the new status.
-  g_object_set_data_full(G_OBJECT(item), "status", g_strdup(status.c_str()),
-                         g_free);
+  // Save the new structure.
+  g_object_set_data_full(G_OBJECT(item), "structure",
+                         g_strdup(structure.c_str()), g_free);
 
   // Clear children.
   GList* children = menuitem_take_children(item);
@@ -344,7 +386,7 @@ void GlobalMenuBarX11::OnSubMenuShow(DbusmenuMenuitem* item) {
   g_list_free(children);
 
   // Build children.
-  BuildMenuFromModel(model->GetSubmenuModelAt(id), item);
+  BuildMenuFromModel(submenu, item);
 }
 
 }  // namespace electron
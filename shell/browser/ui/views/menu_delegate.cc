@@ -35,6 +35,9 @@ void MenuDelegate::RunMenu(ElectronMenuModel* model,
   }
 
   id_ = button->GetID();
+  // views builds every submenu before the menu is shown, so submenus whose
+  // items are added on demand can't wait until they are opened.
+  model->PopulateAllIfNeeded();
   adapter_ = std::make_unique<MenuModelAdapter>(model);
 
   auto item = std::make_unique<views::MenuItemView>(this);
@@ -0,0 +1,152 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/ui/x/x_window_occlusion_tracker.h"
+
+#include <vector>
+
+#include "base/containers/adapters.h"
+#include "base/functional/bind.h"
+#include "base/memory/raw_ptr.h"
+#include "base/no_destructor.h"
+#include "base/scoped_observation.h"
+#include "shell/browser/native_window.h"
+#include "shell/browser/native_window_observer.h"
+#include "third_party/skia/include/core/SkRegion.h"
+#include "ui/base/x/x11_util.h"
+#include "ui/gfx/geometry/skia_conversions.h"
+#include "ui/gfx/x/atom_cache.h"
+#include "ui/gfx/x/event.h"
+
+namespace electron {
+
+namespace {
+
+// Coalesces the updates of a window being dragged or resized.
+constexpr base::TimeDelta kUpdateDelay = base::Milliseconds(100);
+
+}  // namespace
+
+class XWindowOcclusionTracker::TrackedWindow : public NativeWindowObserver {
+ public:
+  TrackedWindow(XWindowOcclusionTracker* tracker, NativeWindow* window)
+      : tracker_(tracker), window_(window) {
+    observation_.Observe(window);
+  }
+
+  NativeWindow* window() const { return window_; }
+
+  void SetOccluded(bool occluded) {
+    if (occluded_ == occluded)
+      return;
+    occluded_ = occluded;
+    window_->NotifyWindowOcclusionChanged(occluded);
+  }
+
+  // NativeWindowObserver:
+  void OnWindowClosed() override { tracker_->Untrack(window_); }
+  // The page is shown again along with its window.
+  void OnWindowShow() override { Reset(); }
+  void OnWindowRestore() override { Reset(); }
+  void OnWindowHide() override { tracker_->ScheduleUpdate(); }
+  void OnWindowMinimize() override { tracker_->ScheduleUpdate(); }
+  void OnWindowResize() override { tracker_->ScheduleUpdate(); }
+  void OnWindowMove() override { tracker_->ScheduleUpdate(); }
+
+ private:
+  void Reset() {
+    occluded_ = false;
+    tracker_->ScheduleUpdate();
+  }
+
+  raw_ptr<XWindowOcclusionTracker> tracker_;
+  raw_ptr<NativeWindow> window_;
+  bool occluded_ = false;
+  base::ScopedObservation<NativeWindow, NativeWindowObserver> observation_{
+      this};
+};
+
+// static
+XWindowOcclusionTracker* XWindowOcclusionTracker::GetInstance() {
+  static base::NoDestructor<XWindowOcclusionTracker> instance;
+  return instance.get();
+}
+
+XWindowOcclusionTracker::XWindowOcclusionTracker() = default;
+
+XWindowOcclusionTracker::~XWindowOcclusionTracker() = default;
+
+void XWindowOcclusionTracker::Track(NativeWindow* window) {
+  if (windows_.empty()) {
+    // Raising and lowering windows changes the stacking order on the root.
+    auto* connection = x11::Connection::Get();
+    root_events_ = connection->ScopedSelectEvent(
+        ui::GetX11RootWindow(), x11::EventMask::PropertyChange);
+    connection->AddEventObserver(this);
+  }
+  windows_.try_emplace(window, std::make_unique<TrackedWindow>(this, window));
+}
+
+void XWindowOcclusionTracker::Untrack(NativeWindow* window) {
+  windows_.erase(window);
+  if (windows_.empty()) {
+    x11::Connection::Get()->RemoveEventObserver(this);
+    root_events_ = x11::ScopedEventSelector();
+    update_timer_.Stop();
+    return;
+  }
+  ScheduleUpdate();
+}
+
+void XWindowOcclusionTracker::ScheduleUpdate() {
+  if (update_timer_.IsRunning())
+    return;
+  update_timer_.Start(FROM_HERE, kUpdateDelay,
+                      base::BindOnce(&XWindowOcclusionTracker::Update,
+                                     base::Unretained(this)));
+}
+
+void XWindowOcclusionTracker::Update() {
+  std::vector<x11::Window> stacking;
+  if (!x11::Connection::Get()->GetArrayProperty(
+          ui::GetX11RootWindow(), x11::GetAtom("_NET_CLIENT_LIST_STACKING"),
+          &stacking))
+    return;
+
+  std::map<x11::Window, TrackedWindow*> tracked_windows;
+  for (const auto& [window, tracked_window] : windows_) {
+    tracked_windows.emplace(
+        static_cast<x11::Window>(window->GetAcceleratedWidget()),
+        tracked_window.get());
+  }
+
+  // The stacking order goes from the bottom to the top, so walk it backwards
+  // and collect the area covered by the windows seen so far.
+  SkRegion covered;
+  for (x11::Window x_window : base::Reversed(stacking)) {
+    auto it = tracked_windows.find(x_window);
+    if (it == tracked_windows.end())
+      continue;
+
+    // Hidden and minimized windows neither cover others nor need updating,
+    // as they are already hidden to their pages.
+    NativeWindow* window = it->second->window();
+    if (!window->IsVisible() || window->IsMinimized())
+      continue;
+
+    SkIRect bounds = gfx::RectToSkIRect(window->GetBounds());
+    it->second->SetOccluded(covered.contains(bounds));
+    if (!window->transparent() && window->GetOpacity() == 1.0)
+      covered.op(bounds, SkRegion::kUnion_Op);
+  }
+}
+
+void XWindowOcclusionTracker::OnEvent(const x11::Event& event) {
+  auto* property = event.As<x11::PropertyNotifyEvent>();
+  if (property && property->window == ui::GetX11RootWindow() &&
+      property->atom == x11::GetAtom("_NET_CLIENT_LIST_STACKING"))
+    ScheduleUpdate();
+}
+
+}  // namespace electron
@@ -0,0 +1,54 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_UI_X_X_WINDOW_OCCLUSION_TRACKER_H_
+#define ELECTRON_SHELL_BROWSER_UI_X_X_WINDOW_OCCLUSION_TRACKER_H_
+
+#include <map>
+#include <memory>
+
+#include "base/timer/timer.h"
+#include "ui/gfx/x/connection.h"
+#include "ui/gfx/x/event_observer.h"
+
+namespace electron {
+
+class NativeWindow;
+
+// Works out which windows are fully covered by other windows of the app
+// from the X stacking order, and lets them know when that changes. Windows
+// of other clients are not taken into account, as their bounds aren't
+// known, so a window is only ever reported occluded when it really is.
+class XWindowOcclusionTracker : public x11::EventObserver {
+ public:
+  static XWindowOcclusionTracker* GetInstance();
+
+  XWindowOcclusionTracker();
+  ~XWindowOcclusionTracker() override;
+
+  // disable copy
+  XWindowOcclusionTracker(const XWindowOcclusionTracker&) = delete;
+  XWindowOcclusionTracker& operator=(const XWindowOcclusionTracker&) = delete;
+
+  // Tracks |window| until it is closed.
+  void Track(NativeWindow* window);
+
+ private:
+  class TrackedWindow;
+
+  void Untrack(NativeWindow* window);
+  void ScheduleUpdate();
+  void Update();
+
+  // x11::EventObserver:
+  void OnEvent(const x11::Event& event) override;
+
+  std::map<NativeWindow*, std::unique_ptr<TrackedWindow>> windows_;
+  x11::ScopedEventSelector root_events_;
+  base::OneShotTimer update_timer_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_UI_X_X_WINDOW_OCCLUSION_TRACKER_H_
@@ -0,0 +1,159 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/web_contents_hibernation_controller.h"
+
+#include <set>
+#include <utility>
+
+#include "base/barrier_closure.h"
+#include "base/functional/bind.h"
+#include "base/functional/callback_helpers.h"
+#include "content/public/browser/navigation_controller.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/web_contents.h"
+#include "mojo/public/cpp/bindings/callback_helpers.h"
+#include "services/service_manager/public/cpp/interface_provider.h"
+
+namespace electron {
+
+WebContentsHibernationController::WebContentsHibernationController(
+    content::WebContents* web_contents)
+    : content::WebContentsObserver(web_contents),
+      content::WebContentsUserData<WebContentsHibernationController>(
+          *web_contents) {}
+
+WebContentsHibernationController::~WebContentsHibernationController() =
+    default;
+
+void WebContentsHibernationController::SetPolicy(const Policy& policy) {
+  policy_ = policy;
+
+  if (policy_.on_memory_pressure && !memory_pressure_listener_) {
+    memory_pressure_listener_.emplace(
+        FROM_HERE,
+        base::BindRepeating(
+            &WebContentsHibernationController::OnMemoryPressure,
+            base::Unretained(this)));
+  } else if (!policy_.on_memory_pressure) {
+    memory_pressure_listener_.reset();
+  }
+
+  idle_timer_.Stop();
+  if (web_contents()->GetVisibility() == content::Visibility::HIDDEN)
+    StartIdleTimer();
+}
+
+bool WebContentsHibernationController::Hibernate() {
+  if (state_ != State::kAwake ||
+      web_contents()->GetVisibility() == content::Visibility::VISIBLE)
+    return false;
+
+  idle_timer_.Stop();
+  if (!policy_.discard || !Discard())
+    Freeze();
+  return true;
+}
+
+void WebContentsHibernationController::OnVisibilityChanged(
+    content::Visibility visibility) {
+  if (visibility == content::Visibility::VISIBLE) {
+    idle_timer_.Stop();
+    Wake(true);
+  } else if (visibility == content::Visibility::HIDDEN) {
+    StartIdleTimer();
+  }
+}
+
+void WebContentsHibernationController::DidStartNavigation(
+    content::NavigationHandle* navigation_handle) {
+  Wake(false);
+}
+
+bool WebContentsHibernationController::Discard() {
+  content::RenderFrameHost* frame_host = web_contents()->GetPrimaryMainFrame();
+  if (!frame_host->IsRenderFrameLive())
+    return false;
+
+  // The navigation entry is all that is kept of the page, so the renderer is
+  // only shut down when the page is all it hosts and there are no unload
+  // handlers that would have to run first.
+  state_ = State::kDiscarded;
+  if (!frame_host->GetProcess()->FastShutdownIfPossible(1, false)) {
+    state_ = State::kAwake;
+    return false;
+  }
+  web_contents()->GetController().SetNeedsReload();
+  return true;
+}
+
+void WebContentsHibernationController::Freeze() {
+  state_ = State::kFrozen;
+
+  // A frozen page doesn't run the tasks that would purge its memory, so every
+  // renderer of the page purges first and the page is frozen once they all
+  // have.
+  std::set<int> process_ids;
+  std::vector<content::RenderFrameHost*> frame_hosts;
+  web_contents()->ForEachRenderFrameHost(
+      [&](content::RenderFrameHost* frame_host) {
+        if (frame_host->IsRenderFrameLive() &&
+            process_ids.insert(frame_host->GetProcess()->GetID()).second)
+          frame_hosts.push_back(frame_host);
+      });
+
+  base::RepeatingClosure barrier = base::BarrierClosure(
+      frame_hosts.size(),
+      base::BindOnce(&WebContentsHibernationController::OnMemoryPurged,
+                     weak_factory_.GetWeakPtr()));
+  for (content::RenderFrameHost* frame_host : frame_hosts) {
+    auto& remote = purge_remotes_.emplace_back();
+    frame_host->GetRemoteInterfaces()->GetInterface(
+        remote.BindNewPipeAndPassReceiver());
+    remote->PurgeMemory(
+        frame_host->GetProcess()->GetActiveViewCount() <= 1,
+        mojo::WrapCallbackWithDefaultInvokeIfNotRun(
+            base::OnceClosure(barrier)));
+  }
+}
+
+void WebContentsHibernationController::OnMemoryPurged() {
+  // Every renderer has replied or gone away, which also runs the callbacks.
+  purge_remotes_.clear();
+  if (state_ == State::kFrozen)
+    web_contents()->SetPageFrozen(true);
+}
+
+void WebContentsHibernationController::Wake(bool reload) {
+  State state = std::exchange(state_, State::kAwake);
+  if (state == State::kFrozen) {
+    // Drops the replies of purges that are still pending.
+    weak_factory_.InvalidateWeakPtrs();
+    purge_remotes_.clear();
+    web_contents()->SetPageFrozen(false);
+  } else if (state == State::kDiscarded && reload) {
+    web_contents()->GetController().LoadIfNecessary();
+  }
+}
+
+void WebContentsHibernationController::StartIdleTimer() {
+  if (policy_.idle_timeout.is_zero() || state_ != State::kAwake)
+    return;
+  idle_timer_.Start(
+      FROM_HERE, policy_.idle_timeout,
+      base::BindOnce(
+          base::IgnoreResult(&WebContentsHibernationController::Hibernate),
+          base::Unretained(this)));
+}
+
+void WebContentsHibernationController::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel level) {
+  if (level != base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE)
+    Hibernate();
+}
+
+WEB_CONTENTS_USER_DATA_KEY_IMPL(WebContentsHibernationController);
+
+}  // namespace electron
@@ -0,0 +1,98 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_WEB_CONTENTS_HIBERNATION_CONTROLLER_H_
+#define ELECTRON_SHELL_BROWSER_WEB_CONTENTS_HIBERNATION_CONTROLLER_H_
+
+#include <optional>
+#include <vector>
+
+#include "base/memory/memory_pressure_listener.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "content/public/browser/web_contents_observer.h"
+#include "content/public/browser/web_contents_user_data.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "shell/common/api/api.mojom.h"
+
+namespace electron {
+
+// Gives the memory of a hidden WebContents back while it isn't shown. The
+// renderer purges its caches and discardable GPU resources and the page is
+// frozen, or, when discarding is allowed and the renderer hosts nothing
+// else, the renderer is shut down and the page is reloaded from its
+// navigation entry. Either way the page is woken up when it is shown again
+// or navigated.
+class WebContentsHibernationController
+    : public content::WebContentsObserver,
+      public content::WebContentsUserData<WebContentsHibernationController> {
+ public:
+  struct Policy {
+    // How long the page has to stay hidden before it is hibernated, or zero
+    // to only hibernate when asked to.
+    base::TimeDelta idle_timeout;
+    // Whether to hibernate the page once the system is under memory
+    // pressure while it is hidden.
+    bool on_memory_pressure = false;
+    // Whether the renderer may be shut down instead of frozen.
+    bool discard = false;
+  };
+
+  ~WebContentsHibernationController() override;
+
+  // disable copy
+  WebContentsHibernationController(const WebContentsHibernationController&) =
+      delete;
+  WebContentsHibernationController& operator=(
+      const WebContentsHibernationController&) = delete;
+
+  void SetPolicy(const Policy& policy);
+
+  // Hibernates the page now. Returns false if it is visible or already
+  // hibernated.
+  bool Hibernate();
+
+  bool is_hibernated() const { return state_ != State::kAwake; }
+  bool is_discarded() const { return state_ == State::kDiscarded; }
+
+ private:
+  explicit WebContentsHibernationController(
+      content::WebContents* web_contents);
+  friend class content::WebContentsUserData<WebContentsHibernationController>;
+
+  enum class State {
+    kAwake,
+    kFrozen,
+    kDiscarded,
+  };
+
+  // content::WebContentsObserver:
+  void OnVisibilityChanged(content::Visibility visibility) override;
+  void DidStartNavigation(
+      content::NavigationHandle* navigation_handle) override;
+
+  bool Discard();
+  void Freeze();
+  void OnMemoryPurged();
+  // |reload| is false when a navigation is about to load the page anyway.
+  void Wake(bool reload);
+  void StartIdleTimer();
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel level);
+
+  Policy policy_;
+  State state_ = State::kAwake;
+  base::OneShotTimer idle_timer_;
+  std::optional<base::MemoryPressureListener> memory_pressure_listener_;
+  std::vector<mojo::Remote<mojom::ElectronRenderer>> purge_remotes_;
+
+  base::WeakPtrFactory<WebContentsHibernationController> weak_factory_{this};
+
+  WEB_CONTENTS_USER_DATA_KEY_DECL();
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_WEB_CONTENTS_HIBERNATION_CONTROLLER_H_
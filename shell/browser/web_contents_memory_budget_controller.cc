@@ -0,0 +1,145 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/web_contents_memory_budget_controller.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/functional/bind.h"
+#include "content/public/browser/navigation_controller.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/web_contents.h"
+#include "mojo/public/cpp/bindings/callback_helpers.h"
+#include "services/resource_coordinator/public/cpp/memory_instrumentation/memory_instrumentation.h"
+#include "services/service_manager/public/cpp/interface_provider.h"
+
+namespace electron {
+
+WebContentsMemoryBudgetController::WebContentsMemoryBudgetController(
+    content::WebContents* web_contents)
+    : content::WebContentsObserver(web_contents),
+      content::WebContentsUserData<WebContentsMemoryBudgetController>(
+          *web_contents) {}
+
+WebContentsMemoryBudgetController::~WebContentsMemoryBudgetController() =
+    default;
+
+void WebContentsMemoryBudgetController::SetPolicy(
+    const Policy& policy,
+    ExceededCallback exceeded_callback) {
+  policy_ = policy;
+  exceeded_callback_ = std::move(exceeded_callback);
+  Reset();
+
+  if (policy_.limit_kb == 0) {
+    check_timer_.Stop();
+    return;
+  }
+  check_timer_.Start(FROM_HERE, policy_.check_interval, this,
+                     &WebContentsMemoryBudgetController::Measure);
+}
+
+void WebContentsMemoryBudgetController::PrimaryMainFrameRenderProcessGone(
+    base::TerminationStatus status) {
+  Reset();
+}
+
+void WebContentsMemoryBudgetController::PrimaryPageChanged(
+    content::Page& page) {
+  // The page may now live in another renderer, which is measured afresh.
+  Reset();
+}
+
+void WebContentsMemoryBudgetController::Measure() {
+  // A dump can take longer than the check interval, so don't pile up more
+  // while one is in flight, or while the renderer is still purging.
+  if (measuring_ || purge_remote_.is_bound())
+    return;
+
+  content::RenderFrameHost* frame_host = web_contents()->GetPrimaryMainFrame();
+  if (!frame_host->IsRenderFrameLive())
+    return;
+
+  const base::Process& process = frame_host->GetProcess()->GetProcess();
+  if (!process.IsValid())
+    return;
+
+  base::ProcessId pid = process.Pid();
+  measuring_ = true;
+  memory_instrumentation::MemoryInstrumentation::GetInstance()
+      ->RequestGlobalDumpForPid(
+          pid, std::vector<std::string>(),
+          base::BindOnce(&WebContentsMemoryBudgetController::OnMemoryDump,
+                         weak_factory_.GetWeakPtr(), pid));
+}
+
+void WebContentsMemoryBudgetController::OnMemoryDump(
+    base::ProcessId pid,
+    bool success,
+    std::unique_ptr<memory_instrumentation::GlobalMemoryDump> global_dump) {
+  measuring_ = false;
+  if (!success || policy_.limit_kb == 0)
+    return;
+
+  for (const auto& dump : global_dump->process_dumps()) {
+    if (dump.pid() != pid)
+      continue;
+
+    uint64_t usage_kb = dump.os_dump().private_footprint_kb;
+    if (usage_kb <= policy_.limit_kb) {
+      purged_ = false;
+      exceeded_ = false;
+      return;
+    }
+
+    if (!purged_) {
+      // Give the renderer a chance to get back under the limit by itself,
+      // and measure again as soon as it has.
+      purged_ = true;
+      content::RenderFrameHost* frame_host =
+          web_contents()->GetPrimaryMainFrame();
+      purge_remote_.reset();
+      frame_host->GetRemoteInterfaces()->GetInterface(
+          purge_remote_.BindNewPipeAndPassReceiver());
+      purge_remote_->PurgeMemory(
+          frame_host->GetProcess()->GetActiveViewCount() <= 1,
+          mojo::WrapCallbackWithDefaultInvokeIfNotRun(base::BindOnce(
+              &WebContentsMemoryBudgetController::OnMemoryPurged,
+              weak_factory_.GetWeakPtr())));
+      return;
+    }
+
+    if (exceeded_ || !exceeded_callback_)
+      return;
+    exceeded_ = true;
+    // The callback runs JavaScript, which can destroy the WebContents.
+    auto weak_this = weak_factory_.GetWeakPtr();
+    bool reload = exceeded_callback_.Run(usage_kb);
+    if (weak_this && reload)
+      web_contents()->GetController().Reload(content::ReloadType::NORMAL,
+                                             false);
+    return;
+  }
+}
+
+void WebContentsMemoryBudgetController::OnMemoryPurged() {
+  purge_remote_.reset();
+  Measure();
+}
+
+void WebContentsMemoryBudgetController::Reset() {
+  // Drops the replies of dumps and purges that are still pending.
+  weak_factory_.InvalidateWeakPtrs();
+  purge_remote_.reset();
+  measuring_ = false;
+  purged_ = false;
+  exceeded_ = false;
+}
+
+WEB_CONTENTS_USER_DATA_KEY_IMPL(WebContentsMemoryBudgetController);
+
+}  // namespace electron
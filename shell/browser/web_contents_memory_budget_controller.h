@@ -0,0 +1,92 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_WEB_CONTENTS_MEMORY_BUDGET_CONTROLLER_H_
+#define ELECTRON_SHELL_BROWSER_WEB_CONTENTS_MEMORY_BUDGET_CONTROLLER_H_
+
+#include <cstdint>
+#include <memory>
+
+#include "base/functional/callback.h"
+#include "base/memory/weak_ptr.h"
+#include "base/process/process_handle.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "content/public/browser/web_contents_observer.h"
+#include "content/public/browser/web_contents_user_data.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "shell/common/api/api.mojom.h"
+
+namespace memory_instrumentation {
+class GlobalMemoryDump;
+}  // namespace memory_instrumentation
+
+namespace electron {
+
+// Keeps the renderer of the page's main frame within a memory budget. Its
+// private memory footprint is sampled periodically; once it goes over the
+// limit the renderer is asked to purge its memory, and if that doesn't bring
+// it back under the limit the embedder is told through |exceeded_callback|.
+class WebContentsMemoryBudgetController
+    : public content::WebContentsObserver,
+      public content::WebContentsUserData<WebContentsMemoryBudgetController> {
+ public:
+  // Called with the footprint in KB. Returns true if the page should be
+  // reloaded.
+  using ExceededCallback = base::RepeatingCallback<bool(uint64_t usage_kb)>;
+
+  struct Policy {
+    // The private memory footprint allowed, in KB, or zero for no budget.
+    uint64_t limit_kb = 0;
+    // How often the footprint is sampled.
+    base::TimeDelta check_interval = base::Seconds(5);
+  };
+
+  ~WebContentsMemoryBudgetController() override;
+
+  // disable copy
+  WebContentsMemoryBudgetController(const WebContentsMemoryBudgetController&) =
+      delete;
+  WebContentsMemoryBudgetController& operator=(
+      const WebContentsMemoryBudgetController&) = delete;
+
+  void SetPolicy(const Policy& policy, ExceededCallback exceeded_callback);
+
+ private:
+  explicit WebContentsMemoryBudgetController(
+      content::WebContents* web_contents);
+  friend class content::WebContentsUserData<WebContentsMemoryBudgetController>;
+
+  // content::WebContentsObserver:
+  void PrimaryMainFrameRenderProcessGone(
+      base::TerminationStatus status) override;
+  void PrimaryPageChanged(content::Page& page) override;
+
+  void Measure();
+  void OnMemoryDump(
+      base::ProcessId pid,
+      bool success,
+      std::unique_ptr<memory_instrumentation::GlobalMemoryDump> global_dump);
+  void OnMemoryPurged();
+  void Reset();
+
+  Policy policy_;
+  ExceededCallback exceeded_callback_;
+  base::RepeatingTimer check_timer_;
+  mojo::Remote<mojom::ElectronRenderer> purge_remote_;
+  // Whether a memory dump has been requested and not answered yet.
+  bool measuring_ = false;
+  // Whether the renderer has already purged its memory, and whether the
+  // embedder has already been told, since the page last went over the limit.
+  bool purged_ = false;
+  bool exceeded_ = false;
+
+  base::WeakPtrFactory<WebContentsMemoryBudgetController> weak_factory_{this};
+
+  WEB_CONTENTS_USER_DATA_KEY_DECL();
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_WEB_CONTENTS_MEMORY_BUDGET_CONTROLLER_H_
@@ -0,0 +1,73 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/web_contents_preconnect_helper.h"
+
+#include "content/public/browser/navigation_handle.h"
+#include "content/public/browser/page.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/web_contents.h"
+#include "shell/browser/electron_browser_context.h"
+#include "shell/browser/preconnect_predictor.h"
+#include "third_party/blink/public/mojom/loader/resource_load_info.mojom.h"
+
+namespace electron {
+
+WebContentsPreconnectHelper::WebContentsPreconnectHelper(
+    content::WebContents* web_contents)
+    : content::WebContentsObserver(web_contents),
+      content::WebContentsUserData<WebContentsPreconnectHelper>(
+          *web_contents) {}
+
+WebContentsPreconnectHelper::~WebContentsPreconnectHelper() = default;
+
+void WebContentsPreconnectHelper::DidStartNavigation(
+    content::NavigationHandle* navigation_handle) {
+  if (!navigation_handle->IsInPrimaryMainFrame() ||
+      navigation_handle->IsSameDocument())
+    return;
+  if (PreconnectPredictor* predictor = GetPredictor())
+    predictor->OnNavigationStarted(navigation_handle->GetURL());
+}
+
+void WebContentsPreconnectHelper::PrimaryPageChanged(content::Page& page) {
+  LearnPage();
+  page_origin_ = page.GetMainDocument().GetLastCommittedOrigin();
+}
+
+void WebContentsPreconnectHelper::ResourceLoadComplete(
+    content::RenderFrameHost* render_frame_host,
+    const content::GlobalRequestID& request_id,
+    const blink::mojom::ResourceLoadInfo& resource_load_info) {
+  if (!render_frame_host->GetPage().IsPrimary() ||
+      !resource_load_info.final_url.SchemeIsHTTPOrHTTPS())
+    return;
+  // Nothing is collected while the predictor would throw it away.
+  if (!GetPredictor())
+    return;
+  resource_origins_.insert(url::Origin::Create(resource_load_info.final_url));
+}
+
+void WebContentsPreconnectHelper::WebContentsDestroyed() {
+  LearnPage();
+}
+
+PreconnectPredictor* WebContentsPreconnectHelper::GetPredictor() {
+  auto* browser_context =
+      static_cast<ElectronBrowserContext*>(web_contents()->GetBrowserContext());
+  PreconnectPredictor* predictor = browser_context->GetPreconnectPredictor();
+  return predictor->enabled() ? predictor : nullptr;
+}
+
+void WebContentsPreconnectHelper::LearnPage() {
+  // Pages that loaded no subresources still count, as they lower the
+  // confidence in the origins other pages of the host used.
+  if (PreconnectPredictor* predictor = GetPredictor())
+    predictor->LearnPage(page_origin_, resource_origins_);
+  resource_origins_.clear();
+}
+
+WEB_CONTENTS_USER_DATA_KEY_IMPL(WebContentsPreconnectHelper);
+
+}  // namespace electron
@@ -0,0 +1,56 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_WEB_CONTENTS_PRECONNECT_HELPER_H_
+#define ELECTRON_SHELL_BROWSER_WEB_CONTENTS_PRECONNECT_HELPER_H_
+
+#include <set>
+
+#include "content/public/browser/web_contents_observer.h"
+#include "content/public/browser/web_contents_user_data.h"
+#include "url/origin.h"
+
+namespace electron {
+
+class PreconnectPredictor;
+
+// Feeds the page loads of a WebContents to the PreconnectPredictor of its
+// browser context, and lets it preconnect as main frame navigations start.
+class WebContentsPreconnectHelper
+    : public content::WebContentsObserver,
+      public content::WebContentsUserData<WebContentsPreconnectHelper> {
+ public:
+  ~WebContentsPreconnectHelper() override;
+
+  // disable copy
+  WebContentsPreconnectHelper(const WebContentsPreconnectHelper&) = delete;
+  WebContentsPreconnectHelper& operator=(const WebContentsPreconnectHelper&) =
+      delete;
+
+ private:
+  explicit WebContentsPreconnectHelper(content::WebContents* web_contents);
+  friend class content::WebContentsUserData<WebContentsPreconnectHelper>;
+
+  // content::WebContentsObserver:
+  void DidStartNavigation(
+      content::NavigationHandle* navigation_handle) override;
+  void PrimaryPageChanged(content::Page& page) override;
+  void ResourceLoadComplete(
+      content::RenderFrameHost* render_frame_host,
+      const content::GlobalRequestID& request_id,
+      const blink::mojom::ResourceLoadInfo& resource_load_info) override;
+  void WebContentsDestroyed() override;
+
+  PreconnectPredictor* GetPredictor();
+  void LearnPage();
+
+  url::Origin page_origin_;
+  std::set<url::Origin> resource_origins_;
+
+  WEB_CONTENTS_USER_DATA_KEY_DECL();
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_WEB_CONTENTS_PRECONNECT_HELPER_H_
@@ -117,6 +117,7 @@ void WebContentsPreferences::Clear() {
   node_integration_ = false;
   node_integration_in_sub_frames_ = false;
   node_integration_in_worker_ = false;
+  lazy_node_integration_ = false;
   disable_html_fullscreen_window_resize_ = false;
   webview_tag_ = false;
   sandbox_ = std::nullopt;
@@ -172,6 +173,7 @@ void WebContentsPreferences::SetFromDictionary(
                       &node_integration_in_sub_frames_);
   web_preferences.Get(options::kNodeIntegrationInWorker,
                       &node_integration_in_worker_);
+  web_preferences.Get(options::kLazyNodeIntegration, &lazy_node_integration_);
   web_preferences.Get(options::kDisableHtmlFullscreenWindowResize,
                       &disable_html_fullscreen_window_resize_);
   web_preferences.Get(options::kWebviewTag, &webview_tag_);
@@ -326,6 +328,25 @@ WebContentsPreferences* WebContentsPreferences::From(
 void WebContentsPreferences::AppendCommandLineSwitches(
     base::CommandLine* command_line,
     bool is_subframe) {
+  AppendProcessSwitches(command_line, is_subframe);
+
+  // We are appending args to a webContents so let's save the current state
+  // of our preferences object so that during the lifetime of the WebContents
+  // we can fetch the options used to initially configure the WebContents
+  // last_preference_ = preference_.Clone();
+  SaveLastPreferences();
+}
+
+base::CommandLine::StringVector
+WebContentsPreferences::GetMainFrameProcessSwitches() const {
+  base::CommandLine command_line(base::CommandLine::NO_PROGRAM);
+  AppendProcessSwitches(&command_line, false);
+  return command_line.argv();
+}
+
+void WebContentsPreferences::AppendProcessSwitches(
+    base::CommandLine* command_line,
+    bool is_subframe) const {
   // Experimental flags.
   if (experimental_features_)
     command_line->AppendSwitch(
@@ -368,11 +389,8 @@ void WebContentsPreferences::AppendCommandLineSwitches(
   if (node_integration_in_worker_)
     command_line->AppendSwitch(switches::kNodeIntegrationInWorker);
 
-  // We are appending args to a webContents so let's save the current state
-  // of our preferences object so that during the lifetime of the WebContents
-  // we can fetch the options used to initially configure the WebContents
-  // last_preference_ = preference_.Clone();
-  SaveLastPreferences();
+  if (lazy_node_integration_)
+    command_line->AppendSwitch(switches::kLazyNodeIntegration);
 }
 
 void WebContentsPreferences::SaveLastPreferences() {
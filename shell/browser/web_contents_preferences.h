@@ -9,6 +9,7 @@
 #include <string>
 #include <vector>
 
+#include "base/command_line.h"
 #include "base/memory/raw_ptr.h"
 #include "base/values.h"
 #include "content/public/browser/web_contents_user_data.h"
@@ -17,10 +18,6 @@
 #include "third_party/blink/public/mojom/v8_cache_options.mojom-forward.h"
 #include "third_party/blink/public/mojom/webpreferences/web_preferences.mojom-forward.h"
 
-namespace base {
-class CommandLine;
-}
-
 namespace gin_helper {
 class Dictionary;
 }
@@ -48,6 +45,11 @@ class WebContentsPreferences
   void AppendCommandLineSwitches(base::CommandLine* command_line,
                                  bool is_subframe);
 
+  // The switches that a renderer process hosting a main frame with these
+  // preferences is launched with. Two WebContents whose switches match can
+  // share a renderer process.
+  base::CommandLine::StringVector GetMainFrameProcessSwitches() const;
+
   // Modify the WebPreferences according to preferences.
   void OverrideWebkitPrefs(blink::web_pref::WebPreferences* prefs,
                            blink::RendererPreferences* renderer_prefs);
@@ -86,11 +88,14 @@ class WebContentsPreferences
  private:
   friend class content::WebContentsUserData<WebContentsPreferences>;
   friend class ElectronBrowserClient;
+  friend class SpareRendererPool;
 
   // Get WebContents according to process ID.
   static content::WebContents* GetWebContentsFromProcessID(int process_id);
 
   void Clear();
+  void AppendProcessSwitches(base::CommandLine* command_line,
+                             bool is_subframe) const;
   void SaveLastPreferences();
 
   // TODO(clavin): refactor to use the WebContents provided by the
@@ -102,6 +107,7 @@ class WebContentsPreferences
   bool node_integration_;
   bool node_integration_in_sub_frames_;
   bool node_integration_in_worker_;
+  bool lazy_node_integration_;
   bool disable_html_fullscreen_window_resize_;
   bool webview_tag_;
   std::optional<bool> sandbox_;
@@ -59,8 +59,11 @@ void WindowList::AddWindow(NativeWindow* window) {
 // static
 void WindowList::RemoveWindow(NativeWindow* window) {
   WindowVector& windows = GetInstance()->windows_;
-  windows.erase(std::remove(windows.begin(), windows.end(), window),
-                windows.end());
+  // A window is added only once, so stop at the first match rather than
+  // scanning the whole list, which adds up when all windows are closed.
+  auto iter = std::find(windows.begin(), windows.end(), window);
+  if (iter != windows.end())
+    windows.erase(iter);
 
   for (WindowListObserver& observer : GetObservers())
     observer.OnWindowRemoved(window);
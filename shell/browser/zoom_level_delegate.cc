@@ -39,8 +39,11 @@ std::string GetHash(const base::FilePath& partition_path) {
 
 // static
 void ZoomLevelDelegate::RegisterPrefs(PrefRegistrySimple* registry) {
-  registry->RegisterDictionaryPref(kPartitionDefaultZoomLevel);
-  registry->RegisterDictionaryPref(kPartitionPerHostZoomLevels);
+  // Zooming changes these often, so they are written in batches.
+  registry->RegisterDictionaryPref(kPartitionDefaultZoomLevel,
+                                   PrefRegistry::LOSSY_PREF);
+  registry->RegisterDictionaryPref(kPartitionPerHostZoomLevels,
+                                   PrefRegistry::LOSSY_PREF);
 }
 
 ZoomLevelDelegate::ZoomLevelDelegate(PrefService* pref_service,
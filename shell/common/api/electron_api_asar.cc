@@ -2,8 +2,12 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include <optional>
+#include <string>
 #include <vector>
 
+#include "base/json/json_reader.h"
+#include "base/values.h"
 #include "gin/handle.h"
 #include "shell/common/asar/archive.h"
 #include "shell/common/asar/asar_util.h"
@@ -29,6 +33,11 @@ class Archive : public node::ObjectWrap {
     NODE_SET_PROTOTYPE_METHOD(tpl, "copyFileOut", &Archive::CopyFileOut);
     NODE_SET_PROTOTYPE_METHOD(tpl, "getFdAndValidateIntegrityLater",
                               &Archive::GetFD);
+    NODE_SET_PROTOTYPE_METHOD(tpl, "readBuffer", &Archive::ReadBuffer);
+    NODE_SET_PROTOTYPE_METHOD(tpl, "readString", &Archive::ReadString);
+    NODE_SET_PROTOTYPE_METHOD(tpl, "readCompressed", &Archive::ReadCompressed);
+    NODE_SET_PROTOTYPE_METHOD(tpl, "statBatch", &Archive::StatBatch);
+    NODE_SET_PROTOTYPE_METHOD(tpl, "resolveModule", &Archive::ResolveModule);
 
     return tpl;
   }
@@ -98,6 +107,12 @@ class Archive : public node::ObjectWrap {
       integrity.Set("hash", info.integrity.value().hash);
       dict.Set("integrity", integrity);
     }
+    if (info.compression.has_value()) {
+      gin_helper::Dictionary compression(isolate, v8::Object::New(isolate));
+      compression.Set("blockSize", info.compression.value().block_size);
+      compression.Set("blocks", info.compression.value().blocks);
+      dict.Set("compression", compression);
+    }
     args.GetReturnValue().Set(dict.GetHandle());
   }
 
@@ -124,6 +139,65 @@ class Archive : public node::ObjectWrap {
     args.GetReturnValue().Set(dict.GetHandle());
   }
 
+  // Stats every path of an array in one call. Returns a Float64Array holding
+  // the type, size and offset of each path in turn, with a type of -1 for
+  // paths that don't exist.
+  static void StatBatch(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto* isolate = args.GetIsolate();
+    auto* wrap = node::ObjectWrap::Unwrap<Archive>(args.Holder());
+
+    std::vector<base::FilePath> paths;
+    if (!wrap->archive_ || !gin::ConvertFromV8(isolate, args[0], &paths)) {
+      args.GetReturnValue().Set(v8::False(isolate));
+      return;
+    }
+
+    constexpr size_t kFieldsPerPath = 3;
+    v8::Local<v8::ArrayBuffer> buffer = v8::ArrayBuffer::New(
+        isolate, paths.size() * kFieldsPerPath * sizeof(double));
+    auto* fields = static_cast<double*>(buffer->Data());
+    for (const base::FilePath& path : paths) {
+      asar::Archive::Stats stats;
+      if (wrap->archive_->Stat(path, &stats)) {
+        fields[0] = static_cast<int>(stats.type);
+        fields[1] = stats.size;
+        fields[2] = stats.offset;
+      } else {
+        fields[0] = -1;
+        fields[1] = 0;
+        fields[2] = 0;
+      }
+      fields += kFieldsPerPath;
+    }
+    args.GetReturnValue().Set(
+        v8::Float64Array::New(buffer, 0, paths.size() * kFieldsPerPath));
+  }
+
+  // Resolves a module request, relative to the root of the archive, the way
+  // Node's Module._findPath() does for a single lookup path, without a call
+  // into the archive per candidate. Returns the relative path of the module,
+  // or false when it isn't found here or needs Node's own handling.
+  static void ResolveModule(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto* isolate = args.GetIsolate();
+    auto* wrap = node::ObjectWrap::Unwrap<Archive>(args.Holder());
+
+    base::FilePath request;
+    std::vector<base::FilePath> extensions;
+    if (!wrap->archive_ || !gin::ConvertFromV8(isolate, args[0], &request) ||
+        !gin::ConvertFromV8(isolate, args[1], &extensions)) {
+      args.GetReturnValue().Set(v8::False(isolate));
+      return;
+    }
+
+    std::optional<base::FilePath> resolved =
+        wrap->ResolveModulePath(request, extensions);
+    if (!resolved) {
+      args.GetReturnValue().Set(v8::False(isolate));
+      return;
+    }
+    args.GetReturnValue().Set(gin::ConvertToV8(isolate, *resolved));
+  }
+
   // Returns all files under a directory.
   static void Readdir(const v8::FunctionCallbackInfo<v8::Value>& args) {
     auto* isolate = args.GetIsolate();
@@ -187,6 +261,175 @@ class Archive : public node::ObjectWrap {
         isolate, wrap->archive_ ? wrap->archive_->GetUnsafeFD() : -1));
   }
 
+  // Copies packed data out of the archive's mapping into a new Buffer.
+  // Returns false if the data isn't mapped, so callers can fall back to fd
+  // reads. Integrity is not validated.
+  static void ReadBuffer(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto* isolate = args.GetIsolate();
+    auto* wrap = node::ObjectWrap::Unwrap<Archive>(args.Holder());
+
+    std::optional<base::span<const uint8_t>> data = wrap->GetMappedData(args);
+    v8::Local<v8::Object> buffer;
+    if (!data || !node::Buffer::Copy(isolate,
+                                     reinterpret_cast<const char*>(
+                                         data->data()),
+                                     data->size())
+                      .ToLocal(&buffer)) {
+      args.GetReturnValue().Set(v8::False(isolate));
+      return;
+    }
+    args.GetReturnValue().Set(buffer);
+  }
+
+  // Decodes packed UTF-8 data straight from the archive's mapping, without an
+  // intermediate Buffer. Returns false if the data isn't mapped or is too
+  // large for a string. Integrity is not validated.
+  static void ReadString(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto* isolate = args.GetIsolate();
+    auto* wrap = node::ObjectWrap::Unwrap<Archive>(args.Holder());
+
+    std::optional<base::span<const uint8_t>> data = wrap->GetMappedData(args);
+    v8::Local<v8::String> str;
+    if (!data || data->size() > v8::String::kMaxLength ||
+        !v8::String::NewFromUtf8(isolate,
+                                 reinterpret_cast<const char*>(data->data()),
+                                 v8::NewStringType::kNormal,
+                                 static_cast<int>(data->size()))
+             .ToLocal(&str)) {
+      args.GetReturnValue().Set(v8::False(isolate));
+      return;
+    }
+    args.GetReturnValue().Set(str);
+  }
+
+  // Decompresses a compressed packed file into a new Buffer. Returns false if
+  // the file isn't compressed or can't be decompressed. Integrity is not
+  // validated.
+  static void ReadCompressed(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto* isolate = args.GetIsolate();
+    auto* wrap = node::ObjectWrap::Unwrap<Archive>(args.Holder());
+
+    base::FilePath path;
+    asar::Archive::FileInfo info;
+    std::string contents;
+    v8::Local<v8::Object> buffer;
+    if (!gin::ConvertFromV8(isolate, args[0], &path) || !wrap->archive_ ||
+        !wrap->archive_->GetFileInfo(path, &info) ||
+        !wrap->archive_->DecompressFile(info, &contents) ||
+        !node::Buffer::Copy(isolate, contents.data(), contents.size())
+             .ToLocal(&buffer)) {
+      args.GetReturnValue().Set(v8::False(isolate));
+      return;
+    }
+    args.GetReturnValue().Set(buffer);
+  }
+
+  // Mirrors tryFile() in Node's module loader, following links.
+  bool IsFile(const base::FilePath& path) const {
+    asar::Archive::FileInfo info;
+    return archive_->GetFileInfo(path, &info);
+  }
+
+  // Mirrors tryExtensions() in Node's module loader.
+  std::optional<base::FilePath> TryExtensions(
+      const base::FilePath& path,
+      const std::vector<base::FilePath>& extensions) const {
+    for (const base::FilePath& extension : extensions) {
+      base::FilePath candidate(path.value() + extension.value());
+      if (IsFile(candidate))
+        return candidate;
+    }
+    return std::nullopt;
+  }
+
+  // Resolves |main| of a package.json against |package_path|, collapsing "."
+  // and ".." like path.resolve() would. Returns std::nullopt for paths that
+  // leave the archive.
+  static std::optional<base::FilePath> ResolveMainPath(
+      const base::FilePath& package_path,
+      const base::FilePath& main) {
+    if (main.IsAbsolute())
+      return std::nullopt;
+
+    std::vector<base::FilePath::StringType> components;
+    for (const auto& component : package_path.Append(main).GetComponents()) {
+      if (component == base::FilePath::kCurrentDirectory)
+        continue;
+      if (component == base::FilePath::kParentDirectory) {
+        if (components.empty())
+          return std::nullopt;
+        components.pop_back();
+        continue;
+      }
+      components.push_back(component);
+    }
+
+    base::FilePath resolved;
+    for (const auto& component : components)
+      resolved = resolved.Append(component);
+    return resolved;
+  }
+
+  std::optional<base::FilePath> ResolveModulePath(
+      const base::FilePath& request,
+      const std::vector<base::FilePath>& extensions) const {
+    if (IsFile(request))
+      return request;
+    if (std::optional<base::FilePath> file = TryExtensions(request, extensions))
+      return file;
+
+    // Linked directories are left to Node, as are directories whose
+    // package.json points nowhere, which Node warns or throws about.
+    asar::Archive::Stats stats;
+    if (!archive_->Stat(request, &stats) ||
+        stats.type != asar::Archive::FileType::kDirectory) {
+      return std::nullopt;
+    }
+
+    const base::FilePath package_json =
+        request.Append(FILE_PATH_LITERAL("package.json"));
+    if (IsFile(package_json)) {
+      std::string contents;
+      if (!asar::ReadFileToString(archive_->path().Append(package_json),
+                                  &contents)) {
+        return std::nullopt;
+      }
+      std::optional<base::Value> value = base::JSONReader::Read(contents);
+      if (!value || !value->is_dict())
+        return std::nullopt;
+      if (const base::Value* main = value->GetDict().Find("main")) {
+        if (!main->is_string())
+          return std::nullopt;
+        if (!main->GetString().empty()) {
+          std::optional<base::FilePath> main_path = ResolveMainPath(
+              request, base::FilePath::FromUTF8Unsafe(main->GetString()));
+          if (!main_path)
+            return std::nullopt;
+          if (IsFile(*main_path))
+            return main_path;
+          if (auto file = TryExtensions(*main_path, extensions))
+            return file;
+          return TryExtensions(main_path->Append(FILE_PATH_LITERAL("index")),
+                               extensions);
+        }
+      }
+    }
+
+    return TryExtensions(request.Append(FILE_PATH_LITERAL("index")),
+                         extensions);
+  }
+
+  // Reads the (offset, size) arguments and returns the mapped range.
+  std::optional<base::span<const uint8_t>> GetMappedData(
+      const v8::FunctionCallbackInfo<v8::Value>& args) const {
+    uint64_t offset, size;
+    if (!archive_ || !gin::ConvertFromV8(args.GetIsolate(), args[0], &offset) ||
+        !gin::ConvertFromV8(args.GetIsolate(), args[1], &size)) {
+      return std::nullopt;
+    }
+    return archive_->GetMappedData(offset, size);
+  }
+
   std::shared_ptr<asar::Archive> archive_;
 };
 
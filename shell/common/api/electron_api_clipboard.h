@@ -53,6 +53,7 @@ class Clipboard {
                             gin_helper::Arguments* args);
 
   static gfx::Image ReadImage(gin_helper::Arguments* args);
+  static v8::Local<v8::Promise> ReadImageAsync(gin_helper::Arguments* args);
   static void WriteImage(const gfx::Image& image, gin_helper::Arguments* args);
 
   static std::u16string ReadFindText();
@@ -4,23 +4,27 @@
 
 #include "shell/common/api/electron_api_native_image.h"
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "base/barrier_callback.h"
 #include "base/files/file_util.h"
 #include "base/logging.h"
 #include "base/memory/ref_counted_memory.h"
 #include "base/strings/pattern.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/thread_pool.h"
 #include "gin/arguments.h"
 #include "gin/object_template_builder.h"
 #include "gin/per_isolate_data.h"
 #include "gin/wrappable.h"
 #include "net/base/data_url.h"
 #include "shell/browser/browser.h"
+#include "shell/common/api/native_image_path_cache.h"
 #include "shell/common/asar/asar_util.h"
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/gfx_converter.h"
@@ -29,10 +33,12 @@
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/function_template_extensions.h"
 #include "shell/common/gin_helper/object_template_builder.h"
+#include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/process_util.h"
 #include "shell/common/skia_util.h"
 #include "shell/common/thread_restrictions.h"
+#include "skia/ext/image_operations.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkPixelRef.h"
@@ -77,6 +83,93 @@ float GetScaleFactorFromOptions(gin::Arguments* args) {
   return scale_factor;
 }
 
+// The layouts toBitmap() and createFromBitmap() can convert pixels to and
+// from. Skia converts between them with its vectorized swizzle and
+// premultiply routines, so callers don't need another pass over the pixels.
+// Skia has no 24-bit color type, so "rgb" is expanded to opaque RGBA by
+// ExpandRGBToRGBA first.
+struct PixelLayout {
+  SkColorType color_type = kN32_SkColorType;
+  SkAlphaType alpha_type = kPremul_SkAlphaType;
+  bool packed_rgb = false;
+
+  size_t bytes_per_pixel() const {
+    return packed_rgb ? 3 : SkColorTypeBytesPerPixel(color_type);
+  }
+};
+
+bool GetPixelLayoutFromOptions(gin_helper::ErrorThrower thrower,
+                               const gin_helper::Dictionary& options,
+                               bool allow_packed_rgb,
+                               PixelLayout* layout) {
+  std::string pixel_format;
+  if (options.Get("pixelFormat", &pixel_format)) {
+    if (pixel_format == "bgra") {
+      layout->color_type = kBGRA_8888_SkColorType;
+    } else if (pixel_format == "rgba") {
+      layout->color_type = kRGBA_8888_SkColorType;
+    } else if (pixel_format == "rgb" && allow_packed_rgb) {
+      layout->color_type = kRGBA_8888_SkColorType;
+      layout->packed_rgb = true;
+    } else {
+      thrower.ThrowError(allow_packed_rgb
+                             ? "pixelFormat must be 'bgra', 'rgba' or 'rgb'"
+                             : "pixelFormat must be 'bgra' or 'rgba'");
+      return false;
+    }
+  }
+
+  std::string alpha_type;
+  if (options.Get("alphaType", &alpha_type)) {
+    if (alpha_type == "premultiplied") {
+      layout->alpha_type = kPremul_SkAlphaType;
+    } else if (alpha_type == "unpremultiplied") {
+      layout->alpha_type = kUnpremul_SkAlphaType;
+    } else {
+      thrower.ThrowError(
+          "alphaType must be 'premultiplied' or 'unpremultiplied'");
+      return false;
+    }
+  }
+  if (layout->packed_rgb)
+    layout->alpha_type = kOpaque_SkAlphaType;
+  return true;
+}
+
+std::vector<uint8_t> ExpandRGBToRGBA(const uint8_t* rgb, size_t pixel_count) {
+  std::vector<uint8_t> rgba(pixel_count * 4);
+  for (size_t i = 0; i < pixel_count; ++i) {
+    rgba[i * 4] = rgb[i * 3];
+    rgba[i * 4 + 1] = rgb[i * 3 + 1];
+    rgba[i * 4 + 2] = rgb[i * 3 + 2];
+    rgba[i * 4 + 3] = 0xff;
+  }
+  return rgba;
+}
+
+// Makes |bitmap| use the pixels of |buffer| in place, keeping its backing
+// store alive until Skia releases them. That can be after the NativeImage is
+// gone, while a copy of the image is still in use. Returns false when the
+// pixels aren't aligned for |info|, in which case they have to be copied.
+bool InstallPixelsFromBuffer(v8::Local<v8::Value> buffer,
+                             const SkImageInfo& info,
+                             SkBitmap* bitmap) {
+  auto view = buffer.As<v8::ArrayBufferView>();
+  auto backing_store = std::make_unique<std::shared_ptr<v8::BackingStore>>(
+      view->Buffer()->GetBackingStore());
+  void* pixels =
+      static_cast<uint8_t*>((*backing_store)->Data()) + view->ByteOffset();
+  if (reinterpret_cast<uintptr_t>(pixels) % info.bytesPerPixel() != 0)
+    return false;
+
+  return bitmap->installPixels(
+      info, pixels, info.minRowBytes(),
+      [](void* /* pixels */, void* context) {
+        delete static_cast<std::shared_ptr<v8::BackingStore>*>(context);
+      },
+      backing_store.release());
+}
+
 base::FilePath NormalizePath(const base::FilePath& path) {
   if (!path.ReferencesParent()) {
     return path;
@@ -99,6 +192,90 @@ bool IsTemplateFilename(const base::FilePath& path) {
 }
 #endif
 
+skia::ImageOperations::ResizeMethod GetResizeMethod(
+    const base::Value::Dict& options) {
+  const std::string* quality = options.FindString("quality");
+  if (quality && *quality == "good")
+    return skia::ImageOperations::ResizeMethod::RESIZE_GOOD;
+  if (quality && *quality == "better")
+    return skia::ImageOperations::ResizeMethod::RESIZE_BETTER;
+  return skia::ImageOperations::ResizeMethod::RESIZE_BEST;
+}
+
+// The async variants decode, encode and resize on the thread pool. ImageSkia
+// is bound to the sequence that uses it, so only the bitmaps of its
+// representations are passed between threads.
+using ImageSkiaReps = std::vector<gfx::ImageSkiaRep>;
+
+constexpr base::TaskTraits kImageTaskTraits = {
+    base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+    base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN};
+
+ImageSkiaReps DecodeImageFromPath(const base::FilePath& path) {
+  gfx::ImageSkia image_skia;
+  electron::util::PopulateImageSkiaRepsFromPath(&image_skia,
+                                                NormalizePath(path));
+  return image_skia.image_reps();
+}
+
+ImageSkiaReps DecodeImageFromBuffer(const std::vector<unsigned char>& data,
+                                    int width,
+                                    int height,
+                                    double scale_factor) {
+  gfx::ImageSkia image_skia;
+  electron::util::AddImageSkiaRepFromBuffer(&image_skia, data.data(),
+                                            data.size(), width, height,
+                                            scale_factor);
+  return image_skia.image_reps();
+}
+
+ImageSkiaReps ResizeImageReps(const ImageSkiaReps& reps,
+                              skia::ImageOperations::ResizeMethod method,
+                              const gfx::Size& size) {
+  ImageSkiaReps resized;
+  for (const auto& image_rep : reps) {
+    gfx::Size rep_size = gfx::ScaleToCeiledSize(size, image_rep.scale());
+    resized.emplace_back(
+        skia::ImageOperations::Resize(image_rep.GetBitmap(), method,
+                                      rep_size.width(), rep_size.height()),
+        image_rep.scale());
+  }
+  return resized;
+}
+
+using IndexedImageSkiaReps = std::pair<size_t, ImageSkiaReps>;
+
+void RunWithIndex(
+    base::RepeatingCallback<void(IndexedImageSkiaReps)> callback,
+    size_t index,
+    ImageSkiaReps image_reps) {
+  callback.Run({index, std::move(image_reps)});
+}
+
+std::vector<unsigned char> EncodePNG(const SkBitmap& bitmap) {
+  std::vector<unsigned char> encoded;
+  gfx::PNGCodec::EncodeBGRASkBitmap(bitmap, false, &encoded);
+  return encoded;
+}
+
+std::vector<unsigned char> EncodeJPEG(const SkBitmap& bitmap, int quality) {
+  std::vector<unsigned char> encoded;
+  if (!gfx::JPEGCodec::Encode(bitmap, quality, &encoded))
+    encoded.clear();
+  return encoded;
+}
+
+void ResolveWithBuffer(gin_helper::Promise<v8::Local<v8::Value>> promise,
+                       std::vector<unsigned char> data) {
+  v8::Isolate* isolate = promise.isolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise.GetContext());
+  promise.Resolve(node::Buffer::Copy(isolate,
+                                     reinterpret_cast<const char*>(data.data()),
+                                     data.size())
+                      .ToLocalChecked());
+}
+
 #if BUILDFLAG(IS_WIN)
 base::win::ScopedHICON ReadICOFromPath(int size, const base::FilePath& path) {
   // If file is in asar archive, we extract it to a temp file so LoadImage can
@@ -148,7 +325,7 @@ NativeImage::~NativeImage() {
 void NativeImage::UpdateExternalAllocatedMemoryUsage() {
   int32_t new_memory_usage = 0;
 
-  if (image_.HasRepresentation(gfx::Image::kImageRepSkia)) {
+  if (!is_shared_ && image_.HasRepresentation(gfx::Image::kImageRepSkia)) {
     auto* const image_skia = image_.ToImageSkia();
     if (!image_skia->isNull()) {
       new_memory_usage = image_skia->bitmap()->computeByteSize();
@@ -160,6 +337,50 @@ void NativeImage::UpdateExternalAllocatedMemoryUsage() {
   memory_usage_ = new_memory_usage;
 }
 
+void NativeImage::LoadSharedScaleFactors() {
+  if (!is_shared_)
+    return;
+  const gfx::ImageSkia* image_skia = image_.ToImageSkia();
+  for (float scale : shared_scale_factors_)
+    image_skia->GetRepresentation(scale);
+}
+
+// static
+void NativeImage::ResolveWithImage(
+    gin_helper::Promise<gin::Handle<NativeImage>> promise,
+    bool is_template,
+    std::vector<gfx::ImageSkiaRep> image_reps) {
+  v8::Isolate* isolate = promise.isolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise.GetContext());
+
+  gfx::ImageSkia image_skia;
+  for (const auto& image_rep : image_reps)
+    image_skia.AddRepresentation(image_rep);
+  gin::Handle<NativeImage> image = Create(isolate, gfx::Image(image_skia));
+  if (is_template)
+    image->SetTemplateImage(true);
+  promise.Resolve(image);
+}
+
+// static
+void NativeImage::ResolveWithImages(
+    gin_helper::Promise<std::vector<gin::Handle<NativeImage>>> promise,
+    std::vector<IndexedImageSkiaReps> results) {
+  v8::Isolate* isolate = promise.isolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise.GetContext());
+
+  std::vector<gin::Handle<NativeImage>> images(results.size());
+  for (const auto& [index, image_reps] : results) {
+    gfx::ImageSkia image_skia;
+    for (const auto& image_rep : image_reps)
+      image_skia.AddRepresentation(image_rep);
+    images[index] = Create(isolate, gfx::Image(image_skia));
+  }
+  promise.Resolve(images);
+}
+
 // static
 bool NativeImage::TryConvertNativeImage(v8::Isolate* isolate,
                                         v8::Local<v8::Value> image,
@@ -245,13 +466,21 @@ v8::Local<v8::Value> NativeImage::ToPNG(gin::Arguments* args) {
 }
 
 v8::Local<v8::Value> NativeImage::ToBitmap(gin::Arguments* args) {
-  float scale_factor = GetScaleFactorFromOptions(args);
+  float scale_factor = 1.0f;
+  PixelLayout layout;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("scaleFactor", &scale_factor);
+    if (!GetPixelLayoutFromOptions(gin_helper::ErrorThrower(args->isolate()),
+                                   options, false, &layout))
+      return v8::Undefined(args->isolate());
+  }
 
   const SkBitmap bitmap =
       image_.AsImageSkia().GetRepresentation(scale_factor).GetBitmap();
 
-  SkImageInfo info =
-      SkImageInfo::MakeN32Premul(bitmap.width(), bitmap.height());
+  SkImageInfo info = SkImageInfo::Make(bitmap.width(), bitmap.height(),
+                                       layout.color_type, layout.alpha_type);
 
   auto array_buffer =
       v8::ArrayBuffer::New(args->isolate(), info.computeMinByteSize());
@@ -276,6 +505,42 @@ v8::Local<v8::Value> NativeImage::ToJPEG(v8::Isolate* isolate, int quality) {
       .ToLocalChecked();
 }
 
+v8::Local<v8::Promise> NativeImage::ToPNGAsync(gin::Arguments* args) {
+  gin_helper::Promise<v8::Local<v8::Value>> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  float scale_factor = GetScaleFactorFromOptions(args);
+
+  if (scale_factor == 1.0f) {
+    // Use raw 1x PNG bytes when available
+    scoped_refptr<base::RefCountedMemory> png = image_.As1xPNGBytes();
+    if (png->size() > 0) {
+      const char* data = reinterpret_cast<const char*>(png->front());
+      promise.Resolve(
+          node::Buffer::Copy(args->isolate(), data, png->size())
+              .ToLocalChecked());
+      return handle;
+    }
+  }
+
+  const SkBitmap bitmap =
+      image_.AsImageSkia().GetRepresentation(scale_factor).GetBitmap();
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, kImageTaskTraits, base::BindOnce(&EncodePNG, bitmap),
+      base::BindOnce(&ResolveWithBuffer, std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Promise> NativeImage::ToJPEGAsync(v8::Isolate* isolate,
+                                                int quality) {
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, kImageTaskTraits,
+      base::BindOnce(&EncodeJPEG, image_.AsBitmap(), quality),
+      base::BindOnce(&ResolveWithBuffer, std::move(promise)));
+  return handle;
+}
+
 std::string NativeImage::ToDataURL(gin::Arguments* args) {
   float scale_factor = GetScaleFactorFromOptions(args);
 
@@ -332,6 +597,7 @@ gfx::Size NativeImage::GetSize(const std::optional<float> scale_factor) {
 }
 
 std::vector<float> NativeImage::GetScaleFactors() {
+  LoadSharedScaleFactors();
   gfx::ImageSkia image_skia = image_.AsImageSkia();
   std::vector<float> scale_factors;
   for (const auto& rep : image_skia.image_reps()) {
@@ -349,10 +615,9 @@ float NativeImage::GetAspectRatio(const std::optional<float> scale_factor) {
     return static_cast<float>(size.width()) / static_cast<float>(size.height());
 }
 
-gin::Handle<NativeImage> NativeImage::Resize(gin::Arguments* args,
-                                             base::Value::Dict options) {
-  float scale_factor = GetScaleFactorFromOptions(args);
-
+std::optional<gfx::Size> NativeImage::GetResizedSize(
+    float scale_factor,
+    const base::Value::Dict& options) {
   gfx::Size size = GetSize(scale_factor);
   std::optional<int> new_width = options.FindInt("width");
   std::optional<int> new_height = options.FindInt("height");
@@ -361,7 +626,7 @@ gin::Handle<NativeImage> NativeImage::Resize(gin::Arguments* args,
   size.SetSize(width, height);
 
   if (width <= 0 && height <= 0) {
-    return CreateEmpty(args->isolate());
+    return std::nullopt;
   } else if (new_width && !new_height) {
     // Scale height to preserve original aspect ratio
     size.set_height(width);
@@ -372,21 +637,75 @@ gin::Handle<NativeImage> NativeImage::Resize(gin::Arguments* args,
     size.set_width(height);
     size = gfx::ScaleToRoundedSize(size, GetAspectRatio(scale_factor), 1.f);
   }
+  return size;
+}
 
-  skia::ImageOperations::ResizeMethod method =
-      skia::ImageOperations::ResizeMethod::RESIZE_BEST;
-  std::string* quality = options.FindString("quality");
-  if (quality && *quality == "good")
-    method = skia::ImageOperations::ResizeMethod::RESIZE_GOOD;
-  else if (quality && *quality == "better")
-    method = skia::ImageOperations::ResizeMethod::RESIZE_BETTER;
+gin::Handle<NativeImage> NativeImage::Resize(gin::Arguments* args,
+                                             base::Value::Dict options) {
+  float scale_factor = GetScaleFactorFromOptions(args);
+  std::optional<gfx::Size> size = GetResizedSize(scale_factor, options);
+  if (!size)
+    return CreateEmpty(args->isolate());
 
   gfx::ImageSkia resized = gfx::ImageSkiaOperations::CreateResizedImage(
-      image_.AsImageSkia(), method, size);
+      image_.AsImageSkia(), GetResizeMethod(options), *size);
   return gin::CreateHandle(
       args->isolate(), new NativeImage(args->isolate(), gfx::Image(resized)));
 }
 
+v8::Local<v8::Promise> NativeImage::ResizeAsync(gin::Arguments* args,
+                                                base::Value::Dict options) {
+  gin_helper::Promise<gin::Handle<NativeImage>> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  float scale_factor = GetScaleFactorFromOptions(args);
+  std::optional<gfx::Size> size = GetResizedSize(scale_factor, options);
+  if (!size) {
+    promise.Resolve(CreateEmpty(args->isolate()));
+    return handle;
+  }
+
+  LoadSharedScaleFactors();
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, kImageTaskTraits,
+      base::BindOnce(&ResizeImageReps, image_.AsImageSkia().image_reps(),
+                     GetResizeMethod(options), *size),
+      base::BindOnce(&ResolveWithImage, std::move(promise), false));
+  return handle;
+}
+
+// static
+v8::Local<v8::Promise> NativeImage::ResizeAllAsync(
+    v8::Isolate* isolate,
+    const std::vector<gin::Handle<NativeImage>>& images,
+    base::Value::Dict options) {
+  gin_helper::Promise<std::vector<gin::Handle<NativeImage>>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  // Every image is resized in a task of its own so that the thread pool can
+  // spread them over its workers, and the promise is only resolved once, when
+  // the last one is done.
+  auto barrier = base::BarrierCallback<IndexedImageSkiaReps>(
+      images.size(),
+      base::BindOnce(&NativeImage::ResolveWithImages, std::move(promise)));
+  auto method = GetResizeMethod(options);
+  for (size_t i = 0; i < images.size(); ++i) {
+    NativeImage* image = images[i].get();
+    std::optional<gfx::Size> size = image->GetResizedSize(1.0f, options);
+    if (!size) {
+      barrier.Run({i, ImageSkiaReps()});
+      continue;
+    }
+
+    image->LoadSharedScaleFactors();
+    base::ThreadPool::PostTaskAndReplyWithResult(
+        FROM_HERE, kImageTaskTraits,
+        base::BindOnce(&ResizeImageReps,
+                       image->image_.AsImageSkia().image_reps(), method, *size),
+        base::BindOnce(&RunWithIndex, barrier, i));
+  }
+  return handle;
+}
+
 gin::Handle<NativeImage> NativeImage::Crop(v8::Isolate* isolate,
                                            const gfx::Rect& rect) {
   gfx::ImageSkia cropped =
@@ -405,6 +724,12 @@ void NativeImage::AddRepresentation(const gin_helper::Dictionary& options) {
 
   bool skia_rep_added = false;
   gfx::ImageSkia image_skia = image_.AsImageSkia();
+  // Copies of an ImageSkia share their representations, so the ones shared
+  // with the createFromPath() cache must not be added to.
+  if (is_shared_) {
+    LoadSharedScaleFactors();
+    image_skia = image_skia.DeepCopy();
+  }
 
   v8::Local<v8::Value> buffer;
   GURL url;
@@ -427,10 +752,14 @@ void NativeImage::AddRepresentation(const gin_helper::Dictionary& options) {
     }
   }
 
-  // Re-initialize image when first representation is added to an empty image
-  if (skia_rep_added && IsEmpty()) {
+  // Re-initialize image when first representation is added to an empty image,
+  // or to the copy of a shared one
+  if (skia_rep_added && (IsEmpty() || is_shared_)) {
     gfx::Image image(image_skia);
     image_ = std::move(image);
+    is_shared_ = false;
+    shared_scale_factors_.clear();
+    UpdateExternalAllocatedMemoryUsage();
   }
 }
 
@@ -483,10 +812,15 @@ gin::Handle<NativeImage> NativeImage::CreateFromPath(
     return gin::CreateHandle(isolate, new NativeImage(isolate, image_path));
   }
 #endif
-  gfx::ImageSkia image_skia;
-  electron::util::PopulateImageSkiaRepsFromPath(&image_skia, image_path);
-  gfx::Image image(image_skia);
-  gin::Handle<NativeImage> handle = Create(isolate, image);
+  NativeImagePathCache::Image cached =
+      NativeImagePathCache::GetInstance()->Get(isolate, image_path);
+  gin::Handle<NativeImage> handle =
+      Create(isolate, gfx::Image(cached.image_skia));
+  if (cached.shared) {
+    handle->is_shared_ = true;
+    handle->shared_scale_factors_ = std::move(cached.scale_factors);
+    handle->UpdateExternalAllocatedMemoryUsage();
+  }
 #if BUILDFLAG(IS_MAC)
   if (IsTemplateFilename(image_path))
     handle->SetTemplateImage(true);
@@ -518,10 +852,21 @@ gin::Handle<NativeImage> NativeImage::CreateFromBitmap(
     return gin::Handle<NativeImage>();
   }
 
-  auto info = SkImageInfo::MakeN32(width, height, kPremul_SkAlphaType);
-  auto size_bytes = info.computeMinByteSize();
+  PixelLayout layout;
+  if (!GetPixelLayoutFromOptions(thrower, options, true, &layout))
+    return gin::Handle<NativeImage>();
+
+  bool copy = true;
+  options.Get("copy", &copy);
+  if (!copy && (layout.packed_rgb || layout.color_type != kN32_SkColorType ||
+                layout.alpha_type != kPremul_SkAlphaType)) {
+    thrower.ThrowError(
+        "copy: false requires the pixel layout returned by toBitmap()");
+    return gin::Handle<NativeImage>();
+  }
 
-  if (size_bytes != node::Buffer::Length(buffer)) {
+  size_t pixel_count = static_cast<size_t>(width) * height;
+  if (pixel_count * layout.bytes_per_pixel() != node::Buffer::Length(buffer)) {
     thrower.ThrowError("invalid buffer size");
     return gin::Handle<NativeImage>();
   }
@@ -532,9 +877,21 @@ gin::Handle<NativeImage> NativeImage::CreateFromBitmap(
     return CreateEmpty(thrower.isolate());
   }
 
+  const auto* data =
+      reinterpret_cast<const uint8_t*>(node::Buffer::Data(buffer));
+  std::vector<uint8_t> rgba;
+  if (layout.packed_rgb) {
+    rgba = ExpandRGBToRGBA(data, pixel_count);
+    data = rgba.data();
+  }
+
+  auto info = SkImageInfo::Make(width, height, layout.color_type,
+                                layout.alpha_type);
   SkBitmap bitmap;
-  bitmap.allocN32Pixels(width, height, false);
-  bitmap.writePixels({info, node::Buffer::Data(buffer), bitmap.rowBytes()});
+  if (copy || !InstallPixelsFromBuffer(buffer, info, &bitmap)) {
+    bitmap.allocN32Pixels(width, height, layout.packed_rgb);
+    bitmap.writePixels({info, data, info.minRowBytes()});
+  }
 
   gfx::ImageSkia image_skia =
       gfx::ImageSkia::CreateFromBitmap(bitmap, scale_factor);
@@ -570,6 +927,67 @@ gin::Handle<NativeImage> NativeImage::CreateFromBuffer(
   return Create(args->isolate(), gfx::Image(image_skia));
 }
 
+// static
+v8::Local<v8::Promise> NativeImage::CreateFromPathAsync(
+    v8::Isolate* isolate,
+    const base::FilePath& path) {
+  gin_helper::Promise<gin::Handle<NativeImage>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+#if BUILDFLAG(IS_WIN)
+  // Icons are loaded as HICONs of the size asked for when they are used.
+  if (path.MatchesExtension(FILE_PATH_LITERAL(".ico"))) {
+    promise.Resolve(CreateFromPath(isolate, path));
+    return handle;
+  }
+#endif
+  bool is_template = false;
+#if BUILDFLAG(IS_MAC)
+  is_template = IsTemplateFilename(path);
+#endif
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, kImageTaskTraits, base::BindOnce(&DecodeImageFromPath, path),
+      base::BindOnce(&NativeImage::ResolveWithImage, std::move(promise),
+                     is_template));
+  return handle;
+}
+
+// static
+v8::Local<v8::Promise> NativeImage::CreateFromBufferAsync(
+    gin_helper::ErrorThrower thrower,
+    v8::Local<v8::Value> buffer,
+    gin::Arguments* args) {
+  if (!node::Buffer::HasInstance(buffer)) {
+    thrower.ThrowError("buffer must be a node Buffer");
+    return v8::Local<v8::Promise>();
+  }
+
+  int width = 0;
+  int height = 0;
+  double scale_factor = 1.;
+
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("width", &width);
+    options.Get("height", &height);
+    options.Get("scaleFactor", &scale_factor);
+  }
+
+  // The buffer can be changed once this returns, so decode a copy of it.
+  const auto* data =
+      reinterpret_cast<const unsigned char*>(node::Buffer::Data(buffer));
+  std::vector<unsigned char> copy(data, data + node::Buffer::Length(buffer));
+
+  gin_helper::Promise<gin::Handle<NativeImage>> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, kImageTaskTraits,
+      base::BindOnce(&DecodeImageFromBuffer, std::move(copy), width, height,
+                     scale_factor),
+      base::BindOnce(&NativeImage::ResolveWithImage, std::move(promise),
+                     false));
+  return handle;
+}
+
 // static
 gin::Handle<NativeImage> NativeImage::CreateFromDataURL(v8::Isolate* isolate,
                                                         const GURL& url) {
@@ -607,6 +1025,8 @@ gin::ObjectTemplateBuilder NativeImage::GetObjectTemplateBuilder(
                                     constructor->InstanceTemplate())
       .SetMethod("toPNG", &NativeImage::ToPNG)
       .SetMethod("toJPEG", &NativeImage::ToJPEG)
+      .SetMethod("toPNGAsync", &NativeImage::ToPNGAsync)
+      .SetMethod("toJPEGAsync", &NativeImage::ToJPEGAsync)
       .SetMethod("toBitmap", &NativeImage::ToBitmap)
       .SetMethod("getBitmap", &NativeImage::GetBitmap)
       .SetMethod("getScaleFactors", &NativeImage::GetScaleFactors)
@@ -619,6 +1039,7 @@ gin::ObjectTemplateBuilder NativeImage::GetObjectTemplateBuilder(
       .SetProperty("isMacTemplateImage", &NativeImage::IsTemplateImage,
                    &NativeImage::SetTemplateImage)
       .SetMethod("resize", &NativeImage::Resize)
+      .SetMethod("resizeAsync", &NativeImage::ResizeAsync)
       .SetMethod("crop", &NativeImage::Crop)
       .SetMethod("getAspectRatio", &NativeImage::GetAspectRatio)
       .SetMethod("addRepresentation", &NativeImage::AddRepresentation);
@@ -650,6 +1071,11 @@ void Initialize(v8::Local<v8::Object> exports,
   native_image.SetMethod("createFromPath", &NativeImage::CreateFromPath);
   native_image.SetMethod("createFromBitmap", &NativeImage::CreateFromBitmap);
   native_image.SetMethod("createFromBuffer", &NativeImage::CreateFromBuffer);
+  native_image.SetMethod("createFromPathAsync",
+                         &NativeImage::CreateFromPathAsync);
+  native_image.SetMethod("createFromBufferAsync",
+                         &NativeImage::CreateFromBufferAsync);
+  native_image.SetMethod("resizeAllAsync", &NativeImage::ResizeAllAsync);
   native_image.SetMethod("createFromDataURL", &NativeImage::CreateFromDataURL);
   native_image.SetMethod("createFromNamedImage",
                          &NativeImage::CreateFromNamedImage);
@@ -5,7 +5,9 @@
 #ifndef ELECTRON_SHELL_COMMON_API_ELECTRON_API_NATIVE_IMAGE_H_
 #define ELECTRON_SHELL_COMMON_API_ELECTRON_API_NATIVE_IMAGE_H_
 
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "base/containers/flat_map.h"
@@ -41,6 +43,11 @@ namespace gin {
 class Arguments;
 }
 
+namespace gin_helper {
+template <typename T>
+class Promise;
+}  // namespace gin_helper
+
 namespace electron::api {
 
 class NativeImage : public gin::Wrappable<NativeImage> {
@@ -74,6 +81,17 @@ class NativeImage : public gin::Wrappable<NativeImage> {
       gin_helper::ErrorThrower thrower,
       v8::Local<v8::Value> buffer,
       gin::Arguments* args);
+  static v8::Local<v8::Promise> CreateFromPathAsync(
+      v8::Isolate* isolate,
+      const base::FilePath& path);
+  static v8::Local<v8::Promise> CreateFromBufferAsync(
+      gin_helper::ErrorThrower thrower,
+      v8::Local<v8::Value> buffer,
+      gin::Arguments* args);
+  static v8::Local<v8::Promise> ResizeAllAsync(
+      v8::Isolate* isolate,
+      const std::vector<gin::Handle<NativeImage>>& images,
+      base::Value::Dict options);
   static gin::Handle<NativeImage> CreateFromDataURL(v8::Isolate* isolate,
                                                     const GURL& url);
   static gin::Handle<NativeImage> CreateFromNamedImage(gin::Arguments* args,
@@ -108,12 +126,20 @@ class NativeImage : public gin::Wrappable<NativeImage> {
  private:
   v8::Local<v8::Value> ToPNG(gin::Arguments* args);
   v8::Local<v8::Value> ToJPEG(v8::Isolate* isolate, int quality);
+  v8::Local<v8::Promise> ToPNGAsync(gin::Arguments* args);
+  v8::Local<v8::Promise> ToJPEGAsync(v8::Isolate* isolate, int quality);
   v8::Local<v8::Value> ToBitmap(gin::Arguments* args);
   std::vector<float> GetScaleFactors();
   v8::Local<v8::Value> GetBitmap(gin::Arguments* args);
   v8::Local<v8::Value> GetNativeHandle(gin_helper::ErrorThrower thrower);
   gin::Handle<NativeImage> Resize(gin::Arguments* args,
                                   base::Value::Dict options);
+  v8::Local<v8::Promise> ResizeAsync(gin::Arguments* args,
+                                     base::Value::Dict options);
+  // Returns the size |options| of resize() ask for, or nullopt when the result
+  // should be an empty image.
+  std::optional<gfx::Size> GetResizedSize(float scale_factor,
+                                          const base::Value::Dict& options);
   gin::Handle<NativeImage> Crop(v8::Isolate* isolate, const gfx::Rect& rect);
   std::string ToDataURL(gin::Arguments* args);
   bool IsEmpty();
@@ -123,6 +149,22 @@ class NativeImage : public gin::Wrappable<NativeImage> {
 
   void UpdateExternalAllocatedMemoryUsage();
 
+  // Decodes the scale variants of a shared image that haven't been used yet.
+  void LoadSharedScaleFactors();
+
+  // Resolves |promise| with an image made of |image_reps|, which were decoded
+  // or resized off the thread that uses the image.
+  static void ResolveWithImage(
+      gin_helper::Promise<gin::Handle<NativeImage>> promise,
+      bool is_template,
+      std::vector<gfx::ImageSkiaRep> image_reps);
+
+  // Resolves |promise| with the images made of |results| once all of them
+  // have been resized, in the order of the index each result comes with.
+  static void ResolveWithImages(
+      gin_helper::Promise<std::vector<gin::Handle<NativeImage>>> promise,
+      std::vector<std::pair<size_t, std::vector<gfx::ImageSkiaRep>>> results);
+
   // Mark the image as template image.
   void SetTemplateImage(bool setAsTemplate);
   // Determine if the image is a template image.
@@ -137,6 +179,12 @@ class NativeImage : public gin::Wrappable<NativeImage> {
 
   gfx::Image image_;
 
+  // Set while |image_| is shared with the createFromPath() cache, which owns
+  // its memory and reports it to the isolate once for all of its users.
+  // |shared_scale_factors_| are the scales it has a file for.
+  bool is_shared_ = false;
+  std::vector<float> shared_scale_factors_;
+
   raw_ptr<v8::Isolate> isolate_;
   int32_t memory_usage_ = 0;
 };
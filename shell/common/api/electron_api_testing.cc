@@ -5,7 +5,9 @@
 #include "base/dcheck_is_on.h"
 #include "base/logging.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "base/time/time.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/v8_value_serializer.h"
 #include "v8/include/v8.h"
 
 #if DCHECK_IS_ON()
@@ -34,12 +36,21 @@ void Log(int severity, std::string text) {
   }
 }
 
+// A negative |delay_ms| drops the regions altogether, as if the sender had
+// gone away before writing them.
+void SetSharedArrayBufferRegionsDelay(double delay_ms) {
+  electron::SetSharedArrayBufferRegionsDelayForTesting(
+      delay_ms < 0 ? base::TimeDelta::Max() : base::Milliseconds(delay_ms));
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
                 void* priv) {
   gin_helper::Dictionary dict(context->GetIsolate(), exports);
   dict.SetMethod("log", &Log);
+  dict.SetMethod("setSharedArrayBufferRegionsDelay",
+                 &SetSharedArrayBufferRegionsDelay);
 }
 
 }  // namespace
@@ -5,6 +5,7 @@
 #include "shell/common/api/electron_api_url_loader.h"
 
 #include <algorithm>
+#include <limits>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -38,6 +39,7 @@
 #include "shell/browser/net/proxying_url_loader_factory.h"
 #include "shell/browser/protocol_registry.h"
 #include "shell/common/gin_converters/callback_converter.h"
+#include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_converters/net_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
@@ -326,10 +328,12 @@ gin::WrapperInfo SimpleURLLoaderWrapper::kWrapperInfo = {
 SimpleURLLoaderWrapper::SimpleURLLoaderWrapper(
     ElectronBrowserContext* browser_context,
     std::unique_ptr<network::ResourceRequest> request,
-    int options)
+    int options,
+    base::FilePath download_path)
     : browser_context_(browser_context),
       request_options_(options),
-      request_(std::move(request)) {
+      request_(std::move(request)),
+      download_path_(std::move(download_path)) {
   DETACH_FROM_SEQUENCE(sequence_checker_);
   if (!request_->trusted_params)
     request_->trusted_params = network::ResourceRequest::TrustedParams();
@@ -378,7 +382,15 @@ void SimpleURLLoaderWrapper::Start() {
       &SimpleURLLoaderWrapper::OnDownloadProgress, base::Unretained(this)));
 
   url_loader_factory_ = GetURLLoaderFactoryForURL(request_ref->url);
-  loader_->DownloadAsStream(url_loader_factory_.get(), this);
+  if (!download_path_.empty()) {
+    loader_->DownloadToFile(
+        url_loader_factory_.get(),
+        base::BindOnce(&SimpleURLLoaderWrapper::OnDownloadedToFile,
+                       base::Unretained(this)),
+        download_path_);
+  } else {
+    loader_->DownloadAsStream(url_loader_factory_.get(), this);
+  }
 }
 
 void SimpleURLLoaderWrapper::Pin() {
@@ -497,10 +509,8 @@ SimpleURLLoaderWrapper::GetURLLoaderFactoryForURL(const GURL& url) {
             std::move(pending_remote)));
   } else if (!bypass_custom_protocol_handlers &&
              protocol_registry->IsProtocolRegistered(url.scheme())) {
-    auto& protocol_handler = protocol_registry->handlers().at(url.scheme());
     mojo::PendingRemote<network::mojom::URLLoaderFactory> pending_remote =
-        ElectronURLLoaderFactory::Create(protocol_handler.first,
-                                         protocol_handler.second);
+        protocol_registry->CreateURLLoaderFactoryForProtocol(url.scheme());
     url_loader_factory = network::SharedURLLoaderFactory::Create(
         std::make_unique<network::WrapperPendingSharedURLLoaderFactory>(
             std::move(pending_remote)));
@@ -649,6 +659,9 @@ gin::Handle<SimpleURLLoaderWrapper> SimpleURLLoaderWrapper::Create(
   if (bypass_custom_protocol_handlers)
     options |= kBypassCustomProtocolHandlers;
 
+  base::FilePath download_path;
+  opts.Get("downloadPath", &download_path);
+
   v8::Local<v8::Value> body;
   v8::Local<v8::Value> chunk_pipe_getter;
   if (opts.Get("body", &body)) {
@@ -675,6 +688,24 @@ gin::Handle<SimpleURLLoaderWrapper> SimpleURLLoaderWrapper::Create(
     }
   }
 
+  // The network service reads the file itself, so the body never passes
+  // through this process.
+  gin_helper::Dictionary body_file;
+  if (opts.Get("bodyFile", &body_file)) {
+    base::FilePath path;
+    uint64_t offset = 0;
+    int64_t length = -1;
+    body_file.Get("path", &path);
+    body_file.Get("offset", &offset);
+    body_file.Get("length", &length);
+    request->request_body =
+        base::MakeRefCounted<network::ResourceRequestBody>();
+    request->request_body->AppendFileRange(
+        path, offset,
+        length < 0 ? std::numeric_limits<uint64_t>::max() : length,
+        base::Time());
+  }
+
   ElectronBrowserContext* browser_context = nullptr;
   if (electron::IsBrowserProcess()) {
     std::string partition;
@@ -690,7 +721,8 @@ gin::Handle<SimpleURLLoaderWrapper> SimpleURLLoaderWrapper::Create(
 
   auto ret = gin::CreateHandle(
       args->isolate(),
-      new SimpleURLLoaderWrapper(browser_context, std::move(request), options));
+      new SimpleURLLoaderWrapper(browser_context, std::move(request), options,
+                                 std::move(download_path)));
   ret->Pin();
   if (!chunk_pipe_getter.IsEmpty()) {
     ret->PinBodyGetter(chunk_pipe_getter);
@@ -723,6 +755,11 @@ void SimpleURLLoaderWrapper::OnComplete(bool success) {
 
 void SimpleURLLoaderWrapper::OnRetry(base::OnceClosure start_retry) {}
 
+void SimpleURLLoaderWrapper::OnDownloadedToFile(base::FilePath path) {
+  // SimpleURLLoader passes an empty path, and deletes the file, on failure.
+  OnComplete(!path.empty());
+}
+
 void SimpleURLLoaderWrapper::OnResponseStarted(
     const GURL& final_url,
     const network::mojom::URLResponseHead& response_head) {
@@ -9,6 +9,7 @@
 #include <string>
 #include <vector>
 
+#include "base/files/file_path.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
@@ -63,7 +64,8 @@ class SimpleURLLoaderWrapper
  private:
   SimpleURLLoaderWrapper(ElectronBrowserContext* browser_context,
                          std::unique_ptr<network::ResourceRequest> request,
-                         int options);
+                         int options,
+                         base::FilePath download_path);
 
   // SimpleURLLoaderStreamConsumer:
   void OnDataReceived(base::StringPiece string_piece,
@@ -131,6 +133,7 @@ class SimpleURLLoaderWrapper
                   std::vector<std::string>* removed_headers);
   void OnUploadProgress(uint64_t position, uint64_t total);
   void OnDownloadProgress(uint64_t current);
+  void OnDownloadedToFile(base::FilePath path);
 
   void Start();
   void Pin();
@@ -140,6 +143,9 @@ class SimpleURLLoaderWrapper
   raw_ptr<ElectronBrowserContext> browser_context_;
   int request_options_;
   std::unique_ptr<network::ResourceRequest> request_;
+  // When not empty, the response body is written to this file by the network
+  // stack instead of being emitted chunk by chunk.
+  base::FilePath download_path_;
   scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
   std::unique_ptr<network::SimpleURLLoader> loader_;
   v8::Global<v8::Value> pinned_wrapper_;
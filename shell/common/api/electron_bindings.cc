@@ -18,18 +18,35 @@
 #include "services/resource_coordinator/public/cpp/memory_instrumentation/memory_instrumentation.h"
 #include "shell/browser/browser.h"
 #include "shell/common/application_info.h"
+#include "shell/common/cpu_profiler.h"
+#include "shell/common/electron_histograms.h"
 #include "shell/common/gin_converters/file_path_converter.h"
+#include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/microtasks_scope.h"
 #include "shell/common/gin_helper/promise.h"
 #include "shell/common/heap_snapshot.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/process_util.h"
+#include "shell/common/shared_memory_array_buffer.h"
+#include "shell/common/startup_timings.h"
 #include "shell/common/thread_restrictions.h"
 #include "third_party/blink/renderer/platform/heap/process_heap.h"  // nogncheck
 
 namespace electron {
 
+namespace {
+
+v8::Local<v8::Value> CreateSharedArrayBuffer(v8::Isolate* isolate,
+                                             uint32_t size) {
+  v8::Local<v8::SharedArrayBuffer> buffer;
+  if (!CreateSharedMemoryArrayBuffer(isolate, size).ToLocal(&buffer))
+    return v8::Undefined(isolate);
+  return buffer;
+}
+
+}  // namespace
+
 ElectronBindings::ElectronBindings(uv_loop_t* loop) {
   uv_async_init(loop, call_next_tick_async_.get(), OnCallNextTick);
   call_next_tick_async_.get()->data = this;
@@ -46,6 +63,8 @@ void ElectronBindings::BindProcess(v8::Isolate* isolate,
   process->SetMethod("crash", &Crash);
   process->SetMethod("hang", &Hang);
   process->SetMethod("getCreationTime", &GetCreationTime);
+  process->SetMethod("getStartupTimings", &GetStartupTimings);
+  process->SetMethod("getHistograms", &GetHistograms);
   process->SetMethod("getHeapStatistics", &GetHeapStatistics);
   process->SetMethod("getBlinkMemoryInfo", &GetBlinkMemoryInfo);
   if (electron::IsBrowserProcess()) {
@@ -74,6 +93,11 @@ void ElectronBindings::BindTo(v8::Isolate* isolate,
   BindProcess(isolate, &dict, metrics_.get());
 
   dict.SetMethod("takeHeapSnapshot", &TakeHeapSnapshot);
+  dict.SetMethod("startCpuProfiler", &StartCpuProfiler);
+  dict.SetMethod("stopCpuProfiler", &StopCpuProfiler);
+  // Renderers post messages with blink, which cannot share these.
+  if (IsBrowserProcess() || IsUtilityProcess())
+    dict.SetMethod("createSharedArrayBuffer", &CreateSharedArrayBuffer);
 #if BUILDFLAG(IS_POSIX)
   dict.SetMethod("setFdLimit", &base::IncreaseFdLimitTo);
 #endif
@@ -163,6 +187,29 @@ v8::Local<v8::Value> ElectronBindings::GetCreationTime(v8::Isolate* isolate) {
   return v8::Number::New(isolate, jsTime);
 }
 
+// static
+v8::Local<v8::Value> ElectronBindings::GetStartupTimings(v8::Isolate* isolate) {
+  // Timings are kept as ticks, so convert them to wall clock time against a
+  // single reading of both clocks.
+  const base::TimeTicks now_ticks = base::TimeTicks::Now();
+  const base::Time now = base::Time::Now();
+  std::vector<gin_helper::Dictionary> timings;
+  for (const auto& timing : electron::GetStartupTimings()) {
+    auto dict = gin_helper::Dictionary::CreateEmpty(isolate);
+    dict.Set("name", timing.name);
+    const base::Time start = now - (now_ticks - timing.start);
+    dict.Set("startTime", start.InMillisecondsFSinceUnixEpoch());
+    dict.Set("duration", (timing.end - timing.start).InMillisecondsF());
+    timings.push_back(dict);
+  }
+  return gin::ConvertToV8(isolate, timings);
+}
+
+// static
+v8::Local<v8::Value> ElectronBindings::GetHistograms(v8::Isolate* isolate) {
+  return gin::ConvertToV8(isolate, histograms::GetHistogramSnapshots());
+}
+
 // static
 v8::Local<v8::Value> ElectronBindings::GetSystemMemoryInfo(
     v8::Isolate* isolate,
@@ -302,4 +349,28 @@ bool ElectronBindings::TakeHeapSnapshot(v8::Isolate* isolate,
   return electron::TakeHeapSnapshot(isolate, &file);
 }
 
+// static
+bool ElectronBindings::StartCpuProfiler(gin_helper::Arguments* args) {
+  double sampling_interval = 1000;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options) && options.Has("samplingInterval") &&
+      (!options.Get("samplingInterval", &sampling_interval) ||
+       sampling_interval < 1)) {
+    args->ThrowTypeError("'samplingInterval' must be a positive number");
+    return false;
+  }
+
+  return electron::StartCpuProfiler(
+      args->isolate(),
+      base::Microseconds(static_cast<int64_t>(sampling_interval)));
+}
+
+// static
+v8::Local<v8::Value> ElectronBindings::StopCpuProfiler(v8::Isolate* isolate) {
+  std::optional<base::Value::Dict> profile = electron::StopCpuProfiler(isolate);
+  if (!profile)
+    return v8::Null(isolate);
+  return gin::ConvertToV8(isolate, *profile);
+}
+
 }  // namespace electron
@@ -63,6 +63,8 @@ class ElectronBindings {
   static void Hang();
   static v8::Local<v8::Value> GetHeapStatistics(v8::Isolate* isolate);
   static v8::Local<v8::Value> GetCreationTime(v8::Isolate* isolate);
+  static v8::Local<v8::Value> GetStartupTimings(v8::Isolate* isolate);
+  static v8::Local<v8::Value> GetHistograms(v8::Isolate* isolate);
   static v8::Local<v8::Value> GetSystemMemoryInfo(v8::Isolate* isolate,
                                                   gin_helper::Arguments* args);
   static v8::Local<v8::Promise> GetProcessMemoryInfo(v8::Isolate* isolate);
@@ -71,6 +73,8 @@ class ElectronBindings {
                                           v8::Isolate* isolate);
   static bool TakeHeapSnapshot(v8::Isolate* isolate,
                                const base::FilePath& file_path);
+  static bool StartCpuProfiler(gin_helper::Arguments* args);
+  static v8::Local<v8::Value> StopCpuProfiler(v8::Isolate* isolate);
 
   void ActivateUVLoop(v8::Isolate* isolate);
 
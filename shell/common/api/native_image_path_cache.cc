@@ -0,0 +1,182 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/api/native_image_path_cache.h"
+
+#include <memory>
+#include <utility>
+
+#include "base/files/file_util.h"
+#include "base/no_destructor.h"
+#include "base/threading/thread_local.h"
+#include "shell/common/asar/asar_util.h"
+#include "shell/common/skia_util.h"
+#include "shell/common/thread_restrictions.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "ui/gfx/image/image_skia_rep.h"
+#include "v8/include/v8-isolate.h"
+
+namespace electron::api {
+
+namespace {
+
+// The decoded bytes kept alive by the cache on top of the ones still used by
+// a NativeImage.
+constexpr size_t kMaxByteSize = 16 * 1024 * 1024;
+
+// Images inside an asar archive can only change together with the archive.
+bool GetFileLastModified(const base::FilePath& path,
+                         base::Time* last_modified) {
+  base::FilePath file_path = path;
+  base::FilePath relative_path;
+  asar::GetAsarArchivePath(path, &file_path, &relative_path);
+
+  electron::ScopedAllowBlockingForElectron allow_blocking;
+  base::File::Info info;
+  if (!base::GetFileInfo(file_path, &info))
+    return false;
+  *last_modified = info.last_modified;
+  return true;
+}
+
+// The file at |path| comes first, followed by the scale variants it could
+// have, so that adding, removing or changing any of them is noticed.
+bool GetLastModified(const base::FilePath& path,
+                     std::vector<base::Time>* last_modified) {
+  base::Time file_last_modified;
+  if (!GetFileLastModified(path, &file_last_modified))
+    return false;
+  last_modified->push_back(file_last_modified);
+  for (const base::FilePath& variant :
+       electron::util::GetScaleVariantPaths(path)) {
+    base::Time variant_last_modified;
+    GetFileLastModified(variant, &variant_last_modified);
+    last_modified->push_back(variant_last_modified);
+  }
+  return true;
+}
+
+// The representations that haven't been decoded yet are estimated from one
+// that has, as their byte size grows with the square of their scale.
+size_t EstimateByteSize(const NativeImagePathCache::Image& image) {
+  const auto image_reps = image.image_skia.image_reps();
+  if (image_reps.empty())
+    return 0;
+  const gfx::ImageSkiaRep& image_rep = image_reps.front();
+  double unscaled_byte_size = image_rep.GetBitmap().computeByteSize() /
+                              (image_rep.scale() * image_rep.scale());
+  double byte_size = 0;
+  for (float scale : image.scale_factors)
+    byte_size += unscaled_byte_size * scale * scale;
+  return static_cast<size_t>(byte_size);
+}
+
+}  // namespace
+
+NativeImagePathCache::Image::Image() = default;
+
+NativeImagePathCache::Image::Image(const Image&) = default;
+
+NativeImagePathCache::Image& NativeImagePathCache::Image::operator=(
+    const Image&) = default;
+
+NativeImagePathCache::Image::~Image() = default;
+
+NativeImagePathCache::Entry::Entry() = default;
+
+NativeImagePathCache::Entry::Entry(Entry&&) = default;
+
+NativeImagePathCache::Entry& NativeImagePathCache::Entry::operator=(Entry&&) =
+    default;
+
+NativeImagePathCache::Entry::~Entry() = default;
+
+// static
+NativeImagePathCache* NativeImagePathCache::GetInstance() {
+  static base::NoDestructor<base::ThreadLocalOwnedPointer<NativeImagePathCache>>
+      s_cache;
+  NativeImagePathCache* cache = s_cache->Get();
+  if (!cache) {
+    auto new_cache = std::make_unique<NativeImagePathCache>();
+    cache = new_cache.get();
+    s_cache->Set(std::move(new_cache));
+  }
+  return cache;
+}
+
+NativeImagePathCache::NativeImagePathCache()
+    : entries_(decltype(entries_)::NO_AUTO_EVICT) {}
+
+// The isolate may already be gone by the time the thread exits, so nothing
+// is reported to it here.
+NativeImagePathCache::~NativeImagePathCache() = default;
+
+NativeImagePathCache::Image NativeImagePathCache::Get(
+    v8::Isolate* isolate,
+    const base::FilePath& path) {
+  if (isolate != isolate_) {
+    // The entries were accounted to an isolate of this thread that has since
+    // been replaced, so they are dropped rather than moved over to this one.
+    entries_.Clear();
+    byte_size_ = 0;
+    isolate_ = isolate;
+  }
+
+  Image image;
+  std::vector<base::Time> last_modified;
+  if (!GetLastModified(path, &last_modified)) {
+    // There may still be scale variants of a missing file, but there is no
+    // modification time to tell when they change, so they aren't cached.
+    if (!electron::util::CreateLazyImageSkiaFromPath(&image.image_skia, path,
+                                                      &image.scale_factors))
+      return Image();
+    return image;
+  }
+
+  auto it = entries_.Get(path);
+  if (it != entries_.end()) {
+    if (it->second.last_modified == last_modified)
+      return it->second.image;
+    RemoveByteSize(it->second.byte_size);
+    entries_.Erase(it);
+  }
+
+  if (!electron::util::CreateLazyImageSkiaFromPath(&image.image_skia, path,
+                                                    &image.scale_factors))
+    return Image();
+
+  image.shared = true;
+  Entry entry;
+  entry.image = image;
+  entry.last_modified = std::move(last_modified);
+  entry.byte_size = EstimateByteSize(image);
+  AddByteSize(entry.byte_size);
+  entries_.Put(path, std::move(entry));
+  Evict();
+  return image;
+}
+
+void NativeImagePathCache::AddByteSize(size_t byte_size) {
+  byte_size_ += byte_size;
+  isolate_->AdjustAmountOfExternalAllocatedMemory(
+      static_cast<int64_t>(byte_size));
+}
+
+void NativeImagePathCache::RemoveByteSize(size_t byte_size) {
+  byte_size_ -= byte_size;
+  isolate_->AdjustAmountOfExternalAllocatedMemory(
+      -static_cast<int64_t>(byte_size));
+}
+
+void NativeImagePathCache::Evict() {
+  // The newest entry is kept even when it is over the budget on its own, as
+  // the NativeImage just created from it holds on to it anyway.
+  while (byte_size_ > kMaxByteSize && entries_.size() > 1) {
+    auto it = entries_.rbegin();
+    RemoveByteSize(it->second.byte_size);
+    entries_.Erase(it);
+  }
+}
+
+}  // namespace electron::api
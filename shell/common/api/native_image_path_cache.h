@@ -0,0 +1,89 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_API_NATIVE_IMAGE_PATH_CACHE_H_
+#define ELECTRON_SHELL_COMMON_API_NATIVE_IMAGE_PATH_CACHE_H_
+
+#include <vector>
+
+#include "base/containers/lru_cache.h"
+#include "base/files/file_path.h"
+#include "base/memory/raw_ptr.h"
+#include "base/time/time.h"
+#include "ui/gfx/image/image_skia.h"
+
+namespace v8 {
+class Isolate;
+}
+
+namespace electron::api {
+
+// Keeps the images decoded by nativeImage.createFromPath(), so that every
+// NativeImage created from the same file shares one copy of its bitmaps
+// instead of reading and decoding the file again. An entry is decoded again
+// when its file has been modified, and the least recently used entries are
+// dropped once the cache grows past its budget.
+//
+// ImageSkia is bound to the thread that first uses it, so every thread has
+// its own cache. The bytes of an entry are reported to the isolate using it
+// as external memory once, rather than by each NativeImage sharing them.
+class NativeImagePathCache {
+ public:
+  struct Image {
+    Image();
+    Image(const Image&);
+    Image& operator=(const Image&);
+    ~Image();
+
+    gfx::ImageSkia image_skia;
+    // The scales that |image_skia| has a file for, including the ones that
+    // are only decoded the first time they are used.
+    std::vector<float> scale_factors;
+    // Whether |image_skia| is owned by a cache entry, which accounts for its
+    // memory.
+    bool shared = false;
+  };
+
+  static NativeImagePathCache* GetInstance();
+
+  NativeImagePathCache();
+  ~NativeImagePathCache();
+
+  // disable copy
+  NativeImagePathCache(const NativeImagePathCache&) = delete;
+  NativeImagePathCache& operator=(const NativeImagePathCache&) = delete;
+
+  // Returns the image at the normalized |path|, decoding it when there is no
+  // up to date entry for it. The image is null when it can't be decoded.
+  Image Get(v8::Isolate* isolate, const base::FilePath& path);
+
+ private:
+  struct Entry {
+    Entry();
+    Entry(Entry&&);
+    Entry& operator=(Entry&&);
+    ~Entry();
+
+    Image image;
+    // The modification times of the file and of each of its scale variants,
+    // which are null for the variants that don't exist.
+    std::vector<base::Time> last_modified;
+    size_t byte_size = 0;
+  };
+
+  // Keep |byte_size_| and the external memory of |isolate_| in step.
+  void AddByteSize(size_t byte_size);
+  void RemoveByteSize(size_t byte_size);
+  void Evict();
+
+  base::HashingLRUCache<base::FilePath, Entry> entries_;
+  size_t byte_size_ = 0;
+
+  // The isolate that |byte_size_| is reported to.
+  raw_ptr<v8::Isolate> isolate_ = nullptr;
+};
+
+}  // namespace electron::api
+
+#endif  // ELECTRON_SHELL_COMMON_API_NATIVE_IMAGE_PATH_CACHE_H_
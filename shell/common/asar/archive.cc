@@ -4,91 +4,118 @@
 
 #include "shell/common/asar/archive.h"
 
+#include <algorithm>
+#include <limits>
 #include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
 
 #include "base/check.h"
+#include "base/command_line.h"
 #include "base/files/file.h"
 #include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
 #include "base/json/json_reader.h"
 #include "base/logging.h"
+#include "base/memory/page_size.h"
 #include "base/pickle.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
 #include "base/values.h"
+#include "crypto/sha2.h"
 #include "electron/fuses.h"
 #include "shell/common/asar/asar_util.h"
 #include "shell/common/asar/scoped_temporary_file.h"
+#include "shell/common/options_switches.h"
+#include "shell/common/process_util.h"
+#include "shell/common/startup_timings.h"
 #include "shell/common/thread_restrictions.h"
+#include "third_party/brotli/include/brotli/decode.h"
 
 #if BUILDFLAG(IS_WIN)
 #include <io.h>
+#include <windows.h>
+#elif BUILDFLAG(IS_POSIX)
+#include <sys/mman.h>
 #endif
 
 namespace asar {
 
 namespace {
 
+// Links are followed at most this many times while resolving a path, which
+// guards against cycles in malformed headers.
+constexpr int kMaxLinkDepth = 32;
+
+// Converts |path| to the '/' separated form used as the key of the index,
+// dropping empty components.
+std::string NormalizePath(std::string_view path) {
+  std::string normalized;
+  normalized.reserve(path.size());
+  for (char c : path) {
 #if BUILDFLAG(IS_WIN)
-const char kSeparators[] = "\\/";
-#else
-const char kSeparators[] = "/";
+    if (c == '\\')
+      c = '/';
 #endif
-
-const base::Value::Dict* GetNodeFromPath(std::string path,
-                                         const base::Value::Dict& root);
-
-// Gets the "files" from "dir".
-const base::Value::Dict* GetFilesNode(const base::Value::Dict& root,
-                                      const base::Value::Dict& dir) {
-  // Test for symbol linked directory.
-  const std::string* link = dir.FindString("link");
-  if (link != nullptr) {
-    const base::Value::Dict* linked_node = GetNodeFromPath(*link, root);
-    if (!linked_node)
-      return nullptr;
-    return linked_node->FindDict("files");
+    if (c == '/' && (normalized.empty() || normalized.back() == '/'))
+      continue;
+    normalized.push_back(c);
   }
-
-  return dir.FindDict("files");
+  if (!normalized.empty() && normalized.back() == '/')
+    normalized.pop_back();
+  return normalized;
 }
 
-// Gets sub-file "name" from "dir".
-const base::Value::Dict* GetChildNode(const base::Value::Dict& root,
-                                      const std::string& name,
-                                      const base::Value::Dict& dir) {
-  if (name.empty())
-    return &root;
-
-  const base::Value::Dict* files = GetFilesNode(root, dir);
-  return files ? files->FindDict(name) : nullptr;
+// Bump whenever the layout written by Archive::WriteIndexCache() changes.
+constexpr uint32_t kIndexCacheVersion = 2;
+
+// Bump whenever the layout written by Archive::WriteRecordedReads() changes.
+constexpr uint32_t kPrefetchManifestVersion = 1;
+
+// Upper bound on the number of reads kept in a prefetch manifest.
+constexpr size_t kMaxRecordedReads = 16384;
+
+// Returns where the data with |extension| derived from an archive with
+// |header| is cached, or an empty path if caching is disabled. The file is
+// keyed by the hash of the header so a modified archive never picks up stale
+// data.
+base::FilePath GetCachePath(std::string_view header,
+                            std::string_view extension) {
+  auto* command_line = base::CommandLine::ForCurrentProcess();
+  if (!command_line->HasSwitch(electron::switches::kAsarIndexCacheDir))
+    return base::FilePath();
+
+  base::FilePath cache_dir =
+      command_line->GetSwitchValuePath(electron::switches::kAsarIndexCacheDir);
+  if (cache_dir.empty())
+    return base::FilePath();
+
+  const std::string digest = crypto::SHA256HashString(header);
+  const std::string hash =
+      base::ToLowerASCII(base::HexEncode(digest.data(), digest.size()));
+  return cache_dir.AppendASCII(base::StrCat({hash, extension}));
 }
 
-// Gets the node of "path" from "root".
-const base::Value::Dict* GetNodeFromPath(std::string path,
-                                         const base::Value::Dict& root) {
-  if (path.empty())
-    return &root;
-
-  const base::Value::Dict* dir = &root;
-  for (size_t delimiter_position = path.find_first_of(kSeparators);
-       delimiter_position != std::string::npos;
-       delimiter_position = path.find_first_of(kSeparators)) {
-    const base::Value::Dict* child =
-        GetChildNode(root, path.substr(0, delimiter_position), *dir);
-    if (!child)
-      return nullptr;
-
-    dir = child;
-    path.erase(0, delimiter_position + 1);
-  }
-
-  return GetChildNode(root, path, *dir);
+// Hints that the pages backing |data| will be read soon. This only starts
+// asynchronous read-ahead and never blocks on the disk.
+void AdviseWillNeed(const uint8_t* data, size_t size) {
+#if BUILDFLAG(IS_WIN)
+  WIN32_MEMORY_RANGE_ENTRY range = {const_cast<uint8_t*>(data), size};
+  ::PrefetchVirtualMemory(::GetCurrentProcess(), 1, &range, 0);
+#elif BUILDFLAG(IS_POSIX)
+  const uintptr_t page_mask = base::GetPageSize() - 1;
+  const uintptr_t start = reinterpret_cast<uintptr_t>(data) & ~page_mask;
+  const uintptr_t end = reinterpret_cast<uintptr_t>(data) + size;
+  madvise(reinterpret_cast<void*>(start), end - start, MADV_WILLNEED);
+#endif
 }
 
 bool FillFileInfoWithNode(Archive::FileInfo* info,
                           uint32_t header_size,
                           bool load_integrity,
+                          bool* missing_integrity,
                           const base::Value::Dict* node) {
   if (std::optional<int> size = node->FindInt("size")) {
     info->size = static_cast<uint32_t>(*size);
@@ -144,12 +171,49 @@ bool FillFileInfoWithNode(Archive::FileInfo* info,
       }
     }
 
-    if (!info->integrity.has_value()) {
-      LOG(FATAL) << "Failed to read integrity for file in ASAR archive";
-    }
+    // Reported when the file is looked up so that unused entries don't
+    // abort the whole archive.
+    *missing_integrity = !info->integrity.has_value();
   }
 #endif
 
+  if (const base::Value::Dict* compression = node->FindDict("compression")) {
+    const std::string* algorithm = compression->FindString("algorithm");
+    std::optional<int> block_size = compression->FindInt("blockSize");
+    const base::Value::List* blocks = compression->FindList("blocks");
+    if (!algorithm || *algorithm != "brotli" || !block_size ||
+        *block_size <= 0 || !blocks) {
+      LOG(ERROR) << "Unsupported compression for file in ASAR archive";
+      return false;
+    }
+
+    CompressionPayload compression_payload;
+    compression_payload.algorithm = CompressionAlgorithm::kBrotli;
+    compression_payload.block_size = static_cast<uint32_t>(*block_size);
+    for (const auto& value : *blocks) {
+      std::optional<int> block = value.GetIfInt();
+      if (!block || *block <= 0) {
+        LOG(ERROR) << "Invalid compressed block size for file in ASAR archive";
+        return false;
+      }
+      compression_payload.blocks.push_back(static_cast<uint32_t>(*block));
+    }
+
+    // Every block but the last must be full, and integrity blocks have to
+    // line up with compressed blocks so each can be validated on its own.
+    const uint64_t expected_blocks =
+        (static_cast<uint64_t>(info->size) + compression_payload.block_size -
+         1) /
+        compression_payload.block_size;
+    if (compression_payload.blocks.size() != expected_blocks ||
+        (info->integrity &&
+         info->integrity->block_size != compression_payload.block_size)) {
+      LOG(ERROR) << "Mismatched compressed blocks for file in ASAR archive";
+      return false;
+    }
+    info->compression = std::move(compression_payload);
+  }
+
   return true;
 }
 
@@ -160,9 +224,22 @@ IntegrityPayload::IntegrityPayload()
 IntegrityPayload::~IntegrityPayload() = default;
 IntegrityPayload::IntegrityPayload(const IntegrityPayload& other) = default;
 
+CompressionPayload::CompressionPayload()
+    : algorithm(CompressionAlgorithm::kNone), block_size(0) {}
+CompressionPayload::~CompressionPayload() = default;
+CompressionPayload::CompressionPayload(const CompressionPayload& other) =
+    default;
+
 Archive::FileInfo::FileInfo()
     : unpacked(false), executable(false), size(0), offset(0) {}
 Archive::FileInfo::~FileInfo() = default;
+Archive::FileInfo::FileInfo(const FileInfo&) = default;
+Archive::FileInfo& Archive::FileInfo::operator=(const FileInfo&) = default;
+
+Archive::Entry::Entry() = default;
+Archive::Entry::~Entry() = default;
+Archive::Entry::Entry(Entry&&) = default;
+Archive::Entry& Archive::Entry::operator=(Entry&&) = default;
 
 Archive::Archive(const base::FilePath& path)
     : initialized_(false), path_(path), file_(base::File::FILE_OK) {
@@ -188,6 +265,7 @@ Archive::~Archive() {
 }
 
 bool Archive::Init() {
+  ScopedStartupTiming startup_timing("asar::Archive::Init");
   // Should only be initialized once
   CHECK(!initialized_);
   initialized_ = true;
@@ -262,17 +340,278 @@ bool Archive::Init() {
   }
 #endif
 
+  header_size_ = 8 + size;
+
+  {
+    electron::ScopedAllowBlockingForElectron allow_blocking;
+    if (!mapped_file_.Initialize(file_.Duplicate())) {
+      LOG(WARNING) << "Failed to map " << path_.value()
+                   << ", reads will fall back to file I/O";
+    }
+  }
+
+  // The prebuilt index can't be trusted when the header has to be validated,
+  // as it would carry the integrity of every file.
+  // The manifest only drives read-ahead hints, so unlike the index it is
+  // fine to use for validated archives too.
+  prefetch_manifest_path_ = GetCachePath(header, ".asarprefetch");
+  if (!prefetch_manifest_path_.empty() && electron::IsBrowserProcess()) {
+    electron::ScopedAllowBlockingForElectron allow_blocking;
+    recording_reads_ = !base::PathExists(prefetch_manifest_path_);
+  }
+
+  base::FilePath cache_path;
+  if (!header_validated_) {
+    cache_path = GetCachePath(header, ".asarindex");
+    if (!cache_path.empty() && ReadIndexCache(cache_path))
+      return true;
+  }
+
   std::optional<base::Value> value = base::JSONReader::Read(header);
   if (!value || !value->is_dict()) {
     LOG(ERROR) << "Failed to parse header";
     return false;
   }
 
-  header_size_ = 8 + size;
-  header_ = std::move(value->GetDict());
+  // Flatten the header into a sorted table so lookups are a single binary
+  // search instead of a dictionary walk per path component. The parsed JSON
+  // is released once this function returns.
+  std::vector<Index::value_type> entries;
+  AddNodeToIndex(std::string(), value->GetDict(), &entries);
+  index_ = Index(std::move(entries));
+
+  // Link every entry to its parent directory. Keys are sorted, so children
+  // are appended in name order, matching the order of the original header.
+  for (size_t i = 0; i < index_.size(); ++i) {
+    const std::string& key = (index_.begin() + i)->first;
+    if (key.empty())
+      continue;
+    const size_t separator = key.rfind('/');
+    auto parent = index_.find(separator == std::string::npos
+                                  ? std::string_view()
+                                  : std::string_view(key).substr(0, separator));
+    if (parent != index_.end() && parent->second.type == FileType::kDirectory)
+      parent->second.children.push_back(static_cast<uint32_t>(i));
+  }
+
+  if (!cache_path.empty())
+    WriteIndexCache(cache_path);
+
   return true;
 }
 
+bool Archive::ReadIndexCache(const base::FilePath& cache_path) {
+  std::string data;
+  {
+    electron::ScopedAllowBlockingForElectron allow_blocking;
+    if (!base::ReadFileToString(cache_path, &data))
+      return false;
+  }
+
+  base::Pickle pickle(data.data(), data.size());
+  base::PickleIterator iter(pickle);
+  uint32_t version, header_size;
+  uint64_t count;
+  if (!iter.ReadUInt32(&version) || version != kIndexCacheVersion ||
+      !iter.ReadUInt32(&header_size) || header_size != header_size_ ||
+      !iter.ReadUInt64(&count)) {
+    return false;
+  }
+
+  std::vector<Index::value_type> entries;
+  entries.reserve(std::min<uint64_t>(count, data.size()));
+  for (uint64_t i = 0; i < count; ++i) {
+    std::string path;
+    Entry entry;
+    int type;
+    bool has_integrity;
+    uint64_t children_count;
+    if (!iter.ReadString(&path) || !iter.ReadInt(&type) ||
+        !iter.ReadBool(&entry.has_info) ||
+        !iter.ReadBool(&entry.missing_integrity) ||
+        !iter.ReadBool(&entry.info.unpacked) ||
+        !iter.ReadBool(&entry.info.executable) ||
+        !iter.ReadUInt32(&entry.info.size) ||
+        !iter.ReadUInt64(&entry.info.offset) || !iter.ReadString(&entry.link) ||
+        !iter.ReadBool(&has_integrity)) {
+      return false;
+    }
+    if (type != static_cast<int>(FileType::kFile) &&
+        type != static_cast<int>(FileType::kDirectory) &&
+        type != static_cast<int>(FileType::kLink)) {
+      return false;
+    }
+    entry.type = static_cast<FileType>(type);
+
+    if (has_integrity) {
+      IntegrityPayload integrity;
+      int algorithm;
+      uint64_t blocks_count;
+      if (!iter.ReadInt(&algorithm) ||
+          algorithm != static_cast<int>(HashAlgorithm::kSHA256) ||
+          !iter.ReadString(&integrity.hash) ||
+          !iter.ReadUInt32(&integrity.block_size) ||
+          !iter.ReadUInt64(&blocks_count)) {
+        return false;
+      }
+      integrity.algorithm = HashAlgorithm::kSHA256;
+      for (uint64_t j = 0; j < blocks_count; ++j) {
+        if (!iter.ReadString(&integrity.blocks.emplace_back()))
+          return false;
+      }
+      entry.info.integrity = std::move(integrity);
+    }
+
+    bool has_compression;
+    if (!iter.ReadBool(&has_compression))
+      return false;
+    if (has_compression) {
+      CompressionPayload compression;
+      int algorithm;
+      uint64_t blocks_count;
+      if (!iter.ReadInt(&algorithm) ||
+          algorithm != static_cast<int>(CompressionAlgorithm::kBrotli) ||
+          !iter.ReadUInt32(&compression.block_size) ||
+          compression.block_size == 0 || !iter.ReadUInt64(&blocks_count)) {
+        return false;
+      }
+      compression.algorithm = CompressionAlgorithm::kBrotli;
+      for (uint64_t j = 0; j < blocks_count; ++j) {
+        if (!iter.ReadUInt32(&compression.blocks.emplace_back()))
+          return false;
+      }
+      entry.info.compression = std::move(compression);
+    }
+
+    if (!iter.ReadUInt64(&children_count))
+      return false;
+    for (uint64_t j = 0; j < children_count; ++j) {
+      uint32_t child;
+      if (!iter.ReadUInt32(&child) || child >= count)
+        return false;
+      entry.children.push_back(child);
+    }
+
+    // Entries were written in index order, anything else is corrupt.
+    if (!entries.empty() && !(entries.back().first < path))
+      return false;
+    entries.emplace_back(std::move(path), std::move(entry));
+  }
+
+  index_ = Index(base::sorted_unique, std::move(entries));
+  return true;
+}
+
+void Archive::WriteIndexCache(const base::FilePath& cache_path) const {
+  base::Pickle pickle;
+  pickle.WriteUInt32(kIndexCacheVersion);
+  pickle.WriteUInt32(header_size_);
+  pickle.WriteUInt64(index_.size());
+  for (const auto& [path, entry] : index_) {
+    pickle.WriteString(path);
+    pickle.WriteInt(static_cast<int>(entry.type));
+    pickle.WriteBool(entry.has_info);
+    pickle.WriteBool(entry.missing_integrity);
+    pickle.WriteBool(entry.info.unpacked);
+    pickle.WriteBool(entry.info.executable);
+    pickle.WriteUInt32(entry.info.size);
+    pickle.WriteUInt64(entry.info.offset);
+    pickle.WriteString(entry.link);
+    pickle.WriteBool(entry.info.integrity.has_value());
+    if (entry.info.integrity) {
+      const IntegrityPayload& integrity = *entry.info.integrity;
+      pickle.WriteInt(static_cast<int>(integrity.algorithm));
+      pickle.WriteString(integrity.hash);
+      pickle.WriteUInt32(integrity.block_size);
+      pickle.WriteUInt64(integrity.blocks.size());
+      for (const std::string& block : integrity.blocks)
+        pickle.WriteString(block);
+    }
+    pickle.WriteBool(entry.info.compression.has_value());
+    if (entry.info.compression) {
+      const CompressionPayload& compression = *entry.info.compression;
+      pickle.WriteInt(static_cast<int>(compression.algorithm));
+      pickle.WriteUInt32(compression.block_size);
+      pickle.WriteUInt64(compression.blocks.size());
+      for (uint32_t block : compression.blocks)
+        pickle.WriteUInt32(block);
+    }
+    pickle.WriteUInt64(entry.children.size());
+    for (uint32_t child : entry.children)
+      pickle.WriteUInt32(child);
+  }
+
+  electron::ScopedAllowBlockingForElectron allow_blocking;
+  if (!base::CreateDirectory(cache_path.DirName()) ||
+      !base::ImportantFileWriter::WriteFileAtomically(
+          cache_path,
+          std::string_view(static_cast<const char*>(pickle.data()),
+                           pickle.size()))) {
+    LOG(WARNING) << "Failed to write asar index cache to "
+                 << cache_path.value();
+  }
+}
+
+void Archive::AddNodeToIndex(std::string path,
+                             const base::Value::Dict& node,
+                             std::vector<Index::value_type>* entries) const {
+  Entry entry;
+  if (const std::string* link = node.FindString("link")) {
+    entry.type = FileType::kLink;
+    entry.link = NormalizePath(*link);
+  } else if (node.Find("files")) {
+    entry.type = FileType::kDirectory;
+    if (const base::Value::Dict* files = node.FindDict("files")) {
+      for (const auto [name, child] : *files) {
+        if (!child.is_dict())
+          continue;
+        AddNodeToIndex(path.empty() ? name : base::StrCat({path, "/", name}),
+                       child.GetDict(), entries);
+      }
+    }
+  } else {
+    entry.has_info = FillFileInfoWithNode(&entry.info, header_size_,
+                                          header_validated_,
+                                          &entry.missing_integrity, &node);
+  }
+  entries->emplace_back(std::move(path), std::move(entry));
+}
+
+const Archive::Entry* Archive::FindEntry(std::string_view path,
+                                         int depth) const {
+  if (depth > kMaxLinkDepth)
+    return nullptr;
+
+  auto it = index_.find(path);
+  if (it != index_.end())
+    return &it->second;
+
+  // The path may go through a linked directory, whose children are only
+  // stored under the link's target.
+  for (size_t separator = path.find('/'); separator != std::string_view::npos;
+       separator = path.find('/', separator + 1)) {
+    auto parent = index_.find(path.substr(0, separator));
+    if (parent == index_.end())
+      return nullptr;
+    if (parent->second.type == FileType::kLink) {
+      return FindEntry(
+          base::StrCat({parent->second.link, path.substr(separator)}),
+          depth + 1);
+    }
+  }
+
+  return nullptr;
+}
+
+const Archive::Entry* Archive::ResolveLink(const Entry* entry) const {
+  for (int depth = 0; entry && entry->type == FileType::kLink; ++depth) {
+    if (depth > kMaxLinkDepth)
+      return nullptr;
+    entry = FindEntry(entry->link);
+  }
+  return entry;
+}
+
 #if !BUILDFLAG(IS_MAC) && !BUILDFLAG(IS_WIN)
 std::optional<IntegrityPayload> Archive::HeaderIntegrity() const {
   return std::nullopt;
@@ -284,75 +623,69 @@ std::optional<base::FilePath> Archive::RelativePath() const {
 #endif
 
 bool Archive::GetFileInfo(const base::FilePath& path, FileInfo* info) const {
-  if (!header_)
+  const Entry* entry =
+      ResolveLink(FindEntry(NormalizePath(path.AsUTF8Unsafe())));
+  if (!entry || !entry->has_info)
     return false;
 
-  const base::Value::Dict* node =
-      GetNodeFromPath(path.AsUTF8Unsafe(), *header_);
-  if (!node)
-    return false;
+  if (entry->missing_integrity) {
+    LOG(FATAL) << "Failed to read integrity for file in ASAR archive";
+  }
 
-  const std::string* link = node->FindString("link");
-  if (link)
-    return GetFileInfo(base::FilePath::FromUTF8Unsafe(*link), info);
+  if (IsRecordingReads())
+    RecordRead(entry->info);
 
-  return FillFileInfoWithNode(info, header_size_, header_validated_, node);
+  *info = entry->info;
+  return true;
 }
 
 bool Archive::Stat(const base::FilePath& path, Stats* stats) const {
-  if (!header_)
+  const Entry* entry = FindEntry(NormalizePath(path.AsUTF8Unsafe()));
+  if (!entry)
     return false;
 
-  const base::Value::Dict* node =
-      GetNodeFromPath(path.AsUTF8Unsafe(), *header_);
-  if (!node)
-    return false;
-
-  if (node->Find("link")) {
-    stats->type = FileType::kLink;
+  if (entry->type != FileType::kFile) {
+    stats->type = entry->type;
     return true;
   }
 
-  if (node->Find("files")) {
-    stats->type = FileType::kDirectory;
-    return true;
+  if (!entry->has_info)
+    return false;
+
+  if (entry->missing_integrity) {
+    LOG(FATAL) << "Failed to read integrity for file in ASAR archive";
   }
 
-  return FillFileInfoWithNode(stats, header_size_, header_validated_, node);
+  static_cast<FileInfo&>(*stats) = entry->info;
+  return true;
 }
 
 bool Archive::Readdir(const base::FilePath& path,
                       std::vector<base::FilePath>* files) const {
-  if (!header_)
+  const Entry* entry =
+      ResolveLink(FindEntry(NormalizePath(path.AsUTF8Unsafe())));
+  if (!entry || entry->type != FileType::kDirectory)
     return false;
 
-  const base::Value::Dict* node =
-      GetNodeFromPath(path.AsUTF8Unsafe(), *header_);
-  if (!node)
-    return false;
-
-  const base::Value::Dict* files_node = GetFilesNode(*header_, *node);
-  if (!files_node)
-    return false;
-
-  for (const auto iter : *files_node)
-    files->push_back(base::FilePath::FromUTF8Unsafe(iter.first));
+  files->reserve(files->size() + entry->children.size());
+  for (uint32_t child : entry->children) {
+    std::string_view key = (index_.begin() + child)->first;
+    const size_t separator = key.rfind('/');
+    if (separator != std::string_view::npos)
+      key.remove_prefix(separator + 1);
+    files->push_back(base::FilePath::FromUTF8Unsafe(key));
+  }
   return true;
 }
 
 bool Archive::Realpath(const base::FilePath& path,
                        base::FilePath* realpath) const {
-  if (!header_)
+  const Entry* entry = FindEntry(NormalizePath(path.AsUTF8Unsafe()));
+  if (!entry)
     return false;
 
-  const base::Value::Dict* node =
-      GetNodeFromPath(path.AsUTF8Unsafe(), *header_);
-  if (!node)
-    return false;
-
-  const std::string* link = node->FindString("link");
-  if (link) {
-    *realpath = base::FilePath::FromUTF8Unsafe(*link);
+  if (entry->type == FileType::kLink) {
+    *realpath = base::FilePath::FromUTF8Unsafe(entry->link);
     return true;
   }
 
@@ -361,7 +694,7 @@ bool Archive::Realpath(const base::FilePath& path,
 }
 
 bool Archive::CopyFileOut(const base::FilePath& path, base::FilePath* out) {
-  if (!header_)
+  if (index_.empty())
     return false;
 
   base::AutoLock auto_lock(external_files_lock_);
@@ -381,11 +714,55 @@ bool Archive::CopyFileOut(const base::FilePath& path, base::FilePath* out) {
     return true;
   }
 
-  auto temp_file = std::make_unique<ScopedTemporaryFile>();
   base::FilePath::StringType ext = path.Extension();
-  if (!temp_file->InitFromFile(&file_, ext, info.offset, info.size,
-                               info.integrity))
-    return false;
+  std::unique_ptr<ScopedTemporaryFile> temp_file;
+
+  // Compressed files have to be expanded before anything else can use them.
+  if (info.compression) {
+    std::string contents;
+    if (!DecompressFile(info, &contents))
+      return false;
+    if (info.integrity) {
+      ValidateIntegrityOrDie(contents.data(), contents.size(),
+                             info.integrity.value());
+    }
+    temp_file = std::make_unique<ScopedTemporaryFile>();
+    if (!temp_file->InitFromContents(ext, contents))
+      return false;
+  }
+
+#if BUILDFLAG(IS_LINUX)
+  // Native modules only need to be dlopen'd, so they can be served from
+  // memory without touching the disk at all.
+  if (!temp_file &&
+      base::FilePath::CompareEqualIgnoreCase(ext, FILE_PATH_LITERAL(".node"))) {
+    auto memory_file = std::make_unique<ScopedTemporaryFile>();
+    if (memory_file->InitInMemoryFromFile(&file_, info.offset, info.size,
+                                          info.integrity))
+      temp_file = std::move(memory_file);
+  }
+#endif
+
+  // Executables are run by child processes, which can't reach the verified
+  // handle of a cached file.
+  if (!temp_file && !info.executable) {
+    base::FilePath cache_dir =
+        base::CommandLine::ForCurrentProcess()->GetSwitchValuePath(
+            electron::switches::kAsarExtractionCacheDir);
+    if (!cache_dir.empty()) {
+      auto cached_file = std::make_unique<ScopedTemporaryFile>();
+      if (cached_file->InitCachedFromFile(cache_dir, &file_, ext, info.offset,
+                                          info.size, info.integrity))
+        temp_file = std::move(cached_file);
+    }
+  }
+
+  if (!temp_file) {
+    temp_file = std::make_unique<ScopedTemporaryFile>();
+    if (!temp_file->InitFromFile(&file_, ext, info.offset, info.size,
+                                 info.integrity))
+      return false;
+  }
 
 #if BUILDFLAG(IS_POSIX)
   if (info.executable) {
@@ -399,8 +776,214 @@ bool Archive::CopyFileOut(const base::FilePath& path, base::FilePath* out) {
   return true;
 }
 
+void Archive::RecordRead(const FileInfo& info) const {
+  if (info.unpacked)
+    return;
+
+  uint64_t size = info.size;
+  if (info.compression) {
+    size = 0;
+    for (uint32_t block : info.compression->blocks)
+      size += block;
+  }
+
+  base::AutoLock auto_lock(recorded_reads_lock_);
+  if (recorded_reads_.size() >= kMaxRecordedReads)
+    return;
+  if (recorded_offsets_.insert(info.offset).second)
+    recorded_reads_.emplace_back(info.offset, size);
+}
+
+void Archive::PrefetchRecordedReads() {
+  if (prefetch_manifest_path_.empty() || !mapped_file_.IsValid())
+    return;
+
+  std::string data;
+  {
+    electron::ScopedAllowBlockingForElectron allow_blocking;
+    if (!base::ReadFileToString(prefetch_manifest_path_, &data))
+      return;
+  }
+
+  base::Pickle pickle(data.data(), data.size());
+  base::PickleIterator iter(pickle);
+  uint32_t version, header_size;
+  uint64_t count;
+  if (!iter.ReadUInt32(&version) || version != kPrefetchManifestVersion ||
+      !iter.ReadUInt32(&header_size) || header_size != header_size_ ||
+      !iter.ReadUInt64(&count) || count > kMaxRecordedReads) {
+    return;
+  }
+
+  // Reads that follow each other in the archive are hinted as one range, as
+  // files required in sequence are often packed in sequence.
+  std::optional<std::pair<uint64_t, uint64_t>> pending;
+  for (uint64_t i = 0; i < count; ++i) {
+    uint64_t offset, size;
+    if (!iter.ReadUInt64(&offset) || !iter.ReadUInt64(&size))
+      break;
+    if (!GetMappedData(offset, size))
+      continue;
+    if (pending && pending->first + pending->second == offset) {
+      pending->second += size;
+      continue;
+    }
+    if (pending)
+      AdviseWillNeed(mapped_file_.data() + pending->first, pending->second);
+    pending.emplace(offset, size);
+  }
+  if (pending)
+    AdviseWillNeed(mapped_file_.data() + pending->first, pending->second);
+}
+
+void Archive::WriteRecordedReads() {
+  if (!recording_reads_.exchange(false))
+    return;
+
+  base::Pickle pickle;
+  {
+    base::AutoLock auto_lock(recorded_reads_lock_);
+    pickle.WriteUInt32(kPrefetchManifestVersion);
+    pickle.WriteUInt32(header_size_);
+    pickle.WriteUInt64(recorded_reads_.size());
+    for (const auto& [offset, size] : recorded_reads_) {
+      pickle.WriteUInt64(offset);
+      pickle.WriteUInt64(size);
+    }
+    recorded_reads_.clear();
+    recorded_offsets_.clear();
+  }
+
+  electron::ScopedAllowBlockingForElectron allow_blocking;
+  if (!base::CreateDirectory(prefetch_manifest_path_.DirName()) ||
+      !base::ImportantFileWriter::WriteFileAtomically(
+          prefetch_manifest_path_,
+          std::string_view(static_cast<const char*>(pickle.data()),
+                           pickle.size()))) {
+    LOG(WARNING) << "Failed to write asar prefetch manifest to "
+                 << prefetch_manifest_path_.value();
+  }
+}
+
 int Archive::GetUnsafeFD() const {
   return fd_;
 }
 
+bool Archive::IsBlockVerified(uint64_t file_offset, uint32_t block) const {
+  base::AutoLock auto_lock(verified_blocks_lock_);
+  auto it = verified_blocks_.find(file_offset);
+  return it != verified_blocks_.end() && block < it->second.size() &&
+         it->second[block];
+}
+
+bool Archive::AreAllBlocksVerified(uint64_t file_offset,
+                                   uint32_t block_count) const {
+  base::AutoLock auto_lock(verified_blocks_lock_);
+  auto it = verified_blocks_.find(file_offset);
+  return it != verified_blocks_.end() && it->second.size() == block_count &&
+         std::all_of(it->second.begin(), it->second.end(),
+                     [](bool verified) { return verified; });
+}
+
+void Archive::MarkBlockVerified(uint64_t file_offset,
+                                uint32_t block,
+                                uint32_t block_count) {
+  if (block >= block_count)
+    return;
+  base::AutoLock auto_lock(verified_blocks_lock_);
+  std::vector<bool>& blocks = verified_blocks_[file_offset];
+  blocks.resize(block_count);
+  blocks[block] = true;
+}
+
+void Archive::MarkAllBlocksVerified(uint64_t file_offset,
+                                    uint32_t block_count) {
+  base::AutoLock auto_lock(verified_blocks_lock_);
+  verified_blocks_[file_offset].assign(block_count, true);
+}
+
+bool Archive::ReadArchiveData(uint64_t offset,
+                              uint64_t size,
+                              char* out) {
+  if (std::optional<base::span<const uint8_t>> data =
+          GetMappedData(offset, size)) {
+    std::copy(data->begin(), data->end(), out);
+    return true;
+  }
+
+  electron::ScopedAllowBlockingForElectron allow_blocking;
+  return size <= static_cast<uint64_t>(std::numeric_limits<int>::max()) &&
+         file_.Read(offset, out, static_cast<int>(size)) ==
+             static_cast<int>(size);
+}
+
+bool Archive::DecompressBlock(const FileInfo& info,
+                              uint32_t block,
+                              std::string* out) {
+  if (!info.compression || block >= info.compression->blocks.size())
+    return false;
+  const CompressionPayload& compression = *info.compression;
+
+  uint64_t offset = info.offset;
+  for (uint32_t i = 0; i < block; ++i)
+    offset += compression.blocks[i];
+  const uint64_t block_start =
+      static_cast<uint64_t>(block) * compression.block_size;
+  const size_t expected_size = static_cast<size_t>(std::min<uint64_t>(
+      compression.block_size, info.size - block_start));
+
+  std::vector<char> encoded(compression.blocks[block]);
+  if (!ReadArchiveData(offset, encoded.size(), encoded.data()))
+    return false;
+
+  switch (compression.algorithm) {
+    case CompressionAlgorithm::kBrotli: {
+      out->resize(expected_size);
+      size_t decoded_size = out->size();
+      if (BrotliDecoderDecompress(
+              encoded.size(), reinterpret_cast<const uint8_t*>(encoded.data()),
+              &decoded_size, reinterpret_cast<uint8_t*>(out->data())) !=
+              BROTLI_DECODER_RESULT_SUCCESS ||
+          decoded_size != expected_size) {
+        LOG(ERROR) << "Failed to decompress block " << block << " of "
+                   << path_.value();
+        return false;
+      }
+      return true;
+    }
+    case CompressionAlgorithm::kNone:
+      break;
+  }
+  return false;
+}
+
+bool Archive::DecompressFile(const FileInfo& info, std::string* out) {
+  if (!info.compression)
+    return false;
+
+  out->clear();
+  out->reserve(info.size);
+  std::string block_data;
+  for (uint32_t block = 0; block < info.compression->blocks.size(); ++block) {
+    if (!DecompressBlock(info, block, &block_data))
+      return false;
+    out->append(block_data);
+  }
+  return out->size() == info.size;
+}
+
+std::optional<base::span<const uint8_t>> Archive::GetMappedData(
+    uint64_t offset,
+    uint64_t size) const {
+  if (!mapped_file_.IsValid())
+    return std::nullopt;
+
+  const uint64_t length = mapped_file_.length();
+  if (offset > length || size > length - offset)
+    return std::nullopt;
+
+  return base::make_span(mapped_file_.data() + offset,
+                         static_cast<size_t>(size));
+}
+
 }  // namespace asar
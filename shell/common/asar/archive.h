@@ -5,17 +5,25 @@
 #ifndef ELECTRON_SHELL_COMMON_ASAR_ARCHIVE_H_
 #define ELECTRON_SHELL_COMMON_ASAR_ARCHIVE_H_
 
+#include <atomic>
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include <uv.h>
 
+#include "base/containers/flat_map.h"
+#include "base/containers/span.h"
 #include "base/files/file.h"
 #include "base/files/file_path.h"
+#include "base/files/memory_mapped_file.h"
 #include "base/synchronization/lock.h"
+#include "base/thread_annotations.h"
 #include "base/values.h"
 
 namespace asar {
@@ -37,6 +45,26 @@ struct IntegrityPayload {
   std::vector<std::string> blocks;
 };
 
+enum class CompressionAlgorithm {
+  kBrotli,
+  kNone,
+};
+
+// Describes a packed file stored as independently compressed blocks, so any
+// range of it can be read by decompressing only the blocks it covers.
+struct CompressionPayload {
+  CompressionPayload();
+  ~CompressionPayload();
+  CompressionPayload(const CompressionPayload& other);
+  CompressionAlgorithm algorithm;
+  // Uncompressed size of every block but the last. Matches the integrity
+  // block size when the file has integrity, so blocks are validated as they
+  // are decompressed.
+  uint32_t block_size;
+  // Compressed size of each block, stored back to back from the file offset.
+  std::vector<uint32_t> blocks;
+};
+
 // This class represents an asar package, and provides methods to read
 // information from it. It is thread-safe after |Init| has been called.
 class Archive {
@@ -44,11 +72,15 @@ class Archive {
   struct FileInfo {
     FileInfo();
     ~FileInfo();
+    FileInfo(const FileInfo&);
+    FileInfo& operator=(const FileInfo&);
     bool unpacked;
     bool executable;
+    // The uncompressed size of the file.
     uint32_t size;
     uint64_t offset;
     std::optional<IntegrityPayload> integrity;
+    std::optional<CompressionPayload> compression;
   };
 
   enum class FileType {
@@ -97,16 +129,136 @@ class Archive {
   // for integrity validation after this fd is handed over.
   int GetUnsafeFD() const;
 
+  // Returns the bytes in [offset, offset + size) of the archive from its
+  // read-only mapping, which stays valid for the lifetime of the archive.
+  // Returns std::nullopt when the archive could not be mapped or the range is
+  // out of bounds, in which case callers should fall back to reading the file.
+  // Like GetUnsafeFD(), no integrity validation is done on the returned data.
+  std::optional<base::span<const uint8_t>> GetMappedData(uint64_t offset,
+                                                         uint64_t size) const;
+
+  // Decompresses block |block| of the compressed packed file |info| into
+  // |out|. Like GetMappedData(), no integrity validation is done.
+  bool DecompressBlock(const FileInfo& info,
+                       uint32_t block,
+                       std::string* out);
+
+  // Decompresses the whole compressed packed file |info| into |out|. Like
+  // GetMappedData(), no integrity validation is done.
+  bool DecompressFile(const FileInfo& info, std::string* out);
+
+  // Tracks which integrity blocks of packed files have been verified by this
+  // process, so repeated reads of the same file can skip hashing them again.
+  // Files are identified by their offset in the archive. Like the header
+  // index, this assumes the archive isn't modified while it is open.
+  bool IsBlockVerified(uint64_t file_offset, uint32_t block) const;
+  bool AreAllBlocksVerified(uint64_t file_offset, uint32_t block_count) const;
+  void MarkBlockVerified(uint64_t file_offset,
+                         uint32_t block,
+                         uint32_t block_count);
+  void MarkAllBlocksVerified(uint64_t file_offset, uint32_t block_count);
+
+  // Reads of packed files done while an archive is first opened are recorded
+  // into a prefetch manifest stored next to the index cache, so later launches
+  // can warm the page cache with them before they are needed. Only done when
+  // --asar-index-cache-dir is set.
+  bool HasPrefetchManifestPath() const {
+    return !prefetch_manifest_path_.empty();
+  }
+  // Whether Init() found no manifest and reads are being recorded.
+  bool IsRecordingReads() const {
+    return recording_reads_.load(std::memory_order_relaxed);
+  }
+  // Asks the OS to read ahead the ranges listed in the manifest.
+  void PrefetchRecordedReads();
+  // Stops recording and writes the ranges read so far to the manifest.
+  void WriteRecordedReads();
+
+  // Accounts for |bytes| of this archive being sent to a consumer, such as a
+  // URL loader, and returns the running total.
+  uint64_t RecordBytesServed(uint64_t bytes) {
+    return bytes_served_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+  }
+  uint64_t bytes_served() const {
+    return bytes_served_.load(std::memory_order_relaxed);
+  }
+
   base::FilePath path() const { return path_; }
 
  private:
+  // A node of the header, flattened into |index_| and keyed by its full
+  // relative path using '/' as the separator.
+  struct Entry {
+    Entry();
+    ~Entry();
+    Entry(Entry&&);
+    Entry& operator=(Entry&&);
+
+    FileType type = FileType::kFile;
+    // Whether |info| describes a valid packed or unpacked file.
+    bool has_info = false;
+    // Set when integrity validation is required but the node has none.
+    bool missing_integrity = false;
+    FileInfo info;
+    // Target of a link, relative to the root of the archive.
+    std::string link;
+    // Positions of the children of a directory in |index_|, sorted by name.
+    std::vector<uint32_t> children;
+  };
+
+  using Index = base::flat_map<std::string, Entry>;
+
+  // Adds |node| and all of its descendants to |entries|.
+  void AddNodeToIndex(std::string path,
+                      const base::Value::Dict& node,
+                      std::vector<Index::value_type>* entries) const;
+
+  // Replaces |index_| with the contents of a file written by
+  // WriteIndexCache(). Returns false if the file is missing or invalid.
+  bool ReadIndexCache(const base::FilePath& cache_path);
+
+  // Serializes |index_| so later launches can skip parsing the header.
+  void WriteIndexCache(const base::FilePath& cache_path) const;
+
+  // Reads |size| bytes at |offset| of the archive into |out|, from the
+  // mapping when available.
+  bool ReadArchiveData(uint64_t offset, uint64_t size, char* out);
+
+  // Adds the range of the packed file |info| to the prefetch manifest.
+  void RecordRead(const FileInfo& info) const;
+
+  // Finds the entry for |path|, resolving linked parent directories.
+  const Entry* FindEntry(std::string_view path, int depth = 0) const;
+
+  // Follows links starting at |entry| until a non-link entry is found.
+  const Entry* ResolveLink(const Entry* entry) const;
+
   bool initialized_;
   bool header_validated_ = false;
   const base::FilePath path_;
   base::File file_;
   int fd_ = -1;
   uint32_t header_size_ = 0;
-  std::optional<base::Value::Dict> header_;
+  Index index_;
+
+  // Read-only view of the whole archive, used to serve packed files without
+  // a syscall per read.
+  base::MemoryMappedFile mapped_file_;
+
+  std::atomic<uint64_t> bytes_served_{0};
+
+  base::FilePath prefetch_manifest_path_;
+  std::atomic<bool> recording_reads_{false};
+  mutable base::Lock recorded_reads_lock_;
+  // (offset, size) of the packed files read while recording, in read order.
+  mutable std::vector<std::pair<uint64_t, uint64_t>> recorded_reads_
+      GUARDED_BY(recorded_reads_lock_);
+  mutable std::unordered_set<uint64_t> recorded_offsets_
+      GUARDED_BY(recorded_reads_lock_);
+
+  mutable base::Lock verified_blocks_lock_;
+  std::unordered_map<uint64_t, std::vector<bool>> verified_blocks_
+      GUARDED_BY(verified_blocks_lock_);
 
   // Cached external temporary files.
   base::Lock external_files_lock_;
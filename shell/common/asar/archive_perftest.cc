@@ -0,0 +1,150 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/json/json_writer.h"
+#include "base/pickle.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/timer/lap_timer.h"
+#include "base/values.h"
+#include "shell/common/asar/archive.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+namespace asar {
+
+namespace {
+
+constexpr int kDirectoryCount = 50;
+constexpr int kFilesPerDirectory = 40;
+constexpr size_t kFileSize = 4096;
+
+constexpr char kMetricPrefix[] = "Archive.";
+constexpr char kMetricLookupsPerSecond[] = "lookups_per_second";
+constexpr char kMetricReaddirsPerSecond[] = "readdirs_per_second";
+constexpr char kMetricReadsPerSecond[] = "reads_per_second";
+
+base::FilePath DirectoryName(int i) {
+  return base::FilePath::FromASCII("dir" + base::NumberToString(i));
+}
+
+base::FilePath FileName(int i) {
+  return base::FilePath::FromASCII("file" + base::NumberToString(i) + ".js");
+}
+
+// Writes an archive of kDirectoryCount directories of kFilesPerDirectory
+// files each, laid out the way the asar module packs them.
+bool WriteArchive(const base::FilePath& path) {
+  base::Value::Dict directories;
+  uint64_t offset = 0;
+  for (int i = 0; i < kDirectoryCount; ++i) {
+    base::Value::Dict files;
+    for (int j = 0; j < kFilesPerDirectory; ++j) {
+      files.Set(FileName(j).AsUTF8Unsafe(),
+                base::Value::Dict()
+                    .Set("size", static_cast<int>(kFileSize))
+                    .Set("offset", base::NumberToString(offset)));
+      offset += kFileSize;
+    }
+    directories.Set(DirectoryName(i).AsUTF8Unsafe(),
+                    base::Value::Dict().Set("files", std::move(files)));
+  }
+  std::string header;
+  if (!base::JSONWriter::Write(
+          base::Value::Dict().Set("files", std::move(directories)), &header))
+    return false;
+
+  base::Pickle header_pickle;
+  header_pickle.WriteString(header);
+  base::Pickle size_pickle;
+  size_pickle.WriteUInt32(header_pickle.size());
+
+  std::string contents(size_pickle.data_as_char(), size_pickle.size());
+  contents.append(header_pickle.data_as_char(), header_pickle.size());
+  contents.append(offset, 'x');
+  return base::WriteFile(path, contents);
+}
+
+class ArchivePerfTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    base::FilePath path = temp_dir_.GetPath().AppendASCII("app.asar");
+    ASSERT_TRUE(WriteArchive(path));
+    archive_ = std::make_unique<Archive>(path);
+    ASSERT_TRUE(archive_->Init());
+  }
+
+  perf_test::PerfResultReporter SetUpReporter(const std::string& story) {
+    perf_test::PerfResultReporter reporter(kMetricPrefix, story);
+    reporter.RegisterImportantMetric(kMetricLookupsPerSecond, "runs/s");
+    reporter.RegisterImportantMetric(kMetricReaddirsPerSecond, "runs/s");
+    reporter.RegisterImportantMetric(kMetricReadsPerSecond, "runs/s");
+    return reporter;
+  }
+
+  base::ScopedTempDir temp_dir_;
+  std::unique_ptr<Archive> archive_;
+};
+
+}  // namespace
+
+TEST_F(ArchivePerfTest, GetFileInfo) {
+  std::vector<base::FilePath> paths;
+  for (int i = 0; i < kDirectoryCount; ++i) {
+    for (int j = 0; j < kFilesPerDirectory; ++j)
+      paths.push_back(DirectoryName(i).Append(FileName(j)));
+  }
+
+  base::LapTimer timer;
+  Archive::FileInfo info;
+  size_t i = 0;
+  do {
+    ASSERT_TRUE(archive_->GetFileInfo(paths[i++ % paths.size()], &info));
+    timer.NextLap();
+  } while (!timer.HasTimeLimitExpired());
+
+  SetUpReporter("get_file_info")
+      .AddResult(kMetricLookupsPerSecond, timer.LapsPerSecond());
+}
+
+TEST_F(ArchivePerfTest, Readdir) {
+  base::LapTimer timer;
+  std::vector<base::FilePath> files;
+  int i = 0;
+  do {
+    files.clear();
+    base::FilePath directory = DirectoryName(i++ % kDirectoryCount);
+    ASSERT_TRUE(archive_->Readdir(directory, &files));
+    timer.NextLap();
+  } while (!timer.HasTimeLimitExpired());
+
+  SetUpReporter("readdir")
+      .AddResult(kMetricReaddirsPerSecond, timer.LapsPerSecond());
+}
+
+TEST_F(ArchivePerfTest, ReadMappedFile) {
+  base::FilePath path = DirectoryName(0).Append(FileName(0));
+  Archive::FileInfo info;
+  ASSERT_TRUE(archive_->GetFileInfo(path, &info));
+
+  base::LapTimer timer;
+  do {
+    ASSERT_TRUE(archive_->GetFileInfo(path, &info));
+    ASSERT_TRUE(archive_->GetMappedData(info.offset, info.size).has_value());
+    timer.NextLap();
+  } while (!timer.HasTimeLimitExpired());
+
+  SetUpReporter("read_mapped_file")
+      .AddResult(kMetricReadsPerSecond, timer.LapsPerSecond());
+}
+
+}  // namespace asar
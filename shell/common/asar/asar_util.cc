@@ -4,19 +4,33 @@
 
 #include "shell/common/asar/asar_util.h"
 
+#include <algorithm>
+#include <atomic>
+#include <limits>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
+#include "base/containers/lru_cache.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/functional/bind.h"
 #include "base/logging.h"
+#include "base/memory/raw_ptr.h"
+#include "base/memory/ref_counted.h"
 #include "base/no_destructor.h"
 #include "base/stl_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/synchronization/lock.h"
+#include "base/system/sys_info.h"
+#include "base/task/thread_pool.h"
+#include "base/task/thread_pool/thread_pool_instance.h"
+#include "base/threading/platform_thread.h"
 #include "base/threading/thread_local.h"
+#include "base/time/time.h"
 #include "crypto/secure_hash.h"
 #include "crypto/sha2.h"
 #include "shell/common/asar/archive.h"
@@ -28,22 +42,212 @@ namespace {
 
 typedef std::map<base::FilePath, std::shared_ptr<Archive>> ArchiveMap;
 
+// Per-thread view of the archive cache. Entries are weak so an archive dropped
+// from the global cache is not kept alive by threads that looked it up before.
+struct ThreadArchiveCache {
+  uint64_t generation = 0;
+  std::map<base::FilePath, std::weak_ptr<Archive>> archives;
+};
+
 const base::FilePath::CharType kAsarExtension[] = FILE_PATH_LITERAL(".asar");
 
-bool IsDirectoryCached(const base::FilePath& path) {
-  static base::NoDestructor<std::map<base::FilePath, bool>>
-      s_is_directory_cache;
+// Upper bound on the number of remembered ".asar" paths.
+constexpr size_t kMaxDirectoryCacheSize = 1024;
+
+using DirectoryCache = base::HashingLRUCache<base::FilePath, bool>;
+
+base::Lock& GetDirectoryCacheLock() {
   static base::NoDestructor<base::Lock> lock;
+  return *lock;
+}
+
+DirectoryCache& GetDirectoryCache() {
+  static base::NoDestructor<DirectoryCache> s_is_directory_cache(
+      kMaxDirectoryCacheSize);
+  return *s_is_directory_cache;
+}
+
+bool IsDirectoryCached(const base::FilePath& path) {
+  {
+    base::AutoLock auto_lock(GetDirectoryCacheLock());
+    auto& is_directory_cache = GetDirectoryCache();
+    auto it = is_directory_cache.Get(path);
+    if (it != is_directory_cache.end())
+      return it->second;
+  }
+
+  // Don't hold the lock while hitting the disk, so a slow stat doesn't stall
+  // other threads looking up unrelated paths.
+  bool is_directory;
+  {
+    electron::ScopedAllowBlockingForElectron allow_blocking;
+    is_directory = base::DirectoryExists(path);
+  }
+
+  base::AutoLock auto_lock(GetDirectoryCacheLock());
+  GetDirectoryCache().Put(path, is_directory);
+  return is_directory;
+}
+
+// Bumped whenever archives are removed from the global cache, which
+// invalidates every thread's view of it.
+std::atomic<uint64_t> g_archive_cache_generation{1};
+
+ThreadArchiveCache& GetThreadArchiveCache() {
+  static base::NoDestructor<base::ThreadLocalOwnedPointer<ThreadArchiveCache>>
+      s_thread_cache;
+  ThreadArchiveCache* cache = s_thread_cache->Get();
+  if (!cache) {
+    auto new_cache = std::make_unique<ThreadArchiveCache>();
+    cache = new_cache.get();
+    s_thread_cache->Set(std::move(new_cache));
+  }
+  return *cache;
+}
+
+// How long reads are recorded for after an archive without a prefetch
+// manifest is opened, which is meant to cover the startup of most apps.
+constexpr base::TimeDelta kReadRecordingDuration = base::Seconds(10);
+
+// Prefetches the reads recorded by an earlier launch in the background, or
+// writes out the reads of this launch once startup should be over.
+void ScheduleArchivePrefetch(const std::shared_ptr<Archive>& archive) {
+  if (!archive->HasPrefetchManifestPath() || !base::ThreadPoolInstance::Get())
+    return;
+
+  std::weak_ptr<Archive> weak_archive = archive;
+  if (archive->IsRecordingReads()) {
+    base::ThreadPool::PostDelayedTask(
+        FROM_HERE,
+        {base::MayBlock(), base::TaskPriority::BEST_EFFORT,
+         base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN},
+        base::BindOnce(
+            [](std::weak_ptr<Archive> weak_archive) {
+              if (std::shared_ptr<Archive> archive = weak_archive.lock())
+                archive->WriteRecordedReads();
+            },
+            std::move(weak_archive)),
+        kReadRecordingDuration);
+  } else {
+    base::ThreadPool::PostTask(
+        FROM_HERE,
+        {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+         base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN},
+        base::BindOnce(
+            [](std::weak_ptr<Archive> weak_archive) {
+              if (std::shared_ptr<Archive> archive = weak_archive.lock())
+                archive->PrefetchRecordedReads();
+            },
+            std::move(weak_archive)));
+  }
+}
+
+// Files with fewer blocks than this are hashed on the calling thread.
+constexpr size_t kMinBlocksForParallelValidation = 2;
+
+std::string HashBlock(const char* data, size_t size) {
+  uint8_t hash[crypto::kSHA256Length];
+  auto hasher = crypto::SecureHash::Create(crypto::SecureHash::SHA256);
+  hasher->Update(data, size);
+  hasher->Finish(hash, sizeof(hash));
+  return base::ToLowerASCII(base::HexEncode(hash, sizeof(hash)));
+}
+
+// Verifies the per-block hashes of a buffer, with blocks claimed by the calling
+// thread and by helpers on the thread pool. The caller keeps working until no
+// block is left unclaimed, so it never waits on a helper that hasn't started
+// and no sync primitive is needed; helpers that start late find nothing to do.
+class BlockValidator : public base::RefCountedThreadSafe<BlockValidator> {
+ public:
+  BlockValidator(const char* data,
+                 size_t size,
+                 const IntegrityPayload& integrity)
+      : data_(data),
+        size_(size),
+        block_size_(integrity.block_size),
+        block_count_(integrity.blocks.size()),
+        blocks_(&integrity.blocks) {}
+
+  // disable copy
+  BlockValidator(const BlockValidator&) = delete;
+  BlockValidator& operator=(const BlockValidator&) = delete;
+
+  void Run() {
+    for (size_t block = next_block_.fetch_add(1); block < block_count_;
+         block = next_block_.fetch_add(1)) {
+      const size_t offset = block * block_size_;
+      const size_t length = std::min<size_t>(block_size_, size_ - offset);
+      if (HashBlock(data_ + offset, length) != (*blocks_)[block])
+        failed_block_.store(block, std::memory_order_relaxed);
+      finished_blocks_.fetch_add(1, std::memory_order_release);
+    }
+  }
+
+  // Returns the index of a block that failed validation, if any. Must be
+  // called after Run() on the owning thread.
+  std::optional<size_t> WaitForResult() {
+    while (finished_blocks_.load(std::memory_order_acquire) < block_count_)
+      base::PlatformThread::YieldCurrentThread();
+
+    // Every block has been claimed, so helpers that start from now on won't
+    // touch the caller's buffers.
+    data_ = nullptr;
+    blocks_ = nullptr;
+
+    const size_t failed_block = failed_block_.load(std::memory_order_relaxed);
+    if (failed_block == kNoFailure)
+      return std::nullopt;
+    return failed_block;
+  }
 
-  base::AutoLock auto_lock(*lock);
-  auto& is_directory_cache = *s_is_directory_cache;
+ private:
+  friend class base::RefCountedThreadSafe<BlockValidator>;
+  ~BlockValidator() = default;
+
+  static constexpr size_t kNoFailure = std::numeric_limits<size_t>::max();
+
+  raw_ptr<const char, AllowPtrArithmetic> data_;
+  const size_t size_;
+  const size_t block_size_;
+  const size_t block_count_;
+  raw_ptr<const std::vector<std::string>> blocks_;
+
+  std::atomic<size_t> next_block_{0};
+  std::atomic<size_t> finished_blocks_{0};
+  std::atomic<size_t> failed_block_{kNoFailure};
+};
+
+// Checks |data| against its block hashes, spreading the work over the thread
+// pool for large files. When every block matches, the whole file matches what
+// was hashed at packaging time. Returns false if the blocks don't describe
+// |data| exactly, in which case the caller should hash the whole buffer.
+bool ValidateBlocksInParallel(const char* data,
+                              size_t size,
+                              const IntegrityPayload& integrity) {
+  const size_t block_count = integrity.blocks.size();
+  if (integrity.block_size == 0 ||
+      block_count < kMinBlocksForParallelValidation ||
+      block_count != (size + integrity.block_size - 1) / integrity.block_size) {
+    return false;
+  }
+
+  auto validator = base::MakeRefCounted<BlockValidator>(data, size, integrity);
+  if (base::ThreadPoolInstance::Get()) {
+    const size_t helpers =
+        std::min<size_t>(block_count, base::SysInfo::NumberOfProcessors()) - 1;
+    for (size_t i = 0; i < helpers; ++i) {
+      base::ThreadPool::PostTask(
+          FROM_HERE, {base::TaskPriority::USER_BLOCKING},
+          base::BindOnce(&BlockValidator::Run, validator));
+    }
+  }
+  validator->Run();
 
-  auto it = is_directory_cache.find(path);
-  if (it != is_directory_cache.end()) {
-    return it->second;
+  if (std::optional<size_t> failed_block = validator->WaitForResult()) {
+    LOG(FATAL) << "Integrity check failed for block " << *failed_block
+               << " of asar archive file";
   }
-  electron::ScopedAllowBlockingForElectron allow_blocking;
-  return is_directory_cache[path] = base::DirectoryExists(path);
+  return true;
 }
 
 }  // namespace
@@ -59,18 +263,38 @@ base::Lock& GetArchiveCacheLock() {
 }
 
 std::shared_ptr<Archive> GetOrCreateAsarArchive(const base::FilePath& path) {
+  // Fast path: archives this thread has seen before are found without taking
+  // the global lock.
+  ThreadArchiveCache& thread_cache = GetThreadArchiveCache();
+  const uint64_t generation =
+      g_archive_cache_generation.load(std::memory_order_acquire);
+  if (thread_cache.generation != generation) {
+    thread_cache.archives.clear();
+    thread_cache.generation = generation;
+  }
+  if (auto it = thread_cache.archives.find(path);
+      it != thread_cache.archives.end()) {
+    if (std::shared_ptr<Archive> archive = it->second.lock())
+      return archive;
+    thread_cache.archives.erase(it);
+  }
+
   base::AutoLock auto_lock(GetArchiveCacheLock());
   ArchiveMap& map = GetArchiveCache();
 
   // if we have it, return it
   const auto lower = map.lower_bound(path);
-  if (lower != std::end(map) && !map.key_comp()(path, lower->first))
+  if (lower != std::end(map) && !map.key_comp()(path, lower->first)) {
+    thread_cache.archives[path] = lower->second;
     return lower->second;
+  }
 
   // if we can create it, return it
   auto archive = std::make_shared<Archive>(path);
   if (archive->Init()) {
     map.try_emplace(lower, path, archive);
+    thread_cache.archives[path] = archive;
+    ScheduleArchivePrefetch(archive);
     return archive;
   }
 
@@ -79,10 +303,16 @@ std::shared_ptr<Archive> GetOrCreateAsarArchive(const base::FilePath& path) {
 }
 
 void ClearArchives() {
-  base::AutoLock auto_lock(GetArchiveCacheLock());
-  ArchiveMap& map = GetArchiveCache();
+  {
+    base::AutoLock auto_lock(GetArchiveCacheLock());
+    ArchiveMap& map = GetArchiveCache();
+
+    map.clear();
+    g_archive_cache_generation.fetch_add(1, std::memory_order_release);
+  }
 
-  map.clear();
+  base::AutoLock auto_lock(GetDirectoryCacheLock());
+  GetDirectoryCache().Clear();
 }
 
 bool GetAsarArchivePath(const base::FilePath& full_path,
@@ -129,20 +359,32 @@ bool ReadFileToString(const base::FilePath& path, std::string* contents) {
     return base::ReadFileToString(real_path, contents);
   }
 
-  base::File src(asar_path, base::File::FLAG_OPEN | base::File::FLAG_READ);
-  if (!src.IsValid())
-    return false;
+  if (info.compression) {
+    if (!archive->DecompressFile(info, contents))
+      return false;
+  } else if (std::optional<base::span<const uint8_t>> data =
+                 archive->GetMappedData(info.offset, info.size)) {
+    contents->assign(data->begin(), data->end());
+  } else {
+    base::File src(asar_path, base::File::FLAG_OPEN | base::File::FLAG_READ);
+    if (!src.IsValid())
+      return false;
 
-  contents->resize(info.size);
-  if (static_cast<int>(info.size) !=
-      src.Read(info.offset, const_cast<char*>(contents->data()),
-               contents->size())) {
-    return false;
+    contents->resize(info.size);
+    if (static_cast<int>(info.size) !=
+        src.Read(info.offset, const_cast<char*>(contents->data()),
+                 contents->size())) {
+      return false;
+    }
   }
 
   if (info.integrity.has_value()) {
-    ValidateIntegrityOrDie(contents->data(), contents->size(),
-                           info.integrity.value());
+    const uint32_t block_count = info.integrity->blocks.size();
+    if (!archive->AreAllBlocksVerified(info.offset, block_count)) {
+      ValidateIntegrityOrDie(contents->data(), contents->size(),
+                             info.integrity.value());
+      archive->MarkAllBlocksVerified(info.offset, block_count);
+    }
   }
 
   return true;
@@ -151,6 +393,11 @@ bool ReadFileToString(const base::FilePath& path, std::string* contents) {
 void ValidateIntegrityOrDie(const char* data,
                             size_t size,
                             const IntegrityPayload& integrity) {
+  if (integrity.algorithm == HashAlgorithm::kSHA256 &&
+      ValidateBlocksInParallel(data, size, integrity)) {
+    return;
+  }
+
   if (integrity.algorithm == HashAlgorithm::kSHA256) {
     uint8_t hash[crypto::kSHA256Length];
     auto hasher = crypto::SecureHash::Create(crypto::SecureHash::SHA256);
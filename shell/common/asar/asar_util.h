@@ -17,10 +17,11 @@ namespace asar {
 class Archive;
 struct IntegrityPayload;
 
-// Gets or creates and caches a new Archive from the path.
+// Gets or creates and caches a new Archive from the path. Lookups of archives
+// the calling thread has already seen don't take any lock.
 std::shared_ptr<Archive> GetOrCreateAsarArchive(const base::FilePath& path);
 
-// Destroy cached Archive objects.
+// Destroy cached Archive objects and forget which paths are directories.
 void ClearArchives();
 
 // Separates the path to Archive out.
@@ -4,19 +4,90 @@
 
 #include "shell/common/asar/scoped_temporary_file.h"
 
+#include <string>
+#include <string_view>
 #include <vector>
 
 #include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
 #include "base/logging.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "crypto/sha2.h"
 #include "shell/common/asar/asar_util.h"
 #include "shell/common/thread_restrictions.h"
 
+#if BUILDFLAG(IS_LINUX)
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+
+#include "base/posix/eintr_wrapper.h"
+#endif
+
 namespace asar {
 
+namespace {
+
+// Reads |size| bytes at |offset| of |src| and validates them when integrity is
+// available.
+bool ReadContents(base::File* src,
+                  uint64_t offset,
+                  uint64_t size,
+                  const std::optional<IntegrityPayload>& integrity,
+                  std::vector<char>* buf) {
+  if (!src->IsValid())
+    return false;
+
+  electron::ScopedAllowBlockingForElectron allow_blocking;
+  buf->resize(size);
+  int len = src->Read(offset, buf->data(), buf->size());
+  if (len != static_cast<int>(size))
+    return false;
+
+  if (integrity.has_value()) {
+    ValidateIntegrityOrDie(buf->data(), buf->size(), integrity.value());
+  }
+
+  return true;
+}
+
+std::string HashContents(const std::vector<char>& buf) {
+  const std::string digest =
+      crypto::SHA256HashString(std::string_view(buf.data(), buf.size()));
+  return base::ToLowerASCII(base::HexEncode(digest.data(), digest.size()));
+}
+
+// Opens the cache entry at |path| and returns it when its content matches
+// |integrity|, or an invalid file otherwise.
+base::File OpenVerifiedCacheEntry(const base::FilePath& path,
+                                  uint64_t size,
+                                  const IntegrityPayload& integrity) {
+  electron::ScopedAllowBlockingForElectron allow_blocking;
+  base::File file(path, base::File::FLAG_OPEN | base::File::FLAG_READ |
+                            base::File::FLAG_WIN_EXCLUSIVE_WRITE);
+  if (!file.IsValid() || file.GetLength() != static_cast<int64_t>(size))
+    return base::File();
+
+  std::vector<char> buf(size);
+  if (file.Read(0, buf.data(), buf.size()) != static_cast<int>(size))
+    return base::File();
+  if (HashContents(buf) != integrity.hash) {
+    LOG(WARNING) << "Discarding modified asar extraction cache entry "
+                 << path.value();
+    return base::File();
+  }
+  return file;
+}
+
+}  // namespace
+
 ScopedTemporaryFile::ScopedTemporaryFile() = default;
 
 ScopedTemporaryFile::~ScopedTemporaryFile() {
-  if (!path_.empty()) {
+  if (!path_.empty() && delete_on_destruction_) {
     electron::ScopedAllowBlockingForElectron allow_blocking;
     // On Windows it is very likely the file is already in use (because it is
     // mostly used for Node native modules), so deleting it now will halt the
@@ -62,16 +133,11 @@ bool ScopedTemporaryFile::InitFromFile(
   if (!Init(ext))
     return false;
 
-  electron::ScopedAllowBlockingForElectron allow_blocking;
-  std::vector<char> buf(size);
-  int len = src->Read(offset, buf.data(), buf.size());
-  if (len != static_cast<int>(size))
+  std::vector<char> buf;
+  if (!ReadContents(src, offset, size, integrity, &buf))
     return false;
 
-  if (integrity.has_value()) {
-    ValidateIntegrityOrDie(buf.data(), buf.size(), integrity.value());
-  }
-
+  electron::ScopedAllowBlockingForElectron allow_blocking;
   base::File dest(path_, base::File::FLAG_OPEN | base::File::FLAG_WRITE);
   if (!dest.IsValid())
     return false;
@@ -80,4 +146,114 @@ bool ScopedTemporaryFile::InitFromFile(
          static_cast<int>(size);
 }
 
+bool ScopedTemporaryFile::InitFromContents(
+    const base::FilePath::StringType& ext,
+    std::string_view contents) {
+  if (!Init(ext))
+    return false;
+
+  electron::ScopedAllowBlockingForElectron allow_blocking;
+  return base::WriteFile(path_, contents);
+}
+
+bool ScopedTemporaryFile::InitCachedFromFile(
+    const base::FilePath& cache_dir,
+    base::File* src,
+    const base::FilePath::StringType& ext,
+    uint64_t offset,
+    uint64_t size,
+    const std::optional<IntegrityPayload>& integrity) {
+  if (!path_.empty())
+    return true;
+
+  // The cache lives outside of the protected archive, so only files whose hash
+  // is known can be told apart from a modified copy.
+  if (!integrity.has_value() ||
+      integrity->algorithm != HashAlgorithm::kSHA256) {
+    return false;
+  }
+
+  base::FilePath cached_path =
+      cache_dir.AppendASCII(integrity->hash).AddExtension(ext);
+  base::File cached = OpenVerifiedCacheEntry(cached_path, size, *integrity);
+  if (!cached.IsValid()) {
+    std::vector<char> buf;
+    if (!ReadContents(src, offset, size, integrity, &buf))
+      return false;
+
+    // Written atomically so other processes never see a partial file.
+    electron::ScopedAllowBlockingForElectron allow_blocking;
+    if (!base::CreateDirectory(cache_dir) ||
+        !base::ImportantFileWriter::WriteFileAtomically(
+            cached_path, std::string_view(buf.data(), buf.size()))) {
+      return false;
+    }
+    cached = OpenVerifiedCacheEntry(cached_path, size, *integrity);
+    if (!cached.IsValid())
+      return false;
+  }
+
+  // Users of the file go through the handle that was verified, so replacing
+  // the cache entry afterwards has no effect on them.
+#if BUILDFLAG(IS_WIN)
+  // The handle doesn't share writing or deleting, which keeps the entry from
+  // being changed for as long as it is open.
+  path_ = cached_path;
+#elif BUILDFLAG(IS_MAC)
+  path_ = base::FilePath(base::StrCat(
+      {"/dev/fd/", base::NumberToString(cached.GetPlatformFile())}));
+#else
+  path_ = base::FilePath(base::StrCat(
+      {"/proc/self/fd/", base::NumberToString(cached.GetPlatformFile())}));
+#endif
+  cached_file_ = std::move(cached);
+  delete_on_destruction_ = false;
+  return true;
+}
+
+#if BUILDFLAG(IS_LINUX)
+bool ScopedTemporaryFile::InitInMemoryFromFile(
+    base::File* src,
+    uint64_t offset,
+    uint64_t size,
+    const std::optional<IntegrityPayload>& integrity) {
+  if (!path_.empty())
+    return true;
+
+  std::vector<char> buf;
+  if (!ReadContents(src, offset, size, integrity, &buf))
+    return false;
+
+  // Native modules are mapped executable, which kernels enforcing
+  // vm.memfd_noexec only allow when MFD_EXEC is requested explicitly. Older
+  // kernels reject the unknown flag, so retry without it.
+  unsigned int flags = MFD_CLOEXEC;
+#if defined(MFD_EXEC)
+  flags |= MFD_EXEC;
+#endif
+  base::ScopedFD fd(memfd_create("electron-asar", flags));
+  if (!fd.is_valid() && errno == EINVAL)
+    fd.reset(memfd_create("electron-asar", MFD_CLOEXEC));
+  if (!fd.is_valid())
+    return false;
+
+  size_t written = 0;
+  while (written < buf.size()) {
+    ssize_t result = HANDLE_EINTR(
+        write(fd.get(), buf.data() + written, buf.size() - written));
+    if (result <= 0)
+      return false;
+    written += result;
+  }
+
+  // The path is only valid in this process, which is where native modules are
+  // loaded.
+  path_ = base::FilePath(base::StrCat(
+      {"/proc/self/fd/", base::NumberToString(fd.get())}));
+  memfd_ = std::move(fd);
+  delete_on_destruction_ = false;
+  return true;
+}
+#endif
+
 }  // namespace asar
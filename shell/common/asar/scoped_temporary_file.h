@@ -6,13 +6,17 @@
 #define ELECTRON_SHELL_COMMON_ASAR_SCOPED_TEMPORARY_FILE_H_
 
 #include <optional>
+#include <string_view>
+#include <vector>
 
+#include "base/files/file.h"
 #include "base/files/file_path.h"
+#include "build/build_config.h"
 #include "shell/common/asar/archive.h"
 
-namespace base {
-class File;
-}
+#if BUILDFLAG(IS_LINUX)
+#include "base/files/scoped_file.h"
+#endif
 
 namespace asar {
 
@@ -37,10 +41,44 @@ class ScopedTemporaryFile {
                     uint64_t size,
                     const std::optional<IntegrityPayload>& integrity);
 
+  // Init a temporary file and fill it with |contents|, which the caller has
+  // already validated.
+  bool InitFromContents(const base::FilePath::StringType& ext,
+                        std::string_view contents);
+
+  // Reuses, or creates, a file in |cache_dir| named after the integrity hash of
+  // the content, so that later launches don't have to write it out again. Only
+  // files with integrity are cached, and path() refers to the verified file
+  // for as long as this object is alive. The file is kept when this object is
+  // destroyed.
+  bool InitCachedFromFile(const base::FilePath& cache_dir,
+                          base::File* src,
+                          const base::FilePath::StringType& ext,
+                          uint64_t offset,
+                          uint64_t size,
+                          const std::optional<IntegrityPayload>& integrity);
+
+#if BUILDFLAG(IS_LINUX)
+  // Fills an anonymous in-memory file with the content, so it never touches
+  // the disk. path() refers to it through /proc/self, so it can only be used
+  // by this process, for as long as this object is alive.
+  bool InitInMemoryFromFile(base::File* src,
+                            uint64_t offset,
+                            uint64_t size,
+                            const std::optional<IntegrityPayload>& integrity);
+#endif
+
   base::FilePath path() const { return path_; }
 
  private:
   base::FilePath path_;
+  // False for files that must outlive this object, like cached extractions.
+  bool delete_on_destruction_ = true;
+  // The verified handle of a cached extraction.
+  base::File cached_file_;
+#if BUILDFLAG(IS_LINUX)
+  base::ScopedFD memfd_;
+#endif
 };
 
 }  // namespace asar
@@ -0,0 +1,218 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/async_log_sink.h"
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "base/files/file_path.h"
+#include "base/functional/bind.h"
+#include "base/logging.h"
+#include "base/no_destructor.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/lock.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
+#include "base/task/thread_pool/thread_pool_instance.h"
+#include "base/thread_annotations.h"
+#include "base/time/time.h"
+#include "build/build_config.h"
+
+namespace logging {
+
+namespace {
+
+// Messages beyond this much unwritten output are dropped, so that a writer
+// that falls behind doesn't grow the buffer without bounds.
+constexpr size_t kMaxBufferSize = 8 * 1024 * 1024;
+
+// The file is moved to "<path>.old" once it grows past this size.
+constexpr long kMaxLogFileSize = 64 * 1024 * 1024;
+
+// Verbose and informational messages of a source file beyond this many per
+// second are dropped and counted.
+constexpr int kMaxMessagesPerSecond = 200;
+
+// The file is written with stdio, which unlike base::File doesn't assert that
+// blocking is allowed, as the fatal messages are written on any thread.
+FILE* OpenLogFile(const base::FilePath& path, bool truncate) {
+#if BUILDFLAG(IS_WIN)
+  return _wfopen(path.value().c_str(), truncate ? L"wb" : L"ab");
+#else
+  return fopen(path.value().c_str(), truncate ? "wb" : "ab");
+#endif
+}
+
+void ReplaceFile(const base::FilePath& from, const base::FilePath& to) {
+#if BUILDFLAG(IS_WIN)
+  _wremove(to.value().c_str());
+  _wrename(from.value().c_str(), to.value().c_str());
+#else
+  rename(from.value().c_str(), to.value().c_str());
+#endif
+}
+
+class AsyncLogSink {
+ public:
+  AsyncLogSink(const base::FilePath& path, bool delete_old)
+      : path_(path),
+        task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+            {base::MayBlock(), base::TaskPriority::BEST_EFFORT,
+             base::TaskShutdownBehavior::BLOCK_SHUTDOWN})) {
+    base::AutoLock auto_lock(file_lock_);
+    file_ = OpenLogFile(path_, delete_old);
+    if (file_) {
+      fseek(file_, 0, SEEK_END);
+      file_size_ = ftell(file_);
+    }
+  }
+
+  // disable copy
+  AsyncLogSink(const AsyncLogSink&) = delete;
+  AsyncLogSink& operator=(const AsyncLogSink&) = delete;
+
+  void OnMessage(int severity,
+                 const char* source_file,
+                 const std::string& str) {
+    if (severity == LOGGING_FATAL) {
+      // The process is about to crash, so write everything right away.
+      base::AutoLock file_auto_lock(file_lock_);
+      std::string data = TakeBuffer();
+      data.append(str);
+      WriteLocked(data);
+      return;
+    }
+
+    bool post_flush = false;
+    {
+      base::AutoLock auto_lock(lock_);
+      if (severity < LOGGING_WARNING && !ShouldLogLocked(source_file))
+        return;
+      if (buffer_.size() + str.size() > kMaxBufferSize) {
+        ++dropped_;
+        return;
+      }
+      buffer_.append(str);
+      // The message is written by the flush that is pending already, if any,
+      // so that the messages logged while the file is written get batched.
+      post_flush = !std::exchange(flush_pending_, true);
+    }
+
+    if (!post_flush)
+      return;
+    // The sink is never destroyed, so it outlives the task.
+    if (!task_runner_->PostTask(FROM_HERE,
+                                base::BindOnce(&AsyncLogSink::Flush,
+                                               base::Unretained(this)))) {
+      // The thread pool has shut down.
+      Flush();
+    }
+  }
+
+ private:
+  struct RateLimit {
+    base::TimeTicks window_start;
+    int count = 0;
+    int dropped = 0;
+  };
+
+  bool ShouldLogLocked(const char* source_file)
+      EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+    auto [it, inserted] = rate_limits_.try_emplace(source_file);
+    RateLimit& limit = it->second;
+    const base::TimeTicks now = base::TimeTicks::Now();
+    if (now - limit.window_start >= base::Seconds(1)) {
+      if (limit.dropped > 0) {
+        buffer_.append(base::StringPrintf("[%s] Dropped %d log messages\n",
+                                          source_file, limit.dropped));
+      }
+      limit = {.window_start = now};
+    }
+    if (limit.count >= kMaxMessagesPerSecond) {
+      ++limit.dropped;
+      return false;
+    }
+    ++limit.count;
+    return true;
+  }
+
+  std::string TakeBuffer() EXCLUSIVE_LOCKS_REQUIRED(file_lock_) {
+    base::AutoLock auto_lock(lock_);
+    flush_pending_ = false;
+    std::string data = std::exchange(buffer_, {});
+    if (dropped_ > 0) {
+      data.append(base::StringPrintf(
+          "Dropped %zu log messages while the log file was written\n",
+          std::exchange(dropped_, 0)));
+    }
+    return data;
+  }
+
+  void Flush() {
+    base::AutoLock file_auto_lock(file_lock_);
+    WriteLocked(TakeBuffer());
+  }
+
+  void WriteLocked(std::string_view data)
+      EXCLUSIVE_LOCKS_REQUIRED(file_lock_) {
+    if (!file_ || data.empty())
+      return;
+    if (file_size_ > 0 &&
+        file_size_ + static_cast<long>(data.size()) > kMaxLogFileSize) {
+      fclose(file_);
+      ReplaceFile(path_, path_.AddExtension(FILE_PATH_LITERAL("old")));
+      file_ = OpenLogFile(path_, /*truncate=*/true);
+      file_size_ = 0;
+      if (!file_)
+        return;
+    }
+    fwrite(data.data(), 1, data.size(), file_);
+    fflush(file_);
+    file_size_ += data.size();
+  }
+
+  const base::FilePath path_;
+  const scoped_refptr<base::SequencedTaskRunner> task_runner_;
+
+  // Guards the file. Taken before |lock_| so that the batches are written in
+  // the order they were taken from the buffer.
+  base::Lock file_lock_;
+  FILE* file_ GUARDED_BY(file_lock_) = nullptr;
+  long file_size_ GUARDED_BY(file_lock_) = 0;
+
+  base::Lock lock_;
+  std::string buffer_ GUARDED_BY(lock_);
+  bool flush_pending_ GUARDED_BY(lock_) = false;
+  size_t dropped_ GUARDED_BY(lock_) = 0;
+  // Keyed by the __FILE__ strings of the messages.
+  std::map<const char*, RateLimit> rate_limits_ GUARDED_BY(lock_);
+};
+
+AsyncLogSink* g_sink = nullptr;
+
+bool HandleLogMessage(int severity,
+                      const char* file,
+                      int line,
+                      size_t message_start,
+                      const std::string& str) {
+  g_sink->OnMessage(severity, file, str);
+  // Let the other destinations, if any, handle the message too.
+  return false;
+}
+
+}  // namespace
+
+void InitAsyncLogSink(const base::FilePath& path, bool delete_old) {
+  if (g_sink || !base::ThreadPoolInstance::Get())
+    return;
+  static base::NoDestructor<AsyncLogSink> sink(path, delete_old);
+  g_sink = sink.get();
+  SetLogMessageHandler(&HandleLogMessage);
+}
+
+}  // namespace logging
@@ -0,0 +1,24 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_ASYNC_LOG_SINK_H_
+#define ELECTRON_SHELL_COMMON_ASYNC_LOG_SINK_H_
+
+namespace base {
+class FilePath;
+}
+
+namespace logging {
+
+// Routes the log messages of this process to |path| through an in-memory
+// buffer, which is written to the file on a background sequence. Verbose and
+// informational messages are rate limited per source file, and the file is
+// moved to "<path>.old" once it grows past a size limit. Fatal messages, and
+// messages logged after the thread pool has shut down, are written
+// synchronously. Requires the thread pool, and does nothing when called again.
+void InitAsyncLogSink(const base::FilePath& path, bool delete_old);
+
+}  // namespace logging
+
+#endif  // ELECTRON_SHELL_COMMON_ASYNC_LOG_SINK_H_
@@ -0,0 +1,61 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/async_log_sink.h"
+
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/logging.h"
+#include "base/strings/stringprintf.h"
+#include "base/task/thread_pool/thread_pool_instance.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace logging {
+
+namespace {
+
+constexpr int kMessageCount = 100;
+
+}  // namespace
+
+// The sink can only be set up once per process, so everything is checked by
+// a single test.
+TEST(AsyncLogSinkTest, WritesInOrderAndFlushesOnShutdown) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const base::FilePath path = temp_dir.GetPath().AppendASCII("electron.log");
+
+  base::ThreadPoolInstance::CreateAndStartWithDefaultParams("AsyncLogSinkTest");
+  InitAsyncLogSink(path, /*delete_old=*/true);
+
+  // Warnings aren't rate limited, so none of them is dropped.
+  for (int i = 0; i < kMessageCount; ++i)
+    LOG(WARNING) << "message " << i;
+
+  // Like at exit, shutting the thread pool down waits for the pending flush,
+  // and the messages logged after that are written right away.
+  base::ThreadPoolInstance::Get()->Shutdown();
+  LOG(WARNING) << "after shutdown";
+
+  std::string contents;
+  ASSERT_TRUE(base::ReadFileToString(path, &contents));
+  size_t last_position = 0;
+  for (int i = 0; i < kMessageCount; ++i) {
+    size_t position =
+        contents.find(base::StringPrintf("message %d\n", i), last_position);
+    ASSERT_NE(position, std::string::npos) << "message " << i;
+    last_position = position;
+  }
+  EXPECT_NE(contents.find("after shutdown\n", last_position),
+            std::string::npos);
+
+  SetLogMessageHandler(nullptr);
+  base::ThreadPoolInstance::Get()->JoinForTesting();
+  base::ThreadPoolInstance::Set(nullptr);
+}
+
+}  // namespace logging
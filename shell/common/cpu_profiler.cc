@@ -0,0 +1,150 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/cpu_profiler.h"
+
+#include <cstdint>
+#include <map>
+#include <utility>
+
+#include "base/containers/circular_deque.h"
+#include "base/no_destructor.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/synchronization/lock.h"
+#include "base/thread_annotations.h"
+#include "gin/converter.h"
+#include "v8/include/v8-profiler.h"
+#include "v8/include/v8.h"
+
+namespace electron {
+
+namespace {
+
+constexpr char kProfileTitle[] = "electron";
+
+// The profilers that are running, there is at most one per isolate. Isolates
+// live on different threads, such as those of workers, so the map is guarded
+// by a lock. Each profiler is only used on the thread of its isolate.
+struct Profilers {
+  base::Lock lock;
+  std::map<v8::Isolate*, v8::CpuProfiler*> map GUARDED_BY(lock);
+};
+
+Profilers& GetProfilers() {
+  static base::NoDestructor<Profilers> profilers;
+  return *profilers;
+}
+
+base::Value::Dict ConvertProfileNode(v8::Isolate* isolate,
+                                     const v8::CpuProfileNode* node) {
+  // DevTools counts lines and columns from zero where V8 counts from one,
+  // with zero meaning that there is no information.
+  base::Value::Dict call_frame;
+  call_frame.Set("functionName",
+                 gin::V8ToString(isolate, node->GetFunctionName()));
+  call_frame.Set("scriptId", base::NumberToString(node->GetScriptId()));
+  call_frame.Set("url",
+                 gin::V8ToString(isolate, node->GetScriptResourceName()));
+  call_frame.Set("lineNumber", node->GetLineNumber() - 1);
+  call_frame.Set("columnNumber", node->GetColumnNumber() - 1);
+
+  base::Value::List children;
+  for (int i = 0; i < node->GetChildrenCount(); ++i)
+    children.Append(static_cast<int>(node->GetChild(i)->GetNodeId()));
+
+  base::Value::Dict result;
+  result.Set("id", static_cast<int>(node->GetNodeId()));
+  result.Set("callFrame", std::move(call_frame));
+  result.Set("hitCount", static_cast<int>(node->GetHitCount()));
+  if (!children.empty())
+    result.Set("children", std::move(children));
+  return result;
+}
+
+base::Value::Dict ConvertProfile(v8::Isolate* isolate,
+                                 const v8::CpuProfile* profile) {
+  // The nodes are listed flat, referring to their children by id.
+  base::Value::List nodes;
+  base::circular_deque<const v8::CpuProfileNode*> pending;
+  pending.push_back(profile->GetTopDownRoot());
+  while (!pending.empty()) {
+    const v8::CpuProfileNode* node = pending.front();
+    pending.pop_front();
+    nodes.Append(ConvertProfileNode(isolate, node));
+    for (int i = 0; i < node->GetChildrenCount(); ++i)
+      pending.push_back(node->GetChild(i));
+  }
+
+  // Sample times are sent as deltas from the previous one, in microseconds,
+  // which keeps long profiles compact.
+  base::Value::List samples;
+  base::Value::List time_deltas;
+  int64_t last_timestamp = profile->GetStartTime();
+  for (int i = 0; i < profile->GetSamplesCount(); ++i) {
+    samples.Append(static_cast<int>(profile->GetSample(i)->GetNodeId()));
+    int64_t timestamp = profile->GetSampleTimestamp(i);
+    time_deltas.Append(static_cast<double>(timestamp - last_timestamp));
+    last_timestamp = timestamp;
+  }
+
+  base::Value::Dict result;
+  result.Set("nodes", std::move(nodes));
+  result.Set("startTime", static_cast<double>(profile->GetStartTime()));
+  result.Set("endTime", static_cast<double>(profile->GetEndTime()));
+  result.Set("samples", std::move(samples));
+  result.Set("timeDeltas", std::move(time_deltas));
+  return result;
+}
+
+}  // namespace
+
+bool StartCpuProfiler(v8::Isolate* isolate, base::TimeDelta sampling_interval) {
+  auto& profilers = GetProfilers();
+  {
+    base::AutoLock auto_lock(profilers.lock);
+    if (profilers.map.contains(isolate))
+      return false;
+  }
+
+  v8::HandleScope handle_scope(isolate);
+  v8::CpuProfiler* profiler = v8::CpuProfiler::New(isolate);
+  profiler->SetSamplingInterval(
+      static_cast<int>(sampling_interval.InMicroseconds()));
+  v8::CpuProfilingStatus status = profiler->StartProfiling(
+      gin::StringToV8(isolate, kProfileTitle), /*record_samples=*/true);
+  if (status == v8::CpuProfilingStatus::kErrorTooManyProfilers) {
+    profiler->Dispose();
+    return false;
+  }
+
+  base::AutoLock auto_lock(profilers.lock);
+  profilers.map.emplace(isolate, profiler);
+  return true;
+}
+
+std::optional<base::Value::Dict> StopCpuProfiler(v8::Isolate* isolate) {
+  v8::CpuProfiler* profiler;
+  {
+    auto& profilers = GetProfilers();
+    base::AutoLock auto_lock(profilers.lock);
+    auto iter = profilers.map.find(isolate);
+    if (iter == profilers.map.end())
+      return std::nullopt;
+    profiler = iter->second;
+    profilers.map.erase(iter);
+  }
+
+  v8::HandleScope handle_scope(isolate);
+  v8::CpuProfile* profile =
+      profiler->StopProfiling(gin::StringToV8(isolate, kProfileTitle));
+  std::optional<base::Value::Dict> result;
+  if (profile) {
+    result = ConvertProfile(isolate, profile);
+    profile->Delete();
+  }
+  profiler->Dispose();
+  return result;
+}
+
+}  // namespace electron
@@ -0,0 +1,29 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_CPU_PROFILER_H_
+#define ELECTRON_SHELL_COMMON_CPU_PROFILER_H_
+
+#include <optional>
+
+#include "base/time/time.h"
+#include "base/values.h"
+
+namespace v8 {
+class Isolate;
+}
+
+namespace electron {
+
+// Starts V8's sampling CPU profiler on |isolate|, taking a sample of the
+// stack every |sampling_interval|. Returns false if it is already running.
+bool StartCpuProfiler(v8::Isolate* isolate, base::TimeDelta sampling_interval);
+
+// Stops the profiler started on |isolate| and returns the profile in the
+// format of DevTools' .cpuprofile files, or nullopt if it wasn't running.
+std::optional<base::Value::Dict> StopCpuProfiler(v8::Isolate* isolate);
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_COMMON_CPU_PROFILER_H_
@@ -8,6 +8,8 @@
 #include <deque>
 #include <map>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 
 #include "base/command_line.h"
 #include "base/environment.h"
@@ -45,6 +47,15 @@ std::deque<std::string>& GetExtraCrashKeyNames() {
   return *crash_key_names;
 }
 
+// Maps the names to their index in GetExtraCrashKeys(), so that setting a key
+// doesn't look through the names of all the other keys. The views point into
+// GetExtraCrashKeyNames(), whose elements never move.
+using CrashKeyIndices = std::unordered_map<std::string_view, size_t>;
+CrashKeyIndices& GetExtraCrashKeyIndices() {
+  static base::NoDestructor<CrashKeyIndices> crash_key_indices;
+  return *crash_key_indices;
+}
+
 }  // namespace
 
 constexpr uint32_t kMaxCrashKeyNameLength = 40;
@@ -66,24 +77,29 @@ void SetCrashKey(const std::string& key, const std::string& value) {
     return;
   }
 
-  auto& crash_key_names = GetExtraCrashKeyNames();
-
-  auto iter = std::find(crash_key_names.begin(), crash_key_names.end(), key);
-  if (iter == crash_key_names.end()) {
+  auto& crash_key_indices = GetExtraCrashKeyIndices();
+  auto iter = crash_key_indices.find(key);
+  if (iter == crash_key_indices.end()) {
+    auto& crash_key_names = GetExtraCrashKeyNames();
     crash_key_names.emplace_back(key);
     GetExtraCrashKeys().emplace_back(crash_key_names.back().c_str());
-    iter = crash_key_names.end() - 1;
+    iter = crash_key_indices
+               .emplace(crash_key_names.back(), crash_key_names.size() - 1)
+               .first;
   }
-  GetExtraCrashKeys()[iter - crash_key_names.begin()].Set(value);
+  GetExtraCrashKeys()[iter->second].Set(value);
 }
 
-void ClearCrashKey(const std::string& key) {
-  const auto& crash_key_names = GetExtraCrashKeyNames();
+void SetCrashKeys(const std::map<std::string, std::string>& keys) {
+  for (const auto& [key, value] : keys)
+    SetCrashKey(key, value);
+}
 
-  auto iter = std::find(crash_key_names.begin(), crash_key_names.end(), key);
-  if (iter != crash_key_names.end()) {
-    GetExtraCrashKeys()[iter - crash_key_names.begin()].Clear();
-  }
+void ClearCrashKey(const std::string& key) {
+  const auto& crash_key_indices = GetExtraCrashKeyIndices();
+  auto iter = crash_key_indices.find(key);
+  if (iter != crash_key_indices.end())
+    GetExtraCrashKeys()[iter->second].Clear();
 }
 
 void GetCrashKeys(std::map<std::string, std::string>* keys) {
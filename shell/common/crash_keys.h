@@ -15,6 +15,9 @@ class CommandLine;
 namespace electron::crash_keys {
 
 void SetCrashKey(const std::string& key, const std::string& value);
+// Sets several keys at once, which is cheaper than setting them one by one
+// for annotations that are updated together often.
+void SetCrashKeys(const std::map<std::string, std::string>& keys);
 void ClearCrashKey(const std::string& key);
 void GetCrashKeys(std::map<std::string, std::string>* keys);
 
@@ -0,0 +1,203 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/data_pipe_stream.h"
+
+#include <utility>
+
+#include "base/functional/bind.h"
+#include "base/task/sequenced_task_runner.h"
+#include "gin/handle.h"
+#include "gin/object_template_builder.h"
+
+namespace electron {
+
+namespace {
+
+// Large enough that a fast writer rarely has to wait for the reader to catch
+// up, without pinning much memory for streams that are mostly idle.
+constexpr uint32_t kPipeCapacity = 1024 * 1024;  // 1 MB
+
+char* GetData(v8::Local<v8::ArrayBufferView> buffer) {
+  return static_cast<char*>(buffer->Buffer()->Data()) + buffer->ByteOffset();
+}
+
+}  // namespace
+
+gin::WrapperInfo DataPipeStream::kWrapperInfo = {gin::kEmbedderNativeGin};
+
+// static
+gin::Handle<DataPipeStream> DataPipeStream::Create(
+    v8::Isolate* isolate,
+    mojo::ScopedDataPipeConsumerHandle consumer,
+    mojo::ScopedDataPipeProducerHandle producer) {
+  return gin::CreateHandle(isolate,
+                           new DataPipeStream(isolate, std::move(consumer),
+                                              std::move(producer)));
+}
+
+// static
+gin::Handle<DataPipeStream> DataPipeStream::CreatePair(
+    v8::Isolate* isolate,
+    mojo::ScopedDataPipeConsumerHandle* remote_consumer,
+    mojo::ScopedDataPipeProducerHandle* remote_producer) {
+  const MojoCreateDataPipeOptions options{sizeof(MojoCreateDataPipeOptions),
+                                          MOJO_CREATE_DATA_PIPE_FLAG_NONE, 1,
+                                          kPipeCapacity};
+  mojo::ScopedDataPipeConsumerHandle consumer;
+  mojo::ScopedDataPipeProducerHandle producer;
+  if (mojo::CreateDataPipe(&options, *remote_producer, consumer) !=
+          MOJO_RESULT_OK ||
+      mojo::CreateDataPipe(&options, producer, *remote_consumer) !=
+          MOJO_RESULT_OK) {
+    return gin::Handle<DataPipeStream>();
+  }
+  return Create(isolate, std::move(consumer), std::move(producer));
+}
+
+DataPipeStream::DataPipeStream(v8::Isolate* isolate,
+                               mojo::ScopedDataPipeConsumerHandle consumer,
+                               mojo::ScopedDataPipeProducerHandle producer)
+    : isolate_(isolate),
+      consumer_(std::move(consumer)),
+      read_watcher_(FROM_HERE,
+                    mojo::SimpleWatcher::ArmingPolicy::MANUAL,
+                    base::SequencedTaskRunner::GetCurrentDefault()),
+      producer_(std::move(producer)),
+      write_watcher_(FROM_HERE,
+                     mojo::SimpleWatcher::ArmingPolicy::MANUAL,
+                     base::SequencedTaskRunner::GetCurrentDefault()) {
+  if (consumer_) {
+    read_watcher_.Watch(
+        consumer_.get(),
+        MOJO_HANDLE_SIGNAL_READABLE | MOJO_HANDLE_SIGNAL_PEER_CLOSED,
+        base::BindRepeating(&DataPipeStream::ContinueRead,
+                            base::Unretained(this)));
+  }
+  if (producer_) {
+    write_watcher_.Watch(
+        producer_.get(),
+        MOJO_HANDLE_SIGNAL_WRITABLE | MOJO_HANDLE_SIGNAL_PEER_CLOSED,
+        base::BindRepeating(&DataPipeStream::ContinueWrite,
+                            base::Unretained(this)));
+  }
+}
+
+DataPipeStream::~DataPipeStream() = default;
+
+v8::Local<v8::Promise> DataPipeStream::Read(
+    v8::Local<v8::ArrayBufferView> buffer) {
+  gin_helper::Promise<int> promise(isolate_);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  if (!read_buffer_.IsEmpty()) {
+    promise.RejectWithErrorMessage("A read is already in progress.");
+    return handle;
+  }
+  read_buffer_.Reset(isolate_, buffer);
+  read_promise_ = std::move(promise);
+  ContinueRead(MOJO_RESULT_OK);
+  return handle;
+}
+
+void DataPipeStream::ContinueRead(MojoResult result) {
+  if (read_buffer_.IsEmpty())
+    return;
+
+  v8::HandleScope handle_scope(isolate_);
+  v8::Local<v8::ArrayBufferView> buffer = read_buffer_.Get(isolate_);
+  uint32_t num_bytes = buffer->ByteLength();
+  if (consumer_) {
+    result = consumer_->ReadData(GetData(buffer), &num_bytes,
+                                 MOJO_READ_DATA_FLAG_NONE);
+  } else {
+    result = MOJO_RESULT_FAILED_PRECONDITION;
+  }
+
+  if (result == MOJO_RESULT_SHOULD_WAIT) {
+    read_watcher_.ArmOrNotify();
+    return;
+  }
+
+  read_buffer_.Reset();
+  if (result == MOJO_RESULT_OK) {
+    read_promise_.Resolve(num_bytes);
+  } else {
+    // The other end has closed its producer, which ends the stream.
+    read_watcher_.Cancel();
+    consumer_.reset();
+    read_promise_.Resolve(0);
+  }
+}
+
+v8::Local<v8::Promise> DataPipeStream::Write(
+    v8::Local<v8::ArrayBufferView> buffer) {
+  gin_helper::Promise<void> promise(isolate_);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  if (!write_buffer_.IsEmpty()) {
+    promise.RejectWithErrorMessage("A write is already in progress.");
+    return handle;
+  }
+  write_buffer_.Reset(isolate_, buffer);
+  write_offset_ = 0;
+  write_promise_ = std::move(promise);
+  ContinueWrite(MOJO_RESULT_OK);
+  return handle;
+}
+
+void DataPipeStream::ContinueWrite(MojoResult result) {
+  if (write_buffer_.IsEmpty())
+    return;
+
+  v8::HandleScope handle_scope(isolate_);
+  v8::Local<v8::ArrayBufferView> buffer = write_buffer_.Get(isolate_);
+  while (producer_ && write_offset_ < buffer->ByteLength()) {
+    uint32_t num_bytes = buffer->ByteLength() - write_offset_;
+    result = producer_->WriteData(GetData(buffer) + write_offset_, &num_bytes,
+                                  MOJO_WRITE_DATA_FLAG_NONE);
+    if (result == MOJO_RESULT_SHOULD_WAIT) {
+      write_watcher_.ArmOrNotify();
+      return;
+    }
+    if (result != MOJO_RESULT_OK) {
+      write_watcher_.Cancel();
+      producer_.reset();
+      break;
+    }
+    write_offset_ += num_bytes;
+  }
+
+  write_buffer_.Reset();
+  if (write_offset_ == buffer->ByteLength())
+    write_promise_.Resolve();
+  else
+    write_promise_.RejectWithErrorMessage("The stream was closed.");
+}
+
+void DataPipeStream::End() {
+  write_watcher_.Cancel();
+  producer_.reset();
+  ContinueWrite(MOJO_RESULT_FAILED_PRECONDITION);
+}
+
+void DataPipeStream::Close() {
+  End();
+  read_watcher_.Cancel();
+  consumer_.reset();
+  ContinueRead(MOJO_RESULT_FAILED_PRECONDITION);
+}
+
+gin::ObjectTemplateBuilder DataPipeStream::GetObjectTemplateBuilder(
+    v8::Isolate* isolate) {
+  return gin::Wrappable<DataPipeStream>::GetObjectTemplateBuilder(isolate)
+      .SetMethod("read", &DataPipeStream::Read)
+      .SetMethod("write", &DataPipeStream::Write)
+      .SetMethod("end", &DataPipeStream::End)
+      .SetMethod("close", &DataPipeStream::Close);
+}
+
+const char* DataPipeStream::GetTypeName() {
+  return "DataPipeStream";
+}
+
+}  // namespace electron
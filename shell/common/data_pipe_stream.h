@@ -0,0 +1,85 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_DATA_PIPE_STREAM_H_
+#define ELECTRON_SHELL_COMMON_DATA_PIPE_STREAM_H_
+
+#include "base/memory/raw_ptr.h"
+#include "gin/wrappable.h"
+#include "mojo/public/cpp/system/data_pipe.h"
+#include "mojo/public/cpp/system/simple_watcher.h"
+#include "shell/common/gin_helper/promise.h"
+#include "v8/include/v8.h"
+
+namespace gin {
+template <typename T>
+class Handle;
+}  // namespace gin
+
+namespace electron {
+
+// One end of a byte stream between two processes, made of a data pipe in each
+// direction. Bytes are copied straight between the pipes and the buffers
+// passed to read() and write(), and a full pipe holds back the writer, so the
+// JS side can wrap it in a Duplex without serializing every chunk.
+class DataPipeStream : public gin::Wrappable<DataPipeStream> {
+ public:
+  static gin::Handle<DataPipeStream> Create(
+      v8::Isolate* isolate,
+      mojo::ScopedDataPipeConsumerHandle consumer,
+      mojo::ScopedDataPipeProducerHandle producer);
+
+  // Creates both pipes, returning this end and the other end in
+  // |remote_consumer| and |remote_producer|, or an empty handle on failure.
+  static gin::Handle<DataPipeStream> CreatePair(
+      v8::Isolate* isolate,
+      mojo::ScopedDataPipeConsumerHandle* remote_consumer,
+      mojo::ScopedDataPipeProducerHandle* remote_producer);
+
+  // disable copy
+  DataPipeStream(const DataPipeStream&) = delete;
+  DataPipeStream& operator=(const DataPipeStream&) = delete;
+
+  // gin::Wrappable
+  static gin::WrapperInfo kWrapperInfo;
+  gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
+      v8::Isolate* isolate) override;
+  const char* GetTypeName() override;
+
+ private:
+  DataPipeStream(v8::Isolate* isolate,
+                 mojo::ScopedDataPipeConsumerHandle consumer,
+                 mojo::ScopedDataPipeProducerHandle producer);
+  ~DataPipeStream() override;
+
+  // Resolves with the number of bytes read into |buffer|, or 0 once the other
+  // end has stopped writing.
+  v8::Local<v8::Promise> Read(v8::Local<v8::ArrayBufferView> buffer);
+  // Resolves once all of |buffer| has been written to the pipe.
+  v8::Local<v8::Promise> Write(v8::Local<v8::ArrayBufferView> buffer);
+  // Stops writing, so that reads on the other end finish.
+  void End();
+  // Closes both directions.
+  void Close();
+
+  void ContinueRead(MojoResult result);
+  void ContinueWrite(MojoResult result);
+
+  raw_ptr<v8::Isolate> isolate_;
+
+  mojo::ScopedDataPipeConsumerHandle consumer_;
+  mojo::SimpleWatcher read_watcher_;
+  v8::Global<v8::ArrayBufferView> read_buffer_;
+  gin_helper::Promise<int> read_promise_;
+
+  mojo::ScopedDataPipeProducerHandle producer_;
+  mojo::SimpleWatcher write_watcher_;
+  v8::Global<v8::ArrayBufferView> write_buffer_;
+  size_t write_offset_ = 0;
+  gin_helper::Promise<void> write_promise_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_COMMON_DATA_PIPE_STREAM_H_
@@ -0,0 +1,66 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/electron_histograms.h"
+
+#include <memory>
+#include <utility>
+
+#include "base/metrics/histogram_base.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/metrics/histogram_samples.h"
+#include "base/metrics/statistics_recorder.h"
+#include "base/strings/string_util.h"
+
+namespace electron::histograms {
+
+void RecordIpcDispatchTime(base::TimeDelta time) {
+  base::UmaHistogramMicrosecondsTimes("Electron.IPC.DispatchTime", time);
+}
+
+void RecordProtocolHandlerTime(base::TimeDelta time) {
+  base::UmaHistogramTimes("Electron.Protocol.HandlerTime", time);
+}
+
+void RecordAsarReadTime(base::TimeDelta time) {
+  base::UmaHistogramMicrosecondsTimes("Electron.Asar.ReadTime", time);
+}
+
+void RecordWindowCreationTime(base::TimeDelta time) {
+  base::UmaHistogramTimes("Electron.Window.CreationTime", time);
+}
+
+base::Value::List GetHistogramSnapshots() {
+  base::Value::List snapshots;
+  for (base::HistogramBase* histogram : base::StatisticsRecorder::Sort(
+           base::StatisticsRecorder::GetHistograms())) {
+    if (!base::StartsWith(histogram->histogram_name(), kPrefix))
+      continue;
+
+    std::unique_ptr<base::HistogramSamples> samples =
+        histogram->SnapshotSamples();
+    base::Value::List buckets;
+    for (auto it = samples->Iterator(); !it->Done(); it->Next()) {
+      base::HistogramBase::Sample min;
+      int64_t max;
+      base::HistogramBase::Count count;
+      it->Get(&min, &max, &count);
+      base::Value::Dict bucket;
+      bucket.Set("min", min);
+      bucket.Set("max", static_cast<double>(max));
+      bucket.Set("count", count);
+      buckets.Append(std::move(bucket));
+    }
+
+    base::Value::Dict snapshot;
+    snapshot.Set("name", histogram->histogram_name());
+    snapshot.Set("count", samples->TotalCount());
+    snapshot.Set("sum", static_cast<double>(samples->sum()));
+    snapshot.Set("buckets", std::move(buckets));
+    snapshots.Append(std::move(snapshot));
+  }
+  return snapshots;
+}
+
+}  // namespace electron::histograms
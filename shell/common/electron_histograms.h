@@ -0,0 +1,41 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_ELECTRON_HISTOGRAMS_H_
+#define ELECTRON_SHELL_COMMON_ELECTRON_HISTOGRAMS_H_
+
+#include "base/time/time.h"
+#include "base/values.h"
+
+// The histograms Electron records for its own code paths. They are regular
+// UMA-style histograms kept by base::StatisticsRecorder, so recording a
+// sample is cheap and needs no tracing, and they can be read back in the
+// process that recorded them with GetHistogramSnapshots().
+namespace electron::histograms {
+
+// All Electron histograms are named with this prefix.
+inline constexpr char kPrefix[] = "Electron.";
+
+// How long the main process took to deserialize an IPC message from a
+// renderer and run its listeners.
+void RecordIpcDispatchTime(base::TimeDelta time);
+
+// How long a protocol handler took to respond to a request.
+void RecordProtocolHandlerTime(base::TimeDelta time);
+
+// How long it took to serve a file from an asar archive to a URL loader.
+void RecordAsarReadTime(base::TimeDelta time);
+
+// How long the native side of a new BrowserWindow took to create.
+void RecordWindowCreationTime(base::TimeDelta time);
+
+// Returns the samples recorded so far in this process by the histograms
+// named with kPrefix, sorted by name. Each entry is a dictionary with the
+// "name", "count" and "sum" of the histogram, and its non-empty "buckets" as
+// dictionaries of "min" (inclusive), "max" (exclusive) and "count".
+base::Value::List GetHistogramSnapshots();
+
+}  // namespace electron::histograms
+
+#endif  // ELECTRON_SHELL_COMMON_ELECTRON_HISTOGRAMS_H_
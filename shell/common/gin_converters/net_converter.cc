@@ -159,20 +159,18 @@ v8::Local<v8::Value> Converter<net::CertPrincipal>::ToV8(
 v8::Local<v8::Value> Converter<net::HttpResponseHeaders*>::ToV8(
     v8::Isolate* isolate,
     net::HttpResponseHeaders* headers) {
-  base::Value::Dict response_headers;
+  // Built in place, as headers are converted for most responses and going
+  // through base::Value would copy each of them once more.
+  v8::Local<v8::Object> response_headers = v8::Object::New(isolate);
   if (headers) {
     size_t iter = 0;
     std::string key;
     std::string value;
-    while (headers->EnumerateHeaderLines(&iter, &key, &value)) {
-      key = base::ToLowerASCII(key);
-      base::Value::List* values = response_headers.FindList(key);
-      if (!values)
-        values = &response_headers.Set(key, base::Value::List())->GetList();
-      values->Append(value);
-    }
+    while (headers->EnumerateHeaderLines(&iter, &key, &value))
+      electron::AppendHeaderValue(isolate, response_headers,
+                                  base::ToLowerASCII(key), value);
   }
-  return ConvertToV8(isolate, response_headers);
+  return response_headers;
 }
 
 bool Converter<net::HttpResponseHeaders*>::FromV8(
@@ -240,14 +238,28 @@ v8::Local<v8::Value> Converter<net::HttpRequestHeaders>::ToV8(
 bool Converter<net::HttpRequestHeaders>::FromV8(v8::Isolate* isolate,
                                                 v8::Local<v8::Value> val,
                                                 net::HttpRequestHeaders* out) {
-  base::Value::Dict dict;
-  if (!ConvertFromV8(isolate, val, &dict))
+  if (!val->IsObject())
     return false;
-  for (const auto it : dict) {
-    if (it.second.is_string()) {
-      std::string value = it.second.GetString();
-      out->SetHeader(it.first, value);
-    }
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+  v8::Local<v8::Object> headers = val.As<v8::Object>();
+  v8::Local<v8::Array> keys;
+  if (!headers
+           ->GetOwnPropertyNames(context,
+                                 static_cast<v8::PropertyFilter>(
+                                     v8::ONLY_ENUMERABLE | v8::SKIP_SYMBOLS),
+                                 v8::KeyConversionMode::kConvertToString)
+           .ToLocal(&keys))
+    return false;
+  for (uint32_t i = 0; i < keys->Length(); ++i) {
+    v8::Local<v8::Value> key;
+    v8::Local<v8::Value> value;
+    if (!keys->Get(context, i).ToLocal(&key) ||
+        !headers->Get(context, key).ToLocal(&value))
+      return false;
+    // Values that aren't strings are skipped, as they always have been.
+    if (!value->IsString())
+      continue;
+    out->SetHeader(V8ToString(isolate, key), V8ToString(isolate, value));
   }
   return true;
 }
@@ -765,3 +777,28 @@ bool Converter<network::mojom::ResolveHostParametersPtr>::FromV8(
 }
 
 }  // namespace gin
+
+namespace electron {
+
+void AppendHeaderValue(v8::Isolate* isolate,
+                       v8::Local<v8::Object> headers,
+                       std::string_view key,
+                       std::string_view value) {
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+  v8::Local<v8::String> name = gin::StringToV8(isolate, key);
+  v8::Local<v8::Value> existing;
+  v8::Local<v8::Array> values;
+  if (headers->HasOwnProperty(context, name).FromMaybe(false) &&
+      headers->Get(context, name).ToLocal(&existing) && existing->IsArray()) {
+    values = existing.As<v8::Array>();
+  } else {
+    values = v8::Array::New(isolate);
+    headers->CreateDataProperty(context, name, values).Check();
+  }
+  values
+      ->CreateDataProperty(context, values->Length(),
+                           gin::StringToV8(isolate, value))
+      .Check();
+}
+
+}  // namespace electron
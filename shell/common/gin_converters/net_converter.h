@@ -5,6 +5,7 @@
 #ifndef ELECTRON_SHELL_COMMON_GIN_CONVERTERS_NET_CONVERTER_H_
 #define ELECTRON_SHELL_COMMON_GIN_CONVERTERS_NET_CONVERTER_H_
 
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -181,4 +182,15 @@ struct Converter<std::vector<std::pair<K, V>>> {
 
 }  // namespace gin
 
+namespace electron {
+
+// Appends |value| to the array of |key| in |headers|, which is created with
+// the first value of the header.
+void AppendHeaderValue(v8::Isolate* isolate,
+                       v8::Local<v8::Object> headers,
+                       std::string_view key,
+                       std::string_view value);
+
+}  // namespace electron
+
 #endif  // ELECTRON_SHELL_COMMON_GIN_CONVERTERS_NET_CONVERTER_H_
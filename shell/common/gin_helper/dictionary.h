@@ -6,6 +6,7 @@
 #define ELECTRON_SHELL_COMMON_GIN_HELPER_DICTIONARY_H_
 
 #include <optional>
+#include <string>
 #include <string_view>
 #include <type_traits>
 #include <utility>
@@ -56,14 +57,20 @@ class Dictionary : public gin::Dictionary {
 
   // Differences from the Set method in gin::Dictionary:
   // 1. It accepts arbitrary type of key.
+  // 2. String keys are created internalized, as V8 would internalize them
+  //    anyway when adding the property.
   template <typename K, typename V>
   bool Set(const K& key, const V& val) {
     v8::Local<v8::Value> v8_value;
     if (!gin::TryConvertToV8(isolate(), val, &v8_value))
       return false;
+    v8::Local<v8::Value> v8_key;
+    if constexpr (std::is_convertible_v<const K&, std::string_view>)
+      v8_key = gin::StringToSymbol(isolate(), key);
+    else
+      v8_key = gin::ConvertToV8(isolate(), key);
     v8::Maybe<bool> result =
-        GetHandle()->Set(isolate()->GetCurrentContext(),
-                         gin::ConvertToV8(isolate(), key), v8_value);
+        GetHandle()->Set(isolate()->GetCurrentContext(), v8_key, v8_value);
     return !result.IsNothing() && result.FromJust();
   }
 
@@ -108,7 +115,8 @@ class Dictionary : public gin::Dictionary {
   template <typename T>
   bool SetMethod(std::string_view key, const T& callback) {
     auto context = isolate()->GetCurrentContext();
-    auto templ = CallbackTraits<T>::CreateTemplate(isolate(), callback);
+    auto templ = CallbackTraits<T>::CreateTemplate(isolate(), callback,
+                                                   {.name = std::string(key)});
     return GetHandle()
         ->Set(context, gin::StringToV8(isolate(), key),
               templ->GetFunction(context).ToLocalChecked())
@@ -4,22 +4,26 @@
 
 #include "shell/common/gin_helper/event_emitter_caller.h"
 
+#include <optional>
+
 #include "shell/common/gin_helper/microtasks_scope.h"
 #include "shell/common/node_includes.h"
 
 namespace gin_helper::internal {
 
-v8::Local<v8::Value> CallMethodWithArgs(v8::Isolate* isolate,
-                                        v8::Local<v8::Object> obj,
-                                        const char* method,
-                                        ValueVector* args) {
-  // Only set up the node::CallbackScope if there's a node environment.
-  std::unique_ptr<node::CallbackScope> callback_scope;
-  if (node::Environment::GetCurrent(isolate)) {
-    v8::HandleScope handle_scope(isolate);
-    callback_scope = std::make_unique<node::CallbackScope>(
-        isolate, v8::Object::New(isolate), node::async_context{0, 0});
-  }
+namespace {
+
+template <typename Callee>
+v8::Local<v8::Value> MakeCallbackWithArgs(v8::Isolate* isolate,
+                                          v8::Local<v8::Object> obj,
+                                          Callee callee,
+                                          ValueVector* args) {
+  // Only set up the node::CallbackScope if there's a node environment. The
+  // receiver doubles as the async resource, as node::MakeCallback does, rather
+  // than allocating a new object for every event.
+  std::optional<node::CallbackScope> callback_scope;
+  if (node::Environment::GetCurrent(isolate))
+    callback_scope.emplace(isolate, obj, node::async_context{0, 0});
 
   // Perform microtask checkpoint after running JavaScript.
   gin_helper::MicrotasksScope microtasks_scope(
@@ -27,7 +31,7 @@ v8::Local<v8::Value> CallMethodWithArgs(v8::Isolate* isolate,
   // Use node::MakeCallback to call the callback, and it will also run pending
   // tasks in Node.js.
   v8::MaybeLocal<v8::Value> ret = node::MakeCallback(
-      isolate, obj, method, args->size(), args->data(), {0, 0});
+      isolate, obj, callee, args->size(), args->data(), {0, 0});
   // If the JS function throws an exception (doesn't return a value) the result
   // of MakeCallback will be empty and therefore ToLocal will be false, in this
   // case we need to return "false" as that indicates that the event emitter did
@@ -39,4 +43,20 @@ v8::Local<v8::Value> CallMethodWithArgs(v8::Isolate* isolate,
   return v8::Boolean::New(isolate, false);
 }
 
+}  // namespace
+
+v8::Local<v8::Value> CallMethodWithArgs(v8::Isolate* isolate,
+                                        v8::Local<v8::Object> obj,
+                                        const char* method,
+                                        ValueVector* args) {
+  return MakeCallbackWithArgs(isolate, obj, method, args);
+}
+
+v8::Local<v8::Value> CallFunctionWithArgs(v8::Isolate* isolate,
+                                          v8::Local<v8::Object> recv,
+                                          v8::Local<v8::Function> function,
+                                          ValueVector* args) {
+  return MakeCallbackWithArgs(isolate, recv, function, args);
+}
+
 }  // namespace gin_helper::internal
@@ -5,6 +5,7 @@
 #ifndef ELECTRON_SHELL_COMMON_GIN_HELPER_EVENT_EMITTER_CALLER_H_
 #define ELECTRON_SHELL_COMMON_GIN_HELPER_EVENT_EMITTER_CALLER_H_
 
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -22,6 +23,22 @@ v8::Local<v8::Value> CallMethodWithArgs(v8::Isolate* isolate,
                                         const char* method,
                                         ValueVector* args);
 
+v8::Local<v8::Value> CallFunctionWithArgs(v8::Isolate* isolate,
+                                          v8::Local<v8::Object> recv,
+                                          v8::Local<v8::Function> function,
+                                          ValueVector* args);
+
+inline v8::Local<v8::String> EventNameToV8(v8::Isolate* isolate,
+                                           std::string_view name) {
+  return gin::StringToV8(isolate, name);
+}
+
+// Lets callers pass event names they have already converted, e.g. cached ones.
+inline v8::Local<v8::String> EventNameToV8(v8::Isolate* isolate,
+                                           v8::Local<v8::String> name) {
+  return name;
+}
+
 }  // namespace internal
 
 // obj.emit.apply(obj, name, args...);
@@ -31,8 +48,9 @@ v8::Local<v8::Value> EmitEvent(v8::Isolate* isolate,
                                v8::Local<v8::Object> obj,
                                const StringType& name,
                                const internal::ValueVector& args) {
-  internal::ValueVector concatenated_args = {gin::StringToV8(isolate, name)};
+  internal::ValueVector concatenated_args;
   concatenated_args.reserve(1 + args.size());
+  concatenated_args.push_back(internal::EventNameToV8(isolate, name));
   concatenated_args.insert(concatenated_args.end(), args.begin(), args.end());
   return internal::CallMethodWithArgs(isolate, obj, "emit", &concatenated_args);
 }
@@ -45,7 +63,7 @@ v8::Local<v8::Value> EmitEvent(v8::Isolate* isolate,
                                const StringType& name,
                                Args&&... args) {
   internal::ValueVector converted_args = {
-      gin::StringToV8(isolate, name),
+      internal::EventNameToV8(isolate, name),
       gin::ConvertToV8(isolate, std::forward<Args>(args))...,
   };
   return internal::CallMethodWithArgs(isolate, obj, "emit", &converted_args);
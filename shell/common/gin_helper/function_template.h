@@ -5,18 +5,23 @@
 #ifndef ELECTRON_SHELL_COMMON_GIN_HELPER_FUNCTION_TEMPLATE_H_
 #define ELECTRON_SHELL_COMMON_GIN_HELPER_FUNCTION_TEMPLATE_H_
 
+#include <cstdint>
 #include <optional>
+#include <string>
+#include <type_traits>
 #include <utility>
 
 #include "base/functional/bind.h"
 #include "base/functional/callback.h"
 #include "base/memory/raw_ptr.h"
+#include "base/trace_event/trace_event.h"
 #include "gin/arguments.h"
 #include "gin/per_isolate_data.h"
 #include "shell/common/gin_helper/arguments.h"
 #include "shell/common/gin_helper/destroyable.h"
 #include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/microtasks_scope.h"
+#include "v8/include/v8-fast-api-calls.h"
 
 // This file is forked from gin/function_template.h with 2 differences:
 // 1. Support for additional types of arguments.
@@ -29,6 +34,11 @@ namespace gin_helper {
 struct InvokerOptions {
   bool holder_is_first_argument = false;
   const char* holder_type = nullptr;  // Null if unknown or not applicable.
+  // Used by optimized code instead of the callback when set, see FastMethod.
+  const v8::CFunction* c_function = nullptr;
+  // The name the function is exposed to JS as, recorded in the trace event of
+  // each call. Empty if unknown.
+  std::string name;
 };
 
 template <typename T>
@@ -305,6 +315,9 @@ struct Dispatcher<ReturnType(ArgTypes...)> {
     typedef CallbackHolder<ReturnType(ArgTypes...)> HolderT;
     HolderT* holder = static_cast<HolderT*>(holder_base);
 
+    TRACE_EVENT1("electron", "gin_helper::Dispatch", "method",
+                 holder->invoker_options.name);
+
     using Indices = std::index_sequence_for<ArgTypes...>;
     Invoker<Indices, ArgTypes...> invoker(args, holder->invoker_options);
     if (invoker.IsOK())
@@ -350,6 +363,7 @@ v8::Local<v8::FunctionTemplate> CreateFunctionTemplate(
     base::RepeatingCallback<Sig> callback,
     InvokerOptions invoker_options = {}) {
   typedef CallbackHolder<Sig> HolderT;
+  const v8::CFunction* c_function = invoker_options.c_function;
   HolderT* holder =
       new HolderT(isolate, std::move(callback), std::move(invoker_options));
 
@@ -357,7 +371,8 @@ v8::Local<v8::FunctionTemplate> CreateFunctionTemplate(
       isolate, &Dispatcher<Sig>::DispatchToCallback,
       gin::ConvertToV8<v8::Local<v8::External>>(isolate,
                                                 holder->GetHandle(isolate)),
-      v8::Local<v8::Signature>(), 0, v8::ConstructorBehavior::kAllow);
+      v8::Local<v8::Signature>(), 0, v8::ConstructorBehavior::kAllow,
+      v8::SideEffectType::kHasSideEffect, c_function);
   return tmpl;
 }
 
@@ -386,10 +401,12 @@ CreateDataPropertyCallback(v8::Isolate* isolate,
 // because of base::Bind().
 template <typename T, typename Enable = void>
 struct CallbackTraits {
-  static v8::Local<v8::FunctionTemplate> CreateTemplate(v8::Isolate* isolate,
-                                                        T callback) {
-    return gin_helper::CreateFunctionTemplate(isolate,
-                                              base::BindRepeating(callback));
+  static v8::Local<v8::FunctionTemplate> CreateTemplate(
+      v8::Isolate* isolate,
+      T callback,
+      InvokerOptions invoker_options = {}) {
+    return gin_helper::CreateFunctionTemplate(
+        isolate, base::BindRepeating(callback), std::move(invoker_options));
   }
 };
 
@@ -398,8 +415,10 @@ template <typename T>
 struct CallbackTraits<base::RepeatingCallback<T>> {
   static v8::Local<v8::FunctionTemplate> CreateTemplate(
       v8::Isolate* isolate,
-      const base::RepeatingCallback<T>& callback) {
-    return gin_helper::CreateFunctionTemplate(isolate, callback);
+      const base::RepeatingCallback<T>& callback,
+      InvokerOptions invoker_options = {}) {
+    return gin_helper::CreateFunctionTemplate(isolate, callback,
+                                              std::move(invoker_options));
   }
 };
 
@@ -411,14 +430,48 @@ template <typename T>
 struct CallbackTraits<
     T,
     typename std::enable_if<std::is_member_function_pointer<T>::value>::type> {
-  static v8::Local<v8::FunctionTemplate> CreateTemplate(v8::Isolate* isolate,
-                                                        T callback) {
-    InvokerOptions invoker_options = {.holder_is_first_argument = true};
+  static v8::Local<v8::FunctionTemplate> CreateTemplate(
+      v8::Isolate* isolate,
+      T callback,
+      InvokerOptions invoker_options = {}) {
+    invoker_options.holder_is_first_argument = true;
     return gin_helper::CreateFunctionTemplate(
         isolate, base::BindRepeating(callback), std::move(invoker_options));
   }
 };
 
+// FastMethod provides the V8 fast-call version of a const member function that
+// takes no arguments, which TurboFan calls directly from optimized code
+// without going through gin::Arguments. As fast calls can neither allocate on
+// the V8 heap nor run JavaScript, only methods that return a primitive are
+// supported, and calls on destroyed objects fall back to the regular callback
+// so it can throw.
+template <auto method>
+struct FastMethod;
+
+template <typename T, typename R, R (T::*method)() const>
+struct FastMethod<method> {
+  static_assert(std::is_same_v<R, bool> || std::is_same_v<R, int32_t> ||
+                    std::is_same_v<R, uint32_t> || std::is_same_v<R, double>,
+                "Fast calls can only return bool, int32_t, uint32_t or double");
+
+  static R Call(v8::Local<v8::Object> receiver,
+                v8::FastApiCallbackOptions& options) {
+    T* object = nullptr;
+    if (gin_helper::Destroyable::IsDestroyed(receiver) ||
+        !gin::ConvertFromV8(v8::Isolate::GetCurrent(), receiver, &object)) {
+      options.fallback = true;
+      return R();
+    }
+    return (object->*method)();
+  }
+
+  static const v8::CFunction* Get() {
+    static const v8::CFunction c_function = v8::CFunction::Make(Call);
+    return &c_function;
+  }
+};
+
 }  // namespace gin_helper
 
 #endif  // ELECTRON_SHELL_COMMON_GIN_HELPER_FUNCTION_TEMPLATE_H_
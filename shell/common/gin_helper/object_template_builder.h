@@ -5,7 +5,9 @@
 #ifndef ELECTRON_SHELL_COMMON_GIN_HELPER_OBJECT_TEMPLATE_BUILDER_H_
 #define ELECTRON_SHELL_COMMON_GIN_HELPER_OBJECT_TEMPLATE_BUILDER_H_
 
+#include <string>
 #include <string_view>
+#include <utility>
 
 #include "base/memory/raw_ptr.h"
 #include "shell/common/gin_helper/function_template.h"
@@ -41,22 +43,41 @@ class ObjectTemplateBuilder {
   template <typename T>
   ObjectTemplateBuilder& SetMethod(const std::string_view name,
                                    const T& callback) {
-    return SetImpl(name, CallbackTraits<T>::CreateTemplate(isolate_, callback));
+    return SetImpl(name, CallbackTraits<T>::CreateTemplate(
+                             isolate_, callback, {.name = std::string(name)}));
+  }
+  // Like SetMethod() for a const member function without arguments, which is
+  // also given a fast-call path for optimized code, see FastMethod.
+  template <auto method>
+  ObjectTemplateBuilder& SetFastMethod(const std::string_view name) {
+    InvokerOptions invoker_options = {
+        .holder_is_first_argument = true,
+        .c_function = FastMethod<method>::Get(),
+        .name = std::string(name),
+    };
+    return SetImpl(name, CreateFunctionTemplate(isolate_,
+                                                base::BindRepeating(method),
+                                                std::move(invoker_options)));
   }
   template <typename T>
   ObjectTemplateBuilder& SetProperty(const std::string_view name,
                                      const T& getter) {
-    return SetPropertyImpl(name,
-                           CallbackTraits<T>::CreateTemplate(isolate_, getter),
-                           v8::Local<v8::FunctionTemplate>());
+    return SetPropertyImpl(
+        name,
+        CallbackTraits<T>::CreateTemplate(isolate_, getter,
+                                          {.name = std::string(name)}),
+        v8::Local<v8::FunctionTemplate>());
   }
   template <typename T, typename U>
   ObjectTemplateBuilder& SetProperty(const std::string_view name,
                                      const T& getter,
                                      const U& setter) {
-    return SetPropertyImpl(name,
-                           CallbackTraits<T>::CreateTemplate(isolate_, getter),
-                           CallbackTraits<U>::CreateTemplate(isolate_, setter));
+    return SetPropertyImpl(
+        name,
+        CallbackTraits<T>::CreateTemplate(isolate_, getter,
+                                          {.name = std::string(name)}),
+        CallbackTraits<U>::CreateTemplate(isolate_, setter,
+                                          {.name = std::string(name)}));
   }
 
   v8::Local<v8::ObjectTemplate> Build();
@@ -7,11 +7,11 @@
 
 #include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/functional/bind.h"
 #include "base/memory/weak_ptr.h"
 #include "shell/common/gin_helper/cleaned_up_at_exit.h"
 #include "shell/common/gin_helper/event_emitter.h"
-#include "shell/common/key_weak_map.h"
 
 namespace base {
 class SupportsUserData;
@@ -51,8 +51,13 @@ class TrackableObjectBase : public CleanedUpAtExit {
   base::WeakPtrFactory<TrackableObjectBase> weak_factory_{this};
 };
 
-// All instances of TrackableObject will be kept in a weak map and can be got
-// from its ID.
+// All instances of TrackableObject will be kept in a registry and can be got
+// from their ID.
+//
+// The registry holds plain pointers instead of weak handles to the wrappers,
+// so tracking an object adds no work for the GC: the wrapper's own weak
+// callback deletes the native object, whose destructor unregisters it. IDs are
+// never reused, so a stale ID can not find a newer object.
 template <typename T>
 class TrackableObject : public TrackableObjectBase, public EventEmitter<T> {
  public:
@@ -73,18 +78,21 @@ class TrackableObject : public TrackableObjectBase, public EventEmitter<T> {
            wrapper->GetAlignedPointerFromInternalField(0) == nullptr;
   }
 
-  // Finds out the TrackableObject from its ID in weak map.
+  // Finds out the TrackableObject from its ID in the registry. Objects whose
+  // wrapper has been collected or marked as destroyed are not returned.
   static T* FromWeakMapID(v8::Isolate* isolate, int32_t id) {
-    if (!weak_map_)
+    if (!registry_)
       return nullptr;
 
-    v8::HandleScope scope(isolate);
-    v8::MaybeLocal<v8::Object> object = weak_map_->Get(isolate, id);
-    if (object.IsEmpty())
+    auto iter = registry_->find(id);
+    if (iter == registry_->end())
       return nullptr;
 
-    T* self = nullptr;
-    gin::ConvertFromV8(isolate, object.ToLocalChecked(), &self);
+    v8::HandleScope scope(isolate);
+    T* self = iter->second;
+    v8::Local<v8::Object> wrapper = self->GetWrapper();
+    if (wrapper.IsEmpty() || self->IsDestroyed())
+      return nullptr;
     return self;
   }
 
@@ -97,18 +105,26 @@ class TrackableObject : public TrackableObjectBase, public EventEmitter<T> {
     return FromWeakMapID(isolate, id);
   }
 
-  // Returns all objects in this class's weak map.
+  // Returns the wrappers of all objects in this class's registry, in the
+  // order they were created.
   static std::vector<v8::Local<v8::Object>> GetAll(v8::Isolate* isolate) {
-    if (weak_map_)
-      return weak_map_->Values(isolate);
-    else
-      return std::vector<v8::Local<v8::Object>>();
+    std::vector<v8::Local<v8::Object>> objects;
+    if (!registry_)
+      return objects;
+
+    objects.reserve(registry_->size());
+    for (const auto& [id, self] : *registry_) {
+      v8::Local<v8::Object> wrapper = self->GetWrapper();
+      if (!wrapper.IsEmpty())
+        objects.push_back(wrapper);
+    }
+    return objects;
   }
 
-  // Removes this instance from the weak map.
+  // Removes this instance from the registry.
   void RemoveFromWeakMap() {
-    if (weak_map_)
-      weak_map_->Remove(weak_map_id());
+    if (registry_)
+      registry_->erase(weak_map_id());
   }
 
  protected:
@@ -117,23 +133,26 @@ class TrackableObject : public TrackableObjectBase, public EventEmitter<T> {
   ~TrackableObject() override { RemoveFromWeakMap(); }
 
   void InitWith(v8::Isolate* isolate, v8::Local<v8::Object> wrapper) override {
-    if (!weak_map_) {
-      weak_map_ = new electron::KeyWeakMap<int32_t>;
-    }
-    weak_map_->Set(isolate, weak_map_id_, wrapper);
+    if (!registry_)
+      registry_ = new Registry;
+    // IDs only grow, so new objects are always appended to the end.
+    registry_->emplace_hint(registry_->end(), weak_map_id_,
+                            static_cast<T*>(this));
     gin_helper::WrappableBase::InitWith(isolate, wrapper);
   }
 
  private:
+  using Registry = base::flat_map<int32_t, T*>;
+
   static int32_t next_id_;
-  static electron::KeyWeakMap<int32_t>* weak_map_;  // leaked on purpose
+  static Registry* registry_;  // leaked on purpose
 };
 
 template <typename T>
 int32_t TrackableObject<T>::next_id_ = 0;
 
 template <typename T>
-electron::KeyWeakMap<int32_t>* TrackableObject<T>::weak_map_ = nullptr;
+typename TrackableObject<T>::Registry* TrackableObject<T>::registry_ = nullptr;
 
 }  // namespace gin_helper
 
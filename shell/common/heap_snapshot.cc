@@ -4,18 +4,33 @@
 
 #include "shell/common/heap_snapshot.h"
 
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "base/containers/circular_deque.h"
 #include "base/files/file.h"
-#include "base/memory/raw_ptr.h"
+#include "base/functional/bind.h"
+#include "base/functional/callback.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/task/sequenced_task_runner.h"
+#include "gin/converter.h"
+#include "mojo/public/cpp/system/simple_watcher.h"
+#include "mojo/public/cpp/system/wait.h"
+#include "shell/common/thread_restrictions.h"
 #include "v8/include/v8-profiler.h"
 #include "v8/include/v8.h"
 
 namespace {
 
+using ChunkWriter = base::RepeatingCallback<bool(std::string_view chunk)>;
+
 class HeapSnapshotOutputStream : public v8::OutputStream {
  public:
-  explicit HeapSnapshotOutputStream(base::File* file) : file_(file) {
-    DCHECK(file_);
-  }
+  explicit HeapSnapshotOutputStream(ChunkWriter writer)
+      : writer_(std::move(writer)) {}
 
   bool IsComplete() const { return is_complete_; }
 
@@ -24,36 +39,245 @@ class HeapSnapshotOutputStream : public v8::OutputStream {
   void EndOfStream() override { is_complete_ = true; }
 
   v8::OutputStream::WriteResult WriteAsciiChunk(char* data, int size) override {
-    auto bytes_written = file_->WriteAtCurrentPos(data, size);
-    return bytes_written == size ? kContinue : kAbort;
+    return writer_.Run(std::string_view(data, size)) ? kContinue : kAbort;
   }
 
  private:
-  raw_ptr<base::File> file_ = nullptr;
+  ChunkWriter writer_;
   bool is_complete_ = false;
 };
 
+bool SerializeHeapSnapshot(v8::Isolate* isolate, ChunkWriter writer) {
+  DCHECK(isolate);
+
+  auto* snapshot = isolate->GetHeapProfiler()->TakeHeapSnapshot();
+  if (!snapshot)
+    return false;
+
+  HeapSnapshotOutputStream stream(std::move(writer));
+  snapshot->Serialize(&stream, v8::HeapSnapshot::kJSON);
+
+  const_cast<v8::HeapSnapshot*>(snapshot)->Delete();
+
+  return stream.IsComplete();
+}
+
+// Writes the chunks of a snapshot to a data pipe. The chunks that don't fit
+// while the snapshot is serialized are kept and written once the pipe has
+// room again, so that a slow reader doesn't block the thread of the isolate.
+// Once kMaxPendingSize bytes are kept, serializing waits for the reader to
+// catch up instead, so that a reader that doesn't keep up doesn't make the
+// whole snapshot be held in memory.
+// Manages its own lifetime, being deleted once everything has been written.
+class PipeSnapshotWriter {
+ public:
+  static constexpr size_t kMaxPendingSize = 16 * 1024 * 1024;
+
+  PipeSnapshotWriter(mojo::ScopedDataPipeProducerHandle pipe,
+                     base::OnceCallback<void(bool)> callback)
+      : pipe_(std::move(pipe)),
+        watcher_(FROM_HERE,
+                 mojo::SimpleWatcher::ArmingPolicy::MANUAL,
+                 base::SequencedTaskRunner::GetCurrentDefault()),
+        callback_(std::move(callback)) {
+    watcher_.Watch(pipe_.get(),
+                   MOJO_HANDLE_SIGNAL_WRITABLE | MOJO_HANDLE_SIGNAL_PEER_CLOSED,
+                   base::BindRepeating(&PipeSnapshotWriter::OnPipeReady,
+                                       base::Unretained(this)));
+  }
+
+  // disable copy
+  PipeSnapshotWriter(const PipeSnapshotWriter&) = delete;
+  PipeSnapshotWriter& operator=(const PipeSnapshotWriter&) = delete;
+
+  // Called for each chunk while the snapshot is serialized.
+  bool Write(std::string_view chunk) {
+    if (!WritePending())
+      return false;
+    if (pending_.empty() && !WriteToPipe(&chunk))
+      return false;
+    if (!chunk.empty()) {
+      pending_.emplace_back(chunk);
+      pending_size_ += chunk.size();
+    }
+    while (pending_size_ > kMaxPendingSize) {
+      if (!WaitForPipe() || !WritePending())
+        return false;
+    }
+    return true;
+  }
+
+  // Called once the snapshot has been serialized, with whether all of it was.
+  void Finish(bool success) {
+    if (success)
+      Continue();
+    else
+      Done(false);
+  }
+
+ private:
+  ~PipeSnapshotWriter() = default;
+
+  // Writes as much of |chunk| as the pipe takes, removing it from |chunk|.
+  // Returns false if the reading end is gone.
+  bool WriteToPipe(std::string_view* chunk) {
+    while (!chunk->empty()) {
+      uint32_t num_bytes = base::checked_cast<uint32_t>(chunk->size());
+      MojoResult result = pipe_->WriteData(chunk->data(), &num_bytes,
+                                           MOJO_WRITE_DATA_FLAG_NONE);
+      if (result == MOJO_RESULT_SHOULD_WAIT)
+        return true;
+      if (result != MOJO_RESULT_OK)
+        return false;
+      chunk->remove_prefix(num_bytes);
+    }
+    return true;
+  }
+
+  // Writes the kept chunks until the pipe is full. Returns false if the
+  // reading end is gone.
+  bool WritePending() {
+    while (!pending_.empty()) {
+      std::string_view chunk(pending_.front());
+      chunk.remove_prefix(pending_offset_);
+      const size_t size = chunk.size();
+      if (!WriteToPipe(&chunk))
+        return false;
+      pending_size_ -= size - chunk.size();
+      if (!chunk.empty()) {
+        pending_offset_ += size - chunk.size();
+        return true;
+      }
+      pending_.pop_front();
+      pending_offset_ = 0;
+    }
+    return true;
+  }
+
+  // Blocks until the pipe has room. Returns false if the reading end is gone.
+  bool WaitForPipe() {
+    electron::ScopedAllowBlockingForElectron allow_blocking;
+    return mojo::Wait(pipe_.get(), MOJO_HANDLE_SIGNAL_WRITABLE) ==
+           MOJO_RESULT_OK;
+  }
+
+  void Continue() {
+    if (!WritePending())
+      Done(false);
+    else if (pending_.empty())
+      Done(true);
+    else
+      watcher_.ArmOrNotify();
+  }
+
+  void OnPipeReady(MojoResult result) {
+    if (result == MOJO_RESULT_OK)
+      Continue();
+    else
+      Done(false);
+  }
+
+  void Done(bool success) {
+    watcher_.Cancel();
+    // Closing the pipe lets the reader know the snapshot is complete.
+    pipe_.reset();
+    std::move(callback_).Run(success);
+    delete this;
+  }
+
+  mojo::ScopedDataPipeProducerHandle pipe_;
+  mojo::SimpleWatcher watcher_;
+  base::OnceCallback<void(bool)> callback_;
+
+  base::circular_deque<std::string> pending_;
+  // How much of the first pending chunk has been written.
+  size_t pending_offset_ = 0;
+  // The bytes of |pending_| that are still to be written.
+  size_t pending_size_ = 0;
+};
+
+base::Value::Dict ConvertAllocationNode(
+    v8::Isolate* isolate,
+    const v8::AllocationProfile::Node* node) {
+  // DevTools counts lines and columns from zero where V8 counts from one,
+  // with zero meaning that there is no information.
+  base::Value::Dict call_frame;
+  call_frame.Set("functionName", gin::V8ToString(isolate, node->name));
+  call_frame.Set("scriptId", base::NumberToString(node->script_id));
+  call_frame.Set("url", gin::V8ToString(isolate, node->script_name));
+  call_frame.Set("lineNumber", node->line_number - 1);
+  call_frame.Set("columnNumber", node->column_number - 1);
+
+  double self_size = 0;
+  for (const auto& allocation : node->allocations)
+    self_size += static_cast<double>(allocation.size) * allocation.count;
+
+  base::Value::List children;
+  for (const auto* child : node->children)
+    children.Append(ConvertAllocationNode(isolate, child));
+
+  base::Value::Dict result;
+  result.Set("callFrame", std::move(call_frame));
+  result.Set("selfSize", self_size);
+  result.Set("id", static_cast<double>(node->node_id));
+  result.Set("children", std::move(children));
+  return result;
+}
+
 }  // namespace
 
 namespace electron {
 
 bool TakeHeapSnapshot(v8::Isolate* isolate, base::File* file) {
-  DCHECK(isolate);
   DCHECK(file);
 
   if (!file->IsValid())
     return false;
 
-  auto* snapshot = isolate->GetHeapProfiler()->TakeHeapSnapshot();
-  if (!snapshot)
-    return false;
+  return SerializeHeapSnapshot(
+      isolate, base::BindRepeating(
+                   [](base::File* file, std::string_view chunk) {
+                     return file->WriteAtCurrentPos(chunk.data(),
+                                                    chunk.size()) ==
+                            static_cast<int>(chunk.size());
+                   },
+                   base::Unretained(file)));
+}
 
-  HeapSnapshotOutputStream stream(file);
-  snapshot->Serialize(&stream, v8::HeapSnapshot::kJSON);
+void TakeHeapSnapshot(v8::Isolate* isolate,
+                      mojo::ScopedDataPipeProducerHandle pipe,
+                      base::OnceCallback<void(bool)> callback) {
+  if (!pipe.is_valid()) {
+    std::move(callback).Run(false);
+    return;
+  }
 
-  const_cast<v8::HeapSnapshot*>(snapshot)->Delete();
+  auto* writer = new PipeSnapshotWriter(std::move(pipe), std::move(callback));
+  writer->Finish(SerializeHeapSnapshot(
+      isolate, base::BindRepeating(&PipeSnapshotWriter::Write,
+                                   base::Unretained(writer))));
+}
 
-  return stream.IsComplete();
+std::optional<base::Value::Dict> GetSamplingHeapProfile(v8::Isolate* isolate) {
+  v8::HandleScope handle_scope(isolate);
+  std::unique_ptr<v8::AllocationProfile> profile(
+      isolate->GetHeapProfiler()->GetAllocationProfile());
+  if (!profile)
+    return std::nullopt;
+
+  base::Value::List samples;
+  for (const auto& sample : profile->GetSamples()) {
+    base::Value::Dict item;
+    item.Set("size", static_cast<double>(sample.size) * sample.count);
+    item.Set("nodeId", static_cast<double>(sample.node_id));
+    item.Set("ordinal", static_cast<double>(sample.sample_id));
+    samples.Append(std::move(item));
+  }
+
+  base::Value::Dict result;
+  result.Set("head", ConvertAllocationNode(isolate, profile->GetRootNode()));
+  result.Set("samples", std::move(samples));
+  return result;
 }
 
 }  // namespace electron
@@ -5,6 +5,12 @@
 #ifndef ELECTRON_SHELL_COMMON_HEAP_SNAPSHOT_H_
 #define ELECTRON_SHELL_COMMON_HEAP_SNAPSHOT_H_
 
+#include <optional>
+
+#include "base/functional/callback_forward.h"
+#include "base/values.h"
+#include "mojo/public/cpp/system/data_pipe.h"
+
 namespace base {
 class File;
 }
@@ -17,6 +23,20 @@ namespace electron {
 
 bool TakeHeapSnapshot(v8::Isolate* isolate, base::File* file);
 
+// Writes the snapshot to |pipe| chunk by chunk as it is serialized. The chunks
+// that don't fit are kept and written as the reader makes room, up to a
+// limit past which serializing blocks until the reader catches up. Then |pipe|
+// is closed and |callback| is run with whether all of it was written. Fails
+// if the reading end is closed before the snapshot has been written.
+void TakeHeapSnapshot(v8::Isolate* isolate,
+                      mojo::ScopedDataPipeProducerHandle pipe,
+                      base::OnceCallback<void(bool)> callback);
+
+// Returns the allocations sampled by the isolate's sampling heap profiler
+// in the format of DevTools' .heapprofile files, or nullopt if the profiler
+// isn't running.
+std::optional<base::Value::Dict> GetSamplingHeapProfile(v8::Isolate* isolate);
+
 }  // namespace electron
 
 #endif  // ELECTRON_SHELL_COMMON_HEAP_SNAPSHOT_H_
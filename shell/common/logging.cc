@@ -16,12 +16,14 @@
 #include "base/strings/string_number_conversions.h"
 #include "chrome/common/chrome_paths.h"
 #include "content/public/common/content_switches.h"
+#include "shell/common/async_log_sink.h"
 #include "shell/common/electron_paths.h"
 
 namespace logging {
 
 constexpr std::string_view kLogFileName{"ELECTRON_LOG_FILE"};
 constexpr std::string_view kElectronEnableLogging{"ELECTRON_ENABLE_LOGGING"};
+constexpr std::string_view kElectronLogAsync{"ELECTRON_LOG_ASYNC"};
 
 base::FilePath GetLogFileName(const base::CommandLine& command_line) {
   std::string filename = command_line.GetSwitchValueASCII(switches::kLogFile);
@@ -140,6 +142,16 @@ void InitElectronLogging(const base::CommandLine& command_line,
       process_type.empty() && (is_preinit || !HasExplicitLogFile(command_line))
           ? DELETE_OLD_LOG_FILE
           : APPEND_TO_OLD_LOG_FILE;
+
+  // The browser process can write its file from a background sequence once
+  // the thread pool exists. Child processes may be sandboxed, so they leave
+  // the file to Chromium, which opens it before the sandbox is engaged.
+  if ((logging_dest & LOG_TO_FILE) != 0 && process_type.empty() &&
+      !is_preinit && base::Environment::Create()->HasVar(kElectronLogAsync)) {
+    settings.logging_dest &= ~LOG_TO_FILE;
+    settings.lock_log = DONT_LOCK_LOG_FILE;
+    InitAsyncLogSink(log_path, settings.delete_old == DELETE_OLD_LOG_FILE);
+  }
   bool success = InitLogging(settings);
   if (!success) {
     PLOG(ERROR) << "Failed to init logging";
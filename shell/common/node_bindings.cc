@@ -10,6 +10,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/auto_reset.h"
 #include "base/base_paths.h"
 #include "base/command_line.h"
 #include "base/containers/fixed_flat_set.h"
@@ -19,6 +20,7 @@
 #include "base/strings/string_split.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/single_thread_task_runner.h"
+#include "base/time/time.h"
 #include "base/trace_event/trace_event.h"
 #include "chrome/common/chrome_version.h"
 #include "content/public/browser/browser_thread.h"
@@ -37,6 +39,7 @@
 #include "shell/common/gin_helper/microtasks_scope.h"
 #include "shell/common/mac/main_application_bundle.h"
 #include "shell/common/node_util.h"
+#include "shell/common/startup_timings.h"
 #include "shell/common/world_ids.h"
 #include "third_party/blink/public/web/web_local_frame.h"
 #include "third_party/blink/renderer/bindings/core/v8/v8_initializer.h"  // nogncheck
@@ -103,7 +106,8 @@
 #define ELECTRON_UTILITY_BINDINGS(V) \
   V(electron_browser_event_emitter)  \
   V(electron_common_net)             \
-  V(electron_utility_parent_port)
+  V(electron_utility_parent_port)    \
+  V(electron_utility_protocol)
 
 #define ELECTRON_TESTING_BINDINGS(V) V(electron_common_testing)
 
@@ -395,6 +399,12 @@ namespace electron {
 
 namespace {
 
+// How long UvRunOnce() may keep running uv iterations that are due before
+// yielding back to Chromium's message loop.
+constexpr base::TimeDelta kUvRunBudget = base::Milliseconds(4);
+
+}  // namespace
+
 base::FilePath GetResourcesPath() {
 #if BUILDFLAG(IS_MAC)
   return MainApplicationBundlePath().Append("Contents").Append("Resources");
@@ -406,24 +416,26 @@ base::FilePath GetResourcesPath() {
   return exec_path.DirName().Append(FILE_PATH_LITERAL("resources"));
 #endif
 }
-}  // namespace
 
 NodeBindings::NodeBindings(BrowserEnvironment browser_env)
     : browser_env_{browser_env},
       uv_loop_{InitEventLoop(browser_env, &worker_loop_)} {}
 
 NodeBindings::~NodeBindings() {
-  // Quit the embed thread.
-  embed_closed_ = true;
-  uv_sem_post(&embed_sem_);
+  if (!watch_backend_fd_) {
+    // Quit the embed thread.
+    embed_closed_ = true;
+    uv_sem_post(&embed_sem_);
 
-  WakeupEmbedThread();
+    WakeupEmbedThread();
 
-  // Wait for everything to be done.
-  uv_thread_join(&embed_thread_);
+    // Wait for everything to be done.
+    uv_thread_join(&embed_thread_);
+
+    uv_sem_destroy(&embed_sem_);
+  }
 
   // Clear uv.
-  uv_sem_destroy(&embed_sem_);
   dummy_uv_handle_.reset();
 
   // Clean up worker loop
@@ -506,7 +518,7 @@ std::vector<std::string> NodeBindings::ParseNodeCliFlags() {
 }
 
 void NodeBindings::Initialize(v8::Local<v8::Context> context) {
-  TRACE_EVENT0("electron", "NodeBindings::Initialize");
+  ScopedStartupTiming startup_timing("NodeBindings::Initialize");
   // Open node's error reporting system for browser process.
 
 #if BUILDFLAG(IS_LINUX)
@@ -571,6 +583,8 @@ std::shared_ptr<node::Environment> NodeBindings::CreateEnvironment(
     std::vector<std::string> args,
     std::vector<std::string> exec_args,
     std::optional<base::RepeatingCallback<void()>> on_app_code_ready) {
+  ScopedStartupTiming startup_timing("NodeBindings::CreateEnvironment");
+
   // Feed node the path to initialization script.
   std::string process_type;
   switch (browser_env_) {
@@ -617,7 +631,19 @@ std::shared_ptr<node::Environment> NodeBindings::CreateEnvironment(
 
   args.insert(args.begin() + 1, init_script);
 
-  auto* isolate_data = node::CreateIsolateData(isolate, uv_loop_, platform);
+  // The renderer creates an environment for each page with nodeIntegration,
+  // all in the same isolate and uv loop, so they share the per-isolate data
+  // rather than building it again on every navigation. It lives as long as
+  // the isolate does, which is until the process exits.
+  node::IsolateData* isolate_data = nullptr;
+  const bool share_isolate_data = browser_env_ == BrowserEnvironment::kRenderer;
+  if (share_isolate_data) {
+    if (!isolate_data_)
+      isolate_data_ = node::CreateIsolateData(isolate, uv_loop_, platform);
+    isolate_data = isolate_data_;
+  } else {
+    isolate_data = node::CreateIsolateData(isolate, uv_loop_, platform);
+  }
   context->SetAlignedPointerInEmbedderData(kElectronContextEmbedderDataIndex,
                                            static_cast<void*>(isolate_data));
 
@@ -749,19 +775,20 @@ std::shared_ptr<node::Environment> NodeBindings::CreateEnvironment(
     }
   }
 
-  auto env_deleter = [isolate, isolate_data,
+  auto env_deleter = [isolate, isolate_data, share_isolate_data,
                       context = v8::Global<v8::Context>{isolate, context}](
                          node::Environment* nenv) mutable {
     // When `isolate_data` was created above, a pointer to it was kept
     // in context's embedder_data[kElectronContextEmbedderDataIndex].
-    // Since we're about to free `isolate_data`, clear that entry
+    // Since the context is done with `isolate_data`, clear that entry
     v8::HandleScope handle_scope{isolate};
     context.Get(isolate)->SetAlignedPointerInEmbedderData(
         kElectronContextEmbedderDataIndex, nullptr);
     context.Reset();
 
     node::FreeEnvironment(nenv);
-    node::FreeIsolateData(isolate_data);
+    if (!share_isolate_data)
+      node::FreeIsolateData(isolate_data);
   };
 
   return {env, std::move(env_deleter)};
@@ -783,6 +810,7 @@ std::shared_ptr<node::Environment> NodeBindings::CreateEnvironment(
 }
 
 void NodeBindings::LoadEnvironment(node::Environment* env) {
+  ScopedStartupTiming startup_timing("NodeBindings::LoadEnvironment");
   node::LoadEnvironment(env, node::StartExecutionCallback{}, &OnNodePreload);
   gin_helper::EmitEvent(env->isolate(), env->process_object(), "loaded");
 }
@@ -801,6 +829,13 @@ void NodeBindings::PrepareEmbedThread() {
   // nothing to do.
   uv_async_init(uv_loop_, dummy_uv_handle_.get(), nullptr);
 
+  // Events are dispatched straight from the message pump when it can watch
+  // the backend fd, which saves two thread hops for each of them.
+  if (CanWatchBackendFd()) {
+    watch_backend_fd_ = true;
+    return;
+  }
+
   // Start worker that will interrupt main loop when having uv events.
   uv_sem_init(&embed_sem_, 0);
   uv_thread_create(&embed_thread_, EmbedThreadRunner, this);
@@ -818,6 +853,9 @@ void NodeBindings::StartPolling() {
   // The MessageLoop should have been created, remember the one in main thread.
   task_runner_ = base::SingleThreadTaskRunner::GetCurrentDefault();
 
+  if (watch_backend_fd_)
+    WatchBackendFd();
+
   // Run uv loop for once to give the uv__io_poll a chance to add all events.
   UvRunOnce();
 }
@@ -832,6 +870,8 @@ void NodeBindings::JoinAppCode() {
     return;
   }
 
+  ScopedStartupTiming startup_timing("NodeBindings::JoinAppCode");
+
   auto* browser = Browser::Get();
   node::Environment* env = uv_env();
 
@@ -854,6 +894,19 @@ void NodeBindings::JoinAppCode() {
 }
 
 void NodeBindings::UvRunOnce() {
+  // A nested run loop, like the one clipboard.readImage() spins, can call
+  // this again while uv_run() is still on the stack, which uv doesn't
+  // support. The outer call runs whatever became due once it is back.
+  if (in_uv_run_) {
+    if (watch_backend_fd_ && !backend_fd_paused_) {
+      StopWatchingBackendFd();
+      backend_fd_paused_ = true;
+    }
+    return;
+  }
+  if (watch_backend_fd_)
+    backend_timer_.Stop();
+
   node::Environment* env = uv_env();
 
   // When doing navigation without restarting renderer process, it may happen
@@ -862,6 +915,7 @@ void NodeBindings::UvRunOnce() {
   if (!env)
     return;
 
+  base::AutoReset<bool> in_uv_run(&in_uv_run_, true);
   v8::HandleScope handle_scope(env->isolate());
 
   // Enter node context while dealing with uv events.
@@ -879,8 +933,18 @@ void NodeBindings::UvRunOnce() {
   if (browser_env_ != BrowserEnvironment::kBrowser)
     TRACE_EVENT_BEGIN0("devtools.timeline", "FunctionCall");
 
-  // Deal with uv events.
-  int r = uv_run(uv_loop_, UV_RUN_NOWAIT);
+  // Deal with uv events. When uv still has callbacks that are due right away,
+  // such as when many completions arrived at once, keep draining them for up
+  // to |kUvRunBudget| rather than paying for another wakeup for each batch.
+  const base::TimeTicks deadline = base::TimeTicks::Now() + kUvRunBudget;
+  int iterations = 0;
+  int r;
+  do {
+    r = uv_run(uv_loop_, UV_RUN_NOWAIT);
+    ++iterations;
+  } while (r != 0 && uv_backend_timeout(uv_loop_) == 0 &&
+           base::TimeTicks::Now() < deadline);
+  TRACE_COUNTER1("electron", "UvIterationsPerWakeup", iterations);
 
   if (browser_env_ != BrowserEnvironment::kBrowser)
     TRACE_EVENT_END0("devtools.timeline", "FunctionCall");
@@ -890,6 +954,22 @@ void NodeBindings::UvRunOnce() {
   if (r == 0)
     base::RunLoop().QuitWhenIdle();  // Quit from uv.
 
+  if (watch_backend_fd_) {
+    if (std::exchange(backend_fd_paused_, false))
+      WatchBackendFd();
+    // The backend fd only becomes readable for I/O, so run the loop again by
+    // the time its next timer is due.
+    int timeout = uv_backend_timeout(uv_loop_);
+    if (timeout >= 0) {
+      backend_timer_.Start(FROM_HERE, base::Milliseconds(timeout),
+                           base::BindOnce(&NodeBindings::UvRunOnce,
+                                          base::Unretained(this)));
+    } else {
+      backend_timer_.Stop();
+    }
+    return;
+  }
+
   // Tell the worker thread to continue polling.
   uv_sem_post(&embed_sem_);
 }
@@ -904,6 +984,22 @@ void NodeBindings::WakeupEmbedThread() {
   uv_async_send(dummy_uv_handle_.get());
 }
 
+bool NodeBindings::CanWatchBackendFd() const {
+  return false;
+}
+
+void NodeBindings::WatchBackendFd() {
+  NOTREACHED();
+}
+
+void NodeBindings::StopWatchingBackendFd() {
+  NOTREACHED();
+}
+
+void NodeBindings::OnBackendFdReadable() {
+  UvRunOnce();
+}
+
 // static
 void NodeBindings::EmbedThreadRunner(void* arg) {
   auto* self = static_cast<NodeBindings*>(arg);
@@ -16,6 +16,7 @@
 #include "base/memory/raw_ptr.h"
 #include "base/memory/raw_ptr_exclusion.h"
 #include "base/memory/weak_ptr.h"
+#include "base/timer/timer.h"
 #include "gin/public/context_holder.h"
 #include "gin/public/gin_embedders.h"
 #include "shell/common/node_includes.h"
@@ -28,6 +29,10 @@ class SingleThreadTaskRunner;
 
 namespace electron {
 
+// The directory that holds the app and Electron's own resources, which JS
+// sees as process.resourcesPath.
+base::FilePath GetResourcesPath();
+
 // A helper class to manage uv_handle_t types, e.g. uv_async_t.
 //
 // As per the uv docs: "uv_close() MUST be called on each handle before
@@ -154,6 +159,18 @@ class NodeBindings {
   // Interrupt the PollEvents.
   void WakeupEmbedThread();
 
+  // Whether uv's backend fd can be watched by the message pump of the current
+  // thread, in which case there is no embed thread and PollEvents() is never
+  // called.
+  virtual bool CanWatchBackendFd() const;
+
+  // Starts watching uv's backend fd in the current thread's message pump.
+  // Derived classes call OnBackendFdReadable() whenever it becomes readable.
+  virtual void WatchBackendFd();
+  virtual void StopWatchingBackendFd();
+
+  void OnBackendFdReadable();
+
  private:
   static uv_loop_t* InitEventLoop(BrowserEnvironment browser_env,
                                   uv_loop_t* worker_loop);
@@ -201,6 +218,21 @@ class NodeBindings {
   // Whether the libuv loop has ended.
   bool embed_closed_ = false;
 
+  // Whether uv's backend fd is watched by the message pump instead of polled
+  // in |embed_thread_|.
+  bool watch_backend_fd_ = false;
+
+  // Runs the loop when its next timer is due while the backend fd is watched.
+  base::OneShotTimer backend_timer_;
+
+  // Whether UvRunOnce() is on the stack, as it is when a nested run loop
+  // runs tasks from inside a uv callback.
+  bool in_uv_run_ = false;
+
+  // Whether the backend fd stopped being watched while |in_uv_run_|, as it
+  // stays readable until the outer call has run the loop.
+  bool backend_fd_paused_ = false;
+
   // Dummy handle to make uv's loop not quit.
   UvHandle<uv_async_t> dummy_uv_handle_;
 
@@ -213,7 +245,7 @@ class NodeBindings {
   // Environment that to wrap the uv loop.
   raw_ptr<node::Environment> uv_env_ = nullptr;
 
-  // Isolate data used in creating the environment
+  // Isolate data shared by the environments of the renderer process.
   raw_ptr<node::IsolateData> isolate_data_ = nullptr;
 
   base::WeakPtrFactory<NodeBindings> weak_factory_{this};
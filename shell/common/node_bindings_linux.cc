@@ -6,6 +6,8 @@
 
 #include <sys/epoll.h>
 
+#include "base/task/current_thread.h"
+
 namespace electron {
 
 NodeBindingsLinux::NodeBindingsLinux(BrowserEnvironment browser_env)
@@ -19,6 +21,8 @@ NodeBindingsLinux::NodeBindingsLinux(BrowserEnvironment browser_env)
   epoll_ctl(epoll_, EPOLL_CTL_ADD, backend_fd, &ev);
 }
 
+NodeBindingsLinux::~NodeBindingsLinux() = default;
+
 void NodeBindingsLinux::PollEvents() {
   auto* const event_loop = uv_loop();
 
@@ -32,6 +36,27 @@ void NodeBindingsLinux::PollEvents() {
   } while (r == -1 && errno == EINTR);
 }
 
+bool NodeBindingsLinux::CanWatchBackendFd() const {
+  // uv's backend fd is an epoll fd, which becomes readable whenever any of
+  // the fds it watches are. Only the UI message pump of the browser process
+  // can watch fds on the main thread.
+  return base::CurrentUIThread::IsSet();
+}
+
+void NodeBindingsLinux::WatchBackendFd() {
+  CHECK(base::CurrentUIThread::Get()->WatchFileDescriptor(
+      uv_backend_fd(uv_loop()), true, base::MessagePumpForUI::WATCH_READ,
+      &backend_fd_controller_, this));
+}
+
+void NodeBindingsLinux::StopWatchingBackendFd() {
+  backend_fd_controller_.StopWatchingFileDescriptor();
+}
+
+void NodeBindingsLinux::OnFileCanReadWithoutBlocking(int fd) {
+  OnBackendFdReadable();
+}
+
 // static
 NodeBindings* NodeBindings::Create(BrowserEnvironment browser_env) {
   return new NodeBindingsLinux(browser_env);
@@ -141,6 +141,9 @@ const char kDisableBlinkFeatures[] = "disableBlinkFeatures";
 // Enable the node integration in WebWorker.
 const char kNodeIntegrationInWorker[] = "nodeIntegrationInWorker";
 
+// Create the Node environment of a page on first use of its Node globals.
+const char kLazyNodeIntegration[] = "lazyNodeIntegration";
+
 // Enable the web view tag.
 const char kWebviewTag[] = "webviewTag";
 
@@ -242,6 +245,9 @@ const char kScrollBounce[] = "scroll-bounce";
 // Command switch passed to renderer process to control nodeIntegration.
 const char kNodeIntegrationInWorker[] = "node-integration-in-worker";
 
+// Command switch passed to renderer process to control lazyNodeIntegration.
+const char kLazyNodeIntegration[] = "lazy-node-integration";
+
 // Widevine options
 // Path to Widevine CDM binaries.
 const char kWidevineCdmPath[] = "widevine-cdm-path";
@@ -251,6 +257,10 @@ const char kWidevineCdmVersion[] = "widevine-cdm-version";
 // Forces the maximum disk space to be used by the disk cache, in bytes.
 const char kDiskCacheSize[] = "disk-cache-size";
 
+// How long changes to zoom levels and DevTools settings wait to be written to
+// the preferences of a session, in seconds.
+const char kPrefsWriteInterval[] = "prefs-write-interval";
+
 // Ignore the limit of 6 connections per host.
 const char kIgnoreConnectionsLimit[] = "ignore-connections-limit";
 
@@ -269,6 +279,27 @@ const char kDisableNTLMv2[] = "disable-ntlm-v2";
 
 const char kEnableWebSQL[] = "enable-websql";
 
+// Directory in which prebuilt asar header indexes are cached across launches
+// and processes.
+const char kAsarIndexCacheDir[] = "asar-index-cache-dir";
+
+// Directory in which files that have to be extracted from asar archives, like
+// native modules and executables, are kept across launches.
+const char kAsarExtractionCacheDir[] = "asar-extraction-cache-dir";
+
+// Number of parallel range requests large downloads are split into.
+const char kParallelDownloadSegments[] = "parallel-download-segments";
+
+// V8 flags that are only passed to the main process, renderer processes or
+// utility processes, after the ones of --js-flags.
+const char kBrowserJsFlags[] = "browser-js-flags";
+const char kRendererJsFlags[] = "renderer-js-flags";
+const char kUtilityJsFlags[] = "utility-js-flags";
+
+// Number of worker threads of the V8 platform of the main process and utility
+// processes.
+const char kV8WorkerThreads[] = "v8-worker-threads";
+
 }  // namespace switches
 
 }  // namespace electron
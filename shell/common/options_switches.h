@@ -73,6 +73,7 @@ extern const char kScrollBounce[];
 extern const char kEnableBlinkFeatures[];
 extern const char kDisableBlinkFeatures[];
 extern const char kNodeIntegrationInWorker[];
+extern const char kLazyNodeIntegration[];
 extern const char kWebviewTag[];
 extern const char kCustomArgs[];
 extern const char kPlugins[];
@@ -119,11 +120,13 @@ extern const char kAppPath[];
 
 extern const char kScrollBounce[];
 extern const char kNodeIntegrationInWorker[];
+extern const char kLazyNodeIntegration[];
 
 extern const char kWidevineCdmPath[];
 extern const char kWidevineCdmVersion[];
 
 extern const char kDiskCacheSize[];
+extern const char kPrefsWriteInterval[];
 extern const char kIgnoreConnectionsLimit[];
 extern const char kAuthServerWhitelist[];
 extern const char kAuthNegotiateDelegateWhitelist[];
@@ -131,6 +134,15 @@ extern const char kEnableAuthNegotiatePort[];
 extern const char kDisableNTLMv2[];
 
 extern const char kEnableWebSQL[];
+
+extern const char kAsarIndexCacheDir[];
+extern const char kAsarExtractionCacheDir[];
+extern const char kParallelDownloadSegments[];
+
+extern const char kBrowserJsFlags[];
+extern const char kRendererJsFlags[];
+extern const char kUtilityJsFlags[];
+extern const char kV8WorkerThreads[];
 }  // namespace switches
 
 }  // namespace electron
@@ -0,0 +1,102 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/shared_memory_array_buffer.h"
+
+#include <map>
+#include <memory>
+#include <utility>
+
+#include "base/no_destructor.h"
+#include "base/synchronization/lock.h"
+#include "gin/converter.h"
+#include "v8/include/v8.h"
+
+namespace electron {
+
+namespace {
+
+struct SharedMemoryBacking {
+  base::UnsafeSharedMemoryRegion region;
+  base::WritableSharedMemoryMapping mapping;
+};
+
+// The buffers can be passed to workers and freed on their threads.
+base::Lock& GetBackingsLock() {
+  static base::NoDestructor<base::Lock> lock;
+  return *lock;
+}
+
+std::map<const void*, SharedMemoryBacking*>& GetBackings() {
+  static base::NoDestructor<std::map<const void*, SharedMemoryBacking*>>
+      backings;
+  return *backings;
+}
+
+void FreeBacking(void* data, size_t length, void* deleter_data) {
+  const auto* backing = static_cast<SharedMemoryBacking*>(deleter_data);
+  {
+    base::AutoLock auto_lock(GetBackingsLock());
+    GetBackings().erase(data);
+  }
+  delete backing;
+}
+
+v8::MaybeLocal<v8::SharedArrayBuffer> WrapRegion(
+    v8::Isolate* isolate,
+    base::UnsafeSharedMemoryRegion region) {
+  auto backing = std::make_unique<SharedMemoryBacking>();
+  backing->mapping = region.Map();
+  if (!backing->mapping.IsValid())
+    return {};
+  backing->region = std::move(region);
+
+  void* data = backing->mapping.memory();
+  const size_t size = backing->mapping.size();
+  {
+    base::AutoLock auto_lock(GetBackingsLock());
+    GetBackings()[data] = backing.get();
+  }
+  std::unique_ptr<v8::BackingStore> backing_store =
+      v8::SharedArrayBuffer::NewBackingStore(data, size, &FreeBacking,
+                                             backing.release());
+  return v8::SharedArrayBuffer::New(isolate, std::move(backing_store));
+}
+
+}  // namespace
+
+v8::MaybeLocal<v8::SharedArrayBuffer> CreateSharedMemoryArrayBuffer(
+    v8::Isolate* isolate,
+    size_t size) {
+  base::UnsafeSharedMemoryRegion region;
+  if (size != 0)
+    region = base::UnsafeSharedMemoryRegion::Create(size);
+  v8::Local<v8::SharedArrayBuffer> buffer;
+  if (!region.IsValid() || !WrapRegion(isolate, std::move(region))
+                                .ToLocal(&buffer)) {
+    isolate->ThrowException(v8::Exception::RangeError(gin::StringToV8(
+        isolate, "Could not allocate a shared memory SharedArrayBuffer")));
+    return {};
+  }
+  return buffer;
+}
+
+v8::MaybeLocal<v8::SharedArrayBuffer> MapSharedMemoryArrayBuffer(
+    v8::Isolate* isolate,
+    base::UnsafeSharedMemoryRegion region) {
+  if (!region.IsValid())
+    return {};
+  return WrapRegion(isolate, std::move(region));
+}
+
+base::UnsafeSharedMemoryRegion GetSharedMemoryRegion(
+    v8::Local<v8::SharedArrayBuffer> buffer) {
+  base::AutoLock auto_lock(GetBackingsLock());
+  auto it = GetBackings().find(buffer->Data());
+  if (it == GetBackings().end())
+    return {};
+  return it->second->region.Duplicate();
+}
+
+}  // namespace electron
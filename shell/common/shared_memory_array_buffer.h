@@ -0,0 +1,36 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_SHARED_MEMORY_ARRAY_BUFFER_H_
+#define ELECTRON_SHELL_COMMON_SHARED_MEMORY_ARRAY_BUFFER_H_
+
+#include "base/memory/unsafe_shared_memory_region.h"
+#include "v8/include/v8-forward.h"
+
+namespace electron {
+
+// SharedArrayBuffers whose contents live in a shared memory region, which
+// lets them be shared with other processes over MessagePorts instead of only
+// with workers in the same process.
+
+// Returns a SharedArrayBuffer of |size| bytes backed by a new shared memory
+// region, or an empty handle, with an exception thrown, on failure.
+v8::MaybeLocal<v8::SharedArrayBuffer> CreateSharedMemoryArrayBuffer(
+    v8::Isolate* isolate,
+    size_t size);
+
+// Returns a SharedArrayBuffer that maps |region|, which was shared by another
+// process, or an empty handle if it could not be mapped.
+v8::MaybeLocal<v8::SharedArrayBuffer> MapSharedMemoryArrayBuffer(
+    v8::Isolate* isolate,
+    base::UnsafeSharedMemoryRegion region);
+
+// Returns a duplicate of the region backing |buffer|, which is invalid if
+// |buffer| was not created by one of the functions above.
+base::UnsafeSharedMemoryRegion GetSharedMemoryRegion(
+    v8::Local<v8::SharedArrayBuffer> buffer);
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_COMMON_SHARED_MEMORY_ARRAY_BUFFER_H_
@@ -2,13 +2,19 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include <cmath>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/strings/pattern.h"
 #include "base/strings/string_util.h"
 #include "net/base/data_url.h"
+#include "shell/common/asar/archive.h"
 #include "shell/common/asar/asar_util.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/skia_util.h"
@@ -22,6 +28,7 @@
 #include "ui/gfx/image/image_skia.h"
 #include "ui/gfx/image/image_skia_operations.h"
 #include "ui/gfx/image/image_skia_rep.h"
+#include "ui/gfx/image/image_skia_source.h"
 #include "ui/gfx/image/image_util.h"
 
 #if BUILDFLAG(IS_WIN)
@@ -150,6 +157,102 @@ bool PopulateImageSkiaRepsFromPath(gfx::ImageSkia* image,
         image, path.InsertBeforeExtensionASCII(pair.name), pair.scale);
   return succeed;
 }
+
+namespace {
+
+bool ImageFileExists(const base::FilePath& path) {
+  base::FilePath asar_path, relative_path;
+  if (asar::GetAsarArchivePath(path, &asar_path, &relative_path)) {
+    std::shared_ptr<asar::Archive> archive =
+        asar::GetOrCreateAsarArchive(asar_path);
+    asar::Archive::FileInfo info;
+    return archive && archive->GetFileInfo(relative_path, &info);
+  }
+
+  electron::ScopedAllowBlockingForElectron allow_blocking;
+  base::File::Info info;
+  return base::GetFileInfo(path, &info) && !info.is_directory;
+}
+
+// Hands out the 1x representation decoded up front, and decodes the file of
+// any other scale the first time it is asked for.
+class LazyPathImageSource : public gfx::ImageSkiaSource {
+ public:
+  LazyPathImageSource(gfx::ImageSkiaRep image_rep_1x,
+                      base::flat_map<float, base::FilePath> paths)
+      : image_rep_1x_(std::move(image_rep_1x)), paths_(std::move(paths)) {}
+
+  // gfx::ImageSkiaSource:
+  gfx::ImageSkiaRep GetImageForScale(float scale) override {
+    // Hand out the closest scale there is a file for, as ImageSkia does when
+    // all of its representations have been decoded.
+    float closest_scale = 1.0f;
+    for (const auto& [file_scale, path] : paths_) {
+      if (std::abs(file_scale - scale) < std::abs(closest_scale - scale))
+        closest_scale = file_scale;
+    }
+    if (closest_scale == 1.0f)
+      return image_rep_1x_;
+
+    gfx::ImageSkia decoded;
+    if (!AddImageSkiaRepFromPath(&decoded, paths_.at(closest_scale),
+                                 closest_scale))
+      return image_rep_1x_;
+    return decoded.image_reps().front();
+  }
+
+ private:
+  const gfx::ImageSkiaRep image_rep_1x_;
+  const base::flat_map<float, base::FilePath> paths_;
+};
+
+}  // namespace
+
+std::vector<base::FilePath> GetScaleVariantPaths(const base::FilePath& path) {
+  std::vector<base::FilePath> paths;
+  for (const ScaleFactorPair& pair : kScaleFactorPairs)
+    paths.push_back(path.InsertBeforeExtensionASCII(pair.name));
+  return paths;
+}
+
+bool CreateLazyImageSkiaFromPath(gfx::ImageSkia* image,
+                                 const base::FilePath& path,
+                                 std::vector<float>* scale_factors) {
+  std::string filename(path.BaseName().RemoveExtension().AsUTF8Unsafe());
+  gfx::ImageSkia image_1x;
+  if (base::MatchPattern(filename, "*@*x") ||
+      !AddImageSkiaRepFromPath(&image_1x, path, 1.0f)) {
+    // Without a 1x representation there is no size to give the lazy image,
+    // so fall back to decoding everything.
+    if (!PopulateImageSkiaRepsFromPath(image, path))
+      return false;
+    for (const auto& image_rep : image->image_reps())
+      scale_factors->push_back(image_rep.scale());
+    return true;
+  }
+
+  base::flat_map<float, base::FilePath> paths;
+  scale_factors->push_back(1.0f);
+  for (const ScaleFactorPair& pair : kScaleFactorPairs) {
+    base::FilePath variant = path.InsertBeforeExtensionASCII(pair.name);
+    if (pair.scale != 1.0f && ImageFileExists(variant)) {
+      paths.emplace(pair.scale, std::move(variant));
+      scale_factors->push_back(pair.scale);
+    }
+  }
+  if (paths.empty()) {
+    *image = image_1x;
+    return true;
+  }
+
+  gfx::ImageSkiaRep image_rep_1x = image_1x.image_reps().front();
+  gfx::Size size(image_rep_1x.GetWidth(), image_rep_1x.GetHeight());
+  *image = gfx::ImageSkia(std::make_unique<LazyPathImageSource>(
+                              std::move(image_rep_1x), std::move(paths)),
+                          size);
+  return true;
+}
+
 #if BUILDFLAG(IS_WIN)
 bool ReadImageSkiaFromICO(gfx::ImageSkia* image, HICON icon) {
   // Convert the icon from the Windows specific HICON to gfx::ImageSkia.
@@ -5,6 +5,8 @@
 #ifndef ELECTRON_SHELL_COMMON_SKIA_UTIL_H_
 #define ELECTRON_SHELL_COMMON_SKIA_UTIL_H_
 
+#include <vector>
+
 namespace base {
 class FilePath;
 }
@@ -18,6 +20,18 @@ namespace electron::util {
 bool PopulateImageSkiaRepsFromPath(gfx::ImageSkia* image,
                                    const base::FilePath& path);
 
+// Like PopulateImageSkiaRepsFromPath, but only the file at |path| is decoded
+// right away. The scale variants found next to it, like icon@2x.png, are
+// decoded the first time a representation of their scale is used. Their
+// scales and the one of |path| are returned in |scale_factors|.
+bool CreateLazyImageSkiaFromPath(gfx::ImageSkia* image,
+                                 const base::FilePath& path,
+                                 std::vector<float>* scale_factors);
+
+// The files that the scale variants of |path| are looked for in, whether or
+// not they exist.
+std::vector<base::FilePath> GetScaleVariantPaths(const base::FilePath& path);
+
 bool AddImageSkiaRepFromBuffer(gfx::ImageSkia* image,
                                const unsigned char* data,
                                size_t size,
@@ -0,0 +1,52 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/startup_timings.h"
+
+#include <cstring>
+
+#include "base/no_destructor.h"
+#include "base/ranges/algorithm.h"
+#include "base/synchronization/lock.h"
+#include "base/trace_event/trace_event.h"
+
+namespace electron {
+
+namespace {
+
+base::Lock& GetStartupTimingsLock() {
+  static base::NoDestructor<base::Lock> lock;
+  return *lock;
+}
+
+std::vector<StartupTiming>& GetStartupTimingsList() {
+  static base::NoDestructor<std::vector<StartupTiming>> timings;
+  return *timings;
+}
+
+}  // namespace
+
+ScopedStartupTiming::ScopedStartupTiming(const char* name)
+    : name_(name), start_(base::TimeTicks::Now()) {
+  TRACE_EVENT_BEGIN0("electron", name_);
+}
+
+ScopedStartupTiming::~ScopedStartupTiming() {
+  TRACE_EVENT_END0("electron", name_);
+
+  base::AutoLock auto_lock(GetStartupTimingsLock());
+  auto& timings = GetStartupTimingsList();
+  if (base::ranges::none_of(timings, [this](const StartupTiming& timing) {
+        return std::strcmp(timing.name, name_) == 0;
+      })) {
+    timings.push_back({name_, start_, base::TimeTicks::Now()});
+  }
+}
+
+std::vector<StartupTiming> GetStartupTimings() {
+  base::AutoLock auto_lock(GetStartupTimingsLock());
+  return GetStartupTimingsList();
+}
+
+}  // namespace electron
@@ -0,0 +1,44 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_STARTUP_TIMINGS_H_
+#define ELECTRON_SHELL_COMMON_STARTUP_TIMINGS_H_
+
+#include <vector>
+
+#include "base/time/time.h"
+
+namespace electron {
+
+// How long one stage of the current process's startup took.
+struct StartupTiming {
+  const char* name;
+  base::TimeTicks start;
+  base::TimeTicks end;
+};
+
+// Times the scope it lives in as the startup stage |name|, which must be a
+// string literal. It is emitted as an "electron" trace event every time, but
+// only the first run of each stage is kept for GetStartupTimings().
+class ScopedStartupTiming {
+ public:
+  explicit ScopedStartupTiming(const char* name);
+  ~ScopedStartupTiming();
+
+  // disable copy
+  ScopedStartupTiming(const ScopedStartupTiming&) = delete;
+  ScopedStartupTiming& operator=(const ScopedStartupTiming&) = delete;
+
+ private:
+  const char* name_;
+  base::TimeTicks start_;
+};
+
+// Returns the startup stages of this process that have finished so far, in
+// the order they finished. Safe to call from any thread.
+std::vector<StartupTiming> GetStartupTimings();
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_COMMON_STARTUP_TIMINGS_H_
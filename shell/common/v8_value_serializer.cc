@@ -4,15 +4,35 @@
 
 #include "shell/common/v8_value_serializer.h"
 
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <optional>
 #include <utility>
 #include <vector>
 
+#include "base/containers/contains.h"
+#include "base/dcheck_is_on.h"
 #include "base/memory/raw_ptr.h"
+#include "base/memory/ref_counted.h"
+#include "base/no_destructor.h"
+#include "base/ranges/algorithm.h"
+#include "base/functional/bind.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/threading/thread_local.h"
+#include "base/time/time.h"
 #include "gin/converter.h"
+#include "mojo/public/cpp/base/big_buffer.h"
+#include "mojo/public/cpp/bindings/message.h"
+#include "mojo/public/cpp/system/message_pipe.h"
+#include "shell/common/api/api.mojom.h"
 #include "shell/common/api/electron_api_native_image.h"
 #include "shell/common/gin_helper/microtasks_scope.h"
+#include "shell/common/shared_memory_array_buffer.h"
 #include "skia/public/mojom/bitmap.mojom.h"
 #include "third_party/blink/public/common/messaging/cloneable_message.h"
+#include "third_party/blink/public/common/messaging/message_port_descriptor.h"
+#include "third_party/blink/public/common/messaging/transferable_message.h"
 #include "third_party/blink/public/common/messaging/web_message_port.h"
 #include "ui/gfx/image/image_skia.h"
 #include "v8/include/v8.h"
@@ -22,9 +42,523 @@ namespace electron {
 namespace {
 enum SerializationTag {
   kNativeImageTag = 'i',
+  kSharedArrayBufferRegionsTag = 0xFC,
+  kPlainDataTag = 0xFD,
   kTrailerOffsetTag = 0xFE,
   kVersionTag = 0xFF
 };
+
+// Serializer output is written into buffers that are kept by each thread and
+// reused by later messages, and then copied out at its final size. That costs
+// one allocation per message rather than every reallocation of a new buffer
+// growing to fit it, for messages up to kMaxCapacity.
+class BufferPool {
+ public:
+  static BufferPool& Get() {
+    static base::NoDestructor<base::ThreadLocalOwnedPointer<BufferPool>>
+        s_pool;
+    BufferPool* pool = s_pool->Get();
+    if (!pool) {
+      auto new_pool = std::make_unique<BufferPool>();
+      pool = new_pool.get();
+      s_pool->Set(std::move(new_pool));
+    }
+    return *pool;
+  }
+
+  std::vector<uint8_t> Take() {
+    if (buffers_.empty())
+      return {};
+    std::vector<uint8_t> buffer = std::move(buffers_.back());
+    buffers_.pop_back();
+    return buffer;
+  }
+
+  void Return(std::vector<uint8_t> buffer) {
+    // More than one buffer is in use when a getter sends a message while its
+    // object is being serialized, which is rare enough not to keep many.
+    if (buffers_.size() == kMaxBuffers || buffer.capacity() > kMaxCapacity)
+      return;
+    buffer.clear();
+    buffers_.push_back(std::move(buffer));
+  }
+
+ private:
+  static constexpr size_t kMaxBuffers = 4;
+  static constexpr size_t kMaxCapacity = 1024 * 1024;
+
+  std::vector<std::vector<uint8_t>> buffers_;
+};
+
+// A buffer taken from the current thread's pool for as long as it lives.
+class PooledBuffer {
+ public:
+  PooledBuffer() : buffer_(BufferPool::Get().Take()) {}
+  ~PooledBuffer() { BufferPool::Get().Return(std::move(buffer_)); }
+
+  PooledBuffer(const PooledBuffer&) = delete;
+  PooledBuffer& operator=(const PooledBuffer&) = delete;
+
+  std::vector<uint8_t>& operator*() { return buffer_; }
+  std::vector<uint8_t>* operator->() { return &buffer_; }
+
+ private:
+  std::vector<uint8_t> buffer_;
+};
+
+// Copies serializer output into a message that owns it, after |prefix_tag|
+// if any.
+void SetEncodedMessage(base::span<const uint8_t> data,
+                       blink::CloneableMessage* out,
+                       std::optional<SerializationTag> prefix_tag = {}) {
+  out->owned_encoded_message.clear();
+  out->owned_encoded_message.reserve(data.size() + (prefix_tag ? 1 : 0));
+  if (prefix_tag)
+    out->owned_encoded_message.push_back(*prefix_tag);
+  out->owned_encoded_message.insert(out->owned_encoded_message.end(),
+                                    data.begin(), data.end());
+  out->encoded_message = out->owned_encoded_message;
+  out->sender_agent_cluster_id =
+      blink::WebMessagePort::GetEmbedderAgentClusterID();
+}
+
+#if DCHECK_IS_ON()
+// How long the regions are held back by the sender in tests, which never
+// sends them when this is base::TimeDelta::Max().
+base::TimeDelta g_regions_delay_for_testing;
+#endif
+
+void WriteSharedArrayBufferRegions(
+    blink::MessagePortDescriptor sender,
+    std::vector<base::UnsafeSharedMemoryRegion> regions) {
+  mojo::ScopedMessagePipeHandle handle =
+      sender.TakeHandleToEntangleWithEmbedder();
+  mojo::Message message = mojom::SharedArrayBufferRegions::WrapAsMessage(
+      mojom::SharedArrayBufferRegions::New(std::move(regions)));
+  mojo::WriteMessageNew(handle.get(), message.TakeMojoMessage(),
+                        MOJO_WRITE_MESSAGE_FLAG_NONE);
+  sender.GiveDisentangledHandle(std::move(handle));
+}
+
+// Sends |regions| over a port of their own, which is added after |ports|.
+void AttachSharedArrayBufferRegions(
+    std::vector<base::UnsafeSharedMemoryRegion> regions,
+    std::vector<blink::MessagePortDescriptor>* ports) {
+  blink::MessagePortDescriptorPair pipe;
+  ports->push_back(pipe.TakePort1());
+#if DCHECK_IS_ON()
+  if (g_regions_delay_for_testing.is_max())
+    return;
+  if (g_regions_delay_for_testing.is_positive()) {
+    base::SequencedTaskRunner::GetCurrentDefault()->PostDelayedTask(
+        FROM_HERE,
+        base::BindOnce(&WriteSharedArrayBufferRegions, pipe.TakePort0(),
+                       std::move(regions)),
+        g_regions_delay_for_testing);
+    return;
+  }
+#endif
+  WriteSharedArrayBufferRegions(pipe.TakePort0(), std::move(regions));
+}
+
+bool ReadSharedArrayBufferRegions(
+    blink::MessagePortDescriptor port,
+    std::vector<base::UnsafeSharedMemoryRegion>* out) {
+  mojo::ScopedMessagePipeHandle handle =
+      port.TakeHandleToEntangleWithEmbedder();
+  // Receivers hold the message back with SharedArrayBufferRegionsWaiter until
+  // the regions have arrived, so they are never waited for here.
+  mojo::ScopedMessageHandle message_handle;
+  const bool read =
+      mojo::ReadMessageNew(handle.get(), &message_handle,
+                           MOJO_READ_MESSAGE_FLAG_NONE) == MOJO_RESULT_OK;
+  port.GiveDisentangledHandle(std::move(handle));
+  if (!read)
+    return false;
+
+  mojom::SharedArrayBufferRegionsPtr regions;
+  if (!mojom::SharedArrayBufferRegions::DeserializeFromMessage(
+          mojo::Message::CreateFromMessageHandle(&message_handle), &regions))
+    return false;
+  *out = std::move(regions->regions);
+  return true;
+}
+
+// The most arrays and objects a plain data payload can contain, which also
+// bounds how deeply the reader recurses into untrusted input.
+constexpr size_t kMaxPlainDataObjects = 64;
+
+// Tags of the values in the plain data format.
+enum PlainDataTag : uint8_t {
+  kPlainUndefined = '_',
+  kPlainNull = '0',
+  kPlainTrue = 'T',
+  kPlainFalse = 'F',
+  kPlainInt32 = 'I',
+  kPlainDouble = 'N',
+  kPlainOneByteString = '"',
+  kPlainTwoByteString = 'c',
+  kPlainArray = 'A',
+  kPlainObject = 'o',
+};
+
+// Encodes values made only of primitives, dense arrays and plain objects in a
+// compact format that is much cheaper to write and read than the structured
+// clone format. Returns false for anything else, including objects that are
+// reachable more than once, whose identity structured clone would preserve,
+// so that the caller can fall back to V8Serializer. Properties are read from
+// their descriptors and accessors and proxies are refused, so no JS runs
+// before falling back.
+class PlainDataWriter {
+ public:
+  explicit PlainDataWriter(v8::Isolate* isolate)
+      : isolate_(isolate),
+        context_(isolate->GetCurrentContext()),
+        object_prototype_(v8::Object::New(isolate)->GetPrototype()),
+        array_prototype_(v8::Array::New(isolate)->GetPrototype()),
+        value_key_(v8::String::NewFromUtf8Literal(
+            isolate,
+            "value",
+            v8::NewStringType::kInternalized)) {
+    buffer_->reserve(kInitialBufferSize);
+  }
+
+  // On success |out| points into this writer's buffer.
+  bool Write(v8::Local<v8::Value> value, base::span<const uint8_t>* out) {
+    v8::TryCatch try_catch(isolate_);
+    buffer_->push_back(kPlainDataTag);
+    if (!WriteValue(value))
+      return false;
+    *out = *buffer_;
+    return true;
+  }
+
+ private:
+  static constexpr size_t kInitialBufferSize = 256;
+
+  bool WriteValue(v8::Local<v8::Value> value) {
+    if (value->IsUndefined()) {
+      buffer_->push_back(kPlainUndefined);
+    } else if (value->IsNull()) {
+      buffer_->push_back(kPlainNull);
+    } else if (value->IsTrue()) {
+      buffer_->push_back(kPlainTrue);
+    } else if (value->IsFalse()) {
+      buffer_->push_back(kPlainFalse);
+    } else if (value->IsInt32()) {
+      buffer_->push_back(kPlainInt32);
+      WriteRaw(value.As<v8::Int32>()->Value());
+    } else if (value->IsNumber()) {
+      buffer_->push_back(kPlainDouble);
+      WriteRaw(value.As<v8::Number>()->Value());
+    } else if (value->IsString()) {
+      WriteString(value.As<v8::String>());
+    } else if (value->IsProxy()) {
+      // Even reading the prototype of a proxy would run its traps.
+      return false;
+    } else if (value->IsArray()) {
+      return WriteArray(value.As<v8::Array>());
+    } else if (value->IsObject()) {
+      return WriteObject(value.As<v8::Object>());
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+  void WriteString(v8::Local<v8::String> string) {
+    const int length = string->Length();
+    if (string->IsOneByte()) {
+      buffer_->push_back(kPlainOneByteString);
+      WriteVarint(length);
+      const size_t offset = buffer_->size();
+      buffer_->resize(offset + length);
+      string->WriteOneByte(isolate_, buffer_->data() + offset, 0, length,
+                           v8::String::NO_NULL_TERMINATION);
+    } else {
+      buffer_->push_back(kPlainTwoByteString);
+      WriteVarint(length);
+      // Keep the characters aligned for the reader.
+      if (buffer_->size() % sizeof(uint16_t))
+        buffer_->push_back(0);
+      const size_t offset = buffer_->size();
+      buffer_->resize(offset + length * sizeof(uint16_t));
+      string->Write(isolate_,
+                    reinterpret_cast<uint16_t*>(buffer_->data() + offset), 0,
+                    length, v8::String::NO_NULL_TERMINATION);
+    }
+  }
+
+  bool WriteArray(v8::Local<v8::Array> array) {
+    if (!AddObject(array) || array->GetPrototype() != array_prototype_)
+      return false;
+    // Holes and named properties are preserved by structured clone, so only
+    // arrays that have neither can be written as a plain list.
+    const uint32_t length = array->Length();
+    v8::Local<v8::Array> keys;
+    if (!array
+             ->GetOwnPropertyNames(
+                 context_,
+                 static_cast<v8::PropertyFilter>(v8::ONLY_ENUMERABLE |
+                                                 v8::SKIP_SYMBOLS),
+                 v8::KeyConversionMode::kConvertToString)
+             .ToLocal(&keys) ||
+        keys->Length() != length)
+      return false;
+    buffer_->push_back(kPlainArray);
+    WriteVarint(length);
+    for (uint32_t i = 0; i < length; ++i) {
+      v8::Local<v8::Value> key;
+      v8::Local<v8::Value> element;
+      if (!array->HasRealIndexedProperty(context_, i).FromMaybe(false) ||
+          !keys->Get(context_, i).ToLocal(&key) || !key->IsString() ||
+          !GetDataProperty(array, key.As<v8::String>(), &element) ||
+          !WriteValue(element))
+        return false;
+    }
+    return true;
+  }
+
+  bool WriteObject(v8::Local<v8::Object> object) {
+    if (!AddObject(object) || object->GetPrototype() != object_prototype_ ||
+        object->InternalFieldCount() != 0)
+      return false;
+    v8::Local<v8::Array> keys;
+    if (!object
+             ->GetOwnPropertyNames(context_, v8::ONLY_ENUMERABLE,
+                                   v8::KeyConversionMode::kConvertToString)
+             .ToLocal(&keys))
+      return false;
+    const uint32_t length = keys->Length();
+    buffer_->push_back(kPlainObject);
+    WriteVarint(length);
+    for (uint32_t i = 0; i < length; ++i) {
+      v8::Local<v8::Value> key;
+      v8::Local<v8::Value> property;
+      if (!keys->Get(context_, i).ToLocal(&key) || !key->IsString() ||
+          !GetDataProperty(object, key.As<v8::String>(), &property))
+        return false;
+      WriteString(key.As<v8::String>());
+      if (!WriteValue(property))
+        return false;
+    }
+    return true;
+  }
+
+  // Reads the value of an own data property without running any getter,
+  // failing for accessors.
+  bool GetDataProperty(v8::Local<v8::Object> object,
+                       v8::Local<v8::String> key,
+                       v8::Local<v8::Value>* out) {
+    v8::Local<v8::Value> descriptor;
+    if (!object->GetOwnPropertyDescriptor(context_, key).ToLocal(&descriptor) ||
+        !descriptor->IsObject())
+      return false;
+    // The descriptors created by V8 are plain objects with no getters of
+    // their own.
+    v8::Local<v8::Object> fields = descriptor.As<v8::Object>();
+    return fields->HasOwnProperty(context_, value_key_).FromMaybe(false) &&
+           fields->Get(context_, value_key_).ToLocal(out);
+  }
+
+  bool AddObject(v8::Local<v8::Object> object) {
+    // Larger payloads are rarely plain enough to be worth the identity checks.
+    if (objects_.size() == kMaxPlainDataObjects ||
+        base::Contains(objects_, object))
+      return false;
+    objects_.push_back(object);
+    return true;
+  }
+
+  void WriteVarint(uint32_t value) {
+    while (value >= 0x80) {
+      buffer_->push_back(static_cast<uint8_t>(value) | 0x80);
+      value >>= 7;
+    }
+    buffer_->push_back(static_cast<uint8_t>(value));
+  }
+
+  template <typename T>
+  void WriteRaw(T value) {
+    const size_t offset = buffer_->size();
+    buffer_->resize(offset + sizeof(T));
+    memcpy(buffer_->data() + offset, &value, sizeof(T));
+  }
+
+  raw_ptr<v8::Isolate> isolate_;
+  v8::Local<v8::Context> context_;
+  v8::Local<v8::Value> object_prototype_;
+  v8::Local<v8::Value> array_prototype_;
+  v8::Local<v8::String> value_key_;
+  std::vector<v8::Local<v8::Object>> objects_;
+  PooledBuffer buffer_;
+};
+
+class PlainDataReader {
+ public:
+  PlainDataReader(v8::Isolate* isolate, base::span<const uint8_t> data)
+      : isolate_(isolate), data_(data) {}
+
+  v8::Local<v8::Value> Read() {
+    v8::EscapableHandleScope scope(isolate_);
+    uint8_t tag;
+    v8::Local<v8::Value> value;
+    if (!ReadByte(&tag) || tag != kPlainDataTag || !ReadValue(&value) ||
+        position_ != data_.size())
+      return v8::Null(isolate_);
+    return scope.Escape(value);
+  }
+
+ private:
+  bool ReadValue(v8::Local<v8::Value>* out) {
+    uint8_t tag;
+    if (!ReadByte(&tag))
+      return false;
+    switch (tag) {
+      case kPlainUndefined:
+        *out = v8::Undefined(isolate_);
+        return true;
+      case kPlainNull:
+        *out = v8::Null(isolate_);
+        return true;
+      case kPlainTrue:
+        *out = v8::True(isolate_);
+        return true;
+      case kPlainFalse:
+        *out = v8::False(isolate_);
+        return true;
+      case kPlainInt32: {
+        int32_t value;
+        if (!ReadRaw(&value))
+          return false;
+        *out = v8::Integer::New(isolate_, value);
+        return true;
+      }
+      case kPlainDouble: {
+        double value;
+        if (!ReadRaw(&value))
+          return false;
+        *out = v8::Number::New(isolate_, value);
+        return true;
+      }
+      case kPlainOneByteString:
+      case kPlainTwoByteString:
+        return ReadString(tag, out);
+      case kPlainArray:
+        return ReadArray(out);
+      case kPlainObject:
+        return ReadObject(out);
+    }
+    return false;
+  }
+
+  bool ReadString(uint8_t tag, v8::Local<v8::Value>* out) {
+    uint32_t length;
+    if (!ReadVarint(&length))
+      return false;
+    v8::MaybeLocal<v8::String> string;
+    if (tag == kPlainOneByteString) {
+      if (length > data_.size() - position_)
+        return false;
+      string = v8::String::NewFromOneByte(isolate_, data_.data() + position_,
+                                          v8::NewStringType::kNormal, length);
+      position_ += length;
+    } else {
+      if (position_ % sizeof(uint16_t))
+        position_++;
+      if (position_ > data_.size() ||
+          length > (data_.size() - position_) / sizeof(uint16_t))
+        return false;
+      string = v8::String::NewFromTwoByte(
+          isolate_, reinterpret_cast<const uint16_t*>(data_.data() + position_),
+          v8::NewStringType::kNormal, length);
+      position_ += length * sizeof(uint16_t);
+    }
+    v8::Local<v8::String> result;
+    if (!string.ToLocal(&result))
+      return false;
+    *out = result;
+    return true;
+  }
+
+  bool ReadArray(v8::Local<v8::Value>* out) {
+    uint32_t length;
+    // Every element takes at least one byte.
+    if (!AddObject() || !ReadVarint(&length) ||
+        length > data_.size() - position_)
+      return false;
+    v8::LocalVector<v8::Value> elements(isolate_, length);
+    for (auto& element : elements) {
+      if (!ReadValue(&element))
+        return false;
+    }
+    *out = v8::Array::New(isolate_, elements.data(), elements.size());
+    return true;
+  }
+
+  bool ReadObject(v8::Local<v8::Value>* out) {
+    uint32_t length;
+    if (!AddObject() || !ReadVarint(&length) ||
+        length > data_.size() - position_)
+      return false;
+    v8::Local<v8::Context> context = isolate_->GetCurrentContext();
+    v8::Local<v8::Object> object = v8::Object::New(isolate_);
+    for (uint32_t i = 0; i < length; ++i) {
+      uint8_t tag;
+      v8::Local<v8::Value> key;
+      v8::Local<v8::Value> property;
+      if (!ReadByte(&tag) ||
+          (tag != kPlainOneByteString && tag != kPlainTwoByteString) ||
+          !ReadString(tag, &key) || !ReadValue(&property) ||
+          !object->CreateDataProperty(context, key.As<v8::String>(), property)
+               .FromMaybe(false))
+        return false;
+    }
+    *out = object;
+    return true;
+  }
+
+  // Fails for more objects than any writer produces, before the recursion
+  // into nested ones can run out of stack.
+  bool AddObject() { return ++num_objects_ <= kMaxPlainDataObjects; }
+
+  bool ReadByte(uint8_t* out) {
+    if (position_ >= data_.size())
+      return false;
+    *out = data_[position_++];
+    return true;
+  }
+
+  bool ReadVarint(uint32_t* out) {
+    uint32_t value = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+      uint8_t byte;
+      if (!ReadByte(&byte))
+        return false;
+      value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+      if (!(byte & 0x80)) {
+        *out = value;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  template <typename T>
+  bool ReadRaw(T* out) {
+    if (sizeof(T) > data_.size() - position_)
+      return false;
+    memcpy(out, data_.data() + position_, sizeof(T));
+    position_ += sizeof(T);
+    return true;
+  }
+
+  raw_ptr<v8::Isolate> isolate_;
+  base::span<const uint8_t> data_;
+  size_t position_ = 0;
+  size_t num_objects_ = 0;
+};
+
 }  // namespace
 
 class V8Serializer : public v8::ValueSerializer::Delegate {
@@ -34,6 +568,15 @@ class V8Serializer : public v8::ValueSerializer::Delegate {
   ~V8Serializer() override = default;
 
   bool Serialize(v8::Local<v8::Value> value, blink::CloneableMessage* out) {
+    base::span<const uint8_t> data;
+    if (!Serialize(value, &data))
+      return false;
+    SetEncodedMessage(data, out);
+    return true;
+  }
+
+  // On success |out| points into this serializer's buffer.
+  bool Serialize(v8::Local<v8::Value> value, base::span<const uint8_t>* out) {
     gin_helper::MicrotasksScope microtasks_scope(
         isolate_, isolate_->GetCurrentContext()->GetMicrotaskQueue(),
         v8::MicrotasksScope::kDoNotRunMicrotasks);
@@ -50,28 +593,78 @@ class V8Serializer : public v8::ValueSerializer::Delegate {
     DCHECK(wrote_value);
 
     std::pair<uint8_t*, size_t> buffer = serializer_.Release();
-    DCHECK_EQ(buffer.first, data_.data());
-    out->encoded_message = base::make_span(buffer.first, buffer.second);
-    out->owned_encoded_message = std::move(data_);
-    out->sender_agent_cluster_id =
-        blink::WebMessagePort::GetEmbedderAgentClusterID();
+    DCHECK_EQ(buffer.first, data_->data());
+    *out = base::make_span(buffer.first, buffer.second);
+    return true;
+  }
 
+  // Makes |array_buffers| be moved out of band instead of being cloned into
+  // the message, with transfer ids matching their index. Must be called before
+  // Serialize().
+  bool TransferArrayBuffers(
+      const std::vector<v8::Local<v8::ArrayBuffer>>& array_buffers) {
+    for (size_t i = 0; i < array_buffers.size(); ++i) {
+      v8::Local<v8::ArrayBuffer> array_buffer = array_buffers[i];
+      if (array_buffer->WasDetached() || !array_buffer->IsDetachable()) {
+        isolate_->ThrowException(v8::Exception::Error(gin::StringToV8(
+            isolate_, "An ArrayBuffer could not be transferred.")));
+        return false;
+      }
+      if (std::find(array_buffers.begin(), array_buffers.begin() + i,
+                    array_buffer) != array_buffers.begin() + i) {
+        isolate_->ThrowException(v8::Exception::Error(gin::StringToV8(
+            isolate_, "An ArrayBuffer is listed more than once in transfer.")));
+        return false;
+      }
+      serializer_.TransferArrayBuffer(i, array_buffer);
+    }
     return true;
   }
 
+  // Makes SharedArrayBuffers created by CreateSharedMemoryArrayBuffer() be
+  // shared instead of failing to serialize, with their regions added to
+  // |regions| in the order of their ids. Must be called before Serialize().
+  void ShareSharedArrayBuffers(
+      std::vector<base::UnsafeSharedMemoryRegion>* regions) {
+    shared_regions_ = regions;
+  }
+
   // v8::ValueSerializer::Delegate
+  v8::Maybe<uint32_t> GetSharedArrayBufferId(
+      v8::Isolate* isolate,
+      v8::Local<v8::SharedArrayBuffer> shared_array_buffer) override {
+    if (!shared_regions_) {
+      return v8::ValueSerializer::Delegate::GetSharedArrayBufferId(
+          isolate, shared_array_buffer);
+    }
+    base::UnsafeSharedMemoryRegion region =
+        GetSharedMemoryRegion(shared_array_buffer);
+    if (region.IsValid()) {
+      shared_regions_->push_back(std::move(region));
+      return v8::Just<uint32_t>(shared_regions_->size() - 1);
+    }
+    isolate_->ThrowException(v8::Exception::Error(gin::StringToV8(
+        isolate_,
+        "A SharedArrayBuffer can only be sent to another process when it was "
+        "created by process.createSharedArrayBuffer().")));
+    return v8::Nothing<uint32_t>();
+  }
+
   void* ReallocateBufferMemory(void* old_buffer,
                                size_t size,
                                size_t* actual_size) override {
-    DCHECK_EQ(old_buffer, data_.data());
-    data_.resize(size);
-    *actual_size = data_.capacity();
-    return data_.data();
+    // A pooled buffer that is still empty can already have storage.
+    DCHECK(!old_buffer || old_buffer == data_->data());
+    // Only the bytes within size() are kept by a later resize(), so V8 must
+    // not be told about the rest of the capacity.
+    data_->resize(size);
+    *actual_size = size;
+    return data_->data();
   }
 
   void FreeBufferMemory(void* buffer) override {
-    DCHECK_EQ(buffer, data_.data());
-    data_ = {};
+    DCHECK_EQ(buffer, data_->data());
+    data_->clear();
   }
 
   v8::Maybe<bool> WriteHostObject(v8::Isolate* isolate,
@@ -112,15 +705,20 @@ class V8Serializer : public v8::ValueSerializer::Delegate {
   }
 
   raw_ptr<v8::Isolate> isolate_;
-  std::vector<uint8_t> data_;
+  raw_ptr<std::vector<base::UnsafeSharedMemoryRegion>> shared_regions_ =
+      nullptr;
+  PooledBuffer data_;
   v8::ValueSerializer serializer_;
 };
 
 class V8Deserializer : public v8::ValueDeserializer::Delegate {
  public:
-  V8Deserializer(v8::Isolate* isolate, base::span<const uint8_t> data)
+  V8Deserializer(v8::Isolate* isolate,
+                 base::span<const uint8_t> data,
+                 base::span<const mojo_base::BigBuffer> array_buffers = {})
       : isolate_(isolate),
-        deserializer_(isolate, data.data(), data.size(), this) {}
+        deserializer_(isolate, data.data(), data.size(), this),
+        array_buffers_(array_buffers) {}
   V8Deserializer(v8::Isolate* isolate, const blink::CloneableMessage& message)
       : V8Deserializer(isolate, message.encoded_message) {}
 
@@ -136,12 +734,45 @@ class V8Deserializer : public v8::ValueDeserializer::Delegate {
     if (!deserializer_.ReadHeader(context).To(&read_header))
       return v8::Null(isolate_);
     DCHECK(read_header);
+    for (size_t i = 0; i < array_buffers_.size(); ++i) {
+      const mojo_base::BigBuffer& contents = array_buffers_[i];
+      v8::Local<v8::ArrayBuffer> array_buffer =
+          v8::ArrayBuffer::New(isolate_, contents.size());
+      base::ranges::copy(contents, static_cast<uint8_t*>(array_buffer->Data()));
+      deserializer_.TransferArrayBuffer(i, array_buffer);
+    }
     v8::Local<v8::Value> value;
     if (!deserializer_.ReadValue(context).ToLocal(&value))
       return v8::Null(isolate_);
     return scope.Escape(value);
   }
 
+  // Maps the SharedArrayBuffers shared by the sender, reading their regions
+  // from |port| once the first is read. Must be called before Deserialize().
+  void MapSharedArrayBuffers(blink::MessagePortDescriptor port) {
+    regions_port_ = std::move(port);
+  }
+
+  // v8::ValueDeserializer::Delegate
+  v8::MaybeLocal<v8::SharedArrayBuffer> GetSharedArrayBufferFromId(
+      v8::Isolate* isolate,
+      uint32_t clone_id) override {
+    if (regions_port_.IsValid() && !shared_regions_) {
+      shared_regions_.emplace();
+      ReadSharedArrayBufferRegions(std::move(regions_port_),
+                                   &*shared_regions_);
+    }
+    if (shared_regions_ && clone_id < shared_regions_->size()) {
+      v8::Local<v8::SharedArrayBuffer> shared_array_buffer;
+      if (MapSharedMemoryArrayBuffer(isolate,
+                                     (*shared_regions_)[clone_id].Duplicate())
+              .ToLocal(&shared_array_buffer))
+        return shared_array_buffer;
+    }
+    return v8::ValueDeserializer::Delegate::GetSharedArrayBufferFromId(
+        isolate, clone_id);
+  }
+
   v8::MaybeLocal<v8::Object> ReadHostObject(v8::Isolate* isolate) override {
     uint8_t tag = 0;
     if (!ReadTag(&tag))
@@ -220,6 +851,9 @@ class V8Deserializer : public v8::ValueDeserializer::Delegate {
 
   raw_ptr<v8::Isolate> isolate_;
   v8::ValueDeserializer deserializer_;
+  base::span<const mojo_base::BigBuffer> array_buffers_;
+  blink::MessagePortDescriptor regions_port_;
+  std::optional<std::vector<base::UnsafeSharedMemoryRegion>> shared_regions_;
 };
 
 bool SerializeV8Value(v8::Isolate* isolate,
@@ -233,9 +867,162 @@ v8::Local<v8::Value> DeserializeV8Value(v8::Isolate* isolate,
   return V8Deserializer(isolate, in).Deserialize();
 }
 
+bool SerializeV8Value(v8::Isolate* isolate,
+                      v8::Local<v8::Value> value,
+                      blink::TransferableMessage* out) {
+  std::vector<base::UnsafeSharedMemoryRegion> shared_regions;
+  V8Serializer serializer(isolate);
+  serializer.ShareSharedArrayBuffers(&shared_regions);
+  base::span<const uint8_t> data;
+  if (!serializer.Serialize(value, &data))
+    return false;
+  if (shared_regions.empty()) {
+    SetEncodedMessage(data, out);
+    return true;
+  }
+  // The tag marks the last port as the one carrying the regions, so that
+  // the receiver never takes a port of the sender's for it.
+  SetEncodedMessage(data, out, kSharedArrayBufferRegionsTag);
+  AttachSharedArrayBufferRegions(std::move(shared_regions), &out->ports);
+  return true;
+}
+
+v8::Local<v8::Value> DeserializeV8Value(v8::Isolate* isolate,
+                                        blink::TransferableMessage* in) {
+  base::span<const uint8_t> data = in->encoded_message;
+  blink::MessagePortDescriptor regions_port;
+  if (!data.empty() && data[0] == kSharedArrayBufferRegionsTag) {
+    if (in->ports.empty())
+      return v8::Null(isolate);
+    data = data.subspan(1);
+    regions_port = std::move(in->ports.back());
+    in->ports.pop_back();
+  }
+  V8Deserializer deserializer(isolate, data);
+  // Messages from blink lock SharedArrayBuffers to the sender's process.
+  if (regions_port.IsValid() && !in->locked_to_sender_agent_cluster)
+    deserializer.MapSharedArrayBuffers(std::move(regions_port));
+  return deserializer.Deserialize();
+}
+
 v8::Local<v8::Value> DeserializeV8Value(v8::Isolate* isolate,
                                         base::span<const uint8_t> data) {
   return V8Deserializer(isolate, data).Deserialize();
 }
 
+SharedArrayBufferRegionsWaiter::SharedArrayBufferRegionsWaiter()
+    : watcher_(FROM_HERE,
+               mojo::SimpleWatcher::ArmingPolicy::MANUAL,
+               base::SequencedTaskRunner::GetCurrentDefault()) {}
+
+SharedArrayBufferRegionsWaiter::~SharedArrayBufferRegionsWaiter() {
+  Cancel();
+}
+
+bool SharedArrayBufferRegionsWaiter::Wait(blink::TransferableMessage& message,
+                                          Callback callback) {
+  DCHECK(!IsWaiting());
+  base::span<const uint8_t> data = message.encoded_message;
+  if (data.empty() || data[0] != kSharedArrayBufferRegionsTag ||
+      message.ports.empty())
+    return false;
+
+  // The regions are written before the port is sent, but can arrive after it
+  // when the port has to be proxied through another process.
+  handle_ = message.ports.back().TakeHandleToEntangleWithEmbedder();
+  const mojo::HandleSignalsState state = handle_->QuerySignalsState();
+  if (state.readable() || state.peer_closed()) {
+    message.ports.back().GiveDisentangledHandle(std::move(handle_));
+    return false;
+  }
+
+  message_ = std::move(message);
+  callback_ = std::move(callback);
+  watcher_.Watch(handle_.get(),
+                 MOJO_HANDLE_SIGNAL_READABLE | MOJO_HANDLE_SIGNAL_PEER_CLOSED,
+                 MOJO_WATCH_CONDITION_SATISFIED,
+                 base::BindRepeating(&SharedArrayBufferRegionsWaiter::OnReady,
+                                     base::Unretained(this)));
+  watcher_.ArmOrNotify();
+  return true;
+}
+
+void SharedArrayBufferRegionsWaiter::Cancel() {
+  if (!IsWaiting())
+    return;
+  watcher_.Cancel();
+  message_->ports.back().GiveDisentangledHandle(std::move(handle_));
+  message_.reset();
+  callback_.Reset();
+}
+
+void SharedArrayBufferRegionsWaiter::OnReady(MojoResult result) {
+  watcher_.Cancel();
+  blink::TransferableMessage message = std::move(*message_);
+  message_.reset();
+  // Whether or not the regions have arrived, nothing more can be waited for:
+  // the SharedArrayBuffers fail to deserialize when they haven't.
+  message.ports.back().GiveDisentangledHandle(std::move(handle_));
+  std::move(callback_).Run(std::move(message));
+}
+
+#if DCHECK_IS_ON()
+void SetSharedArrayBufferRegionsDelayForTesting(base::TimeDelta delay) {
+  g_regions_delay_for_testing = delay;
+}
+#endif
+
+mojom::SerializedArgumentsPtr SerializeV8ValueForIPC(
+    v8::Isolate* isolate,
+    v8::Local<v8::Value> value) {
+  return SerializeV8ValueForIPC(isolate, value, {});
+}
+
+mojom::SerializedArgumentsPtr SerializeV8ValueForIPC(
+    v8::Isolate* isolate,
+    v8::Local<v8::Value> value,
+    const std::vector<v8::Local<v8::ArrayBuffer>>& transfer) {
+  base::span<const uint8_t> data;
+  std::optional<PlainDataWriter> writer;
+  std::optional<V8Serializer> serializer;
+  if (transfer.empty())
+    writer.emplace(isolate);
+  if (!writer || !writer->Write(value, &data)) {
+    serializer.emplace(isolate);
+    if (!serializer->TransferArrayBuffers(transfer) ||
+        !serializer->Serialize(value, &data))
+      return nullptr;
+  }
+
+  auto arguments = mojom::SerializedArguments::New();
+  // The contents are copied once, straight into the outgoing buffer, rather
+  // than into the message and then out of it again on the receiving side.
+  for (v8::Local<v8::ArrayBuffer> array_buffer : transfer) {
+    arguments->array_buffers.emplace_back(
+        base::make_span(static_cast<const uint8_t*>(array_buffer->Data()),
+                        array_buffer->ByteLength()));
+    if (array_buffer->Detach(v8::Local<v8::Value>()).IsNothing())
+      return nullptr;
+  }
+
+  SetEncodedMessage(data, &arguments->value);
+  arguments->send_time = base::TimeTicks::Now();
+  return arguments;
+}
+
+size_t GetSerializedSize(const mojom::SerializedArguments& in) {
+  size_t size = in.value.encoded_message.size();
+  for (const auto& array_buffer : in.array_buffers)
+    size += array_buffer.size();
+  return size;
+}
+
+v8::Local<v8::Value> DeserializeV8Value(v8::Isolate* isolate,
+                                        const mojom::SerializedArguments& in) {
+  base::span<const uint8_t> data = in.value.encoded_message;
+  if (!data.empty() && data[0] == kPlainDataTag)
+    return PlainDataReader(isolate, data).Read();
+  return V8Deserializer(isolate, data, in.array_buffers).Deserialize();
+}
+
 }  // namespace electron
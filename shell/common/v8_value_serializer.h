@@ -5,20 +5,27 @@
 #ifndef ELECTRON_SHELL_COMMON_V8_VALUE_SERIALIZER_H_
 #define ELECTRON_SHELL_COMMON_V8_VALUE_SERIALIZER_H_
 
+#include <optional>
+#include <vector>
+
 #include "base/containers/span.h"
+#include "base/dcheck_is_on.h"
+#include "base/functional/callback.h"
+#include "base/time/time.h"
+#include "mojo/public/cpp/system/message_pipe.h"
+#include "mojo/public/cpp/system/simple_watcher.h"
+#include "shell/common/api/api.mojom-forward.h"
+#include "third_party/blink/public/common/messaging/transferable_message.h"
 #include "ui/gfx/image/image_skia_rep.h"
 
 namespace v8 {
+class ArrayBuffer;
 class Isolate;
 template <class T>
 class Local;
 class Value;
 }  // namespace v8
 
-namespace blink {
-struct CloneableMessage;
-}
-
 namespace electron {
 
 bool SerializeV8Value(v8::Isolate* isolate,
@@ -29,6 +36,81 @@ v8::Local<v8::Value> DeserializeV8Value(v8::Isolate* isolate,
 v8::Local<v8::Value> DeserializeV8Value(v8::Isolate* isolate,
                                         base::span<const uint8_t> data);
 
+// Serializes |value| to be posted to a MessagePort. Unlike the above, the
+// SharedArrayBuffers created by CreateSharedMemoryArrayBuffer() are shared
+// with the receiver rather than failing to serialize, over a port that is
+// added after the ones already in |out|, so it has to be used for messages
+// between the main process and utility processes only.
+bool SerializeV8Value(v8::Isolate* isolate,
+                      v8::Local<v8::Value> value,
+                      blink::TransferableMessage* out);
+// Deserializes a message serialized as above, taking the port that carries
+// its SharedArrayBuffers out of |in| when the message is marked as having
+// one. The regions are never waited for: the SharedArrayBuffers fail to
+// deserialize when they haven't arrived, so receivers hold such messages back
+// with SharedArrayBufferRegionsWaiter first.
+v8::Local<v8::Value> DeserializeV8Value(v8::Isolate* isolate,
+                                        blink::TransferableMessage* in);
+
+// Holds back a message serialized as above until the regions of its
+// SharedArrayBuffers have arrived, which can be after the message when its
+// ports are proxied through another process. Receivers pause their connector
+// while a message is held back, so that later messages stay in order.
+class SharedArrayBufferRegionsWaiter {
+ public:
+  using Callback = base::OnceCallback<void(blink::TransferableMessage)>;
+
+  SharedArrayBufferRegionsWaiter();
+  ~SharedArrayBufferRegionsWaiter();
+
+  // disable copy
+  SharedArrayBufferRegionsWaiter(const SharedArrayBufferRegionsWaiter&) =
+      delete;
+  SharedArrayBufferRegionsWaiter& operator=(
+      const SharedArrayBufferRegionsWaiter&) = delete;
+
+  // Returns false when |message| can be deserialized right away. Otherwise
+  // takes |message| and returns true, running |callback| with it once its
+  // regions have arrived or the sender has closed their port without them.
+  bool Wait(blink::TransferableMessage& message, Callback callback);
+  bool IsWaiting() const { return message_.has_value(); }
+  // Drops the message held back, if any, without running the callback.
+  void Cancel();
+
+ private:
+  void OnReady(MojoResult result);
+
+  mojo::SimpleWatcher watcher_;
+  // The handle of the port carrying the regions, while it is watched.
+  mojo::ScopedMessagePipeHandle handle_;
+  std::optional<blink::TransferableMessage> message_;
+  Callback callback_;
+};
+
+#if DCHECK_IS_ON()
+// Makes the SharedArrayBuffer regions of the messages serialized on this
+// process be sent |delay| after the message, or never for
+// base::TimeDelta::Max(), so that tests can cover the receiver waiting for
+// them.
+void SetSharedArrayBufferRegionsDelayForTesting(base::TimeDelta delay);
+#endif
+
+// Serializes |value| as the arguments of an IPC message.
+// Returns null, with an exception thrown, if |value| could not be serialized.
+mojom::SerializedArgumentsPtr SerializeV8ValueForIPC(
+    v8::Isolate* isolate,
+    v8::Local<v8::Value> value);
+// As above, but moves the contents of the ArrayBuffers in |transfer| instead
+// of cloning them, detaching them from the sender as postMessage() does.
+mojom::SerializedArgumentsPtr SerializeV8ValueForIPC(
+    v8::Isolate* isolate,
+    v8::Local<v8::Value> value,
+    const std::vector<v8::Local<v8::ArrayBuffer>>& transfer);
+v8::Local<v8::Value> DeserializeV8Value(v8::Isolate* isolate,
+                                        const mojom::SerializedArguments& in);
+// The number of bytes |in| takes up, including transferred ArrayBuffers.
+size_t GetSerializedSize(const mojom::SerializedArguments& in);
+
 }  // namespace electron
 
 #endif  // ELECTRON_SHELL_COMMON_V8_VALUE_SERIALIZER_H_
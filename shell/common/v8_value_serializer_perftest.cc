@@ -0,0 +1,140 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include <string>
+
+#include "base/strings/stringprintf.h"
+#include "base/timer/lap_timer.h"
+#include "base/values.h"
+#include "gin/converter.h"
+#include "gin/public/isolate_holder.h"
+#include "gin/test/v8_test.h"
+#include "shell/common/api/api.mojom.h"
+#include "shell/common/gin_converters/value_converter.h"
+#include "shell/common/v8_value_serializer.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+#include "third_party/blink/public/common/messaging/cloneable_message.h"
+#include "v8/include/v8.h"
+
+namespace electron {
+
+namespace {
+
+constexpr char kMetricPrefix[] = "V8Value.";
+constexpr char kMetricRunsPerSecond[] = "runs_per_second";
+
+// An object shaped like the IPC payloads and API options apps pass around:
+// a list of records with a few strings, numbers and a nested object each.
+std::string MakePayloadJson(int records) {
+  std::string json = "[";
+  for (int i = 0; i < records; ++i) {
+    if (i > 0)
+      json += ",";
+    base::StringAppendF(
+        &json,
+        R"({"id":%d,"name":"record %d","enabled":true,"score":%d.5,)"
+        R"("bounds":{"x":%d,"y":%d,"width":800,"height":600},)"
+        R"("tags":["alpha","beta","gamma"]})",
+        i, i, i, i, i);
+  }
+  return json + "]";
+}
+
+class V8ValuePerfTest : public gin::V8Test {
+ protected:
+  v8::Local<v8::Value> MakePayload(int records) {
+    v8::Isolate* isolate = instance_->isolate();
+    return v8::JSON::Parse(isolate->GetCurrentContext(),
+                           gin::StringToV8(isolate, MakePayloadJson(records)))
+        .ToLocalChecked();
+  }
+
+  void Report(const std::string& story, base::LapTimer& timer) {
+    perf_test::PerfResultReporter reporter(kMetricPrefix, story);
+    reporter.RegisterImportantMetric(kMetricRunsPerSecond, "runs/s");
+    reporter.AddResult(kMetricRunsPerSecond, timer.LapsPerSecond());
+  }
+};
+
+}  // namespace
+
+TEST_F(V8ValuePerfTest, Serialize) {
+  v8::Isolate* isolate = instance_->isolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::Value> payload = MakePayload(100);
+
+  base::LapTimer timer;
+  do {
+    blink::CloneableMessage message;
+    ASSERT_TRUE(SerializeV8Value(isolate, payload, &message));
+    timer.NextLap();
+  } while (!timer.HasTimeLimitExpired());
+  Report("serialize", timer);
+}
+
+TEST_F(V8ValuePerfTest, Deserialize) {
+  v8::Isolate* isolate = instance_->isolate();
+  v8::HandleScope handle_scope(isolate);
+  blink::CloneableMessage message;
+  ASSERT_TRUE(SerializeV8Value(isolate, MakePayload(100), &message));
+
+  base::LapTimer timer;
+  do {
+    v8::HandleScope lap_scope(isolate);
+    ASSERT_FALSE(DeserializeV8Value(isolate, message).IsEmpty());
+    timer.NextLap();
+  } while (!timer.HasTimeLimitExpired());
+  Report("deserialize", timer);
+}
+
+// IPC arguments above the inline limit of mojo, which go through shared
+// memory as a BigBuffer.
+TEST_F(V8ValuePerfTest, RoundTripLargeForIPC) {
+  v8::Isolate* isolate = instance_->isolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::Value> payload = MakePayload(10000);
+
+  base::LapTimer timer;
+  do {
+    v8::HandleScope lap_scope(isolate);
+    mojom::SerializedArgumentsPtr arguments =
+        SerializeV8ValueForIPC(isolate, payload);
+    ASSERT_TRUE(arguments);
+    ASSERT_FALSE(DeserializeV8Value(isolate, *arguments).IsEmpty());
+    timer.NextLap();
+  } while (!timer.HasTimeLimitExpired());
+  Report("round_trip_large_for_ipc", timer);
+}
+
+TEST_F(V8ValuePerfTest, ConvertToBaseValue) {
+  v8::Isolate* isolate = instance_->isolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::Value> payload = MakePayload(100);
+
+  base::LapTimer timer;
+  do {
+    base::Value value;
+    ASSERT_TRUE(gin::ConvertFromV8(isolate, payload, &value));
+    timer.NextLap();
+  } while (!timer.HasTimeLimitExpired());
+  Report("convert_to_base_value", timer);
+}
+
+TEST_F(V8ValuePerfTest, ConvertFromBaseValue) {
+  v8::Isolate* isolate = instance_->isolate();
+  v8::HandleScope handle_scope(isolate);
+  base::Value value;
+  ASSERT_TRUE(gin::ConvertFromV8(isolate, MakePayload(100), &value));
+
+  base::LapTimer timer;
+  do {
+    v8::HandleScope lap_scope(isolate);
+    ASSERT_FALSE(gin::ConvertToV8(isolate, value).IsEmpty());
+    timer.NextLap();
+  } while (!timer.HasTimeLimitExpired());
+  Report("convert_from_base_value", timer);
+}
+
+}  // namespace electron
@@ -4,44 +4,83 @@
 
 #include "shell/renderer/api/context_bridge/object_cache.h"
 
+#include <algorithm>
+#include <bit>
+
 #include "shell/common/api/object_life_monitor.h"
 
 namespace electron::api::context_bridge {
 
+namespace {
+
+constexpr size_t kMinCapacity = 16;
+
+// The table is grown before it gets more than half full, which keeps probe
+// sequences short.
+size_t CapacityFor(size_t size) {
+  return std::max(kMinCapacity, std::bit_ceil(size * 2));
+}
+
+}  // namespace
+
 ObjectCache::ObjectCache() = default;
 ObjectCache::~ObjectCache() = default;
 
+void ObjectCache::Reserve(size_t count) {
+  const size_t capacity = CapacityFor(size_ + count);
+  if (capacity > entries_.size())
+    Rehash(capacity);
+}
+
 void ObjectCache::CacheProxiedObject(v8::Local<v8::Value> from,
                                      v8::Local<v8::Value> proxy_value) {
   if (from->IsObject() && !from->IsNullOrUndefined()) {
     auto obj = from.As<v8::Object>();
     int hash = obj->GetIdentityHash();
 
-    proxy_map_[hash].emplace_front(from, proxy_value);
+    if ((size_ + 1) * 2 > entries_.size())
+      Rehash(CapacityFor(size_ + 1));
+    Entry& entry = entries_[FindSlot(hash, from)];
+    if (entry.pair.first.IsEmpty()) {
+      entry.hash = hash;
+      entry.pair.first = from;
+      ++size_;
+    }
+    entry.pair.second = proxy_value;
   }
 }
 
 v8::MaybeLocal<v8::Value> ObjectCache::GetCachedProxiedObject(
     v8::Local<v8::Value> from) const {
-  if (!from->IsObject() || from->IsNullOrUndefined())
+  if (!from->IsObject() || from->IsNullOrUndefined() || entries_.empty())
     return v8::MaybeLocal<v8::Value>();
 
   auto obj = from.As<v8::Object>();
   int hash = obj->GetIdentityHash();
-  auto iter = proxy_map_.find(hash);
-  if (iter == proxy_map_.end())
+  const Entry& entry = entries_[FindSlot(hash, from)];
+  if (entry.pair.first.IsEmpty() || entry.pair.second.IsEmpty())
     return v8::MaybeLocal<v8::Value>();
+  return entry.pair.second;
+}
 
-  auto& list = iter->second;
-  for (const auto& pair : list) {
-    auto from_cmp = pair.first;
-    if (from_cmp == from) {
-      if (pair.second.IsEmpty())
-        return v8::MaybeLocal<v8::Value>();
-      return pair.second;
-    }
+size_t ObjectCache::FindSlot(int hash, v8::Local<v8::Value> from) const {
+  const size_t mask = entries_.size() - 1;
+  for (size_t i = static_cast<size_t>(hash) & mask;; i = (i + 1) & mask) {
+    const Entry& entry = entries_[i];
+    // Comparing hashes first avoids dereferencing handles on most collisions.
+    if (entry.pair.first.IsEmpty() ||
+        (entry.hash == hash && entry.pair.first == from))
+      return i;
+  }
+}
+
+void ObjectCache::Rehash(size_t capacity) {
+  std::vector<Entry> entries(capacity);
+  std::swap(entries_, entries);
+  for (Entry& entry : entries) {
+    if (!entry.pair.first.IsEmpty())
+      entries_[FindSlot(entry.hash, entry.pair.first)] = std::move(entry);
   }
-  return v8::MaybeLocal<v8::Value>();
 }
 
 }  // namespace electron::api::context_bridge
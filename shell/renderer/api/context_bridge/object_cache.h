@@ -5,9 +5,8 @@
 #ifndef ELECTRON_SHELL_RENDERER_API_CONTEXT_BRIDGE_OBJECT_CACHE_H_
 #define ELECTRON_SHELL_RENDERER_API_CONTEXT_BRIDGE_OBJECT_CACHE_H_
 
-#include <forward_list>
-#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "base/containers/linked_list.h"
 #include "content/public/renderer/render_frame.h"
@@ -24,14 +23,29 @@ class ObjectCache final {
   ObjectCache();
   ~ObjectCache();
 
+  // Makes room for |count| more objects without growing the table.
+  void Reserve(size_t count);
+
   void CacheProxiedObject(v8::Local<v8::Value> from,
                           v8::Local<v8::Value> proxy_value);
   v8::MaybeLocal<v8::Value> GetCachedProxiedObject(
       v8::Local<v8::Value> from) const;
 
  private:
-  // object_identity ==> [from_value, proxy_value]
-  std::unordered_map<int, std::forward_list<ObjectCachePair>> proxy_map_;
+  struct Entry {
+    int hash = 0;
+    ObjectCachePair pair;
+  };
+
+  // Returns the slot that holds |from|, or the empty one it would go in.
+  size_t FindSlot(int hash, v8::Local<v8::Value> from) const;
+  void Rehash(size_t capacity);
+
+  // An open addressing table with linear probing, keyed by object identity
+  // hash, whose capacity is zero or a power of two. Empty slots have an
+  // empty |pair.first|.
+  std::vector<Entry> entries_;
+  size_t size_ = 0;
 };
 
 }  // namespace electron::api::context_bridge
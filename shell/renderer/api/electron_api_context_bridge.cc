@@ -4,6 +4,7 @@
 
 #include "shell/renderer/api/electron_api_context_bridge.h"
 
+#include <cstring>
 #include <memory>
 #include <set>
 #include <string>
@@ -17,6 +18,8 @@
 #include "base/trace_event/trace_event.h"
 #include "content/public/renderer/render_frame.h"
 #include "content/public/renderer/render_frame_observer.h"
+#include "gin/per_isolate_data.h"
+#include "gin/public/wrapper_info.h"
 #include "shell/common/api/object_life_monitor.h"
 #include "shell/common/gin_converters/blink_converter.h"
 #include "shell/common/gin_converters/callback_converter.h"
@@ -42,11 +45,6 @@ namespace api {
 
 namespace context_bridge {
 
-const char kProxyFunctionPrivateKey[] = "electron_contextBridge_proxy_fn";
-const char kProxyFunctionReceiverPrivateKey[] =
-    "electron_contextBridge_proxy_fn_receiver";
-const char kSupportsDynamicPropertiesPrivateKey[] =
-    "electron_contextBridge_supportsDynamicProperties";
 const char kOriginalFunctionPrivateKey[] = "electron_contextBridge_original_fn";
 
 }  // namespace context_bridge
@@ -55,6 +53,47 @@ namespace {
 
 static int kMaxRecursion = 1000;
 
+// The internal fields of the data object of a proxy function, which is only
+// reachable from native code. Reading them is much cheaper than looking up
+// private properties on every call.
+enum ProxyFunctionField {
+  kProxyFunctionField,
+  kProxyFunctionReceiverField,
+  kSupportsDynamicPropertiesField,
+  kProxyFunctionFieldCount,
+};
+
+gin::WrapperInfo kProxyFunctionStateInfo = {gin::kEmbedderNativeGin};
+
+v8::Local<v8::Object> CreateProxyFunctionState(
+    v8::Local<v8::Context> context,
+    v8::Local<v8::Function> func,
+    v8::Local<v8::Value> receiver,
+    bool support_dynamic_properties) {
+  v8::Isolate* isolate = context->GetIsolate();
+  gin::PerIsolateData* data = gin::PerIsolateData::From(isolate);
+  v8::Local<v8::ObjectTemplate> templ =
+      data->GetObjectTemplate(&kProxyFunctionStateInfo);
+  if (templ.IsEmpty()) {
+    templ = v8::ObjectTemplate::New(isolate);
+    templ->SetInternalFieldCount(kProxyFunctionFieldCount);
+    data->SetObjectTemplate(&kProxyFunctionStateInfo, templ);
+  }
+  v8::Local<v8::Object> state = templ->NewInstance(context).ToLocalChecked();
+  state->SetInternalField(kProxyFunctionField, func);
+  state->SetInternalField(kProxyFunctionReceiverField, receiver);
+  state->SetInternalField(
+      kSupportsDynamicPropertiesField,
+      v8::Boolean::New(isolate, support_dynamic_properties));
+  return state;
+}
+
+// Whether |value| can be used as it is in any context.
+inline bool IsPrimitive(v8::Local<v8::Value> value) {
+  return value->IsString() || value->IsNumber() || value->IsNullOrUndefined() ||
+         value->IsBoolean() || value->IsSymbol() || value->IsBigInt();
+}
+
 // Returns true if |maybe| is both a value, and that value is true.
 inline bool IsTrue(v8::Maybe<bool> maybe) {
   return maybe.IsJust() && maybe.FromJust();
@@ -111,6 +150,101 @@ bool IsPlainArray(const v8::Local<v8::Value>& arr) {
   return !arr->IsTypedArray();
 }
 
+// Copies an ArrayBuffer, or a typed array or DataView together with its whole
+// buffer, straight into |destination_context|. That gives the same result as
+// structured clone without writing the contents into a message and reading
+// them back out. Returns false for anything it does not handle, including
+// shared, detached and resizable buffers, which are left to structured clone.
+bool CloneArrayBufferOrView(v8::Local<v8::Context> destination_context,
+                            v8::Local<v8::Value> value,
+                            v8::Local<v8::Value>* out) {
+  v8::Local<v8::Value> source;
+  if (value->IsArrayBuffer())
+    source = value;
+  else if (value->IsArrayBufferView())
+    source = value.As<v8::ArrayBufferView>()->Buffer();
+  else
+    return false;
+  if (!source->IsArrayBuffer())
+    return false;
+  v8::Local<v8::ArrayBuffer> source_buffer = source.As<v8::ArrayBuffer>();
+  if (source_buffer->WasDetached() ||
+      source_buffer->IsResizableByUserJavaScript())
+    return false;
+
+  v8::Isolate* isolate = destination_context->GetIsolate();
+  v8::Context::Scope destination_context_scope(destination_context);
+  const size_t byte_length = source_buffer->ByteLength();
+  v8::Local<v8::ArrayBuffer> buffer =
+      v8::ArrayBuffer::New(isolate, byte_length);
+  if (byte_length)
+    memcpy(buffer->Data(), source_buffer->Data(), byte_length);
+  if (value->IsArrayBuffer()) {
+    *out = buffer;
+    return true;
+  }
+
+  auto view = value.As<v8::ArrayBufferView>();
+  const size_t offset = view->ByteOffset();
+  if (value->IsDataView()) {
+    *out = v8::DataView::New(buffer, offset, view->ByteLength());
+    return true;
+  }
+  const size_t length = value.As<v8::TypedArray>()->Length();
+#define CLONE_TYPED_ARRAY(Type)                   \
+  if (value->Is##Type()) {                        \
+    *out = v8::Type::New(buffer, offset, length); \
+    return true;                                  \
+  }
+  CLONE_TYPED_ARRAY(Uint8Array)
+  CLONE_TYPED_ARRAY(Uint8ClampedArray)
+  CLONE_TYPED_ARRAY(Int8Array)
+  CLONE_TYPED_ARRAY(Uint16Array)
+  CLONE_TYPED_ARRAY(Int16Array)
+  CLONE_TYPED_ARRAY(Uint32Array)
+  CLONE_TYPED_ARRAY(Int32Array)
+  CLONE_TYPED_ARRAY(Float32Array)
+  CLONE_TYPED_ARRAY(Float64Array)
+  CLONE_TYPED_ARRAY(BigInt64Array)
+  CLONE_TYPED_ARRAY(BigUint64Array)
+#undef CLONE_TYPED_ARRAY
+  return false;
+}
+
+v8::Array::CallbackResult CollectNumber(uint32_t index,
+                                        v8::Local<v8::Value> element,
+                                        void* data) {
+  if (!element->IsNumber())
+    return v8::Array::CallbackResult::kBreak;
+  static_cast<std::vector<double>*>(data)->push_back(
+      element.As<v8::Number>()->Value());
+  return v8::Array::CallbackResult::kContinue;
+}
+
+// Copies an array made only of numbers into |destination_context| with one
+// pass over its elements, rather than passing each element over the bridge
+// with its own property lookups. Returns false if |arr| holds anything else.
+bool CloneNumberArray(v8::Local<v8::Context> source_context,
+                      v8::Local<v8::Context> destination_context,
+                      v8::Local<v8::Array> arr,
+                      v8::Local<v8::Value>* out) {
+  const uint32_t length = arr->Length();
+  std::vector<double> numbers;
+  numbers.reserve(length);
+  if (arr->Iterate(source_context, &CollectNumber, &numbers).IsNothing() ||
+      numbers.size() != length)
+    return false;
+
+  v8::Isolate* isolate = destination_context->GetIsolate();
+  v8::Context::Scope destination_context_scope(destination_context);
+  v8::LocalVector<v8::Value> elements(isolate);
+  elements.reserve(length);
+  for (double number : numbers)
+    elements.push_back(v8::Number::New(isolate, number));
+  *out = v8::Array::New(isolate, elements.data(), elements.size());
+  return true;
+}
+
 void SetPrivate(v8::Local<v8::Context> context,
                 v8::Local<v8::Object> target,
                 const std::string& key,
@@ -162,8 +296,7 @@ v8::MaybeLocal<v8::Value> PassValueToOtherContext(
   // copying them. This list of primitives is based on the classification of
   // "primitive value" as defined in the ECMA262 spec
   // https://tc39.es/ecma262/#sec-primitive-value
-  if (value->IsString() || value->IsNumber() || value->IsNullOrUndefined() ||
-      value->IsBoolean() || value->IsSymbol() || value->IsBigInt()) {
+  if (IsPrimitive(value)) {
     return v8::MaybeLocal<v8::Value>(value);
   }
 
@@ -197,17 +330,8 @@ v8::MaybeLocal<v8::Value> PassValueToOtherContext(
         return v8::MaybeLocal<v8::Value>(proxy_func);
       }
 
-      v8::Local<v8::Object> state =
-          v8::Object::New(destination_context->GetIsolate());
-      SetPrivate(destination_context, state,
-                 context_bridge::kProxyFunctionPrivateKey, func);
-      SetPrivate(destination_context, state,
-                 context_bridge::kProxyFunctionReceiverPrivateKey,
-                 parent_value);
-      SetPrivate(destination_context, state,
-                 context_bridge::kSupportsDynamicPropertiesPrivateKey,
-                 gin::ConvertToV8(destination_context->GetIsolate(),
-                                  support_dynamic_properties));
+      v8::Local<v8::Object> state = CreateProxyFunctionState(
+          destination_context, func, parent_value, support_dynamic_properties);
 
       if (!v8::Function::New(destination_context, ProxyFunctionWrapper, state)
                .ToLocal(&proxy_func))
@@ -363,8 +487,15 @@ v8::MaybeLocal<v8::Value> PassValueToOtherContext(
   // array so that functions deep inside arrays get proxied or arrays of
   // promises are proxied correctly.
   if (IsPlainArray(value)) {
-    v8::Context::Scope destination_context_scope(destination_context);
     v8::Local<v8::Array> arr = value.As<v8::Array>();
+    v8::Local<v8::Value> cloned_numbers;
+    if (CloneNumberArray(source_context, destination_context, arr,
+                         &cloned_numbers)) {
+      object_cache->CacheProxiedObject(value, cloned_numbers);
+      return v8::MaybeLocal<v8::Value>(cloned_numbers);
+    }
+
+    v8::Context::Scope destination_context_scope(destination_context);
     size_t length = arr->Length();
     v8::Local<v8::Array> cloned_arr =
         v8::Array::New(destination_context->GetIsolate(), length);
@@ -414,6 +545,12 @@ v8::MaybeLocal<v8::Value> PassValueToOtherContext(
     return v8::MaybeLocal<v8::Value>(passed_value.ToLocalChecked());
   }
 
+  v8::Local<v8::Value> cloned_buffer;
+  if (CloneArrayBufferOrView(destination_context, value, &cloned_buffer)) {
+    object_cache->CacheProxiedObject(value, cloned_buffer);
+    return v8::MaybeLocal<v8::Value>(cloned_buffer);
+  }
+
   // Serializable objects
   blink::CloneableMessage ret;
   {
@@ -440,27 +577,20 @@ void ProxyFunctionWrapper(const v8::FunctionCallbackInfo<v8::Value>& info) {
   TRACE_EVENT0("electron", "ContextBridge::ProxyFunctionWrapper");
   CHECK(info.Data()->IsObject());
   v8::Local<v8::Object> data = info.Data().As<v8::Object>();
-  bool support_dynamic_properties = false;
+  CHECK_EQ(data->InternalFieldCount(), kProxyFunctionFieldCount);
   gin::Arguments args(info);
   // Context the proxy function was called from
   v8::Local<v8::Context> calling_context = args.isolate()->GetCurrentContext();
 
-  // Pull the original function and its context off of the data private key
-  v8::MaybeLocal<v8::Value> sdp_value =
-      GetPrivate(calling_context, data,
-                 context_bridge::kSupportsDynamicPropertiesPrivateKey);
-  v8::MaybeLocal<v8::Value> maybe_func = GetPrivate(
-      calling_context, data, context_bridge::kProxyFunctionPrivateKey);
-  v8::MaybeLocal<v8::Value> maybe_recv = GetPrivate(
-      calling_context, data, context_bridge::kProxyFunctionReceiverPrivateKey);
-  v8::Local<v8::Value> func_value;
-  if (sdp_value.IsEmpty() || maybe_func.IsEmpty() || maybe_recv.IsEmpty() ||
-      !gin::ConvertFromV8(args.isolate(), sdp_value.ToLocalChecked(),
-                          &support_dynamic_properties) ||
-      !maybe_func.ToLocal(&func_value))
-    return;
-
-  v8::Local<v8::Function> func = func_value.As<v8::Function>();
+  // Pull the original function and its receiver off of the data object
+  v8::Local<v8::Function> func =
+      data->GetInternalField(kProxyFunctionField).As<v8::Function>();
+  v8::Local<v8::Value> recv =
+      data->GetInternalField(kProxyFunctionReceiverField).As<v8::Value>();
+  const bool support_dynamic_properties =
+      data->GetInternalField(kSupportsDynamicPropertiesField)
+          .As<v8::Boolean>()
+          ->Value();
   v8::Local<v8::Context> func_owning_context =
       func->GetCreationContextChecked();
 
@@ -468,11 +598,15 @@ void ProxyFunctionWrapper(const v8::FunctionCallbackInfo<v8::Value>& info) {
     v8::Context::Scope func_owning_context_scope(func_owning_context);
     context_bridge::ObjectCache object_cache;
 
-    std::vector<v8::Local<v8::Value>> original_args;
-    std::vector<v8::Local<v8::Value>> proxied_args;
-    args.GetRemaining(&original_args);
-
-    for (auto value : original_args) {
+    v8::LocalVector<v8::Value> proxied_args(args.isolate());
+    proxied_args.reserve(info.Length());
+    for (int i = 0; i < info.Length(); ++i) {
+      v8::Local<v8::Value> value = info[i];
+      // Skip the bridge entirely for primitives, which most calls pass.
+      if (IsPrimitive(value)) {
+        proxied_args.push_back(value);
+        continue;
+      }
       auto arg = PassValueToOtherContext(
           calling_context, func_owning_context, value,
           calling_context->Global(), &object_cache, support_dynamic_properties,
@@ -487,9 +621,8 @@ void ProxyFunctionWrapper(const v8::FunctionCallbackInfo<v8::Value>& info) {
     v8::Local<v8::Value> error_message;
     {
       v8::TryCatch try_catch(args.isolate());
-      maybe_return_value =
-          func->Call(func_owning_context, maybe_recv.ToLocalChecked(),
-                     proxied_args.size(), proxied_args.data());
+      maybe_return_value = func->Call(func_owning_context, recv,
+                                      proxied_args.size(), proxied_args.data());
       if (try_catch.HasCaught()) {
         did_error = true;
         v8::Local<v8::Value> exception = try_catch.Exception();
@@ -524,6 +657,12 @@ void ProxyFunctionWrapper(const v8::FunctionCallbackInfo<v8::Value>& info) {
     if (maybe_return_value.IsEmpty())
       return;
 
+    v8::Local<v8::Value> return_value = maybe_return_value.ToLocalChecked();
+    if (IsPrimitive(return_value)) {
+      info.GetReturnValue().Set(return_value);
+      return;
+    }
+
     // In the case where we encountered an exception converting the return value
     // of the function we need to ensure that the exception / thrown value is
     // safely transferred from the function_owning_context (where it was thrown)
@@ -543,8 +682,7 @@ void ProxyFunctionWrapper(const v8::FunctionCallbackInfo<v8::Value>& info) {
     {
       v8::TryCatch try_catch(args.isolate());
       ret = PassValueToOtherContext(func_owning_context, calling_context,
-                                    maybe_return_value.ToLocalChecked(),
-                                    func_owning_context->Global(),
+                                    return_value, func_owning_context->Global(),
                                     &object_cache, support_dynamic_properties,
                                     0, BridgeErrorTarget::kDestination);
       if (try_catch.HasCaught()) {
@@ -597,6 +735,9 @@ v8::MaybeLocal<v8::Object> CreateProxyForAPI(
     auto keys = maybe_keys.ToLocalChecked();
 
     uint32_t length = keys->Length();
+    // Exposed APIs are mostly made of functions and objects, which all end up
+    // in the cache.
+    object_cache->Reserve(length);
     for (uint32_t i = 0; i < length; i++) {
       v8::Local<v8::Value> key =
           keys->Get(destination_context, i).ToLocalChecked();
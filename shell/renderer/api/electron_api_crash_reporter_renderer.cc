@@ -22,6 +22,7 @@ v8::Local<v8::Value> GetParameters(v8::Isolate* isolate) {
 
 #if IS_MAS_BUILD()
 void SetCrashKeyStub(const std::string& key, const std::string& value) {}
+void SetCrashKeysStub(const std::map<std::string, std::string>& keys) {}
 void ClearCrashKeyStub(const std::string& key) {}
 #endif
 
@@ -32,9 +33,11 @@ void Initialize(v8::Local<v8::Object> exports,
   gin_helper::Dictionary dict(context->GetIsolate(), exports);
 #if IS_MAS_BUILD()
   dict.SetMethod("addExtraParameter", &SetCrashKeyStub);
+  dict.SetMethod("addExtraParameters", &SetCrashKeysStub);
   dict.SetMethod("removeExtraParameter", &ClearCrashKeyStub);
 #else
   dict.SetMethod("addExtraParameter", &electron::crash_keys::SetCrashKey);
+  dict.SetMethod("addExtraParameters", &electron::crash_keys::SetCrashKeys);
   dict.SetMethod("removeExtraParameter", &electron::crash_keys::ClearCrashKey);
 #endif
   dict.SetMethod("getParameters", &GetParameters);
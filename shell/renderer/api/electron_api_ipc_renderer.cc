@@ -2,8 +2,18 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <map>
+#include <optional>
 #include <string>
+#include <vector>
 
+#include "base/memory/ref_counted.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/task/thread_pool.h"
+#include "base/threading/sequence_bound.h"
+#include "base/timer/elapsed_timer.h"
+#include "base/trace_event/trace_event.h"
 #include "base/values.h"
 #include "content/public/renderer/render_frame.h"
 #include "content/public/renderer/render_frame_observer.h"
@@ -15,6 +25,7 @@
 #include "shell/common/api/api.mojom.h"
 #include "shell/common/gin_converters/blink_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
+#include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/function_template_extensions.h"
 #include "shell/common/gin_helper/promise.h"
@@ -41,6 +52,52 @@ RenderFrame* GetCurrentRenderFrame() {
   return RenderFrame::FromWebFrame(frame);
 }
 
+// The reply to a sendSync() call with a timeout, which is signaled from the
+// sequence the call was made on.
+struct SyncReply : public base::RefCountedThreadSafe<SyncReply> {
+  base::WaitableEvent event;
+  blink::CloneableMessage result;
+
+ private:
+  friend class base::RefCountedThreadSafe<SyncReply>;
+  ~SyncReply() = default;
+};
+
+// Makes MessageSync calls on a sequence of its own, so that the main thread
+// can give up waiting for them. It uses its own endpoint on the frame's
+// channel, so the calls stay ordered after the messages sent before them.
+class SyncMessageSender {
+ public:
+  explicit SyncMessageSender(
+      mojo::PendingAssociatedRemote<electron::mojom::ElectronApiIPC> remote)
+      : remote_(std::move(remote)) {}
+
+  void MessageSync(bool internal,
+                   const std::string& channel,
+                   blink::CloneableMessage arguments,
+                   scoped_refptr<SyncReply> reply) {
+    remote_->MessageSync(
+        internal, channel, std::move(arguments),
+        base::BindOnce(
+            [](scoped_refptr<SyncReply> reply,
+               blink::CloneableMessage result) {
+              reply->result = std::move(result);
+              reply->event.Signal();
+            },
+            std::move(reply)));
+  }
+
+ private:
+  mojo::AssociatedRemote<electron::mojom::ElectronApiIPC> remote_;
+};
+
+struct SyncMessageStats {
+  int count = 0;
+  int timeouts = 0;
+  base::TimeDelta total_wait_time;
+  base::TimeDelta max_wait_time;
+};
+
 class IPCRenderer : public gin::Wrappable<IPCRenderer>,
                     public content::RenderFrameObserver {
  public:
@@ -62,13 +119,18 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
         &electron_ipc_remote_);
   }
 
-  void OnDestruct() override { electron_ipc_remote_.reset(); }
+  void OnDestruct() override {
+    electron_ipc_remote_.reset();
+    sync_message_sender_.Reset();
+  }
 
   void WillReleaseScriptContext(v8::Local<v8::Context> context,
                                 int32_t world_id) override {
     if (weak_context_.IsEmpty() ||
-        weak_context_.Get(context->GetIsolate()) == context)
+        weak_context_.Get(context->GetIsolate()) == context) {
       electron_ipc_remote_.reset();
+      sync_message_sender_.Reset();
+    }
   }
 
   // gin::Wrappable:
@@ -78,6 +140,7 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
         .SetMethod("send", &IPCRenderer::SendMessage)
         .SetMethod("sendSync", &IPCRenderer::SendSync)
         .SetMethod("sendToHost", &IPCRenderer::SendToHost)
+        .SetMethod("getSyncMessageStats", &IPCRenderer::GetSyncMessageStats)
         .SetMethod("invoke", &IPCRenderer::Invoke)
         .SetMethod("postMessage", &IPCRenderer::PostMessage);
   }
@@ -85,17 +148,38 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
   const char* GetTypeName() override { return "IPCRenderer"; }
 
  private:
+  static bool GetTransferredArrayBuffers(
+      v8::Isolate* isolate,
+      gin_helper::ErrorThrower thrower,
+      std::optional<v8::Local<v8::Value>> transfer,
+      std::vector<v8::Local<v8::ArrayBuffer>>* array_buffers) {
+    if (!transfer || transfer.value()->IsUndefined())
+      return true;
+    if (!gin::ConvertFromV8(isolate, *transfer, array_buffers)) {
+      thrower.ThrowTypeError("Invalid value for transfer");
+      return false;
+    }
+    return true;
+  }
+
   void SendMessage(v8::Isolate* isolate,
                    gin_helper::ErrorThrower thrower,
                    bool internal,
                    const std::string& channel,
-                   v8::Local<v8::Value> arguments) {
+                   v8::Local<v8::Value> arguments,
+                   std::optional<v8::Local<v8::Value>> transfer) {
     if (!electron_ipc_remote_) {
       thrower.ThrowError(kIPCMethodCalledAfterContextReleasedError);
       return;
     }
-    blink::CloneableMessage message;
-    if (!electron::SerializeV8Value(isolate, arguments, &message)) {
+    std::vector<v8::Local<v8::ArrayBuffer>> array_buffers;
+    if (!GetTransferredArrayBuffers(isolate, thrower, transfer,
+                                    &array_buffers)) {
+      return;
+    }
+    electron::mojom::SerializedArgumentsPtr message =
+        electron::SerializeV8ValueForIPC(isolate, arguments, array_buffers);
+    if (!message) {
       return;
     }
     electron_ipc_remote_->Message(internal, channel, std::move(message));
@@ -105,13 +189,20 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
                                 gin_helper::ErrorThrower thrower,
                                 bool internal,
                                 const std::string& channel,
-                                v8::Local<v8::Value> arguments) {
+                                v8::Local<v8::Value> arguments,
+                                std::optional<v8::Local<v8::Value>> transfer) {
     if (!electron_ipc_remote_) {
       thrower.ThrowError(kIPCMethodCalledAfterContextReleasedError);
       return v8::Local<v8::Promise>();
     }
-    blink::CloneableMessage message;
-    if (!electron::SerializeV8Value(isolate, arguments, &message)) {
+    std::vector<v8::Local<v8::ArrayBuffer>> array_buffers;
+    if (!GetTransferredArrayBuffers(isolate, thrower, transfer,
+                                    &array_buffers)) {
+      return v8::Local<v8::Promise>();
+    }
+    electron::mojom::SerializedArgumentsPtr message =
+        electron::SerializeV8ValueForIPC(isolate, arguments, array_buffers);
+    if (!message) {
       return v8::Local<v8::Promise>();
     }
     gin_helper::Promise<blink::CloneableMessage> p(isolate);
@@ -187,7 +278,8 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
                                 gin_helper::ErrorThrower thrower,
                                 bool internal,
                                 const std::string& channel,
-                                v8::Local<v8::Value> arguments) {
+                                v8::Local<v8::Value> arguments,
+                                std::optional<double> timeout_ms) {
     if (!electron_ipc_remote_) {
       thrower.ThrowError(kIPCMethodCalledAfterContextReleasedError);
       return v8::Local<v8::Value>();
@@ -197,14 +289,67 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
       return v8::Local<v8::Value>();
     }
 
+    TRACE_EVENT1("electron", "IPCRenderer::SendSync", "channel", channel);
+    SyncMessageStats& stats = sync_message_stats_[channel];
+    base::ElapsedTimer timer;
     blink::CloneableMessage result;
-    electron_ipc_remote_->MessageSync(internal, channel, std::move(message),
-                                      &result);
+    if (!timeout_ms) {
+      electron_ipc_remote_->MessageSync(internal, channel, std::move(message),
+                                        &result);
+    } else {
+      auto reply = base::MakeRefCounted<SyncReply>();
+      GetSyncMessageSender()
+          .AsyncCall(&SyncMessageSender::MessageSync)
+          .WithArgs(internal, channel, std::move(message), reply);
+      if (!reply->event.TimedWait(base::Milliseconds(*timeout_ms))) {
+        RecordSyncWait(&stats, timer.Elapsed());
+        stats.timeouts++;
+        thrower.ThrowError("Timed out waiting for a reply to '" + channel +
+                           "'");
+        return v8::Local<v8::Value>();
+      }
+      result = std::move(reply->result);
+    }
+    RecordSyncWait(&stats, timer.Elapsed());
     return electron::DeserializeV8Value(isolate, result);
   }
 
+  static void RecordSyncWait(SyncMessageStats* stats,
+                             base::TimeDelta wait_time) {
+    stats->count++;
+    stats->total_wait_time += wait_time;
+    stats->max_wait_time = std::max(stats->max_wait_time, wait_time);
+  }
+
+  v8::Local<v8::Value> GetSyncMessageStats(v8::Isolate* isolate) {
+    auto dict = gin_helper::Dictionary::CreateEmpty(isolate);
+    for (const auto& [channel, stats] : sync_message_stats_) {
+      auto entry = gin_helper::Dictionary::CreateEmpty(isolate);
+      entry.Set("count", stats.count);
+      entry.Set("timeouts", stats.timeouts);
+      entry.Set("totalWaitTime", stats.total_wait_time.InMillisecondsF());
+      entry.Set("maxWaitTime", stats.max_wait_time.InMillisecondsF());
+      dict.Set(channel, entry);
+    }
+    return dict.GetHandle();
+  }
+
+  base::SequenceBound<SyncMessageSender>& GetSyncMessageSender() {
+    if (!sync_message_sender_) {
+      mojo::PendingAssociatedRemote<electron::mojom::ElectronApiIPC> remote;
+      render_frame()->GetRemoteAssociatedInterfaces()->GetInterface(
+          remote.InitWithNewEndpointAndPassReceiver());
+      sync_message_sender_.emplace(base::ThreadPool::CreateSequencedTaskRunner(
+                                       {base::TaskPriority::USER_BLOCKING}),
+                                   std::move(remote));
+    }
+    return sync_message_sender_;
+  }
+
   v8::Global<v8::Context> weak_context_;
   mojo::AssociatedRemote<electron::mojom::ElectronApiIPC> electron_ipc_remote_;
+  base::SequenceBound<SyncMessageSender> sync_message_sender_;
+  std::map<std::string, SyncMessageStats> sync_message_stats_;
 };
 
 gin::WrapperInfo IPCRenderer::kWrapperInfo = {gin::kEmbedderNativeGin};
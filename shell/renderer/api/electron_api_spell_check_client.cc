@@ -52,20 +52,27 @@ struct Word {
 class SpellCheckClient::SpellcheckRequest {
  public:
   SpellcheckRequest(
-      const std::u16string& text,
+      int id,
+      std::u16string text,
       std::unique_ptr<blink::WebTextCheckingCompletion> completion)
-      : text_(text), completion_(std::move(completion)) {}
+      : id_(id), text_(std::move(text)), completion_(std::move(completion)) {}
   SpellcheckRequest(const SpellcheckRequest&) = delete;
   SpellcheckRequest& operator=(const SpellcheckRequest&) = delete;
   ~SpellcheckRequest() = default;
 
+  int id() const { return id_; }
   const std::u16string& text() const { return text_; }
   blink::WebTextCheckingCompletion* completion() { return completion_.get(); }
   std::vector<Word>& wordlist() { return word_list_; }
+  std::set<std::u16string>& misspelled_words() { return misspelled_words_; }
 
  private:
+  int id_;
   std::u16string text_;          // Text to be checked in this task.
   std::vector<Word> word_list_;  // List of Words found in text
+  // The words of the text known to be misspelled, from the cache or the
+  // provider.
+  std::set<std::u16string> misspelled_words_;
   // The interface to send the misspelled ranges to Blink.
   std::unique_ptr<blink::WebTextCheckingCompletion> completion_;
 };
@@ -105,8 +112,8 @@ void SpellCheckClient::RequestCheckingOfText(
     pending_request_param_->completion()->DidCancelCheckingText();
   }
 
-  pending_request_param_ =
-      std::make_unique<SpellcheckRequest>(text, std::move(completionCallback));
+  pending_request_param_ = std::make_unique<SpellcheckRequest>(
+      ++last_request_id_, std::move(text), std::move(completionCallback));
 
   base::SingleThreadTaskRunner::GetCurrentDefault()->PostTask(
       FROM_HERE,
@@ -181,16 +188,49 @@ void SpellCheckClient::SpellCheckText() {
     }
   }
 
-  // Send out all the words data to the spellchecker to check
-  SpellCheckWords(scope, words);
+  // Only ask the provider about the words that haven't been checked yet.
+  auto& misspelled_words = pending_request_param_->misspelled_words();
+  std::set<std::u16string> unchecked_words;
+  for (const auto& w : words) {
+    auto iter = word_cache_.Get(w);
+    if (iter == word_cache_.end())
+      unchecked_words.insert(w);
+    else if (!iter->second)
+      misspelled_words.insert(w);
+  }
+
+  if (unchecked_words.empty()) {
+    FinishRequest();
+    return;
+  }
+
+  // Send out the unchecked words to the spellchecker to check in one batch.
+  SpellCheckWords(scope, std::move(unchecked_words));
 }
 
 void SpellCheckClient::OnSpellCheckDone(
+    int request_id,
+    const std::set<std::u16string>& checked_words,
     const std::vector<std::u16string>& misspelled_words) {
-  std::vector<blink::WebTextCheckingResult> results;
   std::unordered_set<std::u16string> misspelled(misspelled_words.begin(),
                                                 misspelled_words.end());
+  for (const auto& word : checked_words)
+    word_cache_.Put(word, !base::Contains(misspelled, word));
 
+  // The results still fill the cache when the request has been replaced.
+  if (!pending_request_param_ || pending_request_param_->id() != request_id)
+    return;
+
+  for (const auto& word : checked_words) {
+    if (base::Contains(misspelled, word))
+      pending_request_param_->misspelled_words().insert(word);
+  }
+  FinishRequest();
+}
+
+void SpellCheckClient::FinishRequest() {
+  std::vector<blink::WebTextCheckingResult> results;
+  const auto& misspelled = pending_request_param_->misspelled_words();
   auto& word_list = pending_request_param_->wordlist();
 
   for (const auto& word : word_list) {
@@ -216,7 +256,7 @@ void SpellCheckClient::OnSpellCheckDone(
 }
 
 void SpellCheckClient::SpellCheckWords(const SpellCheckScope& scope,
-                                       const std::set<std::u16string>& words) {
+                                       std::set<std::u16string> words) {
   DCHECK(!scope.spell_check_.IsEmpty());
 
   auto context = isolate_->GetCurrentContext();
@@ -224,10 +264,12 @@ void SpellCheckClient::SpellCheckWords(const SpellCheckScope& scope,
       isolate_, context->GetMicrotaskQueue(),
       v8::MicrotasksScope::kDoNotRunMicrotasks);
 
+  v8::Local<v8::Value> v8_words = gin::ConvertToV8(isolate_, words);
   v8::Local<v8::FunctionTemplate> templ = gin_helper::CreateFunctionTemplate(
       isolate_,
-      base::BindRepeating(&SpellCheckClient::OnSpellCheckDone, AsWeakPtr()));
-  v8::Local<v8::Value> args[] = {gin::ConvertToV8(isolate_, words),
+      base::BindRepeating(&SpellCheckClient::OnSpellCheckDone, AsWeakPtr(),
+                          pending_request_param_->id(), std::move(words)));
+  v8::Local<v8::Value> args[] = {v8_words,
                                  templ->GetFunction(context).ToLocalChecked()};
   // Call javascript with the words and the callback function
   scope.spell_check_->Call(context, scope.provider_, std::size(args), args)
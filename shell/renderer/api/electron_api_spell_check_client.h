@@ -10,6 +10,7 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/lru_cache.h"
 #include "base/functional/callback.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
@@ -72,7 +73,7 @@ class SpellCheckClient : public blink::WebSpellCheckPanelHostClient,
   // The javascript function will callback OnSpellCheckDone
   // with the results of all the misspelled words.
   void SpellCheckWords(const SpellCheckScope& scope,
-                       const std::set<std::u16string>& words);
+                       std::set<std::u16string> words);
 
   // Returns whether or not the given word is a contraction of valid words
   // (e.g. "word:word").
@@ -82,8 +83,14 @@ class SpellCheckClient : public blink::WebSpellCheckPanelHostClient,
                      const std::u16string& contraction,
                      std::vector<std::u16string>* contraction_words);
 
-  // Callback for the JS API which returns the list of misspelled words.
-  void OnSpellCheckDone(const std::vector<std::u16string>& misspelled_words);
+  // Callback for the JS API which returns the list of misspelled words among
+  // the |checked_words| of request |request_id|.
+  void OnSpellCheckDone(int request_id,
+                        const std::set<std::u16string>& checked_words,
+                        const std::vector<std::u16string>& misspelled_words);
+
+  // Sends the misspelled ranges of the pending request to Blink.
+  void FinishRequest();
 
   // Represents character attributes used for filtering out characters which
   // are not supported by this SpellCheck object.
@@ -101,6 +108,12 @@ class SpellCheckClient : public blink::WebSpellCheckPanelHostClient,
   // (When Blink sends two or more requests, we cancel the previous
   // requests so we do not have to use vectors.)
   std::unique_ptr<SpellcheckRequest> pending_request_param_;
+  int last_request_id_ = 0;
+
+  // Whether the most recently checked words are spelled correctly, so that
+  // editing a long text doesn't send all of its words to the provider again.
+  static constexpr size_t kWordCacheSize = 10000;
+  base::LRUCache<std::u16string, bool> word_cache_{kWordCacheSize};
 
   raw_ptr<v8::Isolate> isolate_;
   v8::Global<v8::Context> context_;
@@ -3,7 +3,9 @@
 // found in the LICENSE file.
 
 #include <limits>
+#include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -371,6 +373,12 @@ class WebFrameRenderer : public gin::Wrappable<WebFrameRenderer>,
         .SetMethod("executeJavaScript", &WebFrameRenderer::ExecuteJavaScript)
         .SetMethod("executeJavaScriptInIsolatedWorld",
                    &WebFrameRenderer::ExecuteJavaScriptInIsolatedWorld)
+        .SetMethod("_registerScript", &WebFrameRenderer::RegisterScript)
+        .SetMethod("_unregisterScript", &WebFrameRenderer::UnregisterScript)
+        .SetMethod("_hasRegisteredScript",
+                   &WebFrameRenderer::HasRegisteredScript)
+        .SetMethod("_executeRegisteredScript",
+                   &WebFrameRenderer::ExecuteRegisteredScript)
         .SetMethod("setIsolatedWorldInfo",
                    &WebFrameRenderer::SetIsolatedWorldInfo)
         .SetMethod("getResourceUsage", &WebFrameRenderer::GetResourceUsage)
@@ -393,8 +401,20 @@ class WebFrameRenderer : public gin::Wrappable<WebFrameRenderer>,
 
   const char* GetTypeName() override { return "WebFrameRenderer"; }
 
+  // RenderFrameObserver implementation.
   void OnDestruct() override {}
 
+  // The registered functions of a context are dropped with it, so that they
+  // don't keep the context of a document that has gone away alive.
+  void WillReleaseScriptContext(v8::Local<v8::Context> context,
+                                int world_id) override {
+    v8::Isolate* isolate = context->GetIsolate();
+    std::erase_if(registered_scripts_, [&](const auto& entry) {
+      return entry.second.Get(isolate)->GetCreationContextChecked() ==
+             context;
+    });
+  }
+
  private:
   bool MaybeGetRenderFrame(v8::Isolate* isolate,
                            const std::string_view method_name,
@@ -607,15 +627,31 @@ class WebFrameRenderer : public gin::Wrappable<WebFrameRenderer>,
     return std::u16string();
   }
 
-  void RemoveInsertedCSS(v8::Isolate* isolate, const std::u16string& key) {
+  // Takes a key, or an array of them so that the sheets of a theme can be
+  // removed with a single call.
+  void RemoveInsertedCSS(v8::Isolate* isolate, v8::Local<v8::Value> value) {
+    std::vector<std::u16string> keys;
+    if (!gin::ConvertFromV8(isolate, value, &keys)) {
+      std::u16string key;
+      if (!gin::ConvertFromV8(isolate, value, &key)) {
+        gin_helper::ErrorThrower(isolate).ThrowTypeError(
+            "webFrame.removeInsertedCSS(): key must be a string or an array of "
+            "strings");
+        return;
+      }
+      keys.push_back(std::move(key));
+    }
+
     content::RenderFrame* render_frame;
     if (!MaybeGetRenderFrame(isolate, "removeInsertedCSS", &render_frame))
       return;
 
     blink::WebFrame* web_frame = render_frame->GetWebFrame();
     if (web_frame->IsWebLocalFrame()) {
-      web_frame->ToWebLocalFrame()->GetDocument().RemoveInsertedStyleSheet(
-          blink::WebString::FromUTF16(key));
+      blink::WebDocument document =
+          web_frame->ToWebLocalFrame()->GetDocument();
+      for (const auto& key : keys)
+        document.RemoveInsertedStyleSheet(blink::WebString::FromUTF16(key));
     }
   }
 
@@ -752,6 +788,120 @@ class WebFrameRenderer : public gin::Wrappable<WebFrameRenderer>,
     return handle;
   }
 
+  // Evaluates |code|, which must be a function expression, in |world_id| and
+  // keeps the resulting function so that ExecuteRegisteredScript can call it
+  // by |id| without the source being sent or parsed again.
+  void RegisterScript(v8::Isolate* isolate,
+                      int id,
+                      int world_id,
+                      const std::u16string& code) {
+    content::RenderFrame* render_frame;
+    if (!MaybeGetRenderFrame(isolate, "registerScript", &render_frame))
+      return;
+
+    blink::WebLocalFrame* web_frame = render_frame->GetWebFrame();
+    const blink::WebScriptSource source{
+        blink::WebString::FromUTF16(u"(" + code + u"\n)")};
+    v8::Local<v8::Value> value =
+        world_id == blink::DOMWrapperWorld::kMainWorldId
+            ? web_frame->ExecuteScriptAndReturnValue(source)
+            : web_frame->ExecuteScriptInIsolatedWorldAndReturnValue(
+                  world_id, source,
+                  blink::BackForwardCacheAware::kPossiblyDisallow);
+    if (value.IsEmpty() || !value->IsFunction()) {
+      gin_helper::ErrorThrower(isolate).ThrowTypeError(
+          "Script did not evaluate to a function. Check the renderer console "
+          "for errors.");
+      return;
+    }
+
+    registered_scripts_.insert_or_assign(
+        id, v8::Global<v8::Function>(isolate, value.As<v8::Function>()));
+  }
+
+  void UnregisterScript(int id) { registered_scripts_.erase(id); }
+
+  bool HasRegisteredScript(v8::Isolate* isolate, int id) {
+    return !GetRegisteredScript(isolate, id).IsEmpty();
+  }
+
+  v8::Local<v8::Value> ExecuteRegisteredScript(
+      v8::Isolate* isolate,
+      int id,
+      const std::vector<v8::Local<v8::Value>>& args) {
+    content::RenderFrame* render_frame;
+    if (!MaybeGetRenderFrame(isolate, "executeRegisteredScript",
+                             &render_frame))
+      return v8::Undefined(isolate);
+
+    v8::Local<v8::Function> function = GetRegisteredScript(isolate, id);
+    if (function.IsEmpty()) {
+      gin_helper::ErrorThrower(isolate).ThrowError(
+          "No script is registered with this handle");
+      return v8::Undefined(isolate);
+    }
+
+    v8::Local<v8::Context> calling_context = isolate->GetCurrentContext();
+    v8::Local<v8::Context> script_context =
+        function->GetCreationContextChecked();
+    // With contextIsolation disabled the script lives in the calling world,
+    // otherwise the arguments and the result have to cross the bridge.
+    const bool same_context = calling_context == script_context;
+    context_bridge::ObjectCache object_cache;
+
+    v8::MaybeLocal<v8::Value> maybe_result;
+    std::optional<std::string> error_message;
+    {
+      v8::Context::Scope script_context_scope(script_context);
+      std::vector<v8::Local<v8::Value>> argv;
+      argv.reserve(args.size());
+      for (const auto& arg : args) {
+        if (same_context) {
+          argv.push_back(arg);
+          continue;
+        }
+        v8::MaybeLocal<v8::Value> passed = PassValueToOtherContext(
+            calling_context, script_context, arg, calling_context->Global(),
+            &object_cache, false, 0, BridgeErrorTarget::kSource);
+        if (passed.IsEmpty())
+          return v8::Undefined(isolate);
+        argv.push_back(passed.ToLocalChecked());
+      }
+
+      v8::TryCatch try_catch(isolate);
+      maybe_result =
+          render_frame->GetWebFrame()->CallFunctionEvenIfScriptDisabled(
+              function, v8::Undefined(isolate), static_cast<int>(argv.size()),
+              argv.data());
+      if (try_catch.HasCaught()) {
+        // Only the message is passed on, the exception object belongs to the
+        // script's world.
+        error_message = "Registered script threw an exception";
+        v8::Local<v8::Message> message = try_catch.Message();
+        if (!message.IsEmpty())
+          gin::ConvertFromV8(isolate, message->Get(), &*error_message);
+      }
+    }
+
+    if (error_message) {
+      gin_helper::ErrorThrower(isolate).ThrowError(*error_message);
+      return v8::Undefined(isolate);
+    }
+
+    v8::Local<v8::Value> result;
+    if (!maybe_result.ToLocal(&result))
+      return v8::Undefined(isolate);
+    if (same_context)
+      return result;
+
+    if (!PassValueToOtherContext(script_context, calling_context, result,
+                                 script_context->Global(), &object_cache, false,
+                                 0, BridgeErrorTarget::kSource)
+             .ToLocal(&result))
+      return v8::Undefined(isolate);
+    return result;
+  }
+
   void SetIsolatedWorldInfo(v8::Isolate* isolate,
                             int world_id,
                             const gin_helper::Dictionary& options) {
@@ -902,6 +1052,25 @@ class WebFrameRenderer : public gin::Wrappable<WebFrameRenderer>,
 
     return render_frame->GetRoutingID();
   }
+
+  // Returns the function registered with |id|, dropping it when it was
+  // compiled in another document of the frame.
+  v8::Local<v8::Function> GetRegisteredScript(v8::Isolate* isolate, int id) {
+    auto iter = registered_scripts_.find(id);
+    if (iter == registered_scripts_.end() || !render_frame())
+      return v8::Local<v8::Function>();
+
+    v8::Local<v8::Function> function = iter->second.Get(isolate);
+    if (blink::WebLocalFrame::FrameForContext(
+            function->GetCreationContextChecked()) !=
+        render_frame()->GetWebFrame()) {
+      registered_scripts_.erase(iter);
+      return v8::Local<v8::Function>();
+    }
+    return function;
+  }
+
+  std::map<int, v8::Global<v8::Function>> registered_scripts_;
 };
 
 gin::WrapperInfo WebFrameRenderer::kWrapperInfo = {gin::kEmbedderNativeGin};
@@ -5,14 +5,18 @@
 #include "electron/shell/renderer/electron_api_service_impl.h"
 
 #include <memory>
+#include <optional>
 #include <tuple>
 #include <utility>
 #include <vector>
 
 #include "base/environment.h"
+#include "base/memory/memory_pressure_listener.h"
 #include "base/trace_event/trace_event.h"
+#include "base/values.h"
 #include "gin/data_object_builder.h"
 #include "mojo/public/cpp/system/platform_handle.h"
+#include "shell/common/cpu_profiler.h"
 #include "shell/common/electron_constants.h"
 #include "shell/common/gin_converters/blink_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
@@ -25,9 +29,11 @@
 #include "shell/renderer/renderer_client_base.h"
 #include "third_party/blink/public/mojom/frame/user_activation_notification_type.mojom-shared.h"
 #include "third_party/blink/public/platform/scheduler/web_agent_group_scheduler.h"
+#include "third_party/blink/public/platform/web_cache.h"
 #include "third_party/blink/public/web/blink.h"
 #include "third_party/blink/public/web/web_local_frame.h"
 #include "third_party/blink/public/web/web_message_port_converter.h"
+#include "v8/include/v8-profiler.h"
 
 namespace electron {
 
@@ -153,18 +159,21 @@ void ElectronApiServiceImpl::OnConnectionError() {
 
 void ElectronApiServiceImpl::Message(bool internal,
                                      const std::string& channel,
-                                     blink::CloneableMessage arguments) {
+                                     mojom::SerializedArgumentsPtr arguments) {
   blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
   if (!frame)
     return;
 
+  // Only the Node environment can receive the message.
+  renderer_client_->EnsureNodeEnvironment(render_frame());
+
   v8::Isolate* isolate = frame->GetAgentGroupScheduler()->Isolate();
   v8::HandleScope handle_scope(isolate);
 
   v8::Local<v8::Context> context = renderer_client_->GetContext(frame, isolate);
   v8::Context::Scope context_scope(context);
 
-  v8::Local<v8::Value> args = gin::ConvertToV8(isolate, arguments);
+  v8::Local<v8::Value> args = DeserializeV8Value(isolate, *arguments);
 
   EmitIPCEvent(context, internal, channel, {}, args);
 }
@@ -176,6 +185,9 @@ void ElectronApiServiceImpl::ReceivePostMessage(
   if (!frame)
     return;
 
+  // Only the Node environment can receive the message.
+  renderer_client_->EnsureNodeEnvironment(render_frame());
+
   v8::Isolate* isolate = frame->GetAgentGroupScheduler()->Isolate();
   v8::HandleScope handle_scope(isolate);
 
@@ -220,4 +232,94 @@ void ElectronApiServiceImpl::TakeHeapSnapshot(
   std::move(callback).Run(success);
 }
 
+void ElectronApiServiceImpl::StreamHeapSnapshot(
+    mojo::ScopedDataPipeProducerHandle pipe,
+    StreamHeapSnapshotCallback callback) {
+  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
+  if (!frame) {
+    std::move(callback).Run(false);
+    return;
+  }
+
+  v8::Isolate* isolate = frame->GetAgentGroupScheduler()->Isolate();
+  electron::TakeHeapSnapshot(isolate, std::move(pipe), std::move(callback));
+}
+
+void ElectronApiServiceImpl::StartSamplingHeapProfiler(
+    uint64_t sample_interval,
+    int32_t stack_depth,
+    StartSamplingHeapProfilerCallback callback) {
+  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
+  if (!frame) {
+    std::move(callback).Run(false);
+    return;
+  }
+
+  v8::Isolate* isolate = frame->GetAgentGroupScheduler()->Isolate();
+  std::move(callback).Run(isolate->GetHeapProfiler()->StartSamplingHeapProfiler(
+      sample_interval, stack_depth));
+}
+
+void ElectronApiServiceImpl::StopSamplingHeapProfiler(
+    StopSamplingHeapProfilerCallback callback) {
+  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
+  if (!frame) {
+    std::move(callback).Run(std::nullopt);
+    return;
+  }
+
+  v8::Isolate* isolate = frame->GetAgentGroupScheduler()->Isolate();
+  std::optional<base::Value::Dict> profile =
+      electron::GetSamplingHeapProfile(isolate);
+  if (profile)
+    isolate->GetHeapProfiler()->StopSamplingHeapProfiler();
+
+  std::move(callback).Run(std::move(profile));
+}
+
+void ElectronApiServiceImpl::StartCpuProfiler(
+    base::TimeDelta sampling_interval,
+    StartCpuProfilerCallback callback) {
+  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
+  if (!frame) {
+    std::move(callback).Run(false);
+    return;
+  }
+
+  v8::Isolate* isolate = frame->GetAgentGroupScheduler()->Isolate();
+  std::move(callback).Run(
+      electron::StartCpuProfiler(isolate, sampling_interval));
+}
+
+void ElectronApiServiceImpl::StopCpuProfiler(
+    StopCpuProfilerCallback callback) {
+  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
+  if (!frame) {
+    std::move(callback).Run(std::nullopt);
+    return;
+  }
+
+  v8::Isolate* isolate = frame->GetAgentGroupScheduler()->Isolate();
+  std::move(callback).Run(electron::StopCpuProfiler(isolate));
+}
+
+void ElectronApiServiceImpl::PurgeMemory(bool is_sole_page,
+                                         PurgeMemoryCallback callback) {
+  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
+  if (frame) {
+    v8::Isolate* isolate = frame->GetAgentGroupScheduler()->Isolate();
+    isolate->IdleNotificationDeadline(0.5);
+  }
+  blink::WebCache::Clear();
+  // Under critical pressure the compositor also drops its GPU resources. That
+  // reaches every listener in the process, so it would also throttle the
+  // other pages the renderer hosts.
+  if (is_sole_page) {
+    base::MemoryPressureListener::NotifyMemoryPressure(
+        base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL);
+  }
+
+  std::move(callback).Run();
+}
+
 }  // namespace electron
@@ -34,11 +34,23 @@ class ElectronApiServiceImpl : public mojom::ElectronRenderer,
 
   void Message(bool internal,
                const std::string& channel,
-               blink::CloneableMessage arguments) override;
+               mojom::SerializedArgumentsPtr arguments) override;
   void ReceivePostMessage(const std::string& channel,
                           blink::TransferableMessage message) override;
   void TakeHeapSnapshot(mojo::ScopedHandle file,
                         TakeHeapSnapshotCallback callback) override;
+  void StreamHeapSnapshot(mojo::ScopedDataPipeProducerHandle pipe,
+                          StreamHeapSnapshotCallback callback) override;
+  void StartSamplingHeapProfiler(
+      uint64_t sample_interval,
+      int32_t stack_depth,
+      StartSamplingHeapProfilerCallback callback) override;
+  void StopSamplingHeapProfiler(
+      StopSamplingHeapProfilerCallback callback) override;
+  void StartCpuProfiler(base::TimeDelta sampling_interval,
+                        StartCpuProfilerCallback callback) override;
+  void StopCpuProfiler(StopCpuProfilerCallback callback) override;
+  void PurgeMemory(bool is_sole_page, PurgeMemoryCallback callback) override;
   void ProcessPendingMessages();
 
   base::WeakPtr<ElectronApiServiceImpl> GetWeakPtr() {
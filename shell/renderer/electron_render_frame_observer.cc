@@ -8,12 +8,16 @@
 #include <vector>
 
 #include "base/command_line.h"
+#include "base/functional/bind.h"
 #include "base/memory/ref_counted_memory.h"
+#include "base/task/single_thread_task_runner.h"
 #include "base/trace_event/trace_event.h"
 #include "content/public/renderer/render_frame.h"
 #include "electron/buildflags/buildflags.h"
 #include "electron/shell/common/api/api.mojom.h"
 #include "ipc/ipc_message_macros.h"
+#include "mojo/public/cpp/bindings/clone_traits.h"
+#include "mojo/public/cpp/bindings/equals_traits.h"
 #include "net/base/net_module.h"
 #include "net/grit/net_resources.h"
 #include "services/service_manager/public/cpp/interface_provider.h"
@@ -142,9 +146,12 @@ void ElectronRenderFrameObserver::DidInstallConditionalFeatures(
   bool is_main_frame = render_frame_->IsMainFrame();
   bool allow_node_in_sub_frames = prefs.node_integration_in_sub_frames;
 
+  // Subframes on their initial about:blank document never get a preload (see
+  // ShouldNotifyClient), so there is nothing to run in an isolated world.
   bool should_create_isolated_context =
       use_context_isolation && is_main_world &&
-      (is_main_frame || allow_node_in_sub_frames);
+      (is_main_frame || allow_node_in_sub_frames) &&
+      ShouldNotifyClient(WorldIDs::ISOLATED_WORLD_ID);
 
   if (should_create_isolated_context) {
     CreateIsolatedWorldContext();
@@ -154,6 +161,17 @@ void ElectronRenderFrameObserver::DidInstallConditionalFeatures(
 }
 
 void ElectronRenderFrameObserver::DraggableRegionsChanged() {
+  if (draggable_regions_update_pending_)
+    return;
+  draggable_regions_update_pending_ = true;
+  base::SingleThreadTaskRunner::GetCurrentDefault()->PostTask(
+      FROM_HERE,
+      base::BindOnce(&ElectronRenderFrameObserver::SendDraggableRegions,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void ElectronRenderFrameObserver::SendDraggableRegions() {
+  draggable_regions_update_pending_ = false;
   blink::WebVector<blink::WebDraggableRegion> webregions =
       render_frame_->GetWebFrame()->GetDocument().DraggableRegions();
   std::vector<mojom::DraggableRegionPtr> regions;
@@ -165,6 +183,12 @@ void ElectronRenderFrameObserver::DraggableRegionsChanged() {
     regions.push_back(std::move(region));
   }
 
+  if (last_draggable_regions_ &&
+      mojo::Equals(*last_draggable_regions_, regions)) {
+    return;
+  }
+  last_draggable_regions_ = mojo::Clone(regions);
+
   mojo::AssociatedRemote<mojom::ElectronWebContentsUtility>
       web_contents_utility_remote;
   render_frame_->GetRemoteAssociatedInterfaces()->GetInterface(
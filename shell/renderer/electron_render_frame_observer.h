@@ -5,9 +5,13 @@
 #ifndef ELECTRON_SHELL_RENDERER_ELECTRON_RENDER_FRAME_OBSERVER_H_
 #define ELECTRON_SHELL_RENDERER_ELECTRON_RENDER_FRAME_OBSERVER_H_
 
+#include <optional>
 #include <string>
+#include <vector>
 
+#include "base/memory/weak_ptr.h"
 #include "content/public/renderer/render_frame_observer.h"
+#include "electron/shell/common/api/api.mojom.h"
 #include "ipc/ipc_platform_file.h"
 #include "third_party/blink/public/web/web_local_frame.h"
 
@@ -40,12 +44,23 @@ class ElectronRenderFrameObserver : public content::RenderFrameObserver {
   [[nodiscard]] bool ShouldNotifyClient(int world_id) const;
 
   void CreateIsolatedWorldContext();
+  // Sends the draggable regions to the browser, unless they are the ones it
+  // already has.
+  void SendDraggableRegions();
   void OnTakeHeapSnapshot(IPC::PlatformFileForTransit file_handle,
                           const std::string& channel);
 
   bool has_delayed_node_initialization_ = false;
   content::RenderFrame* render_frame_;
   RendererClientBase* renderer_client_;
+
+  // Draggable regions often change several times within a task, or change
+  // back to what they were, so they are only sent once a task and only when
+  // they differ from the last ones sent.
+  bool draggable_regions_update_pending_ = false;
+  std::optional<std::vector<mojom::DraggableRegionPtr>> last_draggable_regions_;
+
+  base::WeakPtrFactory<ElectronRenderFrameObserver> weak_factory_{this};
 };
 
 }  // namespace electron
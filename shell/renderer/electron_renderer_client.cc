@@ -4,9 +4,15 @@
 
 #include "shell/renderer/electron_renderer_client.h"
 
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
 #include "base/command_line.h"
 #include "base/containers/contains.h"
 #include "base/debug/stack_trace.h"
+#include "base/functional/bind.h"
 #include "content/public/renderer/render_frame.h"
 #include "electron/buildflags/buildflags.h"
 #include "net/http/http_request_headers.h"
@@ -16,6 +22,7 @@
 #include "shell/common/node_bindings.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/options_switches.h"
+#include "shell/common/startup_timings.h"
 #include "shell/renderer/electron_render_frame_observer.h"
 #include "shell/renderer/web_worker_observer.h"
 #include "third_party/blink/public/common/web_preferences/web_preferences.h"
@@ -26,6 +33,75 @@
 
 namespace electron {
 
+namespace {
+
+// The globals that a page with nodeIntegration reaches Node.js through.
+constexpr std::string_view kLazyNodeGlobals[] = {
+    "Buffer", "__dirname", "__filename", "clearImmediate", "global",
+    "module", "process",   "require",    "setImmediate"};
+
+bool ShouldCreateNodeEnvironmentLazily(content::RenderFrame* render_frame) {
+  const auto& prefs = render_frame->GetBlinkPreferences();
+  return prefs.node_integration && !prefs.context_isolation &&
+         base::CommandLine::ForCurrentProcess()->HasSwitch(
+             switches::kLazyNodeIntegration);
+}
+
+void LazyNodeGlobalGetter(const v8::FunctionCallbackInfo<v8::Value>& info) {
+  v8::Isolate* isolate = info.GetIsolate();
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+  blink::WebLocalFrame* frame = blink::WebLocalFrame::FrameForContext(context);
+  if (!frame)
+    return;
+
+  // This replaces the lazy globals with the ones Node.js defines.
+  RendererClientBase::Get()->EnsureNodeEnvironment(
+      content::RenderFrame::FromWebFrame(frame));
+
+  v8::Local<v8::Value> value;
+  if (context->Global()->Get(context, info.Data()).ToLocal(&value))
+    info.GetReturnValue().Set(value);
+}
+
+void LazyNodeGlobalSetter(const v8::FunctionCallbackInfo<v8::Value>& info) {
+  // Let the page shadow the global without loading Node.js.
+  v8::Local<v8::Context> context = info.GetIsolate()->GetCurrentContext();
+  std::ignore = context->Global()->CreateDataProperty(
+      context, info.Data().As<v8::Name>(), info[0]);
+}
+
+void InstallLazyNodeGlobals(v8::Local<v8::Context> context) {
+  v8::Isolate* isolate = context->GetIsolate();
+  v8::Local<v8::Object> global = context->Global();
+  for (const auto name : kLazyNodeGlobals) {
+    v8::Local<v8::String> key = gin::StringToSymbol(isolate, name);
+    global->SetAccessorProperty(
+        key,
+        v8::Function::New(context, LazyNodeGlobalGetter, key).ToLocalChecked(),
+        v8::Function::New(context, LazyNodeGlobalSetter, key).ToLocalChecked(),
+        v8::DontEnum);
+  }
+}
+
+void RemoveLazyNodeGlobals(v8::Local<v8::Context> context) {
+  v8::Isolate* isolate = context->GetIsolate();
+  v8::Local<v8::Object> global = context->Global();
+  v8::Local<v8::String> get_key = gin::StringToSymbol(isolate, "get");
+  for (const auto name : kLazyNodeGlobals) {
+    v8::Local<v8::String> key = gin::StringToSymbol(isolate, name);
+    v8::Local<v8::Value> descriptor;
+    // Leave alone the globals that the page has already replaced.
+    if (global->GetOwnPropertyDescriptor(context, key).ToLocal(&descriptor) &&
+        descriptor->IsObject() &&
+        descriptor.As<v8::Object>()->HasOwnProperty(context, get_key).FromMaybe(
+            false)) {
+      std::ignore = global->Delete(context, key);
+    }
+  }
+}
+
+}  // namespace
+
 ElectronRendererClient::ElectronRendererClient()
     : node_bindings_{NodeBindings::Create(
           NodeBindings::BrowserEnvironment::kRenderer)},
@@ -82,6 +158,38 @@ void ElectronRendererClient::DidCreateScriptContext(
   if (!ShouldLoadPreload(renderer_context, render_frame))
     return;
 
+  ScopedStartupTiming startup_timing(
+      "ElectronRendererClient::DidCreateScriptContext");
+
+  // Wait for the page to reach for Node.js before creating its environment.
+  if (ShouldCreateNodeEnvironmentLazily(render_frame)) {
+    lazy_frames_.insert(render_frame);
+    InstallLazyNodeGlobals(renderer_context);
+    return;
+  }
+
+  CreateNodeEnvironment(renderer_context, render_frame, true);
+}
+
+void ElectronRendererClient::EnsureNodeEnvironment(
+    content::RenderFrame* render_frame) {
+  if (lazy_frames_.erase(render_frame) == 0)
+    return;
+
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::Context> context =
+      GetContext(render_frame->GetWebFrame(), isolate);
+  v8::Context::Scope context_scope(context);
+  RemoveLazyNodeGlobals(context);
+  // The page is already running, so there is no load left to defer.
+  CreateNodeEnvironment(context, render_frame, false);
+}
+
+void ElectronRendererClient::CreateNodeEnvironment(
+    v8::Handle<v8::Context> renderer_context,
+    content::RenderFrame* render_frame,
+    bool defer_load) {
   injected_frames_.insert(render_frame);
 
   if (!node_integration_initialized_) {
@@ -102,13 +210,17 @@ void ElectronRendererClient::DidCreateScriptContext(
   // loading the body of this frame.  We will undefer the load once the preload
   // script has finished.  This allows our preload script to run async (E.g.
   // with ESM) without the preload being in a race
-  render_frame->GetWebFrame()->GetDocumentLoader()->SetDefersLoading(
-      blink::LoaderFreezeMode::kStrict);
+  std::optional<base::RepeatingCallback<void()>> on_app_code_ready;
+  if (defer_load) {
+    render_frame->GetWebFrame()->GetDocumentLoader()->SetDefersLoading(
+        blink::LoaderFreezeMode::kStrict);
+    on_app_code_ready =
+        base::BindRepeating(&ElectronRendererClient::UndeferLoad,
+                            base::Unretained(this), render_frame);
+  }
 
   std::shared_ptr<node::Environment> env = node_bindings_->CreateEnvironment(
-      renderer_context, nullptr,
-      base::BindRepeating(&ElectronRendererClient::UndeferLoad,
-                          base::Unretained(this), render_frame));
+      renderer_context, nullptr, std::move(on_app_code_ready));
 
   // If we have disabled the site instance overrides we should prevent loading
   // any non-context aware native module.
@@ -139,6 +251,7 @@ void ElectronRendererClient::DidCreateScriptContext(
 void ElectronRendererClient::WillReleaseScriptContext(
     v8::Handle<v8::Context> context,
     content::RenderFrame* render_frame) {
+  lazy_frames_.erase(render_frame);
   if (injected_frames_.erase(render_frame) == 0)
     return;
 
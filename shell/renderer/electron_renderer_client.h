@@ -33,8 +33,12 @@ class ElectronRendererClient : public RendererClientBase {
                               content::RenderFrame* render_frame) override;
   void WillReleaseScriptContext(v8::Handle<v8::Context> context,
                                 content::RenderFrame* render_frame) override;
+  void EnsureNodeEnvironment(content::RenderFrame* render_frame) override;
 
  private:
+  void CreateNodeEnvironment(v8::Handle<v8::Context> context,
+                             content::RenderFrame* render_frame,
+                             bool defer_load);
   void UndeferLoad(content::RenderFrame* render_frame);
 
   // content::ContentRendererClient:
@@ -63,6 +67,10 @@ class ElectronRendererClient : public RendererClientBase {
   // its script context. Doing so in a web page without scripts would trigger
   // assertion, so we have to keep a book of injected web frames.
   base::flat_set<content::RenderFrame*> injected_frames_;
+
+  // Frames with lazyNodeIntegration whose environment has not been created
+  // yet.
+  base::flat_set<content::RenderFrame*> lazy_frames_;
 };
 
 }  // namespace electron
@@ -17,6 +17,7 @@
 #include "base/process/process_metrics.h"
 #include "content/public/renderer/render_frame.h"
 #include "electron/buildflags/buildflags.h"
+#include "gin/data_object_builder.h"
 #include "shell/common/api/electron_bindings.h"
 #include "shell/common/application_info.h"
 #include "shell/common/gin_helper/dictionary.h"
@@ -25,6 +26,7 @@
 #include "shell/common/node_includes.h"
 #include "shell/common/node_util.h"
 #include "shell/common/options_switches.h"
+#include "shell/common/startup_timings.h"
 #include "shell/renderer/electron_render_frame_observer.h"
 #include "third_party/blink/public/common/web_preferences/web_preferences.h"
 #include "third_party/blink/public/platform/scheduler/web_agent_group_scheduler.h"
@@ -83,14 +85,37 @@ v8::Local<v8::Value> GetBinding(v8::Isolate* isolate,
   return exports;
 }
 
+// Compiles the wrapped preload |source|, consuming |cached_data| when it is a
+// code cache that the browser made for it. A rejected cache is ignored and the
+// source compiled as usual.
 v8::Local<v8::Value> CreatePreloadScript(v8::Isolate* isolate,
-                                         v8::Local<v8::String> source) {
+                                         v8::Local<v8::String> source,
+                                         v8::Local<v8::Value> cached_data) {
   auto context = isolate->GetCurrentContext();
-  auto maybe_script = v8::Script::Compile(context, source);
+
+  v8::ScriptCompiler::CachedData* cache = nullptr;
+  if (cached_data->IsArrayBufferView()) {
+    auto view = cached_data.As<v8::ArrayBufferView>();
+    const size_t length = view->ByteLength();
+    auto* data = new uint8_t[length];
+    view->CopyContents(data, length);
+    cache = new v8::ScriptCompiler::CachedData(
+        data, length, v8::ScriptCompiler::CachedData::BufferOwned);
+  }
+
+  // |script_source| takes ownership of |cache|.
+  v8::ScriptCompiler::Source script_source(source, cache);
+  auto maybe_script = v8::ScriptCompiler::Compile(
+      context, &script_source,
+      cache ? v8::ScriptCompiler::kConsumeCodeCache
+            : v8::ScriptCompiler::kNoCompileOptions);
   v8::Local<v8::Script> script;
   if (!maybe_script.ToLocal(&script))
     return v8::Local<v8::Value>();
-  return script->Run(context).ToLocalChecked();
+
+  gin::DataObjectBuilder result(isolate);
+  result.Set("preloadFn", script->Run(context).ToLocalChecked());
+  return result.Build();
 }
 
 double Uptime() {
@@ -178,6 +203,9 @@ void ElectronSandboxedRendererClient::DidCreateScriptContext(
   if (!ShouldLoadPreload(context, render_frame))
     return;
 
+  ScopedStartupTiming startup_timing(
+      "ElectronSandboxedRendererClient::DidCreateScriptContext");
+
   injected_frames_.insert(render_frame);
 
   // Wrap the bundle into a function that receives the binding object as
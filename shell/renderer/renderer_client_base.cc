@@ -16,6 +16,7 @@
 #include "content/common/buildflags.h"
 #include "content/public/common/content_constants.h"
 #include "content/public/common/content_switches.h"
+#include "content/public/common/url_constants.h"
 #include "content/public/renderer/render_frame.h"
 #include "content/public/renderer/render_thread.h"
 #include "electron/buildflags/buildflags.h"
@@ -28,6 +29,7 @@
 #include "shell/common/node_includes.h"
 #include "shell/common/node_util.h"
 #include "shell/common/options_switches.h"
+#include "shell/common/startup_timings.h"
 #include "shell/common/world_ids.h"
 #include "shell/renderer/api/context_bridge/object_cache.h"
 #include "shell/renderer/api/electron_api_context_bridge.h"
@@ -226,6 +228,7 @@ bool RendererClientBase::ShouldLoadPreload(
 }
 
 void RendererClientBase::RenderThreadStarted() {
+  ScopedStartupTiming startup_timing("RendererClientBase::RenderThreadStarted");
   auto* command_line = base::CommandLine::ForCurrentProcess();
 
   // Enable MessagePort close event by default.
@@ -298,6 +301,8 @@ void RendererClientBase::RenderThreadStarted() {
     blink::WebSecurityPolicy::RegisterURLSchemeAsCodeCacheWithHashing(
         blink::WebString::FromASCII(scheme));
   }
+  blink::WebSecurityPolicy::RegisterURLSchemeAsCodeCacheWithHashing(
+      blink::WebString::FromASCII(content::kChromeDevToolsScheme));
 
   // Allow file scheme to handle service worker by default.
   // FIXME(zcbenz): Can this be moved elsewhere?
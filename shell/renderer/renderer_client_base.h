@@ -65,6 +65,8 @@ class RendererClientBase : public content::ContentRendererClient
   virtual void WillReleaseScriptContext(v8::Handle<v8::Context> context,
                                         content::RenderFrame* render_frame) = 0;
   virtual void DidClearWindowObject(content::RenderFrame* render_frame);
+  // Creates the Node environment of |render_frame| now if it was put off.
+  virtual void EnsureNodeEnvironment(content::RenderFrame* render_frame) {}
   virtual void SetupMainWorldOverrides(v8::Handle<v8::Context> context,
                                        content::RenderFrame* render_frame);
 
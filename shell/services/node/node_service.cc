@@ -19,6 +19,7 @@
 #include "shell/common/node_bindings.h"
 #include "shell/common/node_includes.h"
 #include "shell/services/node/parent_port.h"
+#include "shell/services/node/utility_protocol_registry.h"
 
 namespace electron {
 
@@ -61,15 +62,26 @@ NodeService::NodeService(
 }
 
 NodeService::~NodeService() {
-  if (!node_env_stopped_) {
+  if (node_env_ && !node_env_stopped_) {
     node_env_->set_trace_sync_io(false);
     js_env_->DestroyMicrotasksRunner();
     node::Stop(node_env_.get(), node::StopFlags::kDoNotTerminateIsolate);
   }
 }
 
+void NodeService::WarmUp() {
+  if (js_env_)
+    return;
+
+  js_env_ = std::make_unique<JavascriptEnvironment>(node_bindings_->uv_loop());
+
+  v8::HandleScope scope(js_env_->isolate());
+
+  node_bindings_->Initialize(js_env_->isolate()->GetCurrentContext());
+}
+
 void NodeService::Initialize(node::mojom::NodeServiceParamsPtr params) {
-  if (NodeBindings::IsInitialized())
+  if (node_env_)
     return;
 
   ParentPort::GetInstance()->Initialize(std::move(params->port));
@@ -78,12 +90,10 @@ void NodeService::Initialize(node::mojom::NodeServiceParamsPtr params) {
       std::move(params->url_loader_factory),
       mojo::Remote(std::move(params->host_resolver)));
 
-  js_env_ = std::make_unique<JavascriptEnvironment>(node_bindings_->uv_loop());
+  WarmUp();
 
   v8::HandleScope scope(js_env_->isolate());
 
-  node_bindings_->Initialize(js_env_->isolate()->GetCurrentContext());
-
   // Append program path for process.argv0
   auto program = base::CommandLine::ForCurrentProcess()->GetProgram();
 #if defined(OS_WIN)
@@ -137,4 +147,17 @@ void NodeService::Initialize(node::mojom::NodeServiceParamsPtr params) {
   node_bindings_->StartPolling();
 }
 
+void NodeService::BindProtocolHandler(
+    const std::string& scheme,
+    mojo::PendingReceiver<network::mojom::URLLoaderFactory> factory) {
+  UtilityProtocolRegistry::GetInstance()->BindFactory(scheme,
+                                                      std::move(factory));
+}
+
+void NodeService::OpenStream(mojo::ScopedDataPipeConsumerHandle consumer,
+                             mojo::ScopedDataPipeProducerHandle producer) {
+  ParentPort::GetInstance()->OpenStream(std::move(consumer),
+                                        std::move(producer));
+}
+
 }  // namespace electron
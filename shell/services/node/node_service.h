@@ -6,6 +6,7 @@
 #define ELECTRON_SHELL_SERVICES_NODE_NODE_SERVICE_H_
 
 #include <memory>
+#include <string>
 
 #include "mojo/public/cpp/bindings/pending_receiver.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
@@ -58,7 +59,13 @@ class NodeService : public node::mojom::NodeService {
   NodeService& operator=(const NodeService&) = delete;
 
   // mojom::NodeService implementation:
+  void WarmUp() override;
   void Initialize(node::mojom::NodeServiceParamsPtr params) override;
+  void BindProtocolHandler(
+      const std::string& scheme,
+      mojo::PendingReceiver<network::mojom::URLLoaderFactory> factory) override;
+  void OpenStream(mojo::ScopedDataPipeConsumerHandle consumer,
+                  mojo::ScopedDataPipeProducerHandle producer) override;
 
  private:
   // This needs to be initialized first so that it can be destroyed last
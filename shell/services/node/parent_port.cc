@@ -6,10 +6,12 @@
 
 #include <utility>
 
+#include "base/functional/bind.h"
 #include "base/no_destructor.h"
 #include "gin/data_object_builder.h"
 #include "gin/handle.h"
 #include "shell/browser/api/message_port.h"
+#include "shell/common/data_pipe_stream.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/event_emitter_caller.h"
 #include "shell/common/node_includes.h"
@@ -44,7 +46,9 @@ void ParentPort::PostMessage(v8::Local<v8::Value> message_value) {
   if (!connector_closed_ && connector_ && connector_->is_valid()) {
     v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
     blink::TransferableMessage transferable_message;
-    electron::SerializeV8Value(isolate, message_value, &transferable_message);
+    if (!electron::SerializeV8Value(isolate, message_value,
+                                    &transferable_message))
+      return;
     mojo::Message mojo_message =
         blink::mojom::TransferableMessage::WrapAsMessage(
             std::move(transferable_message));
@@ -53,6 +57,7 @@ void ParentPort::PostMessage(v8::Local<v8::Value> message_value) {
 }
 
 void ParentPort::Close() {
+  regions_waiter_.Cancel();
   if (!connector_closed_ && connector_->is_valid()) {
     port_.GiveDisentangledHandle(connector_->PassMessagePipe());
     connector_ = nullptr;
@@ -62,17 +67,49 @@ void ParentPort::Close() {
 }
 
 void ParentPort::Start() {
-  if (!connector_closed_ && connector_ && connector_->is_valid()) {
+  started_ = true;
+  if (!connector_closed_ && connector_ && connector_->is_valid() &&
+      !regions_waiter_.IsWaiting()) {
     connector_->ResumeIncomingMethodCallProcessing();
   }
 }
 
 void ParentPort::Pause() {
+  started_ = false;
   if (!connector_closed_ && connector_ && connector_->is_valid()) {
     connector_->PauseIncomingMethodCallProcessing();
   }
 }
 
+void ParentPort::OpenStream(mojo::ScopedDataPipeConsumerHandle consumer,
+                            mojo::ScopedDataPipeProducerHandle producer) {
+  if (!streams_started_) {
+    pending_streams_.emplace_back(std::move(consumer), std::move(producer));
+    return;
+  }
+  EmitStream(std::move(consumer), std::move(producer));
+}
+
+void ParentPort::StartStreams() {
+  if (streams_started_)
+    return;
+  streams_started_ = true;
+  for (auto& [consumer, producer] : std::exchange(pending_streams_, {}))
+    EmitStream(std::move(consumer), std::move(producer));
+}
+
+void ParentPort::EmitStream(mojo::ScopedDataPipeConsumerHandle consumer,
+                            mojo::ScopedDataPipeProducerHandle producer) {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::Object> self;
+  if (!GetWrapper(isolate).ToLocal(&self))
+    return;
+  auto stream =
+      DataPipeStream::Create(isolate, std::move(consumer), std::move(producer));
+  gin_helper::EmitEvent(isolate, self, "stream", stream);
+}
+
 bool ParentPort::Accept(mojo::Message* mojo_message) {
   blink::TransferableMessage message;
   if (!blink::mojom::TransferableMessage::DeserializeFromMessage(
@@ -80,12 +117,30 @@ bool ParentPort::Accept(mojo::Message* mojo_message) {
     return false;
   }
 
+  if (regions_waiter_.Wait(
+          message, base::BindOnce(&ParentPort::OnSharedArrayBuffersArrived,
+                                  base::Unretained(this)))) {
+    connector_->PauseIncomingMethodCallProcessing();
+    return true;
+  }
+  return AcceptMessage(std::move(message));
+}
+
+void ParentPort::OnSharedArrayBuffersArrived(
+    blink::TransferableMessage message) {
+  AcceptMessage(std::move(message));
+  // The listeners may have paused or closed the port.
+  if (started_ && !connector_closed_ && connector_)
+    connector_->ResumeIncomingMethodCallProcessing();
+}
+
+bool ParentPort::AcceptMessage(blink::TransferableMessage message) {
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::Value> message_value =
+      electron::DeserializeV8Value(isolate, &message);
   auto wrapped_ports =
       MessagePort::EntanglePorts(isolate, std::move(message.ports));
-  v8::Local<v8::Value> message_value =
-      electron::DeserializeV8Value(isolate, message);
   v8::Local<v8::Object> self;
   if (!GetWrapper(isolate).ToLocal(&self))
     return false;
@@ -108,7 +163,8 @@ gin::ObjectTemplateBuilder ParentPort::GetObjectTemplateBuilder(
   return gin::Wrappable<ParentPort>::GetObjectTemplateBuilder(isolate)
       .SetMethod("postMessage", &ParentPort::PostMessage)
       .SetMethod("start", &ParentPort::Start)
-      .SetMethod("pause", &ParentPort::Pause);
+      .SetMethod("pause", &ParentPort::Pause)
+      .SetMethod("startStreams", &ParentPort::StartStreams);
 }
 
 const char* ParentPort::GetTypeName() {
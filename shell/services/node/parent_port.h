@@ -6,11 +6,15 @@
 #define ELECTRON_SHELL_SERVICES_NODE_PARENT_PORT_H_
 
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "gin/wrappable.h"
 #include "mojo/public/cpp/bindings/connector.h"
 #include "mojo/public/cpp/bindings/message.h"
+#include "mojo/public/cpp/system/data_pipe.h"
 #include "shell/browser/event_emitter_mixin.h"
+#include "shell/common/v8_value_serializer.h"
 
 namespace v8 {
 template <class T>
@@ -43,6 +47,11 @@ class ParentPort : public gin::Wrappable<ParentPort>,
   ~ParentPort() override;
   void Initialize(blink::MessagePortDescriptor port);
 
+  // Emits a 'stream' event for the utility process' end of a stream opened by
+  // the browser. Streams are held until a 'stream' listener is added.
+  void OpenStream(mojo::ScopedDataPipeConsumerHandle consumer,
+                  mojo::ScopedDataPipeProducerHandle producer);
+
   // gin::Wrappable
   static gin::WrapperInfo kWrapperInfo;
   gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
@@ -54,13 +63,27 @@ class ParentPort : public gin::Wrappable<ParentPort>,
   void Close();
   void Start();
   void Pause();
+  void StartStreams();
+  void EmitStream(mojo::ScopedDataPipeConsumerHandle consumer,
+                  mojo::ScopedDataPipeProducerHandle producer);
+
+  bool AcceptMessage(blink::TransferableMessage message);
+  void OnSharedArrayBuffersArrived(blink::TransferableMessage message);
 
   // mojo::MessageReceiver
   bool Accept(mojo::Message* mojo_message) override;
 
+  bool started_ = false;
   bool connector_closed_ = false;
   std::unique_ptr<mojo::Connector> connector_;
   blink::MessagePortDescriptor port_;
+  bool streams_started_ = false;
+  std::vector<std::pair<mojo::ScopedDataPipeConsumerHandle,
+                        mojo::ScopedDataPipeProducerHandle>>
+      pending_streams_;
+  // Holds back the message whose SharedArrayBuffers are still on their way,
+  // with |connector_| paused so that the next ones wait behind it.
+  SharedArrayBufferRegionsWaiter regions_waiter_;
 };
 
 }  // namespace electron
@@ -0,0 +1,136 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/services/node/utility_protocol_registry.h"
+
+#include <utility>
+#include <vector>
+
+#include "base/containers/contains.h"
+#include "base/functional/bind.h"
+#include "base/no_destructor.h"
+#include "shell/common/gin_converters/callback_converter.h"
+#include "shell/common/gin_converters/net_converter.h"
+#include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/node_includes.h"
+
+namespace electron {
+
+namespace {
+
+// How many requests may wait for their scheme's handler to be registered.
+constexpr size_t kMaxPendingRequests = 256;
+
+}  // namespace
+
+// static
+UtilityProtocolRegistry* UtilityProtocolRegistry::GetInstance() {
+  static base::NoDestructor<UtilityProtocolRegistry> instance;
+  return instance.get();
+}
+
+UtilityProtocolRegistry::UtilityProtocolRegistry() = default;
+
+UtilityProtocolRegistry::~UtilityProtocolRegistry() = default;
+
+UtilityProtocolRegistry::PendingRequest::PendingRequest(
+    const network::ResourceRequest& request,
+    StartLoadingCallback callback)
+    : request(request), callback(std::move(callback)) {}
+
+UtilityProtocolRegistry::PendingRequest::PendingRequest(PendingRequest&&) =
+    default;
+
+UtilityProtocolRegistry::PendingRequest::~PendingRequest() = default;
+
+void UtilityProtocolRegistry::BindFactory(
+    const std::string& scheme,
+    mojo::PendingReceiver<network::mojom::URLLoaderFactory> receiver) {
+  ElectronURLLoaderFactory::Create(
+      ProtocolType::kFree,
+      base::BindRepeating(&UtilityProtocolRegistry::HandleRequest,
+                          base::Unretained(this), scheme),
+      std::move(receiver));
+}
+
+bool UtilityProtocolRegistry::RegisterProtocol(const std::string& scheme,
+                                               const ProtocolHandler& handler) {
+  if (!handlers_.try_emplace(scheme, handler).second)
+    return false;
+  unregistered_schemes_.erase(scheme);
+
+  auto [begin, end] = pending_requests_.equal_range(scheme);
+  std::vector<PendingRequest> requests;
+  for (auto it = begin; it != end; ++it)
+    requests.push_back(std::move(it->second));
+  pending_requests_.erase(begin, end);
+  for (auto& pending : requests)
+    handler.Run(pending.request, std::move(pending.callback));
+  return true;
+}
+
+bool UtilityProtocolRegistry::UnregisterProtocol(const std::string& scheme) {
+  unregistered_schemes_.insert(scheme);
+  // Dropping the callbacks closes the clients of the requests, which fails
+  // them.
+  pending_requests_.erase(scheme);
+  return handlers_.erase(scheme) != 0;
+}
+
+bool UtilityProtocolRegistry::IsProtocolRegistered(
+    const std::string& scheme) const {
+  return base::Contains(handlers_, scheme);
+}
+
+void UtilityProtocolRegistry::HandleRequest(
+    const std::string& scheme,
+    const network::ResourceRequest& request,
+    StartLoadingCallback callback) {
+  auto it = handlers_.find(scheme);
+  if (it == handlers_.end()) {
+    // Otherwise |callback| is dropped, which fails the request.
+    if (!base::Contains(unregistered_schemes_, scheme) &&
+        pending_requests_.size() < kMaxPendingRequests) {
+      pending_requests_.emplace(scheme,
+                                PendingRequest(request, std::move(callback)));
+    }
+    return;
+  }
+  it->second.Run(request, std::move(callback));
+}
+
+}  // namespace electron
+
+namespace {
+
+bool RegisterProtocol(const std::string& scheme,
+                      const electron::ProtocolHandler& handler) {
+  return electron::UtilityProtocolRegistry::GetInstance()->RegisterProtocol(
+      scheme, handler);
+}
+
+bool UnregisterProtocol(const std::string& scheme) {
+  return electron::UtilityProtocolRegistry::GetInstance()->UnregisterProtocol(
+      scheme);
+}
+
+bool IsProtocolRegistered(const std::string& scheme) {
+  return electron::UtilityProtocolRegistry::GetInstance()->IsProtocolRegistered(
+      scheme);
+}
+
+void Initialize(v8::Local<v8::Object> exports,
+                v8::Local<v8::Value> unused,
+                v8::Local<v8::Context> context,
+                void* priv) {
+  v8::Isolate* isolate = context->GetIsolate();
+  gin_helper::Dictionary dict(isolate, exports);
+  dict.SetMethod("registerProtocol", &RegisterProtocol);
+  dict.SetMethod("unregisterProtocol", &UnregisterProtocol);
+  dict.SetMethod("isProtocolRegistered", &IsProtocolRegistered);
+}
+
+}  // namespace
+
+NODE_LINKED_BINDING_CONTEXT_AWARE(electron_utility_protocol, Initialize)
@@ -0,0 +1,68 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_SERVICES_NODE_UTILITY_PROTOCOL_REGISTRY_H_
+#define ELECTRON_SHELL_SERVICES_NODE_UTILITY_PROTOCOL_REGISTRY_H_
+
+#include <map>
+#include <set>
+#include <string>
+
+#include "mojo/public/cpp/bindings/pending_receiver.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/mojom/url_loader_factory.mojom.h"
+#include "shell/browser/net/electron_url_loader_factory.h"
+
+namespace electron {
+
+// Keeps the protocol handlers registered in a utility process, and serves the
+// URLLoaderFactory receivers that the browser binds for their schemes. There
+// is only a single instance for the lifetime of a Utility Process.
+class UtilityProtocolRegistry {
+ public:
+  static UtilityProtocolRegistry* GetInstance();
+
+  UtilityProtocolRegistry();
+  ~UtilityProtocolRegistry();
+
+  UtilityProtocolRegistry(const UtilityProtocolRegistry&) = delete;
+  UtilityProtocolRegistry& operator=(const UtilityProtocolRegistry&) = delete;
+
+  // Serves |receiver| with whichever handler is registered for |scheme| when
+  // each request arrives. Requests that arrive before the first handler is
+  // registered wait for it, up to a limit, while those that arrive after the
+  // handler has been unregistered fail.
+  void BindFactory(
+      const std::string& scheme,
+      mojo::PendingReceiver<network::mojom::URLLoaderFactory> receiver);
+
+  bool RegisterProtocol(const std::string& scheme,
+                        const ProtocolHandler& handler);
+  bool UnregisterProtocol(const std::string& scheme);
+  bool IsProtocolRegistered(const std::string& scheme) const;
+
+ private:
+  struct PendingRequest {
+    PendingRequest(const network::ResourceRequest& request,
+                   StartLoadingCallback callback);
+    PendingRequest(PendingRequest&&);
+    ~PendingRequest();
+
+    network::ResourceRequest request;
+    StartLoadingCallback callback;
+  };
+
+  void HandleRequest(const std::string& scheme,
+                     const network::ResourceRequest& request,
+                     StartLoadingCallback callback);
+
+  std::map<std::string, ProtocolHandler> handlers_;
+  std::multimap<std::string, PendingRequest> pending_requests_;
+  // Schemes whose handler has been unregistered and not registered again.
+  std::set<std::string> unregistered_schemes_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_SERVICES_NODE_UTILITY_PROTOCOL_REGISTRY_H_
@@ -6,9 +6,9 @@ import * as net from 'node:net';
 import * as fs from 'fs-extra';
 import * as path from 'node:path';
 import { promisify } from 'node:util';
-import { app, BrowserWindow, Menu, session, net as electronNet, WebContents, utilityProcess } from 'electron/main';
+import { app, BrowserWindow, dialog, Menu, session, net as electronNet, WebContents, utilityProcess } from 'electron/main';
 import { closeWindow, closeAllWindows } from './lib/window-helpers';
-import { ifdescribe, ifit, listen, waitUntil } from './lib/spec-helpers';
+import { defer, ifdescribe, ifit, listen, repeatedly, waitUntil } from './lib/spec-helpers';
 import { collectStreamBody, getResponse } from './lib/net-helpers';
 import { once } from 'node:events';
 import split = require('split')
@@ -1455,9 +1455,14 @@ describe('app module', () => {
           expect(entry).to.have.property('name').that.is.a('string');
         }
 
+        expect(entry.memory).to.have.property('privateBytes').that.is.a('number');
         if (process.platform === 'win32') {
           expect(entry.memory).to.have.property('privateBytes').that.is.greaterThan(0);
         }
+        if (process.platform === 'linux' && entry.type === 'Browser') {
+          expect(entry.memory).to.have.property('privateBytes').that.is.greaterThan(0);
+          expect(entry.memory).to.have.property('proportionalSetSize').that.is.greaterThan(0);
+        }
 
         if (process.platform !== 'linux') {
           expect(entry.sandboxed).to.be.a('boolean');
@@ -1474,6 +1479,118 @@ describe('app module', () => {
 
       expect(types).to.include('Browser');
     });
+
+    it('attributes renderer processes to their webContents', async () => {
+      const w = new BrowserWindow({ show: false });
+      defer(() => w.destroy());
+      await w.loadURL('about:blank');
+
+      const renderer = app.getAppMetrics().find(entry => entry.pid === w.webContents.getOSProcessId());
+      expect(renderer).to.have.property('type', 'Tab');
+      expect(renderer!.webContentsIds).to.include(w.webContents.id);
+    });
+  });
+
+  describe('startMetricsSampling() API', () => {
+    afterEach(() => {
+      app.stopMetricsSampling();
+    });
+
+    it('keeps the most recent samples of each process', async () => {
+      app.startMetricsSampling({ interval: 20, sampleCount: 3 });
+      const samples = await repeatedly(() => app.getMetricsSamples(), {
+        until: samples => samples.some(entry => entry.type === 'Browser' && entry.timestamps.length === 3)
+      });
+      const browser = samples.find(entry => entry.type === 'Browser')!;
+      expect(browser.pid).to.equal(process.pid);
+      expect(browser.timestamps).to.be.an.instanceOf(Float64Array).with.lengthOf(3);
+      for (const key of ['percentCPUUsage', 'workingSetSize', 'handleCount', 'ioReadBytes', 'ioWriteBytes'] as const) {
+        expect(browser[key]).to.be.an.instanceOf(Float64Array).with.lengthOf(3);
+      }
+      expect(browser.workingSetSize[2]).to.be.greaterThan(0);
+      expect(browser.timestamps[2]).to.be.greaterThan(browser.timestamps[0]);
+    });
+
+    it('appends the samples to a file', async () => {
+      const dir = await fs.mkdtemp(path.join(app.getPath('temp'), 'electron-metrics-'));
+      const file = path.join(dir, 'metrics.csv');
+      try {
+        app.startMetricsSampling({ interval: 20, path: file });
+        await waitUntil(() => fs.existsSync(file) && fs.readFileSync(file, 'utf8').split('\n').length > 2);
+        app.stopMetricsSampling();
+
+        const [header, row] = fs.readFileSync(file, 'utf8').split('\n');
+        expect(header).to.equal('timestamp,pid,type,percentCPUUsage,workingSetSize,handleCount,ioReadBytes,ioWriteBytes');
+        expect(row.split(',')).to.have.lengthOf(8);
+      } finally {
+        await fs.remove(dir);
+      }
+    });
+
+    it('validates its options', () => {
+      expect(() => app.startMetricsSampling({ interval: 0 })).to.throw('interval must be at least 10 milliseconds');
+      expect(() => app.startMetricsSampling({ sampleCount: 0 })).to.throw('sampleCount must be a positive number');
+    });
+
+    it('rejects getMetricsSamples() when it is not running', async () => {
+      await expect(app.getMetricsSamples()).to.eventually.be.rejectedWith('Metrics sampling has not been started');
+    });
+  });
+
+  describe('setLongTaskThreshold() API', () => {
+    afterEach(() => {
+      app.setLongTaskThreshold(0);
+    });
+
+    it('emits long-task for tasks running longer than the threshold', async () => {
+      app.setLongTaskThreshold(50);
+      const longTask = once(app, 'long-task');
+      setTimeout(function blockMainThread () {
+        const end = Date.now() + 200;
+        while (Date.now() < end);
+      });
+      const [, details] = await longTask;
+      expect(details.duration).to.be.at.least(200);
+      expect(details.postedFrom).to.be.a('string').that.is.not.empty();
+      expect(details.jsStack).to.include('blockMainThread');
+    });
+
+    const dialogBinding = process._linkedBinding('electron_browser_dialog');
+    ifit(dialogBinding._setMessageBoxSyncResponseForTesting != null)('reports the synchronous dialog that blocked a task', async () => {
+      app.setLongTaskThreshold(50);
+      dialogBinding._setMessageBoxSyncResponseForTesting(1, 200);
+      const longTask = once(app, 'long-task');
+      let response = -1;
+      setTimeout(function showDialog () {
+        response = dialog.showMessageBoxSync({ message: 'test', buttons: ['a', 'b'] });
+      });
+      const [, details] = await longTask;
+      expect(response).to.equal(1);
+      expect(details.blockedBy).to.equal('dialog.showMessageBoxSync');
+      expect(details.duration).to.be.at.least(200);
+      expect(details.jsStack).to.include('showDialog');
+    });
+
+    it('validates the threshold', () => {
+      expect(() => app.setLongTaskThreshold(-1)).to.throw('threshold must be a non-negative number');
+    });
+  });
+
+  describe('setNearHeapLimitHeadroom() API', () => {
+    it('raises the heap limit once and emits near-heap-limit', async () => {
+      const appPath = path.join(fixturesPath, 'api', 'near-heap-limit.js');
+      const appProcess = cp.spawn(process.execPath, ['--browser-js-flags=--max-old-space-size=128', appPath]);
+      let output = '';
+      appProcess.stdout.on('data', (data) => { output += data; });
+      const [code] = await once(appProcess, 'exit');
+      expect(code).to.equal(0);
+      const details = JSON.parse(output.trim().split('\n').pop()!);
+      expect(details.heapLimit - details.initialHeapLimit).to.equal(64 * 1024);
+    });
+
+    it('validates the headroom', () => {
+      expect(() => app.setNearHeapLimitHeadroom(-1)).to.throw('headroom must be a non-negative number');
+    });
   });
 
   describe('getGPUFeatureStatus() API', () => {
@@ -1484,6 +1601,26 @@ describe('app module', () => {
     });
   });
 
+  describe('discardHiddenFrames() API', () => {
+    afterEach(closeAllWindows);
+
+    it('repaints a page that is shown again', async () => {
+      // The background color is what shows until the page paints.
+      const w = new BrowserWindow({ show: false, width: 100, height: 100, backgroundColor: '#0000ff' });
+      await w.loadURL('data:text/html,<body style="background: red">');
+      w.show();
+      await w.webContents.executeJavaScript('new Promise(resolve => requestAnimationFrame(() => requestAnimationFrame(resolve)))');
+      w.hide();
+      app.discardHiddenFrames();
+      w.show();
+      await w.webContents.executeJavaScript('new Promise(resolve => requestAnimationFrame(() => requestAnimationFrame(resolve)))');
+      const image = await w.webContents.capturePage();
+      expect(image.isEmpty()).to.be.false();
+      const [b, g, r] = image.toBitmap();
+      expect([r, g, b]).to.deep.equal([255, 0, 0]);
+    });
+  });
+
   ifdescribe(!process.env.IS_ASAN)('getGPUInfo() API', () => {
     const appPath = path.join(fixturesPath, 'api', 'gpu-info.js');
 
@@ -1531,6 +1668,13 @@ describe('app module', () => {
       await verifyBasicGPUInfo(gpuInfo);
     });
 
+    it('resolves concurrent and later basic GPUInfo requests with the same info', async () => {
+      const [first, second] = await Promise.all([app.getGPUInfo('basic'), app.getGPUInfo('basic')]);
+      await verifyBasicGPUInfo(first);
+      expect(second).to.deep.equal(first);
+      expect(await app.getGPUInfo('basic')).to.deep.equal(first);
+    });
+
     it('succeeds with complete GPUInfo', async () => {
       const completeInfo = await getGPUInfo('complete');
       if (process.platform === 'linux') {
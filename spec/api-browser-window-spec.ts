@@ -2368,6 +2368,17 @@ describe('BrowserWindow module', () => {
       expect(hiddenImage.isEmpty()).to.equal(false);
     });
 
+    it('scales the image to the given size', async () => {
+      const w = new BrowserWindow({ show: false });
+      w.loadFile(path.join(fixtures, 'pages', 'a.html'));
+      await once(w, 'ready-to-show');
+      w.show();
+
+      const size = { width: 40, height: 30 };
+      const image = await w.capturePage(undefined, { size });
+      expect(image.getSize()).to.deep.equal(size);
+    });
+
     it('preserves transparency', async () => {
       const w = new BrowserWindow({ show: false, transparent: true });
       w.loadFile(path.join(fixtures, 'pages', 'theme-color.html'));
@@ -2524,6 +2535,33 @@ describe('BrowserWindow module', () => {
       expect(preconnectUrl).to.equal('http://example.com/');
       expect(allowCredentials).to.be.true('allowCredentials');
     });
+
+    it('preconnects to the origins a page used before when prediction is enabled', async () => {
+      const resourceServer = http.createServer((req, res) => { res.end(); });
+      defer(() => { resourceServer.close(); });
+      const resourceUrl = (await listen(resourceServer)).url;
+      server.removeAllListeners('request');
+      server.on('request', async (req, res) => {
+        res.setHeader('Content-type', 'text/html');
+        if (req.url === '/predict') {
+          res.end(`<img src="${resourceUrl}/image">`);
+        } else if (req.url === '/wait') {
+          // Only answers once the resource server has been preconnected to.
+          await once(resourceServer, 'connection');
+          res.end('waited');
+        } else {
+          res.end();
+        }
+      });
+      const ses = session.fromPartition(`${Math.random()}`);
+      ses.setPreconnectPredictionEnabled(true);
+      w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      await w.loadURL(url + '/predict');
+      // The page is learned once another one replaces it.
+      await w.loadURL(url);
+      await ses.closeAllConnections();
+      await w.loadURL(url + '/wait');
+    });
   });
 
   describe('BrowserWindow.setAutoHideCursor(autoHide)', () => {
@@ -2863,6 +2901,59 @@ describe('BrowserWindow module', () => {
     });
   });
 
+  describe('BrowserWindow.batchUpdate(callback)', () => {
+    afterEach(closeAllWindows);
+
+    it('applies the changes made in the callback', () => {
+      const w = new BrowserWindow({ show: false });
+      const bounds = { x: 10, y: 20, width: 300, height: 200 };
+      w.batchUpdate(() => {
+        w.setBounds(bounds);
+        w.batchUpdate(() => w.setBackgroundColor('#ff0000'));
+      });
+      expectBoundsEqual(w.getBounds(), bounds);
+      expect(w.getBackgroundColor()).to.equal('#FF0000');
+    });
+
+    it('ends the batch when the callback throws', () => {
+      const w = new BrowserWindow({ show: false });
+      expect(() => w.batchUpdate(() => { throw new Error('oops'); })).to.throw(/oops/);
+      expect(() => w.batchUpdate(() => w.setSize(300, 200))).to.not.throw();
+    });
+
+    it('throws for a callback that is not a function', () => {
+      const w = new BrowserWindow({ show: false });
+      expect(() => w.batchUpdate(null as any)).to.throw(/callback must be a function/);
+    });
+
+    it('keeps a hidden window hidden', () => {
+      const w = new BrowserWindow({ show: false });
+      w.batchUpdate(() => w.setSize(300, 200));
+      expect(w.isVisible()).to.be.false();
+    });
+
+    it('can hide a window', async () => {
+      const w = new BrowserWindow({ show: false });
+      const shown = once(w, 'show');
+      w.show();
+      await shown;
+      w.batchUpdate(() => {
+        expect(w.isVisible()).to.be.true();
+        w.hide();
+      });
+      expect(w.isVisible()).to.be.false();
+    });
+
+    it('can destroy the window', () => {
+      const w = new BrowserWindow({ show: false });
+      w.batchUpdate(() => w.destroy());
+      expect(w.isDestroyed()).to.be.true();
+      const other = new BrowserWindow({ show: false });
+      other.batchUpdate(() => other.setSize(300, 200));
+      expect(other.getSize()).to.deep.equal([300, 200]);
+    });
+  });
+
   describe('BrowserWindow.setOpacity(opacity)', () => {
     afterEach(closeAllWindows);
 
@@ -3474,6 +3565,37 @@ describe('BrowserWindow module', () => {
       });
     });
 
+    describe('"lazyNodeIntegration" option', () => {
+      it('creates the Node.js environment on first use of a Node.js global', async () => {
+        const w = new BrowserWindow({
+          show: false,
+          webPreferences: {
+            nodeIntegration: true,
+            contextIsolation: false,
+            lazyNodeIntegration: true
+          }
+        });
+        await w.loadFile(path.join(fixtures, 'api', 'blank.html'));
+        expect(await w.webContents.executeJavaScript('typeof Object.getOwnPropertyDescriptor(window, "process").get')).to.equal('function');
+        expect(await w.webContents.executeJavaScript('process.type')).to.equal('renderer');
+        expect(await w.webContents.executeJavaScript('require("node:path").basename("a/b.txt")')).to.equal('b.txt');
+        expect(await w.webContents.executeJavaScript('typeof Buffer.from')).to.equal('function');
+      });
+
+      it('lets the page replace a Node.js global before using Node.js', async () => {
+        const w = new BrowserWindow({
+          show: false,
+          webPreferences: {
+            nodeIntegration: true,
+            contextIsolation: false,
+            lazyNodeIntegration: true
+          }
+        });
+        await w.loadFile(path.join(fixtures, 'api', 'blank.html'));
+        expect(await w.webContents.executeJavaScript('window.module = 42; module')).to.equal(42);
+      });
+    });
+
     describe('"sandbox" option', () => {
       const preload = path.join(path.resolve(__dirname, 'fixtures'), 'module', 'preload-sandbox.js');
 
@@ -3526,6 +3648,28 @@ describe('BrowserWindow module', () => {
         expect(test).to.equal('preload');
       });
 
+      it('reloads a preload script that changed since it was last used', async () => {
+        const tmpDir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-preload-'));
+        defer(() => fs.rmSync(tmpDir, { recursive: true, force: true }));
+        const changingPreload = path.join(tmpDir, 'preload.js');
+        const answer = async (value: string) => {
+          fs.writeFileSync(changingPreload, `require('electron').ipcRenderer.send('answer', ${JSON.stringify(value)});`);
+          const w = new BrowserWindow({
+            show: false,
+            webPreferences: {
+              sandbox: true,
+              preload: changingPreload
+            }
+          });
+          defer(() => w.destroy());
+          w.loadURL('about:blank');
+          const [, test] = await once(ipcMain, 'answer');
+          return test;
+        };
+        expect(await answer('first')).to.equal('first');
+        expect(await answer('second one')).to.equal('second one');
+      });
+
       it('exposes "loaded" event to preload script', async () => {
         const w = new BrowserWindow({
           show: false,
@@ -4478,6 +4622,57 @@ describe('BrowserWindow module', () => {
       w.loadFile(path.join(fixtures, 'api', 'frame-subscriber.html'));
     });
 
+    it('subscribes to encoded frames', (done) => {
+      const w = new BrowserWindow({ show: false });
+      let called = false;
+      w.loadFile(path.join(fixtures, 'api', 'frame-subscriber.html'));
+      w.webContents.on('dom-ready', () => {
+        w.webContents.beginEncodedFrameSubscription({ codec: 'vp8' }, (chunk, info) => {
+          if (called) return;
+          called = true;
+
+          try {
+            expect(chunk).to.be.an.instanceOf(Buffer);
+            expect(chunk.length).to.be.greaterThan(0);
+            expect(info.keyFrame).to.be.true('first chunk is not a key frame');
+            done();
+          } catch (e) {
+            done(e);
+          } finally {
+            w.webContents.endFrameSubscription();
+          }
+        });
+      });
+    });
+
+    it('subscribes to frames scaled to a size in i420', (done) => {
+      const w = new BrowserWindow({ show: false });
+      let called = false;
+      w.loadFile(path.join(fixtures, 'api', 'frame-subscriber.html'));
+      w.webContents.on('dom-ready', () => {
+        const size = { width: 64, height: 64 };
+        w.webContents.beginFrameSubscription({ size, format: 'i420' }, (image, dirtyRect, frame) => {
+          if (called) return;
+          called = true;
+
+          try {
+            expect(image.isEmpty()).to.be.true('image is not empty');
+            expect(frame!.format).to.equal('i420');
+            expect(frame!.size.width).to.be.at.most(size.width);
+            expect(frame!.size.height).to.be.at.most(size.height);
+            const { width, height } = frame!.size;
+            const chroma = Math.ceil(width / 2) * Math.ceil(height / 2);
+            expect(frame!.data.length).to.equal(width * height + 2 * chroma);
+            done();
+          } catch (e) {
+            done(e);
+          } finally {
+            w.webContents.endFrameSubscription();
+          }
+        });
+      });
+    });
+
     it('throws error when subscriber is not well defined', () => {
       const w = new BrowserWindow({ show: false });
       expect(() => {
@@ -4554,6 +4749,30 @@ describe('BrowserWindow module', () => {
       } catch {}
     });
 
+    it('should stream MHTML to disk with streamToFile', async () => {
+      const tmpDir = await fs.promises.mkdtemp(path.resolve(os.tmpdir(), 'electron-mhtml-save-'));
+      const savePageMHTMLPath = path.join(tmpDir, 'save_page.mhtml');
+      defer(() => fs.promises.rm(tmpDir, { force: true, recursive: true }));
+      const w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(fixtures, 'pages', 'save_page', 'index.html'));
+      let downloaded = false;
+      w.webContents.session.once('will-download', () => { downloaded = true; });
+      await w.webContents.savePage(savePageMHTMLPath, 'MHTML', { streamToFile: true });
+
+      expect(downloaded).to.be.false('will-download');
+      const contents = await fs.promises.readFile(savePageMHTMLPath, 'utf8');
+      expect(contents).to.match(/^From: <Saved by Blink>/);
+      expect(contents).to.include('text/css');
+    });
+
+    it('should reject streamToFile for types other than MHTML', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(fixtures, 'pages', 'save_page', 'index.html'));
+      await expect(
+        w.webContents.savePage(savePageHtmlPath, 'HTMLComplete', { streamToFile: true })
+      ).to.eventually.be.rejectedWith('streamToFile is only supported when saving as MHTML');
+    });
+
     it('should save page to disk with HTMLComplete', async () => {
       const w = new BrowserWindow({ show: false });
       await w.loadFile(path.join(fixtures, 'pages', 'save_page', 'index.html'));
@@ -6342,6 +6561,88 @@ describe('BrowserWindow module', () => {
       w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
     });
 
+    it('only paints the dirty rect when dirtyRectOnly is set', async () => {
+      const dw = new BrowserWindow({
+        width: 100,
+        height: 100,
+        show: false,
+        webPreferences: {
+          backgroundThrottling: false,
+          offscreen: { dirtyRectOnly: true }
+        }
+      });
+      const paint = once(dw.webContents, 'paint') as Promise<[any, Electron.Rectangle, Electron.NativeImage]>;
+      dw.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
+      const [, dirty, image] = await paint;
+      expect(image.isEmpty()).to.be.false('image is empty');
+      expect(image.getSize()).to.deep.equal({ width: dirty.width, height: dirty.height });
+    });
+
+    it('keeps painting after going idle when adaptiveFrameRate is set', async () => {
+      const aw = new BrowserWindow({
+        width: 100,
+        height: 100,
+        show: false,
+        webPreferences: {
+          backgroundThrottling: false,
+          offscreen: { adaptiveFrameRate: true }
+        }
+      });
+      const firstPaint = once(aw.webContents, 'paint');
+      aw.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
+      await firstPaint;
+      await setTimeout(1500);
+      const paint = once(aw.webContents, 'paint');
+      aw.webContents.invalidate();
+      await paint;
+      expect(aw.webContents.getFrameRate()).to.equal(60);
+    });
+
+    it('passes frames in shared memory when useSharedMemory is set', async () => {
+      const sw = new BrowserWindow({
+        width: 100,
+        height: 100,
+        show: false,
+        webPreferences: {
+          backgroundThrottling: false,
+          offscreen: { useSharedMemory: true }
+        }
+      });
+      const paint = once(sw.webContents, 'paint') as Promise<[any, Electron.Rectangle, Electron.NativeImage, Electron.OffscreenSharedFrame]>;
+      sw.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
+      const [,, image, frame] = await paint;
+      expect(image.isEmpty()).to.be.true('image is not empty');
+      expect(frame.type).to.equal('sharedMemory');
+      expect(frame.pixelFormat).to.equal('bgra');
+      const { scaleFactor } = screen.getPrimaryDisplay();
+      expect(frame.contentRect.width).to.be.closeTo(100 * scaleFactor, 2);
+      expect(frame.contentRect.height).to.be.closeTo(100 * scaleFactor, 2);
+      expect(frame.stride).to.be.at.least(frame.contentRect.width * 4);
+      expect(frame.byteLength).to.be.at.least(frame.stride * frame.contentRect.height);
+      frame.release();
+    });
+
+    it('passes frames in shared textures when useSharedTexture is set', async () => {
+      const sw = new BrowserWindow({
+        width: 100,
+        height: 100,
+        show: false,
+        webPreferences: {
+          backgroundThrottling: false,
+          offscreen: { useSharedTexture: true }
+        }
+      });
+      const paint = once(sw.webContents, 'paint') as Promise<[any, Electron.Rectangle, Electron.NativeImage, Electron.OffscreenSharedTexture | Electron.OffscreenSharedFrame]>;
+      sw.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
+      const [,, image, frame] = await paint;
+      expect(image.isEmpty()).to.be.true('image is not empty');
+      expect(frame.type).to.be.oneOf(['sharedTexture', 'sharedMemory']);
+      const { scaleFactor } = screen.getPrimaryDisplay();
+      expect(frame.contentRect.width).to.be.closeTo(100 * scaleFactor, 2);
+      expect(frame.contentRect.height).to.be.closeTo(100 * scaleFactor, 2);
+      frame.release();
+    });
+
     describe('window.webContents.isOffscreen()', () => {
       it('is true for offscreen type', () => {
         w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
@@ -118,6 +118,45 @@ ifdescribe(!(['arm', 'arm64'].includes(process.arch)) || (process.platform !== '
     });
   });
 
+  describe('stopRecordingToCallback', function () {
+    this.timeout(5e3);
+
+    it('passes the trace data to the callback in chunks', async () => {
+      await app.whenReady();
+      await contentTracing.startRecording({});
+      await setTimeout(10);
+      const chunks: string[] = [];
+      await contentTracing.stopRecordingToCallback(chunk => chunks.push(chunk));
+      expect(chunks).to.not.be.empty();
+      const parsed = JSON.parse(chunks.join(''));
+      expect(parsed.traceEvents).to.be.an('array');
+    });
+
+    it('rejects if no trace is happening', async () => {
+      await expect(contentTracing.stopRecordingToCallback(() => {})).to.be.rejectedWith('Failed to stop tracing - no trace in progress');
+    });
+  });
+
+  describe('dumpRecording', function () {
+    this.timeout(5e3);
+
+    it('writes the trace data and keeps recording', async () => {
+      await app.whenReady();
+      await contentTracing.startRecording({ recording_mode: 'record-continuously' });
+      await setTimeout(10);
+      const resultFilePath = await contentTracing.dumpRecording(outputFilePath);
+      expect(resultFilePath).to.equal(outputFilePath);
+      expect(fs.statSync(outputFilePath).size).to.be.above(0);
+
+      const secondFilePath = await contentTracing.stopRecording();
+      expect(fs.statSync(secondFilePath).isFile()).to.be.true('output exists');
+    });
+
+    it('rejects if no trace is happening', async () => {
+      await expect(contentTracing.dumpRecording()).to.be.rejectedWith('Failed to stop tracing - no trace in progress');
+    });
+  });
+
   describe('captured events', () => {
     it('include V8 samples from the main process', async function () {
       this.timeout(60000);
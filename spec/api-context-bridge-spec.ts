@@ -555,6 +555,41 @@ describe('contextBridge', () => {
         expect(result).equal(true);
       });
 
+      it('should copy typed arrays, their buffers and numeric arrays', async () => {
+        await makeBindingWindow(() => {
+          const buffer = new ArrayBuffer(16);
+          new Uint8Array(buffer).set([1, 2, 3, 4]);
+          contextBridge.exposeInMainWorld('example', {
+            buffer,
+            view: new Uint16Array(buffer, 2, 3),
+            dataView: new DataView(buffer, 1, 2),
+            floats: new Float64Array([0.5, -1]),
+            numbers: [1, 2.5, -3, NaN],
+            mixed: [1, 'two', 3],
+            getBuffer: () => buffer
+          });
+        });
+        const result = await callWithBindings((root: any) => {
+          const { buffer, view, dataView, floats, numbers, mixed, getBuffer } = root.example;
+          new Uint8Array(buffer)[0] = 100;
+          return [
+            Object.getPrototypeOf(buffer) === ArrayBuffer.prototype,
+            Object.getPrototypeOf(view) === Uint16Array.prototype,
+            [view.byteOffset, view.length, view.buffer.byteLength],
+            Object.getPrototypeOf(dataView) === DataView.prototype,
+            [dataView.byteOffset, dataView.byteLength, dataView.getUint8(0)],
+            Array.from(floats),
+            Object.getPrototypeOf(numbers) === Array.prototype,
+            numbers,
+            mixed,
+            new Uint8Array(getBuffer())[0]
+          ];
+        });
+        expect(result).to.deep.equal([
+          true, true, [2, 3, 16], true, [1, 2, 2], [0.5, -1], true, [1, 2.5, -3, NaN], [1, 'two', 3], 1
+        ]);
+      });
+
       it('should proxy regexps', async () => {
         await makeBindingWindow(() => {
           contextBridge.exposeInMainWorld('example', /a/g);
@@ -461,6 +461,18 @@ ifdescribe(!isLinuxOnArm && !process.mas && !process.env.DISABLE_CRASH_REPORTER_
       }
     });
 
+    it('reflects parameters added in a batch', async () => {
+      const { remotely } = await startRemoteControlApp();
+      await remotely(() => {
+        require('electron').crashReporter.start({ submitURL: 'http://127.0.0.1' });
+        require('electron').crashReporter.addExtraParameter('hello', 'world');
+        require('electron').crashReporter.addExtraParameters({ hello: 'there', document: 'index.html' });
+      });
+      const parameters = await remotely(() => require('electron').crashReporter.getParameters());
+      expect(parameters).to.have.property('hello', 'there');
+      expect(parameters).to.have.property('document', 'index.html');
+    });
+
     it('can be called in the renderer', async () => {
       const { remotely } = await startRemoteControlApp();
       const rendererParameters = await remotely(async () => {
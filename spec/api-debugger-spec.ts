@@ -120,6 +120,46 @@ describe('debugger module', () => {
       expect(params.message.text).to.equal('a');
     });
 
+    it('emits raw messages of the filtered events', async () => {
+      w.webContents.loadURL('about:blank');
+      w.webContents.debugger.attach();
+      w.webContents.debugger.setMessageOptions({ raw: true, eventFilter: ['Runtime.consoleAPICalled', 'Console'] });
+      const methods: string[] = [];
+      w.webContents.debugger.on('message', (event, method) => { methods.push(method); });
+      const message = emittedUntil(w.webContents.debugger, 'raw-message',
+        (event: Electron.Event, message: string) => JSON.parse(message).method === 'Runtime.consoleAPICalled');
+      await w.webContents.debugger.sendCommand('Runtime.enable');
+      await w.webContents.debugger.sendCommand('Runtime.evaluate', { expression: 'console.log("raw")' });
+      const [, raw] = await message;
+      w.webContents.debugger.detach();
+      expect(JSON.parse(raw).params.args[0].value).to.equal('raw');
+      expect(methods).to.be.empty();
+    });
+
+    it('drops the events not matching the filter', async () => {
+      w.webContents.loadURL('about:blank');
+      w.webContents.debugger.attach();
+      w.webContents.debugger.setMessageOptions({ eventFilter: ['Runtime.consoleAPICalled'] });
+      const methods: string[] = [];
+      w.webContents.debugger.on('message', (event, method) => { methods.push(method); });
+      const message = emittedUntil(w.webContents.debugger, 'message',
+        (event: Electron.Event, method: string) => method === 'Runtime.consoleAPICalled');
+      await w.webContents.debugger.sendCommand('Runtime.enable');
+      await w.webContents.debugger.sendCommand('Runtime.evaluate', { expression: 'console.log("filtered")' });
+      await message;
+      w.webContents.debugger.detach();
+      // Runtime.enable also emits Runtime.executionContextCreated.
+      expect(methods).to.deep.equal(['Runtime.consoleAPICalled']);
+    });
+
+    it('throws when the event filter is not an array of strings', () => {
+      w.webContents.debugger.attach();
+      expect(() => {
+        w.webContents.debugger.setMessageOptions({ eventFilter: 'Network' as any });
+      }).to.throw('eventFilter must be an array of strings');
+      w.webContents.debugger.detach();
+    });
+
     it('returns error message when command fails', async () => {
       w.webContents.loadURL('about:blank');
       w.webContents.debugger.attach();
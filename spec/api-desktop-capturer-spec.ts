@@ -42,6 +42,45 @@ ifdescribe(!process.arch.includes('arm') && process.platform !== 'win32')('deskt
     await expect(promise2).to.eventually.be.fulfilled();
   });
 
+  describe('watchSources', () => {
+    it('emits the screen sources that are found', async () => {
+      const watcher = desktopCapturer.watchSources({ types: ['screen'] });
+      const thumbnailChanged = once(watcher, 'thumbnail-changed');
+      const [source] = await once(watcher, 'source-added');
+      expect(source.id).to.match(/^screen:/);
+      const [changed] = await thumbnailChanged;
+      watcher.stop();
+      expect(changed.id).to.match(/^screen:/);
+      expect(changed.thumbnail.isEmpty()).to.be.false();
+    });
+
+    it('stops emitting once stopped', async () => {
+      const watcher = desktopCapturer.watchSources({ types: ['screen'], thumbnailSize: { width: 0, height: 0 }, updateInterval: 50 });
+      await once(watcher, 'source-added');
+      watcher.stop();
+      let emitted = false;
+      watcher.on('source-added', () => { emitted = true; });
+      watcher.on('thumbnail-changed', () => { emitted = true; });
+      await setTimeout(200);
+      expect(emitted).to.be.false();
+    });
+
+    it('emits nothing when stopped before it starts', async () => {
+      const watcher = desktopCapturer.watchSources({ types: ['screen'], thumbnailSize: { width: 0, height: 0 }, updateInterval: 50 });
+      watcher.stop();
+      let emitted = false;
+      watcher.on('source-added', () => { emitted = true; });
+      watcher.on('error', () => { emitted = true; });
+      await setTimeout(200);
+      expect(emitted).to.be.false();
+    });
+
+    it('throws an error for invalid options', () => {
+      expect(() => desktopCapturer.watchSources(['screen'] as any)).to.throw('Invalid options');
+      expect(() => desktopCapturer.watchSources({ types: ['screen'], updateInterval: 0 })).to.throw('updateInterval must be a positive number');
+    });
+  });
+
   // Linux doesn't return any window sources.
   ifit(process.platform !== 'linux')('returns an empty display_id for window sources', async () => {
     const w = new BrowserWindow({ width: 200, height: 200 });
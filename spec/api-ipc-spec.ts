@@ -2,7 +2,7 @@ import { EventEmitter, once } from 'node:events';
 import { expect } from 'chai';
 import { BrowserWindow, ipcMain, IpcMainInvokeEvent, MessageChannelMain, WebContents } from 'electron/main';
 import { closeAllWindows } from './lib/window-helpers';
-import { defer, listen } from './lib/spec-helpers';
+import { defer, listen, waitUntil } from './lib/spec-helpers';
 import * as path from 'node:path';
 import * as http from 'node:http';
 
@@ -58,6 +58,81 @@ describe('ipc module', () => {
       await done;
     });
 
+    it('receives large arguments and sends large responses', async () => {
+      ipcMain.handleOnce('test', (e: IpcMainInvokeEvent, arg: string) => {
+        expect(arg).to.have.lengthOf(1024 * 1024);
+        return arg + arg;
+      });
+      const done = new Promise<void>(resolve => ipcMain.once('result', (e, arg) => {
+        expect(arg.result).to.equal('a'.repeat(2 * 1024 * 1024));
+        resolve();
+      }));
+      await w.webContents.executeJavaScript(`(${rendererInvoke})('a'.repeat(1024 * 1024))`);
+      await done;
+    });
+
+    it('preserves plain and non-plain arguments', async () => {
+      ipcMain.handleOnce('test', (e: IpcMainInvokeEvent, plain: any, shared: any, cyclic: any, holey: any[], named: any) => {
+        expect(plain).to.deep.equal({
+          n: null,
+          b: [true, false],
+          i: -7,
+          d: 1.5,
+          s: 'abc',
+          w: 'héllo ☃',
+          nested: { a: [1, 'two', { three: 3 }] },
+          empty: [{}, []]
+        });
+        expect(plain).to.have.property('u', undefined);
+        expect(shared.a).to.equal(shared.b);
+        expect(cyclic.self).to.equal(cyclic);
+        expect(holey).to.have.lengthOf(3);
+        expect(1 in holey).to.be.false();
+        expect(named.extra).to.equal('prop');
+        return { w: '☃', list: [1, 2.5, 'x'] };
+      });
+      const done = new Promise<void>(resolve => ipcMain.once('result', (e, arg) => {
+        expect(arg).to.deep.equal({ result: { w: '☃', list: [1, 2.5, 'x'] } });
+        resolve();
+      }));
+      await w.webContents.executeJavaScript(`(() => {
+        const plain = { u: undefined, n: null, b: [true, false], i: -7, d: 1.5, s: 'abc', w: 'héllo ☃', nested: { a: [1, 'two', { three: 3 }] }, empty: [{}, []] };
+        const obj = {};
+        const cyclic = {};
+        cyclic.self = cyclic;
+        const named = [1];
+        named.extra = 'prop';
+        return (${rendererInvoke})(plain, { a: obj, b: obj }, cyclic, [1, , 3], named);
+      })()`);
+      await done;
+    });
+
+    it('runs getters once and does not walk proxies when falling back', async () => {
+      ipcMain.handleOnce('test', (e: IpcMainInvokeEvent, withGetter: any, nested: any) => {
+        expect(withGetter.x).to.equal(1);
+        let depth = 0;
+        for (let value = nested; value.child; value = value.child) depth++;
+        expect(depth).to.equal(100);
+        return null;
+      });
+      const done = once(ipcMain, 'result');
+      const counts = await w.webContents.executeJavaScript(`(async () => {
+        let getterCalls = 0;
+        let trapCalls = 0;
+        const withGetter = { get x () { getterCalls++; return 1; } };
+        const nested = {};
+        let last = nested;
+        for (let i = 0; i < 100; i++) last = last.child = {};
+        const proxy = new Proxy({}, { getPrototypeOf () { trapCalls++; return Object.prototype; } });
+        await (${rendererInvoke})(withGetter, nested);
+        try { require('electron').ipcRenderer.send('proxy', proxy); } catch {}
+        return { getterCalls, trapCalls };
+      })()`);
+      const [, arg] = await done;
+      expect(arg).to.deep.equal({ result: null });
+      expect(counts).to.deep.equal({ getterCalls: 1, trapCalls: 0 });
+    });
+
     it('receives an error from a synchronous handler', async () => {
       ipcMain.handleOnce('test', () => {
         throw new Error('some error');
@@ -200,6 +275,155 @@ describe('ipc module', () => {
     });
   });
 
+  describe('sendSyncWithTimeout', () => {
+    let w: BrowserWindow;
+
+    before(async () => {
+      w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
+      await w.loadURL('about:blank');
+    });
+    after(async () => {
+      w.destroy();
+    });
+
+    it('returns the reply', async () => {
+      ipcMain.once('test-sync-timeout', (e, arg) => { e.returnValue = arg * 2; });
+      const result = await w.webContents.executeJavaScript('require(\'electron\').ipcRenderer.sendSyncWithTimeout(\'test-sync-timeout\', 5000, 21)');
+      expect(result).to.equal(42);
+    });
+
+    it('throws when no reply arrives in time', async () => {
+      const received = once(ipcMain, 'test-sync-no-reply');
+      const error = await w.webContents.executeJavaScript(`(() => {
+        try {
+          require('electron').ipcRenderer.sendSyncWithTimeout('test-sync-no-reply', 100);
+        } catch (e) {
+          return e.message;
+        }
+      })()`);
+      expect(error).to.match(/Timed out/);
+      await received;
+    });
+
+    it('reports the time spent waiting per channel', async () => {
+      ipcMain.once('test-sync-stats', (e) => { e.returnValue = null; });
+      const stats = await w.webContents.executeJavaScript(`(() => {
+        const { ipcRenderer } = require('electron');
+        ipcRenderer.sendSync('test-sync-stats');
+        return ipcRenderer.getSyncMessageStats();
+      })()`);
+      expect(stats['test-sync-stats']).to.include({ count: 1, timeouts: 0 });
+      expect(stats['test-sync-stats'].maxWaitTime).to.be.a('number');
+      expect(stats['test-sync-no-reply']).to.include({ count: 1, timeouts: 1 });
+    });
+  });
+
+  describe('batching', () => {
+    let w: BrowserWindow;
+
+    before(async () => {
+      w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
+      await w.loadURL('about:blank');
+    });
+    after(async () => {
+      w.destroy();
+    });
+
+    it('delivers messages queued on a channel as one event', async () => {
+      const received = once(ipcMain, 'test-batched');
+      w.webContents.executeJavaScript(`(() => {
+        const { ipcRenderer } = require('electron');
+        for (let i = 0; i < 100; i++) {
+          ipcRenderer.sendBatched('test-batched', i, String(i));
+        }
+      })()`);
+      const [, messages] = await received;
+      expect(messages).to.have.lengthOf(100);
+      expect(messages[0]).to.deep.equal([0, '0']);
+      expect(messages[99]).to.deep.equal([99, '99']);
+    });
+
+    it('flushes a batch once it is full', async () => {
+      const events: any[][][] = [];
+      const done = new Promise<void>(resolve => {
+        let count = 0;
+        ipcMain.on('test-batched', (e, messages) => {
+          events.push(messages);
+          count += messages.length;
+          if (count === 1500) resolve();
+        });
+      });
+      try {
+        w.webContents.executeJavaScript(`(() => {
+          const { ipcRenderer } = require('electron');
+          for (let i = 0; i < 1500; i++) {
+            ipcRenderer.sendBatched('test-batched', i);
+          }
+        })()`);
+        await done;
+      } finally {
+        ipcMain.removeAllListeners('test-batched');
+      }
+      expect(events.map(messages => messages.length)).to.deep.equal([1000, 500]);
+    });
+  });
+
+  describe('ArrayBuffer transfer', () => {
+    let w: BrowserWindow;
+
+    before(async () => {
+      w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
+      await w.loadURL('about:blank');
+    });
+    after(async () => {
+      w.destroy();
+    });
+
+    it('transfers ArrayBuffers to the main process with invokeWithTransfer', async () => {
+      ipcMain.handleOnce('test', (e, { data }: { data: Uint8Array }) => {
+        expect(data).to.be.an.instanceOf(Uint8Array);
+        expect(Array.from(data)).to.deep.equal([1, 2, 3]);
+        return data.buffer.byteLength;
+      });
+      const result = await w.webContents.executeJavaScript(`(async () => {
+        const { ipcRenderer } = require('electron');
+        const data = new Uint8Array([1, 2, 3]);
+        const received = await ipcRenderer.invokeWithTransfer('test', [data.buffer], { data });
+        return { received, remaining: data.buffer.byteLength };
+      })()`);
+      expect(result).to.deep.equal({ received: 3, remaining: 0 });
+    });
+
+    it('throws when an ArrayBuffer is listed twice', async () => {
+      const error = await w.webContents.executeJavaScript(`(() => {
+        const { ipcRenderer } = require('electron');
+        const buffer = new ArrayBuffer(8);
+        try {
+          ipcRenderer.sendWithTransfer('test', [buffer, buffer], buffer);
+        } catch (e) {
+          return e.message;
+        }
+      })()`);
+      expect(error).to.match(/listed more than once/);
+    });
+
+    it('transfers ArrayBuffers to the renderer with webContents.sendWithTransfer', async () => {
+      const ready = once(ipcMain, 'ready');
+      const received = w.webContents.executeJavaScript(`new Promise(resolve => {
+        const { ipcRenderer } = require('electron');
+        ipcRenderer.once('test', (e, buffer) => {
+          resolve(Array.from(new Uint8Array(buffer)));
+        });
+        ipcRenderer.send('ready');
+      })`);
+      await ready;
+      const buffer = new Uint8Array([4, 5, 6]).buffer;
+      w.webContents.sendWithTransfer('test', [buffer], buffer);
+      expect(buffer.byteLength).to.equal(0);
+      expect(await received).to.deep.equal([4, 5, 6]);
+    });
+  });
+
   describe('MessagePort', () => {
     afterEach(closeAllWindows);
 
@@ -441,6 +665,62 @@ describe('ipc module', () => {
         expect(ev.data).to.equal('hello');
       });
 
+      it('delivers messages in batches while listening for them', async () => {
+        const { port1, port2 } = new MessageChannelMain();
+        for (let i = 0; i < 100; i++) port2.postMessage(i);
+        const received: number[] = [];
+        port1.on('message', (ev) => received.push(ev.data));
+        const batches: number[][] = [];
+        port1.on('messages', (events) => batches.push(events.map(ev => ev.data)));
+        port1.start();
+        await waitUntil(() => received.length === 100);
+        const expected = [...Array(100).keys()];
+        expect(received).to.deep.equal(expected);
+        expect(batches.flat()).to.deep.equal(expected);
+        expect(batches.length).to.be.lessThan(100);
+      });
+
+      it('delivers the batched messages before the close event', async () => {
+        const { port1, port2 } = new MessageChannelMain();
+        const received: number[] = [];
+        port1.on('messages', (events) => received.push(...events.map(ev => ev.data)));
+        port1.start();
+        port2.postMessage(1);
+        port2.postMessage(2);
+        port2.close();
+        await once(port1, 'close');
+        expect(received).to.deep.equal([1, 2]);
+      });
+
+      it('delivers the batched messages of a port before it is transferred', async () => {
+        const { port1, port2 } = new MessageChannelMain();
+        const received: number[] = [];
+        port1.on('messages', (events) => received.push(...events.map(ev => ev.data)));
+        port1.start();
+
+        // The signal is read after port1 has taken the messages off its pipe,
+        // but before they are emitted.
+        const { port1: signal1, port2: signal2 } = new MessageChannelMain();
+        const { port1: carrier1, port2: carrier2 } = new MessageChannelMain();
+        let receivedAtTransfer: number[] = [];
+        signal1.once('message', () => {
+          carrier1.postMessage(null, [port1]);
+          receivedAtTransfer = [...received];
+        });
+        signal1.start();
+        for (let i = 0; i < 10; i++) port2.postMessage(i);
+        signal2.postMessage(null);
+
+        carrier2.start();
+        const [{ ports: [transferred] }] = await once(carrier2, 'message');
+        expect(receivedAtTransfer).to.deep.equal([...Array(10).keys()]);
+        transferred.on('message', (ev) => received.push(ev.data));
+        transferred.start();
+        for (let i = 10; i < 20; i++) port2.postMessage(i);
+        await waitUntil(() => received.length === 20);
+        expect(received).to.deep.equal([...Array(20).keys()]);
+      });
+
       it('can pass one end to a WebContents', async () => {
         const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
         w.loadURL('about:blank');
@@ -481,6 +761,41 @@ describe('ipc module', () => {
         expect(message).to.equal('hello');
       });
 
+      it('can connect two WebContents directly', async () => {
+        const windows = [0, 1].map(() => new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } }));
+        try {
+          await Promise.all(windows.map(async (w, index) => {
+            await w.loadURL('about:blank');
+            await w.webContents.executeJavaScript(`(${function (index: number) {
+              const { ipcRenderer } = require('electron');
+              ipcRenderer.on('peer', e => {
+                const [port] = e.ports;
+                port.onmessage = ev => {
+                  ipcRenderer.send('done', index, e.data, new Uint8Array(ev.data.buffer)[0]);
+                };
+                const buffer = new ArrayBuffer(16);
+                new Uint8Array(buffer)[0] = index + 1;
+                port.postMessage({ buffer }, [buffer]);
+              });
+            }})(${index})`);
+          }));
+          const received = new Promise<any[]>(resolve => {
+            const results: any[] = [];
+            ipcMain.on('done', function listener (e, ...args) {
+              results[args[0]] = args.slice(1);
+              if (results.filter(Boolean).length === 2) {
+                ipcMain.off('done', listener);
+                resolve(results);
+              }
+            });
+          });
+          MessageChannelMain.connect('peer', windows[0].webContents, windows[1].webContents, 'hi');
+          expect(await received).to.deep.equal([['hi', 2], ['hi', 1]]);
+        } finally {
+          windows.forEach(w => w.destroy());
+        }
+      });
+
       it('can send messages to a closed port', () => {
         const { port1, port2 } = new MessageChannelMain();
         port2.start();
@@ -715,6 +1030,53 @@ describe('ipc module', () => {
       expect(result).to.equal(42 * 2);
     });
 
+    it('records per-channel ipc stats', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
+      await w.loadURL('about:blank');
+      const received = once(w.webContents.ipc, 'test-stats');
+      w.webContents.executeJavaScript('require(\'electron\').ipcRenderer.send(\'test-stats\', \'x\'.repeat(1000))');
+      await received;
+      w.webContents.send('test-stats-sent', 42);
+      const stats = w.webContents.getIpcStats();
+      expect(stats['test-stats'].receivedCount).to.equal(1);
+      expect(stats['test-stats'].receivedBytes).to.be.greaterThan(1000);
+      expect(stats['test-stats'].queueingDelay).to.be.at.least(0);
+      expect(stats['test-stats-sent'].sentCount).to.equal(1);
+      expect(stats['test-stats-sent'].sentBytes).to.be.greaterThan(0);
+    });
+
+    it('counts the channels past the limit together', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
+      await w.loadURL('about:blank');
+      const received = once(w.webContents.ipc, 'test-stats-last');
+      w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron');
+        for (let i = 0; i < 300; i++) ipcRenderer.send('test-stats-' + i);
+        ipcRenderer.send('test-stats-last');
+      }`);
+      await received;
+      const stats = w.webContents.getIpcStats();
+      expect(Object.keys(stats)).to.have.lengthOf(257);
+      expect(stats['(other)'].receivedCount).to.be.at.least(300 + 1 - 256);
+    });
+
+    it('overrides ipcMain handlers registered before it until removed', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
+      await w.loadURL('about:blank');
+      ipcMain.handle('test-override', (event, arg) => {
+        expect(event.sender).to.equal(w.webContents);
+        expect(event.senderFrame).to.equal(w.webContents.mainFrame);
+        return arg * 3;
+      });
+      defer(() => ipcMain.removeHandler('test-override'));
+      const invoke = () => w.webContents.executeJavaScript('require(\'electron\').ipcRenderer.invoke(\'test-override\', 42)');
+      expect(await invoke()).to.equal(42 * 3);
+      w.webContents.ipc.handle('test-override', (_event, arg) => arg * 2);
+      expect(await invoke()).to.equal(42 * 2);
+      w.webContents.ipc.removeHandler('test-override');
+      expect(await invoke()).to.equal(42 * 3);
+    });
+
     it('receives ipcs from child frames', async () => {
       const server = http.createServer((req, res) => {
         res.setHeader('content-type', 'text/html');
@@ -43,6 +43,23 @@ describe('MenuItems', () => {
     });
   });
 
+  describe('MenuItem property changes', () => {
+    it('updates the menu the item is in', () => {
+      const menu = Menu.buildFromTemplate([
+        { label: 'one', sublabel: 'first' },
+        { label: 'two', type: 'checkbox' }
+      ]);
+      menu.items[0].label = 'uno';
+      menu.items[0].sublabel = 'primero';
+      menu.items[1].checked = true;
+
+      expect(menu.items[0].label).to.equal('uno');
+      expect((menu as any).getLabelAt(0)).to.equal('uno');
+      expect((menu as any).getSublabelAt(0)).to.equal('primero');
+      expect((menu as any).isItemCheckedAt(1)).to.be.true();
+    });
+  });
+
   describe('MenuItem.click', () => {
     it('should be called with the item object passed', done => {
       const menu = Menu.buildFromTemplate([{
@@ -240,6 +257,28 @@ describe('MenuItems', () => {
     });
   });
 
+  describe('MenuItem with submenu function', () => {
+    it('does not call the function until the submenu is populated', () => {
+      let calls = 0;
+      const menu = Menu.buildFromTemplate([{
+        label: 'text',
+        submenu: () => {
+          calls++;
+          return [{ label: 'a' }, { type: 'separator' }, { label: 'b' }];
+        }
+      }]);
+      const { submenu } = menu.items[0];
+      expect(menu.items[0].type).to.equal('submenu');
+      expect(calls).to.equal(0);
+      expect(submenu!.items).to.have.lengthOf(0);
+
+      (submenu as any)._populate();
+      (submenu as any)._populate();
+      expect(calls).to.equal(1);
+      expect(submenu!.items.map(item => item.type)).to.deep.equal(['normal', 'separator', 'normal']);
+    });
+  });
+
   describe('MenuItem role', () => {
     it('returns undefined for items without default accelerator', () => {
       const list = keys(roleList).filter(key => !roleList[key].accelerator);
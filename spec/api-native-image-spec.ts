@@ -1,6 +1,8 @@
 import { expect } from 'chai';
 import { nativeImage } from 'electron/common';
 import { ifdescribe, ifit } from './lib/spec-helpers';
+import * as fs from 'node:fs';
+import * as os from 'node:os';
 import * as path from 'node:path';
 
 describe('nativeImage module', () => {
@@ -117,6 +119,41 @@ describe('nativeImage module', () => {
       expect(() => nativeImage.createFromBitmap(Buffer.from([]), {} as any)).to.throw('width is required');
       expect(() => nativeImage.createFromBitmap(Buffer.from([]), { width: 1 } as any)).to.throw('height is required');
       expect(() => nativeImage.createFromBitmap(Buffer.from([]), { width: 1, height: 1 })).to.throw('invalid buffer size');
+      expect(() => nativeImage.createFromBitmap(Buffer.alloc(4), { width: 1, height: 1, pixelFormat: 'argb' as any })).to.throw("pixelFormat must be 'bgra', 'rgba' or 'rgb'");
+      expect(() => nativeImage.createFromBitmap(Buffer.alloc(4), { width: 1, height: 1, alphaType: 'opaque' as any })).to.throw("alphaType must be 'premultiplied' or 'unpremultiplied'");
+      expect(() => nativeImage.createFromBitmap(Buffer.alloc(4), { width: 1, height: 1, pixelFormat: 'rgb' })).to.throw('invalid buffer size');
+    });
+
+    it('converts pixels from the given layout', () => {
+      const rgb = nativeImage.createFromBitmap(Buffer.from([0x10, 0x20, 0x30]), { width: 1, height: 1, pixelFormat: 'rgb' });
+      expect([...rgb.toBitmap({ pixelFormat: 'rgba' })]).to.deep.equal([0x10, 0x20, 0x30, 0xff]);
+
+      const bgra = nativeImage.createFromBitmap(Buffer.from([0x30, 0x20, 0x10, 0xff]), { width: 1, height: 1, pixelFormat: 'bgra' });
+      expect([...bgra.toBitmap({ pixelFormat: 'rgba' })]).to.deep.equal([0x10, 0x20, 0x30, 0xff]);
+
+      const unpremultiplied = nativeImage.createFromBitmap(Buffer.from([0xff, 0x00, 0xff, 0x80]), {
+        width: 1,
+        height: 1,
+        pixelFormat: 'rgba',
+        alphaType: 'unpremultiplied'
+      });
+      expect([...unpremultiplied.toBitmap({ pixelFormat: 'rgba' })]).to.deep.equal([0x80, 0x00, 0x80, 0x80]);
+      expect([...unpremultiplied.toBitmap({ pixelFormat: 'rgba', alphaType: 'unpremultiplied' })]).to.deep.equal([0xff, 0x00, 0xff, 0x80]);
+    });
+
+    it('uses the buffer in place with copy: false', () => {
+      const imageA = nativeImage.createFromPath(path.join(fixturesPath, 'assets', 'logo.png'));
+      const bitmap = imageA.toBitmap();
+
+      const imageB = nativeImage.createFromBitmap(bitmap, { ...imageA.getSize(), copy: false });
+      expect(imageB.getSize()).to.deep.equal({ width: 538, height: 190 });
+      expect(imageB.toBitmap().equals(bitmap)).to.be.true();
+      expect(imageB.toPNG().equals(nativeImage.createFromBitmap(bitmap, imageA.getSize()).toPNG())).to.be.true();
+    });
+
+    it('rejects converting pixels with copy: false', () => {
+      expect(() => nativeImage.createFromBitmap(Buffer.alloc(3), { width: 1, height: 1, pixelFormat: 'rgb', copy: false }))
+        .to.throw('copy: false requires the pixel layout returned by toBitmap()');
     });
   });
 
@@ -319,6 +356,64 @@ describe('nativeImage module', () => {
       expect(image.isEmpty()).to.be.false();
       expect(image.getSize()).to.deep.equal({ width: 256, height: 256 });
     });
+
+    describe('with scale variants', () => {
+      let tmpDir: string;
+      let imagePath: string;
+
+      beforeEach(async () => {
+        tmpDir = await fs.promises.mkdtemp(path.resolve(os.tmpdir(), 'electron-native-image-'));
+        imagePath = path.join(tmpDir, 'icon.png');
+        await fs.promises.copyFile(image1x1.path, imagePath);
+        await fs.promises.copyFile(image2x2.path, path.join(tmpDir, 'icon@2x.png'));
+      });
+
+      afterEach(async () => {
+        await fs.promises.rm(tmpDir, { force: true, recursive: true });
+      });
+
+      it('loads the variants next to the file', () => {
+        const image = nativeImage.createFromPath(imagePath);
+        expect(image.getScaleFactors()).to.deep.equal([1, 2]);
+        expect(image.getSize()).to.deep.equal({ width: 1, height: 1 });
+        expect(image.getSize(2)).to.deep.equal({ width: 2, height: 2 });
+      });
+
+      it('loads the image again when the file is modified', async () => {
+        expect(nativeImage.createFromPath(imagePath).getSize()).to.deep.equal({ width: 1, height: 1 });
+
+        await fs.promises.copyFile(image3x3.path, imagePath);
+        const later = new Date(Date.now() + 60 * 1000);
+        await fs.promises.utimes(imagePath, later, later);
+        expect(nativeImage.createFromPath(imagePath).getSize()).to.deep.equal({ width: 3, height: 3 });
+      });
+
+      it('loads the image again when a variant is added or modified', async () => {
+        expect(nativeImage.createFromPath(imagePath).getScaleFactors()).to.deep.equal([1, 2]);
+
+        await fs.promises.copyFile(image3x3.path, path.join(tmpDir, 'icon@3x.png'));
+        expect(nativeImage.createFromPath(imagePath).getScaleFactors()).to.deep.equal([1, 2, 3]);
+
+        const variantPath = path.join(tmpDir, 'icon@2x.png');
+        await fs.promises.copyFile(image3x3.path, variantPath);
+        const later = new Date(Date.now() + 60 * 1000);
+        await fs.promises.utimes(variantPath, later, later);
+        expect(nativeImage.createFromPath(imagePath).getSize(2)).to.deep.equal({ width: 3, height: 3 });
+      });
+
+      it('does not change other images of the same file when one is modified', () => {
+        const imageA = nativeImage.createFromPath(imagePath);
+        const imageB = nativeImage.createFromPath(imagePath);
+        imageA.addRepresentation({
+          scaleFactor: 3.0,
+          buffer: nativeImage.createFromPath(image3x3.path).toPNG()
+        });
+
+        expect(imageA.getScaleFactors()).to.deep.equal([1, 2, 3]);
+        expect(imageB.getScaleFactors()).to.deep.equal([1, 2]);
+        expect(nativeImage.createFromPath(imagePath).getScaleFactors()).to.deep.equal([1, 2]);
+      });
+    });
   });
 
   describe('createFromNamedImage(name)', () => {
@@ -378,6 +473,71 @@ describe('nativeImage module', () => {
     });
   });
 
+  describe('resizeAllAsync(images, options)', () => {
+    it('resizes every image in order', async () => {
+      const images = [
+        nativeImage.createFromPath(imageLogo.path),
+        nativeImage.createFromPath(image3x3.path),
+        nativeImage.createEmpty()
+      ];
+      const resized = await nativeImage.resizeAllAsync(images, { width: 2 });
+      expect(resized).to.have.lengthOf(3);
+      expect(resized[0].getSize()).to.deep.equal(images[0].resize({ width: 2 }).getSize());
+      expect(resized[1].getSize()).to.deep.equal({ width: 2, height: 2 });
+      expect(resized[2].isEmpty()).to.be.true();
+    });
+
+    it('resolves with an empty array for no images', async () => {
+      expect(await nativeImage.resizeAllAsync([], { width: 2 })).to.deep.equal([]);
+    });
+  });
+
+  describe('async variants', () => {
+    it('createFromPathAsync() loads the same image as createFromPath()', async () => {
+      const image = await nativeImage.createFromPathAsync(imageLogo.path);
+      expect(image.getSize()).to.deep.equal({ width: imageLogo.width, height: imageLogo.height });
+      expect(image.toBitmap().equals(nativeImage.createFromPath(imageLogo.path).toBitmap())).to.be.true();
+      expect((await nativeImage.createFromPathAsync('does-not-exist.png')).isEmpty()).to.be.true();
+    });
+
+    it('createFromBufferAsync() decodes the same image as createFromBuffer()', async () => {
+      const buffer = nativeImage.createFromPath(imageLogo.path).toPNG();
+      const image = await nativeImage.createFromBufferAsync(buffer, { scaleFactor: 2.0 });
+      expect(image.getSize()).to.deep.equal({ width: imageLogo.width / 2, height: imageLogo.height / 2 });
+      expect(() => nativeImage.createFromBufferAsync(null as any)).to.throw('buffer must be a node Buffer');
+    });
+
+    it('toPNGAsync() and toJPEGAsync() encode like their sync counterparts', async () => {
+      const image = nativeImage.createFromPath(imageLogo.path);
+      expect((await image.toPNGAsync()).equals(image.toPNG())).to.be.true();
+      expect((await image.toPNGAsync({ scaleFactor: 2.0 })).equals(image.toPNG({ scaleFactor: 2.0 }))).to.be.true();
+      expect((await image.toJPEGAsync(80)).equals(image.toJPEG(80))).to.be.true();
+    });
+
+    it('resizeAsync() returns a resized image', async () => {
+      const image = nativeImage.createFromPath(imageLogo.path);
+      for (const [resizeTo, expectedSize] of new Map([
+        [{ width: 269 }, { width: 269, height: 95 }],
+        [{ height: 200 }, { width: 566, height: 200 }],
+        [{ width: 80, height: 65 }, { width: 80, height: 65 }],
+        [{ width: 0, height: 0 }, { width: 0, height: 0 }]
+      ])) {
+        const resized = await image.resizeAsync(resizeTo);
+        expect(resized.getSize()).to.deep.equal(expectedSize);
+      }
+      expect((await nativeImage.createEmpty().resizeAsync({ width: 1, height: 1 })).isEmpty()).to.be.true();
+    });
+
+    it('runs several jobs at once', async () => {
+      const images = await Promise.all([imageLogo, image1x1, image3x3].map(({ path }) => nativeImage.createFromPathAsync(path)));
+      expect(images.map(image => image.getSize())).to.deep.equal([
+        { width: imageLogo.width, height: imageLogo.height },
+        { width: 1, height: 1 },
+        { width: 3, height: 3 }
+      ]);
+    });
+  });
+
   describe('crop(bounds)', () => {
     it('returns an empty image when called on an empty image', () => {
       expect(nativeImage.createEmpty().crop({ width: 1, height: 2, x: 0, y: 0 }).isEmpty()).to.be.true();
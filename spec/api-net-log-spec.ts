@@ -118,6 +118,50 @@ describe('netLog module', () => {
     expect(JSON.parse(dump).events.some((x: any) => x.params && x.params.bytes && Buffer.from(x.params.bytes, 'base64').includes(unique))).to.be.true('uuid present in dump');
   });
 
+  describe('ring buffer', () => {
+    const makeRequest = () => new Promise<void>((resolve) => {
+      const req = net.request({ url: serverUrl, session: session.fromPartition('net-log') });
+      req.on('response', (response) => {
+        response.on('data', () => {});
+        response.on('end', () => resolve());
+      });
+      req.end();
+    });
+
+    it('dumps the recorded events and keeps recording', async () => {
+      await testNetLog().startRingBuffer();
+      expect(testNetLog().currentlyLogging).to.be.true('currently logging');
+      await makeRequest();
+      await testNetLog().dump(dumpFileDynamic);
+      expect(testNetLog().currentlyLogging).to.be.true('currently logging');
+      const { events } = JSON.parse(fs.readFileSync(dumpFileDynamic, 'utf8'));
+      expect(events).to.be.an('array').that.is.not.empty();
+      await testNetLog().stopLogging();
+    });
+
+    it('only keeps the events of the requested source types', async () => {
+      await testNetLog().startRingBuffer({ maxSize: 1024 * 1024 });
+      await makeRequest();
+      await testNetLog().dump(dumpFileDynamic, { sourceTypes: ['URL_REQUEST'] });
+      await testNetLog().stopLogging();
+      const { constants, events } = JSON.parse(fs.readFileSync(dumpFileDynamic, 'utf8'));
+      expect(events).to.be.an('array').that.is.not.empty();
+      for (const event of events) {
+        expect(event.source.type).to.equal(constants.logSourceType.URL_REQUEST);
+      }
+    });
+
+    it('rejects a dump when no ring buffer is recording', async () => {
+      await expect(testNetLog().dump(dumpFileDynamic)).to.be.rejectedWith('No ring buffer net log in progress');
+    });
+
+    it('does not start while another net log is running', async () => {
+      await testNetLog().startLogging(dumpFile);
+      expect(() => testNetLog().startRingBuffer()).to.throw(/There is already a net log running/);
+      await testNetLog().stopLogging();
+    });
+  });
+
   ifit(process.platform !== 'linux')('should begin and end logging automatically when --log-net-log is passed', async () => {
     const appProcess = ChildProcess.spawn(process.execPath,
       [appPath], {
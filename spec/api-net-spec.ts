@@ -1,6 +1,8 @@
 import { expect } from 'chai';
 import { net, ClientRequest, ClientRequestConstructorOptions, utilityProcess } from 'electron/main';
+import * as fs from 'node:fs';
 import * as http from 'node:http';
+import * as os from 'node:os';
 import * as path from 'node:path';
 import * as url from 'node:url';
 import { once } from 'node:events';
@@ -1614,4 +1616,117 @@ describe('net module', () => {
       });
     });
   }
+
+  describe('downloadPath option', () => {
+    let downloadPath: string;
+
+    beforeEach(() => {
+      downloadPath = path.join(os.tmpdir(), `net-download-${Date.now()}`);
+    });
+
+    afterEach(() => {
+      fs.rmSync(downloadPath, { force: true });
+    });
+
+    it('writes the response body to a file', async () => {
+      const bodyData = randomString(kOneMegaByte);
+      const serverUrl = await respondOnce.toSingleURL((request, response) => {
+        response.end(bodyData);
+      });
+      const urlRequest = net.request({ url: serverUrl, downloadPath });
+      const response = await getResponse(urlRequest);
+      expect(response.statusCode).to.equal(200);
+      const body = await collectStreamBody(response);
+      expect(body).to.equal('');
+      expect(fs.readFileSync(downloadPath, 'utf8')).to.equal(bodyData);
+    });
+
+    it('writes the response body to a file in a utility process', async () => {
+      const bodyData = randomString(kOneMegaByte);
+      const serverUrl = await respondOnce.toSingleURL((request, response) => {
+        response.end(bodyData);
+      });
+      const child = utilityProcess.fork(path.resolve(__dirname, 'fixtures', 'api', 'utility-process', 'net-download.js'));
+      child.postMessage({ url: serverUrl, downloadPath });
+      const [data] = await once(child, 'message');
+      expect(data).to.deep.equal({ statusCode: 200, body: '' });
+      expect(fs.readFileSync(downloadPath, 'utf8')).to.equal(bodyData);
+      await once(child, 'exit');
+    });
+  });
+
+  describe('streaming uploads', () => {
+    let tmpDir: string;
+    let filePath: string;
+    const fileData = randomBuffer(kOneMegaByte);
+
+    before(() => {
+      tmpDir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-net-spec-'));
+      filePath = path.join(tmpDir, 'upload.bin');
+      fs.writeFileSync(filePath, fileData);
+    });
+
+    after(() => {
+      fs.rmSync(tmpDir, { recursive: true, force: true });
+    });
+
+    it('sends a file with request.sendFile()', async () => {
+      let headers: http.IncomingHttpHeaders;
+      let received: Buffer;
+      const serverUrl = await respondOnce.toSingleURL(async (request, response) => {
+        headers = request.headers;
+        received = await collectStreamBodyBuffer(request);
+        response.end();
+      });
+      const urlRequest = net.request({ method: 'POST', url: serverUrl });
+      urlRequest.sendFile(filePath);
+      await collectStreamBody(await getResponse(urlRequest));
+      expect(headers!['content-length']).to.equal(String(kOneMegaByte));
+      expect(received!.equals(fileData)).to.be.true();
+    });
+
+    it('sends a range of a file with request.sendFile()', async () => {
+      let received: Buffer;
+      const serverUrl = await respondOnce.toSingleURL(async (request, response) => {
+        received = await collectStreamBodyBuffer(request);
+        response.end();
+      });
+      const urlRequest = net.request({ method: 'POST', url: serverUrl });
+      urlRequest.sendFile(filePath, { offset: 10, length: 100 });
+      await collectStreamBody(await getResponse(urlRequest));
+      expect(received!.equals(fileData.subarray(10, 110))).to.be.true();
+    });
+
+    it('fails the request when the file of request.sendFile() does not exist', async () => {
+      const serverUrl = await respondOnce.toSingleURL((request, response) => {
+        response.end();
+      });
+      const urlRequest = net.request({ method: 'POST', url: serverUrl });
+      urlRequest.sendFile(path.join(tmpDir, 'missing.bin'));
+      const [error] = await once(urlRequest, 'error');
+      expect(error.message).to.match(/ERR_FILE_NOT_FOUND/);
+    });
+
+    it('does not allow request.sendFile() after a write', () => {
+      const urlRequest = net.request({ method: 'POST', url: 'http://127.0.0.1' });
+      urlRequest.write('x');
+      expect(() => urlRequest.sendFile(filePath)).to.throw(/before the request body is written/);
+      urlRequest.abort();
+    });
+
+    it('sends a stream body of net.fetch() with chunked encoding', async () => {
+      let headers: http.IncomingHttpHeaders;
+      const serverUrl = await respondOnce.toSingleURL(async (request, response) => {
+        headers = request.headers;
+        response.end(await collectStreamBodyBuffer(request));
+      });
+      const resp = await net.fetch(serverUrl, {
+        method: 'POST',
+        body: fs.createReadStream(filePath) as any,
+        duplex: 'half'
+      } as RequestInit);
+      expect(Buffer.from(await resp.arrayBuffer()).equals(fileData)).to.be.true();
+      expect(headers!['transfer-encoding']).to.equal('chunked');
+    });
+  });
 });
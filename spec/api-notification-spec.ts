@@ -1,6 +1,7 @@
 import { expect } from 'chai';
 import { Notification } from 'electron/main';
 import { once } from 'node:events';
+import { setTimeout } from 'node:timers/promises';
 import { ifit } from './lib/spec-helpers';
 
 describe('Notification module', () => {
@@ -112,6 +113,85 @@ describe('Notification module', () => {
     n.close();
   });
 
+  it('inits, gets and sets tag and coalesceInterval', () => {
+    const n = new Notification({
+      tag: 'tag',
+      coalesceInterval: 1000
+    });
+
+    expect(n.tag).to.equal('tag');
+    n.tag = 'tag1';
+    expect(n.tag).to.equal('tag1');
+
+    expect(n.coalesceInterval).to.equal(1000);
+    n.coalesceInterval = 500;
+    expect(n.coalesceInterval).to.equal(500);
+    n.coalesceInterval = -1;
+    expect(n.coalesceInterval).to.equal(0);
+  });
+
+  ifit(process.platform === 'darwin')('can show and close coalesced notifications', async () => {
+    const options = { title: 'test notification', silent: true, tag: 'coalesced', coalesceInterval: 1000 };
+    const first = new Notification(options);
+    const second = new Notification(options);
+    let secondShown = false;
+    second.on('show', () => { secondShown = true; });
+
+    const firstShown = once(first, 'show');
+    first.show();
+    second.show();
+    await firstShown;
+
+    // Closing the notification held back keeps it from being displayed when
+    // the interval ends.
+    second.close();
+    await setTimeout(1500);
+    expect(secondShown).to.be.false();
+
+    const firstClosed = once(first, 'close');
+    first.close();
+    await firstClosed;
+  });
+
+  ifit(process.platform === 'darwin')('displays only the last notification shown during the coalesce interval', async () => {
+    const options = { title: 'test notification', silent: true, tag: 'coalesced-mac', coalesceInterval: 200 };
+    const first = new Notification(options);
+    const second = new Notification(options);
+    const third = new Notification(options);
+    let secondShown = false;
+    second.on('show', () => { secondShown = true; });
+
+    const firstShown = once(first, 'show');
+    first.show();
+    second.show();
+    third.show();
+    await firstShown;
+    await once(third, 'show');
+    expect(secondShown).to.be.false();
+    third.close();
+  });
+
+  it('keeps the notification held back alive until the coalesce interval ends', async () => {
+    const v8Util = process._linkedBinding('electron_common_v8_util');
+    const options = { title: 'test notification', silent: true, tag: 'coalesced-gc', coalesceInterval: 1000 };
+    const first = new Notification(options);
+    first.show();
+    let collected = false;
+    const registry = new FinalizationRegistry(() => { collected = true; });
+    (() => {
+      const second = new Notification(options);
+      registry.register(second, null);
+      second.show();
+    })();
+    for (let i = 0; i < 5; i++) {
+      v8Util.requestGarbageCollectionForTesting();
+      await setTimeout(100);
+    }
+    expect(collected).to.be.false();
+    await setTimeout(1000);
+    first.close();
+  });
+
   ifit(process.platform === 'win32')('inits, gets and sets custom xml', () => {
     const n = new Notification({
       toastXml: '<xml/>'
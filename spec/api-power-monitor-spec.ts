@@ -8,7 +8,7 @@
 // python-dbusmock.
 import { expect } from 'chai';
 import * as dbus from 'dbus-native';
-import { ifdescribe, startRemoteControlApp } from './lib/spec-helpers';
+import { defer, ifdescribe, ifit, startRemoteControlApp } from './lib/spec-helpers';
 import { promisify } from 'node:util';
 import { setTimeout } from 'node:timers/promises';
 import { once } from 'node:events';
@@ -173,6 +173,41 @@ describe('powerMonitor', () => {
       });
     });
 
+    describe('powerMonitor.setIdleThreshold', () => {
+      afterEach(() => {
+        powerMonitor.setIdleThreshold(0);
+      });
+
+      it('accepts a threshold and 0 to stop', () => {
+        expect(() => {
+          powerMonitor.setIdleThreshold(60);
+          powerMonitor.setIdleThreshold(0);
+        }).to.not.throw();
+      });
+
+      it('does not accept a negative threshold', () => {
+        expect(() => {
+          powerMonitor.setIdleThreshold(-1);
+        }).to.throw(/must not be negative/);
+      });
+
+      // The system idle time can only be faked when DCHECK_IS_ON.
+      const binding = process._linkedBinding('electron_browser_power_monitor');
+      ifit(binding._setSystemIdleTimeForTesting != null)('emits "idle" and then "active" when input resumes', async () => {
+        const setSystemIdleTime = binding._setSystemIdleTimeForTesting!;
+        defer(() => setSystemIdleTime(-1));
+
+        setSystemIdleTime(120);
+        const idle = once(powerMonitor, 'idle');
+        powerMonitor.setIdleThreshold(60);
+        await idle;
+
+        const active = once(powerMonitor, 'active');
+        setSystemIdleTime(0);
+        await active;
+      });
+    });
+
     describe('powerMonitor.getSystemIdleTime', () => {
       it('returns current system idle time', () => {
         const idleTime = powerMonitor.getSystemIdleTime();
@@ -22,6 +22,18 @@ describe('process module', () => {
       });
     });
 
+    describe('process.getStartupTimings()', () => {
+      it('returns the renderer startup stages', async () => {
+        const timings = await w.webContents.executeJavaScript('process.getStartupTimings()');
+        const names = timings.map((timing: any) => timing.name);
+        expect(names).to.include('RendererClientBase::RenderThreadStarted');
+        for (const timing of timings) {
+          expect(timing.startTime).to.be.a('number');
+          expect(timing.duration).to.be.a('number').and.be.at.least(0);
+        }
+      });
+    });
+
     describe('process.getCPUUsage()', () => {
       it('returns a cpu usage object', async () => {
         const cpuUsage = await w.webContents.executeJavaScript('process.getCPUUsage()');
@@ -120,6 +132,36 @@ describe('process module', () => {
       });
     });
 
+    describe('process.getStartupTimings()', () => {
+      it('returns the main process startup stages in order', () => {
+        const timings = process.getStartupTimings();
+        const names = timings.map(timing => timing.name);
+        expect(names).to.include.members([
+          'ElectronMainDelegate::BasicStartupComplete',
+          'NodeBindings::CreateEnvironment',
+          'NodeBindings::LoadEnvironment',
+          'ElectronBrowserMainParts::PostEarlyInitialization'
+        ]);
+        expect(names.indexOf('NodeBindings::CreateEnvironment')).to.be.lessThan(names.indexOf('ElectronBrowserMainParts::PostEarlyInitialization'));
+      });
+    });
+
+    describe('process.getHistograms()', () => {
+      it('returns the samples of the Electron histograms', () => {
+        const w = new BrowserWindow({ show: false });
+        defer(() => w.destroy());
+        const histograms = process.getHistograms();
+        const histogram = histograms.find(histogram => histogram.name === 'Electron.Window.CreationTime');
+        expect(histogram).to.not.be.undefined();
+        expect(histogram!.count).to.be.at.least(1);
+        const bucketCount = histogram!.buckets.reduce((sum, bucket) => sum + bucket.count, 0);
+        expect(bucketCount).to.equal(histogram!.count);
+        for (const { name } of histograms) {
+          expect(name.startsWith('Electron.')).to.be.true('name starts with Electron.');
+        }
+      });
+    });
+
     describe('process.getCPUUsage()', () => {
       it('returns a cpu usage object', () => {
         const cpuUsage = process.getCPUUsage();
@@ -203,5 +245,23 @@ describe('process module', () => {
         expect(success).to.be.false();
       });
     });
+
+    describe('process.startCpuProfiler()', () => {
+      it('records samples until stopped', () => {
+        expect(process.startCpuProfiler({ samplingInterval: 100 })).to.be.true();
+        defer(() => process.stopCpuProfiler());
+        expect(process.startCpuProfiler()).to.be.false();
+        const end = Date.now() + 50;
+        while (Date.now() < end);
+        const profile = process.stopCpuProfiler();
+        expect(profile.nodes).to.be.an('array').that.is.not.empty();
+        expect(profile.nodes[0]).to.have.property('callFrame');
+        expect(profile.samples).to.have.lengthOf(profile.timeDeltas.length);
+      });
+
+      it('returns null when stopping while it is not running', () => {
+        expect(process.stopCpuProfiler()).to.be.null();
+      });
+    });
   });
 });
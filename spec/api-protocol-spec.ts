@@ -358,6 +358,19 @@ describe('protocol module', () => {
         expect(r.data).to.equal(text);
       });
 
+      it('sends large responses from the target URL', async () => {
+        const data = 'a'.repeat(8 * 1024 * 1024);
+        const server = http.createServer((req, res) => {
+          res.end(data);
+        });
+        after(() => server.close());
+        const { url } = await listen(server);
+
+        registerHttpProtocol(protocolName, (request, callback) => callback({ url }));
+        const r = await ajax(protocolName + '://fake-host');
+        expect(r.data).to.have.lengthOf(data.length);
+      });
+
       it('can access request headers', (done) => {
         protocol.registerHttpProtocol(protocolName, (request) => {
           try {
@@ -453,6 +466,20 @@ describe('protocol module', () => {
         expect(r.data).to.have.lengthOf(data.length);
       });
 
+      it('keeps the order of many small chunks', async () => {
+        const lines = Array.from({ length: 100000 }, (_, i) => `line ${i}\n`);
+        registerStreamProtocol(protocolName, (request, callback) => {
+          let next = 0;
+          callback(new stream.Readable({
+            read () {
+              this.push(next < lines.length ? lines[next++] : null);
+            }
+          }));
+        });
+        const r = await ajax(protocolName + '://fake-host');
+        expect(r.data).to.equal(lines.join(''));
+      });
+
       it('can handle a stream completing while writing', async () => {
         function dumbPassthrough () {
           return new stream.Transform({
@@ -1117,6 +1144,31 @@ describe('protocol module', () => {
       ChildProcess.spawnSync(process.execPath, [appPath, 'true', codeCachePath]);
       expect(fs.readdirSync(path.join(codeCachePath, 'js')).length).to.above(2);
     });
+
+    it('code caches the DevTools front-end', async () => {
+      const appPath = path.join(fixturesPath, 'apps', 'devtools-code-cache');
+      ChildProcess.spawnSync(process.execPath, [appPath, codeCachePath]);
+      expect(fs.readdirSync(path.join(codeCachePath, 'js')).length).to.above(2);
+    });
+  });
+
+  describe('protocol.registerSchemesAsPrivileged processPerSite', () => {
+    const appPath = path.join(fixturesPath, 'apps', 'process-per-site');
+
+    it('shares one sandboxed renderer process per site', () => {
+      const { stdout } = ChildProcess.spawnSync(process.execPath, [appPath], { encoding: 'utf8' });
+      const results = JSON.parse(stdout.trim().split('\n').pop()!);
+      expect(results.shared[0]).to.equal(results.shared[1]);
+      expect(results.shared[2]).to.not.equal(results.shared[0]);
+      expect(results.separate[0]).to.not.equal(results.separate[1]);
+    });
+
+    it('does not let windows without the sandbox join a shared renderer', () => {
+      const { stdout } = ChildProcess.spawnSync(process.execPath, [appPath], { encoding: 'utf8' });
+      const results = JSON.parse(stdout.trim().split('\n').pop()!);
+      expect(results.unsandboxed).to.deep.equal(['ERR_BLOCKED_BY_CLIENT']);
+      expect(results.nodeIntegration).to.deep.equal(['ERR_BLOCKED_BY_CLIENT']);
+    });
   });
 
   describe('handle', () => {
@@ -1129,6 +1181,30 @@ describe('protocol module', () => {
       expect(resp.status).to.equal(200);
     });
 
+    it('reuses responses with a max-age when cache is enabled', async () => {
+      let calls = 0;
+      protocol.handle('test-scheme', () => {
+        calls++;
+        return new Response(`response ${calls}`, { headers: { 'cache-control': 'max-age=60' } });
+      }, { cache: true });
+      defer(() => { protocol.unhandle('test-scheme'); });
+      expect(await (await net.fetch('test-scheme://foo')).text()).to.equal('response 1');
+      expect(await (await net.fetch('test-scheme://foo')).text()).to.equal('response 1');
+      expect(await (await net.fetch('test-scheme://bar')).text()).to.equal('response 2');
+      expect(calls).to.equal(2);
+    });
+
+    it('does not reuse responses that may not be stored', async () => {
+      let calls = 0;
+      protocol.handle('test-scheme', () => {
+        calls++;
+        return new Response(`response ${calls}`, { headers: { 'cache-control': 'no-store' } });
+      }, { cache: true });
+      defer(() => { protocol.unhandle('test-scheme'); });
+      expect(await (await net.fetch('test-scheme://foo')).text()).to.equal('response 1');
+      expect(await (await net.fetch('test-scheme://foo')).text()).to.equal('response 2');
+    });
+
     it('can be unhandled', async () => {
       protocol.handle('test-scheme', (req) => new Response('hello ' + req.url));
       defer(() => {
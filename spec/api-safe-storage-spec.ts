@@ -91,6 +91,32 @@ describe('safeStorage module', () => {
     });
   });
 
+  describe('SafeStorage.encryptStrings()', () => {
+    it('encrypts each string', async () => {
+      const plaintexts = ['plaintext', '€ - utf symbol', ''];
+      const encrypted = await safeStorage.encryptStrings(plaintexts);
+      expect(encrypted).to.have.lengthOf(plaintexts.length);
+      expect(encrypted.map(buffer => safeStorage.decryptString(buffer))).to.deep.equal(plaintexts);
+    });
+  });
+
+  describe('SafeStorage.decryptStrings()', () => {
+    it('decrypts each buffer', async () => {
+      const plaintexts = Array.from({ length: 100 }, (_, i) => `secret ${i}`);
+      const encrypted = plaintexts.map(plaintext => safeStorage.encryptString(plaintext));
+      expect(await safeStorage.decryptStrings(encrypted)).to.deep.equal(plaintexts);
+    });
+
+    it('rejects when a buffer is not encrypted', async () => {
+      const encrypted = [safeStorage.encryptString('plaintext'), Buffer.from('plaintext')];
+      await expect(safeStorage.decryptStrings(encrypted)).to.eventually.be.rejectedWith(/index 1 .* does not appear to be encrypted/);
+    });
+
+    it('rejects non-buffer input', async () => {
+      await expect(safeStorage.decryptStrings(['plaintext'] as any)).to.eventually.be.rejected();
+    });
+  });
+
   describe('safeStorage persists encryption key across app relaunch', () => {
     it('can decrypt after closing and reopening app', async () => {
       const fixturesPath = path.resolve(__dirname, 'fixtures');
@@ -22,6 +22,15 @@ describe('screen module', () => {
     });
   });
 
+  describe('screen.displaysVersion', () => {
+    it('stays the same while displays are unchanged', () => {
+      const { displaysVersion } = screen;
+      expect(displaysVersion).to.be.a('number');
+      screen.getAllDisplays();
+      expect(screen.displaysVersion).to.equal(displaysVersion);
+    });
+  });
+
   describe('screen.getPrimaryDisplay()', () => {
     let display: Display | null = null;
 
@@ -30,6 +30,9 @@ describe('session.serviceWorkers', () => {
       if (file.endsWith('.js')) {
         res.setHeader('Content-Type', 'application/javascript');
       }
+      if (file === 'sw-sources.js') {
+        res.setHeader('Content-Security-Policy', "script-src 'self'");
+      }
       res.end(fs.readFileSync(path.resolve(__dirname, 'fixtures', 'api', 'service-workers', file)));
     });
     const { port } = await listen(server);
@@ -90,4 +93,48 @@ describe('session.serviceWorkers', () => {
       expect(messages['error log']).to.have.property('level', 3);
     });
   });
+
+  describe('setConsoleMessageFilter()', () => {
+    afterEach(() => {
+      ses.serviceWorkers.setConsoleMessageFilter(null);
+    });
+
+    it('drops the messages below the level', async () => {
+      ses.serviceWorkers.setConsoleMessageFilter({ level: 2 });
+      const messages: string[] = [];
+      w.loadURL(`${baseUrl}/logs.html`);
+      for await (const [, details] of on(ses.serviceWorkers, 'console-message')) {
+        messages.push(details.message);
+        if (messages.length >= 2) break;
+      }
+      expect(messages).to.deep.equal(['warn log', 'error log']);
+    });
+
+    it('keeps the current filter when given an invalid one', async () => {
+      ses.serviceWorkers.setConsoleMessageFilter({ level: 2 });
+      expect(() => ses.serviceWorkers.setConsoleMessageFilter({ level: 1, sources: 'console-api' as any })).to.throw();
+      const messages: string[] = [];
+      w.loadURL(`${baseUrl}/logs.html`);
+      for await (const [, details] of on(ses.serviceWorkers, 'console-message')) {
+        messages.push(details.message);
+        if (messages.length >= 2) break;
+      }
+      expect(messages).to.deep.equal(['warn log', 'error log']);
+    });
+
+    it('drops the messages of other sources', async () => {
+      // The worker logs with console.log() and then violates its CSP, which
+      // logs a security message.
+      ses.serviceWorkers.setConsoleMessageFilter({ sources: ['security'] });
+      w.loadURL(`${baseUrl}/sources.html`);
+      const [, details] = await once(ses.serviceWorkers, 'console-message');
+      expect(details).to.have.property('source', 'security');
+      expect(details.message).to.not.equal('console log');
+    });
+
+    it('throws for invalid filters', () => {
+      expect(() => ses.serviceWorkers.setConsoleMessageFilter({ sources: 'console-api' as any })).to.throw(/sources must be an array of strings/);
+      expect(() => ses.serviceWorkers.setConsoleMessageFilter({ level: 'warning' as any })).to.throw(/level must be a number/);
+    });
+  });
 });
@@ -4,11 +4,12 @@ import * as https from 'node:https';
 import * as path from 'node:path';
 import * as fs from 'node:fs';
 import * as ChildProcess from 'node:child_process';
+import * as crypto from 'node:crypto';
 import { app, session, BrowserWindow, net, ipcMain, Session, webFrameMain, WebFrameMain } from 'electron/main';
 import * as send from 'send';
 import * as auth from 'basic-auth';
 import { closeAllWindows } from './lib/window-helpers';
-import { defer, listen } from './lib/spec-helpers';
+import { defer, ifit, listen, startRemoteControlApp, waitUntil } from './lib/spec-helpers';
 import { once } from 'node:events';
 import { setTimeout } from 'node:timers/promises';
 
@@ -26,6 +27,63 @@ describe('session module', () => {
     it('returns existing session with same partition', () => {
       expect(session.fromPartition('test')).to.equal(session.fromPartition('test'));
     });
+
+    it('creates lightweight sessions that are isolated from each other', async () => {
+      const a = session.fromPartition(`${Math.random()}`, { lightweight: true });
+      const b = session.fromPartition(`${Math.random()}`, { lightweight: true });
+      expect(a).to.not.equal(b);
+      await a.cookies.set({ url, name: 'lightweight', value: '1' });
+      expect(await a.cookies.get({ url, name: 'lightweight' })).to.have.lengthOf(1);
+      expect(await b.cookies.get({ url, name: 'lightweight' })).to.have.lengthOf(0);
+    });
+
+    it('keeps the HTTP cache of a persistent session in memory with cacheBackend: memory', async () => {
+      const server = http.createServer((req, res) => {
+        res.setHeader('Cache-Control', 'max-age=3600');
+        res.end('x'.repeat(1024));
+      });
+      const { url } = await listen(server);
+      defer(() => server.close());
+      const ses = session.fromPartition(`persist:${Math.random()}`, { cacheBackend: 'memory', cacheSize: 1024 * 1024 });
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      defer(() => w.destroy());
+      await w.loadURL(url);
+      expect(await ses.getCacheSize()).to.be.greaterThan(0);
+      expect(fs.existsSync(path.join(ses.storagePath!, 'Cache'))).to.equal(false);
+    });
+  });
+
+  describe('session.setSparePartitionCount(count)', () => {
+    afterEach(() => {
+      session.setSparePartitionCount(0);
+    });
+
+    it('hands out distinct sessions from the pool', async () => {
+      session.setSparePartitionCount(2);
+      await setTimeout(100);
+      const a = session.fromPartition(`${Math.random()}`, { lightweight: true });
+      const b = session.fromPartition(`${Math.random()}`, { lightweight: true });
+      const c = session.fromPartition(`${Math.random()}`, { lightweight: true });
+      expect(new Set([a, b, c]).size).to.equal(3);
+    });
+
+    const binding = process._linkedBinding('electron_browser_session');
+    ifit(binding._getSparePartitionCountForTesting != null)('hands a spare session to a new lightweight partition', async () => {
+      const getSpareCount = binding._getSparePartitionCountForTesting!;
+      session.setSparePartitionCount(1);
+      await waitUntil(() => getSpareCount() === 1);
+
+      session.fromPartition(`${Math.random()}`, { lightweight: true });
+      expect(getSpareCount()).to.equal(0);
+      await waitUntil(() => getSpareCount() === 1);
+
+      session.fromPartition(`${Math.random()}`, { lightweight: true, cache: false });
+      expect(getSpareCount()).to.equal(1);
+    });
+
+    it('throws for a negative count', () => {
+      expect(() => session.setSparePartitionCount(-1)).to.throw(/count must be a non-negative integer/);
+    });
   });
 
   describe('session.fromPath(path)', () => {
@@ -210,6 +268,45 @@ describe('session module', () => {
       expect(removeEventRemoved).to.equal(true);
     });
 
+    describe('ses.cookies.setChangeNotificationOptions()', () => {
+      it('only emits the changes matching the filters', async () => {
+        const { cookies } = session.fromPartition(`${Math.random()}`);
+        cookies.setChangeNotificationOptions({ filters: [{ name: 'wanted' }] });
+        const names: string[] = [];
+        cookies.on('changed', (event, cookie) => names.push(cookie.name));
+
+        await cookies.set({ url, name: 'ignored', value: '1' });
+        const changed = once(cookies, 'changed');
+        await cookies.set({ url, name: 'wanted', value: '1' });
+        await changed;
+        expect(names).to.deep.equal(['wanted']);
+      });
+
+      it('coalesces changes into batches', async () => {
+        const { cookies } = session.fromPartition(`${Math.random()}`);
+        cookies.setChangeNotificationOptions({ batchInterval: 100 });
+        let changedEvents = 0;
+        cookies.on('changed', () => changedEvents++);
+
+        const batch = once(cookies, 'changed-batch');
+        await cookies.setMany([
+          { url, name: 'a', value: '1' },
+          { url, name: 'b', value: '2' },
+          { url, name: 'c', value: '3' }
+        ]);
+        const [, changes] = await batch;
+        expect(changes.map((change: any) => change.cookie.name)).to.deep.equal(['a', 'b', 'c']);
+        expect(changes[0].cause).to.equal('explicit');
+        expect(changes[0].removed).to.be.false();
+        expect(changedEvents).to.equal(0);
+      });
+
+      it('validates the filters', () => {
+        const { cookies } = session.fromPartition(`${Math.random()}`);
+        expect(() => cookies.setChangeNotificationOptions({ filters: [{}] })).to.throw("Each filter must have a 'domain' or a 'name'");
+      });
+    });
+
     describe('ses.cookies.flushStore()', async () => {
       it('flushes the cookies to disk', async () => {
         const name = 'foo';
@@ -221,6 +318,84 @@ describe('session module', () => {
       });
     });
 
+    describe('ses.cookies.setMany()', () => {
+      it('sets the cookies and reports the ones that failed', async () => {
+        const { cookies } = session.fromPartition(`${Math.random()}`);
+        const errors = await cookies.setMany([
+          { url, name: 'a', value: '1' },
+          { url, name: 'b', value: '2', sameSite: 'bogus' as any },
+          { url, name: 'c', value: '3' }
+        ]);
+        expect(errors).to.have.lengthOf(3);
+        expect(errors[0]).to.equal('');
+        expect(errors[1]).to.match(/to an appropriate cookie same site value/);
+        expect(errors[2]).to.equal('');
+
+        const [named, all] = await cookies.getMany([{ url, name: 'c' }, {}]);
+        expect(named.map(c => c.value)).to.deep.equal(['3']);
+        expect(all.map(c => c.name).sort()).to.deep.equal(['a', 'c']);
+
+        await cookies.removeMany([{ url, name: 'a' }, { url, name: 'c' }]);
+        expect(await cookies.get({})).to.be.empty();
+      });
+    });
+
+    describe('ses.cookies.export()', () => {
+      it('round-trips the cookie jar', async () => {
+        const source = session.fromPartition(`${Math.random()}`).cookies;
+        const expirationDate = Math.floor(Date.now() / 1000) + 3600;
+        await source.set({ url, name: 'persistent', value: 'p', expirationDate, httpOnly: true });
+        await source.set({ url, name: 'session', value: 's', sameSite: 'strict' });
+        const data = await source.export();
+        expect(data).to.be.an.instanceOf(Buffer);
+
+        const target = session.fromPartition(`${Math.random()}`).cookies;
+        expect(await target.import(data)).to.equal(2);
+        const imported = await target.get({});
+        const persistent = imported.find(c => c.name === 'persistent')!;
+        expect(persistent.value).to.equal('p');
+        expect(persistent.httpOnly).to.be.true();
+        expect(persistent.expirationDate).to.be.closeTo(expirationDate, 1);
+        expect(imported.find(c => c.name === 'session')!.sameSite).to.equal('strict');
+      });
+
+      it('keeps the partition of partitioned cookies', async () => {
+        const frameCookies: (string | undefined)[] = [];
+        const server = http.createServer((req, res) => {
+          if (req.url === '/frame') {
+            frameCookies.push(req.headers.cookie);
+            res.setHeader('Set-Cookie', 'chip=1; Secure; SameSite=None; Partitioned; Path=/');
+            res.end();
+          } else {
+            res.setHeader('Content-Type', 'text/html');
+            res.end(`<iframe src="http://localhost:${port}/frame"></iframe>`);
+          }
+        });
+        const { port } = await listen(server);
+        defer(() => server.close());
+
+        const source = session.fromPartition(`${Math.random()}`);
+        const w = new BrowserWindow({ show: false, webPreferences: { session: source } });
+        defer(() => w.destroy());
+        await w.loadURL(`http://127.0.0.1:${port}/`);
+        const data = await source.cookies.export();
+
+        const target = session.fromPartition(`${Math.random()}`);
+        expect(await target.cookies.import(data)).to.equal(1);
+        const w2 = new BrowserWindow({ show: false, webPreferences: { session: target } });
+        defer(() => w2.destroy());
+        // The cookie is only sent within the top-level site it was set under.
+        await w2.loadURL(`http://localhost:${port}/frame`);
+        await w2.loadURL(`http://127.0.0.1:${port}/`);
+        expect(frameCookies).to.deep.equal([undefined, undefined, 'chip=1']);
+      });
+
+      it('rejects data that was not exported', async () => {
+        const { cookies } = session.fromPartition(`${Math.random()}`);
+        await expect(cookies.import(Buffer.from('garbage'))).to.eventually.be.rejectedWith('Expected a buffer returned by cookies.export()');
+      });
+    });
+
     it('should survive an app restart for persistent partition', async function () {
       this.timeout(60000);
       const appPath = path.join(fixtures, 'api', 'cookie-app');
@@ -262,6 +437,28 @@ describe('session module', () => {
         // trying until it is.
       }
     });
+
+    it('clears origins one at a time and reports the progress', async () => {
+      const ses = session.fromPartition(`clear-storage-${Math.random()}`);
+      const origins = ['https://a.example.com', 'https://b.example.com', 'https://c.example.com'];
+      const progress: any[] = [];
+      const onProgress = (event: Electron.Event, details: any) => progress.push(details);
+      ses.on('clear-storage-data-progress', onProgress);
+      defer(() => ses.off('clear-storage-data-progress', onProgress));
+      await ses.clearStorageData({ origins, interval: 10, storages: ['localstorage'] });
+      expect(progress).to.deep.equal(origins.map((origin, i) => ({
+        origin,
+        completed: i + 1,
+        total: origins.length
+      })));
+    });
+
+    it('rejects when both origin and origins are passed', async () => {
+      await expect(session.defaultSession.clearStorageData({
+        origin: 'https://a.example.com',
+        origins: ['https://b.example.com']
+      })).to.eventually.be.rejectedWith(/either 'origin' or 'origins'/);
+    });
   });
 
   describe('will-download event', () => {
@@ -530,6 +727,31 @@ describe('session module', () => {
     });
   });
 
+  describe('ses.resolveHosts(hosts)', () => {
+    const customSession = session.fromPartition('resolvehost');
+
+    it('resolves every host in order', async () => {
+      const results = await customSession.resolveHosts(['ipv4.localhost2', 'notfound.localhost2', 'ipv6.localhost2'], {
+        concurrency: 2
+      });
+      expect(results.map(result => result.host)).to.deep.equal(['ipv4.localhost2', 'notfound.localhost2', 'ipv6.localhost2']);
+      expect(results[0].endpoints![0].address).to.equal('10.0.0.1');
+      expect(results[1].error).to.equal('net::ERR_NAME_NOT_RESOLVED');
+      expect(results[2].endpoints![0].address).to.equal('::1');
+      for (const result of results) {
+        expect(result.duration).to.be.a('number');
+      }
+    });
+
+    it('resolves an empty list', async () => {
+      expect(await customSession.resolveHosts([])).to.deep.equal([]);
+    });
+
+    it('throws for an invalid concurrency', () => {
+      expect(() => customSession.resolveHosts(['ipv4.localhost2'], { concurrency: 0 })).to.throw(/concurrency must be between 1 and 64/);
+    });
+  });
+
   describe('ses.getBlobData()', () => {
     const scheme = 'cors-blob';
     const protocol = session.defaultSession.protocol;
@@ -621,6 +843,52 @@ describe('session module', () => {
     });
   });
 
+  describe('ses.getBlobDataStream()', () => {
+    const scheme = 'stream-blob';
+    const protocol = session.defaultSession.protocol;
+    const url = `${scheme}://host`;
+    afterEach(async () => {
+      protocol.unregisterProtocol(scheme);
+      await closeAllWindows();
+    });
+
+    it('streams blob data larger than the pipe for uuid', async () => {
+      // Larger than the pipe, so the blob has to be written in several parts.
+      const size = 3 * 1024 * 1024 + 1;
+      const content = `<html>
+                       <script>
+                       let fd = new FormData();
+                       fd.append("data", new Blob([new Uint8Array(${size}).fill(97)]));
+                       fetch('${url}', {method:'POST', body: fd });
+                       </script>
+                       </html>`;
+      const received = new Promise<Buffer>((resolve, reject) => {
+        protocol.registerStringProtocol(scheme, (request, callback) => {
+          if (request.method === 'GET') {
+            callback({ data: content, mimeType: 'text/html' });
+            return;
+          }
+          const uuid = request.uploadData![1].blobUUID!;
+          const chunks: Buffer[] = [];
+          const stream = session.defaultSession.getBlobDataStream(uuid);
+          stream.on('data', (chunk) => chunks.push(chunk));
+          stream.on('end', () => resolve(Buffer.concat(chunks)));
+          stream.on('error', reject);
+          callback({ data: '' });
+        });
+      });
+      const w = new BrowserWindow({ show: false });
+      w.loadURL(url);
+      const result = await received;
+      expect(result.length).to.equal(size);
+      expect(result.every(byte => byte === 97)).to.be.true();
+    });
+
+    it('throws for an unknown uuid', () => {
+      expect(() => session.defaultSession.getBlobDataStream('not-a-uuid')).to.throw(/Could not get blob data handle/);
+    });
+  });
+
   describe('ses.setCertificateVerifyProc(callback)', () => {
     let server: http.Server;
     let serverUrl: string;
@@ -711,6 +979,72 @@ describe('session module', () => {
       expect(numVerificationRequests).to.equal(1);
     });
 
+    const trustedCertificate = (file: string) => {
+      const certificate = new crypto.X509Certificate(fs.readFileSync(path.join(fixtures, 'certificates', file)));
+      return 'sha256/' + crypto.createHash('sha256').update(certificate.raw).digest('base64');
+    };
+
+    it('accepts a trusted server certificate without a proc', async () => {
+      const ses = session.fromPartition(`${Math.random()}`);
+      ses.setCertificateVerifyProc(null, {
+        trustedCertificates: [{ hostname: 'localhost', fingerprint: trustedCertificate('server.pem') }]
+      });
+
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      await w.loadURL(serverUrl.replace('127.0.0.1', 'localhost'));
+      expect(w.webContents.getTitle()).to.equal('hello');
+    });
+
+    it('does not trust the other certificates of the chain', async () => {
+      const ses = session.fromPartition(`${Math.random()}`);
+      ses.setCertificateVerifyProc(null, {
+        trustedCertificates: [{ hostname: 'localhost', fingerprint: trustedCertificate('intermediateCA.pem') }]
+      });
+
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      await expect(w.loadURL(serverUrl.replace('127.0.0.1', 'localhost'))).to.eventually.be.rejectedWith(/ERR_CERT_AUTHORITY_INVALID/);
+    });
+
+    it('does not trust a certificate for other hosts', async () => {
+      const ses = session.fromPartition(`${Math.random()}`);
+      ses.setCertificateVerifyProc(null, {
+        trustedCertificates: [{ hostname: 'example.com', fingerprint: trustedCertificate('server.pem') }]
+      });
+
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      await expect(w.loadURL(serverUrl.replace('127.0.0.1', 'localhost'))).to.eventually.be.rejectedWith(/ERR_CERT_AUTHORITY_INVALID/);
+    });
+
+    it('calls proc with the result of the policies', async () => {
+      const ses = session.fromPartition(`${Math.random()}`);
+      const errorCodes: number[] = [];
+      ses.setCertificateVerifyProc(({ hostname, errorCode }, callback) => {
+        if (hostname === 'localhost') errorCodes.push(errorCode);
+        callback(-2);
+      }, {
+        trustedCertificates: [{ hostname: 'localhost', fingerprint: trustedCertificate('server.pem') }]
+      });
+
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      await expect(w.loadURL(serverUrl.replace('127.0.0.1', 'localhost'))).to.eventually.be.rejectedWith(/ERR_FAILED/);
+      expect(errorCodes).to.not.be.empty();
+      expect(errorCodes.every(code => code === 0)).to.be.true();
+    });
+
+    it('validates its options', () => {
+      const ses = session.fromPartition(`${Math.random()}`);
+      expect(() => ses.setCertificateVerifyProc(null, { cacheTTL: -1 })).to.throw('cacheTTL must be a non-negative number');
+      expect(() => ses.setCertificateVerifyProc(null, {
+        pinnedPublicKeys: [{ hostname: 'localhost', hashes: ['not-a-hash'] }]
+      })).to.throw('Invalid public key hash: not-a-hash');
+      expect(() => ses.setCertificateVerifyProc(null, {
+        trustedCertificates: [{ hostname: 'localhost', fingerprint: 'sha1/AAAA' }]
+      })).to.throw('Invalid certificate fingerprint: sha1/AAAA');
+      expect(() => ses.setCertificateVerifyProc(null, {
+        trustedCertificates: [{ fingerprint: 'sha256/AAAA' } as any]
+      })).to.throw('Trusted certificates must have a hostname and fingerprint');
+    });
+
     it('does not cancel requests in other sessions', async () => {
       const ses1 = session.fromPartition(`${Math.random()}`);
       ses1.setCertificateVerifyProc((opts, cb) => cb(0));
@@ -897,6 +1231,70 @@ describe('session module', () => {
         }).to.throw(/Invalid value for headers - must be an object/);
       });
 
+      it('completes a download whose sha256 matches', async () => {
+        const sha256 = crypto.createHash('sha256').update(mockPDF).digest('hex');
+        const downloadDone = new Promise<string>((resolve) => {
+          session.defaultSession.once('will-download', (e, item) => {
+            item.savePath = downloadFilePath;
+            item.on('done', (e, state) => resolve(state));
+          });
+        });
+        session.defaultSession.downloadURL(`${url}:${port}`, { sha256 });
+        expect(await downloadDone).to.equal('completed');
+        fs.unlinkSync(downloadFilePath);
+      });
+
+      it('cancels a download whose sha256 does not match', async () => {
+        const downloadDone = new Promise<string>((resolve) => {
+          session.defaultSession.once('will-download', (e, item) => {
+            item.savePath = downloadFilePath;
+            item.on('done', (e, state) => resolve(state));
+          });
+        });
+        session.defaultSession.downloadURL(`${url}:${port}`, { sha256: '0'.repeat(64) });
+        expect(await downloadDone).to.equal('cancelled');
+        expect(fs.existsSync(downloadFilePath)).to.equal(false);
+      });
+
+      it('checks the sha256 of a download split into parallel range requests', async () => {
+        const dir = fs.mkdtempSync(path.join(app.getPath('temp'), 'electron-download-'));
+        defer(() => fs.rmSync(dir, { recursive: true, force: true }));
+        const data = crypto.randomBytes(8 * 1024 * 1024);
+        fs.writeFileSync(path.join(dir, 'data.bin'), data);
+        const rangeServer = http.createServer((req, res) => {
+          send(req, req.url!, { root: dir }).pipe(res);
+        });
+        const { url: serverUrl } = await listen(rangeServer);
+        defer(() => rangeServer.close());
+
+        const savePath = path.join(dir, 'saved.bin');
+        const rc = await startRemoteControlApp(['--parallel-download-segments=3']);
+        const download = (sha256: string) => rc.remotely((url: string, savePath: string, sha256: string) => {
+          const { session } = require('electron');
+          return new Promise((resolve) => {
+            session.defaultSession.once('will-download', (e: any, item: any) => {
+              item.savePath = savePath;
+              item.on('done', (e: any, state: string) => resolve(state));
+            });
+            session.defaultSession.downloadURL(url, { sha256 });
+          });
+        }, `${serverUrl}/data.bin`, savePath, sha256);
+
+        const sha256 = crypto.createHash('sha256').update(data).digest('hex');
+        expect(await download(sha256)).to.equal('completed');
+        expect(fs.readFileSync(savePath).equals(data)).to.equal(true);
+        fs.unlinkSync(savePath);
+
+        expect(await download('0'.repeat(64))).to.equal('cancelled');
+        expect(fs.existsSync(savePath)).to.equal(false);
+      });
+
+      it('throws when called with an invalid sha256', () => {
+        expect(() => {
+          session.defaultSession.downloadURL(`${url}:${port}`, { sha256: 'abc' });
+        }).to.throw(/Invalid value for sha256/);
+      });
+
       it('correctly handles a download with an invalid auth header', async () => {
         const server = http.createServer((req, res) => {
           const { authorization } = req.headers;
@@ -1464,6 +1862,42 @@ describe('session module', () => {
     });
   });
 
+  describe('ses.setPermissionCheckCacheEnabled(enabled)', () => {
+    afterEach(closeAllWindows);
+    it('reuses the results of the handler until the cache is cleared', async () => {
+      const w = new BrowserWindow({
+        show: false,
+        webPreferences: {
+          partition: `${Math.random()}`
+        }
+      });
+      const ses = w.webContents.session;
+      let checks = 0;
+      ses.setPermissionCheckHandler((wc, permission) => {
+        if (permission === 'clipboard-read') checks++;
+        return true;
+      });
+      ses.setPermissionCheckCacheEnabled(true);
+      defer(() => ses.setPermissionCheckCacheEnabled(false));
+
+      const readClipboardPermission = () => {
+        return w.webContents.executeJavaScript(`
+          navigator.permissions.query({name: 'clipboard-read'})
+              .then(permission => permission.state).catch(err => err.message);
+        `, true);
+      };
+
+      await w.loadFile(path.join(fixtures, 'api', 'blank.html'));
+      expect(await readClipboardPermission()).to.equal('granted');
+      expect(await readClipboardPermission()).to.equal('granted');
+      expect(checks).to.equal(1);
+
+      ses.clearPermissionCheckCache();
+      expect(await readClipboardPermission()).to.equal('granted');
+      expect(checks).to.equal(2);
+    });
+  });
+
   describe('ses.isPersistent()', () => {
     afterEach(closeAllWindows);
 
@@ -1555,6 +1989,105 @@ describe('session module', () => {
         session.defaultSession.setCodeCachePath(path.join(app.getPath('userData'), 'electron-test-code-cache'));
       }).to.not.throw();
     });
+
+    describe('with sandboxed preload scripts', () => {
+      afterEach(closeAllWindows);
+
+      it('saves a code cache for the preload script', async () => {
+        const ses = session.fromPartition(`persist:code-cache-${Math.random()}`);
+        const codeCachePath = path.join(app.getPath('temp'), `electron-test-code-cache-${Math.random()}`);
+        ses.setCodeCachePath(codeCachePath);
+        defer(() => fs.promises.rm(codeCachePath, { recursive: true, force: true }));
+
+        const preloadCacheDir = path.join(codeCachePath, 'preload');
+        const w = new BrowserWindow({
+          show: false,
+          webPreferences: {
+            session: ses,
+            sandbox: true,
+            preload: path.join(__dirname, 'fixtures', 'module', 'preload-sandbox.js')
+          }
+        });
+        await w.loadURL('about:blank');
+
+        let files: string[] = [];
+        for (let i = 0; i < 50 && files.length === 0; i++) {
+          files = await fs.promises.readdir(preloadCacheDir).catch(() => []);
+          if (files.length === 0) await setTimeout(100);
+        }
+        expect(files).to.have.lengthOf(1);
+        const { size } = await fs.promises.stat(path.join(preloadCacheDir, files[0]));
+        expect(size).to.be.greaterThan(0);
+      });
+
+      it('removes the code caches of preload scripts when clearing all entries', async () => {
+        const ses = session.fromPartition(`persist:code-cache-${Math.random()}`);
+        const codeCachePath = path.join(app.getPath('temp'), `electron-test-code-cache-${Math.random()}`);
+        ses.setCodeCachePath(codeCachePath);
+        defer(() => fs.promises.rm(codeCachePath, { recursive: true, force: true }));
+
+        const preloadCacheDir = path.join(codeCachePath, 'preload');
+        const w = new BrowserWindow({
+          show: false,
+          webPreferences: {
+            session: ses,
+            sandbox: true,
+            preload: path.join(__dirname, 'fixtures', 'module', 'preload-sandbox.js')
+          }
+        });
+        await w.loadURL('about:blank');
+        await waitUntil(() => fs.existsSync(preloadCacheDir) && fs.readdirSync(preloadCacheDir).length > 0);
+
+        await ses.clearCodeCaches({ urls: ['https://example.com/'] });
+        expect(fs.readdirSync(preloadCacheDir)).to.have.lengthOf(1);
+
+        await ses.clearCodeCaches({});
+        expect(fs.existsSync(preloadCacheDir)).to.be.false();
+      });
+    });
+  });
+
+  describe('ses.setSpareRendererCount(count[, webPreferences])', () => {
+    afterEach(closeAllWindows);
+
+    it('throws for a negative count', () => {
+      expect(() => {
+        session.fromPartition('spare-renderers').setSpareRendererCount(-1);
+      }).to.throw('Must pass a non-negative count of spare renderers.');
+    });
+
+    const rendererPids = () => new Set(app.getAppMetrics().filter(p => p.type === 'Tab').map(p => p.pid));
+
+    const launchSpare = async (ses: Session, webPreferences: Electron.WebPreferences) => {
+      const before = rendererPids();
+      ses.setSpareRendererCount(1, webPreferences);
+      defer(() => ses.setSpareRendererCount(0, webPreferences));
+      for (let i = 0; i < 50; i++) {
+        const pid = [...rendererPids()].find(p => !before.has(p));
+        if (pid !== undefined) return pid;
+        await setTimeout(100);
+      }
+      throw new Error('Spare renderer was not launched');
+    };
+
+    it('lets a window with matching preferences adopt a spare renderer', async () => {
+      const ses = session.fromPartition(`spare-renderers-${Math.random()}`);
+      const sparePid = await launchSpare(ses, { sandbox: true });
+
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses, sandbox: true } });
+      await w.loadURL('about:blank');
+      expect(w.webContents.getOSProcessId()).to.equal(sparePid);
+    });
+
+    it('does not give a spare to a window that needs different switches', async () => {
+      const ses = session.fromPartition(`spare-renderers-${Math.random()}`);
+      const sparePid = await launchSpare(ses, { sandbox: true });
+
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses, sandbox: true, experimentalFeatures: true } });
+      await w.loadURL('about:blank');
+      expect(w.webContents.getOSProcessId()).to.not.equal(sparePid);
+      expect(rendererPids().has(sparePid)).to.be.true('spare renderer is still alive');
+    });
   });
 
   describe('ses.setSSLConfig()', () => {
@@ -147,6 +147,42 @@ describe('tray module', () => {
     });
   });
 
+  describe('tray.setImageFrames(images)', () => {
+    it('throws a descriptive error for a missing file', () => {
+      const badPath = path.resolve('I', 'Do', 'Not', 'Exist');
+      expect(() => {
+        tray.setImageFrames([nativeImage.createEmpty(), badPath]);
+      }).to.throw(/Failed to load image from path (.+)/);
+    });
+
+    it('throws for a negative minimumInterval', () => {
+      expect(() => {
+        tray.setImageFrames([nativeImage.createEmpty()], { minimumInterval: -1 });
+      }).to.throw(/'minimumInterval' must not be negative/);
+    });
+
+    it('allows switching between the frames', () => {
+      tray.setImageFrames([nativeImage.createEmpty(), nativeImage.createEmpty()], { minimumInterval: 0 });
+      expect(() => {
+        tray.setImageFrame(1);
+        tray.setImageFrame(0);
+        tray.setImageFrame(0);
+      }).to.not.throw();
+    });
+
+    it('allows switching frames faster than the minimumInterval', () => {
+      tray.setImageFrames([nativeImage.createEmpty(), nativeImage.createEmpty()], { minimumInterval: 1000 });
+      expect(() => {
+        for (let i = 0; i < 10; i++) tray.setImageFrame(i % 2);
+      }).to.not.throw();
+    });
+
+    it('throws for a frame index out of range', () => {
+      tray.setImageFrames([nativeImage.createEmpty()]);
+      expect(() => tray.setImageFrame(1)).to.throw(/Image frame index out of range/);
+    });
+  });
+
   describe('tray.setPressedImage(image)', () => {
     it('throws a descriptive error for a missing file', () => {
       const badPath = path.resolve('I', 'Do', 'Not', 'Exist');
@@ -1,17 +1,26 @@
 import { expect } from 'chai';
 import * as childProcess from 'node:child_process';
 import * as path from 'node:path';
-import { BrowserWindow, MessageChannelMain, utilityProcess, app } from 'electron/main';
-import { ifit } from './lib/spec-helpers';
+import { BrowserWindow, MessageChannelMain, utilityProcess, app, net, protocol } from 'electron/main';
+import { defer, ifdescribe, ifit, waitUntil } from './lib/spec-helpers';
 import { closeWindow } from './lib/window-helpers';
 import { once } from 'node:events';
 import { pathToFileURL } from 'node:url';
-import { setImmediate } from 'node:timers/promises';
+import { setImmediate, setTimeout } from 'node:timers/promises';
 
 const fixturesPath = path.resolve(__dirname, 'fixtures', 'api', 'utility-process');
 const isWindowsOnArm = process.platform === 'win32' && process.arch === 'arm64';
 const isWindows32Bit = process.platform === 'win32' && process.arch === 'ia32';
 
+function isTestingBindingAvailable () {
+  try {
+    process._linkedBinding('electron_common_testing');
+    return true;
+  } catch {
+    return false;
+  }
+}
+
 describe('utilityProcess module', () => {
   describe('UtilityProcess constructor', () => {
     it('throws when empty script path is provided', async () => {
@@ -253,6 +262,74 @@ describe('utilityProcess module', () => {
     });
   });
 
+  describe('priority', () => {
+    it('throws for an invalid priority option', () => {
+      expect(() => {
+        utilityProcess.fork(path.join(fixturesPath, 'empty.js'), [], { priority: 'high' as any });
+      }).to.throw('priority must be one of: normal, background');
+    });
+
+    it('launches a process with background priority', async () => {
+      const child = utilityProcess.fork(path.join(fixturesPath, 'endless.js'), [], { priority: 'background' });
+      await once(child, 'spawn');
+      await waitUntil(() => child.getMetrics() !== null);
+      expect(child.getMetrics()).to.have.property('pid', child.pid);
+      const exit = once(child, 'exit');
+      expect(child.kill()).to.be.true();
+      await exit;
+    });
+
+    it('can lower the priority of a running process', async () => {
+      const child = utilityProcess.fork(path.join(fixturesPath, 'endless.js'));
+      await once(child, 'spawn');
+      expect(() => child.setPriority('background')).to.not.throw();
+      const exit = once(child, 'exit');
+      expect(child.kill()).to.be.true();
+      await exit;
+    });
+
+    it('leaves the pid alone once the process has exited', async () => {
+      const child = utilityProcess.fork(path.join(fixturesPath, 'endless.js'));
+      await once(child, 'spawn');
+      const exit = once(child, 'exit');
+      expect(child.kill()).to.be.true();
+      await exit;
+      expect(() => child.setPriority('background')).to.not.throw();
+    });
+  });
+
+  describe('getMetrics() API', () => {
+    it('returns null once the process has exited', async () => {
+      const child = utilityProcess.fork(path.join(fixturesPath, 'empty.js'));
+      await once(child, 'exit');
+      expect(child.getMetrics()).to.be.null();
+    });
+  });
+
+  describe('createStream() API', () => {
+    it('streams bytes to and from the child process', async () => {
+      const child = utilityProcess.fork(path.join(fixturesPath, 'echo-stream.js'));
+      await once(child, 'spawn');
+      const stream = child.createStream()!;
+      const data = Buffer.alloc(8 * 1024 * 1024);
+      for (let i = 0; i < data.length; i++) data[i] = i % 251;
+      const chunks: Buffer[] = [];
+      stream.on('data', (chunk: Buffer) => chunks.push(chunk));
+      stream.end(data);
+      await once(stream, 'end');
+      expect(Buffer.concat(chunks).equals(data)).to.be.true();
+      const exit = once(child, 'exit');
+      expect(child.kill()).to.be.true();
+      await exit;
+    });
+
+    it('returns null once the child process has exited', async () => {
+      const child = utilityProcess.fork(path.join(fixturesPath, 'empty.js'));
+      await once(child, 'exit');
+      expect(child.createStream()).to.be.null();
+    });
+  });
+
   describe('postMessage() API', () => {
     it('establishes a default ipc channel with the child process', async () => {
       const result = 'I will be echoed.';
@@ -279,6 +356,200 @@ describe('utilityProcess module', () => {
       expect(child.kill()).to.be.true();
       await exit;
     });
+
+    it('shares SharedArrayBuffers created by process.createSharedArrayBuffer()', async () => {
+      const child = utilityProcess.fork(path.join(fixturesPath, 'shared-array-buffer.js'));
+      await once(child, 'spawn');
+      const buffer = process.createSharedArrayBuffer(16);
+      const view = new Int32Array(buffer);
+      child.postMessage({ buffer });
+      const [{ buffer: childBuffer }] = await once(child, 'message');
+      expect(Atomics.load(view, 0)).to.equal(42);
+      const childView = new Int32Array(childBuffer);
+      Atomics.store(childView, 0, 7);
+      child.postMessage('check');
+      const [result] = await once(child, 'message');
+      expect(result).to.equal(7);
+      const exit = once(child, 'exit');
+      expect(child.kill()).to.be.true();
+      await exit;
+    });
+
+    ifdescribe(isTestingBindingAvailable())('when the SharedArrayBuffer regions are held up', () => {
+      const setRegionsDelay = (delay: number) => {
+        process._linkedBinding('electron_common_testing').setSharedArrayBufferRegionsDelay(delay);
+        defer(() => {
+          process._linkedBinding('electron_common_testing').setSharedArrayBufferRegionsDelay(0);
+        });
+      };
+
+      it('delivers the message once the regions arrive', async () => {
+        const child = utilityProcess.fork(path.join(fixturesPath, 'shared-array-buffer.js'));
+        await once(child, 'spawn');
+        setRegionsDelay(500);
+        const buffer = process.createSharedArrayBuffer(16);
+        const view = new Int32Array(buffer);
+        child.postMessage({ buffer });
+        const [{ buffer: childBuffer }] = await once(child, 'message');
+        expect(Atomics.load(view, 0)).to.equal(42);
+        expect(childBuffer).to.be.an.instanceOf(SharedArrayBuffer);
+        const exit = once(child, 'exit');
+        expect(child.kill()).to.be.true();
+        await exit;
+      });
+
+      it('delivers null when the regions never arrive and keeps the later messages in order', async () => {
+        const child = utilityProcess.fork(path.join(fixturesPath, 'post-message.js'));
+        await once(child, 'spawn');
+        setRegionsDelay(-1);
+        child.postMessage({ buffer: process.createSharedArrayBuffer(16) });
+        child.postMessage('after');
+        const [first] = await once(child, 'message');
+        expect(first).to.be.null();
+        const [second] = await once(child, 'message');
+        expect(second).to.equal('after');
+        const exit = once(child, 'exit');
+        expect(child.kill()).to.be.true();
+        await exit;
+      });
+    });
+
+    it('throws when posting other SharedArrayBuffers', async () => {
+      const child = utilityProcess.fork(path.join(fixturesPath, 'post-message.js'));
+      await once(child, 'spawn');
+      expect(() => {
+        child.postMessage({ buffer: new SharedArrayBuffer(16) });
+      }).to.throw(/process\.createSharedArrayBuffer/);
+      const exit = once(child, 'exit');
+      expect(child.kill()).to.be.true();
+      await exit;
+    });
+  });
+
+  describe('protocol.handleInUtilityProcess() API', () => {
+    afterEach(() => {
+      if (protocol.isProtocolHandled('utility-scheme')) {
+        protocol.unhandle('utility-scheme');
+      }
+    });
+
+    it('serves requests with the handler registered by the child', async () => {
+      const child = utilityProcess.fork(path.join(fixturesPath, 'handle-protocol.js'));
+      protocol.handleInUtilityProcess('utility-scheme', child);
+      // Requests made before the child registers its handler wait for it.
+      const response = net.fetch('utility-scheme://host/path');
+      child.postMessage('register');
+      await once(child, 'message');
+      expect(await (await response).text()).to.equal('utility: /path');
+      const body = await net.fetch('utility-scheme://host/', { method: 'POST', body: 'data' }).then(r => r.text());
+      expect(body).to.equal('utility: data');
+      const exit = once(child, 'exit');
+      expect(child.kill()).to.be.true();
+      await exit;
+    });
+
+    it('does not handle built-in schemes', async () => {
+      const child = utilityProcess.fork(path.join(fixturesPath, 'empty.js'));
+      expect(() => protocol.handleInUtilityProcess('https', child)).to.throw(/Cannot handle https/);
+      await once(child, 'exit');
+    });
+  });
+
+  describe('setSpareProcessCount() API', () => {
+    afterEach(() => {
+      utilityProcess.setSpareProcessCount(0);
+    });
+
+    it('throws for a negative count', () => {
+      expect(() => {
+        utilityProcess.setSpareProcessCount(-1);
+      }).to.throw('Must pass a non-negative count of spare processes.');
+    });
+
+    it('runs forked processes in a spare', async () => {
+      utilityProcess.setSpareProcessCount(1);
+      // Give the spare time to launch.
+      await setTimeout(1000);
+      const child = utilityProcess.fork(path.join(fixturesPath, 'post-message.js'));
+      await once(child, 'spawn');
+      child.postMessage('hello');
+      const [data] = await once(child, 'message');
+      expect(data).to.equal('hello');
+      const exit = once(child, 'exit');
+      expect(child.kill()).to.be.true();
+      await exit;
+    });
+
+    it('launches processes normally when the options rule out a spare', async () => {
+      utilityProcess.setSpareProcessCount(1);
+      await setTimeout(1000);
+      const child = utilityProcess.fork(path.join(fixturesPath, 'log.js'), [], {
+        stdio: ['ignore', 'pipe', 'ignore']
+      });
+      await once(child, 'spawn');
+      let log = '';
+      child.stdout!.on('data', (chunk) => {
+        log += chunk.toString('utf8');
+      });
+      await once(child, 'exit');
+      expect(log).to.equal('hello\n');
+    });
+  });
+
+  describe('createPool() API', () => {
+    let pool: Electron.UtilityProcessPool | null = null;
+    afterEach(() => {
+      pool?.close();
+      pool = null;
+    });
+
+    it('throws when size is not a positive integer', () => {
+      expect(() => {
+        utilityProcess.createPool(path.join(fixturesPath, 'pool-worker.js'), [], { size: 0 });
+      }).to.throw('size must be a positive integer.');
+    });
+
+    it('resolves each job with the reply of a worker', async () => {
+      pool = utilityProcess.createPool(path.join(fixturesPath, 'pool-worker.js'), [], { size: 2 });
+      const results = await Promise.all([1, 2, 3, 4].map((value) => pool!.run({ value })));
+      expect(results.map(r => r.value)).to.deep.equal([2, 4, 6, 8]);
+      expect(pool.getStats()).to.deep.include({ workers: 2, queued: 0, inFlight: 0, completed: 4 });
+    });
+
+    it('does not hold short jobs behind a long one', async () => {
+      pool = utilityProcess.createPool(path.join(fixturesPath, 'pool-worker.js'), [], { size: 2 });
+      const long = pool.run({ value: 0, delay: 2000 });
+      const short = await Promise.all([1, 2, 3].map((value) => pool!.run({ value })));
+      expect(pool.getStats().inFlight).to.equal(1);
+      const { pid } = await long;
+      expect(short.every(r => r.pid !== pid)).to.be.true();
+    });
+
+    it('rejects the jobs of a crashed worker and replaces it', async () => {
+      pool = utilityProcess.createPool(path.join(fixturesPath, 'pool-worker.js'), [], { size: 1 });
+      await expect(pool.run({ crash: true })).to.eventually.be.rejectedWith(/exited/);
+      const result = await pool.run({ value: 21 });
+      expect(result.value).to.equal(42);
+      expect(pool.getStats()).to.deep.include({ failed: 1, respawns: 1 });
+    });
+
+    it('stops replacing workers that keep crashing and rejects the queue', async () => {
+      pool = utilityProcess.createPool(path.join(fixturesPath, 'exception.js'), [], { size: 1 });
+      const jobs = [1, 2, 3].map((value) => pool!.run({ value }));
+      const results = await Promise.allSettled(jobs);
+      expect(results.every(r => r.status === 'rejected')).to.be.true();
+      await waitUntil(() => pool!.getStats().respawns === 5 && pool!.getStats().workers === 0);
+      await expect(pool.run({ value: 4 })).to.eventually.be.rejectedWith(/kept exiting/);
+      expect(pool.getStats()).to.deep.include({ queued: 0, inFlight: 0 });
+    });
+
+    it('rejects queued jobs when closed', async () => {
+      pool = utilityProcess.createPool(path.join(fixturesPath, 'pool-worker.js'), [], { size: 1 });
+      pool.run({ value: 0, delay: 1000 }).catch(() => {});
+      const queued = pool.run({ value: 1 });
+      pool.close();
+      await expect(queued).to.eventually.be.rejectedWith('The pool is closed.');
+    });
   });
 
   describe('behavior', () => {
@@ -1,3 +1,4 @@
+import { expect } from 'chai';
 import { closeWindow } from './lib/window-helpers';
 import { BaseWindow, View } from 'electron/main';
 
@@ -12,4 +13,50 @@ describe('View', () => {
     w = new BaseWindow({ show: false });
     w.setContentView(new View());
   });
+
+  describe('view.setFlex', () => {
+    it('lays out the children by weight', () => {
+      w = new BaseWindow({ show: false, width: 400, height: 300 });
+      const parent = new View();
+      const left = new View();
+      const right = new View();
+      parent.setLayout({ orientation: 'horizontal' });
+      left.setFlex({ weight: 1 });
+      right.setFlex({ weight: 3 });
+      parent.addChildView(left);
+      parent.addChildView(right);
+      w.setContentView(parent);
+      parent.setBounds({ x: 0, y: 0, width: 400, height: 300 });
+      expect(left.getBounds().width).to.equal(100);
+      expect(right.getBounds()).to.deep.equal({ x: 100, y: 0, width: 300, height: 300 });
+    });
+
+    it('throws for negative weights', () => {
+      expect(() => new View().setFlex({ weight: -1 })).to.throw(/'weight' must not be negative/);
+    });
+  });
+
+  describe('view.setAutoResize', () => {
+    it('resizes the view together with its parent', () => {
+      const parent = new View();
+      const child = new View();
+      parent.addChildView(child);
+      parent.setBounds({ x: 0, y: 0, width: 100, height: 100 });
+      child.setBounds({ x: 10, y: 10, width: 50, height: 50 });
+      child.setAutoResize({ width: true });
+      parent.setBounds({ x: 0, y: 0, width: 200, height: 50 });
+      expect(child.getBounds()).to.deep.equal({ x: 10, y: 10, width: 150, height: 50 });
+    });
+
+    it('scales the view proportionally to its parent', () => {
+      const parent = new View();
+      const child = new View();
+      parent.addChildView(child);
+      parent.setBounds({ x: 0, y: 0, width: 100, height: 100 });
+      child.setBounds({ x: 50, y: 0, width: 50, height: 100 });
+      child.setAutoResize({ horizontal: true, height: true });
+      parent.setBounds({ x: 0, y: 0, width: 300, height: 200 });
+      expect(child.getBounds()).to.deep.equal({ x: 150, y: 0, width: 150, height: 200 });
+    });
+  });
 });
@@ -3,6 +3,7 @@ import { AddressInfo } from 'node:net';
 import * as path from 'node:path';
 import * as fs from 'node:fs';
 import * as http from 'node:http';
+import * as zlib from 'node:zlib';
 import { BrowserWindow, ipcMain, webContents, session, app, BrowserView, WebContents } from 'electron/main';
 import { closeAllWindows } from './lib/window-helpers';
 import { ifdescribe, defer, waitUntil, listen, ifit } from './lib/spec-helpers';
@@ -41,6 +42,32 @@ describe('webContents module', () => {
     });
   });
 
+  describe('getAllWebContentsInfo() API', () => {
+    afterEach(closeAllWindows);
+    it('describes every web contents', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(fixturesPath, 'pages', 'base-page.html'));
+
+      const all = webContents.getAllWebContentsInfo();
+      expect(all.map(info => info.id)).to.deep.equal(webContents.getAllWebContents().map(contents => contents.id));
+
+      const info = all.find(info => info.id === w.webContents.id);
+      expect(info).to.deep.equal({
+        id: w.webContents.id,
+        type: 'window',
+        url: w.webContents.getURL(),
+        processId: w.webContents.getProcessId(),
+        osProcessId: w.webContents.getOSProcessId(),
+        visibility: 'hidden'
+      });
+      expect(webContents.getWebContentsInfo(w.webContents.id)).to.deep.equal(info);
+    });
+
+    it('returns null for an unknown id', () => {
+      expect(webContents.getWebContentsInfo(12345)).to.be.null();
+    });
+  });
+
   describe('fromId()', () => {
     it('returns undefined for an unknown id', () => {
       expect(webContents.fromId(12345)).to.be.undefined();
@@ -374,6 +401,109 @@ describe('webContents module', () => {
     });
   });
 
+  describe('webContents.setMemoryBudget()', () => {
+    afterEach(closeAllWindows);
+
+    it('throws for invalid options', () => {
+      const w = new BrowserWindow({ show: false });
+      expect(() => w.webContents.setMemoryBudget({ limit: -1 })).to.throw(/'limit' must be a non-negative number/);
+      expect(() => w.webContents.setMemoryBudget({ checkInterval: 0 })).to.throw(/'checkInterval' must be a positive number/);
+    });
+
+    it('emits memory-budget-exceeded when the renderer stays over budget', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      w.webContents.setMemoryBudget({ limit: 1, checkInterval: 100, reload: true });
+      let reloaded = false;
+      w.webContents.once('did-start-navigation', () => { reloaded = true; });
+      const details = await new Promise<any>(resolve => {
+        w.webContents.once('memory-budget-exceeded', (event, details) => {
+          event.preventDefault();
+          resolve(details);
+        });
+      });
+      expect(details.limit).to.equal(1);
+      expect(details.usage).to.be.greaterThan(1);
+      await setTimeout(500);
+      expect(reloaded).to.be.false();
+    });
+  });
+
+  describe('webContents.findInPage()', () => {
+    afterEach(closeAllWindows);
+
+    it('reports intermediate results with reportProgress', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      await w.webContents.executeJavaScript('document.body.textContent = "match ".repeat(20000)');
+
+      const results: Electron.Result[] = [];
+      const done = new Promise<void>(resolve => {
+        w.webContents.on('found-in-page', (event, result) => {
+          results.push(result);
+          if (result.finalUpdate) resolve();
+        });
+      });
+      const requestId = w.webContents.findInPage('match', { reportProgress: true });
+      await done;
+
+      expect(results.every(result => result.requestId === requestId)).to.be.true();
+      expect(results.slice(0, -1).every(result => !result.finalUpdate)).to.be.true();
+      const counts = results.map(result => result.matches);
+      expect(counts).to.deep.equal([...counts].sort((a, b) => a - b));
+      expect(counts[counts.length - 1]).to.equal(20000);
+    });
+  });
+
+  describe('webContents.registerScript', () => {
+    let w: BrowserWindow;
+
+    beforeEach(async () => {
+      w = new BrowserWindow({ show: false, webPreferences: { contextIsolation: true } });
+      await w.loadURL('about:blank');
+    });
+    afterEach(closeAllWindows);
+
+    it('calls the registered function with the given arguments', async () => {
+      const handle = await w.webContents.registerScript('(a, b) => ({ sum: a + b, title: document.title })');
+      await w.webContents.executeJavaScript('document.title = "registered"');
+      const result = await w.webContents.executeRegisteredScript(handle, 1, 2);
+      expect(result).to.deep.equal({ sum: 3, title: 'registered' });
+    });
+
+    it('runs in the given world', async () => {
+      await w.webContents.executeJavaScriptInIsolatedWorld(999, [{ code: 'window.X = 123' }]);
+      const handle = await w.webContents.registerScript('() => window.X', 999);
+      expect(await w.webContents.executeRegisteredScript(handle)).to.equal(123);
+    });
+
+    it('resolves with the result of a returned promise', async () => {
+      const handle = await w.webContents.registerScript('(value) => Promise.resolve(value * 2)');
+      expect(await w.webContents.executeRegisteredScript(handle, 21)).to.equal(42);
+    });
+
+    it('rejects when the code is not a function', async () => {
+      await expect(w.webContents.registerScript('42')).to.eventually.be.rejectedWith(/did not evaluate to a function/);
+    });
+
+    it('rejects when the function throws', async () => {
+      const handle = await w.webContents.registerScript('() => { throw new Error("oops") }');
+      await expect(w.webContents.executeRegisteredScript(handle)).to.eventually.be.rejectedWith(/oops/);
+    });
+
+    it('compiles the function again after a navigation', async () => {
+      const handle = await w.webContents.registerScript('() => location.href');
+      await w.loadFile(path.join(fixturesPath, 'pages', 'base-page.html'));
+      expect(await w.webContents.executeRegisteredScript(handle)).to.equal(w.webContents.getURL());
+    });
+
+    it('rejects after the script is unregistered', async () => {
+      const handle = await w.webContents.registerScript('() => 1');
+      w.webContents.unregisterScript(handle);
+      await expect(w.webContents.executeRegisteredScript(handle)).to.eventually.be.rejectedWith(/No script is registered/);
+    });
+  });
+
   describe('loadURL() promise API', () => {
     let w: BrowserWindow;
 
@@ -916,6 +1046,43 @@ describe('webContents module', () => {
     });
   });
 
+  describe('sendInputEvents(events)', () => {
+    let w: BrowserWindow;
+    beforeEach(async () => {
+      w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
+      await w.loadFile(path.join(fixturesPath, 'pages', 'key-events.html'));
+    });
+    afterEach(closeAllWindows);
+
+    it('sends the events in order', async () => {
+      const keys: string[] = [];
+      const received = new Promise<void>(resolve => {
+        const listener = (event: Electron.IpcMainEvent, key: string) => {
+          keys.push(key);
+          if (keys.length === 2) {
+            ipcMain.removeListener('keydown', listener);
+            resolve();
+          }
+        };
+        ipcMain.on('keydown', listener);
+      });
+      w.webContents.sendInputEvents([
+        { type: 'mouseMove', x: 1, y: 1 },
+        { type: 'mouseMove', x: 2, y: 2 },
+        { type: 'keyDown', keyCode: 'A' },
+        { type: 'keyDown', keyCode: 'B' }
+      ]);
+      await received;
+      expect(keys).to.deep.equal(['a', 'b']);
+    });
+
+    it('throws for an invalid event', () => {
+      expect(() => {
+        w.webContents.sendInputEvents([{ type: 'keyDown', keyCode: 'A' }, { type: 'not-an-event' } as any]);
+      }).to.throw(/Invalid event object at index 1/);
+    });
+  });
+
   describe('sendInputEvent(event)', () => {
     let w: BrowserWindow;
     beforeEach(async () => {
@@ -1019,6 +1186,21 @@ describe('webContents module', () => {
       const result = await w.webContents.executeJavaScript('window.getComputedStyle(document.body).getPropertyValue("background-repeat")');
       expect(result).to.equal('repeat');
     });
+
+    it('supports removing several inserted CSS at once', async () => {
+      const w = new BrowserWindow({ show: false });
+      w.loadURL('about:blank');
+      const keys = await Promise.all([
+        w.webContents.insertCSS('body { background-repeat: round; }'),
+        w.webContents.insertCSS('body { background-size: contain; }')
+      ]);
+      await w.webContents.removeInsertedCSS(keys);
+      const result = await w.webContents.executeJavaScript(`(() => {
+        const style = window.getComputedStyle(document.body);
+        return [style.getPropertyValue('background-repeat'), style.getPropertyValue('background-size')];
+      })()`);
+      expect(result).to.deep.equal(['repeat', 'auto']);
+    });
   });
 
   describe('inspectElement()', () => {
@@ -2049,6 +2231,81 @@ describe('webContents module', () => {
     });
   });
 
+  describe('takeHeapSnapshotStream()', () => {
+    afterEach(closeAllWindows);
+
+    const readAll = async (stream: NodeJS.ReadableStream) => {
+      const chunks: Buffer[] = [];
+      for await (const chunk of stream) chunks.push(chunk as Buffer);
+      return Buffer.concat(chunks);
+    };
+
+    it('streams the snapshot', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { sandbox: true } });
+      await w.loadURL('about:blank');
+      const snapshot = JSON.parse((await readAll(w.webContents.takeHeapSnapshotStream())).toString());
+      expect(snapshot).to.have.property('snapshot');
+      expect(snapshot.nodes).to.be.an('array').that.is.not.empty();
+    });
+
+    it('compresses the snapshot', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      const compressed = await readAll(w.webContents.takeHeapSnapshotStream({ compress: true }));
+      const snapshot = JSON.parse(zlib.gunzipSync(compressed).toString());
+      expect(snapshot).to.have.property('snapshot');
+    });
+
+    it('throws without a render process', () => {
+      const w = new BrowserWindow({ show: false });
+      w.webContents.destroy();
+      expect(() => w.webContents.takeHeapSnapshotStream()).to.throw();
+    });
+  });
+
+  describe('startSamplingHeapProfiler()', () => {
+    afterEach(closeAllWindows);
+
+    it('records allocations until stopped', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      await w.webContents.startSamplingHeapProfiler({ samplingInterval: 1024 });
+      await w.webContents.executeJavaScript('window.retained = Array.from({ length: 10000 }, (_, i) => ({ i }))');
+      const profile = await w.webContents.stopSamplingHeapProfiler();
+      expect(profile.head).to.have.property('callFrame');
+      expect(profile.head.children).to.be.an('array');
+      expect(profile.samples).to.be.an('array').that.is.not.empty();
+    });
+
+    it('rejects stopping when it is not running', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      await expect(w.webContents.stopSamplingHeapProfiler()).to.eventually.be.rejectedWith('The sampling heap profiler is not running');
+    });
+  });
+
+  describe('startCpuProfiler()', () => {
+    afterEach(closeAllWindows);
+
+    it('records samples until stopped', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      await w.webContents.startCpuProfiler({ samplingInterval: 100 });
+      await w.webContents.executeJavaScript('{ const end = Date.now() + 50; while (Date.now() < end); }');
+      const profile = await w.webContents.stopCpuProfiler();
+      expect(profile.nodes).to.be.an('array').that.is.not.empty();
+      expect(profile.nodes[0]).to.have.property('callFrame');
+      expect(profile.samples).to.have.lengthOf(profile.timeDeltas.length);
+      expect(profile.endTime).to.be.at.least(profile.startTime);
+    });
+
+    it('rejects stopping when it is not running', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      await expect(w.webContents.stopCpuProfiler()).to.eventually.be.rejectedWith('The CPU profiler is not running');
+    });
+  });
+
   describe('setBackgroundThrottling()', () => {
     afterEach(closeAllWindows);
     it('does not crash when allowing', () => {
@@ -2102,6 +2359,101 @@ describe('webContents module', () => {
     });
   });
 
+  describe('hibernate()', () => {
+    afterEach(closeAllWindows);
+
+    it('hibernates a hidden page and wakes it when navigated', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      expect(w.webContents.hibernate()).to.equal(true);
+      expect(w.webContents.isHibernated()).to.equal(true);
+      expect(w.webContents.hibernate()).to.equal(false);
+
+      await w.loadFile(path.join(fixturesPath, 'pages', 'base-page.html'));
+      expect(w.webContents.isHibernated()).to.equal(false);
+    });
+
+    it('does not emit render-process-gone when the renderer is discarded', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      w.webContents.setHibernationPolicy({ discard: true });
+      let gone = false;
+      w.webContents.once('render-process-gone', () => { gone = true; });
+      expect(w.webContents.hibernate()).to.equal(true);
+      await setTimeout(500);
+      expect(gone).to.equal(false);
+      expect(w.webContents.isHibernated()).to.equal(true);
+    });
+  });
+
+  describe('setHibernationPolicy()', () => {
+    afterEach(closeAllWindows);
+
+    it('hibernates the page once it has been hidden for idleTimeout', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      w.webContents.setHibernationPolicy({ idleTimeout: 100 });
+      await waitUntil(() => w.webContents.isHibernated());
+    });
+
+    it('throws on an invalid idleTimeout', () => {
+      const w = new BrowserWindow({ show: false });
+      expect(() => {
+        w.webContents.setHibernationPolicy({ idleTimeout: -1 });
+      }).to.throw("'idleTimeout' must be a non-negative number");
+      expect(() => {
+        w.webContents.setHibernationPolicy({ idleTimeout: 'soon' as any });
+      }).to.throw("'idleTimeout' must be a non-negative number");
+    });
+  });
+
+  describe('setBackgroundThrottlingPolicy()', () => {
+    afterEach(closeAllWindows);
+
+    it('defaults to throttle', () => {
+      const w = new BrowserWindow({ show: false });
+      expect(w.webContents.getBackgroundThrottlingPolicy()).to.equal('throttle');
+    });
+
+    it('follows backgroundThrottling', () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { backgroundThrottling: false } });
+      expect(w.webContents.getBackgroundThrottlingPolicy()).to.equal('live');
+
+      w.webContents.setBackgroundThrottling(true);
+      expect(w.webContents.getBackgroundThrottlingPolicy()).to.equal('throttle');
+    });
+
+    it('updates backgroundThrottling', () => {
+      const w = new BrowserWindow({ show: false });
+
+      w.webContents.setBackgroundThrottlingPolicy('capFrameRate', { frameRate: 1, whenOccluded: true });
+      expect(w.webContents.getBackgroundThrottlingPolicy()).to.equal('capFrameRate');
+      expect(w.webContents.getBackgroundThrottling()).to.equal(false);
+
+      w.webContents.setBackgroundThrottlingPolicy('freeze');
+      expect(w.webContents.getBackgroundThrottlingPolicy()).to.equal('freeze');
+      expect(w.webContents.getBackgroundThrottling()).to.equal(true);
+    });
+
+    it('keeps a page running at a capped frame rate', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      w.webContents.setBackgroundThrottlingPolicy('capFrameRate', { frameRate: 10 });
+      const visibilityState = await w.webContents.executeJavaScript('document.visibilityState');
+      expect(visibilityState).to.equal('visible');
+    });
+
+    it('throws on invalid arguments', () => {
+      const w = new BrowserWindow({ show: false });
+      expect(() => {
+        w.webContents.setBackgroundThrottlingPolicy('sometimes' as any);
+      }).to.throw("Expected 'live', 'capFrameRate', 'throttle' or 'freeze'");
+      expect(() => {
+        w.webContents.setBackgroundThrottlingPolicy('capFrameRate', { frameRate: 0 });
+      }).to.throw("'frameRate' must be a number between 1 and 240");
+    });
+  });
+
   ifdescribe(features.isPrintingEnabled())('getPrintersAsync()', () => {
     afterEach(closeAllWindows);
     it('can get printer list', async () => {
@@ -2179,6 +2531,29 @@ describe('webContents module', () => {
       }
     });
 
+    it('prints the pages of several webContents in parallel', async () => {
+      const other = new BrowserWindow({ show: false, webPreferences: { sandbox: true } });
+      await Promise.all([
+        w.loadURL('data:text/html,<h1>Hello, World!</h1>'),
+        other.loadURL('data:text/html,<h1>Hello, Other!</h1>')
+      ]);
+
+      const results = await Promise.all([w, other, w, other].map(({ webContents }) => webContents.printToPDF({})));
+      for (const data of results) {
+        expect(data).to.be.an.instanceof(Buffer).that.is.not.empty();
+      }
+    });
+
+    it('prints the queued pages after a failed one', async () => {
+      await w.loadURL('data:text/html,<h1>Hello, World!</h1>');
+
+      const filePath = path.join(app.getPath('temp'), 'does', 'not', 'exist', 'out.pdf');
+      const failed = w.webContents.printToPDFFile(filePath);
+      const data = await w.webContents.printToPDF({});
+      await expect(failed).to.eventually.be.rejectedWith(/Failed to write PDF to file/);
+      expect(data).to.be.an.instanceof(Buffer).that.is.not.empty();
+    });
+
     it('does not crash when called multiple times in sequence', async () => {
       await w.loadURL('data:text/html,<h1>Hello, World!</h1>');
 
@@ -2200,6 +2575,23 @@ describe('webContents module', () => {
       expect(data).to.be.an.instanceof(Buffer).that.is.not.empty();
     });
 
+    it('can print a PDF to a file', async () => {
+      await w.loadURL('data:text/html,<h1>Hello, World!</h1>');
+
+      const filePath = path.join(app.getPath('temp'), `print-to-pdf-file-${Date.now()}.pdf`);
+      defer(() => fs.promises.rm(filePath, { force: true }));
+      await w.webContents.printToPDFFile(filePath);
+      const data = await fs.promises.readFile(filePath);
+      expect(data.subarray(0, 5).toString()).to.equal('%PDF-');
+    });
+
+    it('rejects when the PDF file cannot be written', async () => {
+      await w.loadURL('data:text/html,<h1>Hello, World!</h1>');
+
+      const filePath = path.join(app.getPath('temp'), 'does', 'not', 'exist', 'out.pdf');
+      await expect(w.webContents.printToPDFFile(filePath)).to.eventually.be.rejectedWith(/Failed to write PDF to file/);
+    });
+
     type PageSizeString = Exclude<Required<Electron.PrintToPDFOptions>['pageSize'], Electron.Size>;
 
     it('with custom page sizes', async () => {
@@ -85,6 +85,18 @@ describe('webFrameMain module', () => {
       ]);
     });
 
+    it('can describe all frames in subtree without wrappers', () => {
+      const info = webFrame.getFramesInSubtreeInfo();
+      const frames = webFrame.framesInSubtree;
+      expect(info.urls).to.deep.equal(frames.map(frame => frame.url));
+      expect(info.origins).to.deep.equal(frames.map(frame => frame.origin));
+      expect(info.frameTreeNodeIds).to.deep.equal(frames.map(frame => frame.frameTreeNodeId));
+      expect(info.parentFrameTreeNodeIds).to.deep.equal(frames.map(frame => frame.parent ? frame.parent.frameTreeNodeId : -1));
+      expect(info.processIds).to.deep.equal(frames.map(frame => frame.processId));
+      expect(info.routingIds).to.deep.equal(frames.map(frame => frame.routingId));
+      expect(webFrameMain.fromId(info.processIds[2], info.routingIds[2])).to.equal(frames[2]);
+    });
+
     describe('cross-origin', () => {
       let serverA: Server;
       let serverB: Server;
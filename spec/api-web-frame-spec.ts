@@ -55,11 +55,13 @@ describe('webFrame module', () => {
 
     const spellCheckerFeedback =
       new Promise<[string[], boolean]>(resolve => {
+        const checkedWords: string[] = [];
         ipcMain.on('spec-spell-check', (e, words, callbackDefined) => {
-          if (words.length === 5) {
-            // The API calls the provider after every completed word.
-            // The promise is resolved only after this event is received with all words.
-            resolve([words, callbackDefined]);
+          // The API calls the provider after every completed word, with only
+          // the words it hasn't been asked about before.
+          checkedWords.push(...words);
+          if (checkedWords.includes('re')) {
+            resolve([checkedWords, callbackDefined]);
           }
         });
       });
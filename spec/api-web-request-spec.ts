@@ -10,6 +10,7 @@ import { ipcMain, protocol, session, WebContents, webContents } from 'electron/m
 import { Socket } from 'node:net';
 import { listen, defer } from './lib/spec-helpers';
 import { once } from 'node:events';
+import { setTimeout } from 'node:timers/promises';
 import { ReadableStream } from 'node:stream/web';
 
 const fixturesPath = path.resolve(__dirname, 'fixtures');
@@ -28,6 +29,10 @@ describe('webRequest module', () => {
       ]);
       const content = req.url;
       res.end(content);
+    } else if (req.url === '/repeatedHeaders') {
+      res.setHeader('X-Repeated', ['one', 'two']);
+      res.setHeader('Constructor', 'value');
+      res.end(req.url);
     } else {
       res.setHeader('Custom', ['Header']);
       let content = req.url;
@@ -106,6 +111,20 @@ describe('webRequest module', () => {
       await expect(ajax(`${defaultURL}filter/test`)).to.eventually.be.rejected();
     });
 
+    it('sees redirects to a filtered URL from one that is not filtered', async () => {
+      ses.webRequest.onBeforeRequest({ urls: [defaultURL] }, cancel);
+      await expect(ajax(`${defaultURL}serverRedirect`)).to.eventually.be.rejected();
+    });
+
+    it('can filter URLs among many patterns', async () => {
+      const urls = Array.from({ length: 1000 }, (_, i) => `*://*.host${i}.example.com/*`);
+      urls.push(`${defaultURL}filter/*`);
+      ses.webRequest.onBeforeRequest({ urls }, cancel);
+      const { data } = await ajax(`${defaultURL}nofilter/test`);
+      expect(data).to.equal('/nofilter/test');
+      await expect(ajax(`${defaultURL}filter/test`)).to.eventually.be.rejected();
+    });
+
     it('can filter URLs and types', async () => {
       const filter1: Electron.WebRequestFilter = { urls: [defaultURL + 'filter/*'], types: ['xhr'] };
       ses.webRequest.onBeforeRequest(filter1, cancel);
@@ -275,6 +294,57 @@ describe('webRequest module', () => {
     });
   });
 
+  describe('webRequest.setRules', () => {
+    afterEach(() => {
+      ses.webRequest.setRules([]);
+      ses.webRequest.onBeforeRequest(null);
+    });
+
+    it('can block requests', async () => {
+      ses.webRequest.setRules([{ urls: [defaultURL + 'filter/*'], action: 'block' }]);
+      const { data } = await ajax(`${defaultURL}nofilter/test`);
+      expect(data).to.equal('/nofilter/test');
+      await expect(ajax(`${defaultURL}filter/test`)).to.eventually.be.rejected();
+    });
+
+    it('can redirect requests', async () => {
+      ses.webRequest.setRules([{ urls: [defaultURL + 'filter/*'], action: 'redirect', redirectURL: defaultURL + 'redirected' }]);
+      const { data } = await ajax(`${defaultURL}filter/test`);
+      expect(data).to.equal('/redirected');
+    });
+
+    it('calls listeners for the redirected request only', async () => {
+      const urls: string[] = [];
+      ses.webRequest.onBeforeRequest((details, callback) => {
+        urls.push(details.url);
+        callback({});
+      });
+      ses.webRequest.setRules([{ urls: [defaultURL + 'filter/*'], action: 'redirect', redirectURL: defaultURL + 'redirected' }]);
+      await ajax(`${defaultURL}filter/test`);
+      expect(urls).to.deep.equal([defaultURL + 'redirected']);
+    });
+
+    it('can modify request and response headers', async () => {
+      ses.webRequest.setRules([{
+        urls: [defaultURL + '*'],
+        action: 'modifyHeaders',
+        setRequestHeaders: { Accept: '*/*;test/header' },
+        setResponseHeaders: { 'X-Rule': 'applied' },
+        removeResponseHeaders: ['Custom']
+      }]);
+      const { data, headers } = await ajax(defaultURL);
+      expect(data).to.equal('/header/received');
+      expect(headers['x-rule']).to.equal('applied');
+      expect(headers).to.not.have.property('custom');
+    });
+
+    it('throws for invalid rules', () => {
+      expect(() => ses.webRequest.setRules([{ urls: ['bad'], action: 'block' }])).to.throw(/Invalid url pattern/);
+      expect(() => ses.webRequest.setRules([{ urls: ['*://*/*'], action: 'foo' as any }])).to.throw(/Invalid rule action/);
+      expect(() => ses.webRequest.setRules([{ urls: ['*://*/*'], action: 'redirect' }])).to.throw(/redirectURL/);
+    });
+  });
+
   describe('webRequest.onBeforeSendHeaders', () => {
     afterEach(() => {
       ses.webRequest.onBeforeSendHeaders(null);
@@ -291,6 +361,17 @@ describe('webRequest module', () => {
       expect(data).to.equal('/');
     });
 
+    it('lists the request headers as an own property of details', async () => {
+      let keys: string[] = [];
+      ses.webRequest.onBeforeSendHeaders((details, callback) => {
+        keys = Object.keys(details);
+        callback({ requestHeaders: { ...details }.requestHeaders });
+      });
+      const { data } = await ajax(defaultURL);
+      expect(data).to.equal('/');
+      expect(keys).to.include('requestHeaders');
+    });
+
     it('can change the request headers', async () => {
       ses.webRequest.onBeforeSendHeaders((details, callback) => {
         const requestHeaders = details.requestHeaders;
@@ -433,6 +514,18 @@ describe('webRequest module', () => {
       expect(data).to.equal('/');
     });
 
+    it('groups repeated response headers', async () => {
+      let responseHeaders: Record<string, string[]> | undefined;
+      ses.webRequest.onHeadersReceived((details, callback) => {
+        responseHeaders = details.responseHeaders;
+        callback({});
+      });
+      await ajax(`${defaultURL}repeatedHeaders`);
+      expect(responseHeaders!['X-Repeated']).to.deep.equal(['one', 'two']);
+      expect(Object.prototype.hasOwnProperty.call(responseHeaders, 'Constructor')).to.be.true();
+      expect(responseHeaders!.Constructor).to.deep.equal(['value']);
+    });
+
     it('can change the response header', async () => {
       ses.webRequest.onHeadersReceived((details, callback) => {
         const responseHeaders = details.responseHeaders!;
@@ -563,6 +656,18 @@ describe('webRequest module', () => {
       const { data } = await ajax(defaultURL);
       expect(data).to.equal('/');
     });
+
+    it('can batch events', async () => {
+      const batches: Electron.OnCompletedListenerDetails[][] = [];
+      ses.webRequest.onCompleted({ urls: ['<all_urls>'], batchInterval: 500 } as any, ((detailsArray: any) => {
+        batches.push(detailsArray);
+      }) as any);
+      await Promise.all([ajax(`${defaultURL}a`), ajax(`${defaultURL}b`), ajax(`${defaultURL}c`)]);
+      await setTimeout(1000);
+      const urls = batches.flat().map(details => details.url);
+      expect(urls).to.have.members([`${defaultURL}a`, `${defaultURL}b`, `${defaultURL}c`]);
+      expect(batches.length).to.be.lessThan(3);
+    });
   });
 
   describe('webRequest.onErrorOccurred', () => {
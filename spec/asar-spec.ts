@@ -1,4 +1,6 @@
 import { expect } from 'chai';
+import * as cp from 'node:child_process';
+import * as os from 'node:os';
 import * as path from 'node:path';
 import * as url from 'node:url';
 import { Worker } from 'node:worker_threads';
@@ -112,6 +114,47 @@ describe('asar package', () => {
     });
   });
 
+  describe('index cache', () => {
+    let cacheDir: string;
+
+    beforeEach(() => {
+      cacheDir = importedFs.mkdtempSync(path.join(os.tmpdir(), 'electron-asar-index-cache-'));
+    });
+
+    afterEach(() => {
+      importedFs.rmSync(cacheDir, { recursive: true, force: true });
+    });
+
+    const runApp = async () => {
+      const appPath = path.join(fixtures, 'api', 'asar-index-cache');
+      const appProcess = cp.spawn(process.execPath, [appPath, `--asar-index-cache-dir=${cacheDir}`]);
+      let output = '';
+      appProcess.stdout.on('data', (data) => { output += data; });
+      const [code] = await once(appProcess, 'exit');
+      expect(code).to.equal(0);
+      return JSON.parse(output);
+    };
+
+    it('writes the prebuilt index and reads it back on the next launch', async () => {
+      const first = await runApp();
+      const cached = importedFs.readdirSync(cacheDir).filter(f => f.endsWith('.asarindex'));
+      expect(cached).to.not.be.empty();
+
+      const second = await runApp();
+      expect(second).to.deep.equal(first);
+      expect(second.file1.trim()).to.equal('file1');
+    });
+
+    it('ignores a corrupt cache file', async () => {
+      const first = await runApp();
+      for (const file of importedFs.readdirSync(cacheDir)) {
+        importedFs.writeFileSync(path.join(cacheDir, file), 'garbage');
+      }
+      const second = await runApp();
+      expect(second).to.deep.equal(first);
+    });
+  });
+
   describe('worker threads', function () {
     // DISABLED-FIXME(#38192): only disabled for ASan.
     ifit(!process.env.IS_ASAN)('should start worker thread from asar file', function (callback) {
@@ -1468,6 +1511,85 @@ describe('asar package', function () {
       });
     });
 
+    describe('compressed files', function () {
+      const expectCompressedFile = (data: string) => {
+        expect(data).to.have.lengthOf(204823);
+        expect(data.startsWith('line 0 of a compressed file\n')).to.be.true();
+        expect(data.endsWith('line 6642 of a compressed file\n')).to.be.true();
+      };
+
+      itremote('reads a compressed file', function () {
+        const p = path.join(asarDir, 'compressed.asar', 'file.txt');
+        expectCompressedFile(fs.readFileSync(p, 'utf8'));
+        expectCompressedFile(fs.readFileSync(p).toString());
+      });
+
+      itremote('reads a compressed file asynchronously', async function () {
+        const p = path.join(asarDir, 'compressed.asar', 'file.txt');
+        expectCompressedFile(await fs.promises.readFile(p, 'utf8'));
+        const data = await new Promise<Buffer>((resolve, reject) => {
+          fs.readFile(p, (error, data) => error ? reject(error) : resolve(data));
+        });
+        expectCompressedFile(data.toString());
+      });
+
+      itremote('reports the uncompressed size', function () {
+        const p = path.join(asarDir, 'compressed.asar', 'file.txt');
+        expect(fs.statSync(p).size).to.equal(204823);
+      });
+
+      itremote('opens a compressed file', function () {
+        const p = path.join(asarDir, 'compressed.asar', 'file.txt');
+        const fd = fs.openSync(p, 'r');
+        const buffer = Buffer.alloc(204823);
+        fs.readSync(fd, buffer, 0, buffer.length, 0);
+        fs.closeSync(fd);
+        expectCompressedFile(buffer.toString());
+      });
+
+      itremote('requires a compressed JSON file', function () {
+        const p = path.join(asarDir, 'compressed.asar', 'data.json');
+        expect(require(p)).to.deep.equal({ compressed: true });
+      });
+
+      itremote('fetches a range of a compressed file', async function () {
+        const p = path.resolve(asarDir, 'compressed.asar', 'file.txt');
+        expectCompressedFile(await (await fetch('file://' + p)).text());
+
+        // Spans the boundary between the first two blocks.
+        const response = await fetch('file://' + p, {
+          headers: { Range: 'bytes=65530-65545' }
+        });
+        const data = await response.text();
+        expect(data).to.equal(fs.readFileSync(p, 'utf8').slice(65530, 65546));
+      });
+    });
+
+    describe('module resolution', function () {
+      itremote('resolves a file with an extension', function () {
+        const p = path.join(asarDir, 'module.asar', 'file');
+        expect(require.resolve(p)).to.equal(p + '.js');
+        expect(require(p)).to.equal('file');
+      });
+
+      itremote('resolves the index of a directory', function () {
+        const p = path.join(asarDir, 'module.asar', 'dir');
+        expect(require.resolve(p)).to.equal(path.join(p, 'index.js'));
+        expect(require(p)).to.equal('dir index');
+      });
+
+      itremote('resolves the main of a package', function () {
+        const p = path.join(asarDir, 'module.asar', 'pkg');
+        expect(require.resolve(p)).to.equal(path.join(p, 'lib', 'main.js'));
+        expect(require(p)).to.equal('pkg main');
+      });
+
+      itremote('throws when a module is missing', function () {
+        const p = path.join(asarDir, 'module.asar', 'missing');
+        expect(() => require.resolve(p)).to.throw(/Cannot find module/);
+      });
+    });
+
     describe('util.promisify', function () {
       itremote('can promisify all fs functions', function () {
         const originalFs = require('original-fs');
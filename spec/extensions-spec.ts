@@ -1,5 +1,5 @@
 import { expect } from 'chai';
-import { app, session, BrowserWindow, ipcMain, WebContents, Extension, Session } from 'electron/main';
+import { app, session, BrowserWindow, ipcMain, MessageChannelMain, WebContents, Extension, Session } from 'electron/main';
 import { closeAllWindows, closeWindow } from './lib/window-helpers';
 import * as http from 'node:http';
 import * as path from 'node:path';
@@ -186,6 +186,31 @@ describe('chrome extensions', () => {
     expect(bg).to.equal('red');
   });
 
+  it('defers activating an extension until a matching page is loaded', async () => {
+    const customSession = session.fromPartition(`persist:${uuid.v4()}`);
+    const extension = await customSession.loadExtension(path.join(fixtures, 'extensions', 'red-bg'), { deferActivation: true });
+    expect(customSession.getAllExtensions()).to.be.empty();
+
+    const loaded = once(customSession, 'extension-loaded');
+    const w = new BrowserWindow({ show: false, webPreferences: { session: customSession } });
+    await w.loadURL(url);
+    const [, loadedExtension] = await loaded;
+    expect(loadedExtension.id).to.equal(extension.id);
+    expect(customSession.getAllExtensions().map(e => e.id)).to.deep.equal([extension.id]);
+
+    const bg = await w.webContents.executeJavaScript('document.documentElement.style.backgroundColor');
+    expect(bg).to.equal('red');
+  });
+
+  it('can remove an extension whose activation is deferred', async () => {
+    const customSession = session.fromPartition(`persist:${uuid.v4()}`);
+    const { id } = await customSession.loadExtension(path.join(fixtures, 'extensions', 'red-bg'), { deferActivation: true });
+    customSession.removeExtension(id);
+    const w = new BrowserWindow({ show: false, webPreferences: { session: customSession } });
+    await w.loadURL(url);
+    expect(customSession.getAllExtensions()).to.be.empty();
+  });
+
   it('does not crash when loading an extension with missing manifest', async () => {
     const customSession = session.fromPartition(`persist:${uuid.v4()}`);
     const promise = customSession.loadExtension(path.join(fixtures, 'extensions', 'missing-manifest'));
@@ -546,6 +571,25 @@ describe('chrome extensions', () => {
       expect(bgPageContents.session).to.not.equal(undefined);
     });
 
+    it('can exchange structured clones with the app over a MessagePortMain', async () => {
+      const customSession = session.fromPartition(`persist:${uuid.v4()}`);
+      const extensionPath = path.join(fixtures, 'extensions', 'message-port-background');
+      customSession.setPreloads([path.join(extensionPath, 'preload.js')]);
+      const promise = once(app, 'web-contents-created') as Promise<[any, WebContents]>;
+      await customSession.loadExtension(extensionPath);
+      const [, bgPageContents] = await promise;
+      await once(bgPageContents, 'did-finish-load');
+
+      const { port1, port2 } = new MessageChannelMain();
+      bgPageContents.postMessage('port', null, [port2]);
+      port1.start();
+      const message = { map: new Map([['key', 1]]), bytes: new Uint8Array([1, 2, 3]) };
+      port1.postMessage(message);
+      const [{ data }] = await once(port1, 'message');
+      expect(data).to.deep.equal(message);
+      port1.close();
+    });
+
     it('can open devtools of background page', async () => {
       const customSession = session.fromPartition(`persist:${require('uuid').v4()}`);
       const promise = once(app, 'web-contents-created') as Promise<[any, WebContents]>;
@@ -1264,6 +1308,16 @@ describe('chrome extensions', () => {
         expect(updated[1]).to.equal('HEY HEY HEY');
       });
 
+      it('executeScript with files', async () => {
+        await w.loadURL(url);
+
+        const message = { method: 'executeScriptFiles' };
+        w.webContents.executeJavaScript(`window.postMessage('${JSON.stringify(message)}', '*')`);
+
+        const [,, responseString] = await once(w.webContents, 'console-message');
+        expect(JSON.parse(responseString)).to.deep.equal([1, 2]);
+      });
+
       it('registerContentScripts', async () => {
         await w.loadURL(url);
 
@@ -0,0 +1,16 @@
+const { app } = require('electron');
+
+const fs = require('node:fs');
+const path = require('node:path');
+
+const asarPath = path.resolve(__dirname, '..', '..', 'test.asar', 'a.asar');
+
+app.whenReady().then(() => {
+  const result = {
+    file1: fs.readFileSync(path.join(asarPath, 'file1'), 'utf8'),
+    link1: fs.readFileSync(path.join(asarPath, 'link1'), 'utf8'),
+    dir: fs.readdirSync(path.join(asarPath, 'dir1'))
+  };
+  process.stdout.write(JSON.stringify(result));
+  app.quit();
+});
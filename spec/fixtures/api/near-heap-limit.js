@@ -0,0 +1,16 @@
+const { app } = require('electron');
+
+app.setNearHeapLimitHeadroom(64);
+app.once('near-heap-limit', (event, details) => {
+  console.log(JSON.stringify(details));
+  retained.length = 0;
+  app.exit(0);
+});
+
+const retained = [];
+function allocate () {
+  for (let i = 0; i < 1000; i++) retained.push(new Array(1000).fill(i));
+  setImmediate(allocate);
+}
+
+app.whenReady().then(allocate);
@@ -0,0 +1,7 @@
+self.addEventListener('install', function () {
+  console.log('console log');
+  // Served with a CSP that forbids eval, so this logs a security message.
+  try {
+    eval('1');
+  } catch {}
+});
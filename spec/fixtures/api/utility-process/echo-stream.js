@@ -0,0 +1,3 @@
+process.parentPort.on('stream', (stream) => {
+  stream.pipe(stream);
+});
@@ -0,0 +1,9 @@
+process.parentPort.once('message', () => {
+  process.parentPort.handleProtocol('utility-scheme', async (req) => {
+    const body = req.method === 'POST' ? await req.text() : new URL(req.url).pathname;
+    return new Response(`utility: ${body}`, {
+      headers: { 'content-type': 'text/plain' }
+    });
+  });
+  process.parentPort.postMessage('registered');
+});
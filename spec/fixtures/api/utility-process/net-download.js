@@ -0,0 +1,14 @@
+const { net } = require('electron');
+
+process.parentPort.once('message', ({ data: { url, downloadPath } }) => {
+  const request = net.request({ url, downloadPath });
+  request.on('response', (response) => {
+    let body = '';
+    response.on('data', (chunk) => { body += chunk; });
+    response.on('end', () => {
+      process.parentPort.postMessage({ statusCode: response.statusCode, body });
+      process.exit(0);
+    });
+  });
+  request.end();
+});
@@ -0,0 +1,4 @@
+process.parentPort.on('message', ({ data, ports: [reply] }) => {
+  if (data.crash) process.crash();
+  setTimeout(() => reply.postMessage({ pid: process.pid, value: data.value * 2 }), data.delay ?? 0);
+});
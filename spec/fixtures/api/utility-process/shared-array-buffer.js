@@ -0,0 +1,11 @@
+let childView;
+process.parentPort.on('message', (e) => {
+  if (e.data === 'check') {
+    process.parentPort.postMessage(Atomics.load(childView, 0));
+    return;
+  }
+  Atomics.store(new Int32Array(e.data.buffer), 0, 42);
+  const buffer = process.createSharedArrayBuffer(16);
+  childView = new Int32Array(buffer);
+  process.parentPort.postMessage({ buffer });
+});
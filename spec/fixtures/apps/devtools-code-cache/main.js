@@ -0,0 +1,28 @@
+const { once } = require('node:events');
+const { setTimeout } = require('node:timers/promises');
+const { BrowserWindow, app, session } = require('electron');
+
+if (process.argv.length < 3) {
+  console.error('Must pass code_cache_dir');
+  process.exit(1);
+}
+
+app.once('ready', async () => {
+  const codeCachePath = process.argv[2];
+  session.defaultSession.setCodeCachePath(codeCachePath);
+
+  // The page runs no scripts, so every code cache entry comes from DevTools.
+  const win = new BrowserWindow({ show: false });
+  await win.loadURL('about:blank');
+
+  // Open DevTools twice, the second load of the front-end is the one that
+  // generates the code cache.
+  for (let i = 0; i < 2; i++) {
+    win.webContents.openDevTools({ mode: 'detach' });
+    await once(win.webContents, 'devtools-opened');
+    await setTimeout(1000);
+    win.webContents.closeDevTools();
+    await once(win.webContents, 'devtools-closed');
+  }
+  app.exit();
+});
@@ -0,0 +1,31 @@
+const { BrowserWindow, app, protocol } = require('electron');
+
+protocol.registerSchemesAsPrivileged([
+  { scheme: 'shared', privileges: { standard: true, processPerSite: true } },
+  { scheme: 'separate', privileges: { standard: true } }
+]);
+
+// Returns the renderer process ids of windows showing |urls|, or the error
+// codes of the loads that failed.
+async function getProcessIds (urls, webPreferences = {}) {
+  const pids = [];
+  for (const url of urls) {
+    const w = new BrowserWindow({ show: false, webPreferences });
+    pids.push(await w.loadURL(url).then(() => w.webContents.getOSProcessId(), (error) => error.code));
+  }
+  return pids;
+}
+
+app.whenReady().then(async () => {
+  for (const scheme of ['shared', 'separate']) {
+    protocol.handle(scheme, () => new Response('<html></html>', { headers: { 'content-type': 'text/html' } }));
+  }
+  const results = {
+    shared: await getProcessIds(['shared://a/', 'shared://a/', 'shared://b/']),
+    separate: await getProcessIds(['separate://a/', 'separate://a/']),
+    unsandboxed: await getProcessIds(['shared://a/'], { sandbox: false }),
+    nodeIntegration: await getProcessIds(['shared://a/'], { nodeIntegration: true })
+  };
+  console.log(JSON.stringify(results));
+  app.exit(0);
+});
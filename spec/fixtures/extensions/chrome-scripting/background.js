@@ -20,6 +20,21 @@ const handleRequest = async (request, sender, sendResponse) => {
       break;
     }
 
+    case 'executeScriptFiles': {
+      // The second injection reads the file from the cache.
+      const counts = [];
+      for (let i = 0; i < 2; i++) {
+        const results = await chrome.scripting.executeScript({
+          target: { tabId },
+          files: ['counter.js']
+        });
+        counts.push(results[0].result);
+      }
+
+      sendResponse(counts);
+      break;
+    }
+
     case 'globalParams' : {
       await chrome.scripting.executeScript({
         target: { tabId },
@@ -0,0 +1,2 @@
+window.injectionCount = (window.injectionCount || 0) + 1;
+window.injectionCount; // eslint-disable-line no-unused-expressions
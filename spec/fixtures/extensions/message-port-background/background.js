@@ -0,0 +1,6 @@
+/* eslint-disable no-undef */
+window.addEventListener('message', (event) => {
+  if (event.data !== 'app-port') return;
+  const [port] = event.ports;
+  port.onmessage = ({ data }) => port.postMessage(data);
+});
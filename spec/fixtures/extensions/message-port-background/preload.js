@@ -0,0 +1,5 @@
+const { ipcRenderer } = require('electron');
+
+ipcRenderer.on('port', (event) => {
+  window.postMessage('app-port', '*', event.ports);
+});
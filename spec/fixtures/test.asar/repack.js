@@ -8,7 +8,8 @@ const path = require('node:path');
 
 const archives = [];
 for (const child of fs.readdirSync(__dirname)) {
-  if (child.endsWith('.asar')) {
+  // compressed.asar uses block compression, which @electron/asar can't write.
+  if (child.endsWith('.asar') && child !== 'compressed.asar') {
     archives.push(path.resolve(__dirname, child));
   }
 }
@@ -3,7 +3,7 @@ import * as url from 'node:url';
 import { BrowserWindow, session, ipcMain, app, WebContents } from 'electron/main';
 import { closeAllWindows } from './lib/window-helpers';
 import { emittedUntil } from './lib/events-helpers';
-import { ifit, ifdescribe, defer, itremote, useRemoteContext, listen } from './lib/spec-helpers';
+import { ifit, ifdescribe, defer, itremote, useRemoteContext, listen, waitUntil } from './lib/spec-helpers';
 import { expect } from 'chai';
 import * as http from 'node:http';
 import * as auth from 'basic-auth';
@@ -1519,6 +1519,33 @@ describe('<webview> tag', function () {
       });
     });
 
+    describe('guest events', () => {
+      it('are sent to the embedder in one message per task', async () => {
+        const batches: [number, string, Record<string, any>][][] = [];
+        const sendInternal = w._sendInternal;
+        w._sendInternal = function (channel: string, ...args: any[]) {
+          if (channel === 'GUEST_VIEW_INTERNAL_DISPATCH_EVENTS') batches.push(args[0]);
+          return sendInternal.call(this, channel, ...args);
+        };
+        defer(() => { delete (w as any)._sendInternal; });
+
+        const didAttach = once(w, 'did-attach-webview') as Promise<[any, WebContents]>;
+        await loadWebView(w, { src: 'about:blank' });
+        const [, guest] = await didAttach;
+
+        // The microtasks run between the events emitted from native code.
+        await new Promise<void>(resolve => setImmediate(resolve));
+        batches.length = 0;
+        guest.emit('page-title-updated', {}, 'first', true);
+        queueMicrotask(() => guest.emit('page-title-updated', {}, 'second', true));
+        await waitUntil(() => batches.length > 0);
+        await new Promise<void>(resolve => setImmediate(resolve));
+
+        expect(batches).to.have.lengthOf(1);
+        expect(batches[0].map(([, , props]) => props.title)).to.deep.equal(['first', 'second']);
+      });
+    });
+
     describe('page-title-updated event', () => {
       it('emits when title is set', async () => {
         const { title, explicitSet } = await loadWebViewAndWaitForEvent(w, {
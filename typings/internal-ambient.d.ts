@@ -7,6 +7,8 @@ declare namespace NodeJS {
     _resolveFilename(request: string, parent?: NodeJS.Module | null, isMain?: boolean, options?: { paths: string[] }): string;
     _preloadModules(requests: string[]): void;
     _nodeModulePaths(from: string): string[];
+    _findPath(request: string, paths: string[], isMain?: boolean): string | false;
+    _pathCache: Record<string, string>;
     _extensions: Record<string, (module: NodeJS.Module, filename: string) => any>;
     _cache: Record<string, NodeJS.Module>;
     wrapper: [string, string];
@@ -22,10 +24,11 @@ declare namespace NodeJS {
   }
 
   interface IpcRendererBinding {
-    send(internal: boolean, channel: string, args: any[]): void;
-    sendSync(internal: boolean, channel: string, args: any[]): any;
+    send(internal: boolean, channel: string, args: any[], transfer?: ArrayBuffer[]): void;
+    sendSync(internal: boolean, channel: string, args: any[], timeout?: number): any;
+    getSyncMessageStats(): Record<string, Electron.SyncMessageStats>;
     sendToHost(channel: string, args: any[]): void;
-    invoke<T>(internal: boolean, channel: string, args: any[]): Promise<{ error: string, result: T }>;
+    invoke<T>(internal: boolean, channel: string, args: any[], transfer?: ArrayBuffer[]): Promise<{ error: string, result: T }>;
     postMessage(channel: string, message: any, transferables: MessagePort[]): void;
   }
 
@@ -60,6 +63,10 @@ declare namespace NodeJS {
     size: number;
     unpacked: boolean;
     offset: number;
+    compression?: {
+      blockSize: number;
+      blocks: number[];
+    };
     integrity?: {
       algorithm: 'SHA256';
       hash: string;
@@ -79,6 +86,11 @@ declare namespace NodeJS {
     realpath(path: string): string | false;
     copyFileOut(path: string): string | false;
     getFdAndValidateIntegrityLater(): number | -1;
+    readBuffer(offset: number, size: number): Buffer | false;
+    readString(offset: number, size: number): string | false;
+    readCompressed(path: string): Buffer | false;
+    statBatch(paths: string[]): Float64Array | false;
+    resolveModule(request: string, extensions: string[]): string | false;
   }
 
   interface AsarBinding {
@@ -111,11 +123,14 @@ declare namespace NodeJS {
   interface PowerMonitorBinding extends Electron.PowerMonitor {
     createPowerMonitor(): PowerMonitorBinding;
     setListeningForShutdown(listening: boolean): void;
+    _setSystemIdleTimeForTesting?(idleTime: number): void;
   }
 
   interface SessionBinding {
     fromPartition: typeof Electron.Session.fromPartition,
     fromPath: typeof Electron.Session.fromPath,
+    setSparePartitionCount: typeof Electron.Session.setSparePartitionCount,
+    _getSparePartitionCountForTesting?(): number;
     Session: typeof Electron.Session
   }
 
@@ -159,6 +174,7 @@ declare namespace NodeJS {
     useSessionCookies?: boolean;
     credentials?: 'include' | 'omit' | 'same-origin';
     body: Uint8Array | BodyFunc;
+    bodyFile?: { path: string, offset: number, length: number };
     session?: Electron.Session;
     partition?: string;
     referrer?: string;
@@ -169,6 +185,7 @@ declare namespace NodeJS {
     mode?: string;
     destination?: string;
     bypassCustomProtocolHandlers?: boolean;
+    downloadPath?: string;
   };
   type ResponseHead = {
     statusCode: number;
@@ -27,6 +27,7 @@ declare namespace Electron {
 
   interface BaseWindow {
     _init(): void;
+    _batchUpdate(callback: () => void): void;
   }
 
   interface BrowserWindow {
@@ -64,6 +65,11 @@ declare namespace Electron {
     }
   }
 
+  interface Session {
+    _getCodeCachePath(): string | null;
+    _getBlobDataStream(identifier: string, callback: (success: boolean) => void): ElectronInternal.DataPipeStream;
+  }
+
   interface TouchBar {
     _removeFromWindow: (win: BrowserWindow) => void;
   }
@@ -73,6 +79,7 @@ declare namespace Electron {
     getOwnerBrowserWindow(): Electron.BrowserWindow | null;
     getLastWebPreferences(): Electron.WebPreferences | null;
     _getProcessMemoryInfo(): Electron.ProcessMemoryInfo;
+    _takeHeapSnapshotStream(callback: (success: boolean) => void): ElectronInternal.DataPipeStream;
     _getPreloadPaths(): string[];
     equal(other: WebContents): boolean;
     browserWindowOptions: BrowserWindowConstructorOptions;
@@ -81,7 +88,7 @@ declare namespace Electron {
     _setNextChildWebPreferences(prefs: Partial<Electron.BrowserWindowConstructorOptions['webPreferences']> & Pick<Electron.BrowserWindowConstructorOptions, 'backgroundColor'>): void;
     _send(internal: boolean, channel: string, args: any): boolean;
     _sendInternal(channel: string, ...args: any[]): void;
-    _printToPDF(options: any): Promise<Buffer>;
+    _printToPDF(options: any, filePath?: string): Promise<Buffer>;
     _print(options: any, callback?: (success: boolean, failureReason: string) => void): void;
     _getPrintersAsync(): Promise<Electron.PrinterInfo[]>;
     _init(): void;
@@ -99,13 +106,17 @@ declare namespace Electron {
   }
 
   interface WebFrameMain {
-    _send(internal: boolean, channel: string, args: any): void;
+    _send(internal: boolean, channel: string, args: any, transfer?: ArrayBuffer[]): void;
     _sendInternal(channel: string, ...args: any[]): void;
     _postMessage(channel: string, message: any, transfer?: any[]): void;
   }
 
   interface WebFrame {
     _isEvalAllowed(): boolean;
+    _registerScript(id: number, worldId: number, code: string): void;
+    _unregisterScript(id: number): void;
+    _hasRegisteredScript(id: number): boolean;
+    _executeRegisteredScript(id: number, args: any[]): any;
   }
 
   interface WebPreferences {
@@ -133,6 +144,12 @@ declare namespace Electron {
     getItemCount(): number;
     popupAt(window: BaseWindow, x: number, y: number, positioning: number, sourceType: Required<Electron.PopupOptions>['sourceType'], callback: () => void): void;
     closePopupAt(id: number): void;
+    setLabel(index: number, label: string): void;
+    _markItemChanged(index: number): void;
+    _setNeedsPopulate(needsPopulate: boolean): void;
+    _setPopulator(populate: () => (MenuItemConstructorOptions | MenuItem)[]): void;
+    _populate(): void;
+    getIndexOfCommandId(commandId: number): number;
     setSublabel(index: number, label: string): void;
     setToolTip(index: number, tooltip: string): void;
     setIcon(index: number, image: string | NativeImage): void;
@@ -185,14 +202,21 @@ declare namespace Electron {
   interface Protocol {
     registerProtocol(scheme: string, handler: any): boolean;
     interceptProtocol(scheme: string, handler: any): boolean;
+    registerUtilityProcessProtocol(scheme: string, child: ElectronInternal.UtilityProcessWrapper): boolean;
   }
 }
 
 declare namespace ElectronInternal {
   interface DesktopCapturer {
     startHandling(captureWindow: boolean, captureScreen: boolean, thumbnailSize: Electron.Size, fetchWindowIcons: boolean): void;
+    startWatching(captureWindow: boolean, captureScreen: boolean, thumbnailSize: Electron.Size, fetchWindowIcons: boolean, updateInterval: number): void;
+    stopWatching(): void;
     _onerror?: (error: string) => void;
     _onfinished?: (sources: Electron.DesktopCapturerSource[], fetchWindowIcons: boolean) => void;
+    _onsourceadded?: (source: Electron.DesktopCapturerSource) => void;
+    _onsourceremoved?: (id: string) => void;
+    _onsourcenamechanged?: (source: Electron.DesktopCapturerSource) => void;
+    _onthumbnailchanged?: (source: Electron.DesktopCapturerSource) => void;
   }
 
   interface GetSourcesOptions {
@@ -255,15 +279,25 @@ declare namespace ElectronInternal {
     loader: ModuleLoader;
   }
 
+  interface DataPipeStream {
+    read(buffer: ArrayBufferView): Promise<number>;
+    write(buffer: ArrayBufferView): Promise<void>;
+    end(): void;
+    close(): void;
+  }
+
   interface UtilityProcessWrapper extends NodeJS.EventEmitter {
     readonly pid: (number) | (undefined);
     kill(): boolean;
     postMessage(message: any, transfer?: any[]): void;
+    createStream(): DataPipeStream | null;
+    setPriority(priority: 'normal' | 'background'): void;
   }
 
   interface ParentPort extends NodeJS.EventEmitter {
     start(): void;
     pause(): void;
+    startStreams(): void;
     postMessage(message: any): void;
   }
 